@@ -27,18 +27,20 @@
 # This file defines a function to detect toolchain support for AVX2.
 #
 
-include(CheckCXXSourceRuns)
+include(CheckCXXSourceCompiles)
 include(CMakePushCheckState)
 
 #
-# Tries to build and run an AVX2 program with the given compiler flag.
+# Tries to build an AVX2 program with the given compiler flag. The program is
+# not run, since the AVX2 kernels are selected at runtime and the build host
+# need not support them.
 # If successful, sets cache variable HAVE_AVX2 to 1.
 #
 function (CheckAVX2Flag FLAG)
   cmake_push_check_state()
   set(CMAKE_REQUIRED_FLAGS "${CMAKE_REQUIRED_FLAGS} ${FLAG}")
   unset(HAVE_AVX2 CACHE)
-  check_cxx_source_runs("
+  check_cxx_source_compiles("
     #include <immintrin.h>
     int main() {
       __m256i packed = _mm256_set_epi32(-1, -2, -3, -4, -5, -6, -7, -8);
@@ -0,0 +1,57 @@
+#
+# CheckIOUringSupport.cmake
+#
+#
+# The MIT License
+#
+# Copyright (c) 2018 TileDB, Inc.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+# This file defines a function to detect support for Linux io_uring.
+#
+
+include(CheckCXXSourceCompiles)
+
+#
+# Determines if the io_uring kernel interface headers are available. TileDB
+# issues the io_uring system calls directly, so no library is required; the
+# kernel support itself is probed at runtime.
+#
+# This function sets the following variable in the cache:
+#    HAVE_IO_URING - Set to true if the io_uring headers are usable.
+#
+function (CheckIOUringSupport)
+  # Check for cached variable.
+  if (DEFINED HAVE_IO_URING)
+    return()
+  endif()
+
+  check_cxx_source_compiles("
+    #include <linux/io_uring.h>
+    #include <sys/syscall.h>
+    int main() {
+      struct io_uring_params p = {};
+      (void)p;
+      return IORING_OP_READ + IORING_FEAT_RW_CUR_POS +
+             (int)__NR_io_uring_setup + (int)__NR_io_uring_enter;
+    }"
+    HAVE_IO_URING
+  )
+endfunction()
@@ -0,0 +1,87 @@
+#
+# CheckSSE42Support.cmake
+#
+#
+# The MIT License
+#
+# Copyright (c) 2018 TileDB, Inc.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+# This file defines a function to detect toolchain support for SSE4.2.
+#
+
+include(CheckCXXSourceCompiles)
+include(CMakePushCheckState)
+
+#
+# Tries to build an SSE4.2 program with the given compiler flag. The program is
+# not run, since the SSE4.2 kernels are selected at runtime and the build host
+# need not support them.
+# If successful, sets cache variable HAVE_SSE42 to 1.
+#
+function (CheckSSE42Flag FLAG)
+  cmake_push_check_state()
+  set(CMAKE_REQUIRED_FLAGS "${CMAKE_REQUIRED_FLAGS} ${FLAG}")
+  unset(HAVE_SSE42 CACHE)
+  check_cxx_source_compiles("
+    #include <nmmintrin.h>
+    int main() {
+      unsigned crc = _mm_crc32_u32(0u, 42u);
+      return (int)(crc & 0);
+    }"
+    HAVE_SSE42
+  )
+  cmake_pop_check_state()
+endfunction()
+
+#
+# Determines if SSE4.2 is available.
+#
+# This function sets two variables in the cache:
+#    COMPILER_SUPPORTS_SSE42 - Set to true if the compiler supports SSE4.2.
+#    COMPILER_SSE42_FLAG - Set to the appropriate flag to enable SSE4.2 (empty
+#        if none is needed).
+#
+function (CheckSSE42Support)
+  # Check for cached variable.
+  if (DEFINED COMPILER_SUPPORTS_SSE42)
+    return()
+  endif()
+
+  if (MSVC)
+    # MSVC compiles the SSE4.2 intrinsics without a flag.
+    CheckSSE42Flag("")
+    if (HAVE_SSE42)
+      set(COMPILER_SUPPORTS_SSE42 TRUE CACHE BOOL "True if the compiler supports SSE4.2.")
+      set(COMPILER_SSE42_FLAG "" CACHE STRING "Compiler flag for SSE4.2 support.")
+      return()
+    endif()
+  else()
+    CheckSSE42Flag(-msse4.2)
+    if (HAVE_SSE42)
+      set(COMPILER_SUPPORTS_SSE42 TRUE CACHE BOOL "True if the compiler supports SSE4.2.")
+      set(COMPILER_SSE42_FLAG "-msse4.2" CACHE STRING "Compiler flag for SSE4.2 support.")
+      return()
+    endif()
+  endif()
+
+
+  unset(HAVE_SSE42 CACHE)
+endfunction()
@@ -0,0 +1,110 @@
+#
+# FindGBenchmark_EP.cmake
+#
+#
+# The MIT License
+#
+# Copyright (c) 2017-2018 TileDB, Inc.
+# Copyright (c) 2016 MIT and Intel Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+# Finds the Google Benchmark library, installing with an ExternalProject as
+# necessary.
+# This module defines:
+#   - GBENCHMARK_INCLUDE_DIR, directory containing headers
+#   - GBENCHMARK_LIBRARIES, the Google Benchmark library path
+#   - GBENCHMARK_FOUND, whether Google Benchmark has been found
+#   - The GBenchmark::GBenchmark imported target
+
+# Include some common helper functions.
+include(TileDBCommon)
+
+# First check for a static version in the EP prefix.
+find_library(GBENCHMARK_LIBRARIES
+  NAMES
+    libbenchmark${CMAKE_STATIC_LIBRARY_SUFFIX}
+    benchmark${CMAKE_STATIC_LIBRARY_SUFFIX}
+  PATHS ${TILEDB_EP_INSTALL_PREFIX}
+  PATH_SUFFIXES lib lib64
+  NO_DEFAULT_PATH
+)
+
+if (GBENCHMARK_LIBRARIES)
+  find_path(GBENCHMARK_INCLUDE_DIR
+    NAMES benchmark/benchmark.h
+    PATHS ${TILEDB_EP_INSTALL_PREFIX}
+    PATH_SUFFIXES include
+    NO_DEFAULT_PATH
+  )
+else()
+  # Static EP not found, search in system paths.
+  find_library(GBENCHMARK_LIBRARIES
+    NAMES
+      benchmark libbenchmark
+    PATH_SUFFIXES lib lib64
+    ${TILEDB_DEPS_NO_DEFAULT_PATH}
+  )
+  find_path(GBENCHMARK_INCLUDE_DIR
+    NAMES benchmark/benchmark.h
+    PATH_SUFFIXES include
+    ${TILEDB_DEPS_NO_DEFAULT_PATH}
+  )
+endif()
+
+include(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(GBenchmark
+  REQUIRED_VARS GBENCHMARK_LIBRARIES GBENCHMARK_INCLUDE_DIR
+)
+
+if (NOT GBENCHMARK_FOUND)
+  if (TILEDB_SUPERBUILD)
+    message(STATUS "Adding Google Benchmark as an external project")
+    ExternalProject_Add(ep_gbenchmark
+      PREFIX "externals"
+      GIT_REPOSITORY "https://github.com/google/benchmark.git"
+      GIT_TAG "v1.7.1"
+      GIT_SHALLOW TRUE
+      CMAKE_ARGS
+        -DCMAKE_BUILD_TYPE=Release
+        -DCMAKE_INSTALL_PREFIX=${TILEDB_EP_INSTALL_PREFIX}
+        -DBENCHMARK_ENABLE_TESTING=OFF
+        -DBENCHMARK_ENABLE_GTEST_TESTS=OFF
+        -DBENCHMARK_ENABLE_INSTALL=ON
+      UPDATE_COMMAND ""
+      LOG_DOWNLOAD TRUE
+      LOG_CONFIGURE TRUE
+      LOG_BUILD TRUE
+      LOG_INSTALL TRUE
+    )
+    list(APPEND TILEDB_EXTERNAL_PROJECTS ep_gbenchmark)
+  else()
+    message(FATAL_ERROR "Unable to find Google Benchmark")
+  endif()
+endif()
+
+if (GBENCHMARK_FOUND AND NOT TARGET GBenchmark::GBenchmark)
+  find_package(Threads REQUIRED)
+  add_library(GBenchmark::GBenchmark UNKNOWN IMPORTED)
+  set_target_properties(GBenchmark::GBenchmark PROPERTIES
+    IMPORTED_LOCATION "${GBENCHMARK_LIBRARIES}"
+    INTERFACE_INCLUDE_DIRECTORIES "${GBENCHMARK_INCLUDE_DIR}"
+    INTERFACE_LINK_LIBRARIES Threads::Threads
+  )
+endif()
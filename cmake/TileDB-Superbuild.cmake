@@ -31,12 +31,11 @@ set(INHERITED_CMAKE_ARGS
   -DTILEDB_FORCE_ALL_DEPS=${TILEDB_FORCE_ALL_DEPS}
   -DSANITIZER=${SANITIZER}
   -DTILEDB_EP_BASE=${TILEDB_EP_BASE}
-  -DTILEDB_TBB=${TILEDB_TBB}
-  -DTILEDB_TBB_SHARED=${TILEDB_TBB_SHARED}
   -DTILEDB_STATS=${TILEDB_STATS}
   -DTILEDB_STATIC=${TILEDB_STATIC}
   -DTILEDB_TESTS=${TILEDB_TESTS}
   -DTILEDB_TOOLS=${TILEDB_TOOLS}
+  -DTILEDB_MICROBENCH=${TILEDB_MICROBENCH}
   -DTILEDB_INSTALL_LIBDIR=${TILEDB_INSTALL_LIBDIR}
 )
 
@@ -81,10 +80,6 @@ if (TILEDB_S3)
   include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/Modules/FindAWSSDK_EP.cmake)
 endif()
 
-if (TILEDB_TBB)
-  include(${CMAKE_SOURCE_DIR}/cmake/Modules/FindTBB_EP.cmake)
-endif()
-
 if (TILEDB_TESTS)
   include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/Modules/FindCatch_EP.cmake)
 endif()
@@ -93,6 +88,10 @@ if (TILEDB_TOOLS)
   include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/Modules/FindClipp_EP.cmake)
 endif()
 
+if (TILEDB_MICROBENCH)
+  include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/Modules/FindGBenchmark_EP.cmake)
+endif()
+
 ############################################################
 # Set up the regular build (i.e. non-superbuild).
 ############################################################
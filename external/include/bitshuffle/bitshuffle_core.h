@@ -56,7 +56,7 @@ extern "C" {
 
 /* --- bshuf_using_SSE2 ----
  *
- * Whether routines where compiled with the SSE2 instruction set.
+ * Whether the routines using the SSE2 instruction set are selected.
  *
  * Returns
  * -------
@@ -68,7 +68,7 @@ int bshuf_using_SSE2(void);
 
 /* ---- bshuf_using_AVX2 ----
  *
- * Whether routines where compiled with the AVX2 instruction set.
+ * Whether the routines using the AVX2 instruction set are selected.
  *
  * Returns
  * -------
@@ -78,6 +78,25 @@ int bshuf_using_SSE2(void);
 int bshuf_using_AVX2(void);
 
 
+/* ---- bshuf_select_isa ----
+ *
+ * Selects the instruction set of the routines to use, which is the best one
+ * compiled for up to the given one. The caller must check that the processor
+ * supports it, and must call this before any routine runs. By default SSE2 is
+ * used if compiled for, as every x86-64 processor supports it.
+ *
+ * Parameters
+ * ----------
+ *  max_isa : The best instruction set to use (0: scalar, 1: SSE2, 2: AVX2).
+ *
+ * Returns
+ * -------
+ *  The selected instruction set.
+ *
+ */
+int bshuf_select_isa(int max_isa);
+
+
 /* ---- bshuf_default_block_size ----
  *
  * The default block size as function of element size.
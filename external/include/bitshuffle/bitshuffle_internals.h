@@ -68,6 +68,35 @@ typedef int64_t (*bshufBlockFunDef)(ioc_chain* C_ptr,
 int64_t bshuf_blocked_wrap_fun(bshufBlockFunDef fun, const void* in, void* out,
         const size_t size, const size_t elem_size, size_t block_size);
 
+/* ---- Worker routines shared with the AVX2 routines ---- */
+
+int64_t bshuf_trans_bit_byte_remainder(const void* in, void* out, const size_t size,
+        const size_t elem_size, const size_t start_byte);
+
+int64_t bshuf_trans_bitrow_eight(const void* in, void* out, const size_t size,
+        const size_t elem_size);
+
+int64_t bshuf_trans_byte_elem_SSE(const void* in, void* out, const size_t size,
+        const size_t elem_size);
+
+int64_t bshuf_trans_byte_bitrow_SSE(const void* in, void* out, const size_t size,
+        const size_t elem_size);
+
+int64_t bshuf_shuffle_bit_eightelem_SSE(const void* in, void* out, const size_t size,
+        const size_t elem_size);
+
+/* ---- AVX2 routines, defined in bitshuffle_avx2.cc ---- */
+
+/* Whether the AVX2 routines were compiled, i.e., bitshuffle_avx2.cc was built
+ * with AVX2 enabled. Otherwise the AVX2 routines return -12. */
+int bshuf_AVX2_compiled(void);
+
+int64_t bshuf_trans_bit_elem_AVX(const void* in, void* out, const size_t size,
+        const size_t elem_size);
+
+int64_t bshuf_untrans_bit_elem_AVX(const void* in, void* out, const size_t size,
+        const size_t elem_size);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
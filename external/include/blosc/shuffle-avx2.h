@@ -15,7 +15,9 @@
 
 #include "blosc-common.h"
 
-#ifdef __AVX2__
+/* TILEDB_AVX2_KERNELS is defined when shuffle-avx2.cc is compiled with AVX2
+   enabled even though the rest of the library is not. */
+#if defined(__AVX2__) || defined(TILEDB_AVX2_KERNELS)
 
 namespace blosc {
 
@@ -49,6 +49,18 @@ BLOSC_NO_EXPORT void
 unshuffle(const size_t bytesoftype, const size_t blocksize,
           const uint8_t* _src, const uint8_t* _dest);
 
+/**
+  Selects the implementation the shuffle and unshuffle routines dispatch to,
+  using the fastest hardware-accelerated routines the host processor supports
+  up to the given instruction set (0: generic, 1: SSE2, 2: AVX2), instead of
+  the fastest overall which is selected on first use otherwise. This must be
+  called before any shuffle or unshuffle runs. Returns the name of the
+  selected implementation ("generic", "sse2" or "avx2").
+  Modification for TileDB.
+*/
+BLOSC_NO_EXPORT const char*
+select_shuffle_implementation(const int max_isa);
+
 }
 
 #endif /* SHUFFLE_H */
@@ -10,6 +10,10 @@
  * - Renamed from bitshuffle_core.c
  * - Fixed unused parameter warnings when building without OpenMP
  *
+ * Modified: Oct 2018
+ * - Moved the AVX2 routines to bitshuffle_avx2.cc, and select the AVX2
+ *   routines at runtime with bshuf_select_isa instead of at compile time.
+ *
  * See LICENSE file for details about copyright and rights to use.
  *
  */
@@ -21,19 +25,13 @@
 #include <string.h>
 
 
-#if defined(__AVX2__) && defined (__SSE2__)
-#define USEAVX2
-#endif
-
 #if defined(__SSE2__)
 #define USESSE2
 #endif
 
 
-// Conditional includes for SSE2 and AVX2.
-#ifdef USEAVX2
-#include <immintrin.h>
-#elif defined USESSE2
+// Conditional includes for SSE2.
+#ifdef USESSE2
 #include <emmintrin.h>
 #endif
 
@@ -43,23 +41,35 @@
 #define MAX(X,Y) ((X) > (Y) ? (X) : (Y))
 
 
-/* ---- Functions indicating compile time instruction set. ---- */
+/* ---- Functions indicating the instruction set in use. ---- */
 
-int bshuf_using_SSE2(void) {
+/* The instruction set of the routines in use (0: scalar, 1: SSE2, 2: AVX2).
+   This is set before any routine runs, so plain loads of it are fine. */
 #ifdef USESSE2
-    return 1;
+static int bshuf_isa = 1;
 #else
-    return 0;
+static int bshuf_isa = 0;
 #endif
+
+int bshuf_using_SSE2(void) {
+    return bshuf_isa >= 1;
 }
 
 
 int bshuf_using_AVX2(void) {
-#ifdef USEAVX2
-    return 1;
-#else
-    return 0;
+    return bshuf_isa >= 2;
+}
+
+
+int bshuf_select_isa(int max_isa) {
+    int isa = 0;
+#ifdef USESSE2
+    isa = 1;
 #endif
+    if (isa == 1 && bshuf_AVX2_compiled())
+        isa = 2;
+    bshuf_isa = max_isa < isa ? (max_isa < 0 ? 0 : max_isa) : isa;
+    return bshuf_isa;
 }
 
 
@@ -883,293 +893,20 @@ int64_t bshuf_shuffle_bit_eightelem_SSE(const void* in, void* out, const size_t
 #endif // #ifdef USESSE2
 
 
-/* ---- Code that requires AVX2. Intel Haswell (2013) and later. ---- */
-
-/* ---- Worker code that uses AVX2 ----
- *
- * The following code makes use of the AVX2 instruction set and specialized
- * 32 byte registers. The AVX2 instructions are present on newer x86
- * processors. The first Intel processor microarchitecture supporting AVX2 was
- * Haswell (2013).
- *
- */
-
-#ifdef USEAVX2
-
-/* Transpose bits within bytes. */
-int64_t bshuf_trans_bit_byte_AVX(const void* in, void* out, const size_t size,
-         const size_t elem_size) {
-
-    size_t ii, kk;
-    const char* in_b = (const char*) in;
-    char* out_b = (char*) out;
-    int32_t* out_i32;
-
-    size_t nbyte = elem_size * size;
-
-    int64_t count;
-
-    __m256i ymm;
-    int32_t bt;
-
-    for (ii = 0; ii + 31 < nbyte; ii += 32) {
-        ymm = _mm256_loadu_si256((__m256i *) &in_b[ii]);
-        for (kk = 0; kk < 8; kk++) {
-            bt = _mm256_movemask_epi8(ymm);
-            ymm = _mm256_slli_epi16(ymm, 1);
-            out_i32 = (int32_t*) &out_b[((7 - kk) * nbyte + ii) / 8];
-            *out_i32 = bt;
-        }
-    }
-    count = bshuf_trans_bit_byte_remainder(in, out, size, elem_size,
-            nbyte - nbyte % 32);
-    return count;
-}
-
-
-/* Transpose bits within elements. */
-int64_t bshuf_trans_bit_elem_AVX(const void* in, void* out, const size_t size,
-         const size_t elem_size) {
-
-    int64_t count;
-
-    CHECK_MULT_EIGHT(size);
-
-    void* tmp_buf = malloc(size * elem_size);
-    if (tmp_buf == NULL) return -1;
-
-    count = bshuf_trans_byte_elem_SSE(in, out, size, elem_size);
-    CHECK_ERR_FREE(count, tmp_buf);
-    count = bshuf_trans_bit_byte_AVX(out, tmp_buf, size, elem_size);
-    CHECK_ERR_FREE(count, tmp_buf);
-    count = bshuf_trans_bitrow_eight(tmp_buf, out, size, elem_size);
-
-    free(tmp_buf);
-
-    return count;
-}
-
-
-/* For data organized into a row for each bit (8 * elem_size rows), transpose
- * the bytes. */
-int64_t bshuf_trans_byte_bitrow_AVX(const void* in, void* out, const size_t size,
-         const size_t elem_size) {
-
-    size_t hh, ii, jj, kk, mm;
-    const char* in_b = (const char*) in;
-    char* out_b = (char*) out;
-
-    CHECK_MULT_EIGHT(size);
-
-    size_t nrows = 8 * elem_size;
-    size_t nbyte_row = size / 8;
-
-    if (elem_size % 4) return bshuf_trans_byte_bitrow_SSE(in, out, size,
-            elem_size);
-
-    __m256i ymm_0[8];
-    __m256i ymm_1[8];
-    __m256i ymm_storeage[8][4];
-
-    for (jj = 0; jj + 31 < nbyte_row; jj += 32) {
-        for (ii = 0; ii + 3 < elem_size; ii += 4) {
-            for (hh = 0; hh < 4; hh ++) {
-
-                for (kk = 0; kk < 8; kk ++){
-                    ymm_0[kk] = _mm256_loadu_si256((__m256i *) &in_b[
-                            (ii * 8 + hh * 8 + kk) * nbyte_row + jj]);
-                }
-
-                for (kk = 0; kk < 4; kk ++){
-                    ymm_1[kk] = _mm256_unpacklo_epi8(ymm_0[kk * 2],
-                            ymm_0[kk * 2 + 1]);
-                    ymm_1[kk + 4] = _mm256_unpackhi_epi8(ymm_0[kk * 2],
-                            ymm_0[kk * 2 + 1]);
-                }
-
-                for (kk = 0; kk < 2; kk ++){
-                    for (mm = 0; mm < 2; mm ++){
-                        ymm_0[kk * 4 + mm] = _mm256_unpacklo_epi16(
-                                ymm_1[kk * 4 + mm * 2],
-                                ymm_1[kk * 4 + mm * 2 + 1]);
-                        ymm_0[kk * 4 + mm + 2] = _mm256_unpackhi_epi16(
-                                ymm_1[kk * 4 + mm * 2],
-                                ymm_1[kk * 4 + mm * 2 + 1]);
-                    }
-                }
-
-                for (kk = 0; kk < 4; kk ++){
-                    ymm_1[kk * 2] = _mm256_unpacklo_epi32(ymm_0[kk * 2],
-                            ymm_0[kk * 2 + 1]);
-                    ymm_1[kk * 2 + 1] = _mm256_unpackhi_epi32(ymm_0[kk * 2],
-                            ymm_0[kk * 2 + 1]);
-                }
-
-                for (kk = 0; kk < 8; kk ++){
-                    ymm_storeage[kk][hh] = ymm_1[kk];
-                }
-            }
-
-            for (mm = 0; mm < 8; mm ++) {
-
-                for (kk = 0; kk < 4; kk ++){
-                    ymm_0[kk] = ymm_storeage[mm][kk];
-                }
-
-                ymm_1[0] = _mm256_unpacklo_epi64(ymm_0[0], ymm_0[1]);
-                ymm_1[1] = _mm256_unpacklo_epi64(ymm_0[2], ymm_0[3]);
-                ymm_1[2] = _mm256_unpackhi_epi64(ymm_0[0], ymm_0[1]);
-                ymm_1[3] = _mm256_unpackhi_epi64(ymm_0[2], ymm_0[3]);
-
-                ymm_0[0] = _mm256_permute2x128_si256(ymm_1[0], ymm_1[1], 32);
-                ymm_0[1] = _mm256_permute2x128_si256(ymm_1[2], ymm_1[3], 32);
-                ymm_0[2] = _mm256_permute2x128_si256(ymm_1[0], ymm_1[1], 49);
-                ymm_0[3] = _mm256_permute2x128_si256(ymm_1[2], ymm_1[3], 49);
-
-                _mm256_storeu_si256((__m256i *) &out_b[
-                        (jj + mm * 2 + 0 * 16) * nrows + ii * 8], ymm_0[0]);
-                _mm256_storeu_si256((__m256i *) &out_b[
-                        (jj + mm * 2 + 0 * 16 + 1) * nrows + ii * 8], ymm_0[1]);
-                _mm256_storeu_si256((__m256i *) &out_b[
-                        (jj + mm * 2 + 1 * 16) * nrows + ii * 8], ymm_0[2]);
-                _mm256_storeu_si256((__m256i *) &out_b[
-                        (jj + mm * 2 + 1 * 16 + 1) * nrows + ii * 8], ymm_0[3]);
-            }
-        }
-    }
-    for (ii = 0; ii < nrows; ii ++ ) {
-        for (jj = nbyte_row - nbyte_row % 32; jj < nbyte_row; jj ++) {
-            out_b[jj * nrows + ii] = in_b[ii * nbyte_row + jj];
-        }
-    }
-    return size * elem_size;
-}
-
-
-/* Shuffle bits within the bytes of eight element blocks. */
-int64_t bshuf_shuffle_bit_eightelem_AVX(const void* in, void* out, const size_t size,
-         const size_t elem_size) {
-
-    CHECK_MULT_EIGHT(size);
-
-    // With a bit of care, this could be written such that such that it is
-    // in_buf = out_buf safe.
-    const char* in_b = (const char*) in;
-    char* out_b = (char*) out;
-
-    size_t ii, jj, kk;
-    size_t nbyte = elem_size * size;
-
-    __m256i ymm;
-    int32_t bt;
-
-    if (elem_size % 4) {
-        return bshuf_shuffle_bit_eightelem_SSE(in, out, size, elem_size);
-    } else {
-        for (jj = 0; jj + 31 < 8 * elem_size; jj += 32) {
-            for (ii = 0; ii + 8 * elem_size - 1 < nbyte;
-                    ii += 8 * elem_size) {
-                ymm = _mm256_loadu_si256((__m256i *) &in_b[ii + jj]);
-                for (kk = 0; kk < 8; kk++) {
-                    bt = _mm256_movemask_epi8(ymm);
-                    ymm = _mm256_slli_epi16(ymm, 1);
-                    size_t ind = (ii + jj / 8 + (7 - kk) * elem_size);
-                    * (int32_t *) &out_b[ind] = bt;
-                }
-            }
-        }
-    }
-    return size * elem_size;
-}
-
-
-/* Untranspose bits within elements. */
-int64_t bshuf_untrans_bit_elem_AVX(const void* in, void* out, const size_t size,
-         const size_t elem_size) {
-
-    int64_t count;
-
-    CHECK_MULT_EIGHT(size);
-
-    void* tmp_buf = malloc(size * elem_size);
-    if (tmp_buf == NULL) return -1;
-
-    count = bshuf_trans_byte_bitrow_AVX(in, tmp_buf, size, elem_size);
-    CHECK_ERR_FREE(count, tmp_buf);
-    count =  bshuf_shuffle_bit_eightelem_AVX(tmp_buf, out, size, elem_size);
-
-    free(tmp_buf);
-    return count;
-}
 
 
-#else // #ifdef USEAVX2
-
-int64_t bshuf_trans_bit_byte_AVX(const void* in, void* out, const size_t size,
-         const size_t elem_size) {
-    (void)in;
-    (void)out;
-    (void)size;
-    (void)elem_size;
-    return -12;
-}
-
-
-int64_t bshuf_trans_bit_elem_AVX(const void* in, void* out, const size_t size,
-         const size_t elem_size) {
-    (void)in;
-    (void)out;
-    (void)size;
-    (void)elem_size;
-    return -12;
-}
-
-
-int64_t bshuf_trans_byte_bitrow_AVX(const void* in, void* out, const size_t size,
-         const size_t elem_size) {
-    (void)in;
-    (void)out;
-    (void)size;
-    (void)elem_size;
-    return -12;
-}
-
-
-int64_t bshuf_shuffle_bit_eightelem_AVX(const void* in, void* out, const size_t size,
-         const size_t elem_size) {
-    (void)in;
-    (void)out;
-    (void)size;
-    (void)elem_size;
-    return -12;
-}
-
-
-int64_t bshuf_untrans_bit_elem_AVX(const void* in, void* out, const size_t size,
-         const size_t elem_size) {
-    (void)in;
-    (void)out;
-    (void)size;
-    (void)elem_size;
-    return -12;
-}
-
-#endif // #ifdef USEAVX2
-
-
-/* ---- Drivers selecting best instruction set at compile time. ---- */
+/* ---- Drivers selecting best instruction set at run time. ---- */
 
 int64_t bshuf_trans_bit_elem(const void* in, void* out, const size_t size, 
         const size_t elem_size) {
 
     int64_t count;
-#ifdef USEAVX2
-    count = bshuf_trans_bit_elem_AVX(in, out, size, elem_size);
-#elif defined(USESSE2)
-    count = bshuf_trans_bit_elem_SSE(in, out, size, elem_size);
-#else
-    count = bshuf_trans_bit_elem_scal(in, out, size, elem_size);
-#endif
+    if (bshuf_isa >= 2)
+        count = bshuf_trans_bit_elem_AVX(in, out, size, elem_size);
+    else if (bshuf_isa == 1)
+        count = bshuf_trans_bit_elem_SSE(in, out, size, elem_size);
+    else
+        count = bshuf_trans_bit_elem_scal(in, out, size, elem_size);
     return count;
 }
 
@@ -1178,13 +915,12 @@ int64_t bshuf_untrans_bit_elem(const void* in, void* out, const size_t size,
         const size_t elem_size) {
 
     int64_t count;
-#ifdef USEAVX2
-    count = bshuf_untrans_bit_elem_AVX(in, out, size, elem_size);
-#elif defined(USESSE2)
-    count = bshuf_untrans_bit_elem_SSE(in, out, size, elem_size);
-#else
-    count = bshuf_untrans_bit_elem_scal(in, out, size, elem_size);
-#endif
+    if (bshuf_isa >= 2)
+        count = bshuf_untrans_bit_elem_AVX(in, out, size, elem_size);
+    else if (bshuf_isa == 1)
+        count = bshuf_untrans_bit_elem_SSE(in, out, size, elem_size);
+    else
+        count = bshuf_untrans_bit_elem_scal(in, out, size, elem_size);
     return count;
 }
 
@@ -1388,4 +1124,3 @@ int64_t bshuf_bitunshuffle(const void* in, void* out, const size_t size,
 #undef CHECK_ERR_FREE
 
 #undef USESSE2
-#undef USEAVX2
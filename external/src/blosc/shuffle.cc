@@ -18,7 +18,10 @@
 #define HAVE_CPU_FEAT_INTRIN
 #endif
 
-#if defined(__AVX2__)
+/* TILEDB_AVX2_KERNELS is defined when shuffle-avx2.cc is compiled with AVX2
+   enabled even though this file is not; the AVX2 routines are then used only
+   if the host processor supports them. */
+#if defined(__AVX2__) || defined(TILEDB_AVX2_KERNELS)
 #define SHUFFLE_AVX2_ENABLED
 #endif
 
@@ -286,8 +289,8 @@ static blosc_cpu_features blosc_get_cpu_features(void) {
 
 #endif
 
-static shuffle_implementation_t get_shuffle_implementation(void) {
-  blosc_cpu_features cpu_features = blosc_get_cpu_features();
+static shuffle_implementation_t
+get_shuffle_implementation(blosc_cpu_features cpu_features) {
   shuffle_implementation_t impl_generic;
 
 #if defined(SHUFFLE_AVX2_ENABLED)
@@ -352,13 +355,28 @@ void init_shuffle_implementation(void) {
   if (!implementation_initialized) {
 #endif
     /* Initialize the implementation. */
-    host_implementation = get_shuffle_implementation();
+    host_implementation = get_shuffle_implementation(blosc_get_cpu_features());
 
     /*  Set the flag indicating the implementation has been initialized. */
     implementation_initialized = 1;
   }
 }
 
+/*  Select the shuffle/unshuffle implementation, using at most the given
+    instruction set. Modification for TileDB. */
+const char*
+select_shuffle_implementation(const int max_isa) {
+  int cpu_features = blosc_get_cpu_features();
+  if (max_isa < 2)
+    cpu_features &= ~BLOSC_HAVE_AVX2;
+  if (max_isa < 1)
+    cpu_features &= ~BLOSC_HAVE_SSE2;
+  host_implementation =
+      get_shuffle_implementation((blosc_cpu_features)cpu_features);
+  implementation_initialized = 1;
+  return host_implementation.name;
+}
+
 /*  Shuffle a block by dynamically dispatching to the appropriate
     hardware-accelerated routine at run-time. */
 void
@@ -88,9 +88,9 @@ def find_tiledb_path(args):
     return None
 
 
-def list_benchmarks(show=False):
-    """Returns a list of benchmark program names."""
-    executables = glob.glob(os.path.join(benchmark_build_dir, 'bench_*'))
+def list_benchmarks(show=False, prefix='bench_'):
+    """Returns a list of benchmark (or scenario) program names."""
+    executables = glob.glob(os.path.join(benchmark_build_dir, prefix + '*'))
     names = []
     for exe in sorted(executables):
         is_exec = os.path.isfile(exe) and os.access(exe, os.X_OK)
@@ -99,7 +99,8 @@ def list_benchmarks(show=False):
             names.append(name)
 
     if show:
-        print('{} benchmarks:'.format(len(names)))
+        kind = 'scenarios' if prefix == 'scenario_' else 'benchmarks'
+        print('{} {}:'.format(len(names), kind))
         for name in names:
             print('  {}'.format(name))
 
@@ -172,6 +173,122 @@ def run_benchmarks(args):
     print_results(results)
 
 
+def run_scenario_trial(exe, params):
+    """Runs one setup/run/teardown trial of a scenario, returning its results."""
+    subprocess.check_output([exe, 'setup'] + params, cwd=benchmark_build_dir)
+    try:
+        sync_fs()
+        drop_fs_caches()
+        output_json = subprocess.check_output([exe, 'run'] + params,
+                                              cwd=benchmark_build_dir)
+        return json.loads(output_json)
+    finally:
+        subprocess.check_output([exe, 'teardown'], cwd=benchmark_build_dir)
+
+
+def run_scenarios(args):
+    """
+    Runs the scenario programs, returning a dict of the results of the fastest
+    trial of each scenario.
+    """
+    if args.benchmarks is None:
+        scenarios = list_benchmarks(prefix='scenario_')
+    else:
+        scenarios = args.benchmarks.split(',')
+    params = args.param or []
+
+    print('Dropping caches (you may be prompted for sudo access).')
+    drop_fs_caches()
+
+    print('Running scenarios...')
+    p = ProgressBar()
+
+    try:
+        results = {}
+        for s in scenarios:
+            exe = os.path.join(benchmark_build_dir, s)
+            if not os.path.exists(exe):
+                print('Error: no scenario named "{}"'.format(s))
+                continue
+
+            trials = [run_scenario_trial(exe, params)
+                      for i in range(0, NUM_TRIALS)]
+            results[s] = min(trials, key=lambda r: r['ms'])
+    finally:
+        p.stop()
+
+    return results
+
+
+def scenario_metrics(result):
+    """
+    Returns the metrics of a scenario result to report and compare, as a list
+    of (name, value, higher_is_better) tuples.
+    """
+    metrics = [('ms', result['ms'], False),
+               ('ops/sec', result['ops_per_sec'], True),
+               ('peak RSS (KB)', result['peak_rss_kb'], False)]
+    for kind in sorted(result['latency_us'].keys()):
+        latency = result['latency_us'][kind]
+        for p in ['p50', 'p90', 'p99']:
+            metrics.append(('{} {} (us)'.format(kind, p), latency[p], False))
+    return metrics
+
+
+def print_scenario_results(results):
+    """Prints scenario results."""
+    print('Reporting fastest of {} runs for each scenario:'.format(NUM_TRIALS))
+    for s in sorted(results.keys()):
+        print('-' * 93)
+        print('{} ({} clients, {} ops)'.format(
+            s, results[s]['clients'], results[s]['ops']))
+        for name, value, _ in scenario_metrics(results[s]):
+            print('  {:<40s}{:>50.1f}'.format(name, value))
+
+
+def counter_values(result):
+    """Returns a dict of the internal stats counters of a scenario result."""
+    return {c['name']: c['value'] for c in result['stats']['counters']}
+
+
+def compare_to_baseline(results, baseline, threshold):
+    """
+    Compares scenario results to baseline results, printing the differences.
+    Returns the number of metrics that regressed by more than the threshold.
+    """
+    regressions = 0
+    print('Comparing to baseline (threshold {:.0f}%):'.format(threshold * 100))
+    for s in sorted(results.keys()):
+        print('-' * 93)
+        if s not in baseline:
+            print('{}: not in baseline'.format(s))
+            continue
+        print(s)
+        base_metrics = {m[0]: m[1] for m in scenario_metrics(baseline[s])}
+        for name, value, higher_is_better in scenario_metrics(results[s]):
+            base = base_metrics.get(name)
+            if not base:
+                continue
+            change = (value - base) / float(base)
+            regressed = -change > threshold if higher_is_better \
+                else change > threshold
+            regressions += regressed
+            print('  {:<40s}{:>16.1f}{:>16.1f}{:>+17.1f}%{}'.format(
+                name, base, value, change * 100,
+                ' <-- regression' if regressed else ''))
+
+        # Counters (e.g. bytes read) are deterministic for a given workload,
+        # so report those that changed, which hints at the cause.
+        base_counters = counter_values(baseline[s])
+        for name, value in sorted(counter_values(results[s]).items()):
+            base = base_counters.get(name, 0)
+            if base != value and \
+                    abs(value - base) > threshold * max(base, value):
+                print('  {:<40s}{:>16d}{:>16d}'.format(
+                    'counter ' + name, base, value))
+    return regressions
+
+
 def main():
     parser = argparse.ArgumentParser(description='Runs TileDB benchmarks.')
     parser.add_argument('--tiledb', metavar='PATH',
@@ -182,7 +299,24 @@ def main():
                         help='List all available benchmarks and exit.')
     parser.add_argument('-b', '--benchmarks', metavar='NAMES',
                         help='If given, one or more comma-separated names of '
-                             'benchmarks to run.')
+                             'benchmarks (or scenarios) to run.')
+    parser.add_argument('-s', '--scenarios', action='store_true',
+                        default=False,
+                        help='Run the scenario programs instead of the '
+                             'benchmarks.')
+    parser.add_argument('-p', '--param', metavar='KEY=VALUE', action='append',
+                        help='Scenario parameter, passed to every scenario. '
+                             'Can be given multiple times.')
+    parser.add_argument('-o', '--output', metavar='FILE',
+                        help='Save the scenario results as JSON to FILE, '
+                             'e.g. to use as a baseline.')
+    parser.add_argument('--baseline', metavar='FILE',
+                        help='Compare the scenario results to the baseline '
+                             'results saved in FILE, exiting with an error '
+                             'if any metric regressed.')
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help='Relative change of a metric considered a '
+                             'regression (default: 0.1).')
     args = parser.parse_args()
 
     if find_tiledb_path(args) is None:
@@ -194,9 +328,25 @@ def main():
 
     if args.list:
         list_benchmarks(show=True)
+        list_benchmarks(show=True, prefix='scenario_')
         sys.exit(0)
 
-    run_benchmarks(args)
+    if not args.scenarios:
+        run_benchmarks(args)
+        return
+
+    results = run_scenarios(args)
+    print_scenario_results(results)
+
+    if args.output is not None:
+        with open(args.output, 'w') as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+
+    if args.baseline is not None:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if compare_to_baseline(results, baseline, args.threshold) > 0:
+            sys.exit(1)
 
 
 if __name__ == '__main__':
@@ -0,0 +1,322 @@
+/**
+ * @file   scenario.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Defines common code for the scenario benchmark programs.
+ */
+
+#include <tiledb/tiledb>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "scenario.h"
+
+namespace {
+void usage(const std::string& argv0) {
+  std::cerr << "USAGE: " << argv0 << " [setup|run|teardown] [key=value ...]"
+            << std::endl
+            << std::endl
+            << "Runs a TileDB scenario benchmark. Specify one of the following "
+               "tasks:"
+            << std::endl
+            << "    setup : Performs scenario setup and exits." << std::endl
+            << "    run : Runs the scenario workload." << std::endl
+            << "    teardown : Performs scenario cleanup and exits."
+            << std::endl
+            << "If no task is specified then setup, run, teardown are executed "
+               "once, in that order."
+            << std::endl
+            << "The scenario parameters are given as 'key=value' pairs, and "
+               "must be the same for setup and run. Common parameters are "
+               "'clients', 'ops' and 'seed'."
+            << std::endl;
+}
+
+/** Returns the given percentile (in [0, 100]) of the sorted values. */
+uint64_t percentile(const std::vector<uint64_t>& sorted, double p) {
+  if (sorted.empty())
+    return 0;
+  auto rank = (uint64_t)(p / 100.0 * sorted.size() + 0.5);
+  rank = std::max<uint64_t>(1, std::min<uint64_t>(rank, sorted.size()));
+  return sorted[rank - 1];
+}
+}  // namespace
+
+ScenarioBase::ScenarioBase() = default;
+
+ScenarioBase::~ScenarioBase() = default;
+
+int ScenarioBase::main(int argc, char** argv) {
+  std::string task;
+  int first_param = 1;
+  if (argc > 1 && std::string(argv[1]).find('=') == std::string::npos) {
+    task = argv[1];
+    first_param = 2;
+  }
+
+  if (!parse_params(argc - first_param, argv + first_param)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  try {
+    if (task == "setup") {
+      setup_base();
+    } else if (task == "run") {
+      run_base();
+    } else if (task == "teardown") {
+      teardown_base();
+    } else if (task.empty()) {
+      setup_base();
+      run_base();
+      teardown_base();
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+void ScenarioBase::teardown_base() {
+  auto t0 = std::chrono::steady_clock::now();
+  teardown();
+  auto t1 = std::chrono::steady_clock::now();
+
+  uint64_t ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+  print_task_ms_json("teardown", ms);
+}
+
+void ScenarioBase::setup_base() {
+  teardown();
+
+  auto t0 = std::chrono::steady_clock::now();
+  setup();
+  auto t1 = std::chrono::steady_clock::now();
+
+  uint64_t ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+  print_task_ms_json("setup", ms);
+}
+
+void ScenarioBase::run_base() {
+  pre_run();
+
+  unsigned num_clients = clients();
+  uint64_t num_ops = ops();
+  std::vector<std::map<std::string, std::vector<uint64_t>>> client_latencies(
+      num_clients);
+  std::mutex error_mtx;
+  std::string error;
+
+  tiledb::Stats::reset();
+  tiledb::Stats::enable();
+
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (unsigned c = 0; c < num_clients; c++) {
+    threads.emplace_back([&, c]() {
+      try {
+        for (uint64_t op = 0; op < num_ops; op++) {
+          auto op_t0 = std::chrono::steady_clock::now();
+          const char* kind = run_op(c, op);
+          auto op_t1 = std::chrono::steady_clock::now();
+          client_latencies[c][kind].push_back(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  op_t1 - op_t0)
+                  .count());
+        }
+      } catch (const std::exception& e) {
+        std::unique_lock<std::mutex> lck(error_mtx);
+        error = e.what();
+      }
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+  auto t1 = std::chrono::steady_clock::now();
+
+  tiledb::Stats::disable();
+
+  if (!error.empty()) {
+    std::cerr << "Error: " << error << std::endl;
+    std::exit(1);
+  }
+
+  // Merge the latencies of all clients
+  std::map<std::string, std::vector<uint64_t>> latencies_us;
+  for (auto& l : client_latencies) {
+    for (auto& kind : l) {
+      auto& all = latencies_us[kind.first];
+      all.insert(all.end(), kind.second.begin(), kind.second.end());
+    }
+  }
+
+  std::string stats;
+  tiledb::Stats::dump(&stats);
+
+  uint64_t ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+  print_run_json(ms, &latencies_us, stats);
+}
+
+void ScenarioBase::teardown() {
+}
+
+void ScenarioBase::setup() {
+}
+
+void ScenarioBase::pre_run() {
+}
+
+unsigned ScenarioBase::default_clients() const {
+  return 1;
+}
+
+unsigned ScenarioBase::clients() const {
+  return (unsigned)std::max<uint64_t>(1, param("clients", default_clients()));
+}
+
+uint64_t ScenarioBase::ops() const {
+  return param("ops", 10);
+}
+
+uint64_t ScenarioBase::param(
+    const std::string& name, uint64_t default_value) const {
+  auto it = params_.find(name);
+  if (it == params_.end())
+    return default_value;
+  return std::strtoull(it->second.c_str(), nullptr, 10);
+}
+
+double ScenarioBase::param_double(
+    const std::string& name, double default_value) const {
+  auto it = params_.find(name);
+  if (it == params_.end())
+    return default_value;
+  return std::strtod(it->second.c_str(), nullptr);
+}
+
+std::mt19937_64 ScenarioBase::rng(uint64_t n) const {
+  std::seed_seq seq{param("seed", 0), n};
+  return std::mt19937_64(seq);
+}
+
+bool ScenarioBase::parse_params(int argc, char** argv) {
+  for (int i = 0; i < argc; i++) {
+    std::string arg(argv[i]);
+    auto eq = arg.find('=');
+    if (eq == std::string::npos || eq == 0)
+      return false;
+    params_[arg.substr(0, eq)] = arg.substr(eq + 1);
+  }
+  return true;
+}
+
+uint64_t ScenarioBase::peak_rss_kb() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    return 0;
+  return pmc.PeakWorkingSetSize / 1024;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef __APPLE__
+  // Reported in bytes on macOS
+  return (uint64_t)usage.ru_maxrss / 1024;
+#else
+  return (uint64_t)usage.ru_maxrss;
+#endif
+#endif
+}
+
+void ScenarioBase::print_task_ms_json(const std::string& name, uint64_t ms) {
+  std::cout << "{ \"phase\": \"" << name << "\", \"ms\": " << ms << " }\n";
+}
+
+void ScenarioBase::print_run_json(
+    uint64_t ms,
+    std::map<std::string, std::vector<uint64_t>>* latencies_us,
+    const std::string& stats) {
+  uint64_t total_ops = (uint64_t)clients() * ops();
+  double ops_per_sec = ms == 0 ? 0 : total_ops * 1000.0 / ms;
+
+  std::cout << "{\n";
+  std::cout << "\"phase\": \"run\",\n";
+  std::cout << "\"ms\": " << ms << ",\n";
+  std::cout << "\"clients\": " << clients() << ",\n";
+  std::cout << "\"ops\": " << total_ops << ",\n";
+  std::cout << "\"ops_per_sec\": " << ops_per_sec << ",\n";
+  std::cout << "\"peak_rss_kb\": " << peak_rss_kb() << ",\n";
+
+  std::cout << "\"params\": {";
+  for (auto it = params_.begin(); it != params_.end(); ++it) {
+    std::cout << (it == params_.begin() ? " " : ", ");
+    std::cout << "\"" << it->first << "\": \"" << it->second << "\"";
+  }
+  std::cout << " },\n";
+
+  std::cout << "\"latency_us\": {\n";
+  for (auto it = latencies_us->begin(); it != latencies_us->end(); ++it) {
+    auto& values = it->second;
+    std::sort(values.begin(), values.end());
+    if (it != latencies_us->begin())
+      std::cout << ",\n";
+    std::cout << "  \"" << it->first << "\": { ";
+    std::cout << "\"count\": " << values.size() << ", ";
+    std::cout << "\"p50\": " << percentile(values, 50) << ", ";
+    std::cout << "\"p90\": " << percentile(values, 90) << ", ";
+    std::cout << "\"p99\": " << percentile(values, 99) << ", ";
+    std::cout << "\"max\": " << (values.empty() ? 0 : values.back()) << " }";
+  }
+  std::cout << "\n},\n";
+
+  std::cout << "\"stats\": " << stats << "\n";
+  std::cout << "}\n";
+}
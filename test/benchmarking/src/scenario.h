@@ -0,0 +1,162 @@
+/**
+ * @file   scenario.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Declares common code for the scenario benchmark programs.
+ */
+
+#ifndef TILEDB_SCENARIO_H
+#define TILEDB_SCENARIO_H
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Base class for scenario benchmarks.
+ *
+ * A scenario generates a parameterized array in its setup phase, and its run
+ * phase executes a workload of operations from a number of concurrent
+ * clients. Each client runs in its own thread and performs a fixed number
+ * of operations, the latency of each of which is recorded. The run phase
+ * reports, as a single JSON object on stdout, the total run time, the
+ * throughput, the latency percentiles per operation kind, the peak resident
+ * set size of the process and the internal TileDB stats gathered during the
+ * run.
+ *
+ * Parameters are given on the command line as `key=value` pairs after the
+ * task name, and must be the same for the setup and run phases. The
+ * parameters common to all scenarios are `clients` (the number of
+ * concurrent clients, by default 1 unless the scenario says otherwise),
+ * `ops` (the number of operations per client, default 10) and `seed` (the
+ * random seed, default 0).
+ */
+class ScenarioBase {
+ public:
+  /** Constructor. */
+  ScenarioBase();
+
+  /** Destructor. */
+  virtual ~ScenarioBase();
+
+  /**
+   * Main method of the scenario, which invokes setup, run, or teardown
+   * depending on the arguments given.
+   */
+  int main(int argc, char** argv);
+
+  /** Scenario setup (array creation, etc). */
+  void setup_base();
+
+  /** Scenario cleanup (array removal, etc). */
+  void teardown_base();
+
+  /** Scenario run method, executing the workload from all the clients. */
+  void run_base();
+
+ protected:
+  /** Implemented by subclass: the setup phase. */
+  virtual void setup();
+
+  /** Implemented by subclass: the cleanup phase. */
+  virtual void teardown();
+
+  /**
+   * Implemented by subclass: anything that needs to happen in the same process
+   * as 'run' but should be excluded from the run time, e.g. opening the
+   * arrays and allocating the query buffers of every client.
+   */
+  virtual void pre_run();
+
+  /**
+   * Implemented by subclass: performs the given operation of the given
+   * client. This is called concurrently for different clients.
+   *
+   * @param client The client index, in `[0, clients())`.
+   * @param op The operation index of the client, in `[0, ops())`.
+   * @return The name of the kind of the performed operation (e.g. "read"),
+   *     under which its latency is reported.
+   */
+  virtual const char* run_op(unsigned client, uint64_t op) = 0;
+
+  /**
+   * Implemented by subclass: the number of concurrent clients if the
+   * `clients` parameter is not set.
+   */
+  virtual unsigned default_clients() const;
+
+  /** Returns the number of concurrent clients. */
+  unsigned clients() const;
+
+  /** Returns the number of operations per client. */
+  uint64_t ops() const;
+
+  /**
+   * Returns the value of the given integer parameter, or the given default
+   * if it is not set.
+   */
+  uint64_t param(const std::string& name, uint64_t default_value) const;
+
+  /**
+   * Returns the value of the given floating point parameter, or the given
+   * default if it is not set.
+   */
+  double param_double(const std::string& name, double default_value) const;
+
+  /** Returns a random generator seeded with the `seed` parameter and `n`. */
+  std::mt19937_64 rng(uint64_t n) const;
+
+ private:
+  /** The `key=value` parameters given on the command line. */
+  std::map<std::string, std::string> params_;
+
+  /** Parses the `key=value` parameters given on the command line. */
+  bool parse_params(int argc, char** argv);
+
+  /** Returns the peak resident set size of the process, in KB. */
+  static uint64_t peak_rss_kb();
+
+  /** Prints a time in milliseconds for a task name in JSON. */
+  void print_task_ms_json(const std::string& name, uint64_t ms);
+
+  /**
+   * Prints the results of the run phase in JSON.
+   *
+   * @param ms The total run time in milliseconds.
+   * @param latencies_us The latencies in microseconds per operation kind.
+   * @param stats The internal TileDB stats in JSON.
+   */
+  void print_run_json(
+      uint64_t ms,
+      std::map<std::string, std::vector<uint64_t>>* latencies_us,
+      const std::string& stats);
+};
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * @file   scenario_incomplete.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Scenario: reads of a whole sparse array with small buffers, so that each
+ * read resubmits its incomplete query many times.
+ *
+ * Parameters: 'cells' (default 100000) and 'buffer_cells' (default 1000).
+ */
+
+#include "sparse_scenario.h"
+
+using namespace tiledb;
+
+class Scenario : public SparseScenario {
+ protected:
+  virtual void setup() {
+    create_array();
+    auto gen = rng(0);
+    Array array(ctx_, array_uri_, TILEDB_WRITE);
+    write_cells(array, param("cells", 100000), &gen);
+    array.close();
+  }
+
+  virtual void pre_run() {
+    for (unsigned c = 0; c < clients(); c++)
+      arrays_.emplace_back(new Array(ctx_, array_uri_, TILEDB_READ));
+  }
+
+  virtual const char* run_op(unsigned client, uint64_t) {
+    std::array<uint32_t, 4> subarray = {{1, domain(), 1, domain()}};
+    read_cells(*arrays_[client], subarray, param("buffer_cells", 1000));
+    return "read";
+  }
+
+ private:
+  std::vector<std::unique_ptr<Array>> arrays_;
+};
+
+int main(int argc, char** argv) {
+  Scenario scenario;
+  return scenario.main(argc, argv);
+}
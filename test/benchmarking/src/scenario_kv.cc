@@ -0,0 +1,108 @@
+/**
+ * @file   scenario_kv.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Scenario: random key lookups in a key-value store.
+ *
+ * Parameters: 'items' (default 100000) and 'keys_per_op' (the number of
+ * lookups per operation, default 10).
+ */
+
+#include <tiledb/tiledb>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include "scenario.h"
+
+using namespace tiledb;
+
+class Scenario : public ScenarioBase {
+ protected:
+  virtual void setup() {
+    MapSchema schema(ctx_);
+    schema.add_attribute(Attribute::create<int32_t>(ctx_, "a"));
+    Map::create(map_uri_, schema);
+
+    Map map(ctx_, map_uri_, TILEDB_WRITE);
+    for (uint64_t i = 0; i < items(); i++) {
+      auto item = Map::create_item(ctx_, key(i));
+      item["a"] = (int32_t)i;
+      map.add_item(item);
+    }
+    map.flush();
+    map.close();
+  }
+
+  virtual void teardown() {
+    VFS vfs(ctx_);
+    if (vfs.is_dir(map_uri_))
+      vfs.remove_dir(map_uri_);
+  }
+
+  virtual void pre_run() {
+    for (unsigned c = 0; c < clients(); c++) {
+      gens_.push_back(rng(c + 1));
+      maps_.emplace_back(new Map(ctx_, map_uri_, TILEDB_READ));
+    }
+  }
+
+  virtual const char* run_op(unsigned client, uint64_t) {
+    std::uniform_int_distribution<uint64_t> dist(0, items() - 1);
+    uint64_t keys_per_op = param("keys_per_op", 10);
+    for (uint64_t k = 0; k < keys_per_op; k++) {
+      auto i = dist(gens_[client]);
+      int32_t a = (*maps_[client])[key(i)]["a"];
+      if (a != (int32_t)i)
+        throw std::runtime_error("Wrong value for key " + key(i));
+    }
+    return "lookup";
+  }
+
+ private:
+  const std::string map_uri_ = "scenario_map";
+
+  Context ctx_;
+  std::vector<std::mt19937_64> gens_;
+  std::vector<std::unique_ptr<Map>> maps_;
+
+  uint64_t items() const {
+    return std::max<uint64_t>(1, param("items", 100000));
+  }
+
+  static std::string key(uint64_t i) {
+    return "key_" + std::to_string(i);
+  }
+};
+
+int main(int argc, char** argv) {
+  Scenario scenario;
+  return scenario.main(argc, argv);
+}
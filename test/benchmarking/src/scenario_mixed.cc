@@ -0,0 +1,88 @@
+/**
+ * @file   scenario_mixed.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Scenario: a mixed workload of concurrent reads and writes on a sparse
+ * array. Each operation either writes a new fragment of random cells or
+ * opens the array and reads a random subarray.
+ *
+ * Parameters: 'cells' (initial cells, default 100000), 'write_pct' (the
+ * percentage of writes, default 20), 'write_cells' (default 1000),
+ * 'query_extent' (default 4096) and 'buffer_cells' (default 100000). The
+ * number of clients defaults to 8.
+ */
+
+#include "sparse_scenario.h"
+
+using namespace tiledb;
+
+class Scenario : public SparseScenario {
+ protected:
+  virtual void setup() {
+    create_array();
+    auto gen = rng(0);
+    Array array(ctx_, array_uri_, TILEDB_WRITE);
+    write_cells(array, param("cells", 100000), &gen);
+    array.close();
+  }
+
+  virtual void pre_run() {
+    for (unsigned c = 0; c < clients(); c++)
+      gens_.push_back(rng(c + 1));
+  }
+
+  virtual const char* run_op(unsigned client, uint64_t) {
+    auto& gen = gens_[client];
+    if (std::uniform_int_distribution<uint64_t>(0, 99)(gen) <
+        param("write_pct", 20)) {
+      Array array(ctx_, array_uri_, TILEDB_WRITE);
+      write_cells(array, param("write_cells", 1000), &gen);
+      array.close();
+      return "write";
+    }
+
+    auto subarray =
+        random_subarray(&gen, (uint32_t)param("query_extent", 4096));
+    Array array(ctx_, array_uri_, TILEDB_READ);
+    read_cells(array, subarray, param("buffer_cells", 100000));
+    array.close();
+    return "open_read";
+  }
+
+  virtual unsigned default_clients() const {
+    return 8;
+  }
+
+ private:
+  std::vector<std::mt19937_64> gens_;
+};
+
+int main(int argc, char** argv) {
+  Scenario scenario;
+  return scenario.main(argc, argv);
+}
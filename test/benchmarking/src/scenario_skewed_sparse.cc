@@ -0,0 +1,75 @@
+/**
+ * @file   scenario_skewed_sparse.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Scenario: reads of random subarrays from a sparse array whose cells are
+ * skewed towards the origin of the domain, so that the reads range from
+ * nearly empty to very dense.
+ *
+ * Parameters: 'cells' (default 1000000), 'skew' (default 4.0),
+ * 'query_extent' (default 1024) and 'buffer_cells' (default 100000).
+ */
+
+#include "sparse_scenario.h"
+
+using namespace tiledb;
+
+class Scenario : public SparseScenario {
+ protected:
+  virtual void setup() {
+    create_array();
+    auto gen = rng(0);
+    Array array(ctx_, array_uri_, TILEDB_WRITE);
+    write_cells(
+        array, param("cells", 1000000), &gen, param_double("skew", 4.0));
+    array.close();
+  }
+
+  virtual void pre_run() {
+    for (unsigned c = 0; c < clients(); c++) {
+      gens_.push_back(rng(c + 1));
+      arrays_.emplace_back(new Array(ctx_, array_uri_, TILEDB_READ));
+    }
+  }
+
+  virtual const char* run_op(unsigned client, uint64_t) {
+    auto subarray =
+        random_subarray(&gens_[client], (uint32_t)param("query_extent", 1024));
+    read_cells(*arrays_[client], subarray, param("buffer_cells", 100000));
+    return "read";
+  }
+
+ private:
+  std::vector<std::mt19937_64> gens_;
+  std::vector<std::unique_ptr<Array>> arrays_;
+};
+
+int main(int argc, char** argv) {
+  Scenario scenario;
+  return scenario.main(argc, argv);
+}
@@ -0,0 +1,144 @@
+/**
+ * @file   scenario_var_strings.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Scenario: reads of random ranges of a dense 1D array with a variable-sized
+ * string attribute, whose lengths follow an exponential distribution.
+ *
+ * Parameters: 'cells' (default 1000000), 'avg_len' (the average string
+ * length, default 32), 'max_len' (default 1024), 'tile_extent' (default
+ * 10000) and 'query_cells' (default 10000).
+ */
+
+#include <tiledb/tiledb>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "scenario.h"
+
+using namespace tiledb;
+
+class Scenario : public ScenarioBase {
+ protected:
+  virtual void setup() {
+    ArraySchema schema(ctx_, TILEDB_DENSE);
+    Domain domain(ctx_);
+    domain.add_dimension(Dimension::create<uint64_t>(
+        ctx_,
+        "d",
+        {{1, cells()}},
+        std::min<uint64_t>(param("tile_extent", 10000), cells())));
+    schema.set_domain(domain);
+    FilterList filters(ctx_);
+    filters.add_filter({ctx_, TILEDB_FILTER_ZSTD});
+    schema.add_attribute(
+        Attribute::create<std::string>(ctx_, "s").set_filter_list(filters));
+    Array::create(array_uri_, schema);
+
+    auto gen = rng(0);
+    std::exponential_distribution<double> len_dist(
+        1.0 / std::max<uint64_t>(1, param("avg_len", 32)));
+    std::uniform_int_distribution<int> char_dist('a', 'z');
+    std::vector<uint64_t> offsets(cells());
+    std::string data;
+    for (uint64_t i = 0; i < cells(); i++) {
+      offsets[i] = data.size();
+      auto len = std::min<uint64_t>(1 + (uint64_t)len_dist(gen), max_len());
+      for (uint64_t j = 0; j < len; j++)
+        data.push_back((char)char_dist(gen));
+    }
+
+    Array array(ctx_, array_uri_, TILEDB_WRITE);
+    Query query(ctx_, array);
+    query.set_layout(TILEDB_ROW_MAJOR).set_buffer("s", offsets, data);
+    query.submit();
+    array.close();
+  }
+
+  virtual void teardown() {
+    VFS vfs(ctx_);
+    if (vfs.is_dir(array_uri_))
+      vfs.remove_dir(array_uri_);
+  }
+
+  virtual void pre_run() {
+    auto query_cells = std::min(param("query_cells", 10000), cells());
+    clients_.resize(clients());
+    for (unsigned c = 0; c < clients(); c++) {
+      auto& client = clients_[c];
+      client.gen = rng(c + 1);
+      client.array.reset(new Array(ctx_, array_uri_, TILEDB_READ));
+      client.offsets.resize(query_cells);
+      client.data.resize(query_cells * max_len());
+    }
+  }
+
+  virtual const char* run_op(unsigned client, uint64_t) {
+    auto& state = clients_[client];
+    auto query_cells = state.offsets.size();
+    std::uniform_int_distribution<uint64_t> dist(1, cells() - query_cells + 1);
+    uint64_t start = dist(state.gen);
+    std::vector<uint64_t> subarray = {start, start + query_cells - 1};
+
+    Query query(ctx_, *state.array);
+    query.set_subarray(subarray)
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("s", state.offsets, state.data);
+    query.submit();
+    return "read";
+  }
+
+ private:
+  /** State of a client. */
+  struct Client {
+    std::mt19937_64 gen;
+    std::unique_ptr<Array> array;
+    std::vector<uint64_t> offsets;
+    std::string data;
+  };
+
+  const std::string array_uri_ = "scenario_array";
+
+  Context ctx_;
+  std::vector<Client> clients_;
+
+  uint64_t cells() const {
+    return std::max<uint64_t>(1, param("cells", 1000000));
+  }
+
+  uint64_t max_len() const {
+    return std::max<uint64_t>(1, param("max_len", 1024));
+  }
+};
+
+int main(int argc, char** argv) {
+  Scenario scenario;
+  return scenario.main(argc, argv);
+}
@@ -0,0 +1,140 @@
+/**
+ * @file   sparse_scenario.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Defines common code for the scenario benchmarks on sparse arrays.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "sparse_scenario.h"
+
+using namespace tiledb;
+
+namespace {
+Config sparse_scenario_config() {
+  Config config;
+  config["sm.dedup_coords"] = "true";
+  return config;
+}
+}  // namespace
+
+SparseScenario::SparseScenario()
+    : ctx_(sparse_scenario_config()) {
+}
+
+void SparseScenario::teardown() {
+  VFS vfs(ctx_);
+  if (vfs.is_dir(array_uri_))
+    vfs.remove_dir(array_uri_);
+}
+
+void SparseScenario::create_array() {
+  auto tile_extent = (uint32_t)std::min<uint64_t>(
+      param("tile_extent", 1024), domain());
+  ArraySchema schema(ctx_, TILEDB_SPARSE);
+  Domain dom(ctx_);
+  dom.add_dimension(
+      Dimension::create<uint32_t>(ctx_, "d1", {{1, domain()}}, tile_extent));
+  dom.add_dimension(
+      Dimension::create<uint32_t>(ctx_, "d2", {{1, domain()}}, tile_extent));
+  schema.set_domain(dom);
+  schema.set_capacity(param("capacity", 10000));
+  FilterList filters(ctx_);
+  filters.add_filter({ctx_, TILEDB_FILTER_BYTESHUFFLE})
+      .add_filter({ctx_, TILEDB_FILTER_LZ4});
+  schema.add_attribute(Attribute::create<int32_t>(ctx_, "a", filters));
+  Array::create(array_uri_, schema);
+}
+
+void SparseScenario::write_cells(
+    Array& array, uint64_t cell_num, std::mt19937_64* gen, double skew) {
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  std::vector<uint32_t> coords(2 * cell_num);
+  std::vector<int32_t> data(cell_num);
+  for (uint64_t i = 0; i < cell_num; i++) {
+    for (unsigned d = 0; d < 2; d++) {
+      auto c = (uint32_t)(domain() * std::pow(dist(*gen), skew));
+      coords[2 * i + d] = 1 + std::min<uint32_t>(c, domain() - 1);
+    }
+    data[i] = (int32_t)i;
+  }
+
+  Query query(ctx_, array);
+  query.set_layout(TILEDB_UNORDERED)
+      .set_buffer("a", data)
+      .set_coordinates(coords);
+  query.submit();
+}
+
+uint64_t SparseScenario::read_cells(
+    Array& array,
+    const std::array<uint32_t, 4>& subarray,
+    uint64_t buffer_cells,
+    uint64_t* submit_num) {
+  std::vector<uint32_t> coords(2 * buffer_cells);
+  std::vector<int32_t> data(buffer_cells);
+  std::vector<uint32_t> sub(subarray.begin(), subarray.end());
+
+  Query query(ctx_, array);
+  query.set_subarray(sub)
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", data)
+      .set_coordinates(coords);
+
+  uint64_t cell_num = 0, submits = 0;
+  Query::Status status;
+  do {
+    query.submit();
+    submits++;
+    status = query.query_status();
+    auto result_num = query.result_buffer_elements()["a"].second;
+    if (status == Query::Status::INCOMPLETE && result_num == 0)
+      throw std::runtime_error("Read buffers too small for a single cell");
+    cell_num += result_num;
+  } while (status == Query::Status::INCOMPLETE);
+
+  if (submit_num != nullptr)
+    *submit_num = submits;
+  return cell_num;
+}
+
+std::array<uint32_t, 4> SparseScenario::random_subarray(
+    std::mt19937_64* gen, uint32_t side) const {
+  side = std::max<uint32_t>(1, std::min(side, domain()));
+  std::uniform_int_distribution<uint32_t> dist(1, domain() - side + 1);
+  uint32_t r = dist(*gen), c = dist(*gen);
+  return {{r, r + side - 1, c, c + side - 1}};
+}
+
+uint32_t SparseScenario::domain() const {
+  return (uint32_t)std::max<uint64_t>(1, param("domain", 65536));
+}
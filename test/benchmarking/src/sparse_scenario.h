@@ -0,0 +1,115 @@
+/**
+ * @file   sparse_scenario.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Declares common code for the scenario benchmarks on sparse arrays.
+ */
+
+#ifndef TILEDB_SPARSE_SCENARIO_H
+#define TILEDB_SPARSE_SCENARIO_H
+
+#include <tiledb/tiledb>
+
+#include <array>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "scenario.h"
+
+/**
+ * Base class for scenarios on a 2D sparse array with `uint32_t` dimensions
+ * and a single `int32_t` attribute "a". The array is shaped by the
+ * parameters `domain` (the size of each dimension, default 65536),
+ * `tile_extent` (default 1024) and `capacity` (default 10000). Random cells
+ * may collide, so the writes deduplicate their coordinates.
+ */
+class SparseScenario : public ScenarioBase {
+ public:
+  /** Constructor. */
+  SparseScenario();
+
+ protected:
+  /** The TileDB context, shared by all clients. */
+  tiledb::Context ctx_;
+
+  /** The array URI. */
+  const std::string array_uri_ = "scenario_array";
+
+  /** Removes the array if it exists. */
+  virtual void teardown();
+
+  /** Creates the array. */
+  void create_array();
+
+  /**
+   * Writes the given number of cells at random coordinates to the array as
+   * a new fragment. Each coordinate is `domain * u^skew` for `u` uniform in
+   * `[0, 1)`, so a skew of 1 is uniform and larger skews cluster the cells
+   * towards the origin of the domain.
+   *
+   * @param array The array, opened for writes.
+   * @param cell_num The number of cells to write.
+   * @param gen The random generator.
+   * @param skew The skew of the coordinates.
+   */
+  void write_cells(
+      tiledb::Array& array,
+      uint64_t cell_num,
+      std::mt19937_64* gen,
+      double skew = 1.0);
+
+  /**
+   * Reads the given subarray to completion, with buffers of the given number
+   * of cells, resubmitting the query while it is incomplete.
+   *
+   * @param array The array, opened for reads.
+   * @param subarray The subarray to read.
+   * @param buffer_cells The number of cells the buffers can hold.
+   * @param submit_num Set to the number of submissions, if not `nullptr`.
+   * @return The number of cells read.
+   */
+  uint64_t read_cells(
+      tiledb::Array& array,
+      const std::array<uint32_t, 4>& subarray,
+      uint64_t buffer_cells,
+      uint64_t* submit_num = nullptr);
+
+  /**
+   * Returns a random square subarray with the given side length, which lies
+   * within the domain.
+   */
+  std::array<uint32_t, 4> random_subarray(
+      std::mt19937_64* gen, uint32_t side) const;
+
+  /** Returns the size of each dimension. */
+  uint32_t domain() const;
+};
+
+#endif
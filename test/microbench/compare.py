@@ -0,0 +1,83 @@
+#!/usr/bin/env python
+
+# Compares two Google Benchmark JSON result files (as written by
+# 'tiledb_microbench --benchmark_out=<file> --benchmark_out_format=json')
+# and exits with a non-zero status if any benchmark regressed by more than
+# the given threshold.
+
+import argparse
+import json
+import sys
+
+
+def load_results(path, metric):
+    with open(path) as f:
+        data = json.load(f)
+    results = {}
+    counts = {}
+    for b in data['benchmarks']:
+        if metric not in b:
+            continue
+        name = b.get('run_name', b['name'])
+        # Each repetition of a benchmark shares its run name, so key the
+        # individual runs by repetition and the median by its aggregate
+        # name. The other aggregates (mean, stddev, ...) are skipped.
+        if b.get('run_type') == 'aggregate':
+            if b.get('aggregate_name') != 'median':
+                continue
+            key = (name, 'median')
+        else:
+            repetition = b.get('repetition_index', counts.get(name, 0))
+            counts[name] = repetition + 1
+            key = (name, '#{}'.format(repetition))
+        results[key] = float(b[metric])
+    return results
+
+
+def label(key):
+    name, run = key
+    return name if run == '#0' else '{} [{}]'.format(name, run)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare two tiledb_microbench JSON result files.')
+    parser.add_argument('baseline', help='Baseline JSON results')
+    parser.add_argument('contender', help='New JSON results')
+    parser.add_argument('--metric', default='real_time',
+                        help='Benchmark field to compare (default: real_time)')
+    parser.add_argument('--threshold', type=float, default=0.10,
+                        help='Relative slowdown considered a regression '
+                             '(default: 0.10)')
+    args = parser.parse_args()
+
+    base = load_results(args.baseline, args.metric)
+    new = load_results(args.contender, args.metric)
+
+    regressions = []
+    print('{:<64} {:>14} {:>14} {:>9}'.format(
+        'Benchmark', 'Baseline', 'Contender', 'Change'))
+    for key in sorted(base):
+        if key not in new or base[key] == 0:
+            continue
+        change = (new[key] - base[key]) / base[key]
+        flag = ''
+        if change > args.threshold:
+            regressions.append(key)
+            flag = ' <-- regression'
+        print('{:<64} {:>14.2f} {:>14.2f} {:>+8.1f}%{}'.format(
+            label(key), base[key], new[key], change * 100, flag))
+
+    missing = sorted(set(base) - set(new))
+    for key in missing:
+        print('{:<64} missing from contender'.format(label(key)))
+
+    if regressions:
+        print('\n{} benchmark(s) regressed by more than {:.0f}%'.format(
+            len(regressions), args.threshold * 100))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,179 @@
+/**
+ * @file bench_crc32c.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks of the CRC32C checksum, per implementation and input size,
+ * and of its overhead on the reverse filter pipeline when the chunk checksums
+ * are verified.
+ */
+
+#include "test/microbench/src/microbench.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/misc/crc32c.h"
+#include "tiledb/sm/misc/simd.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tiledb::sm;
+using tiledb::sm::microbench::compute_tp;
+
+namespace {
+
+/** The labels of the implementations, indexed by the first argument. */
+const char* impl_names[] = {"portable", "sse42"};
+
+/** The number of `uint64_t` cells in the pipeline tiles (4 MB). */
+const uint64_t cell_num = 512 * 1024;
+
+/** The compressors checksummed in the pipeline benchmarks. */
+const FilterType codec_types[] = {FilterType::FILTER_NONE,
+                                  FilterType::FILTER_LZ4};
+
+/** The labels of `codec_types`. */
+const char* codec_names[] = {"none", "lz4"};
+
+/** Returns `size` random bytes. */
+std::vector<uint8_t> make_bytes(uint64_t size) {
+  std::mt19937_64 gen(0);
+  std::vector<uint8_t> bytes(size);
+  for (auto& b : bytes)
+    b = (uint8_t)gen();
+  return bytes;
+}
+
+/**
+ * Fills the input buffer with slowly increasing values, as in the filter
+ * pipeline benchmarks.
+ */
+void make_cells(Buffer* buff) {
+  std::mt19937_64 gen(0);
+  std::uniform_int_distribution<uint64_t> delta(0, 3);
+  uint64_t value = 1000;
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    buff->write(&value, sizeof(value));
+    value += delta(gen);
+  }
+}
+
+/** Registers the `(implementation, size)` arguments. */
+void crc32c_args(benchmark::internal::Benchmark* b) {
+  for (int64_t impl = 0; impl < 2; ++impl) {
+    for (int64_t size : {4 * 1024, 64 * 1024, 1024 * 1024})
+      b->Args({impl, size});
+  }
+}
+
+}  // namespace
+
+static void BM_Crc32c(benchmark::State& state) {
+  auto bytes = make_bytes((uint64_t)state.range(1));
+  bool sse42 = state.range(0) == 1;
+  uint32_t crc = 0;
+  if (sse42 && !(simd::detect_sse42() &&
+                 crc32c::sse42::extend(0, bytes.data(), 0, &crc))) {
+    state.SkipWithError("SSE4.2 kernel not available");
+    return;
+  }
+
+  for (auto _ : state) {
+    if (sse42)
+      crc32c::sse42::extend(0, bytes.data(), bytes.size(), &crc);
+    else
+      crc = crc32c::extend_portable(0, bytes.data(), bytes.size());
+    benchmark::DoNotOptimize(crc);
+  }
+
+  state.SetLabel(impl_names[state.range(0)]);
+  state.SetBytesProcessed(int64_t(state.iterations()) * bytes.size());
+}
+BENCHMARK(BM_Crc32c)
+    ->Apply(crc32c_args)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Runs the reverse pipeline of a compressor, with (second argument 1) and
+ * without a checksum filter verifying each 64 KB chunk. The difference
+ * between the two is the decode overhead of the checksum.
+ */
+static void BM_Crc32cPipelineReverse(benchmark::State& state) {
+  FilterPipeline pipeline;
+  std::unique_ptr<Filter> codec(Filter::create(codec_types[state.range(0)]));
+  pipeline.add_filter(*codec);
+  if (state.range(1) == 1) {
+    std::unique_ptr<Filter> checksum(
+        Filter::create(FilterType::FILTER_CHECKSUM_CRC32C));
+    pipeline.add_filter(*checksum);
+  }
+  pipeline.set_max_chunk_size(64 * 1024);
+  pipeline.set_verify_checksums(true);
+
+  // Filter the cells once
+  Buffer cells;
+  make_cells(&cells);
+  Buffer filtered;
+  filtered.write(cells.data(), cells.size());
+  Tile filtered_tile(Datatype::UINT64, sizeof(uint64_t), 0, &filtered, false);
+  if (!pipeline.run_forward(&filtered_tile, compute_tp()).ok()) {
+    state.SkipWithError("run_forward failed");
+    return;
+  }
+
+  Buffer buff;
+  Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+  for (auto _ : state) {
+    state.PauseTiming();
+    buff.reset_size();
+    buff.reset_offset();
+    buff.write(filtered.data(), filtered.size());
+    state.ResumeTiming();
+
+    if (!pipeline.run_reverse(&tile, compute_tp()).ok()) {
+      state.SkipWithError("run_reverse failed");
+      break;
+    }
+  }
+
+  state.SetLabel(
+      std::string(codec_names[state.range(0)]) +
+      (state.range(1) == 1 ? "+crc32c" : ""));
+  state.SetBytesProcessed(int64_t(state.iterations()) * cells.size());
+}
+BENCHMARK(BM_Crc32cPipelineReverse)
+    ->Args({0, 0})
+    ->Args({0, 1})
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
@@ -0,0 +1,183 @@
+/**
+ * @file bench_filter_pipeline.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks of the filter pipeline, running each filter type forward
+ * and in reverse over a tile, for several chunk sizes.
+ */
+
+#include "test/microbench/src/microbench.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace tiledb::sm;
+using tiledb::sm::microbench::compute_tp;
+
+namespace {
+
+/** The number of `uint64_t` cells in the benchmarked tiles (4 MB). */
+const uint64_t cell_num = 512 * 1024;
+
+/** The benchmarked filters, indexed by the first benchmark argument. */
+const FilterType filter_types[] = {FilterType::FILTER_NONE,
+                                   FilterType::FILTER_GZIP,
+                                   FilterType::FILTER_ZSTD,
+                                   FilterType::FILTER_LZ4,
+                                   FilterType::FILTER_RLE,
+                                   FilterType::FILTER_BZIP2,
+                                   FilterType::FILTER_DOUBLE_DELTA,
+                                   FilterType::FILTER_BIT_WIDTH_REDUCTION,
+                                   FilterType::FILTER_BITSHUFFLE,
+                                   FilterType::FILTER_BYTESHUFFLE,
+                                   FilterType::FILTER_POSITIVE_DELTA};
+
+/** The labels of `filter_types`. */
+const char* filter_names[] = {"none",
+                              "gzip",
+                              "zstd",
+                              "lz4",
+                              "rle",
+                              "bzip2",
+                              "double_delta",
+                              "bit_width_reduction",
+                              "bitshuffle",
+                              "byteshuffle",
+                              "positive_delta"};
+
+/** The benchmarked chunk sizes, in bytes. */
+const int64_t chunk_sizes[] = {16 * 1024, 64 * 1024, 1024 * 1024};
+
+/**
+ * Fills the input buffer with slowly increasing values, with runs of
+ * repeated values, resembling sorted coordinates or timestamps.
+ */
+void make_cells(Buffer* buff) {
+  std::mt19937_64 gen(0);
+  std::uniform_int_distribution<uint64_t> delta(0, 3);
+  buff->reset_size();
+  buff->reset_offset();
+  uint64_t value = 1000;
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    buff->write(&value, sizeof(value));
+    value += delta(gen);
+  }
+}
+
+/** Creates the pipeline of the benchmark arguments `(filter, chunk_size)`. */
+void make_pipeline(const benchmark::State& state, FilterPipeline* pipeline) {
+  std::unique_ptr<Filter> filter(Filter::create(filter_types[state.range(0)]));
+  pipeline->add_filter(*filter);
+  pipeline->set_max_chunk_size((uint32_t)state.range(1));
+}
+
+/** Registers the `(filter, chunk_size)` arguments. */
+void pipeline_args(benchmark::internal::Benchmark* b) {
+  for (unsigned f = 0; f < sizeof(filter_types) / sizeof(FilterType); ++f) {
+    for (auto chunk_size : chunk_sizes)
+      b->Args({f, chunk_size});
+  }
+}
+
+}  // namespace
+
+static void BM_FilterPipelineForward(benchmark::State& state) {
+  FilterPipeline pipeline;
+  make_pipeline(state, &pipeline);
+  Buffer cells;
+  make_cells(&cells);
+
+  Buffer buff;
+  Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+  uint64_t filtered_size = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    buff.reset_size();
+    buff.reset_offset();
+    buff.write(cells.data(), cells.size());
+    state.ResumeTiming();
+
+    if (!pipeline.run_forward(&tile, compute_tp()).ok()) {
+      state.SkipWithError("run_forward failed");
+      break;
+    }
+    filtered_size = buff.size();
+  }
+
+  state.SetLabel(filter_names[state.range(0)]);
+  state.SetBytesProcessed(int64_t(state.iterations()) * cells.size());
+  state.counters["ratio"] = double(cells.size()) / filtered_size;
+}
+BENCHMARK(BM_FilterPipelineForward)
+    ->Apply(pipeline_args)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+static void BM_FilterPipelineReverse(benchmark::State& state) {
+  FilterPipeline pipeline;
+  make_pipeline(state, &pipeline);
+  Buffer cells;
+  make_cells(&cells);
+
+  // Filter the cells once
+  Buffer filtered;
+  filtered.write(cells.data(), cells.size());
+  Tile filtered_tile(Datatype::UINT64, sizeof(uint64_t), 0, &filtered, false);
+  if (!pipeline.run_forward(&filtered_tile, compute_tp()).ok()) {
+    state.SkipWithError("run_forward failed");
+    return;
+  }
+
+  Buffer buff;
+  Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+  for (auto _ : state) {
+    state.PauseTiming();
+    buff.reset_size();
+    buff.reset_offset();
+    buff.write(filtered.data(), filtered.size());
+    state.ResumeTiming();
+
+    if (!pipeline.run_reverse(&tile, compute_tp()).ok()) {
+      state.SkipWithError("run_reverse failed");
+      break;
+    }
+  }
+
+  state.SetLabel(filter_names[state.range(0)]);
+  state.SetBytesProcessed(int64_t(state.iterations()) * cells.size());
+}
+BENCHMARK(BM_FilterPipelineReverse)
+    ->Apply(pipeline_args)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
@@ -0,0 +1,161 @@
+/**
+ * @file bench_fragment_metadata.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks of the (de)serialization of the metadata of sparse
+ * fragments, for several numbers of tiles.
+ */
+
+#include "test/microbench/src/microbench.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/uri.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using namespace tiledb::sm;
+using tiledb::sm::microbench::Access;
+using tiledb::sm::microbench::make_array_schema;
+
+namespace {
+
+/** The URI of the benchmark fragment, which is never accessed. */
+const char* fragment_uri = "file:///microbench_array/__fragment";
+
+/** Populates sparse fragment metadata with `tile_num` tiles. */
+Status make_fragment_metadata(uint64_t tile_num, FragmentMetadata* meta) {
+  const int64_t non_empty_domain[] = {0, 1024 * 1024 - 1, 0, 1024 * 1024 - 1};
+  RETURN_NOT_OK(meta->init(non_empty_domain));
+  RETURN_NOT_OK(meta->set_num_tiles(tile_num));
+  for (uint64_t t = 0; t < tile_num; ++t) {
+    int64_t lo = (int64_t)t % 1024 * 1024;
+    int64_t mbr[] = {lo, lo + 1023, lo, lo + 1023};
+    int64_t bounding_coords[] = {lo, lo, lo + 1023, lo + 1023};
+    RETURN_NOT_OK(meta->set_mbr(t, mbr));
+    meta->set_bounding_coords(t, bounding_coords);
+    meta->set_tile_offset("a", t, 4096);
+    meta->set_tile_offset(constants::coords, t, 16384);
+    meta->set_tile_offset("v", t, 8192);
+    meta->set_tile_var_offset("v", t, 10000 + t % 100);
+    meta->set_tile_var_size("v", t, 10000 + t % 100);
+  }
+  meta->set_last_tile_cell_num(1000);
+  return Status::Ok();
+}
+
+/**
+ * Serializes the metadata sections into `sections` and the footer into
+ * `footer`.
+ */
+Status serialize(
+    FragmentMetadata* meta,
+    std::vector<std::unique_ptr<Buffer>>* sections,
+    Buffer* footer) {
+  std::vector<uint64_t> section_offsets;
+  uint64_t offset = 0;
+  sections->resize(meta->section_num());
+  for (unsigned s = 0; s < meta->section_num(); ++s) {
+    (*sections)[s].reset(new Buffer());
+    RETURN_NOT_OK(meta->serialize_section(s, (*sections)[s].get()));
+    section_offsets.push_back(offset);
+    offset += (*sections)[s]->size();
+  }
+  return meta->serialize_footer(section_offsets, footer);
+}
+
+}  // namespace
+
+static void BM_FragmentMetadataSerialize(benchmark::State& state) {
+  ArraySchema array_schema(ArrayType::SPARSE);
+  make_array_schema(&array_schema);
+  FragmentMetadata meta(&array_schema, false, URI(fragment_uri), 0);
+  if (!make_fragment_metadata(state.range(0), &meta).ok()) {
+    state.SkipWithError("Creating fragment metadata failed");
+    return;
+  }
+
+  uint64_t size = 0;
+  for (auto _ : state) {
+    std::vector<std::unique_ptr<Buffer>> sections;
+    Buffer footer;
+    if (!serialize(&meta, &sections, &footer).ok()) {
+      state.SkipWithError("Serializing fragment metadata failed");
+      break;
+    }
+    size = footer.size();
+    for (const auto& section : sections)
+      size += section->size();
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * size);
+}
+BENCHMARK(BM_FragmentMetadataSerialize)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_FragmentMetadataDeserialize(benchmark::State& state) {
+  ArraySchema array_schema(ArrayType::SPARSE);
+  make_array_schema(&array_schema);
+  std::vector<std::unique_ptr<Buffer>> sections;
+  Buffer footer;
+  {
+    FragmentMetadata meta(&array_schema, false, URI(fragment_uri), 0);
+    if (!make_fragment_metadata(state.range(0), &meta).ok() ||
+        !serialize(&meta, &sections, &footer).ok()) {
+      state.SkipWithError("Creating fragment metadata failed");
+      return;
+    }
+  }
+
+  for (auto _ : state) {
+    FragmentMetadata meta(&array_schema, false, URI(fragment_uri), 0);
+    ConstBuffer footer_buff(&footer);
+    bool ok = meta.deserialize(&footer_buff).ok();
+    for (unsigned s = 0; ok && s < meta.section_num(); ++s) {
+      ConstBuffer section_buff(sections[s].get());
+      ok = Access::load_section(&meta, s, &section_buff).ok();
+    }
+    if (!ok) {
+      state.SkipWithError("Deserializing fragment metadata failed");
+      break;
+    }
+  }
+
+  uint64_t size = footer.size();
+  for (const auto& section : sections)
+    size += section->size();
+  state.SetBytesProcessed(int64_t(state.iterations()) * size);
+}
+BENCHMARK(BM_FragmentMetadataDeserialize)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
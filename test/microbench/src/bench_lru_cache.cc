@@ -0,0 +1,128 @@
+/**
+ * @file bench_lru_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks of the LRU cache under contention, with several threads
+ * reading from and inserting into a shared cache.
+ */
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/cache/lru_cache.h"
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tiledb::sm;
+
+namespace {
+
+/** The size of the cached objects. */
+const uint64_t object_size = 4 * 1024;
+
+/** The number of objects the cache holds. */
+const uint64_t cached_num = 4096;
+
+/** The cache shared by the benchmark threads. */
+std::unique_ptr<LRUCache> cache;
+
+/** The object keys, of which the first `cached_num` are cached initially. */
+std::vector<std::string> keys;
+
+/** Inserts a new object with the input key into the shared cache. */
+void insert(const std::string& key) {
+  auto object = std::malloc(object_size);
+  std::memset(object, 0, object_size);
+  cache->insert(key, object, object_size);
+}
+
+/**
+ * Creates the shared cache, filling it with `cached_num` objects. The keys
+ * span `key_num` objects.
+ */
+void setup_cache(uint64_t key_num) {
+  cache.reset(new LRUCache(cached_num * object_size));
+  keys.clear();
+  for (uint64_t i = 0; i < key_num; ++i)
+    keys.emplace_back("file:///array/__fragment/a.tdb/" + std::to_string(i));
+  for (uint64_t i = 0; i < cached_num; ++i)
+    insert(keys[i]);
+}
+
+}  // namespace
+
+static void BM_LRUCacheRead(benchmark::State& state) {
+  if (state.thread_index() == 0)
+    setup_cache(cached_num);
+
+  // All reads hit
+  std::mt19937 gen(state.thread_index());
+  std::uniform_int_distribution<uint64_t> key(0, cached_num - 1);
+  Buffer buffer;
+  for (auto _ : state) {
+    bool success;
+    buffer.reset_size();
+    buffer.reset_offset();
+    cache->read(keys[key(gen)], &buffer, 0, 256, &success);
+    benchmark::DoNotOptimize(success);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0)
+    cache.reset();
+}
+BENCHMARK(BM_LRUCacheRead)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_LRUCacheReadInsert(benchmark::State& state) {
+  if (state.thread_index() == 0)
+    setup_cache(2 * cached_num);
+
+  // Reads over twice the cached objects, inserting the missed objects and
+  // thus evicting others
+  std::mt19937 gen(state.thread_index());
+  std::uniform_int_distribution<uint64_t> key(0, 2 * cached_num - 1);
+  Buffer buffer;
+  for (auto _ : state) {
+    const auto& k = keys[key(gen)];
+    bool success;
+    buffer.reset_size();
+    buffer.reset_offset();
+    cache->read(k, &buffer, 0, 256, &success);
+    if (!success)
+      insert(k);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0)
+    cache.reset();
+}
+BENCHMARK(BM_LRUCacheReadInsert)->ThreadRange(1, 16)->UseRealTime();
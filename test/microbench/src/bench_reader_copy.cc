@@ -0,0 +1,175 @@
+/**
+ * @file bench_reader_copy.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks of the copy of result cells from the attribute tiles into
+ * the user buffers (`Reader::copy_fixed_cells` and `Reader::copy_var_cells`),
+ * for several cell range lengths.
+ */
+
+#include "test/microbench/src/microbench.h"
+#include "tiledb/sm/query/reader.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+using namespace tiledb::sm;
+using tiledb::sm::microbench::Access;
+using tiledb::sm::microbench::make_array_schema;
+
+namespace {
+
+/** The number of cells in the benchmarked fixed-sized tile. */
+const uint64_t fixed_cell_num = 1024 * 1024;
+
+/** The number of cells in the benchmarked var-sized tile. */
+const uint64_t var_cell_num = 256 * 1024;
+
+/** Initializes a storage manager and array schema for the benchmarks. */
+struct ReaderFixture {
+  StorageManager storage_manager_;
+  ArraySchema array_schema_;
+  Reader reader_;
+
+  ReaderFixture()
+      : array_schema_(ArrayType::SPARSE) {
+    storage_manager_.init(nullptr);
+    make_array_schema(&array_schema_);
+    reader_.set_storage_manager(&storage_manager_);
+    reader_.set_array_schema(&array_schema_);
+  }
+};
+
+/**
+ * Splits `[0, cell_num)` into consecutive cell ranges of the input length
+ * on the input tile.
+ */
+Reader::OverlappingCellRangeList make_cell_ranges(
+    const Reader::OverlappingTile* tile, uint64_t cell_num, uint64_t length) {
+  Reader::OverlappingCellRangeList cell_ranges;
+  for (uint64_t start = 0; start < cell_num; start += length)
+    cell_ranges.emplace_back(
+        tile, start, std::min(start + length, cell_num) - 1);
+  return cell_ranges;
+}
+
+}  // namespace
+
+static void BM_ReaderCopyFixedCells(benchmark::State& state) {
+  ReaderFixture fixture;
+  Reader::OverlappingTile tile(0, 0, {"a"});
+  auto& attr_tile = tile.attr_tiles_["a"].first;
+  attr_tile.init(
+      constants::format_version,
+      Datatype::INT32,
+      fixed_cell_num * sizeof(int32_t),
+      sizeof(int32_t),
+      0);
+  std::vector<int32_t> cells(fixed_cell_num);
+  for (uint64_t i = 0; i < fixed_cell_num; ++i)
+    cells[i] = (int32_t)i;
+  attr_tile.write(cells.data(), cells.size() * sizeof(int32_t));
+  auto cell_ranges = make_cell_ranges(&tile, fixed_cell_num, state.range(0));
+
+  std::vector<int32_t> buffer(fixed_cell_num);
+  uint64_t buffer_size = 0;
+  fixture.reader_.set_buffer("a", buffer.data(), &buffer_size);
+  for (auto _ : state) {
+    buffer_size = buffer.size() * sizeof(int32_t);
+    if (!Access::copy_fixed_cells(&fixture.reader_, "a", cell_ranges).ok()) {
+      state.SkipWithError("copy_fixed_cells failed");
+      break;
+    }
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * buffer_size);
+}
+BENCHMARK(BM_ReaderCopyFixedCells)
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 16)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+static void BM_ReaderCopyVarCells(benchmark::State& state) {
+  ReaderFixture fixture;
+  Reader::OverlappingTile tile(0, 0, {"v"});
+  auto& offsets_tile = tile.attr_tiles_["v"].first;
+  auto& values_tile = tile.attr_tiles_["v"].second;
+  offsets_tile.init(
+      constants::format_version,
+      Datatype::UINT64,
+      var_cell_num * sizeof(uint64_t),
+      sizeof(uint64_t),
+      0);
+  values_tile.init(
+      constants::format_version, Datatype::CHAR, 16 * var_cell_num, 1, 0);
+
+  // Cells of 0 to 16 characters
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<uint64_t> cell_size(0, 16);
+  std::vector<uint64_t> offsets(var_cell_num);
+  std::string values;
+  for (uint64_t i = 0; i < var_cell_num; ++i) {
+    offsets[i] = values.size();
+    values.append(cell_size(gen), 'a' + (i % 26));
+  }
+  offsets_tile.write(offsets.data(), offsets.size() * sizeof(uint64_t));
+  values_tile.write(values.data(), values.size());
+  auto cell_ranges = make_cell_ranges(&tile, var_cell_num, state.range(0));
+
+  std::vector<uint64_t> buffer_off(var_cell_num);
+  uint64_t buffer_off_size = 0;
+  std::vector<char> buffer_val(values.size());
+  uint64_t buffer_val_size = 0;
+  fixture.reader_.set_buffer(
+      "v",
+      buffer_off.data(),
+      &buffer_off_size,
+      buffer_val.data(),
+      &buffer_val_size);
+  for (auto _ : state) {
+    buffer_off_size = buffer_off.size() * sizeof(uint64_t);
+    buffer_val_size = buffer_val.size();
+    if (!Access::copy_var_cells(&fixture.reader_, "v", cell_ranges).ok()) {
+      state.SkipWithError("copy_var_cells failed");
+      break;
+    }
+    benchmark::DoNotOptimize(buffer_val.data());
+  }
+
+  state.SetBytesProcessed(
+      int64_t(state.iterations()) * (buffer_off_size + buffer_val_size));
+}
+BENCHMARK(BM_ReaderCopyVarCells)
+    ->RangeMultiplier(16)
+    ->Range(1, 1 << 16)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
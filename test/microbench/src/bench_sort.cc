@@ -0,0 +1,169 @@
+/**
+ * @file bench_sort.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks of the coordinate sorts of reads and writes, in the global
+ * order (`GlobalCmp`) and in row-major order (`RowCmp`).
+ */
+
+#include "test/microbench/src/microbench.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/misc/comparators.h"
+#include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/query/reader.h"
+
+#include <benchmark/benchmark.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace tiledb::sm;
+using tiledb::sm::microbench::compute_tp;
+
+namespace {
+
+/** The domain of both dimensions of the 2D benchmark domain. */
+const int64_t dim_domain[] = {0, 1024 * 1024 - 1};
+
+/** The tile extent of both dimensions. */
+const int64_t tile_extent = 1024;
+
+/** Sorted coordinates of a benchmark, with their tile coordinates. */
+struct Coords {
+  /** The coordinates, zipped. */
+  std::vector<int64_t> coords_;
+  /** The tile coordinates of the coordinates, zipped. */
+  std::vector<int64_t> tile_coords_;
+  /** The overlapping coordinates pointing into the vectors above. */
+  std::vector<Reader::OverlappingCoords<int64_t>> overlapping_;
+};
+
+/** Creates the 2D benchmark domain with row-major tile and cell orders. */
+void make_domain(Domain* domain) {
+  for (const char* name : {"d1", "d2"}) {
+    Dimension dim(name, Datatype::INT64);
+    dim.set_domain(dim_domain);
+    dim.set_tile_extent(&tile_extent);
+    domain->add_dimension(&dim);
+  }
+  domain->init(Layout::ROW_MAJOR, Layout::ROW_MAJOR);
+}
+
+/** Generates `num` random 2D coordinates. */
+void make_coords(uint64_t num, Coords* coords) {
+  std::mt19937_64 gen(0);
+  std::uniform_int_distribution<int64_t> dist(dim_domain[0], dim_domain[1]);
+  coords->coords_.resize(2 * num);
+  coords->tile_coords_.resize(2 * num);
+  for (uint64_t i = 0; i < 2 * num; ++i) {
+    coords->coords_[i] = dist(gen);
+    coords->tile_coords_[i] = coords->coords_[i] / tile_extent;
+  }
+  coords->overlapping_.clear();
+  coords->overlapping_.reserve(num);
+  for (uint64_t i = 0; i < num; ++i) {
+    coords->overlapping_.emplace_back(nullptr, &coords->coords_[2 * i], i);
+    coords->overlapping_.back().tile_coords_ = &coords->tile_coords_[2 * i];
+  }
+}
+
+}  // namespace
+
+static void BM_SortOverlappingCoordsGlobal(benchmark::State& state) {
+  Domain domain(Datatype::INT64);
+  make_domain(&domain);
+  Coords coords;
+  make_coords(state.range(0), &coords);
+
+  std::vector<Reader::OverlappingCoords<int64_t>> sorted;
+  for (auto _ : state) {
+    state.PauseTiming();
+    sorted = coords.overlapping_;
+    state.ResumeTiming();
+    parallel_sort(
+        compute_tp(),
+        sorted.begin(),
+        sorted.end(),
+        GlobalCmp<int64_t>(&domain));
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SortOverlappingCoordsGlobal)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+static void BM_SortOverlappingCoordsRow(benchmark::State& state) {
+  Coords coords;
+  make_coords(state.range(0), &coords);
+
+  std::vector<Reader::OverlappingCoords<int64_t>> sorted;
+  for (auto _ : state) {
+    state.PauseTiming();
+    sorted = coords.overlapping_;
+    state.ResumeTiming();
+    parallel_sort(
+        compute_tp(), sorted.begin(), sorted.end(), RowCmp<int64_t>(2));
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SortOverlappingCoordsRow)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+static void BM_SortCellPositionsGlobal(benchmark::State& state) {
+  Domain domain(Datatype::INT64);
+  make_domain(&domain);
+  Coords coords;
+  make_coords(state.range(0), &coords);
+
+  std::vector<uint64_t> cell_pos(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::iota(cell_pos.begin(), cell_pos.end(), 0);
+    state.ResumeTiming();
+    parallel_sort(
+        compute_tp(),
+        cell_pos.begin(),
+        cell_pos.end(),
+        GlobalCmp<int64_t>(&domain, coords.coords_.data()));
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SortCellPositionsGlobal)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
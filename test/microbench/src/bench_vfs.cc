@@ -0,0 +1,84 @@
+/**
+ * @file bench_vfs.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks of the batching of the regions of multi-region VFS reads
+ * (`VFS::compute_read_batches`).
+ */
+
+#include "test/microbench/src/microbench.h"
+#include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/storage_manager/config.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace tiledb::sm;
+using tiledb::sm::microbench::Access;
+
+static void BM_VFSComputeReadBatches(benchmark::State& state) {
+  VFS vfs;
+  if (!vfs.init(Config().vfs_params()).ok()) {
+    state.SkipWithError("VFS init failed");
+    return;
+  }
+
+  // Regions of 1 KB to 64 KB separated by gaps of up to 16 KB, resembling
+  // the tiles of a read, submitted out of order
+  std::mt19937_64 gen(0);
+  std::uniform_int_distribution<uint64_t> size(1024, 64 * 1024);
+  std::uniform_int_distribution<uint64_t> gap(0, 16 * 1024);
+  std::vector<std::tuple<uint64_t, void*, uint64_t>> regions;
+  uint64_t offset = 0;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    offset += gap(gen);
+    auto nbytes = size(gen);
+    regions.emplace_back(offset, nullptr, nbytes);
+    offset += nbytes;
+  }
+  std::shuffle(regions.begin(), regions.end(), gen);
+
+  std::vector<Access::BatchedRead> batches;
+  for (auto _ : state) {
+    batches.clear();
+    if (!Access::compute_read_batches(vfs, regions, &batches).ok()) {
+      state.SkipWithError("compute_read_batches failed");
+      break;
+    }
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+  state.counters["batches"] = batches.size();
+}
+BENCHMARK(BM_VFSComputeReadBatches)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 16)
+    ->Unit(benchmark::kMicrosecond);
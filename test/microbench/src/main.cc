@@ -1,11 +1,11 @@
 /**
- * @file   unit-tbb.cc
+ * @file main.cc
  *
  * @section LICENSE
  *
  * The MIT License
  *
- * @copyright Copyright (c) 2017 TileDB, Inc.
+ * @copyright Copyright (c) 2018 TileDB, Inc.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -27,27 +27,9 @@
  *
  * @section DESCRIPTION
  *
- * Tests for TileDB TBB thread runtime support
+ * Entry point of the micro-benchmark suite.
  */
 
-#ifdef HAVE_TBB
+#include <benchmark/benchmark.h>
 
-#include "catch.hpp"
-#include "tiledb/sm/cpp_api/tiledb"
-
-TEST_CASE("TileDB TBB negative number of set threads", "[tbb]") {
-  tiledb::Config config;
-  config["sm.num_tbb_threads"] = "-3";
-  CHECK_THROWS(tiledb::Context(config));
-}
-
-TEST_CASE("TileDB TBB different number of set threads per process", "[tbb]") {
-  // default number of TBB threads
-  auto ctx1 = tiledb::Context();
-
-  tiledb::Config config;
-  config["sm.num_tbb_threads"] = "1000";
-  CHECK_THROWS(tiledb::Context(config));
-}
-
-#endif
+BENCHMARK_MAIN();
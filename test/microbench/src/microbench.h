@@ -0,0 +1,139 @@
+/**
+ * @file microbench.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Helpers shared by the micro-benchmarks.
+ */
+
+#ifndef TILEDB_MICROBENCH_H
+#define TILEDB_MICROBENCH_H
+
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/thread_pool.h"
+#include "tiledb/sm/query/reader.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+namespace microbench {
+
+/**
+ * Gives the benchmarks access to the internal kernels they time, which are
+ * private to their classes.
+ */
+class Access {
+ public:
+  /** A batched read of `VFS::compute_read_batches`. */
+  typedef VFS::BatchedRead BatchedRead;
+
+  /** Calls `VFS::compute_read_batches`. */
+  static Status compute_read_batches(
+      const VFS& vfs,
+      const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions,
+      std::vector<BatchedRead>* batches) {
+    return vfs.compute_read_batches(regions, batches);
+  }
+
+  /** Calls `Reader::copy_fixed_cells`. */
+  static Status copy_fixed_cells(
+      Reader* reader,
+      const std::string& attribute,
+      const Reader::OverlappingCellRangeList& cell_ranges) {
+    return reader->copy_fixed_cells(attribute, cell_ranges);
+  }
+
+  /** Calls `Reader::copy_var_cells`. */
+  static Status copy_var_cells(
+      Reader* reader,
+      const std::string& attribute,
+      const Reader::OverlappingCellRangeList& cell_ranges) {
+    return reader->copy_var_cells(attribute, cell_ranges);
+  }
+
+  /** Calls `FragmentMetadata::load_section`. */
+  static Status load_section(
+      FragmentMetadata* meta, unsigned section, ConstBuffer* buff) {
+    return meta->load_section(section, buff);
+  }
+};
+
+/**
+ * Returns the compute thread pool shared by all benchmarks, sized to the
+ * number of hardware threads as the storage manager's default.
+ */
+inline ThreadPool* compute_tp() {
+  static std::unique_ptr<ThreadPool> tp;
+  if (tp == nullptr) {
+    tp.reset(new ThreadPool());
+    tp->init(std::max(1u, std::thread::hardware_concurrency()));
+  }
+  return tp.get();
+}
+
+/**
+ * Initializes the schema of the benchmark arrays: a 2D `int64` domain of
+ * `[0, 2^20)` along each dimension, with `1024 x 1024` tiles, a fixed-sized
+ * `int32` attribute `a` and a var-sized `char` attribute `v`.
+ */
+inline Status make_array_schema(ArraySchema* schema) {
+  const int64_t dim_domain[] = {0, 1024 * 1024 - 1};
+  const int64_t tile_extent = 1024;
+  Domain domain(Datatype::INT64);
+  for (const char* name : {"d1", "d2"}) {
+    Dimension dim(name, Datatype::INT64);
+    RETURN_NOT_OK(dim.set_domain(dim_domain));
+    RETURN_NOT_OK(dim.set_tile_extent(&tile_extent));
+    RETURN_NOT_OK(domain.add_dimension(&dim));
+  }
+  RETURN_NOT_OK(schema->set_domain(&domain));
+
+  Attribute a("a", Datatype::INT32);
+  RETURN_NOT_OK(schema->add_attribute(&a));
+  Attribute v("v", Datatype::CHAR);
+  RETURN_NOT_OK(v.set_cell_val_num(constants::var_num));
+  RETURN_NOT_OK(schema->add_attribute(&v));
+  return schema->init();
+}
+
+}  // namespace microbench
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_MICROBENCH_H
@@ -86,6 +86,51 @@ TEST_CASE(
     REQUIRE(a_read[i] == i + 1);
 }
 
+TEST_CASE(
+    "Backwards compatibility: Test reading 1.5.0 sparse array with "
+    "non-sectioned fragment metadata",
+    "[backwards-compat]") {
+  // The array was written with format version 2, which stores the metadata
+  // of each fragment in a single generic tile. The second fragment
+  // overwrites cell (2, 1) and adds cell (4, 1)
+  Context ctx;
+  std::string array_uri(arrays_dir + "/sparse_array_v1_5_0");
+  Array array(ctx, array_uri, TILEDB_READ);
+  std::vector<int> subarray = {1, 4, 1, 4};
+  auto max_el = array.max_buffer_elements(subarray);
+  REQUIRE(max_el["a"].second >= 6);
+  REQUIRE(max_el["b"].first >= 6);
+  REQUIRE(max_el["b"].second >= 15);
+  std::vector<int> a_read(max_el["a"].second);
+  std::vector<uint64_t> b_off_read(max_el["b"].first);
+  std::string b_read;
+  b_read.resize(max_el["b"].second);
+  std::vector<int> coords_read(max_el[TILEDB_COORDS].second);
+
+  Query query_r(ctx, array);
+  query_r.set_subarray(subarray)
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_read)
+      .set_buffer("b", b_off_read, b_read)
+      .set_coordinates(coords_read);
+  query_r.submit();
+  REQUIRE(query_r.query_status() == Query::Status::COMPLETE);
+  array.close();
+
+  auto result_el = query_r.result_buffer_elements();
+  REQUIRE(result_el["a"].second == 6);
+  REQUIRE(result_el["b"].first == 6);
+  REQUIRE(result_el["b"].second == 15);
+  a_read.resize(6);
+  b_off_read.resize(6);
+  b_read.resize(15);
+  coords_read.resize(12);
+  CHECK(a_read == std::vector<int>({1, 2, 30, 4, 6, 5}));
+  CHECK(b_off_read == std::vector<uint64_t>({0, 1, 3, 5, 9, 10}));
+  CHECK(b_read == "abbxyddddzeeeee");
+  CHECK(coords_read == std::vector<int>({1, 1, 1, 2, 2, 1, 3, 3, 4, 1, 4, 4}));
+}
+
 TEST_CASE(
     "Backwards compatibility: Test reading arrays written with previous "
     "version of tiledb",
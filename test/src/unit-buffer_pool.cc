@@ -0,0 +1,170 @@
+/**
+ * @file unit-buffer_pool.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests class BufferPool.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/buffer_pool.h"
+#include "tiledb/sm/misc/constants.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+using namespace tiledb::sm;
+
+TEST_CASE("BufferPool: Test acquire and release", "[buffer-pool]") {
+  const uint64_t min_size = constants::buffer_pool_min_class_size;
+  BufferPool pool(8 * min_size);
+
+  // Requests are rounded up to the next size class
+  CHECK(pool.block_size(min_size + 1) == 2 * min_size);
+  CHECK(pool.block_size(3 * min_size) == 4 * min_size);
+  void* data = pool.acquire(min_size + 1);
+  REQUIRE(data != nullptr);
+  CHECK(pool.pooled_size() == 0);
+
+  // Released blocks are reused for requests of the same class
+  pool.release(data, min_size + 1);
+  CHECK(pool.pooled_size() == 2 * min_size);
+  void* data2 = pool.acquire(2 * min_size);
+  CHECK(data2 == data);
+  CHECK(pool.pooled_size() == 0);
+
+  // Requests of a different class get a new block
+  void* data3 = pool.acquire(3 * min_size);
+  REQUIRE(data3 != nullptr);
+  CHECK(data3 != data2);
+  pool.release(data2, 2 * min_size);
+  pool.release(data3, 3 * min_size);
+  CHECK(pool.pooled_size() == 6 * min_size);
+
+  // Releasing beyond the pool size frees the block instead
+  void* data4 = pool.acquire(4 * min_size);
+  void* data5 = pool.acquire(4 * min_size);
+  void* data6 = pool.acquire(4 * min_size);
+  CHECK(data4 == data3);
+  pool.release(data4, 4 * min_size);
+  pool.release(data5, 4 * min_size);
+  pool.release(data6, 4 * min_size);
+  CHECK(pool.pooled_size() == 6 * min_size);
+
+  // Small and large requests bypass the size classes
+  CHECK(pool.block_size(min_size - 1) == min_size - 1);
+  CHECK(pool.block_size(16 * min_size) == 16 * min_size);
+  void* small = pool.acquire(min_size - 1);
+  pool.release(small, min_size - 1);
+  void* large = pool.acquire(16 * min_size);
+  pool.release(large, 16 * min_size);
+  CHECK(pool.pooled_size() == 6 * min_size);
+
+  // Disowned blocks are freed by their new owner
+  void* data7 = pool.acquire(min_size);
+  pool.disown(min_size);
+  std::free(data7);
+  CHECK(pool.pooled_size() == 6 * min_size);
+}
+
+TEST_CASE("BufferPool: Test disabled pool", "[buffer-pool]") {
+  const uint64_t min_size = constants::buffer_pool_min_class_size;
+  BufferPool pool(0);
+  CHECK(pool.block_size(min_size + 1) == min_size + 1);
+  void* data = pool.acquire(min_size);
+  REQUIRE(data != nullptr);
+  pool.release(data, min_size);
+  CHECK(pool.pooled_size() == 0);
+}
+
+TEST_CASE("BufferPool: Test unbounded pool size", "[buffer-pool]") {
+  // The number of size classes is bounded even for the largest pool size
+  const uint64_t min_size = constants::buffer_pool_min_class_size;
+  BufferPool pool(std::numeric_limits<uint64_t>::max());
+  auto max_class_size = min_size << (constants::buffer_pool_max_class_num - 1);
+  CHECK(pool.block_size(min_size + 1) == 2 * min_size);
+  CHECK(pool.block_size(max_class_size) == max_class_size);
+  CHECK(pool.block_size(max_class_size + 1) == max_class_size + 1);
+}
+
+TEST_CASE("BufferPool: Test pooled buffers", "[buffer-pool]") {
+  const uint64_t min_size = constants::buffer_pool_min_class_size;
+  BufferPool pool(8 * min_size);
+
+  // Reallocation preserves the contents and returns the old block
+  Buffer buff(&pool);
+  CHECK(buff.pool() == &pool);
+  char c = 'a';
+  for (uint64_t i = 0; i < min_size; ++i)
+    REQUIRE(buff.write(&c, sizeof(char)).ok());
+  CHECK(buff.alloced_size() == min_size);
+  REQUIRE(buff.write(&c, sizeof(char)).ok());
+  CHECK(buff.alloced_size() == 2 * min_size);
+  CHECK(pool.pooled_size() == min_size);
+  for (uint64_t i = 0; i <= min_size; ++i)
+    CHECK(buff.value<char>(i) == 'a');
+
+  // The allocated size is the requested one, even if the block is larger
+  void* data = buff.data();
+  REQUIRE(buff.realloc(3 * min_size).ok());
+  CHECK(buff.alloced_size() == 3 * min_size);
+  CHECK(buff.data() != data);
+  data = buff.data();
+  REQUIRE(buff.realloc(4 * min_size).ok());
+  CHECK(buff.alloced_size() == 4 * min_size);
+  CHECK(buff.data() == data);
+  CHECK(pool.pooled_size() == 3 * min_size);
+
+  // Clearing returns the block to the pool
+  buff.clear();
+  CHECK(pool.pooled_size() == 7 * min_size);
+
+  // Swapping exchanges the pools along with the data
+  Buffer buff2;
+  REQUIRE(buff.realloc(min_size).ok());
+  CHECK(pool.pooled_size() == 6 * min_size);
+  REQUIRE(buff.swap(buff2).ok());
+  CHECK(buff.pool() == nullptr);
+  CHECK(buff2.pool() == &pool);
+  buff2.clear();
+  CHECK(pool.pooled_size() == 7 * min_size);
+
+  // Copies do not allocate from the pool
+  REQUIRE(buff2.realloc(min_size).ok());
+  Buffer buff3(buff2);
+  CHECK(buff3.pool() == nullptr);
+
+  // Disowned data leaves the pool
+  data = buff2.data();
+  buff2.disown_data();
+  CHECK(buff2.pool() == nullptr);
+  buff2.clear();
+  CHECK(pool.pooled_size() == 6 * min_size);
+  std::free(data);
+}
@@ -35,6 +35,11 @@
 #include "tiledb/sm/c_api/tiledb.h"
 
 #include <cstring>
+#include <set>
+
+#ifndef _WIN32
+#include <poll.h>
+#endif
 
 /** Tests for C API async queries. */
 struct AsyncFx {
@@ -57,6 +62,7 @@ struct AsyncFx {
   void write_sparse_async_cancelled();
   void read_dense_async();
   void read_sparse_async();
+  void read_dense_async_cq();
   void remove_dense_array();
   void remove_sparse_array();
   void remove_array(const std::string& array_name);
@@ -749,6 +755,102 @@ void AsyncFx::read_sparse_async() {
   free(buffer_coords);
 }
 
+void AsyncFx::read_dense_async_cq() {
+  // Open array
+  tiledb_array_t* array;
+  int rc = tiledb_array_alloc(ctx_, DENSE_ARRAY_NAME, &array);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  CHECK(rc == TILEDB_OK);
+
+  // Create completion queue
+  tiledb_completion_queue_t* cq;
+  rc = tiledb_completion_queue_alloc(ctx_, &cq);
+  REQUIRE(rc == TILEDB_OK);
+  int32_t fd;
+  rc = tiledb_completion_queue_get_fd(ctx_, cq, &fd);
+  CHECK(rc == TILEDB_OK);
+
+  // The queue is initially empty
+  void* tag = nullptr;
+  tiledb_query_status_t status;
+  int32_t has_event;
+  rc = tiledb_completion_queue_poll(ctx_, cq, &tag, &status, &has_event);
+  CHECK(rc == TILEDB_OK);
+  CHECK(has_event == 0);
+  rc = tiledb_completion_queue_wait(ctx_, cq, 0, &tag, &status, &has_event);
+  CHECK(rc == TILEDB_OK);
+  CHECK(has_event == 0);
+
+  // Submit one query per row of the array, tagged with the row index
+  const int query_num = 4;
+  tiledb_query_t* queries[query_num];
+  int buffer_a1[query_num][4];
+  uint64_t buffer_a1_size[query_num];
+  for (int i = 0; i < query_num; ++i) {
+    uint64_t subarray[] = {(uint64_t)i + 1, (uint64_t)i + 1, 1, 4};
+    buffer_a1_size[i] = sizeof(buffer_a1[i]);
+    rc = tiledb_query_alloc(ctx_, array, TILEDB_READ, &queries[i]);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, queries[i], TILEDB_ROW_MAJOR);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_subarray(ctx_, queries[i], subarray);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffer(
+        ctx_, queries[i], "a1", buffer_a1[i], &buffer_a1_size[i]);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_submit_async_cq(ctx_, queries[i], cq, &queries[i]);
+    CHECK(rc == TILEDB_OK);
+  }
+
+#ifndef _WIN32
+  // The descriptor becomes readable once an event is posted
+  CHECK(fd != -1);
+  struct pollfd pfd = {fd, POLLIN, 0};
+  CHECK(poll(&pfd, 1, 10000) == 1);
+  CHECK((pfd.revents & POLLIN) != 0);
+#endif
+
+  // Retrieve exactly one event per query
+  std::set<void*> tags;
+  for (int i = 0; i < query_num; ++i) {
+    rc = tiledb_completion_queue_wait(
+        ctx_, cq, -1, &tag, &status, &has_event);
+    CHECK(rc == TILEDB_OK);
+    CHECK(has_event == 1);
+    CHECK(status == TILEDB_COMPLETED);
+    tags.insert(tag);
+  }
+  CHECK(tags.size() == query_num);
+  rc = tiledb_completion_queue_poll(ctx_, cq, &tag, &status, &has_event);
+  CHECK(rc == TILEDB_OK);
+  CHECK(has_event == 0);
+
+#ifndef _WIN32
+  // The descriptor is no longer readable once the queue is drained
+  CHECK(poll(&pfd, 1, 0) == 0);
+#endif
+
+  // Check buffers
+  for (int i = 0; i < query_num; ++i) {
+    CHECK(tags.count(&queries[i]) == 1);
+    CHECK(buffer_a1_size[i] == sizeof(buffer_a1[i]));
+    // Row `i` spans two 2x2 tiles written in global order
+    int base = (i / 2) * 8 + (i % 2) * 2;
+    int c_buffer_a1[] = {base, base + 1, base + 4, base + 5};
+    CHECK(!memcmp(buffer_a1[i], c_buffer_a1, sizeof(c_buffer_a1)));
+    tiledb_query_free(&queries[i]);
+  }
+
+  // Close array
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+
+  // Clean up
+  tiledb_completion_queue_free(&cq);
+  tiledb_array_free(&array);
+}
+
 void AsyncFx::remove_array(const std::string& array_name) {
   if (!is_array(array_name))
     return;
@@ -795,4 +897,15 @@ TEST_CASE_METHOD(
   write_sparse_async_cancelled();
   read_sparse_async();
   remove_sparse_array();
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(
+    AsyncFx,
+    "C API: Test async completion queue",
+    "[capi], [async], [completion-queue]") {
+  remove_dense_array();
+  create_dense_array();
+  write_dense_async();
+  read_dense_async_cq();
+  remove_dense_array();
+}
@@ -190,10 +190,15 @@ void check_save_to_file() {
 
   std::stringstream ss;
   ss << "sm.array_schema_cache_size 10000000\n";
+  ss << "sm.buffer_pool_size 50000000\n";
   ss << "sm.check_coord_dups true\n";
   ss << "sm.check_coord_oob true\n";
   ss << "sm.check_global_order true\n";
   ss << "sm.consolidation.amplification 1\n";
+  ss << "sm.consolidation.auto false\n";
+  ss << "sm.consolidation.auto_interval_ms 1000\n";
+  ss << "sm.consolidation.auto_max_bytes 1000000000\n";
+  ss << "sm.consolidation.auto_write_amplification 4\n";
   ss << "sm.consolidation.buffer_size 50000000\n";
   ss << "sm.consolidation.step_max_frags 4294967295\n";
   ss << "sm.consolidation.step_min_frags 4294967295\n";
@@ -202,11 +207,23 @@ void check_save_to_file() {
   ss << "sm.dedup_coords false\n";
   ss << "sm.enable_signal_handlers true\n";
   ss << "sm.fragment_metadata_cache_size 10000000\n";
+  ss << "sm.generic_tile_prefetch_size 65536\n";
   ss << "sm.num_async_threads 1\n";
+  ss << "sm.num_compute_threads " << std::thread::hardware_concurrency()
+     << "\n";
+  ss << "sm.num_consolidation_threads 1\n";
   ss << "sm.num_reader_threads 1\n";
   ss << "sm.num_tbb_threads -1\n";
   ss << "sm.num_writer_threads 1\n";
+  ss << "sm.read_partition_utilization 1\n";
   ss << "sm.tile_cache_size 10000000\n";
+  ss << "sm.verify_checksums true\n";
+  ss << "sm.write_coalescing.max_age_ms 1000\n";
+  ss << "sm.write_coalescing.max_bytes 0\n";
+  ss << "sm.zstd_dictionary_size 0\n";
+  ss << "vfs.disk_cache.max_size 10737418240\n";
+  ss << "vfs.file.io_uring false\n";
+  ss << "vfs.file.io_uring_depth 32\n";
   ss << "vfs.file.max_parallel_ops " << std::thread::hardware_concurrency()
      << "\n";
   ss << "vfs.max_batch_read_amplification 1\n";
@@ -374,12 +391,22 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   all_param_values["sm.check_coord_oob"] = "true";
   all_param_values["sm.check_global_order"] = "true";
   all_param_values["sm.tile_cache_size"] = "100";
+  all_param_values["sm.zstd_dictionary_size"] = "0";
+  all_param_values["sm.verify_checksums"] = "true";
+  all_param_values["sm.write_coalescing.max_bytes"] = "0";
+  all_param_values["sm.write_coalescing.max_age_ms"] = "1000";
+  all_param_values["sm.read_partition_utilization"] = "1";
   all_param_values["sm.array_schema_cache_size"] = "1000";
   all_param_values["sm.fragment_metadata_cache_size"] = "10000000";
+  all_param_values["sm.generic_tile_prefetch_size"] = "65536";
+  all_param_values["sm.buffer_pool_size"] = "50000000";
   all_param_values["sm.enable_signal_handlers"] = "true";
   all_param_values["sm.num_async_threads"] = "1";
   all_param_values["sm.num_reader_threads"] = "1";
   all_param_values["sm.num_writer_threads"] = "1";
+  all_param_values["sm.num_compute_threads"] =
+      std::to_string(std::thread::hardware_concurrency());
+  all_param_values["sm.num_consolidation_threads"] = "1";
   all_param_values["sm.num_tbb_threads"] = "-1";
   all_param_values["sm.consolidation.amplification"] = "1";
   all_param_values["sm.consolidation.steps"] = "4294967295";
@@ -387,6 +414,10 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   all_param_values["sm.consolidation.step_max_frags"] = "4294967295";
   all_param_values["sm.consolidation.buffer_size"] = "50000000";
   all_param_values["sm.consolidation.step_size_ratio"] = "0";
+  all_param_values["sm.consolidation.auto"] = "false";
+  all_param_values["sm.consolidation.auto_interval_ms"] = "1000";
+  all_param_values["sm.consolidation.auto_max_bytes"] = "1000000000";
+  all_param_values["sm.consolidation.auto_write_amplification"] = "4";
   all_param_values["vfs.num_threads"] =
       std::to_string(std::thread::hardware_concurrency());
   all_param_values["vfs.min_parallel_size"] = "10485760";
@@ -394,6 +425,10 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   all_param_values["vfs.max_batch_read_size"] = "104857600";
   all_param_values["vfs.file.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
+  all_param_values["vfs.file.io_uring"] = "false";
+  all_param_values["vfs.file.io_uring_depth"] = "32";
+  all_param_values["vfs.disk_cache.path"] = "";
+  all_param_values["vfs.disk_cache.max_size"] = "10737418240";
   all_param_values["vfs.s3.scheme"] = "https";
   all_param_values["vfs.s3.region"] = "us-east-1";
   all_param_values["vfs.s3.aws_access_key_id"] = "";
@@ -424,6 +459,10 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   vfs_param_values["max_batch_read_size"] = "104857600";
   vfs_param_values["file.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
+  vfs_param_values["file.io_uring"] = "false";
+  vfs_param_values["file.io_uring_depth"] = "32";
+  vfs_param_values["disk_cache.path"] = "";
+  vfs_param_values["disk_cache.max_size"] = "10737418240";
   vfs_param_values["s3.scheme"] = "https";
   vfs_param_values["s3.region"] = "us-east-1";
   vfs_param_values["s3.aws_access_key_id"] = "";
@@ -33,6 +33,7 @@
 #include "catch.hpp"
 #include "test/src/helpers.h"
 #include "tiledb/sm/c_api/tiledb.h"
+#include "tiledb/sm/misc/stats.h"
 
 #include <climits>
 #include <cstring>
@@ -74,9 +75,11 @@ struct ConsolidationFx {
   void write_dense_vector_del_3();
   void write_dense_full();
   void write_dense_subarray();
+  void write_dense_tile_columns();
   void write_dense_unordered();
   void write_sparse_full();
   void write_sparse_unordered();
+  void write_sparse_dups();
   void write_kv_keys_abc();
   void write_kv_keys_acd();
   void read_dense_vector();
@@ -87,10 +90,12 @@ struct ConsolidationFx {
   void read_dense_vector_del_1();
   void read_dense_vector_del_2();
   void read_dense_vector_del_3();
+  void read_dense_full();
   void read_dense_full_subarray_unordered();
   void read_dense_subarray_full_unordered();
   void read_dense_subarray_unordered_full();
   void read_sparse_full_unordered();
+  void read_sparse_dups();
   void read_sparse_unordered_full();
   void read_kv_keys_abc_acd();
   void read_kv_keys_acd_abc();
@@ -1447,6 +1452,98 @@ void ConsolidationFx::write_dense_subarray() {
   tiledb_query_free(&query);
 }
 
+void ConsolidationFx::write_dense_tile_columns() {
+  // Set attributes
+  const char* attributes[] = {"a1", "a2", "a3"};
+
+  // Prepare cell buffers for the two tile columns. Together they
+  // hold the same cells as `write_dense_full`.
+  // clang-format off
+  int buffer_a1[2][8] = {
+      {0, 1, 2, 3, 8, 9, 10, 11},
+      {4, 5, 6, 7, 12, 13, 14, 15}
+  };
+  uint64_t buffer_a2[2][8] = {
+      {0, 1, 3, 6, 10, 11, 13, 16},
+      {0, 1, 3, 6, 10, 11, 13, 16}
+  };
+  char buffer_var_a2[2][21] = {
+      "abbcccdddd"
+      "ijjkkkllll",
+      "effggghhhh"
+      "mnnooopppp"
+  };
+  float buffer_a3[2][16] = {
+      {0.1f,  0.2f,  1.1f,  1.2f,  2.1f,  2.2f,  3.1f,  3.2f,
+       8.1f,  8.2f,  9.1f,  9.2f,  10.1f, 10.2f, 11.1f, 11.2f},
+      {4.1f,  4.2f,  5.1f,  5.2f,  6.1f,  6.2f,  7.1f,  7.2f,
+       12.1f, 12.2f, 13.1f, 13.2f, 14.1f, 14.2f, 15.1f, 15.2f}
+  };
+  uint64_t subarrays[2][4] = {{1, 4, 1, 2}, {1, 4, 3, 4}};
+  // clang-format on
+
+  // Open array
+  tiledb_array_t* array;
+  int rc = tiledb_array_alloc(ctx_, DENSE_ARRAY_NAME, &array);
+  CHECK(rc == TILEDB_OK);
+  if (encryption_type_ == TILEDB_NO_ENCRYPTION) {
+    rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+  } else {
+    rc = tiledb_array_open_with_key(
+        ctx_,
+        array,
+        TILEDB_WRITE,
+        encryption_type_,
+        encryption_key_,
+        (uint32_t)strlen(encryption_key_));
+  }
+  REQUIRE(rc == TILEDB_OK);
+
+  // Write one fragment per tile column
+  for (int i = 0; i < 2; ++i) {
+    uint64_t buffer_sizes[] = {
+        sizeof(buffer_a1[i]),
+        sizeof(buffer_a2[i]),
+        sizeof(buffer_var_a2[i]) - 1,  // No need to store the last '\0'
+        sizeof(buffer_a3[i])};
+
+    tiledb_query_t* query;
+    rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, query, TILEDB_GLOBAL_ORDER);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_subarray(ctx_, query, subarrays[i]);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffer(
+        ctx_, query, attributes[0], buffer_a1[i], &buffer_sizes[0]);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffer_var(
+        ctx_,
+        query,
+        attributes[1],
+        buffer_a2[i],
+        &buffer_sizes[1],
+        buffer_var_a2[i],
+        &buffer_sizes[2]);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffer(
+        ctx_, query, attributes[2], buffer_a3[i], &buffer_sizes[3]);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx_, query);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_finalize(ctx_, query);
+    CHECK(rc == TILEDB_OK);
+    tiledb_query_free(&query);
+  }
+
+  // Close array
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+
+  // Clean up
+  tiledb_array_free(&array);
+}
+
 void ConsolidationFx::write_dense_unordered() {
   // Prepare buffers
   int buffer_a1[] = {211, 213, 212, 208};
@@ -1615,6 +1712,77 @@ void ConsolidationFx::write_sparse_full() {
   tiledb_query_free(&query);
 }
 
+void ConsolidationFx::write_sparse_dups() {
+  // Prepare cell buffers for two fragments, each with a duplicate
+  // coordinate tuple. Writing them requires `sm.check_coord_dups=false`.
+  // clang-format off
+  int buffer_a1[2][4] = {{0, 1, 2, 3}, {4, 5, 6, 7}};
+  uint64_t buffer_a2[2][4] = {{0, 1, 3, 6}, {0, 1, 3, 6}};
+  char buffer_var_a2[2][11] = {"abbcccdddd", "effggghhhh"};
+  float buffer_a3[2][8] = {
+      {0.1f, 0.2f, 1.1f, 1.2f, 2.1f, 2.2f, 3.1f, 3.2f},
+      {4.1f, 4.2f, 5.1f, 5.2f, 6.1f, 6.2f, 7.1f, 7.2f}
+  };
+  uint64_t buffer_coords[2][8] = {
+      {1, 1, 1, 2, 1, 2, 2, 1},
+      {3, 3, 3, 4, 3, 4, 4, 3}
+  };
+  // clang-format on
+
+  // Open array
+  tiledb_array_t* array;
+  int rc = tiledb_array_alloc(ctx_, SPARSE_ARRAY_NAME, &array);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Write one fragment at a time
+  for (int i = 0; i < 2; ++i) {
+    uint64_t buffer_sizes[] = {
+        sizeof(buffer_a1[i]),
+        sizeof(buffer_a2[i]),
+        sizeof(buffer_var_a2[i]) - 1,  // No need to store the last '\0'
+        sizeof(buffer_a3[i]),
+        sizeof(buffer_coords[i])};
+
+    tiledb_query_t* query;
+    rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, query, TILEDB_GLOBAL_ORDER);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffer(
+        ctx_, query, "a1", buffer_a1[i], &buffer_sizes[0]);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffer_var(
+        ctx_,
+        query,
+        "a2",
+        buffer_a2[i],
+        &buffer_sizes[1],
+        buffer_var_a2[i],
+        &buffer_sizes[2]);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffer(
+        ctx_, query, "a3", buffer_a3[i], &buffer_sizes[3]);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_buffer(
+        ctx_, query, TILEDB_COORDS, buffer_coords[i], &buffer_sizes[4]);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx_, query);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_finalize(ctx_, query);
+    CHECK(rc == TILEDB_OK);
+    tiledb_query_free(&query);
+  }
+
+  // Close array
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+
+  // Clean up
+  tiledb_array_free(&array);
+}
+
 void ConsolidationFx::write_sparse_unordered() {
   // Prepare cell buffers
   int buffer_a1[] = {107, 104, 106, 105};
@@ -2317,6 +2485,115 @@ void ConsolidationFx::read_dense_vector_del_3() {
   tiledb_query_free(&query);
 }
 
+void ConsolidationFx::read_dense_full() {
+  // Correct buffers
+  int c_buffer_a1[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  uint64_t c_buffer_a2_off[] = {
+      0, 1, 3, 6, 10, 11, 13, 16, 20, 21, 23, 26, 30, 31, 33, 36};
+  char c_buffer_a2_val[] =
+      "abbcccdddd"
+      "effggghhhh"
+      "ijjkkkllll"
+      "mnnooopppp";
+  float c_buffer_a3[] = {
+      0.1f,  0.2f,  1.1f,  1.2f,  2.1f,  2.2f,  3.1f,  3.2f,
+      4.1f,  4.2f,  5.1f,  5.2f,  6.1f,  6.2f,  7.1f,  7.2f,
+      8.1f,  8.2f,  9.1f,  9.2f,  10.1f, 10.2f, 11.1f, 11.2f,
+      12.1f, 12.2f, 13.1f, 13.2f, 14.1f, 14.2f, 15.1f, 15.2f,
+  };
+
+  // Open array
+  tiledb_array_t* array;
+  int rc = tiledb_array_alloc(ctx_, DENSE_ARRAY_NAME, &array);
+  CHECK(rc == TILEDB_OK);
+  if (encryption_type_ == TILEDB_NO_ENCRYPTION) {
+    rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  } else {
+    rc = tiledb_array_open_with_key(
+        ctx_,
+        array,
+        TILEDB_READ,
+        encryption_type_,
+        encryption_key_,
+        (uint32_t)strlen(encryption_key_));
+  }
+  REQUIRE(rc == TILEDB_OK);
+
+  // Compute max buffer sizes
+  uint64_t subarray[] = {1, 4, 1, 4};
+  uint64_t buffer_a1_size, buffer_a2_off_size, buffer_a2_val_size,
+      buffer_a3_size;
+  rc = tiledb_array_max_buffer_size(
+      ctx_, array, "a1", subarray, &buffer_a1_size);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_max_buffer_size_var(
+      ctx_, array, "a2", subarray, &buffer_a2_off_size, &buffer_a2_val_size);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_max_buffer_size(
+      ctx_, array, "a3", subarray, &buffer_a3_size);
+  CHECK(rc == TILEDB_OK);
+
+  // Prepare cell buffers
+  auto buffer_a1 = (int*)malloc(buffer_a1_size);
+  auto buffer_a2_off = (uint64_t*)malloc(buffer_a2_off_size);
+  auto buffer_a2_val = (char*)malloc(buffer_a2_val_size);
+  auto buffer_a3 = (float*)malloc(buffer_a3_size);
+
+  // Create query
+  tiledb_query_t* query;
+  rc = tiledb_query_alloc(ctx_, array, TILEDB_READ, &query);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_GLOBAL_ORDER);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer(ctx_, query, "a1", buffer_a1, &buffer_a1_size);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer_var(
+      ctx_,
+      query,
+      "a2",
+      buffer_a2_off,
+      &buffer_a2_off_size,
+      buffer_a2_val,
+      &buffer_a2_val_size);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer(ctx_, query, "a3", buffer_a3, &buffer_a3_size);
+  CHECK(rc == TILEDB_OK);
+
+  // Submit query
+  rc = tiledb_query_submit(ctx_, query);
+  CHECK(rc == TILEDB_OK);
+
+  tiledb_query_status_t status;
+  rc = tiledb_query_get_status(ctx_, query, &status);
+  CHECK(status == TILEDB_COMPLETED);
+
+  // Finalize query
+  rc = tiledb_query_finalize(ctx_, query);
+  CHECK(rc == TILEDB_OK);
+
+  // Check buffers
+  CHECK(sizeof(c_buffer_a1) == buffer_a1_size);
+  CHECK(sizeof(c_buffer_a2_off) == buffer_a2_off_size);
+  CHECK(sizeof(c_buffer_a2_val) - 1 == buffer_a2_val_size);
+  CHECK(sizeof(c_buffer_a3) == buffer_a3_size);
+  CHECK(!memcmp(buffer_a1, c_buffer_a1, sizeof(c_buffer_a1)));
+  CHECK(!memcmp(buffer_a2_off, c_buffer_a2_off, sizeof(c_buffer_a2_off)));
+  CHECK(!memcmp(buffer_a2_val, c_buffer_a2_val, sizeof(c_buffer_a2_val) - 1));
+  CHECK(!memcmp(buffer_a3, c_buffer_a3, sizeof(c_buffer_a3)));
+
+  // Close array
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+
+  // Clean up
+  tiledb_array_free(&array);
+  tiledb_query_free(&query);
+  free(buffer_a1);
+  free(buffer_a2_off);
+  free(buffer_a2_val);
+  free(buffer_a3);
+}
+
 void ConsolidationFx::read_dense_full_subarray_unordered() {
   // Correct buffers
   int c_buffer_a1[] = {
@@ -2734,6 +3011,79 @@ void ConsolidationFx::read_sparse_full_unordered() {
   free(buffer_coords);
 }
 
+void ConsolidationFx::read_sparse_dups() {
+  // Correct buffers. Only the first cell of each duplicate coordinate
+  // tuple is read.
+  int c_buffer_a1[] = {0, 1, 3, 4, 5, 7};
+  uint64_t c_buffer_a2_off[] = {0, 1, 3, 7, 8, 10};
+  char c_buffer_a2_val[] = "abbddddeffhhhh";
+  uint64_t c_buffer_coords[] = {1, 1, 1, 2, 2, 1, 3, 3, 3, 4, 4, 3};
+
+  // Open array
+  tiledb_array_t* array;
+  int rc = tiledb_array_alloc(ctx_, SPARSE_ARRAY_NAME, &array);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Prepare cell buffers, large enough for all the written cells
+  int buffer_a1[8];
+  uint64_t buffer_a2_off[8];
+  char buffer_a2_val[20];
+  uint64_t buffer_coords[16];
+  uint64_t buffer_a1_size = sizeof(buffer_a1);
+  uint64_t buffer_a2_off_size = sizeof(buffer_a2_off);
+  uint64_t buffer_a2_val_size = sizeof(buffer_a2_val);
+  uint64_t buffer_coords_size = sizeof(buffer_coords);
+
+  // Create query
+  tiledb_query_t* query;
+  rc = tiledb_query_alloc(ctx_, array, TILEDB_READ, &query);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_GLOBAL_ORDER);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer(ctx_, query, "a1", buffer_a1, &buffer_a1_size);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer_var(
+      ctx_,
+      query,
+      "a2",
+      buffer_a2_off,
+      &buffer_a2_off_size,
+      buffer_a2_val,
+      &buffer_a2_val_size);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer(
+      ctx_, query, TILEDB_COORDS, buffer_coords, &buffer_coords_size);
+  CHECK(rc == TILEDB_OK);
+
+  // Submit query
+  rc = tiledb_query_submit(ctx_, query);
+  CHECK(rc == TILEDB_OK);
+
+  // Finalize query
+  rc = tiledb_query_finalize(ctx_, query);
+  CHECK(rc == TILEDB_OK);
+
+  // Check buffers
+  CHECK(buffer_a1_size == sizeof(c_buffer_a1));
+  CHECK(buffer_a2_off_size == sizeof(c_buffer_a2_off));
+  CHECK(buffer_a2_val_size == sizeof(c_buffer_a2_val) - 1);
+  CHECK(buffer_coords_size == sizeof(c_buffer_coords));
+  CHECK(!memcmp(buffer_a1, c_buffer_a1, sizeof(c_buffer_a1)));
+  CHECK(!memcmp(buffer_a2_off, c_buffer_a2_off, sizeof(c_buffer_a2_off)));
+  CHECK(!memcmp(buffer_a2_val, c_buffer_a2_val, sizeof(c_buffer_a2_val) - 1));
+  CHECK(!memcmp(buffer_coords, c_buffer_coords, sizeof(c_buffer_coords)));
+
+  // Close array
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+
+  // Clean up
+  tiledb_array_free(&array);
+  tiledb_query_free(&query);
+}
+
 void ConsolidationFx::read_sparse_unordered_full() {
   // Correct buffers
   int c_buffer_a1[] = {0, 1, 2, 3, 4, 104, 105, 5, 6, 7};
@@ -3099,6 +3449,117 @@ TEST_CASE_METHOD(
   remove_dense_array();
 }
 
+TEST_CASE_METHOD(
+    ConsolidationFx,
+    "C API: Test consolidation, dense, tile copy",
+    "[capi], [consolidation], [dense-consolidation-tile-copy]") {
+  remove_dense_array();
+
+  SECTION("- unencrypted") {
+    create_dense_array();
+  }
+
+  SECTION("- encrypted") {
+    encryption_type_ = TILEDB_AES_256_GCM;
+    encryption_key_ = "0123456789abcdeF0123456789abcdeF";
+    create_dense_array();
+  }
+
+  // The two fragments have disjoint tiles that interleave in the global
+  // tile order, so the consolidated fragment is built by copying tiles
+  write_dense_tile_columns();
+  read_dense_full();
+  consolidate_dense();
+  read_dense_full();
+
+  // Check number of fragments
+  get_dir_num_struct data = {ctx_, vfs_, 0};
+  int rc = tiledb_vfs_ls(ctx_, vfs_, DENSE_ARRAY_NAME, &get_dir_num, &data);
+  CHECK(rc == TILEDB_OK);
+  CHECK(data.dir_num == 1);
+
+  remove_dense_array();
+}
+
+TEST_CASE_METHOD(
+    ConsolidationFx,
+    "C API: Test background consolidation",
+    "[capi], [consolidation], [auto-consolidation]") {
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_alloc(&config, &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  int rc = tiledb_config_set(config, "sm.consolidation.auto", "true", &error);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  rc = tiledb_config_set(
+      config, "sm.consolidation.auto_interval_ms", "0", &error);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(error == nullptr);
+
+  int expected_dir_num = 1;
+  bool open_for_reads = false;
+  bool kept_open_for_reads = false;
+  SECTION("- within budget") {
+  }
+
+  SECTION("- array open for reads") {
+    open_for_reads = true;
+  }
+
+  SECTION("- array kept open for reads") {
+    open_for_reads = true;
+    kept_open_for_reads = true;
+    expected_dir_num = 4;
+  }
+
+  SECTION("- no write amplification budget") {
+    rc = tiledb_config_set(
+        config, "sm.consolidation.auto_write_amplification", "0", &error);
+    REQUIRE(rc == TILEDB_OK);
+    REQUIRE(error == nullptr);
+    expected_dir_num = 4;
+  }
+
+  // Replace the context with one consolidating in the background
+  tiledb_vfs_free(&vfs_);
+  tiledb_ctx_free(&ctx_);
+  REQUIRE(tiledb_ctx_alloc(config, &ctx_) == TILEDB_OK);
+  REQUIRE(tiledb_vfs_alloc(ctx_, nullptr, &vfs_) == TILEDB_OK);
+  tiledb_config_free(&config);
+
+  remove_dense_vector();
+  create_dense_vector();
+
+  // The runs that cannot lock the array while it is open for reads in
+  // the same context are rescheduled
+  tiledb_array_t* array = nullptr;
+  if (open_for_reads) {
+    REQUIRE(tiledb_array_alloc(ctx_, DENSE_VECTOR_NAME, &array) == TILEDB_OK);
+    REQUIRE(tiledb_array_open(ctx_, array, TILEDB_READ) == TILEDB_OK);
+  }
+  write_dense_vector_4_fragments();
+  if (open_for_reads && !kept_open_for_reads) {
+    REQUIRE(tiledb_array_close(ctx_, array) == TILEDB_OK);
+    tiledb_array_free(&array);
+  }
+
+  // Wait for the background consolidation to settle. If the array is kept
+  // open for reads, the runs give up after a bounded number of retries.
+  REQUIRE(tiledb_ctx_wait_consolidations(ctx_) == TILEDB_OK);
+  if (kept_open_for_reads) {
+    REQUIRE(tiledb_array_close(ctx_, array) == TILEDB_OK);
+    tiledb_array_free(&array);
+  }
+  get_dir_num_struct data = {ctx_, vfs_, 0};
+  rc = tiledb_vfs_ls(ctx_, vfs_, DENSE_VECTOR_NAME, &get_dir_num, &data);
+  CHECK(rc == TILEDB_OK);
+  CHECK(data.dir_num == expected_dir_num);
+  read_dense_vector();
+
+  remove_dense_vector();
+}
+
 TEST_CASE_METHOD(
     ConsolidationFx,
     "C API: Test consolidation, sparse",
@@ -3134,6 +3595,99 @@ TEST_CASE_METHOD(
   remove_sparse_array();
 }
 
+TEST_CASE_METHOD(
+    ConsolidationFx,
+    "C API: Test consolidation, sparse, tile merge",
+    "[capi], [consolidation], [sparse-consolidation-tile-merge]") {
+  remove_sparse_array();
+
+  SECTION("- unencrypted") {
+    create_sparse_array();
+  }
+
+  SECTION("- encrypted") {
+    encryption_type_ = TILEDB_AES_256_GCM;
+    encryption_key_ = "0123456789abcdeF0123456789abcdeF";
+    create_sparse_array();
+  }
+
+  // The fragments overlap, so their tiles are merged. The buffer size
+  // makes each batch a single tile of two cells.
+  write_sparse_full();
+  write_sparse_unordered();
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_alloc(&config, &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  int rc =
+      tiledb_config_set(config, "sm.consolidation.buffer_size", "16", &error);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_stats_reset();
+  tiledb_stats_enable();
+  if (encryption_type_ == TILEDB_NO_ENCRYPTION) {
+    rc = tiledb_array_consolidate(ctx_, SPARSE_ARRAY_NAME, config);
+  } else {
+    rc = tiledb_array_consolidate_with_key(
+        ctx_,
+        SPARSE_ARRAY_NAME,
+        encryption_type_,
+        encryption_key_,
+        (uint32_t)strlen(encryption_key_),
+        config);
+  }
+  tiledb_stats_disable();
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_config_free(&config);
+  const auto& stats = tiledb::sm::stats::all_stats;
+  CHECK(stats.counter_consolidator_num_cells_merged == 10);
+  read_sparse_full_unordered();
+
+  // Check number of fragments
+  get_dir_num_struct data = {ctx_, vfs_, 0};
+  rc = tiledb_vfs_ls(ctx_, vfs_, SPARSE_ARRAY_NAME, &get_dir_num, &data);
+  CHECK(rc == TILEDB_OK);
+  CHECK(data.dir_num == 1);
+
+  remove_sparse_array();
+}
+
+TEST_CASE_METHOD(
+    ConsolidationFx,
+    "C API: Test consolidation, sparse, tile merge with duplicates",
+    "[capi], [consolidation], [sparse-consolidation-tile-merge]") {
+  // Allow writing duplicate coordinates
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_alloc(&config, &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  int rc = tiledb_config_set(config, "sm.check_coord_dups", "false", &error);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_vfs_free(&vfs_);
+  tiledb_ctx_free(&ctx_);
+  REQUIRE(tiledb_ctx_alloc(config, &ctx_) == TILEDB_OK);
+  REQUIRE(tiledb_vfs_alloc(ctx_, nullptr, &vfs_) == TILEDB_OK);
+  tiledb_config_free(&config);
+
+  remove_sparse_array();
+  create_sparse_array();
+
+  // Each fragment has a duplicate coordinate tuple, of which only the
+  // first cell is kept when reading and when merging the tiles
+  write_sparse_dups();
+  read_sparse_dups();
+  tiledb_stats_reset();
+  tiledb_stats_enable();
+  consolidate_sparse();
+  tiledb_stats_disable();
+  const auto& stats = tiledb::sm::stats::all_stats;
+  CHECK(stats.counter_consolidator_num_cells_merged == 6);
+  read_sparse_dups();
+
+  remove_sparse_array();
+}
+
 TEST_CASE_METHOD(
     ConsolidationFx,
     "C API: Test consolidation, KV",
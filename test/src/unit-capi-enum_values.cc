@@ -103,11 +103,19 @@ TEST_CASE("C API: Test enum values", "[capi], [enums]") {
   REQUIRE(TILEDB_FILTER_BYTESHUFFLE == 9);
   REQUIRE(TILEDB_FILTER_POSITIVE_DELTA == 10);
   REQUIRE((uint8_t)FilterType::INTERNAL_FILTER_AES_256_GCM == 11);
+  REQUIRE(TILEDB_FILTER_AUTO == 12);
+  REQUIRE(TILEDB_FILTER_CHECKSUM_CRC32C == 13);
 
   /** Filter option */
   REQUIRE(TILEDB_COMPRESSION_LEVEL == 0);
   REQUIRE(TILEDB_BIT_WIDTH_MAX_WINDOW == 1);
   REQUIRE(TILEDB_POSITIVE_DELTA_MAX_WINDOW == 2);
+  REQUIRE(TILEDB_AUTO_OBJECTIVE == 3);
+
+  /** Adaptive filter objective */
+  REQUIRE(TILEDB_AUTO_RATIO == 0);
+  REQUIRE(TILEDB_AUTO_BALANCED == 1);
+  REQUIRE(TILEDB_AUTO_DECODE_SPEED == 2);
 
   /** Encryption type */
   REQUIRE(TILEDB_NO_ENCRYPTION == 0);
@@ -191,4 +191,64 @@ TEST_CASE("C API: Test filter list on attribute", "[capi], [filter]") {
   tiledb_filter_free(&filter);
   tiledb_filter_list_free(&filter_list);
   tiledb_ctx_free(&ctx);
-}
\ No newline at end of file
+}
+
+TEST_CASE("C API: Test filter list on dimension", "[capi], [filter]") {
+  tiledb_ctx_t* ctx;
+  int rc = tiledb_ctx_alloc(nullptr, &ctx);
+  REQUIRE(rc == TILEDB_OK);
+
+  tiledb_filter_t* filter;
+  rc = tiledb_filter_alloc(ctx, TILEDB_FILTER_DOUBLE_DELTA, &filter);
+  REQUIRE(rc == TILEDB_OK);
+
+  tiledb_filter_list_t* filter_list;
+  rc = tiledb_filter_list_alloc(ctx, &filter_list);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_filter_list_add_filter(ctx, filter_list, filter);
+  REQUIRE(rc == TILEDB_OK);
+
+  int64_t dim_domain[] = {1, 100};
+  int64_t tile_extent = 10;
+  tiledb_dimension_t* dim;
+  rc = tiledb_dimension_alloc(
+      ctx, "d", TILEDB_INT64, dim_domain, &tile_extent, &dim);
+  REQUIRE(rc == TILEDB_OK);
+
+  // No filters by default
+  tiledb_filter_list_t* filter_list_out;
+  rc = tiledb_dimension_get_filter_list(ctx, dim, &filter_list_out);
+  REQUIRE(rc == TILEDB_OK);
+  unsigned nfilters;
+  rc = tiledb_filter_list_get_nfilters(ctx, filter_list_out, &nfilters);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(nfilters == 0);
+  tiledb_filter_list_free(&filter_list_out);
+
+  rc = tiledb_dimension_set_filter_list(ctx, dim, filter_list);
+  REQUIRE(rc == TILEDB_OK);
+
+  rc = tiledb_dimension_get_filter_list(ctx, dim, &filter_list_out);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_filter_list_get_nfilters(ctx, filter_list_out, &nfilters);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(nfilters == 1);
+
+  tiledb_filter_t* filter_out;
+  rc = tiledb_filter_list_get_filter_from_index(
+      ctx, filter_list_out, 0, &filter_out);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_filter_type_t type;
+  rc = tiledb_filter_get_type(ctx, filter_out, &type);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(type == TILEDB_FILTER_DOUBLE_DELTA);
+
+  tiledb_filter_free(&filter_out);
+  tiledb_filter_list_free(&filter_list_out);
+
+  // Clean up
+  tiledb_dimension_free(&dim);
+  tiledb_filter_free(&filter);
+  tiledb_filter_list_free(&filter_list);
+  tiledb_ctx_free(&ctx);
+}
@@ -475,3 +475,103 @@ TEST_CASE_METHOD(
 
   remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
 }
+
+TEST_CASE_METHOD(
+    SparseRealFx,
+    "C API: Test 1d sparse array with real domain, cells on partition edges",
+    "[capi][sparse-real][sparse-real-partition-edge]") {
+  std::string array_name =
+      FILE_URI_PREFIX + FILE_TEMP_DIR + "sparse_real_partition_edge";
+  create_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+
+  // Create a 1D array with two cells per data tile
+  double dim_domain[] = {0.0, 4.0};
+  double tile_extent = 1.0;
+  tiledb_dimension_t* d;
+  int rc = tiledb_dimension_alloc(
+      ctx_, "d", TILEDB_FLOAT64, dim_domain, &tile_extent, &d);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_domain_t* domain;
+  REQUIRE(tiledb_domain_alloc(ctx_, &domain) == TILEDB_OK);
+  REQUIRE(tiledb_domain_add_dimension(ctx_, domain, d) == TILEDB_OK);
+  tiledb_attribute_t* a;
+  REQUIRE(tiledb_attribute_alloc(ctx_, "a", TILEDB_INT32, &a) == TILEDB_OK);
+  tiledb_array_schema_t* array_schema;
+  REQUIRE(
+      tiledb_array_schema_alloc(ctx_, TILEDB_SPARSE, &array_schema) ==
+      TILEDB_OK);
+  REQUIRE(
+      tiledb_array_schema_set_domain(ctx_, array_schema, domain) == TILEDB_OK);
+  REQUIRE(tiledb_array_schema_set_capacity(ctx_, array_schema, 2) == TILEDB_OK);
+  REQUIRE(
+      tiledb_array_schema_add_attribute(ctx_, array_schema, a) == TILEDB_OK);
+  REQUIRE(
+      tiledb_array_create(ctx_, array_name.c_str(), array_schema) ==
+      TILEDB_OK);
+  tiledb_attribute_free(&a);
+  tiledb_dimension_free(&d);
+  tiledb_domain_free(&domain);
+  tiledb_array_schema_free(&array_schema);
+
+  // Write a data tile whose MBR ends on the first space tile boundary,
+  // along which the read partitions the subarray
+  double coords_w[] = {0.5, 1.0};
+  int a_w[] = {1, 2};
+  uint64_t coords_w_size = sizeof(coords_w);
+  uint64_t a_w_size = sizeof(a_w);
+  tiledb_array_t* array;
+  REQUIRE(tiledb_array_alloc(ctx_, array_name.c_str(), &array) == TILEDB_OK);
+  REQUIRE(tiledb_array_open(ctx_, array, TILEDB_WRITE) == TILEDB_OK);
+  tiledb_query_t* query;
+  REQUIRE(tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_layout(ctx_, query, TILEDB_UNORDERED) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_buffer(ctx_, query, "a", a_w, &a_w_size) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_buffer(
+          ctx_, query, TILEDB_COORDS, coords_w, &coords_w_size) == TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+  REQUIRE(tiledb_query_finalize(ctx_, query) == TILEDB_OK);
+  REQUIRE(tiledb_array_close(ctx_, array) == TILEDB_OK);
+  tiledb_query_free(&query);
+
+  // Read one cell at a time, so that the tile does not fit in the buffers
+  // and the subarray is partitioned. The cell on the edge must be read.
+  REQUIRE(tiledb_array_open(ctx_, array, TILEDB_READ) == TILEDB_OK);
+  REQUIRE(tiledb_query_alloc(ctx_, array, TILEDB_READ, &query) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_subarray(ctx_, query, dim_domain) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_layout(ctx_, query, TILEDB_ROW_MAJOR) == TILEDB_OK);
+  double coords[1];
+  int a_r[1];
+  uint64_t coords_size = sizeof(coords);
+  uint64_t a_r_size = sizeof(a_r);
+  REQUIRE(
+      tiledb_query_set_buffer(ctx_, query, "a", a_r, &a_r_size) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_buffer(
+          ctx_, query, TILEDB_COORDS, coords, &coords_size) == TILEDB_OK);
+  std::vector<double> coords_read;
+  std::vector<int> a_read;
+  tiledb_query_status_t status;
+  do {
+    REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+    REQUIRE(tiledb_query_get_status(ctx_, query, &status) == TILEDB_OK);
+    for (uint64_t i = 0; i < a_r_size / sizeof(int); ++i) {
+      coords_read.push_back(coords[i]);
+      a_read.push_back(a_r[i]);
+    }
+  } while (status == TILEDB_INCOMPLETE);
+  CHECK(status == TILEDB_COMPLETED);
+  CHECK(coords_read == std::vector<double>({0.5, 1.0}));
+  CHECK(a_read == std::vector<int>({1, 2}));
+
+  // Clean up
+  REQUIRE(tiledb_array_close(ctx_, array) == TILEDB_OK);
+  tiledb_array_free(&array);
+  tiledb_query_free(&query);
+
+  remove_temp_dir(FILE_URI_PREFIX + FILE_TEMP_DIR);
+}
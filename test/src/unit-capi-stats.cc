@@ -32,8 +32,15 @@
 
 #include "catch.hpp"
 #include "tiledb/sm/c_api/tiledb.h"
+#include "tiledb/sm/misc/stats.h"
 
+#include <chrono>
 #include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tiledb::sm;
 
 TEST_CASE("C API: Test stats", "[capi], [stats]") {
   REQUIRE(tiledb_stats_enable() == TILEDB_OK);
@@ -49,3 +56,395 @@ TEST_CASE("C API: Test stats", "[capi], [stats]") {
   REQUIRE(stats_str == nullptr);
   REQUIRE(tiledb_stats_disable() == TILEDB_OK);
 }
+
+TEST_CASE("Stats: Test latency histogram", "[stats], [stats-histogram]") {
+  stats::LatencyHistogram hist;
+  CHECK(hist.count() == 0);
+  CHECK(hist.percentile(50) == 0);
+
+  for (uint64_t i = 1; i <= 1000; ++i)
+    hist.record(i);
+  CHECK(hist.count() == 1000);
+  CHECK(hist.max() == 1000);
+  CHECK(hist.percentile(100) == 1000);
+
+  // Percentiles are bucket upper bounds, within 12.5% of the exact value
+  auto p50 = hist.percentile(50);
+  CHECK(p50 >= 500);
+  CHECK(p50 <= 500 * 1.125);
+  auto p99 = hist.percentile(99);
+  CHECK(p99 >= 990);
+  CHECK(p99 <= 1000);
+
+  // Small values are exact, huge values land in the last bucket
+  stats::LatencyHistogram small;
+  small.record(3);
+  CHECK(small.percentile(50) == 3);
+  small.record(uint64_t(1) << 60);
+  CHECK(small.percentile(100) == uint64_t(1) << 60);
+
+  hist.reset();
+  CHECK(hist.count() == 0);
+  CHECK(hist.max() == 0);
+}
+
+TEST_CASE("Stats: Test sharded counter", "[stats], [stats-counter]") {
+  stats::ShardedCounter counter;
+  CHECK(counter == 0);
+
+  // Add from more threads than shards
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < 2 * stats::counter_shard_num; ++t) {
+    threads.emplace_back([&counter]() {
+      for (int i = 0; i < 1000; ++i)
+        counter += 2;
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+  CHECK(counter == 2 * stats::counter_shard_num * 2000);
+
+  counter = 5;
+  CHECK(counter == 5);
+  counter.max(3);
+  CHECK(counter == 5);
+  counter.max(7);
+  CHECK(counter == 7);
+}
+
+TEST_CASE("Stats: Test trace buffer", "[stats], [trace-buffer]") {
+  stats::TraceBuffer buffer(1);
+  std::vector<stats::TraceEvent> events;
+  buffer.snapshot(&events);
+  CHECK(events.empty());
+
+  // Wrap around, keeping the most recent events only
+  uint64_t num = stats::TraceBuffer::event_num + 10;
+  for (uint64_t i = 0; i < num; ++i)
+    buffer.push({"f", i, 1, 0});
+  buffer.snapshot(&events);
+  REQUIRE(events.size() == stats::TraceBuffer::event_num);
+  CHECK(events.front().start_ns_ == 10);
+  CHECK(events.back().start_ns_ == num - 1);
+
+  events.clear();
+  buffer.clear();
+  buffer.snapshot(&events);
+  CHECK(events.empty());
+  buffer.push({"f", num, 1, 0});
+  buffer.snapshot(&events);
+  REQUIRE(events.size() == 1);
+  CHECK(events[0].start_ns_ == num);
+
+  // Snapshots taken while the owning thread pushes see consecutive events
+  buffer.clear();
+  std::thread pusher([&buffer, num]() {
+    for (uint64_t i = 0; i < 4 * num; ++i)
+      buffer.push({"f", i, 1, 0});
+  });
+  bool consecutive = true;
+  for (int s = 0; s < 100; ++s) {
+    events.clear();
+    buffer.snapshot(&events);
+    for (size_t i = 1; i < events.size(); ++i)
+      consecutive &= events[i].start_ns_ == events[i - 1].start_ns_ + 1;
+  }
+  pusher.join();
+  CHECK(consecutive);
+}
+
+/** Returns the trace thread id of the first event with the input name. */
+static std::string trace_tid(
+    const std::string& trace, const std::string& name) {
+  auto pos = trace.find("\"name\": \"" + name + "\"");
+  if (pos == std::string::npos)
+    return "";
+  pos = trace.find("\"tid\": ", pos) + 7;
+  return trace.substr(pos, trace.find_first_not_of("0123456789", pos) - pos);
+}
+
+TEST_CASE("Stats: Test trace thread ids", "[stats], [trace-tid]") {
+  // The second thread reuses the buffer of the first one, which exited
+  stats::tracer.reset();
+  stats::tracer.set_enabled(true);
+  std::thread([]() {
+    stats::tracer.record("trace_tid_1", std::chrono::steady_clock::now(), 1);
+  }).join();
+  std::thread([]() {
+    stats::tracer.record("trace_tid_2", std::chrono::steady_clock::now(), 1);
+  }).join();
+  stats::tracer.set_enabled(false);
+
+  std::string trace;
+  stats::tracer.dump(&trace);
+  stats::tracer.reset();
+  auto tid_1 = trace_tid(trace, "trace_tid_1");
+  auto tid_2 = trace_tid(trace, "trace_tid_2");
+  REQUIRE(!tid_1.empty());
+  REQUIRE(!tid_2.empty());
+  CHECK(tid_1 != tid_2);
+}
+
+TEST_CASE("C API: Test query stats", "[capi], [stats], [query-stats]") {
+  const char* array_name = "test_query_stats";
+  tiledb_ctx_t* ctx;
+  REQUIRE(tiledb_ctx_alloc(nullptr, &ctx) == TILEDB_OK);
+  tiledb_object_t type;
+  REQUIRE(tiledb_object_type(ctx, array_name, &type) == TILEDB_OK);
+  if (type == TILEDB_ARRAY)
+    REQUIRE(tiledb_object_remove(ctx, array_name) == TILEDB_OK);
+
+  // Create a 1D dense array
+  int dim_domain[] = {1, 4};
+  int tile_extent = 2;
+  tiledb_dimension_t* d;
+  REQUIRE(
+      tiledb_dimension_alloc(
+          ctx, "d", TILEDB_INT32, dim_domain, &tile_extent, &d) == TILEDB_OK);
+  tiledb_domain_t* domain;
+  REQUIRE(tiledb_domain_alloc(ctx, &domain) == TILEDB_OK);
+  REQUIRE(tiledb_domain_add_dimension(ctx, domain, d) == TILEDB_OK);
+  tiledb_attribute_t* a;
+  REQUIRE(tiledb_attribute_alloc(ctx, "a", TILEDB_INT32, &a) == TILEDB_OK);
+  tiledb_array_schema_t* schema;
+  REQUIRE(tiledb_array_schema_alloc(ctx, TILEDB_DENSE, &schema) == TILEDB_OK);
+  REQUIRE(tiledb_array_schema_set_domain(ctx, schema, domain) == TILEDB_OK);
+  REQUIRE(tiledb_array_schema_add_attribute(ctx, schema, a) == TILEDB_OK);
+  REQUIRE(tiledb_array_create(ctx, array_name, schema) == TILEDB_OK);
+  tiledb_attribute_free(&a);
+  tiledb_dimension_free(&d);
+  tiledb_domain_free(&domain);
+  tiledb_array_schema_free(&schema);
+
+  // Write without stats
+  tiledb_array_t* array;
+  REQUIRE(tiledb_array_alloc(ctx, array_name, &array) == TILEDB_OK);
+  REQUIRE(tiledb_array_open(ctx, array, TILEDB_WRITE) == TILEDB_OK);
+  int data_w[] = {1, 2, 3, 4};
+  uint64_t data_w_size = sizeof(data_w);
+  tiledb_query_t* query;
+  REQUIRE(tiledb_query_alloc(ctx, array, TILEDB_WRITE, &query) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_buffer(ctx, query, "a", data_w, &data_w_size) ==
+      TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx, query) == TILEDB_OK);
+
+  // No stats were gathered for the write
+  char* stats_json = nullptr;
+  REQUIRE(tiledb_query_get_stats(ctx, query, &stats_json) == TILEDB_OK);
+  std::string stats_str(stats_json);
+  REQUIRE(tiledb_stats_free_str(&stats_json) == TILEDB_OK);
+  CHECK(stats_str.find("\"functions\": [\n  ]") != std::string::npos);
+  CHECK(stats_str.find("\"histograms\": [\n  ]") != std::string::npos);
+  tiledb_query_free(&query);
+  REQUIRE(tiledb_array_close(ctx, array) == TILEDB_OK);
+
+  // Read with stats
+  REQUIRE(tiledb_stats_enable() == TILEDB_OK);
+  REQUIRE(tiledb_array_open(ctx, array, TILEDB_READ) == TILEDB_OK);
+  int data[4];
+  uint64_t data_size = sizeof(data);
+  REQUIRE(tiledb_query_alloc(ctx, array, TILEDB_READ, &query) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_buffer(ctx, query, "a", data, &data_size) == TILEDB_OK);
+  REQUIRE(tiledb_query_set_layout(ctx, query, TILEDB_ROW_MAJOR) == TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx, query) == TILEDB_OK);
+  CHECK(data[3] == 4);
+
+  REQUIRE(tiledb_query_get_stats(ctx, query, &stats_json) == TILEDB_OK);
+  stats_str = stats_json;
+  REQUIRE(tiledb_stats_free_str(&stats_json) == TILEDB_OK);
+  CHECK(
+      stats_str.find("{ \"name\": \"reader_read\", \"callCount\": 1,") !=
+      std::string::npos);
+  CHECK(
+      stats_str.find("{ \"name\": \"reader_read\", \"count\": 1,") !=
+      std::string::npos);
+  CHECK(
+      stats_str.find("\"name\": \"reader_num_attr_tiles_touched\"") !=
+      std::string::npos);
+  CHECK(stats_str.find("\"writer_write\"") == std::string::npos);
+
+  tiledb_query_free(&query);
+  REQUIRE(tiledb_array_close(ctx, array) == TILEDB_OK);
+  REQUIRE(tiledb_stats_disable() == TILEDB_OK);
+  tiledb_array_free(&array);
+  REQUIRE(tiledb_object_remove(ctx, array_name) == TILEDB_OK);
+  tiledb_ctx_free(&ctx);
+}
+
+TEST_CASE(
+    "C API: Test query stats with background consolidation",
+    "[capi], [stats], [query-stats]") {
+  const char* array_name = "test_query_stats_consolidation";
+  tiledb_config_t* config;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_alloc(&config, &error) == TILEDB_OK);
+  REQUIRE(
+      tiledb_config_set(config, "sm.consolidation.auto", "true", &error) ==
+      TILEDB_OK);
+  REQUIRE(
+      tiledb_config_set(
+          config, "sm.consolidation.auto_interval_ms", "0", &error) ==
+      TILEDB_OK);
+  tiledb_ctx_t* ctx;
+  REQUIRE(tiledb_ctx_alloc(config, &ctx) == TILEDB_OK);
+  tiledb_config_free(&config);
+  tiledb_object_t type;
+  REQUIRE(tiledb_object_type(ctx, array_name, &type) == TILEDB_OK);
+  if (type == TILEDB_ARRAY)
+    REQUIRE(tiledb_object_remove(ctx, array_name) == TILEDB_OK);
+
+  // Create a 1D dense array
+  int dim_domain[] = {1, 4};
+  int tile_extent = 2;
+  tiledb_dimension_t* d;
+  REQUIRE(
+      tiledb_dimension_alloc(
+          ctx, "d", TILEDB_INT32, dim_domain, &tile_extent, &d) == TILEDB_OK);
+  tiledb_domain_t* domain;
+  REQUIRE(tiledb_domain_alloc(ctx, &domain) == TILEDB_OK);
+  REQUIRE(tiledb_domain_add_dimension(ctx, domain, d) == TILEDB_OK);
+  tiledb_attribute_t* a;
+  REQUIRE(tiledb_attribute_alloc(ctx, "a", TILEDB_INT32, &a) == TILEDB_OK);
+  tiledb_array_schema_t* schema;
+  REQUIRE(tiledb_array_schema_alloc(ctx, TILEDB_DENSE, &schema) == TILEDB_OK);
+  REQUIRE(tiledb_array_schema_set_domain(ctx, schema, domain) == TILEDB_OK);
+  REQUIRE(tiledb_array_schema_add_attribute(ctx, schema, a) == TILEDB_OK);
+  REQUIRE(tiledb_array_create(ctx, array_name, schema) == TILEDB_OK);
+  tiledb_attribute_free(&a);
+  tiledb_dimension_free(&d);
+  tiledb_domain_free(&domain);
+  tiledb_array_schema_free(&schema);
+
+  // Write with stats, which triggers a background consolidation
+  REQUIRE(tiledb_stats_enable() == TILEDB_OK);
+  REQUIRE(tiledb_stats_reset() == TILEDB_OK);
+  tiledb_array_t* array;
+  REQUIRE(tiledb_array_alloc(ctx, array_name, &array) == TILEDB_OK);
+  REQUIRE(tiledb_array_open(ctx, array, TILEDB_WRITE) == TILEDB_OK);
+  int data_w[] = {1, 2, 3, 4};
+  uint64_t data_w_size = sizeof(data_w);
+  tiledb_query_t* query;
+  REQUIRE(tiledb_query_alloc(ctx, array, TILEDB_WRITE, &query) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_buffer(ctx, query, "a", data_w, &data_w_size) ==
+      TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx, query) == TILEDB_OK);
+  REQUIRE(tiledb_ctx_wait_consolidations(ctx) == TILEDB_OK);
+
+  // The background consolidation is not accounted to the write, which it
+  // may outlive
+  char* stats_json = nullptr;
+  REQUIRE(tiledb_stats_dump_str(&stats_json) == TILEDB_OK);
+  std::string stats_str(stats_json);
+  REQUIRE(tiledb_stats_free_str(&stats_json) == TILEDB_OK);
+  CHECK(stats_str.find("sm_auto_consolidations") != std::string::npos);
+  REQUIRE(tiledb_query_get_stats(ctx, query, &stats_json) == TILEDB_OK);
+  stats_str = stats_json;
+  REQUIRE(tiledb_stats_free_str(&stats_json) == TILEDB_OK);
+  CHECK(stats_str.find("\"writer_write\"") != std::string::npos);
+  CHECK(stats_str.find("sm_auto_consolidations") == std::string::npos);
+
+  tiledb_query_free(&query);
+  REQUIRE(tiledb_array_close(ctx, array) == TILEDB_OK);
+  REQUIRE(tiledb_stats_disable() == TILEDB_OK);
+  tiledb_array_free(&array);
+  REQUIRE(tiledb_object_remove(ctx, array_name) == TILEDB_OK);
+  tiledb_ctx_free(&ctx);
+}
+
+TEST_CASE("C API: Test trace", "[capi], [stats], [trace]") {
+  const char* array_name = "test_trace";
+  tiledb_ctx_t* ctx;
+  REQUIRE(tiledb_ctx_alloc(nullptr, &ctx) == TILEDB_OK);
+  tiledb_object_t type;
+  REQUIRE(tiledb_object_type(ctx, array_name, &type) == TILEDB_OK);
+  if (type == TILEDB_ARRAY)
+    REQUIRE(tiledb_object_remove(ctx, array_name) == TILEDB_OK);
+
+  // Create a 1D dense array
+  int dim_domain[] = {1, 4};
+  int tile_extent = 2;
+  tiledb_dimension_t* d;
+  REQUIRE(
+      tiledb_dimension_alloc(
+          ctx, "d", TILEDB_INT32, dim_domain, &tile_extent, &d) == TILEDB_OK);
+  tiledb_domain_t* domain;
+  REQUIRE(tiledb_domain_alloc(ctx, &domain) == TILEDB_OK);
+  REQUIRE(tiledb_domain_add_dimension(ctx, domain, d) == TILEDB_OK);
+  tiledb_attribute_t* a;
+  REQUIRE(tiledb_attribute_alloc(ctx, "a", TILEDB_INT32, &a) == TILEDB_OK);
+  tiledb_array_schema_t* schema;
+  REQUIRE(tiledb_array_schema_alloc(ctx, TILEDB_DENSE, &schema) == TILEDB_OK);
+  REQUIRE(tiledb_array_schema_set_domain(ctx, schema, domain) == TILEDB_OK);
+  REQUIRE(tiledb_array_schema_add_attribute(ctx, schema, a) == TILEDB_OK);
+  REQUIRE(tiledb_array_create(ctx, array_name, schema) == TILEDB_OK);
+  tiledb_attribute_free(&a);
+  tiledb_dimension_free(&d);
+  tiledb_domain_free(&domain);
+  tiledb_array_schema_free(&schema);
+
+  // Write without tracing
+  REQUIRE(tiledb_stats_trace_reset() == TILEDB_OK);
+  tiledb_array_t* array;
+  REQUIRE(tiledb_array_alloc(ctx, array_name, &array) == TILEDB_OK);
+  REQUIRE(tiledb_array_open(ctx, array, TILEDB_WRITE) == TILEDB_OK);
+  int data_w[] = {1, 2, 3, 4};
+  uint64_t data_w_size = sizeof(data_w);
+  tiledb_query_t* query;
+  REQUIRE(tiledb_query_alloc(ctx, array, TILEDB_WRITE, &query) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_buffer(ctx, query, "a", data_w, &data_w_size) ==
+      TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx, query) == TILEDB_OK);
+  tiledb_query_free(&query);
+  REQUIRE(tiledb_array_close(ctx, array) == TILEDB_OK);
+
+  // Read with tracing, but without stats
+  REQUIRE(tiledb_stats_trace_enable() == TILEDB_OK);
+  REQUIRE(tiledb_array_open(ctx, array, TILEDB_READ) == TILEDB_OK);
+  int data[4];
+  uint64_t data_size = sizeof(data);
+  REQUIRE(tiledb_query_alloc(ctx, array, TILEDB_READ, &query) == TILEDB_OK);
+  REQUIRE(
+      tiledb_query_set_buffer(ctx, query, "a", data, &data_size) == TILEDB_OK);
+  REQUIRE(tiledb_query_set_layout(ctx, query, TILEDB_ROW_MAJOR) == TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx, query) == TILEDB_OK);
+  CHECK(data[3] == 4);
+  uint64_t query_id = 0;
+  REQUIRE(tiledb_query_get_id(ctx, query, &query_id) == TILEDB_OK);
+  CHECK(query_id != 0);
+  REQUIRE(tiledb_stats_trace_disable() == TILEDB_OK);
+
+  char* trace_json = nullptr;
+  REQUIRE(tiledb_stats_trace_dump_str(&trace_json) == TILEDB_OK);
+  std::string trace_str(trace_json);
+  REQUIRE(tiledb_stats_free_str(&trace_json) == TILEDB_OK);
+  CHECK(trace_str.find("{\n  \"traceEvents\": [") == 0);
+#ifdef TILEDB_STATS
+  std::string read_event = "{\"name\": \"reader_read\", \"cat\": \"tiledb\", "
+                           "\"ph\": \"X\", \"ts\": ";
+  auto pos = trace_str.find(read_event);
+  REQUIRE(pos != std::string::npos);
+  auto end = trace_str.find('}', pos);
+  CHECK(
+      trace_str.substr(pos, end - pos)
+          .find("\"args\": {\"query_id\": " + std::to_string(query_id)) !=
+      std::string::npos);
+  CHECK(trace_str.find("\"writer_write\"") == std::string::npos);
+#endif
+
+  // Reset discards the events
+  REQUIRE(tiledb_stats_trace_reset() == TILEDB_OK);
+  REQUIRE(tiledb_stats_trace_dump_str(&trace_json) == TILEDB_OK);
+  trace_str = trace_json;
+  REQUIRE(tiledb_stats_free_str(&trace_json) == TILEDB_OK);
+  CHECK(trace_str.find("\"name\"") == std::string::npos);
+
+  tiledb_query_free(&query);
+  REQUIRE(tiledb_array_close(ctx, array) == TILEDB_OK);
+  tiledb_array_free(&array);
+  REQUIRE(tiledb_object_remove(ctx, array_name) == TILEDB_OK);
+  tiledb_ctx_free(&ctx);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file   unit-compression-lz4.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the lz4 compression.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/compressors/lz4_compressor.h"
+
+#include <string>
+
+using namespace tiledb::sm;
+
+TEST_CASE("Compression-LZ4: Test levels", "[compression], [lz4]") {
+  std::string input;
+  for (int i = 0; i < 5000; i++)
+    input += "value_" + std::to_string(i % 211) + ";";
+
+  uint64_t prev_size = 0;
+  for (int level : {-1, 1, 3, 9, 12, 20}) {
+    // Compress
+    ConstBuffer in(input.data(), input.size());
+    Buffer compressed;
+    REQUIRE(
+        compressed.realloc(input.size() + LZ4::overhead(input.size())).ok());
+    REQUIRE(LZ4::compress(level, &in, &compressed).ok());
+
+    // LZ4HC levels (from 3 on) compress at least as well as LZ4
+    if (level == 3)
+      CHECK(compressed.size() < prev_size);
+    prev_size = compressed.size();
+
+    // Decompress
+    ConstBuffer comp_in(compressed.data(), compressed.size());
+    std::string output(input.size(), 0);
+    PreallocatedBuffer out(&output[0], output.size());
+    REQUIRE(LZ4::decompress(&comp_in, &out).ok());
+    CHECK(output == input);
+  }
+}
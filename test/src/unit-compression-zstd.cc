@@ -0,0 +1,147 @@
+/**
+ * @file   unit-compression-zstd.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the zstd compression, with and without dictionary.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/compressors/zstd_compressor.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tiledb::sm;
+
+namespace {
+
+/** Returns a small record of the kind a dictionary helps compress. */
+std::string record(int i) {
+  return "{\"id\": " + std::to_string(i) + ", \"name\": \"user_" +
+         std::to_string(i % 101) + "\", \"email\": \"user_" +
+         std::to_string(i % 101) + "@example.com\", \"active\": " +
+         (i % 2 ? "true" : "false") + "}";
+}
+
+/** Compresses the input with the dictionary, returning the output size. */
+uint64_t compress(
+    const std::string& input, const ZStdDictionary* dict, Buffer* output) {
+  ConstBuffer in(input.data(), input.size());
+  REQUIRE(output->realloc(input.size() + ZStd::overhead(input.size())).ok());
+  REQUIRE(ZStd::compress(-1, dict, &in, output).ok());
+  return output->size();
+}
+
+/** Decompresses the input with the dictionary. */
+Status decompress(
+    const Buffer& input,
+    const ZStdDictionary* dict,
+    uint64_t size,
+    std::string* output) {
+  ConstBuffer in(input.data(), input.size());
+  output->assign(size, 0);
+  PreallocatedBuffer out(&(*output)[0], size);
+  return ZStd::decompress(dict, &in, &out);
+}
+
+}  // namespace
+
+TEST_CASE(
+    "Compression-ZStd: Test reusing contexts", "[compression], [zstd]") {
+  // Compress and decompress repeatedly from several threads
+  std::vector<std::thread> threads;
+  std::vector<bool> ok(4, true);
+  for (unsigned t = 0; t < ok.size(); t++) {
+    threads.emplace_back([&ok, t]() {
+      for (int i = 0; i < 100; i++) {
+        auto input = record(i * (t + 1));
+        Buffer compressed;
+        compress(input, nullptr, &compressed);
+        std::string output;
+        if (!decompress(compressed, nullptr, input.size(), &output).ok() ||
+            output != input)
+          ok[t] = false;
+      }
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+  for (auto thread_ok : ok)
+    CHECK(thread_ok);
+}
+
+TEST_CASE(
+    "Compression-ZStd: Test dictionaries",
+    "[compression], [zstd], [zstd-dictionary]") {
+  // Train a dictionary on many small records
+  std::vector<uint8_t> samples;
+  std::vector<size_t> sample_sizes;
+  for (int i = 0; i < 2000; i++) {
+    auto r = record(i);
+    samples.insert(samples.end(), r.begin(), r.end());
+    sample_sizes.push_back(r.size());
+  }
+  std::shared_ptr<ZStdDictionary> dict;
+  REQUIRE(ZStdDictionary::train(samples, sample_sizes, 4096, &dict).ok());
+  REQUIRE(dict != nullptr);
+  CHECK(dict->size() <= 4096);
+  CHECK(dict->id() != 0);
+
+  // A record compresses better with the dictionary
+  auto input = record(5000);
+  Buffer compressed, compressed_dict;
+  auto size = compress(input, nullptr, &compressed);
+  auto size_dict = compress(input, dict.get(), &compressed_dict);
+  CHECK(size_dict < size);
+
+  // Decompress with the dictionary
+  std::string output;
+  CHECK(decompress(compressed_dict, dict.get(), input.size(), &output).ok());
+  CHECK(output == input);
+
+  // Data compressed without dictionary is decompressed without it
+  CHECK(decompress(compressed, dict.get(), input.size(), &output).ok());
+  CHECK(output == input);
+
+  // Decompressing without the dictionary fails
+  CHECK(!decompress(compressed_dict, nullptr, input.size(), &output).ok());
+
+  // A copy of the serialized dictionary decompresses the same
+  ZStdDictionary dict_copy(dict->data(), dict->size());
+  CHECK(dict_copy.id() == dict->id());
+  CHECK(decompress(compressed_dict, &dict_copy, input.size(), &output).ok());
+  CHECK(output == input);
+
+  // Too few samples to train a dictionary
+  std::shared_ptr<ZStdDictionary> no_dict;
+  sample_sizes.resize(2);
+  samples.resize(sample_sizes[0] + sample_sizes[1]);
+  CHECK(ZStdDictionary::train(samples, sample_sizes, 4096, &no_dict).ok());
+  CHECK(no_dict == nullptr);
+}
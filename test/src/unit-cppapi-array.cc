@@ -32,8 +32,11 @@
 
 #include "catch.hpp"
 #include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/utils.h"
 
+#include <set>
+
 using namespace tiledb;
 
 struct Point {
@@ -935,3 +938,622 @@ TEST_CASE(
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
 }
+
+TEST_CASE("C++ API: Poll array", "[cppapi], [cppapi-poll-array]") {
+  Context ctx;
+  VFS vfs(ctx);
+  const std::string array_name = "cppapi_poll_array";
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create array
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 4}}, 4));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Open for reads while the array is empty
+  Array array_r(ctx, array_name, TILEDB_READ);
+  CHECK(array_r.poll().empty());
+
+  // Write two fragments
+  auto write = [&](const std::vector<int>& a_w) {
+    Array array_w(ctx, array_name, TILEDB_WRITE);
+    Query query_w(ctx, array_w);
+    std::vector<int> a = a_w;
+    query_w.set_layout(TILEDB_ROW_MAJOR).set_buffer("a", a);
+    query_w.submit();
+    array_w.close();
+  };
+  write({1, 2, 3, 4});
+  write({5, 6, 7, 8});
+
+  // Poll picks up both fragments
+  auto new_fragments = array_r.poll();
+  CHECK(new_fragments.size() == 2);
+  for (const auto& uri : new_fragments)
+    CHECK(uri.find(array_name) != std::string::npos);
+  CHECK(array_r.poll().empty());
+
+  // Read sees the latest fragment
+  std::vector<int> subarray = {1, 4};
+  std::vector<int> a_r(4);
+  Query query_r(ctx, array_r);
+  query_r.set_subarray(subarray)
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_r);
+  query_r.submit();
+  CHECK(a_r == std::vector<int>({5, 6, 7, 8}));
+
+  // Write one more fragment and poll again
+  write({9, 10, 11, 12});
+  auto last_fragments = array_r.poll();
+  REQUIRE(last_fragments.size() == 1);
+  CHECK(
+      std::find(
+          new_fragments.begin(), new_fragments.end(), last_fragments[0]) ==
+      new_fragments.end());
+
+  // After reopening at an earlier timestamp, all fragments are new again
+  array_r.reopen_at(0);
+  CHECK(array_r.poll().size() == 3);
+
+  // Write a partial fragment and consolidate in another context. Polling
+  // picks up the consolidated fragment and drops the deleted ones
+  {
+    Array array_w(ctx, array_name, TILEDB_WRITE);
+    Query query_w(ctx, array_w);
+    std::vector<int> a = {13, 14};
+    query_w.set_subarray<int>({1, 2})
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a", a);
+    query_w.submit();
+    array_w.close();
+  }
+  CHECK(array_r.poll().size() == 1);
+  {
+    Context ctx_c;
+    Array::consolidate(ctx_c, array_name);
+  }
+  CHECK(array_r.poll().size() == 1);
+  array_r.reopen_at(0);
+  CHECK(array_r.poll().size() == 1);
+  std::fill(a_r.begin(), a_r.end(), 0);
+  Query query_c(ctx, array_r);
+  query_c.set_subarray(subarray)
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_r);
+  query_c.submit();
+  CHECK(a_r == std::vector<int>({13, 14, 11, 12}));
+
+  array_r.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Fragment metadata sections",
+    "[cppapi], [cppapi-fragment-metadata-sections]") {
+  Context ctx;
+  VFS vfs(ctx);
+  const std::string array_name = "cppapi_fragment_metadata_sections";
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create array
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 4}}, 2));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(2);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  schema.add_attribute(Attribute::create<double>(ctx, "c"));
+  Array::create(array_name, schema);
+
+  // Write a fragment
+  std::vector<int> coords = {1, 2, 3, 4};
+  std::vector<int> a = {1, 2, 3, 4};
+  std::string b = "abbcccdddd";
+  std::vector<uint64_t> b_off = {0, 1, 3, 6};
+  std::vector<double> c = {1.1, 2.2, 3.3, 4.4};
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_buffer("a", a)
+      .set_buffer("b", b_off, b)
+      .set_buffer("c", c)
+      .set_coordinates(coords);
+  query_w.submit();
+  array_w.close();
+
+  // The metadata file ends with the size of the footer, which follows the
+  // separately stored sections
+  std::string fragment_uri;
+  for (const auto& uri : vfs.ls(array_name)) {
+    if (uri.find("/__") != std::string::npos &&
+        uri.find(".tdb") == std::string::npos)
+      fragment_uri = uri;
+  }
+  REQUIRE(!fragment_uri.empty());
+  auto metadata_uri = fragment_uri + "/__fragment_metadata.tdb";
+  auto file_size = vfs.file_size(metadata_uri);
+  REQUIRE(file_size > sizeof(uint64_t));
+  uint64_t footer_size = 0;
+  VFS::filebuf fbuf(vfs);
+  fbuf.open(metadata_uri, std::ios::in);
+  std::istream is(&fbuf);
+  is.seekg(file_size - sizeof(uint64_t));
+  is.read((char*)&footer_size, sizeof(uint64_t));
+  fbuf.close();
+  CHECK(footer_size > 0);
+  CHECK(footer_size < file_size - sizeof(uint64_t));
+
+  // Read a single attribute with a fresh context, so that only the needed
+  // sections are loaded
+  Context ctx_r;
+  Array array_r(ctx_r, array_name, TILEDB_READ);
+  std::vector<int> subarray = {2, 3};
+  std::vector<double> c_r(2);
+  Query query_r(ctx_r, array_r);
+  query_r.set_subarray(subarray).set_layout(TILEDB_ROW_MAJOR);
+  query_r.set_buffer("c", c_r);
+  query_r.submit();
+  CHECK(c_r == std::vector<double>({2.2, 3.3}));
+
+  // Load the remaining sections for another query on the same array
+  auto max_sizes = array_r.max_buffer_elements(subarray);
+  CHECK(max_sizes["b"].second >= 5);
+  std::vector<int> a_r(2);
+  std::string b_r;
+  b_r.resize(max_sizes["b"].second);
+  std::vector<uint64_t> b_off_r(max_sizes["b"].first);
+  Query query_r2(ctx_r, array_r);
+  query_r2.set_subarray(subarray)
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_r)
+      .set_buffer("b", b_off_r, b_r);
+  query_r2.submit();
+  auto result_num = query_r2.result_buffer_elements();
+  CHECK(a_r == std::vector<int>({2, 3}));
+  CHECK(result_num["b"].first == 2);
+  CHECK(b_r.substr(0, result_num["b"].second) == "bbccc");
+  CHECK(b_off_r[0] == 0);
+  CHECK(b_off_r[1] == 2);
+  array_r.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Incomplete sparse read with skewed data",
+    "[cppapi], [cppapi-incomplete-skewed]") {
+  const std::string array_name = "cppapi_incomplete_skewed";
+  std::string utilization;
+  SECTION("- Full utilization") {
+    utilization = "1";
+  }
+  SECTION("- Half utilization") {
+    utilization = "0.5";
+  }
+
+  Config config;
+  CHECK_THROWS(config["sm.read_partition_utilization"] = "0");
+  CHECK_THROWS(config["sm.read_partition_utilization"] = "1.5");
+  config["sm.read_partition_utilization"] = utilization;
+  Context ctx(config);
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create array
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d1", {{1, 1000}}, 100))
+      .add_dimension(Dimension::create<int>(ctx, "d2", {{1, 1000}}, 100));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(100);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Most cells are in the first rows, the rest are spread out
+  std::vector<int> coords, a;
+  for (int i = 1; i <= 10; i++) {
+    for (int j = 1; j <= 100; j++) {
+      coords.push_back(i);
+      coords.push_back(j);
+      a.push_back(i * 1000 + j);
+    }
+  }
+  for (int i = 101; i <= 1000; i += 100) {
+    coords.push_back(i);
+    coords.push_back(500);
+    a.push_back(i * 1000 + 500);
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_buffer("a", a)
+      .set_coordinates(coords);
+  query_w.submit();
+  array_w.close();
+
+  // Read with buffers that hold a small fraction of the results
+  Array array_r(ctx, array_name, TILEDB_READ);
+  const uint64_t buffer_cells = 64;
+  std::vector<int> a_r(buffer_cells), coords_r(2 * buffer_cells);
+  std::vector<int> a_all, coords_all;
+  Query query_r(ctx, array_r);
+  query_r.set_subarray<int>({1, 1000, 1, 1000})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_r)
+      .set_coordinates(coords_r);
+  unsigned submissions = 0;
+  do {
+    query_r.submit();
+    submissions++;
+    auto result_num = query_r.result_buffer_elements()["a"].second;
+    REQUIRE(result_num > 0);
+    a_all.insert(a_all.end(), a_r.begin(), a_r.begin() + result_num);
+    coords_all.insert(
+        coords_all.end(), coords_r.begin(), coords_r.begin() + 2 * result_num);
+  } while (query_r.query_status() == Query::Status::INCOMPLETE &&
+           submissions < 1000);
+  array_r.close();
+
+  CHECK(query_r.query_status() == Query::Status::COMPLETE);
+  CHECK(a_all == a);
+  CHECK(coords_all == coords);
+  auto min_submissions = (a.size() + buffer_cells - 1) / buffer_cells;
+  CHECK(submissions >= min_submissions);
+  CHECK(submissions <= 4 * min_submissions);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Incomplete read resumes without re-reading tiles",
+    "[cppapi], [cppapi-incomplete-resume]") {
+  const std::string array_name = "cppapi_incomplete_resume";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create array
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1000}}, 1000));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(100);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  // Write a single tile with 99 cells in [1, 99] and one cell at 1000, with
+  // var-sized values of varying length
+  std::vector<int> coords, a;
+  std::vector<uint64_t> b_off;
+  std::string b;
+  for (int i = 1; i <= 100; i++) {
+    auto c = (i < 100) ? i : 1000;
+    coords.push_back(c);
+    a.push_back(c);
+    b_off.push_back(b.size());
+    b.append((size_t)(i % 3 + 1), (char)('a' + i % 26));
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_buffer("a", a)
+      .set_buffer("b", b_off, b)
+      .set_coordinates(coords);
+  query_w.submit();
+  array_w.close();
+
+  // The tile MBR is ten times larger than the subarray, so its results are
+  // estimated to fit the buffers in a single partition. They are copied
+  // over several submissions instead.
+  Stats::enable();
+  Stats::reset();
+  Array array_r(ctx, array_name, TILEDB_READ);
+  std::vector<int> coords_r(12), a_r(12);
+  std::vector<uint64_t> b_off_r(12);
+  std::string b_r;
+  b_r.resize(30);
+  std::vector<int> coords_all, a_all;
+  std::vector<uint64_t> b_off_all;
+  std::string b_all;
+  Query query_r(ctx, array_r);
+  query_r.set_subarray<int>({1, 100})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_r)
+      .set_buffer("b", b_off_r, b_r)
+      .set_coordinates(coords_r);
+  unsigned submissions = 0;
+  uint64_t tiles_touched = 0;
+  do {
+    query_r.submit();
+    submissions++;
+    auto result_num = query_r.result_buffer_elements()["a"].second;
+    auto result_var_size = query_r.result_buffer_elements()["b"].second;
+    REQUIRE(result_num > 0);
+    CHECK(query_r.result_buffer_elements()["b"].first == result_num);
+    coords_all.insert(
+        coords_all.end(), coords_r.begin(), coords_r.begin() + result_num);
+    a_all.insert(a_all.end(), a_r.begin(), a_r.begin() + result_num);
+    for (uint64_t i = 0; i < result_num; i++)
+      b_off_all.push_back(b_all.size() + b_off_r[i]);
+    b_all.append(b_r.substr(0, result_var_size));
+
+    // The tiles are read only by the first submission
+    uint64_t touched =
+        tiledb::sm::stats::all_stats.counter_reader_num_attr_tiles_touched;
+    if (submissions == 1)
+      tiles_touched = touched;
+    CHECK(touched == tiles_touched);
+  } while (query_r.query_status() == Query::Status::INCOMPLETE &&
+           submissions < 1000);
+  array_r.close();
+  Stats::disable();
+
+  // The cell at 1000 is outside the subarray
+  coords.pop_back();
+  a.pop_back();
+  b.resize(b_off.back());
+  b_off.pop_back();
+  CHECK(query_r.query_status() == Query::Status::COMPLETE);
+  CHECK(submissions > 1);
+  CHECK(tiles_touched > 0);
+  CHECK(coords_all == coords);
+  CHECK(a_all == a);
+  CHECK(b_off_all == b_off);
+  CHECK(b_all == b);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Incomplete dense read resumes with coordinates",
+    "[cppapi], [cppapi-incomplete-resume]") {
+  const std::string array_name = "cppapi_incomplete_resume_dense";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create array
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 100}}, 100));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  // The first cells have much larger values than the rest
+  std::vector<uint64_t> b_off;
+  std::string b;
+  for (int i = 1; i <= 100; i++) {
+    b_off.push_back(b.size());
+    b.append((size_t)(i <= 10 ? 20 : 1), (char)('a' + i % 26));
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_ROW_MAJOR).set_buffer("b", b_off, b);
+  query_w.submit();
+  array_w.close();
+
+  // The estimated results fit the buffers, but the actual ones do not
+  Array array_r(ctx, array_name, TILEDB_READ);
+  std::vector<int> coords_r(50);
+  std::vector<uint64_t> b_off_r(50);
+  std::string b_r;
+  b_r.resize(150);
+  std::vector<int> coords_all;
+  std::string b_all;
+  Query query_r(ctx, array_r);
+  query_r.set_subarray<int>({1, 50})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("b", b_off_r, b_r)
+      .set_coordinates(coords_r);
+  unsigned submissions = 0;
+  do {
+    query_r.submit();
+    submissions++;
+    auto result_num = query_r.result_buffer_elements()["b"].first;
+    auto result_var_size = query_r.result_buffer_elements()["b"].second;
+    REQUIRE(result_num > 0);
+    CHECK(query_r.result_buffer_elements()[TILEDB_COORDS].second == result_num);
+    coords_all.insert(
+        coords_all.end(), coords_r.begin(), coords_r.begin() + result_num);
+    b_all.append(b_r.substr(0, result_var_size));
+  } while (query_r.query_status() == Query::Status::INCOMPLETE &&
+           submissions < 1000);
+  array_r.close();
+
+  std::vector<int> coords(50);
+  for (int i = 0; i < 50; i++)
+    coords[i] = i + 1;
+  CHECK(query_r.query_status() == Query::Status::COMPLETE);
+  CHECK(submissions > 1);
+  CHECK(coords_all == coords);
+  CHECK(b_all == b.substr(0, b_off[50]));
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Async queries with a completion queue",
+    "[cppapi], [cppapi-completion-queue]") {
+  const std::string array_name = "cpp_unit_array_cq";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create and write a 4x4 dense array
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "rows", {{0, 3}}, 4))
+      .add_dimension(Dimension::create<int>(ctx, "cols", {{0, 3}}, 4));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+  std::vector<int> data_w = {
+      0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_ROW_MAJOR).set_buffer("a", data_w);
+  query_w.submit();
+  array_w.close();
+
+  // Read each row with a separate async query
+  CompletionQueue cq(ctx);
+  CompletionQueue::Event event;
+  CHECK(!cq.poll(&event));
+  CHECK(!cq.wait(&event, 0));
+
+  Array array(ctx, array_name, TILEDB_READ);
+  std::vector<std::vector<int>> data(4, std::vector<int>(4));
+  std::vector<std::unique_ptr<Query>> queries;
+  for (int i = 0; i < 4; ++i) {
+    queries.emplace_back(new Query(ctx, array));
+    queries[i]
+        ->set_subarray<int>({i, i, 0, 3})
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a", data[i]);
+    queries[i]->submit_async(cq, queries[i].get());
+  }
+
+  std::set<void*> tags;
+  for (int i = 0; i < 4; ++i) {
+    event = cq.wait();
+    CHECK(event.status == TILEDB_COMPLETED);
+    tags.insert(event.tag);
+  }
+  CHECK(tags.size() == 4);
+  CHECK(!cq.poll(&event));
+
+  for (int i = 0; i < 4; ++i) {
+    CHECK(tags.count(queries[i].get()) == 1);
+    for (int j = 0; j < 4; ++j)
+      CHECK(data[i][j] == 4 * i + j);
+  }
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Generic tile prefetch",
+    "[cppapi], [cppapi-generic-tile-prefetch]") {
+  const std::string array_name = "cpp_unit_array_generic_tile_prefetch";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a sparse array with two fragments
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1000}}, 100));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(10);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  std::vector<int> coords, a;
+  std::vector<uint64_t> b_off;
+  std::string b;
+  for (int f = 0; f < 2; f++) {
+    std::vector<int> coords_w, a_w;
+    std::vector<uint64_t> b_off_w;
+    std::string b_w;
+    for (int i = 1 + f; i <= 1000; i += 2) {
+      coords_w.push_back(i);
+      a_w.push_back(i);
+      b_off_w.push_back(b_w.size());
+      b_w.append((size_t)(1 + i % 3), (char)('a' + i % 26));
+    }
+    Array array_w(ctx, array_name, TILEDB_WRITE);
+    Query query_w(ctx, array_w);
+    query_w.set_layout(TILEDB_UNORDERED)
+        .set_buffer("a", a_w)
+        .set_buffer("b", b_off_w, b_w)
+        .set_coordinates(coords_w);
+    query_w.submit();
+    array_w.close();
+  }
+  for (int i = 1; i <= 1000; i++) {
+    coords.push_back(i);
+    a.push_back(i);
+    b_off.push_back(b.size());
+    b.append((size_t)(1 + i % 3), (char)('a' + i % 26));
+  }
+
+  // Read with a fresh context (i.e. empty caches) for each prefetch size,
+  // covering no prefetch, a partially prefetched header, a partially
+  // prefetched tile and entirely prefetched tiles
+  std::map<std::string, uint64_t> num_reads;
+  for (std::string prefetch_size : {"0", "8", "100", "65536"}) {
+    Config config;
+    config["sm.generic_tile_prefetch_size"] = prefetch_size;
+    Context ctx_r(config);
+    Stats::reset();
+    Stats::enable();
+    Array array_r(ctx_r, array_name, TILEDB_READ);
+    std::vector<int> coords_r(1000), a_r(1000);
+    std::vector<uint64_t> b_off_r(1000);
+    std::string b_r;
+    b_r.resize(b.size());
+    Query query_r(ctx_r, array_r);
+    query_r.set_subarray<int>({1, 1000})
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a", a_r)
+        .set_buffer("b", b_off_r, b_r)
+        .set_coordinates(coords_r);
+    query_r.submit();
+    array_r.close();
+    num_reads[prefetch_size] =
+        tiledb::sm::stats::all_stats.vfs_read_call_count;
+    Stats::disable();
+
+    CHECK(query_r.query_status() == Query::Status::COMPLETE);
+    CHECK(coords_r == coords);
+    CHECK(a_r == a);
+    CHECK(b_off_r == b_off);
+    CHECK(b_r == b);
+  }
+
+  // Prefetching saves a request per generic tile
+  CHECK(num_reads["65536"] < num_reads["0"]);
+
+  // Loading the metadata of a fragment that is not cached takes four
+  // requests: the existence check, the file size, the header (which holds
+  // the format version) and the tail of the file (which holds the footer
+  // and its size). Opening at timestamp 0
+  // lists the fragments without loading their metadata, which isolates
+  // that cost.
+  auto num_requests = [&](uint64_t timestamp) -> uint64_t {
+    Context ctx_r;
+    Stats::reset();
+    Stats::enable();
+    Array array_r(ctx_r, array_name, TILEDB_READ, timestamp);
+    array_r.close();
+    Stats::disable();
+    const auto& stats = tiledb::sm::stats::all_stats;
+    return (uint64_t)stats.vfs_is_file_call_count +
+           (uint64_t)stats.vfs_file_size_call_count +
+           (uint64_t)stats.vfs_read_call_count;
+  };
+  CHECK(num_requests(UINT64_MAX) - num_requests(0) == 2 * 4);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
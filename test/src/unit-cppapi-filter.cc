@@ -32,6 +32,7 @@
 
 #include "catch.hpp"
 #include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/misc/stats.h"
 
 static void check_filters(
     const tiledb::FilterList& answer, const tiledb::FilterList& check) {
@@ -221,4 +222,399 @@ TEST_CASE("C++ API: Filter lists on array", "[cppapi], [filter]") {
   // Clean up
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
-}
\ No newline at end of file
+}
+
+TEST_CASE("C++ API: Filter lists on dimensions", "[cppapi], [filter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array";
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create schema with a filter list on the first dimension only
+  FilterList d1_filters(ctx);
+  d1_filters.add_filter({ctx, TILEDB_FILTER_DOUBLE_DELTA})
+      .add_filter({ctx, TILEDB_FILTER_LZ4});
+  FilterList coords_filters(ctx);
+  coords_filters.add_filter({ctx, TILEDB_FILTER_ZSTD});
+
+  auto d1 = Dimension::create<int64_t>(ctx, "d1", {{1, 100}}, 10);
+  auto d2 = Dimension::create<int64_t>(ctx, "d2", {{1, 100}}, 10);
+  d1.set_filter_list(d1_filters);
+  Domain domain(ctx);
+  domain.add_dimensions(d1, d2);
+
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.set_coords_filter_list(coords_filters);
+  Array::create(array_name, schema);
+
+  // Write to array
+  std::vector<int> a_data;
+  std::vector<int64_t> coords;
+  for (int i = 0; i < 20; i++) {
+    a_data.push_back(i);
+    coords.push_back(i + 1);
+    coords.push_back(20 - i);
+  }
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_buffer("a", a_data)
+      .set_coordinates(coords)
+      .set_layout(TILEDB_UNORDERED);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  // The coordinates are stored per dimension
+  std::string fragment_uri;
+  for (const auto& uri : vfs.ls(array_name)) {
+    if (vfs.is_dir(uri) && uri.find("__") != std::string::npos)
+      fragment_uri = uri;
+  }
+  REQUIRE(!fragment_uri.empty());
+  CHECK(vfs.is_file(fragment_uri + "/__coords_0.tdb"));
+  CHECK(vfs.is_file(fragment_uri + "/__coords_1.tdb"));
+  CHECK(!vfs.is_file(fragment_uri + "/__coords.tdb"));
+
+  // Read a subarray crossing several tiles
+  array.open(TILEDB_READ);
+  std::vector<int64_t> subarray = {3, 12, 9, 15};
+  std::vector<int> a_read(20);
+  std::vector<int64_t> coords_read(40);
+  Query query_r(ctx, array);
+  query_r.set_subarray(subarray)
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_read)
+      .set_coordinates(coords_read);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  auto ret = query_r.result_buffer_elements();
+  REQUIRE(ret["a"].second == 7);
+  for (int i = 0; i < 7; i++) {
+    REQUIRE(a_read[i] == 5 + i);
+    REQUIRE(coords_read[2 * i] == 6 + i);
+    REQUIRE(coords_read[2 * i + 1] == 15 - i);
+  }
+
+  // Check reading filter lists.
+  auto dims = array.schema().domain().dimensions();
+  check_filters(d1_filters, dims[0].filter_list());
+  REQUIRE(dims[1].filter_list().nfilters() == 0);
+  check_filters(coords_filters, array.schema().coords_filter_list());
+  array.close();
+
+  // Clean up
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Filter lists with zstd dictionaries",
+    "[cppapi], [filter], [zstd-dictionary]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array";
+  std::string array_name_dict = "cpp_unit_array_dict";
+  const int ncells = 20000;
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+  if (vfs.is_dir(array_name_dict))
+    vfs.remove_dir(array_name_dict);
+
+  // Small tiles of similar values, which compress poorly on their own
+  std::vector<int64_t> a_data;
+  std::vector<std::string> s_data;
+  for (int i = 0; i < ncells; i++) {
+    a_data.push_back(1000000 + (i % 1000) * 37);
+    s_data.push_back(
+        "{\"user\": \"user_" + std::to_string(i % 997) +
+        "@example.com\", \"status\": \"" + (i % 3 ? "active" : "inactive") +
+        "\", \"group\": " + std::to_string(i % 13) + "}");
+  }
+  auto s_buf = ungroup_var_buffer(s_data);
+
+  auto create_and_write = [&](const Context& write_ctx,
+                              const std::string& name) {
+    FilterList filters(write_ctx);
+    filters.add_filter({write_ctx, TILEDB_FILTER_ZSTD});
+    auto a = Attribute::create<int64_t>(write_ctx, "a");
+    auto s = Attribute::create<std::string>(write_ctx, "s");
+    a.set_filter_list(filters);
+    s.set_filter_list(filters);
+
+    Domain domain(write_ctx);
+    domain.add_dimension(
+        Dimension::create<int>(write_ctx, "d", {{1, ncells}}, 20));
+    ArraySchema schema(write_ctx, TILEDB_DENSE);
+    schema.set_domain(domain).add_attributes(a, s);
+    Array::create(name, schema);
+
+    Array array(write_ctx, name, TILEDB_WRITE);
+    Query query(write_ctx, array);
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_subarray<int>({1, ncells})
+        .set_buffer("a", a_data)
+        .set_buffer("s", s_buf);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+  };
+
+  auto read_and_check = [&](const std::string& name) {
+    Array array(ctx, name, TILEDB_READ);
+    std::vector<int> subarray = {1, ncells};
+    auto buff_el = array.max_buffer_elements(subarray);
+    std::vector<int64_t> a_read(buff_el["a"].second);
+    std::vector<uint64_t> s_read_off(buff_el["s"].first);
+    std::string s_read_data;
+    s_read_data.resize(buff_el["s"].second);
+    Query query(ctx, array);
+    query.set_subarray(subarray)
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a", a_read)
+        .set_buffer("s", s_read_off, s_read_data);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+
+    auto ret = query.result_buffer_elements();
+    REQUIRE(ret["a"].second == (uint64_t)ncells);
+    REQUIRE(ret["s"].second == s_buf.second.size());
+    s_read_data.resize(ret["s"].second);
+    CHECK(a_read == a_data);
+    CHECK(s_read_off == s_buf.first);
+    CHECK(
+        s_read_data ==
+        std::string(s_buf.second.begin(), s_buf.second.end()));
+  };
+
+  // Write without and with dictionaries
+  create_and_write(ctx, array_name);
+  Config config;
+  config["sm.zstd_dictionary_size"] = "4096";
+  Context ctx_dict(config);
+  create_and_write(ctx_dict, array_name_dict);
+
+  // The dictionaries are stored in the fragment, so reading needs no config
+  read_and_check(array_name);
+  read_and_check(array_name_dict);
+  CHECK(vfs.dir_size(array_name_dict) < vfs.dir_size(array_name));
+
+  // Write the two halves of an array with the same schema in fragments of
+  // their own, then consolidate. The fragments do not overlap, but each has
+  // its own dictionaries, so their tiles are not copied verbatim.
+  std::string array_name_halves = "cpp_unit_array_dict_halves";
+  if (vfs.is_dir(array_name_halves))
+    vfs.remove_dir(array_name_halves);
+  Array::create(array_name_halves, ArraySchema(ctx, array_name_dict));
+  const int half = ncells / 2;
+  for (int h = 0; h < 2; h++) {
+    int begin = h * half, end = (h + 1) * half;
+    std::vector<int64_t> a_half(a_data.begin() + begin, a_data.begin() + end);
+    uint64_t s_start = s_buf.first[begin];
+    uint64_t s_end = h == 1 ? s_buf.second.size() : s_buf.first[end];
+    std::vector<uint64_t> s_half_off;
+    for (int i = begin; i < end; i++)
+      s_half_off.push_back(s_buf.first[i] - s_start);
+    std::vector<char> s_half_data(
+        s_buf.second.begin() + s_start, s_buf.second.begin() + s_end);
+    Array array(ctx_dict, array_name_halves, TILEDB_WRITE);
+    Query query(ctx_dict, array);
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_subarray<int>({begin + 1, end})
+        .set_buffer("a", a_half)
+        .set_buffer("s", s_half_off, s_half_data);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+  }
+  Stats::reset();
+  Stats::enable();
+  Array::consolidate(ctx, array_name_halves);
+  Stats::disable();
+  const auto& stats = tiledb::sm::stats::all_stats;
+  CHECK(stats.counter_consolidator_num_tiles_copied == 0);
+  read_and_check(array_name_halves);
+
+  // Clean up
+  if (vfs.is_dir(array_name_halves))
+    vfs.remove_dir(array_name_halves);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+  if (vfs.is_dir(array_name_dict))
+    vfs.remove_dir(array_name_dict);
+}
+
+TEST_CASE(
+    "C++ API: Filter lists with checksums", "[cppapi], [filter], [checksum]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array";
+  const int ncells = 1000;
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create and write the array
+  FilterList filters(ctx);
+  filters.add_filter({ctx, TILEDB_FILTER_CHECKSUM_CRC32C});
+  auto a = Attribute::create<int>(ctx, "a");
+  a.set_filter_list(filters);
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, ncells}}, 100));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).add_attribute(a);
+  Array::create(array_name, schema);
+
+  std::vector<int> a_data(ncells);
+  for (int i = 0; i < ncells; i++)
+    a_data[i] = i;
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_layout(TILEDB_ROW_MAJOR)
+      .set_subarray<int>({1, ncells})
+      .set_buffer("a", a_data);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  // Reads with a new context each time, so that no tile is cached
+  auto read = [&](const Config& config, std::vector<int>* a_read) {
+    Context read_ctx(config);
+    Array array(read_ctx, array_name, TILEDB_READ);
+    Query query(read_ctx, array);
+    a_read->assign(ncells, 0);
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_subarray<int>({1, ncells})
+        .set_buffer("a", *a_read);
+    auto st = query.submit();
+    array.close();
+    return st;
+  };
+
+  std::vector<int> a_read;
+  CHECK_NOTHROW(read(Config(), &a_read));
+  CHECK(a_read == a_data);
+
+  // Corrupt the last byte of the attribute file, i.e., of the last value
+  std::string attr_file;
+  for (const auto& uri : vfs.ls(array_name)) {
+    if (vfs.is_file(uri + "/a.tdb"))
+      attr_file = uri + "/a.tdb";
+  }
+  REQUIRE(!attr_file.empty());
+  auto file_size = vfs.file_size(attr_file);
+  std::vector<char> bytes(file_size);
+  {
+    VFS::filebuf fbuf(vfs);
+    fbuf.open(attr_file, std::ios::in);
+    std::istream is(&fbuf);
+    is.read(bytes.data(), file_size);
+  }
+  bytes[file_size - 1] ^= 1;
+  vfs.remove_file(attr_file);
+  {
+    VFS::filebuf fbuf(vfs);
+    fbuf.open(attr_file, std::ios::out);
+    std::ostream os(&fbuf);
+    os.write(bytes.data(), file_size);
+  }
+
+  // The read fails, unless the checksums are not verified
+  CHECK_THROWS(read(Config(), &a_read));
+  Config config;
+  config["sm.verify_checksums"] = "false";
+  CHECK_NOTHROW(read(config, &a_read));
+  CHECK(a_read[ncells - 1] == ((ncells - 1) ^ (1 << 24)));
+
+  // Clean up
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Filter lists on dimensions in global order",
+    "[cppapi], [filter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array";
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  FilterList d1_filters(ctx);
+  d1_filters.add_filter({ctx, TILEDB_FILTER_DOUBLE_DELTA});
+  auto d1 = Dimension::create<int64_t>(ctx, "d1", {{1, 100}}, 10);
+  auto d2 = Dimension::create<int64_t>(ctx, "d2", {{1, 100}}, 10);
+  d1.set_filter_list(d1_filters);
+  Domain domain(ctx);
+  domain.add_dimensions(d1, d2);
+
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Write in global order with two submissions, so that the files stay
+  // open across them. Row-major tile and cell orders: the cells (i, i) for
+  // i in [1, 20] are in global order.
+  std::vector<int> a_data[2];
+  std::vector<int64_t> coords[2];
+  for (int i = 0; i < 20; i++) {
+    a_data[i / 10].push_back(i);
+    coords[i / 10].push_back(i + 1);
+    coords[i / 10].push_back(i + 1);
+  }
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_layout(TILEDB_GLOBAL_ORDER);
+  for (int s = 0; s < 2; s++) {
+    query.set_buffer("a", a_data[s]).set_coordinates(coords[s]);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+  }
+
+  // Finalizing closes the attribute file, the file of each dimension and
+  // the fragment metadata file
+  Stats::reset();
+  Stats::enable();
+  query.finalize();
+  Stats::disable();
+  CHECK(tiledb::sm::stats::all_stats.vfs_close_file_call_count == 4);
+  array.close();
+
+  std::string fragment_uri;
+  for (const auto& uri : vfs.ls(array_name)) {
+    if (vfs.is_dir(uri) && uri.find("__") != std::string::npos)
+      fragment_uri = uri;
+  }
+  REQUIRE(!fragment_uri.empty());
+  CHECK(vfs.is_file(fragment_uri + "/__coords_0.tdb"));
+  CHECK(vfs.is_file(fragment_uri + "/__coords_1.tdb"));
+  CHECK(!vfs.is_file(fragment_uri + "/__coords.tdb"));
+
+  // Read back all the cells
+  array.open(TILEDB_READ);
+  std::vector<int64_t> subarray = {1, 100, 1, 100};
+  std::vector<int> a_read(20);
+  std::vector<int64_t> coords_read(40);
+  Query query_r(ctx, array);
+  query_r.set_subarray(subarray)
+      .set_layout(TILEDB_GLOBAL_ORDER)
+      .set_buffer("a", a_read)
+      .set_coordinates(coords_read);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  auto ret = query_r.result_buffer_elements();
+  REQUIRE(ret["a"].second == 20);
+  for (int i = 0; i < 20; i++) {
+    CHECK(a_read[i] == i);
+    CHECK(coords_read[2 * i] == i + 1);
+    CHECK(coords_read[2 * i + 1] == i + 1);
+  }
+  array.close();
+
+  // Clean up
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
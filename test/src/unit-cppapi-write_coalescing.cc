@@ -0,0 +1,363 @@
+/**
+ * @file   unit-cppapi-write_coalescing.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the coalescing of small unordered writes using the C++ API.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cpp_api/tiledb"
+
+#include <chrono>
+#include <thread>
+
+using namespace tiledb;
+
+namespace {
+
+const std::string array_name = "cppapi_write_coalescing";
+
+/** Creates a 1D sparse array with a fixed and a var-sized attribute. */
+void create_array(const Context& ctx) {
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+}
+
+/** Writes a single cell with an unordered write. */
+void write_cell(const Context& ctx, int coord, int a, std::string b) {
+  std::vector<int> coords = {coord};
+  std::vector<int> a_data = {a};
+  std::vector<uint64_t> b_offsets = {0};
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_layout(TILEDB_UNORDERED)
+      .set_buffer("a", a_data)
+      .set_buffer("b", b_offsets, b)
+      .set_coordinates(coords);
+  query.submit();
+  query.finalize();
+  array.close();
+}
+
+/** Returns the number of fragments of the array. */
+uint64_t fragment_num(const Context& ctx) {
+  VFS vfs(ctx);
+  uint64_t num = 0;
+  for (const auto& uri : vfs.ls(array_name)) {
+    auto name = uri.substr(uri.find_last_of('/') + 1);
+    if (name.find("__") == 0 && vfs.is_dir(uri))
+      ++num;
+  }
+  return num;
+}
+
+/** Reads all the cells of the array, in global order. */
+void read_cells(
+    const Context& ctx,
+    std::vector<int>* coords,
+    std::vector<int>* a_data,
+    std::vector<std::string>* b_data) {
+  Array array(ctx, array_name, TILEDB_READ);
+  std::vector<int> subarray = {1, 100};
+  auto max_el = array.max_buffer_elements(subarray);
+  coords->resize(max_el[TILEDB_COORDS].second);
+  a_data->resize(max_el["a"].second);
+  std::vector<uint64_t> b_offsets(max_el["b"].first);
+  std::string b_values;
+  b_values.resize(max_el["b"].second);
+
+  Query query(ctx, array);
+  query.set_subarray(subarray)
+      .set_layout(TILEDB_GLOBAL_ORDER)
+      .set_buffer("a", *a_data)
+      .set_buffer("b", b_offsets, b_values)
+      .set_coordinates(*coords);
+  query.submit();
+  REQUIRE(query.query_status() == Query::Status::COMPLETE);
+
+  auto result_el = query.result_buffer_elements();
+  coords->resize(result_el[TILEDB_COORDS].second);
+  a_data->resize(result_el["a"].second);
+  b_offsets.resize(result_el["b"].first);
+  b_values.resize(result_el["b"].second);
+  b_data->clear();
+  for (size_t i = 0; i < b_offsets.size(); ++i) {
+    auto end = (i + 1 < b_offsets.size()) ? b_offsets[i + 1] : b_values.size();
+    b_data->push_back(b_values.substr(b_offsets[i], end - b_offsets[i]));
+  }
+  array.close();
+}
+
+}  // namespace
+
+TEST_CASE(
+    "C++ API: Write coalescing, buffered writes and flushes",
+    "[cppapi], [write-coalescing]") {
+  Config config;
+  config["sm.write_coalescing.max_bytes"] = "1048576";
+  config["sm.write_coalescing.max_age_ms"] = "0";
+  Context ctx(config);
+  create_array(ctx);
+
+  SECTION("- Flushed when opened for reads, latest write wins") {
+    write_cell(ctx, 5, 50, "five");
+    write_cell(ctx, 2, 20, "two");
+    write_cell(ctx, 5, 55, "FIVE");
+    write_cell(ctx, 9, 90, "nine!");
+    CHECK(fragment_num(ctx) == 0);
+
+    std::vector<int> coords, a_data;
+    std::vector<std::string> b_data;
+    read_cells(ctx, &coords, &a_data, &b_data);
+    CHECK(fragment_num(ctx) == 1);
+    CHECK(coords == std::vector<int>({2, 5, 9}));
+    CHECK(a_data == std::vector<int>({20, 55, 90}));
+    CHECK(b_data == std::vector<std::string>({"two", "FIVE", "nine!"}));
+  }
+
+  SECTION("- Explicit flush") {
+    write_cell(ctx, 1, 10, "one");
+    write_cell(ctx, 3, 30, "three");
+    CHECK(fragment_num(ctx) == 0);
+    ctx.flush_writes();
+    CHECK(fragment_num(ctx) == 1);
+
+    // Nothing is left to flush
+    ctx.flush_writes();
+    CHECK(fragment_num(ctx) == 1);
+  }
+
+  SECTION("- Duplicates within a write are rejected") {
+    std::vector<int> coords = {6, 6};
+    std::vector<int> a_data = {60, 66};
+    std::vector<uint64_t> b_offsets = {0, 3};
+    std::string b_values = "sixSIX";
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_buffer("a", a_data)
+        .set_buffer("b", b_offsets, b_values)
+        .set_coordinates(coords);
+    CHECK_THROWS(query.submit());
+    array.close();
+
+    // Nothing was buffered
+    ctx.flush_writes();
+    CHECK(fragment_num(ctx) == 0);
+  }
+
+  SECTION("- Flushed before a global order write") {
+    write_cell(ctx, 4, 40, "four");
+    std::vector<int> coords = {4};
+    std::vector<int> a_data = {44};
+    std::vector<uint64_t> b_offsets = {0};
+    std::string b_values = "FOUR";
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_GLOBAL_ORDER)
+        .set_buffer("a", a_data)
+        .set_buffer("b", b_offsets, b_values)
+        .set_coordinates(coords);
+    query.submit();
+    query.finalize();
+    array.close();
+    CHECK(fragment_num(ctx) == 2);
+
+    std::vector<std::string> b_data;
+    read_cells(ctx, &coords, &a_data, &b_data);
+    CHECK(a_data == std::vector<int>({44}));
+    CHECK(b_data == std::vector<std::string>({"FOUR"}));
+  }
+
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Write coalescing, size and age thresholds",
+    "[cppapi], [write-coalescing]") {
+  std::vector<int> coords, a_data;
+  std::vector<std::string> b_data;
+
+  SECTION("- Size") {
+    // Each cell buffers 4 + 4 + 8 + 4 = 20 bytes
+    Config config;
+    config["sm.write_coalescing.max_bytes"] = "60";
+    config["sm.write_coalescing.max_age_ms"] = "0";
+    Context ctx(config);
+    create_array(ctx);
+    for (int i = 1; i <= 7; ++i)
+      write_cell(ctx, i, i, "abcd");
+    CHECK(fragment_num(ctx) == 2);
+    read_cells(ctx, &coords, &a_data, &b_data);
+    CHECK(fragment_num(ctx) == 3);
+    CHECK(a_data == std::vector<int>({1, 2, 3, 4, 5, 6, 7}));
+  }
+
+  SECTION("- Age") {
+    Config config;
+    config["sm.write_coalescing.max_bytes"] = "1048576";
+    config["sm.write_coalescing.max_age_ms"] = "1000";
+    Context ctx(config);
+    create_array(ctx);
+    write_cell(ctx, 1, 1, "a");
+    write_cell(ctx, 2, 2, "b");
+    for (int i = 0; i < 1000 && fragment_num(ctx) == 0; ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(fragment_num(ctx) == 1);
+    read_cells(ctx, &coords, &a_data, &b_data);
+    CHECK(fragment_num(ctx) == 1);
+    CHECK(coords == std::vector<int>({1, 2}));
+    CHECK(a_data == std::vector<int>({1, 2}));
+    CHECK(b_data == std::vector<std::string>({"a", "b"}));
+  }
+
+  SECTION("- Flushed when the context is freed") {
+    {
+      Config config;
+      config["sm.write_coalescing.max_bytes"] = "1048576";
+      config["sm.write_coalescing.max_age_ms"] = "0";
+      Context ctx(config);
+      create_array(ctx);
+      write_cell(ctx, 8, 80, "eight");
+      CHECK(fragment_num(ctx) == 0);
+    }
+    Context ctx;
+    CHECK(fragment_num(ctx) == 1);
+    read_cells(ctx, &coords, &a_data, &b_data);
+    CHECK(a_data == std::vector<int>({80}));
+    CHECK(b_data == std::vector<std::string>({"eight"}));
+  }
+
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Write coalescing, failed flushes",
+    "[cppapi], [write-coalescing]") {
+  const std::string moved_name = array_name + "_moved";
+  std::vector<int> coords, a_data;
+  std::vector<std::string> b_data;
+
+  SECTION("- Explicit flush") {
+    Config config;
+    config["sm.write_coalescing.max_bytes"] = "1048576";
+    config["sm.write_coalescing.max_age_ms"] = "0";
+    Context ctx(config);
+    VFS vfs(ctx);
+    create_array(ctx);
+    write_cell(ctx, 1, 10, "one");
+    write_cell(ctx, 2, 20, "two");
+
+    // The flush fails while the array is missing
+    vfs.move_dir(array_name, moved_name);
+    CHECK_THROWS(ctx.flush_writes());
+    vfs.move_dir(moved_name, array_name);
+
+    // The writes are kept, ahead of the newer ones
+    write_cell(ctx, 1, 11, "ONE");
+    write_cell(ctx, 3, 30, "three");
+    ctx.flush_writes();
+    CHECK(fragment_num(ctx) == 1);
+    read_cells(ctx, &coords, &a_data, &b_data);
+    CHECK(coords == std::vector<int>({1, 2, 3}));
+    CHECK(a_data == std::vector<int>({11, 20, 30}));
+    CHECK(b_data == std::vector<std::string>({"ONE", "two", "three"}));
+  }
+
+  SECTION("- Background flush") {
+    Config config;
+    config["sm.write_coalescing.max_bytes"] = "1048576";
+    config["sm.write_coalescing.max_age_ms"] = "50";
+    Context ctx(config);
+    VFS vfs(ctx);
+    create_array(ctx);
+
+    // Keep the array open, so that writes are buffered while it is missing
+    std::vector<int> cell_coords = {1};
+    std::vector<int> cell_a = {1};
+    std::vector<uint64_t> cell_b_offsets = {0};
+    std::string cell_b = "a";
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_buffer("a", cell_a)
+        .set_buffer("b", cell_b_offsets, cell_b)
+        .set_coordinates(cell_coords);
+    query.submit();
+    vfs.move_dir(array_name, moved_name);
+
+    // The error of the background flush is reported by a later write, which
+    // is not buffered
+    bool failed = false;
+    for (int i = 0; i < 1000 && !failed; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      Query retry(ctx, array);
+      retry.set_layout(TILEDB_UNORDERED)
+          .set_buffer("a", cell_a)
+          .set_buffer("b", cell_b_offsets, cell_b)
+          .set_coordinates(cell_coords);
+      try {
+        retry.submit();
+      } catch (const TileDBError&) {
+        failed = true;
+      }
+    }
+    CHECK(failed);
+    array.close();
+
+    // The writes are kept
+    vfs.move_dir(moved_name, array_name);
+    ctx.flush_writes();
+    CHECK(fragment_num(ctx) == 1);
+    read_cells(ctx, &coords, &a_data, &b_data);
+    CHECK(coords == std::vector<int>({1}));
+    CHECK(a_data == std::vector<int>({1}));
+    CHECK(b_data == std::vector<std::string>({"a"}));
+  }
+
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(moved_name))
+    vfs.remove_dir(moved_name);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
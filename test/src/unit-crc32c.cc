@@ -0,0 +1,87 @@
+/**
+ * @file   unit-crc32c.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the CRC32C checksum.
+ */
+
+#include "tiledb/sm/misc/crc32c.h"
+#include "tiledb/sm/misc/simd.h"
+
+#include <catch.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tiledb::sm;
+
+TEST_CASE("CRC32C: Test known values", "[crc32c]") {
+  for (auto isa : {simd::Isa::GENERIC, simd::Isa::SSE2}) {
+    if (simd::select(isa) != isa)
+      continue;
+
+    std::string digits = "123456789";
+    CHECK(crc32c::value(digits.data(), digits.size()) == 0xe3069283);
+    CHECK(crc32c::value(digits.data(), 0) == 0);
+
+    // RFC 3720, B.4: 32 bytes of zeros and of ones
+    std::vector<uint8_t> zeros(32, 0), ones(32, 0xff);
+    CHECK(crc32c::value(zeros.data(), zeros.size()) == 0x8a9136aa);
+    CHECK(crc32c::value(ones.data(), ones.size()) == 0x62a8ab43);
+  }
+
+  simd::select();
+}
+
+TEST_CASE("CRC32C: Test implementations agree", "[crc32c]") {
+  std::mt19937 gen(0);
+  std::vector<uint8_t> data(40000);
+  for (auto& b : data)
+    b = (uint8_t)gen();
+
+  // All alignments and sizes around the stream block boundaries
+  for (uint64_t offset = 0; offset < 9; ++offset) {
+    for (uint64_t size :
+         {0, 1, 7, 8, 31, 32, 33, 100, 767, 768, 777, 9000, 24576, 30000}) {
+      auto portable = crc32c::extend_portable(0, &data[offset], size);
+      CHECK(crc32c::value(&data[offset], size) == portable);
+      uint32_t sse42;
+      if (simd::detect_sse42() &&
+          crc32c::sse42::extend(0, &data[offset], size, &sse42))
+        CHECK(sse42 == portable);
+    }
+  }
+
+  // Extending a checksum is the same as checksumming the concatenation
+  auto whole = crc32c::value(data.data(), data.size());
+  auto first = crc32c::value(data.data(), 1234);
+  CHECK(crc32c::extend(first, &data[1234], data.size() - 1234) == whole);
+  CHECK(
+      crc32c::extend_portable(first, &data[1234], data.size() - 1234) ==
+      whole);
+}
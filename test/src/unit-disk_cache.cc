@@ -0,0 +1,289 @@
+/**
+ * @file unit-disk_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests class DiskCache.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cache/disk_cache.h"
+#include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/misc/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace tiledb::sm;
+
+struct DiskCacheFx {
+  const std::string dir_ = "disk_cache_unit_test";
+  VFS vfs_;
+
+  /** Size of the cached ranges. */
+  const uint64_t range_size_ = 1000;
+
+  DiskCacheFx() {
+    REQUIRE(vfs_.init(Config::VFSParams()).ok());
+    remove_dir();
+  }
+
+  ~DiskCacheFx() {
+    remove_dir();
+  }
+
+  void remove_dir() {
+    bool is_dir = false;
+    REQUIRE(vfs_.is_dir(URI(dir_), &is_dir).ok());
+    if (is_dir)
+      REQUIRE(vfs_.remove_dir(URI(dir_)).ok());
+  }
+
+  /** The URI of a file of a fragment. */
+  URI fragment_file(int i) const {
+    return URI(
+        "s3://bucket/array/__0123_" + std::to_string(i) + "/a" +
+        std::to_string(i) + ".tdb");
+  }
+
+  /** The data of range `i`, a different byte value per range. */
+  std::vector<char> range_data(int i) const {
+    return std::vector<char>(range_size_, (char)('a' + i));
+  }
+
+  /** Returns `true` if range `i` of `fragment_file(i)` hits in `cache`. */
+  bool hit(DiskCache* cache, int i) const {
+    std::vector<char> data(range_size_);
+    bool hit = false;
+    REQUIRE(cache->read(fragment_file(i), i, data.data(), range_size_, &hit)
+                .ok());
+    if (hit)
+      REQUIRE(data == range_data(i));
+    return hit;
+  }
+
+  void write(DiskCache* cache, int i) const {
+    auto data = range_data(i);
+    REQUIRE(cache->write(fragment_file(i), i, data.data(), range_size_).ok());
+  }
+};
+
+TEST_CASE("DiskCache: Test cacheable URIs", "[disk-cache]") {
+  CHECK(DiskCache::cacheable(URI("s3://bucket/array/__1_2_abc_3/a.tdb")));
+  CHECK(DiskCache::cacheable(URI("hdfs://host/array/__1_2_abc_3/a_var.tdb")));
+  CHECK(!DiskCache::cacheable(
+      URI("s3://bucket/array/__1_2_abc_3/__fragment_metadata.tdb")));
+  CHECK(!DiskCache::cacheable(
+      URI("hdfs://host/array/__1_2_abc_3/__fragment_metadata.tdb")));
+  CHECK(!DiskCache::cacheable(URI("s3://bucket/array/__array_schema.tdb")));
+  CHECK(!DiskCache::cacheable(URI("s3://bucket/array/__1_2_abc_3.ok")));
+  CHECK(!DiskCache::cacheable(URI("file:///array/__1_2_abc_3/a.tdb")));
+}
+
+TEST_CASE_METHOD(
+    DiskCacheFx, "DiskCache: Test read and write", "[disk-cache]") {
+  Config::DiskCacheParams params;
+  params.path_ = dir_;
+  DiskCache cache;
+  REQUIRE(cache.init(&vfs_, params).ok());
+  CHECK(cache.size() == 0);
+
+  stats::all_stats.set_enabled(true);
+  stats::all_stats.reset();
+
+  CHECK(!hit(&cache, 0));
+  write(&cache, 0);
+  CHECK(hit(&cache, 0));
+  CHECK(cache.size() > range_size_);
+
+  // Only the exact range of the same file hits.
+  std::vector<char> data(range_size_);
+  bool hit = true;
+  REQUIRE(cache.read(fragment_file(0), 1, data.data(), range_size_, &hit).ok());
+  CHECK(!hit);
+  REQUIRE(cache.read(fragment_file(0), 0, data.data(), 10, &hit).ok());
+  CHECK(!hit);
+  REQUIRE(cache.read(fragment_file(1), 0, data.data(), range_size_, &hit).ok());
+  CHECK(!hit);
+
+  CHECK(stats::all_stats.counter_vfs_disk_cache_hits == 1);
+  CHECK(stats::all_stats.counter_vfs_disk_cache_misses == 4);
+  CHECK(stats::all_stats.counter_vfs_disk_cache_hit_bytes == range_size_);
+  CHECK(stats::all_stats.counter_vfs_disk_cache_inserted_bytes == range_size_);
+  stats::all_stats.set_enabled(false);
+
+  // The cache persists across instances (e.g. processes).
+  DiskCache cache2;
+  REQUIRE(cache2.init(&vfs_, params).ok());
+  CHECK(cache2.size() == cache.size());
+  CHECK(this->hit(&cache2, 0));
+}
+
+TEST_CASE_METHOD(
+    DiskCacheFx, "DiskCache: Test asynchronous writes", "[disk-cache]") {
+  Config::DiskCacheParams params;
+  params.path_ = dir_;
+  DiskCache cache;
+  REQUIRE(cache.init(&vfs_, params).ok());
+  ThreadPool tp;
+  REQUIRE(tp.init(2).ok());
+
+  // The data is copied, so the caller may reuse its buffer right away.
+  for (int i = 0; i < 4; i++) {
+    auto data = range_data(i);
+    cache.write_async(&tp, fragment_file(i), i, data.data(), range_size_);
+    std::fill(data.begin(), data.end(), 0);
+  }
+  cache.wait_writes();
+  for (int i = 0; i < 4; i++)
+    CHECK(hit(&cache, i));
+
+  // Without threads, the range is written synchronously.
+  ThreadPool empty_tp;
+  REQUIRE(empty_tp.init(0).ok());
+  auto data = range_data(4);
+  cache.write_async(&empty_tp, fragment_file(4), 4, data.data(), range_size_);
+  CHECK(hit(&cache, 4));
+}
+
+TEST_CASE_METHOD(
+    DiskCacheFx, "DiskCache: Test LRU eviction", "[disk-cache]") {
+  Config::DiskCacheParams params;
+  params.path_ = dir_;
+  params.max_size_ = 1000000;
+  DiskCache cache;
+  REQUIRE(cache.init(&vfs_, params).ok());
+
+  // Measure the size of a cached range (data and header).
+  write(&cache, 0);
+  uint64_t entry_size = cache.size();
+  REQUIRE(entry_size > range_size_);
+
+  // Room for a bit less than 4 ranges.
+  params.max_size_ = 4 * entry_size - 1;
+  REQUIRE(cache.init(&vfs_, params).ok());
+  CHECK(cache.size() == entry_size);
+
+  // Ranges larger than the cache are not cached.
+  std::vector<char> large(params.max_size_);
+  REQUIRE(cache.write(fragment_file(9), 0, large.data(), large.size()).ok());
+  CHECK(cache.size() == entry_size);
+
+  // Fill the cache, then use range 0 again so that range 1 is the least
+  // recently used.
+  for (int i = 1; i < 3; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    write(&cache, i);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  CHECK(hit(&cache, 0));
+  CHECK(cache.size() == 3 * entry_size);
+
+  // Exceeding the maximum size evicts range 1.
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  stats::all_stats.set_enabled(true);
+  stats::all_stats.reset();
+  write(&cache, 3);
+  CHECK(cache.size() == 3 * entry_size);
+  CHECK(stats::all_stats.counter_vfs_disk_cache_evicted_bytes == entry_size);
+  stats::all_stats.set_enabled(false);
+  CHECK(hit(&cache, 0));
+  CHECK(!hit(&cache, 1));
+  CHECK(hit(&cache, 2));
+  CHECK(hit(&cache, 3));
+
+  // Shrinking the cache evicts upon initialization.
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  CHECK(hit(&cache, 3));
+  params.max_size_ = 2 * entry_size;
+  DiskCache cache2;
+  REQUIRE(cache2.init(&vfs_, params).ok());
+  CHECK(cache2.size() == entry_size);
+  CHECK(hit(&cache2, 3));
+}
+
+TEST_CASE_METHOD(
+    DiskCacheFx,
+    "DiskCache: Test concurrent writes and evictions",
+    "[disk-cache]") {
+  Config::DiskCacheParams params;
+  params.path_ = dir_;
+  DiskCache cache;
+  REQUIRE(cache.init(&vfs_, params).ok());
+  write(&cache, 0);
+  uint64_t entry_size = cache.size();
+
+  // Room for a few ranges only, so that the writes of the threads keep
+  // evicting each other's ranges.
+  params.max_size_ = 8 * entry_size;
+  REQUIRE(cache.init(&vfs_, params).ok());
+  const int num_threads = 4, num_ranges = 50;
+  std::vector<std::thread> threads;
+  std::vector<int> failures(num_threads, 0);
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = t * num_ranges; i < (t + 1) * num_ranges; i++) {
+        auto data = range_data(i);
+        if (!cache.write(fragment_file(i), i, data.data(), range_size_).ok())
+          failures[t]++;
+        if (i % 10 == 0 && !cache.evict().ok())
+          failures[t]++;
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  for (int t = 0; t < num_threads; t++)
+    CHECK(failures[t] == 0);
+
+  // The cache holds complete ranges only, within its maximum size.
+  REQUIRE(cache.evict().ok());
+  CHECK(cache.size() <= params.max_size_);
+  int num_hits = 0;
+  for (int i = 0; i < num_threads * num_ranges; i++)
+    num_hits += hit(&cache, i) ? 1 : 0;
+  CHECK(num_hits > 0);
+  CHECK(num_hits <= 8);
+}
+
+TEST_CASE_METHOD(
+    DiskCacheFx, "DiskCache: Test VFS initialization", "[disk-cache]") {
+  Config::VFSParams params;
+  params.disk_cache_params_.path_ = dir_;
+  VFS vfs;
+  REQUIRE(vfs.init(params).ok());
+  bool is_dir = false;
+  REQUIRE(vfs.is_dir(URI(dir_), &is_dir).ok());
+  CHECK(is_dir);
+
+  // The cache directory must be local.
+  params.disk_cache_params_.path_ = "s3://bucket/cache";
+  CHECK(!vfs.init(params).ok());
+}
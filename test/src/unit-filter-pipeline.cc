@@ -33,9 +33,11 @@
 
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/filter/auto_filter.h"
 #include "tiledb/sm/filter/bit_width_reduction_filter.h"
 #include "tiledb/sm/filter/bitshuffle_filter.h"
 #include "tiledb/sm/filter/byteshuffle_filter.h"
+#include "tiledb/sm/filter/checksum_crc32c_filter.h"
 #include "tiledb/sm/filter/compression_filter.h"
 #include "tiledb/sm/filter/encryption_aes256gcm_filter.h"
 #include "tiledb/sm/filter/filter_pipeline.h"
@@ -1462,4 +1464,215 @@ TEST_CASE("Filter: Test encryption", "[filter], [encryption]") {
     for (uint64_t i = 0; i < nelts; i++)
       CHECK(tile.buffer()->value<uint64_t>(i * sizeof(uint64_t)) == i);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Filter: Test auto codec", "[filter], [auto-filter]") {
+  // 20000 values in three chunks of (at most) 8192 values: constant, random
+  // and increasing values
+  const uint64_t nelts = 20000;
+  std::mt19937_64 gen(0);
+  Buffer buff;
+  std::vector<uint64_t> values(nelts);
+  for (uint64_t i = 0; i < nelts; i++) {
+    values[i] = i < 8192 ? 7 : (i < 16384 ? gen() : i);
+    CHECK(buff.write(&values[i], sizeof(uint64_t)).ok());
+  }
+
+  Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+
+  // Returns the codec recorded in the metadata of each chunk
+  auto chunk_codecs = [](Buffer* filtered) {
+    std::vector<FilterType> codecs;
+    filtered->reset_offset();
+    auto num_chunks = filtered->value<uint64_t>();
+    filtered->advance_offset(sizeof(uint64_t));
+    for (uint64_t i = 0; i < num_chunks; i++) {
+      filtered->advance_offset(sizeof(uint32_t));  // Chunk orig size
+      auto filtered_size = filtered->value<uint32_t>();
+      filtered->advance_offset(sizeof(uint32_t));
+      auto metadata_size = filtered->value<uint32_t>();
+      filtered->advance_offset(sizeof(uint32_t));
+      codecs.push_back(static_cast<FilterType>(filtered->value<uint8_t>()));
+      filtered->advance_offset(metadata_size + filtered_size);
+    }
+    return codecs;
+  };
+
+  auto check_values = [&](Buffer* unfiltered) {
+    REQUIRE(unfiltered->size() == nelts * sizeof(uint64_t));
+    for (uint64_t i = 0; i < nelts; i++)
+      CHECK(unfiltered->value<uint64_t>(i * sizeof(uint64_t)) == values[i]);
+  };
+
+  FilterPipeline pipeline;
+  CHECK(pipeline.add_filter(AutoFilter()).ok());
+
+  SECTION("- Default objective") {
+    CHECK(pipeline.run_forward(&tile).ok());
+    auto codecs = chunk_codecs(tile.buffer());
+    REQUIRE(codecs.size() == 3);
+    CHECK(codecs[0] == FilterType::FILTER_RLE);
+    CHECK(codecs[1] == FilterType::FILTER_NONE);
+    CHECK(codecs[2] != FilterType::FILTER_NONE);
+    CHECK(tile.buffer()->size() < 9000 * sizeof(uint64_t));
+
+    CHECK(pipeline.run_reverse(&tile).ok());
+    check_values(tile.buffer());
+  }
+
+  SECTION("- All objectives") {
+    for (auto objective : {AutoObjective::AUTO_RATIO,
+                           AutoObjective::AUTO_BALANCED,
+                           AutoObjective::AUTO_DECODE_SPEED}) {
+      pipeline.get_filter<AutoFilter>()->set_objective(objective);
+      CHECK(pipeline.run_forward(&tile).ok());
+      auto codecs = chunk_codecs(tile.buffer());
+      REQUIRE(codecs.size() == 3);
+      CHECK(codecs[0] != FilterType::FILTER_NONE);
+      CHECK(codecs[1] == FilterType::FILTER_NONE);
+
+      CHECK(pipeline.run_reverse(&tile).ok());
+      check_values(tile.buffer());
+    }
+  }
+
+  SECTION("- After another filter") {
+    FilterPipeline pipeline2;
+    CHECK(pipeline2.add_filter(BitshuffleFilter()).ok());
+    CHECK(pipeline2.add_filter(AutoFilter()).ok());
+    CHECK(pipeline2.run_forward(&tile).ok());
+    CHECK(pipeline2.run_reverse(&tile).ok());
+    check_values(tile.buffer());
+  }
+
+  SECTION("- Float values") {
+    const uint64_t nelts2 = 1000;
+    Buffer buff2;
+    for (uint64_t i = 0; i < nelts2; i++) {
+      float value = i < 500 ? 1.5f : (float)i;
+      CHECK(buff2.write(&value, sizeof(float)).ok());
+    }
+    Tile tile2(Datatype::FLOAT32, sizeof(float), 0, &buff2, false);
+
+    CHECK(pipeline.run_forward(&tile2).ok());
+    CHECK(pipeline.run_reverse(&tile2).ok());
+    REQUIRE(tile2.buffer()->size() == nelts2 * sizeof(float));
+    for (uint64_t i = 0; i < nelts2; i++) {
+      float value = i < 500 ? 1.5f : (float)i;
+      CHECK(tile2.buffer()->value<float>(i * sizeof(float)) == value);
+    }
+  }
+
+  SECTION("- Options and serialization") {
+    AutoFilter filter;
+    uint32_t objective = 3;
+    CHECK(!filter.set_option(FilterOption::AUTO_OBJECTIVE, &objective).ok());
+    objective = (uint32_t)AutoObjective::AUTO_DECODE_SPEED;
+    CHECK(filter.set_option(FilterOption::AUTO_OBJECTIVE, &objective).ok());
+    int level = 7;
+    CHECK(filter.set_option(FilterOption::COMPRESSION_LEVEL, &level).ok());
+    uint32_t window = 10;
+    CHECK(
+        !filter.set_option(FilterOption::BIT_WIDTH_MAX_WINDOW, &window).ok());
+
+    Buffer serialized;
+    CHECK(filter.serialize(&serialized).ok());
+    ConstBuffer cbuff(serialized.data(), serialized.size());
+    Filter* deserialized;
+    CHECK(Filter::deserialize(&cbuff, &deserialized).ok());
+    std::unique_ptr<Filter> deserialized_ptr(deserialized);
+    CHECK(deserialized->type() == FilterType::FILTER_AUTO);
+    uint32_t get_objective;
+    int get_level;
+    CHECK(deserialized->get_option(FilterOption::AUTO_OBJECTIVE, &get_objective)
+              .ok());
+    CHECK(get_objective == objective);
+    CHECK(deserialized->get_option(FilterOption::COMPRESSION_LEVEL, &get_level)
+              .ok());
+    CHECK(get_level == 7);
+
+    // An invalid serialized objective is rejected. It follows the filter
+    // type and the metadata length.
+    *(uint8_t*)serialized.data(sizeof(uint8_t) + sizeof(uint32_t)) = 3;
+    ConstBuffer cbuff2(serialized.data(), serialized.size());
+    Filter* invalid = nullptr;
+    CHECK(!Filter::deserialize(&cbuff2, &invalid).ok());
+    CHECK(invalid == nullptr);
+  }
+}
+
+TEST_CASE("Filter: Test CRC32C checksum", "[filter], [checksum]") {
+  const uint64_t nelts = 20000;
+  Buffer buff;
+  for (uint64_t i = 0; i < nelts; i++)
+    CHECK(buff.write(&i, sizeof(uint64_t)).ok());
+
+  Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+
+  auto check_values = [&](Buffer* unfiltered) {
+    REQUIRE(unfiltered->size() == nelts * sizeof(uint64_t));
+    for (uint64_t i = 0; i < nelts; i++)
+      CHECK(unfiltered->value<uint64_t>(i * sizeof(uint64_t)) == i);
+  };
+
+  // Flips a bit of the last byte of the filtered tile (in the last chunk)
+  auto corrupt = [](Buffer* filtered) {
+    auto data = (uint8_t*)filtered->data();
+    data[filtered->size() - 1] ^= 1;
+  };
+
+  FilterPipeline pipeline;
+
+  SECTION("- Checksum only") {
+    CHECK(pipeline.add_filter(ChecksumCRC32CFilter()).ok());
+    CHECK(pipeline.run_forward(&tile).ok());
+    // Each chunk has the two checksums as metadata
+    CHECK(
+        tile.buffer()->size() ==
+        nelts * sizeof(uint64_t) + sizeof(uint64_t) +
+            3 * (3 * sizeof(uint32_t) + 2 * sizeof(uint32_t)));
+    CHECK(pipeline.run_reverse(&tile).ok());
+    check_values(tile.buffer());
+  }
+
+  SECTION("- After compression") {
+    CHECK(pipeline.add_filter(CompressionFilter(Compressor::ZSTD, -1)).ok());
+    CHECK(pipeline.add_filter(ChecksumCRC32CFilter()).ok());
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(tile.buffer()->size() < nelts * sizeof(uint64_t));
+    CHECK(pipeline.run_reverse(&tile).ok());
+    check_values(tile.buffer());
+  }
+
+  SECTION("- Corrupted data") {
+    CHECK(pipeline.add_filter(ChecksumCRC32CFilter()).ok());
+    CHECK(pipeline.run_forward(&tile).ok());
+    corrupt(tile.buffer());
+    CHECK(!pipeline.run_reverse(&tile).ok());
+  }
+
+  SECTION("- Corrupted data, not verified") {
+    CHECK(pipeline.add_filter(ChecksumCRC32CFilter()).ok());
+    CHECK(pipeline.run_forward(&tile).ok());
+    corrupt(tile.buffer());
+    pipeline.set_verify_checksums(false);
+    FilterPipeline copy(pipeline);
+    CHECK(!copy.verify_checksums());
+    CHECK(copy.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == nelts * sizeof(uint64_t));
+    CHECK(
+        tile.buffer()->value<uint64_t>((nelts - 1) * sizeof(uint64_t)) ==
+        ((nelts - 1) ^ (1ull << 56)));
+  }
+
+  SECTION("- Corrupted metadata") {
+    CHECK(pipeline.add_filter(BitWidthReductionFilter()).ok());
+    CHECK(pipeline.add_filter(ChecksumCRC32CFilter()).ok());
+    CHECK(pipeline.run_forward(&tile).ok());
+    // Flip a bit of the first chunk's bit width reduction metadata, which
+    // follows the chunk sizes and the two checksums
+    auto data = (uint8_t*)tile.buffer()->data();
+    data[sizeof(uint64_t) + 5 * sizeof(uint32_t)] ^= 1;
+    CHECK(!pipeline.run_reverse(&tile).ok());
+  }
+}
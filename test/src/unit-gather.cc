@@ -0,0 +1,119 @@
+/**
+ * @file unit-gather.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the functions that gather scattered cells.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/misc/gather.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace tiledb::sm;
+
+TEST_CASE("Gather: Test fixed-sized cells", "[gather]") {
+  const uint64_t cell_num = 1000;
+  std::mt19937 gen(0);
+  std::vector<uint64_t> cell_pos(cell_num);
+  for (uint64_t i = 0; i < cell_num; i++)
+    cell_pos[i] = i;
+  std::shuffle(cell_pos.begin(), cell_pos.end(), gen);
+
+  for (uint64_t cell_size : {1, 2, 3, 4, 8, 16, 24}) {
+    std::vector<unsigned char> src(cell_num * cell_size);
+    for (auto& c : src)
+      c = (unsigned char)gen();
+
+    // Gather a prefix of the positions, so that the last block is partial
+    for (uint64_t num : {(uint64_t)0, (uint64_t)1, (uint64_t)63, cell_num}) {
+      std::vector<unsigned char> dst(num * cell_size + 1, 0xFF);
+      gather::gather_fixed(&src[0], cell_size, &cell_pos[0], num, &dst[0]);
+      for (uint64_t i = 0; i < num; i++)
+        CHECK(!std::memcmp(
+            &dst[i * cell_size], &src[cell_pos[i] * cell_size], cell_size));
+      CHECK(dst[num * cell_size] == 0xFF);
+    }
+  }
+}
+
+TEST_CASE("Gather: Test var-sized cells", "[gather]") {
+  const uint64_t cell_num = 1000;
+  std::mt19937 gen(0);
+
+  // Cells of random sizes, including empty ones
+  std::vector<uint64_t> offsets(cell_num);
+  std::string src_var;
+  for (uint64_t i = 0; i < cell_num; i++) {
+    offsets[i] = src_var.size();
+    src_var.append(gen() % 10, (char)('a' + i % 26));
+  }
+
+  std::vector<uint64_t> cell_pos(cell_num);
+  for (uint64_t i = 0; i < cell_num; i++)
+    cell_pos[i] = i;
+  std::shuffle(cell_pos.begin(), cell_pos.end(), gen);
+
+  // Gather every other position
+  std::vector<uint64_t> pos;
+  for (uint64_t i = 0; i < cell_num; i += 2)
+    pos.push_back(cell_pos[i]);
+  if (std::find(pos.begin(), pos.end(), cell_num - 1) == pos.end())
+    pos.push_back(cell_num - 1);
+
+  std::vector<uint64_t> dst_offsets(pos.size());
+  auto dst_var_size = gather::gather_var_offsets(
+      &offsets[0],
+      cell_num,
+      src_var.size(),
+      &pos[0],
+      pos.size(),
+      &dst_offsets[0]);
+  std::string dst_var(dst_var_size, ' ');
+  gather::gather_var(
+      &offsets[0],
+      src_var.data(),
+      &pos[0],
+      pos.size(),
+      &dst_offsets[0],
+      dst_var_size,
+      &dst_var[0]);
+
+  // Check against a plain copy
+  std::string expected;
+  for (uint64_t i = 0; i < pos.size(); i++) {
+    CHECK(dst_offsets[i] == expected.size());
+    auto end = (pos[i] == cell_num - 1) ? src_var.size() : offsets[pos[i] + 1];
+    expected.append(src_var, offsets[pos[i]], end - offsets[pos[i]]);
+  }
+  CHECK(dst_var_size == expected.size());
+  CHECK(dst_var == expected);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file   unit-range_select.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the kernels that select the values that fall in a range.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/misc/range_select.h"
+#include "tiledb/sm/misc/simd.h"
+
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace tiledb::sm;
+
+namespace {
+
+/**
+ * Checks `range_select::select` against a scalar check of every value, with
+ * both contiguous and strided values, and with and without intersecting
+ * with a previous selection.
+ */
+template <class T>
+void check_select(const std::vector<T>& values, T low, T high) {
+  for (uint64_t stride : {1, 3}) {
+    auto num = (uint64_t)values.size() / stride;
+    auto words = range_select::bitmap_words(num);
+
+    // Overwrite a bitmap full of garbage
+    std::vector<uint64_t> bitmap(words, ~(uint64_t)0);
+    range_select::select<T>(
+        values.data(), stride, num, low, high, false, bitmap.data());
+    std::vector<uint64_t> expected;
+    for (uint64_t i = 0; i < num; ++i) {
+      auto x = values[i * stride];
+      if (x >= low && x <= high)
+        expected.push_back(i);
+    }
+    std::vector<uint64_t> pos(num);
+    auto n = range_select::bitmap_to_positions(bitmap.data(), num, pos.data());
+    pos.resize(n);
+    CHECK(pos == expected);
+    CHECK(range_select::bitmap_empty(bitmap.data(), num) == expected.empty());
+
+    // Intersect with a selection of the even positions
+    for (auto& w : bitmap)
+      w = 0x5555555555555555ull;
+    if (num % 64 != 0)
+      bitmap[words - 1] &= ((uint64_t)1 << (num % 64)) - 1;
+    range_select::select<T>(
+        values.data(), stride, num, low, high, true, bitmap.data());
+    std::vector<uint64_t> expected_even;
+    for (auto p : expected) {
+      if (p % 2 == 0)
+        expected_even.push_back(p);
+    }
+    pos.resize(num);
+    n = range_select::bitmap_to_positions(bitmap.data(), num, pos.data());
+    pos.resize(n);
+    CHECK(pos == expected_even);
+  }
+}
+
+/** Runs `check_select` on random values of all the tested lengths. */
+template <class T>
+void check_select_random(T min, T max, T low, T high) {
+  std::mt19937_64 gen(0);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  for (uint64_t num : {0, 1, 7, 63, 64, 65, 200, 1000}) {
+    std::vector<T> values(num * 3);
+    for (auto& v : values)
+      v = (T)(min + (max - min) * dist(gen));
+    // Make sure the bounds themselves are included
+    if (!values.empty()) {
+      values[0] = low;
+      values[values.size() - 1] = high;
+    }
+    check_select<T>(values, low, high);
+  }
+}
+
+/** Runs the checks of all the value types. */
+void check_all_types() {
+  check_select_random<int8_t>(-100, 100, -10, 50);
+  check_select_random<uint8_t>(0, 250, 10, 50);
+  check_select_random<int16_t>(-1000, 1000, -100, 500);
+  check_select_random<uint16_t>(0, 1000, 100, 500);
+  check_select_random<int32_t>(-1000000, 1000000, -5000, 250000);
+  check_select_random<uint32_t>(0, 4000000000u, 100, 3000000000u);
+  check_select_random<int64_t>(
+      -10000000000ll, 10000000000ll, -5000000000ll, 20);
+  check_select_random<uint64_t>(
+      0,
+      std::numeric_limits<uint64_t>::max() / 2 * 2,
+      100,
+      std::numeric_limits<uint64_t>::max() / 4 * 3);
+  check_select_random<float>(-1.0f, 1.0f, -0.25f, 0.5f);
+  check_select_random<double>(-1.0, 1.0, -0.25, 0.5);
+
+  // NaN never falls in a range
+  std::vector<double> nan(100, std::numeric_limits<double>::quiet_NaN());
+  nan[50] = 0.0;
+  check_select<double>(nan, -1.0, 1.0);
+}
+
+}  // namespace
+
+TEST_CASE("Range select: Test bitmap to positions", "[range-select]") {
+  std::vector<uint64_t> bitmap = {0, (uint64_t)1 << 63 | 5, 0};
+  CHECK(!range_select::bitmap_empty(bitmap.data(), 150));
+  CHECK(range_select::bitmap_empty(bitmap.data(), 64));
+
+  std::vector<uint64_t> pos(150);
+  CHECK(range_select::bitmap_to_positions(bitmap.data(), 150, pos.data()) == 3);
+  CHECK(pos[0] == 64);
+  CHECK(pos[1] == 66);
+  CHECK(pos[2] == 127);
+}
+
+TEST_CASE(
+    "Range select: Test kernels agree across instruction sets",
+    "[range-select]") {
+  for (auto isa : {simd::Isa::GENERIC, simd::Isa::AVX2}) {
+    if (simd::select(isa) != isa)
+      continue;
+    check_all_types();
+  }
+
+  simd::select();
+}
@@ -0,0 +1,133 @@
+/**
+ * @file unit-simd.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the runtime selection of the SIMD kernels.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/filter/bitshuffle_filter.h"
+#include "tiledb/sm/filter/byteshuffle_filter.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/misc/simd.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace tiledb::sm;
+
+namespace {
+
+/**
+ * Runs the given filter forward on random data of the given type, checks that
+ * the reverse restores the data and returns the filtered bytes.
+ */
+std::vector<char> run_filter(
+    const Filter& filter, Datatype type, uint64_t cell_size, uint64_t nelts) {
+  std::mt19937 gen(0);
+  std::vector<char> data(nelts * cell_size);
+  for (auto& c : data)
+    c = (char)gen();
+
+  Buffer buff;
+  CHECK(buff.write(&data[0], data.size()).ok());
+  Tile tile(type, cell_size, 0, &buff, false);
+
+  FilterPipeline pipeline;
+  CHECK(pipeline.add_filter(filter).ok());
+  CHECK(pipeline.run_forward(&tile).ok());
+  auto filtered = tile.buffer();
+  std::vector<char> result(
+      (char*)filtered->data(), (char*)filtered->data() + filtered->size());
+
+  CHECK(pipeline.run_reverse(&tile).ok());
+  REQUIRE(tile.buffer()->size() == data.size());
+  CHECK(!std::memcmp(tile.buffer()->data(), &data[0], data.size()));
+
+  return result;
+}
+
+}  // namespace
+
+TEST_CASE("SIMD: Test instruction set selection", "[simd]") {
+  auto best = simd::select();
+  CHECK(best == simd::isa());
+  CHECK(best <= simd::detect());
+  CHECK(best <= simd::compiled());
+  CHECK(stats::all_stats.counter_simd_isa == (uint64_t)best);
+
+  // The counter is a setting, so it survives a reset
+  stats::all_stats.reset();
+  CHECK(stats::all_stats.counter_simd_isa == (uint64_t)best);
+
+  CHECK(simd::select(simd::Isa::GENERIC) == simd::Isa::GENERIC);
+  CHECK(simd::isa() == simd::Isa::GENERIC);
+  CHECK(stats::all_stats.counter_simd_isa == 0);
+  CHECK(std::string(simd::isa_str(simd::Isa::GENERIC)) == "generic");
+
+  simd::select();
+  CHECK(simd::isa() == best);
+}
+
+TEST_CASE(
+    "SIMD: Test shuffle kernels agree across instruction sets", "[simd]") {
+  const std::vector<std::pair<Datatype, uint64_t>> types = {
+      {Datatype::INT8, 1},
+      {Datatype::INT16, 2},
+      {Datatype::INT32, 4},
+      {Datatype::INT64, 8},
+      {Datatype::FLOAT64, 8}};
+
+  for (const auto& type : types) {
+    // Cover full vectors, partial vectors and the remainder of 8 elements
+    for (uint64_t nelts : {1000, 1001, 4099}) {
+      simd::select(simd::Isa::GENERIC);
+      auto bit_ref =
+          run_filter(BitshuffleFilter(), type.first, type.second, nelts);
+      auto byte_ref =
+          run_filter(ByteshuffleFilter(), type.first, type.second, nelts);
+
+      for (auto isa : {simd::Isa::SSE2, simd::Isa::AVX2}) {
+        if (simd::select(isa) != isa)
+          continue;
+        CHECK(
+            run_filter(BitshuffleFilter(), type.first, type.second, nelts) ==
+            bit_ref);
+        CHECK(
+            run_filter(ByteshuffleFilter(), type.first, type.second, nelts) ==
+            byte_ref);
+      }
+    }
+  }
+
+  simd::select();
+}
@@ -30,8 +30,13 @@
  * Tests the `ThreadPool` class.
  */
 
+#include <algorithm>
 #include <atomic>
 #include <catch.hpp>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/thread_pool.h"
 
 using namespace tiledb::sm;
@@ -182,6 +187,229 @@ TEST_CASE("ThreadPool: Test enqueue with empty pool", "[threadpool]") {
   CHECK(result == 0);
 }
 
+TEST_CASE("ThreadPool: Test nested wait", "[threadpool]") {
+  // Tasks that enqueue into and wait on their own pool must not deadlock,
+  // even when the pool has a single thread.
+  ThreadPool pool;
+  REQUIRE(pool.init(1).ok());
+  std::atomic<int> result(0);
+  std::vector<std::future<Status>> results;
+  for (int i = 0; i < 10; i++) {
+    results.push_back(pool.enqueue([&pool, &result]() {
+      std::vector<std::future<Status>> inner;
+      for (int j = 0; j < 10; j++) {
+        inner.push_back(pool.enqueue([&result]() {
+          result++;
+          return Status::Ok();
+        }));
+      }
+      return pool.wait_all(inner);
+    }));
+  }
+  CHECK(pool.wait_all(results).ok());
+  CHECK(result == 100);
+}
+
+TEST_CASE("ThreadPool: Test task priorities", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(1).ok());
+  std::atomic<bool> blocked(true);
+  std::atomic<int> num_done(0);
+  std::mutex mtx;
+  std::vector<ThreadPool::Priority> order;
+  std::vector<std::future<Status>> results;
+
+  // Occupy the single worker until all tasks have been enqueued.
+  results.push_back(pool.enqueue([&blocked]() {
+    while (blocked)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return Status::Ok();
+  }));
+
+  const int num_tasks = 20;
+  for (int i = 0; i < num_tasks; i++) {
+    auto priority =
+        i % 2 == 0 ? ThreadPool::Priority::NORMAL : ThreadPool::Priority::HIGH;
+    results.push_back(pool.enqueue(
+        [&, priority]() {
+          std::lock_guard<std::mutex> lock(mtx);
+          order.push_back(priority);
+          num_done++;
+          return Status::Ok();
+        },
+        priority));
+  }
+
+  // Let only the worker thread run the tasks, so that the execution order is
+  // the order in which they were dequeued.
+  blocked = false;
+  while (num_done < num_tasks)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  CHECK(pool.wait_all(results).ok());
+
+  REQUIRE(order.size() == (size_t)num_tasks);
+  for (int i = 0; i < num_tasks; i++) {
+    auto expected = i < num_tasks / 2 ? ThreadPool::Priority::HIGH :
+                                        ThreadPool::Priority::NORMAL;
+    CHECK(order[i] == expected);
+  }
+}
+
+TEST_CASE("ThreadPool: Test parallel_for", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(4).ok());
+  const uint64_t num_iters = 10000;
+  std::vector<std::atomic<int>> visited(num_iters);
+  for (auto& v : visited)
+    v = 0;
+
+  auto statuses = parallel_for(&pool, 0, num_iters, [&](uint64_t i) {
+    visited[i]++;
+    return i == 1234 ? Status::Error("Generic error") : Status::Ok();
+  });
+
+  REQUIRE(statuses.size() == num_iters + 1);
+  for (uint64_t i = 0; i < num_iters; i++) {
+    CHECK(visited[i] == 1);
+    CHECK(statuses[i].ok() == (i != 1234));
+  }
+}
+
+TEST_CASE("ThreadPool: Test parallel_for cancellation", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(1).ok());
+
+  // Occupy the single worker, so that the blocks stay queued
+  std::atomic<bool> started(false);
+  std::atomic<bool> blocked(true);
+  auto blocker = pool.enqueue([&started, &blocked]() {
+    started = true;
+    while (blocked)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return Status::Ok();
+  });
+  while (!started)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  // Cancel the queued blocks while the calling thread runs its own block,
+  // since it would run them too once it waits
+  const uint64_t num_iters = 100;
+  std::atomic<bool> first_started(false);
+  std::atomic<bool> cancelled(false);
+  std::vector<Status> statuses;
+  std::thread caller([&]() {
+    statuses = parallel_for(&pool, 0, num_iters, [&](uint64_t i) {
+      if (i == 0) {
+        first_started = true;
+        while (!cancelled)
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      return Status::Ok();
+    });
+  });
+  while (!first_started)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  pool.cancel_all_tasks();
+  cancelled = true;
+  caller.join();
+  blocked = false;
+  CHECK(blocker.get().ok());
+
+  // Only the indices of the block of the calling thread succeeded
+  REQUIRE(statuses.size() == num_iters + 1);
+  CHECK(statuses[0].ok());
+  CHECK(!statuses[num_iters - 1].ok());
+}
+
+TEST_CASE("ThreadPool: Test wait runs pending tasks", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(1).ok());
+
+  // Occupy the single worker until the waiting thread is done
+  std::atomic<bool> started(false);
+  std::atomic<bool> blocked(true);
+  auto blocker = pool.enqueue([&started, &blocked]() {
+    started = true;
+    while (blocked)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return Status::Ok();
+  });
+  while (!started)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  // The waiting thread runs the awaited tasks, including nested ones
+  std::atomic<int> result(0);
+  std::vector<std::future<Status>> results;
+  for (int i = 0; i < 10; i++) {
+    results.push_back(pool.enqueue([&pool, &result]() {
+      std::vector<std::future<Status>> inner;
+      for (int j = 0; j < 10; j++) {
+        inner.push_back(pool.enqueue([&result]() {
+          result++;
+          return Status::Ok();
+        }));
+      }
+      return pool.wait_all(inner);
+    }));
+  }
+  CHECK(pool.wait_all(results).ok());
+  CHECK(result == 100);
+  blocked = false;
+  CHECK(blocker.get().ok());
+}
+
+TEST_CASE("ThreadPool: Test wait runs no background task", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(1).ok());
+
+  // Occupy the single worker for a while, and queue a background task
+  std::atomic<bool> blocked(true);
+  auto blocker = pool.enqueue([&blocked]() {
+    while (blocked)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return Status::Ok();
+  });
+  std::thread::id background_tid;
+  auto background = pool.enqueue(
+      [&background_tid]() {
+        background_tid = std::this_thread::get_id();
+        return Status::Ok();
+      },
+      ThreadPool::Priority::BACKGROUND);
+  std::thread unblocker([&blocked]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    blocked = false;
+  });
+
+  // The waiting thread does not run the background task
+  auto statuses = parallel_for(
+      &pool, 0, 10, [](uint64_t) { return Status::Ok(); });
+  for (const auto& st : statuses)
+    CHECK(st.ok());
+  CHECK(background.get().ok());
+  unblocker.join();
+  CHECK(blocker.get().ok());
+  CHECK(background_tid != std::this_thread::get_id());
+}
+
+TEST_CASE("ThreadPool: Test parallel_sort", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(4).ok());
+  std::mt19937 gen(1234);
+
+  for (uint64_t n : {0, 1, 100, 100000, 250007}) {
+    std::vector<uint64_t> values(n);
+    for (auto& v : values)
+      v = gen() % 1000;
+    std::vector<uint64_t> expected(values);
+    std::sort(expected.begin(), expected.end(), std::greater<uint64_t>());
+
+    parallel_sort(
+        &pool, values.begin(), values.end(), std::greater<uint64_t>());
+    CHECK(values == expected);
+  }
+}
+
 // TODO: This test is too aggressive, as it can/will exhaust memory, which
 // is a problem both on some CI machines as well as development machines.
 // TEST_CASE("ThreadPool: Too many threads", "[threadpool]") {
@@ -0,0 +1,74 @@
+/**
+ * @file   unit-time.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the time utility functions.
+ */
+
+#include <catch.hpp>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "tiledb/sm/misc/utils.h"
+
+using namespace tiledb::sm;
+
+TEST_CASE("Time: Test fragment timestamps", "[time]") {
+  SECTION("- Serial") {
+    // Increasing even when the clock has not advanced, and never ahead of
+    // the current time
+    uint64_t prev = utils::time::timestamp_next_ms();
+    for (int i = 0; i < 1000; i++) {
+      uint64_t next = utils::time::timestamp_next_ms();
+      REQUIRE(next > prev);
+      REQUIRE(utils::time::timestamp_now_ms() >= next);
+      prev = next;
+    }
+  }
+
+  SECTION("- Threaded") {
+    const unsigned nthreads = 20, num = 100;
+    std::vector<uint64_t> timestamps[nthreads];
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < nthreads; i++) {
+      threads.emplace_back([&timestamps, i]() {
+        for (unsigned j = 0; j < num; j++)
+          timestamps[i].push_back(utils::time::timestamp_next_ms());
+      });
+    }
+    for (auto& t : threads)
+      t.join();
+
+    // Distinct across threads
+    std::set<uint64_t> all;
+    for (unsigned i = 0; i < nthreads; i++)
+      all.insert(timestamps[i].begin(), timestamps[i].end());
+    REQUIRE(all.size() == nthreads * num);
+  }
+}
@@ -30,8 +30,10 @@
  * Tests the `VFS` class.
  */
 
+#include <algorithm>
 #include <atomic>
 #include <catch.hpp>
+#include <vector>
 #include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/sm/misc/stats.h"
 
@@ -214,3 +216,92 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
   if (exists)
     vfs->remove_file(testfile);
 }
+
+TEST_CASE("VFS: Test io_uring reads", "[vfs][io-uring]") {
+  URI testfile("vfs_unit_test_data");
+  std::unique_ptr<VFS> vfs(new VFS);
+
+  Config::VFSParams vfs_params;
+  vfs_params.file_params_.io_uring_ = true;
+  vfs_params.file_params_.io_uring_depth_ = 4;
+  vfs_params.file_params_.max_parallel_ops_ = 8;
+  vfs_params.min_parallel_size_ = 4096;
+  vfs_params.max_batch_read_amplification_ = 1;
+  REQUIRE(vfs->init(vfs_params).ok());
+#ifdef _WIN32
+  REQUIRE(!vfs->io_uring_enabled());
+#endif
+  bool enabled = vfs->io_uring_enabled();
+
+  bool exists = false;
+  REQUIRE(vfs->is_file(testfile, &exists).ok());
+  if (exists)
+    vfs->remove_file(testfile);
+
+  // Write enough data for regions not to fit in a registered buffer.
+  const unsigned nelts = 100000;
+  std::vector<uint32_t> data_write(nelts), data_read(nelts);
+  for (unsigned i = 0; i < nelts; i++)
+    data_write[i] = i;
+  REQUIRE(
+      vfs->write(testfile, data_write.data(), nelts * sizeof(uint32_t)).ok());
+
+  stats::all_stats.set_enabled(true);
+  stats::all_stats.reset();
+
+  // A large read is split, and the parts submitted together.
+  REQUIRE(vfs->read(testfile, 0, data_read.data(), nelts * sizeof(uint32_t))
+              .ok());
+  REQUIRE(data_read == data_write);
+  if (enabled) {
+    REQUIRE(stats::all_stats.counter_vfs_posix_io_uring_num_reads == 8);
+    REQUIRE(stats::all_stats.counter_vfs_read_num_parallelized == 0);
+  }
+
+  // Every other element as a different region: one batch per region, many
+  // more than the ring depth.
+  stats::all_stats.reset();
+  std::fill(data_read.begin(), data_read.end(), 0);
+  std::vector<std::tuple<uint64_t, void*, uint64_t>> regions;
+  for (unsigned i = 0; i < nelts; i += 2)
+    regions.emplace_back(i * sizeof(uint32_t), &data_read[i], sizeof(uint32_t));
+  REQUIRE(vfs->read_all(testfile, regions).ok());
+  for (unsigned i = 0; i < nelts; i++)
+    REQUIRE(data_read[i] == (i % 2 == 0 ? i : 0));
+  REQUIRE(
+      stats::all_stats.counter_vfs_read_total_bytes ==
+      nelts / 2 * sizeof(uint32_t));
+  if (enabled) {
+    REQUIRE(stats::all_stats.counter_vfs_posix_io_uring_num_reads == nelts / 2);
+    REQUIRE(
+        stats::all_stats.counter_vfs_posix_io_uring_num_submissions <
+        nelts / 2);
+  }
+
+  // Batches larger than the registered buffers, mixed with small ones.
+  stats::all_stats.reset();
+  std::fill(data_read.begin(), data_read.end(), 0);
+  regions.clear();
+  regions.emplace_back(0, &data_read[0], sizeof(uint32_t));
+  regions.emplace_back(
+      2 * sizeof(uint32_t), &data_read[2], (nelts - 4) * sizeof(uint32_t));
+  regions.emplace_back(
+      (nelts - 1) * sizeof(uint32_t), &data_read[nelts - 1], sizeof(uint32_t));
+  REQUIRE(vfs->read_all(testfile, regions).ok());
+  for (unsigned i = 0; i < nelts; i++)
+    REQUIRE(data_read[i] == (i == 1 || i == nelts - 2 ? 0 : i));
+  if (enabled)
+    REQUIRE(stats::all_stats.counter_vfs_posix_io_uring_num_reads == 3);
+
+  // Reads past the end of the file fail.
+  regions.clear();
+  regions.emplace_back(
+      nelts * sizeof(uint32_t), &data_read[0], sizeof(uint32_t));
+  REQUIRE(!vfs->read_all(testfile, regions).ok());
+
+  stats::all_stats.set_enabled(false);
+
+  REQUIRE(vfs->is_file(testfile, &exists).ok());
+  if (exists)
+    vfs->remove_file(testfile);
+}
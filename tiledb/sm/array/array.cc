@@ -36,6 +36,7 @@
 
 #include <cassert>
 #include <iostream>
+#include <unordered_set>
 
 /* ****************************** */
 /*             MACROS             */
@@ -126,6 +127,9 @@ Status Array::open(
       encryption_key_.set_key(encryption_type, encryption_key, key_length));
 
   if (query_type == QueryType::READ) {
+    // Flush the writes buffered in this context before taking the timestamp,
+    // as their fragment would otherwise be newer than the opened array
+    RETURN_NOT_OK(storage_manager_->flush_writes(array_uri_));
     timestamp_ = utils::time::timestamp_now_ms();
     RETURN_NOT_OK(storage_manager_->array_open_for_reads(
         array_uri_,
@@ -228,10 +232,13 @@ Status Array::close() {
   is_open_ = false;
   clear_last_max_buffer_sizes();
   array_schema_ = nullptr;
+  auto fragment_metadata = std::move(fragment_metadata_);
   fragment_metadata_.clear();
+  new_fragment_metadata_.clear();
 
   if (query_type_ == QueryType::READ) {
-    RETURN_NOT_OK(storage_manager_->array_close_for_reads(array_uri_));
+    RETURN_NOT_OK(storage_manager_->array_close_for_reads(
+        array_uri_, fragment_metadata));
   } else {
     RETURN_NOT_OK(storage_manager_->array_close_for_writes(array_uri_));
   }
@@ -254,6 +261,11 @@ std::vector<FragmentMetadata*> Array::fragment_metadata() const {
   return fragment_metadata_;
 }
 
+std::vector<FragmentMetadata*> Array::new_fragment_metadata() const {
+  std::unique_lock<std::mutex> lck(mtx_);
+  return new_fragment_metadata_;
+}
+
 Status Array::get_array_schema(ArraySchema** array_schema) const {
   std::unique_lock<std::mutex> lck(mtx_);
 
@@ -382,6 +394,9 @@ const EncryptionKey& Array::get_encryption_key() const {
 }
 
 Status Array::reopen() {
+  // Flush the writes buffered in this context before taking the timestamp,
+  // as their fragment would otherwise be newer than the reopened array
+  RETURN_NOT_OK(storage_manager_->flush_writes(array_uri_));
   return reopen(utils::time::timestamp_now_ms());
 }
 
@@ -400,14 +415,29 @@ Status Array::reopen(uint64_t timestamp) {
   clear_last_max_buffer_sizes();
 
   timestamp_ = timestamp;
+  auto old_fragment_metadata = std::move(fragment_metadata_);
   fragment_metadata_.clear();
+  new_fragment_metadata_.clear();
 
-  return storage_manager_->array_reopen(
+  RETURN_NOT_OK(storage_manager_->array_reopen(
       array_uri_,
       timestamp_,
       encryption_key_,
       &array_schema_,
-      &fragment_metadata_);
+      old_fragment_metadata,
+      &fragment_metadata_));
+
+  // Find the fragments that were not visible before the reopen. The
+  // fragment metadata objects are owned by the open array and shared
+  // across reopens, hence they can be compared by address.
+  std::unordered_set<FragmentMetadata*> old_set(
+      old_fragment_metadata.begin(), old_fragment_metadata.end());
+  for (auto metadata : fragment_metadata_) {
+    if (old_set.find(metadata) == old_set.end())
+      new_fragment_metadata_.push_back(metadata);
+  }
+
+  return Status::Ok();
 }
 
 uint64_t Array::timestamp() const {
@@ -514,6 +544,14 @@ Status Array::compute_max_buffer_sizes(
   // Sanity check
   assert(!fragment_metadata_.empty());
 
+  // Load the fragment metadata of the involved attributes
+  std::vector<std::string> attributes;
+  for (const auto& it : *max_buffer_sizes)
+    attributes.push_back(it.first);
+  for (auto& meta : fragment_metadata_)
+    RETURN_NOT_OK(
+        meta->load_sections(storage_manager_, encryption_key_, attributes));
+
   // First we calculate a rough upper bound. Especially for dense
   // arrays, this will not be accurate, as it accounts only for the
   // non-empty regions of the subarray.
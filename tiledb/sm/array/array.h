@@ -156,6 +156,14 @@ class Array {
    */
   std::vector<FragmentMetadata*> fragment_metadata() const;
 
+  /**
+   * Returns the metadata of the fragments that became visible the last
+   * time the array was reopened, i.e., the fragments the array did not
+   * hold before that reopen. They are sorted in ascending timestamp order.
+   * If the array has not been reopened, an empty vector is returned.
+   */
+  std::vector<FragmentMetadata*> new_fragment_metadata() const;
+
   /**
    * Returns `true` if the array is empty at the time it is opened.
    * The funciton returns `false` if the array is not open.
@@ -237,6 +245,12 @@ class Array {
   /** The metadata of the fragments the array was opened with. */
   std::vector<FragmentMetadata*> fragment_metadata_;
 
+  /**
+   * The metadata of the fragments that became visible upon the last
+   * reopen. This is a subset of `fragment_metadata_`.
+   */
+  std::vector<FragmentMetadata*> new_fragment_metadata_;
+
   /** `True` if the array has been opened. */
   std::atomic<bool> is_open_;
 
@@ -272,6 +272,11 @@ const FilterPipeline* ArraySchema::coords_filters() const {
   return &coords_filters_;
 }
 
+const FilterPipeline* ArraySchema::coords_filters(unsigned dim_idx) const {
+  auto filters = domain_->dimension(dim_idx)->filters();
+  return (filters->size() > 0) ? filters : &coords_filters_;
+}
+
 Compressor ArraySchema::coords_compression() const {
   auto compressor = coords_filters_.get_filter<CompressionFilter>();
   assert(compressor != nullptr);
@@ -506,7 +511,7 @@ Status ArraySchema::deserialize(ConstBuffer* buff, bool is_kv) {
 
   // Load domain
   domain_ = new Domain();
-  RETURN_NOT_OK(domain_->deserialize(buff));
+  RETURN_NOT_OK(domain_->deserialize(buff, version_));
 
   // Load attributes
   uint32_t attribute_num;
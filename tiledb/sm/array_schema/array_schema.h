@@ -170,6 +170,13 @@ class ArraySchema {
   /** Return a pointer to the pipeline used for coordinates. */
   const FilterPipeline* coords_filters() const;
 
+  /**
+   * Return the filter pipeline for the coordinate tiles of the given
+   * dimension. This is the pipeline of the dimension if it is not empty,
+   * and the coordinates pipeline otherwise.
+   */
+  const FilterPipeline* coords_filters(unsigned dim_idx) const;
+
   /** Returns the compressor of the coordinates. */
   Compressor coords_compression() const;
 
@@ -62,6 +62,7 @@ Dimension::Dimension(const Dimension* dim) {
 
   name_ = dim->name();
   type_ = dim->type_;
+  filters_ = dim->filters_;
   uint64_t type_size = datatype_size(type_);
   domain_ = std::malloc(2 * type_size);
   std::memcpy(domain_, dim->domain(), 2 * type_size);
@@ -91,7 +92,9 @@ Dimension::~Dimension() {
 // domain (void* - 2*type_size)
 // null_tile_extent (uint8_t)
 // tile_extent (void* - type_size)
-Status Dimension::deserialize(ConstBuffer* buff, Datatype type) {
+// filter_pipeline (see FilterPipeline::serialize)
+Status Dimension::deserialize(
+    ConstBuffer* buff, uint32_t version, Datatype type) {
   // Set type
   type_ = type;
 
@@ -124,6 +127,10 @@ Status Dimension::deserialize(ConstBuffer* buff, Datatype type) {
     RETURN_NOT_OK(buff->read(tile_extent_, datatype_size(type_)));
   }
 
+  // Load filter pipeline
+  if (version >= constants::split_coords_version)
+    RETURN_NOT_OK(filters_.deserialize(buff));
+
   return Status::Ok();
 }
 
@@ -144,6 +151,10 @@ void Dimension::dump(FILE* out) const {
   fprintf(out, "- Tile extent: %s\n", tile_extent_s.c_str());
 }
 
+const FilterPipeline* Dimension::filters() const {
+  return &filters_;
+}
+
 const std::string& Dimension::name() const {
   return name_;
 }
@@ -159,6 +170,7 @@ bool Dimension::is_anonymous() const {
 // domain (void* - 2*type_size)
 // null_tile_extent (uint8_t)
 // tile_extent (void* - type_size)
+// filter_pipeline (see FilterPipeline::serialize)
 Status Dimension::serialize(Buffer* buff) {
   // Sanity check
   if (domain_ == nullptr) {
@@ -180,6 +192,9 @@ Status Dimension::serialize(Buffer* buff) {
   if (tile_extent_ != nullptr)
     RETURN_NOT_OK(buff->write(tile_extent_, datatype_size(type_)));
 
+  // Write filter pipeline
+  RETURN_NOT_OK(filters_.serialize(buff));
+
   return Status::Ok();
 }
 
@@ -208,6 +223,11 @@ Status Dimension::set_domain(const void* domain) {
   return st;
 }
 
+Status Dimension::set_filter_pipeline(const FilterPipeline* pipeline) {
+  filters_ = *pipeline;
+  return Status::Ok();
+}
+
 Status Dimension::set_tile_extent(const void* tile_extent) {
   if (domain_ == nullptr)
     return Status::DimensionError(
@@ -38,6 +38,7 @@
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/enums/compressor.h"
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/status.h"
 
@@ -80,10 +81,11 @@ class Dimension {
    * Populates the object members from the data in the input binary buffer.
    *
    * @param buff The buffer to deserialize from.
+   * @param version The format version of the array schema.
    * @param type The type of the dimension.
    * @return Status
    */
-  Status deserialize(ConstBuffer* buff, Datatype type);
+  Status deserialize(ConstBuffer* buff, uint32_t version, Datatype type);
 
   /** Returns the domain. */
   void* domain() const;
@@ -91,6 +93,13 @@ class Dimension {
   /** Dumps the dimension contents in ASCII form in the selected output. */
   void dump(FILE* out) const;
 
+  /**
+   * Returns the filter pipeline of this dimension. If empty, the coordinate
+   * tiles of the dimension are filtered with the coordinates filter pipeline
+   * of the array schema.
+   */
+  const FilterPipeline* filters() const;
+
   /** Returns the dimension name. */
   const std::string& name() const;
 
@@ -108,6 +117,9 @@ class Dimension {
   /** Sets the domain. */
   Status set_domain(const void* domain);
 
+  /** Sets the filter pipeline for this dimension. */
+  Status set_filter_pipeline(const FilterPipeline* pipeline);
+
   /** Sets the tile extent. */
   Status set_tile_extent(const void* tile_extent);
 
@@ -140,6 +152,9 @@ class Dimension {
   /** The dimension domain. */
   void* domain_;
 
+  /** The dimension filter pipeline. */
+  FilterPipeline filters_;
+
   /** The dimension name. */
   std::string name_;
 
@@ -367,6 +367,8 @@ Status Domain::add_dimension(Dimension* dim) {
   RETURN_NOT_OK_ELSE(new_dim->set_domain(dim->domain()), delete new_dim);
   RETURN_NOT_OK_ELSE(
       new_dim->set_tile_extent(dim->tile_extent()), delete new_dim);
+  RETURN_NOT_OK_ELSE(
+      new_dim->set_filter_pipeline(dim->filters()), delete new_dim);
 
   dimensions_.emplace_back(new_dim);
   ++dim_num_;
@@ -467,7 +469,7 @@ int Domain::cell_order_cmp(const T* coords_a, const T* coords_b) const {
 // dimension #1
 // dimension #2
 // ...
-Status Domain::deserialize(ConstBuffer* buff) {
+Status Domain::deserialize(ConstBuffer* buff, uint32_t version) {
   // Load type
   uint8_t type;
   RETURN_NOT_OK(buff->read(&type, sizeof(uint8_t)));
@@ -477,7 +479,7 @@ Status Domain::deserialize(ConstBuffer* buff) {
   RETURN_NOT_OK(buff->read(&dim_num_, sizeof(uint32_t)));
   for (uint32_t i = 0; i < dim_num_; ++i) {
     auto dim = new Dimension();
-    dim->deserialize(buff, type_);
+    RETURN_NOT_OK_ELSE(dim->deserialize(buff, version, type_), delete dim);
     dimensions_.emplace_back(dim);
   }
 
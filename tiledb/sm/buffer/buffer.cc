@@ -31,6 +31,7 @@
  */
 
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/buffer_pool.h"
 #include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/misc/logger.h"
 
@@ -55,11 +56,22 @@ Buffer::Buffer() {
   size_ = 0;
   offset_ = 0;
   owns_data_ = true;
+  pool_ = nullptr;
+}
+
+Buffer::Buffer(BufferPool* pool)
+    : pool_(pool) {
+  alloced_size_ = 0;
+  data_ = nullptr;
+  size_ = 0;
+  offset_ = 0;
+  owns_data_ = true;
 }
 
 Buffer::Buffer(void* data, uint64_t size, bool owns_data)
     : data_(data)
     , owns_data_(owns_data)
+    , pool_(nullptr)
     , size_(size) {
   offset_ = 0;
   alloced_size_ = 0;
@@ -72,6 +84,7 @@ Buffer::Buffer(const Buffer& buff) {
   size_ = 0;
   offset_ = 0;
   owns_data_ = true;
+  pool_ = nullptr;
   *this = buff;
 }
 
@@ -97,8 +110,12 @@ uint64_t Buffer::alloced_size() const {
 }
 
 void Buffer::clear() {
-  if (data_ != nullptr && owns_data_)
-    std::free(data_);
+  if (data_ != nullptr && owns_data_) {
+    if (pool_ != nullptr)
+      pool_->release(data_, alloced_size_);
+    else
+      std::free(data_);
+  }
 
   data_ = nullptr;
   offset_ = 0;
@@ -123,6 +140,11 @@ void* Buffer::data(uint64_t offset) const {
 }
 
 void Buffer::disown_data() {
+  // The new owner frees the data with `std::free`, so it leaves the pool
+  if (owns_data_ && pool_ != nullptr) {
+    pool_->disown(alloced_size_);
+    pool_ = nullptr;
+  }
   owns_data_ = false;
 }
 
@@ -139,6 +161,10 @@ bool Buffer::owns_data() const {
   return owns_data_;
 }
 
+BufferPool* Buffer::pool() const {
+  return pool_;
+}
+
 Status Buffer::read(void* buffer, uint64_t nbytes) {
   if (nbytes + offset_ > size_) {
     return LOG_STATUS(
@@ -155,7 +181,27 @@ Status Buffer::realloc(uint64_t nbytes) {
         "Cannot reallocate buffer; Buffer does not own data"));
   }
 
-  if (data_ == nullptr) {
+  if (pool_ != nullptr) {
+    if (data_ != nullptr && nbytes <= alloced_size_)
+      return Status::Ok();
+    // Grow in place if the pooled block is already large enough
+    if (data_ != nullptr &&
+        pool_->block_size(nbytes) == pool_->block_size(alloced_size_)) {
+      alloced_size_ = nbytes;
+      return Status::Ok();
+    }
+    auto new_data = pool_->acquire(nbytes);
+    if (new_data == nullptr) {
+      return LOG_STATUS(Status::BufferError(
+          "Cannot reallocate buffer; Memory allocation failed"));
+    }
+    if (data_ != nullptr) {
+      std::memcpy(new_data, data_, alloced_size_);
+      pool_->release(data_, alloced_size_);
+    }
+    data_ = new_data;
+    alloced_size_ = nbytes;
+  } else if (data_ == nullptr) {
     data_ = std::malloc(nbytes);
     if (data_ == nullptr) {
       return LOG_STATUS(Status::BufferError(
@@ -201,6 +247,7 @@ Status Buffer::swap(Buffer& other) {
   std::swap(data_, other.data_);
   std::swap(offset_, other.offset_);
   std::swap(owns_data_, other.owns_data_);
+  std::swap(pool_, other.pool_);
   std::swap(size_, other.size_);
   return Status::Ok();
 }
@@ -272,6 +319,7 @@ Status Buffer::write_with_shift(ConstBuffer* buff, uint64_t offset) {
 
 Buffer& Buffer::operator=(const Buffer& buff) {
   clear();
+  pool_ = nullptr;
 
   owns_data_ = buff.owns_data_;
 
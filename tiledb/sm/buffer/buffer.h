@@ -40,6 +40,7 @@
 namespace tiledb {
 namespace sm {
 
+class BufferPool;
 class ConstBuffer;
 
 /** Enables reading from and writing to a buffer. */
@@ -52,6 +53,14 @@ class Buffer {
   /** Constructor. */
   Buffer();
 
+  /**
+   * Constructor. The buffer will draw its allocations from the input pool
+   * and return them to it when cleared.
+   *
+   * @param pool The buffer pool. If `nullptr`, the system allocator is used.
+   */
+  explicit Buffer(BufferPool* pool);
+
   /**
    * Constructor. Initializes a buffer with the input data and size.
    *
@@ -109,6 +118,9 @@ class Buffer {
   /** Returns `true` if the buffer owns its data buffer. */
   bool owns_data() const;
 
+  /** Returns the pool the buffer allocates from (`nullptr` if none). */
+  BufferPool* pool() const;
+
   /**
    * Reads from the local data into the input buffer.
    *
@@ -243,6 +255,9 @@ class Buffer {
    */
   bool owns_data_;
 
+  /** The pool the buffer allocates from, or `nullptr` for the system heap. */
+  BufferPool* pool_;
+
   /** Size of the buffer useful data. */
   uint64_t size_;
 
@@ -0,0 +1,163 @@
+/**
+ * @file   buffer_pool.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class BufferPool.
+ */
+
+#include "tiledb/sm/buffer/buffer_pool.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/stats.h"
+
+#include <cstdlib>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+BufferPool::BufferPool(uint64_t max_size)
+    : in_use_size_(0)
+    , max_size_(max_size)
+    , pooled_size_(0) {
+  for (int i = 0; i < constants::buffer_pool_max_class_num &&
+                  class_size(i) <= max_size_;
+       ++i)
+    classes_.emplace_back(new SizeClass());
+}
+
+BufferPool::~BufferPool() {
+  for (auto& c : classes_) {
+    for (auto data : c->free_)
+      std::free(data);
+  }
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+void* BufferPool::acquire(uint64_t nbytes) {
+  int index = class_index(nbytes);
+  if (index == -1)
+    return std::malloc(nbytes);
+
+  auto size = class_size(index);
+  void* data = nullptr;
+  {
+    auto& c = classes_[index];
+    std::unique_lock<std::mutex> lck(c->mtx_);
+    if (!c->free_.empty()) {
+      data = c->free_.back();
+      c->free_.pop_back();
+    }
+  }
+
+  if (data != nullptr) {
+    pooled_size_ -= size;
+    STATS_COUNTER_ADD(buffer_pool_hits, 1);
+    STATS_COUNTER_ADD(buffer_pool_reused_bytes, size);
+  } else {
+    data = std::malloc(size);
+    if (data == nullptr)
+      return nullptr;
+    STATS_COUNTER_ADD(buffer_pool_misses, 1);
+  }
+
+  in_use_size_ += size;
+  STATS_COUNTER_MAX(buffer_pool_max_in_use_bytes, in_use_size_.load());
+  return data;
+}
+
+uint64_t BufferPool::block_size(uint64_t nbytes) const {
+  int index = class_index(nbytes);
+  return (index == -1) ? nbytes : class_size(index);
+}
+
+void BufferPool::disown(uint64_t nbytes) {
+  int index = class_index(nbytes);
+  if (index != -1)
+    in_use_size_ -= class_size(index);
+}
+
+uint64_t BufferPool::pooled_size() const {
+  return pooled_size_;
+}
+
+void BufferPool::release(void* data, uint64_t nbytes) {
+  if (data == nullptr)
+    return;
+
+  // Blocks outside the size classes are not pooled
+  int index = class_index(nbytes);
+  if (index == -1) {
+    std::free(data);
+    return;
+  }
+
+  auto size = class_size(index);
+  in_use_size_ -= size;
+
+  // Free the block if keeping it would exceed the pool size
+  if ((pooled_size_ += size) > max_size_) {
+    pooled_size_ -= size;
+    std::free(data);
+    return;
+  }
+  STATS_COUNTER_MAX(buffer_pool_max_pooled_bytes, pooled_size_.load());
+
+  auto& c = classes_[index];
+  std::unique_lock<std::mutex> lck(c->mtx_);
+  c->free_.push_back(data);
+}
+
+/* ****************************** */
+/*          PRIVATE METHODS       */
+/* ****************************** */
+
+int BufferPool::class_index(uint64_t nbytes) const {
+  // Small requests are cheap for the system allocator and not worth rounding
+  if (nbytes < constants::buffer_pool_min_class_size)
+    return -1;
+
+  for (int i = 0; i < (int)classes_.size(); ++i) {
+    if (nbytes <= class_size(i))
+      return i;
+  }
+
+  return -1;
+}
+
+uint64_t BufferPool::class_size(int index) {
+  return constants::buffer_pool_min_class_size << index;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,166 @@
+/**
+ * @file   buffer_pool.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class BufferPool.
+ */
+
+#ifndef TILEDB_BUFFER_POOL_H
+#define TILEDB_BUFFER_POOL_H
+
+#include <atomic>
+#include <cinttypes>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A thread-safe pool of heap allocations, bucketed in power-of-two size
+ * classes. Buffers that are repeatedly allocated and freed with similar sizes
+ * (e.g., tile and filter pipeline buffers) draw memory from the pool instead
+ * of the system allocator. Released blocks are kept idle for reuse as long as
+ * the total idle bytes do not exceed the pool size; otherwise they are freed.
+ *
+ * Every block handed out by the pool is allocated with `std::malloc`, so a
+ * block that escapes the pool (see `disown`) can be released with `std::free`.
+ */
+class BufferPool {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param max_size The maximum number of idle bytes kept by the pool. The
+   *     largest size class is the largest power of two not exceeding this
+   *     value. A value of 0 disables pooling.
+   */
+  explicit BufferPool(uint64_t max_size);
+
+  /** Destructor. Frees all idle blocks. */
+  ~BufferPool();
+
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns a block of at least `nbytes` bytes. Requests that fall within
+   * a size class are rounded up to the class size and served from the idle
+   * blocks of that class if possible.
+   *
+   * @param nbytes The number of bytes requested.
+   * @return The block, or `nullptr` if the allocation failed.
+   */
+  void* acquire(uint64_t nbytes);
+
+  /**
+   * Returns the actual size of the block that `acquire` returns for a
+   * request of `nbytes` bytes. A block can be grown in place up to this size.
+   */
+  uint64_t block_size(uint64_t nbytes) const;
+
+  /**
+   * Accounts for a block obtained through `acquire` whose ownership was
+   * transferred outside the pool. The block must then be freed with
+   * `std::free`.
+   *
+   * @param nbytes The size requested for the block. Any size with the same
+   *     `block_size` is valid.
+   */
+  void disown(uint64_t nbytes);
+
+  /** Returns the total number of idle bytes currently kept by the pool. */
+  uint64_t pooled_size() const;
+
+  /**
+   * Returns a block obtained through `acquire` to the pool. The block is
+   * freed instead if it does not fit a size class or if keeping it would
+   * exceed the pool size.
+   *
+   * @param data The block to release.
+   * @param nbytes The size requested for the block. Any size with the same
+   *     `block_size` is valid.
+   */
+  void release(void* data, uint64_t nbytes);
+
+ private:
+  /* ********************************* */
+  /*         TYPE DEFINITIONS          */
+  /* ********************************* */
+
+  /** The idle blocks of a single size class. */
+  struct SizeClass {
+    /** Protects `free_`. */
+    std::mutex mtx_;
+    /** The idle blocks. */
+    std::vector<void*> free_;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The size classes, ordered by increasing block size. */
+  std::vector<std::unique_ptr<SizeClass>> classes_;
+
+  /** The number of bytes handed out by `acquire` and not yet released. */
+  std::atomic<uint64_t> in_use_size_;
+
+  /** The maximum number of idle bytes kept by the pool. */
+  uint64_t max_size_;
+
+  /** The total number of idle bytes currently kept by the pool. */
+  std::atomic<uint64_t> pooled_size_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Returns the index of the smallest size class that fits `nbytes`, or
+   * -1 if `nbytes` is not served by the pool.
+   */
+  int class_index(uint64_t nbytes) const;
+
+  /** Returns the block size of the size class at the input index. */
+  static uint64_t class_size(int index);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_BUFFER_POOL_H
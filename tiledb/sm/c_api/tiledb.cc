@@ -166,6 +166,10 @@ struct tiledb_vfs_fh_t {
   tiledb::sm::VFSFileHandle* vfs_fh_ = nullptr;
 };
 
+struct tiledb_completion_queue_t {
+  tiledb::sm::CompletionQueue* cq_ = nullptr;
+};
+
 /* ********************************* */
 /*         AUXILIARY FUNCTIONS       */
 /* ********************************* */
@@ -394,6 +398,17 @@ inline int32_t sanity_check(tiledb_ctx_t* ctx, const tiledb_vfs_fh_t* fh) {
   return TILEDB_OK;
 }
 
+inline int32_t sanity_check(
+    tiledb_ctx_t* ctx, const tiledb_completion_queue_t* cq) {
+  if (cq == nullptr || cq->cq_ == nullptr) {
+    auto st = tiledb::sm::Status::Error("Invalid TileDB completion queue");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_ERR;
+  }
+  return TILEDB_OK;
+}
+
 inline int32_t check_filter_type(
     tiledb_ctx_t* ctx, tiledb_filter_t* filter, tiledb_filter_type_t type) {
   auto cpp_type = static_cast<tiledb::sm::FilterType>(type);
@@ -781,6 +796,25 @@ int32_t tiledb_ctx_cancel_tasks(tiledb_ctx_t* ctx) {
   return TILEDB_OK;
 }
 
+int32_t tiledb_ctx_flush_writes(tiledb_ctx_t* ctx) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(ctx, ctx->ctx_->storage_manager()->flush_writes()))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_ctx_wait_consolidations(tiledb_ctx_t* ctx) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  ctx->ctx_->storage_manager()->wait_for_consolidations();
+
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*              GROUP             */
 /* ****************************** */
@@ -1333,6 +1367,21 @@ void tiledb_dimension_free(tiledb_dimension_t** dim) {
   }
 }
 
+int32_t tiledb_dimension_set_filter_list(
+    tiledb_ctx_t* ctx,
+    tiledb_dimension_t* dim,
+    tiledb_filter_list_t* filter_list) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, dim) == TILEDB_ERR ||
+      sanity_check(ctx, filter_list) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx, dim->dim_->set_filter_pipeline(filter_list->pipeline_)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int32_t tiledb_dimension_get_name(
     tiledb_ctx_t* ctx, const tiledb_dimension_t* dim, const char** name) {
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, dim) == TILEDB_ERR)
@@ -1349,6 +1398,38 @@ int32_t tiledb_dimension_get_type(
   return TILEDB_OK;
 }
 
+int32_t tiledb_dimension_get_filter_list(
+    tiledb_ctx_t* ctx,
+    tiledb_dimension_t* dim,
+    tiledb_filter_list_t** filter_list) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, dim) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Create a filter list struct
+  *filter_list = new (std::nothrow) tiledb_filter_list_t;
+  if (*filter_list == nullptr) {
+    auto st = tiledb::sm::Status::Error(
+        "Failed to allocate TileDB filter list object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  // Create a new FilterPipeline object
+  (*filter_list)->pipeline_ =
+      new (std::nothrow) tiledb::sm::FilterPipeline(*dim->dim_->filters());
+  if ((*filter_list)->pipeline_ == nullptr) {
+    delete *filter_list;
+    auto st = tiledb::sm::Status::Error(
+        "Failed to allocate TileDB filter list object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  return TILEDB_OK;
+}
+
 int32_t tiledb_dimension_get_domain(
     tiledb_ctx_t* ctx, const tiledb_dimension_t* dim, void** domain) {
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, dim) == TILEDB_ERR)
@@ -2282,6 +2363,158 @@ int32_t tiledb_query_get_type(
   return TILEDB_OK;
 }
 
+int32_t tiledb_query_get_id(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, uint64_t* id) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  *id = query->query_->id();
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_get_stats(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, char** stats_json) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  std::string str;
+  query->query_->dump_stats(&str);
+
+  *stats_json = static_cast<char*>(std::malloc(str.size() + 1));
+  if (*stats_json == nullptr) {
+    auto st = tiledb::sm::Status::Error(
+        "Failed to allocate query stats string; Memory allocation error");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  std::memcpy(*stats_json, str.data(), str.size());
+  (*stats_json)[str.size()] = '\0';
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_submit_async_cq(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    tiledb_completion_queue_t* cq,
+    void* tag) {
+  // Sanity checks
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR ||
+      sanity_check(ctx, cq) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(ctx, query->query_->submit_async(cq->cq_, tag)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+/* ****************************** */
+/*        COMPLETION QUEUE        */
+/* ****************************** */
+
+int32_t tiledb_completion_queue_alloc(
+    tiledb_ctx_t* ctx, tiledb_completion_queue_t** cq) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Create completion queue struct
+  *cq = new (std::nothrow) tiledb_completion_queue_t;
+  if (*cq == nullptr) {
+    auto st = tiledb::sm::Status::Error(
+        "Failed to allocate TileDB completion queue object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  // Create a new CompletionQueue object
+  (*cq)->cq_ = new (std::nothrow) tiledb::sm::CompletionQueue();
+  if ((*cq)->cq_ == nullptr) {
+    delete *cq;
+    *cq = nullptr;
+    auto st = tiledb::sm::Status::Error(
+        "Failed to allocate TileDB completion queue object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  // Initialize the completion queue
+  if (SAVE_ERROR_CATCH(ctx, (*cq)->cq_->init())) {
+    delete (*cq)->cq_;
+    delete *cq;
+    *cq = nullptr;
+    return TILEDB_ERR;
+  }
+
+  // Success
+  return TILEDB_OK;
+}
+
+void tiledb_completion_queue_free(tiledb_completion_queue_t** cq) {
+  if (cq != nullptr && *cq != nullptr) {
+    delete (*cq)->cq_;
+    delete *cq;
+    *cq = nullptr;
+  }
+}
+
+int32_t tiledb_completion_queue_get_fd(
+    tiledb_ctx_t* ctx, tiledb_completion_queue_t* cq, int32_t* fd) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, cq) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  *fd = cq->cq_->fd();
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_completion_queue_poll(
+    tiledb_ctx_t* ctx,
+    tiledb_completion_queue_t* cq,
+    void** tag,
+    tiledb_query_status_t* status,
+    int32_t* has_event) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, cq) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  tiledb::sm::CompletionQueue::Event event;
+  *has_event = cq->cq_->pop(&event) ? 1 : 0;
+  if (*has_event) {
+    *tag = event.tag_;
+    *status = static_cast<tiledb_query_status_t>(event.status_);
+  }
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_completion_queue_wait(
+    tiledb_ctx_t* ctx,
+    tiledb_completion_queue_t* cq,
+    int64_t timeout_ms,
+    void** tag,
+    tiledb_query_status_t* status,
+    int32_t* has_event) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, cq) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  tiledb::sm::CompletionQueue::Event event;
+  *has_event = cq->cq_->wait(timeout_ms, &event) ? 1 : 0;
+  if (*has_event) {
+    *tag = event.tag_;
+    *status = static_cast<tiledb_query_status_t>(event.status_);
+  }
+
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*              ARRAY             */
 /* ****************************** */
@@ -2454,6 +2687,42 @@ int32_t tiledb_array_reopen_at(
   return TILEDB_OK;
 }
 
+int32_t tiledb_array_poll(
+    tiledb_ctx_t* ctx, tiledb_array_t* array, uint32_t* new_fragment_num) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, array) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Reopen array
+  if (SAVE_ERROR_CATCH(ctx, array->array_->reopen()))
+    return TILEDB_ERR;
+
+  *new_fragment_num = (uint32_t)array->array_->new_fragment_metadata().size();
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_array_get_new_fragment_uri(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    uint32_t idx,
+    const char** fragment_uri) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, array) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto new_fragment_metadata = array->array_->new_fragment_metadata();
+  if (idx >= new_fragment_metadata.size()) {
+    auto st = tiledb::sm::Status::Error(
+        "Cannot get new fragment URI; Invalid fragment index");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_ERR;
+  }
+
+  *fragment_uri = new_fragment_metadata[idx]->fragment_uri().c_str();
+
+  return TILEDB_OK;
+}
+
 int32_t tiledb_array_get_timestamp(
     tiledb_ctx_t* ctx, tiledb_array_t* array, uint64_t* timestamp) {
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, array) == TILEDB_ERR)
@@ -4329,6 +4598,43 @@ int32_t tiledb_stats_free_str(char** out) {
   return TILEDB_OK;
 }
 
+int32_t tiledb_stats_trace_enable() {
+  tiledb::sm::stats::tracer.set_enabled(true);
+  return TILEDB_OK;
+}
+
+int32_t tiledb_stats_trace_disable() {
+  tiledb::sm::stats::tracer.set_enabled(false);
+  return TILEDB_OK;
+}
+
+int32_t tiledb_stats_trace_reset() {
+  tiledb::sm::stats::tracer.reset();
+  return TILEDB_OK;
+}
+
+int32_t tiledb_stats_trace_dump(FILE* out) {
+  tiledb::sm::stats::tracer.dump(out);
+  return TILEDB_OK;
+}
+
+int32_t tiledb_stats_trace_dump_str(char** out) {
+  if (out == nullptr)
+    return TILEDB_ERR;
+
+  std::string str;
+  tiledb::sm::stats::tracer.dump(&str);
+
+  *out = static_cast<char*>(std::malloc(str.size() + 1));
+  if (*out == nullptr)
+    return TILEDB_ERR;
+
+  std::memcpy(*out, str.data(), str.size());
+  (*out)[str.size()] = '\0';
+
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*            C++ API             */
 /* ****************************** */
@@ -126,6 +126,14 @@ typedef enum {
 #undef TILEDB_FILTER_OPTION_ENUM
 } tiledb_filter_option_t;
 
+/** Objective of the codec choice of the adaptive filter. */
+typedef enum {
+/** Helper macro for defining adaptive filter objective enums. */
+#define TILEDB_AUTO_OBJECTIVE_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_AUTO_OBJECTIVE_ENUM
+} tiledb_auto_objective_t;
+
 /** Encryption type. */
 typedef enum {
 /** Helper macro for defining encryption enums. */
@@ -274,6 +282,9 @@ typedef struct tiledb_vfs_t tiledb_vfs_t;
 /** A virtual filesystem file handle. */
 typedef struct tiledb_vfs_fh_t tiledb_vfs_fh_t;
 
+/** A queue of completion events of asynchronous queries. */
+typedef struct tiledb_completion_queue_t tiledb_completion_queue_t;
+
 /* ********************************* */
 /*              ERROR                */
 /* ********************************* */
@@ -385,6 +396,40 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `sm.tile_cache_size` <br>
  *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
  *    **Default**: 10,000,000
+ * - `sm.zstd_dictionary_size` <br>
+ *    The maximum size in bytes of the zstd dictionary trained for each
+ *    attribute whose first filter is zstd compression, on the first tiles
+ *    written to a fragment, and stored in the fragment metadata. A
+ *    dictionary improves the compression of small tiles. No dictionaries
+ *    are trained if 0. <br>
+ *    **Default**: 0
+ * - `sm.verify_checksums` <br>
+ *    If `true`, the checksum filters verify the checksum of every tile
+ *    chunk they unfilter, and reads fail on a mismatch. Tiles found in the
+ *    tile cache were verified when first read, so they are not verified
+ *    again. If `false`, checksums are still written but not verified. <br>
+ *    **Default**: true
+ * - `sm.write_coalescing.max_bytes` <br>
+ *    If non-zero, unordered writes are not written as a fragment each, but
+ *    are buffered in memory per array and written together as a single
+ *    fragment once the buffered bytes of the array exceed this size, once
+ *    they are older than `sm.write_coalescing.max_age_ms`, when the array
+ *    is opened for reads in the same context, when
+ *    `tiledb_ctx_flush_writes` is called, or when the context is freed.
+ *    Buffered writes are lost if the process exits before they are flushed.
+ *    Cells written more than once while buffered keep their latest value.
+ *    Writes are not buffered if 0. <br>
+ *    **Default**: 0
+ * - `sm.write_coalescing.max_age_ms` <br>
+ *    The time in milliseconds after which buffered writes are flushed, if
+ *    `sm.write_coalescing.max_bytes` is non-zero. Buffered writes are only
+ *    flushed on the other events if 0. <br>
+ *    **Default**: 1000
+ * - `sm.read_partition_utilization` <br>
+ *    The fraction of the user buffers that each partition of an incomplete
+ *    read aims to fill, based on the estimated result size. Must be in
+ *    `(0, 1]`. <br>
+ *    **Default**: 1.0
  * - `sm.array_schema_cache_size` <br>
  *    The array schema cache size in bytes. Any `uint64_t` value is
  *    acceptable. <br>
@@ -392,25 +437,44 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `sm.fragment_metadata_cache_size` <br>
  *    The fragment metadata cache size in bytes. Any `uint64_t` value is
  *    acceptable. <br>
+ * - `sm.generic_tile_prefetch_size` <br>
+ *    The number of bytes of a generic tile (e.g. the array schema or a
+ *    fragment metadata section) that are read speculatively in the same
+ *    request as its header, so that small generic tiles are read in a
+ *    single request. `0` reads the header and the tile separately. <br>
+ *    **Default**: 65536
+ * - `sm.buffer_pool_size` <br>
+ *    The maximum number of idle bytes kept by the pool that tile and
+ *    filter buffers allocate from. `0` disables pooling. <br>
+ *    **Default**: 50,000,000
  * - `sm.enable_signal_handlers` <br>
  *    Determines whether or not TileDB will install signal handlers. <br>
  *    **Default**: true
  * - `sm.num_async_threads` <br>
- *    The number of threads allocated for async queries. <br>
+ *    Deprecated and ignored. Async queries run on the thread pool of the
+ *    context (see `sm.num_compute_threads`). <br>
  *    **Default**: 1
  * - `sm.num_reader_threads` <br>
- *    The number of threads allocated for issuing reads to VFS in parallel. <br>
+ *    Deprecated and ignored. Reads are issued on the thread pool of the context
+ *    (see `sm.num_compute_threads`). <br>
  *    **Default**: 1
  * - `sm.num_writer_threads` <br>
- *    The number of threads allocated for issuing writes to VFS in
- *    parallel.<br>
+ *    Deprecated and ignored. Writes are issued on the thread pool of the
+ *    context (see `sm.num_compute_threads`). <br>
+ *    **Default**: 1
+ * - `sm.num_compute_threads` <br>
+ *    The number of threads of the thread pool of the context, which runs all
+ *    its parallel work: async queries, the parallel I/O, loops and sorts of the
+ *    queries and the filter pipeline, and background consolidation. <br>
+ *    **Default**: number of cores
+ * - `sm.num_consolidation_threads` <br>
+ *    The maximum number of background consolidations running at a time on the
+ *    thread pool of the context (see `sm.consolidation.auto`).<br>
  *    **Default**: 1
  * - `sm.num_tbb_threads` <br>
- *    The number of threads allocated for the TBB thread pool (if TBB is
- *    enabled). Note: this is a whole-program setting. Usually this should not
- *    be modified from the default. See also the documentation for TBB's
- *    `task_scheduler_init` class.<br>
- *    **Default**: TBB automatic
+ *    Deprecated and ignored. TileDB no longer uses TBB; all parallel work runs
+ *    on the thread pool of the context (see `sm.num_compute_threads`). <br>
+ *    **Default**: -1
  * - `sm.consolidation.amplification` <br>
  *    The factor by which the size of the dense fragment resulting
  *    from consolidating a set of fragments (containing at least one
@@ -438,9 +502,28 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    The size ratio that two ("adjacent") fragments must satisfy to be
  *    considered for consolidation in a single step.<br>
  *    **Default**: 0.0
+ * - `sm.consolidation.auto` <br>
+ *    If `true`, arrays written through this context are consolidated in
+ *    the background after writes, using the consolidation parameters
+ *    above.<br>
+ *    **Default**: false
+ * - `sm.consolidation.auto_interval_ms` <br>
+ *    The minimum time (in milliseconds) between two background
+ *    consolidation runs on the same array.<br>
+ *    **Default**: 1000
+ * - `sm.consolidation.auto_max_bytes` <br>
+ *    The maximum number of fragment bytes a single background
+ *    consolidation run may rewrite.<br>
+ *    **Default**: 1,000,000,000
+ * - `sm.consolidation.auto_write_amplification` <br>
+ *    The maximum ratio of bytes rewritten by background consolidation to
+ *    bytes written by queries, per array.<br>
+ *    **Default**: 4.0
  * - `vfs.num_threads` <br>
  *    The number of threads allocated for VFS operations (any backend), per VFS
- *    instance. <br>
+ *    instance created without a context, e.g., by `tiledb_vfs_alloc`. The VFS
+ *    of a context uses the thread pool of the context (see
+ *    `sm.num_compute_threads`). <br>
  *    **Default**: number of cores
  * - `vfs.min_parallel_size` <br>
  *    The minimum number of bytes in a parallel VFS operation
@@ -458,6 +541,29 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    The maximum number of parallel operations on objects with `file:///`
  *    URIs. <br>
  *    **Default**: `vfs.num_threads`
+ * - `vfs.file.io_uring` <br>
+ *    If `true`, reads of objects with `file:///` URIs are submitted in
+ *    batches through Linux io_uring instead of blocking `pread` calls from
+ *    the VFS thread pool. Ignored (with the blocking path used instead) if
+ *    TileDB was built without io_uring support or the kernel does not
+ *    provide it. <br>
+ *    **Default**: false
+ * - `vfs.file.io_uring_depth` <br>
+ *    The maximum number of reads in flight on an io_uring instance, if
+ *    `vfs.file.io_uring` is `true`. <br>
+ *    **Default**: 32
+ * - `vfs.disk_cache.path` <br>
+ *    A local directory in which the fragment files (except the fragment
+ *    metadata) read from `s3://` and `hdfs://` URIs are cached, keyed on the
+ *    file URI and the byte range read. Fragment files are immutable, so cached
+ *    ranges never go stale. Missed ranges are cached by background tasks, off
+ *    the read path. The directory may be shared by concurrent processes. The
+ *    cache is disabled if empty. <br>
+ *    **Default**: ""
+ * - `vfs.disk_cache.max_size` <br>
+ *    The maximum size in bytes of the local disk cache, beyond which the
+ *    least recently used ranges are evicted. <br>
+ *    **Default**: 10737418240
  * - `vfs.s3.region` <br>
  *    The S3 region, if S3 is enabled. <br>
  *    **Default**: us-east-1
@@ -891,6 +997,39 @@ TILEDB_EXPORT int32_t tiledb_ctx_is_supported_fs(
  */
 TILEDB_EXPORT int32_t tiledb_ctx_cancel_tasks(tiledb_ctx_t* ctx);
 
+/**
+ * Writes the unordered writes buffered by the given context (see the
+ * `sm.write_coalescing.max_bytes` config parameter) to their arrays, as one
+ * fragment per array. Buffered writes are lost if the process exits before
+ * they are flushed; once this function returns, they are durable.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_ctx_flush_writes(ctx);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_ctx_flush_writes(tiledb_ctx_t* ctx);
+
+/**
+ * Waits until the background consolidations of the given context (see the
+ * `sm.consolidation.auto` config parameter) have completed, including the
+ * runs scheduled for the fragments written meanwhile.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_ctx_wait_consolidations(ctx);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_ctx_wait_consolidations(tiledb_ctx_t* ctx);
+
 /* ********************************* */
 /*                GROUP              */
 /* ********************************* */
@@ -1607,6 +1746,32 @@ TILEDB_EXPORT int32_t tiledb_dimension_alloc(
  */
 TILEDB_EXPORT void tiledb_dimension_free(tiledb_dimension_t** dim);
 
+/**
+ * Sets the filter list for a dimension. The coordinate tiles of the
+ * dimension are filtered with this list in sparse fragments. If the list is
+ * empty (the default), the coordinates filter list of the array schema is
+ * used. Note that the filter list must be set before the dimension is added
+ * to a domain.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_filter_list_t* filter_list;
+ * tiledb_filter_list_alloc(ctx, &filter_list);
+ * tiledb_filter_list_add_filter(ctx, filter_list, filter);
+ * tiledb_dimension_set_filter_list(ctx, dim, filter_list);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param dim The target dimension.
+ * @param filter_list The filter_list to be set.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_dimension_set_filter_list(
+    tiledb_ctx_t* ctx,
+    tiledb_dimension_t* dim,
+    tiledb_filter_list_t* filter_list);
+
 /**
  * Retrieves the dimension name.
  *
@@ -1643,6 +1808,27 @@ TILEDB_EXPORT int32_t tiledb_dimension_get_name(
 TILEDB_EXPORT int32_t tiledb_dimension_get_type(
     tiledb_ctx_t* ctx, const tiledb_dimension_t* dim, tiledb_datatype_t* type);
 
+/**
+ * Retrieves the filter list for a dimension.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_filter_list_t* filter_list;
+ * tiledb_dimension_get_filter_list(ctx, dim, &filter_list);
+ * tiledb_filter_list_free(&filter_list);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param dim The target dimension.
+ * @param filter_list The filter list to be retrieved.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_dimension_get_filter_list(
+    tiledb_ctx_t* ctx,
+    tiledb_dimension_t* dim,
+    tiledb_filter_list_t** filter_list);
+
 /**
  * Retrieves the domain of the dimension.
  *
@@ -2626,6 +2812,202 @@ TILEDB_EXPORT int32_t tiledb_query_get_status(
 TILEDB_EXPORT int32_t tiledb_query_get_type(
     tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_query_type_t* query_type);
 
+/**
+ * Retrieves the id of a query, which is unique within the process and
+ * identifies the query in the events dumped by `tiledb_stats_trace_dump`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint64_t query_id;
+ * tiledb_query_get_id(ctx, query, &query_id);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query.
+ * @param id The query id to be retrieved.
+ * @return `TILEDB_OK` upon success, and `TILEDB_ERR` upon error.
+ */
+TILEDB_EXPORT int32_t
+tiledb_query_get_id(tiledb_ctx_t* ctx, tiledb_query_t* query, uint64_t* id);
+
+/**
+ * Retrieves the stats gathered while processing a query, as a JSON string
+ * in the format of `tiledb_stats_dump_str` that lists only the non-zero
+ * entries, along with latency histograms (count, p50, p90, p99, p999 and
+ * max, in nanoseconds) of the main processing phases. Stats are gathered
+ * only while they are enabled with `tiledb_stats_enable`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * char* stats_json;
+ * tiledb_query_get_stats(ctx, query, &stats_json);
+ * // Use stats_json...
+ * tiledb_stats_free_str(&stats_json);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query.
+ * @param stats_json Set to a newly allocated string holding the stats. It
+ *     must be freed with `tiledb_stats_free_str`.
+ * @return `TILEDB_OK` upon success, and `TILEDB_ERR` upon error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_stats(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, char** stats_json);
+
+/**
+ * Submits a TileDB query in asynchronous mode, posting an event to a
+ * completion queue once the processing of the query ends (whether the
+ * query completed, is incomplete, failed or was cancelled). The event
+ * carries the input tag and the query status, and is retrieved with
+ * `tiledb_completion_queue_poll` or `tiledb_completion_queue_wait`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_completion_queue_t* cq;
+ * tiledb_completion_queue_alloc(ctx, &cq);
+ * tiledb_query_submit_async_cq(ctx, query, cq, query);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query to be submitted.
+ * @param cq The completion queue to post the completion event to.
+ * @param tag A user tag identifying the query in the completion event.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ *
+ * @note The completion queue must not be freed before the events of all
+ *     queries submitted to it have been posted.
+ *
+ * @note Each async query is processed from start to end by one thread of
+ *     the thread pool of the context (see `sm.num_compute_threads`). While
+ *     the query waits for its I/O and filtering tasks, that thread runs the
+ *     pending tasks of any query, but it does not start another async query.
+ *     Hence at most `sm.num_compute_threads` async queries are processed at
+ *     a time, and the rest wait in the pool until a thread becomes idle.
+ */
+TILEDB_EXPORT int32_t tiledb_query_submit_async_cq(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    tiledb_completion_queue_t* cq,
+    void* tag);
+
+/* ********************************* */
+/*          COMPLETION QUEUE         */
+/* ********************************* */
+
+/**
+ * Creates a completion queue, to which asynchronous queries submitted with
+ * `tiledb_query_submit_async_cq` post their completion events.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_completion_queue_t* cq;
+ * tiledb_completion_queue_alloc(ctx, &cq);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cq The completion queue to be created.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_completion_queue_alloc(
+    tiledb_ctx_t* ctx, tiledb_completion_queue_t** cq);
+
+/**
+ * Frees a completion queue.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_completion_queue_free(&cq);
+ * @endcode
+ *
+ * @param cq The completion queue to be freed.
+ */
+TILEDB_EXPORT void tiledb_completion_queue_free(tiledb_completion_queue_t** cq);
+
+/**
+ * Retrieves a file descriptor that is readable whenever the completion
+ * queue holds events, so that the queue can be registered with `epoll`,
+ * `poll` or `select`. The descriptor is owned by the queue and must not be
+ * read from or closed by the user. It is set to `-1` on platforms that
+ * do not support it (e.g., Windows).
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * int32_t fd;
+ * tiledb_completion_queue_get_fd(ctx, cq, &fd);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cq The completion queue.
+ * @param fd The file descriptor to be retrieved.
+ * @return `TILEDB_OK` upon success, and `TILEDB_ERR` upon error.
+ */
+TILEDB_EXPORT int32_t tiledb_completion_queue_get_fd(
+    tiledb_ctx_t* ctx, tiledb_completion_queue_t* cq, int32_t* fd);
+
+/**
+ * Retrieves the oldest completion event of the queue without blocking.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * void* tag;
+ * tiledb_query_status_t status;
+ * int32_t has_event;
+ * tiledb_completion_queue_poll(ctx, cq, &tag, &status, &has_event);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cq The completion queue.
+ * @param tag The tag of the query that posted the event.
+ * @param status The status of the query when its processing ended.
+ * @param has_event Set to `1` if an event was retrieved and `0` if the
+ *     queue was empty, in which case `tag` and `status` are unchanged.
+ * @return `TILEDB_OK` upon success, and `TILEDB_ERR` upon error.
+ */
+TILEDB_EXPORT int32_t tiledb_completion_queue_poll(
+    tiledb_ctx_t* ctx,
+    tiledb_completion_queue_t* cq,
+    void** tag,
+    tiledb_query_status_t* status,
+    int32_t* has_event);
+
+/**
+ * Retrieves the oldest completion event of the queue, waiting for an
+ * event to be posted if the queue is empty.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * void* tag;
+ * tiledb_query_status_t status;
+ * int32_t has_event;
+ * tiledb_completion_queue_wait(ctx, cq, 100, &tag, &status, &has_event);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cq The completion queue.
+ * @param timeout_ms The maximum time to wait in milliseconds. A negative
+ *     value waits without a time limit.
+ * @param tag The tag of the query that posted the event.
+ * @param status The status of the query when its processing ended.
+ * @param has_event Set to `1` if an event was retrieved and `0` on timeout,
+ *     in which case `tag` and `status` are unchanged.
+ * @return `TILEDB_OK` upon success, and `TILEDB_ERR` upon error.
+ */
+TILEDB_EXPORT int32_t tiledb_completion_queue_wait(
+    tiledb_ctx_t* ctx,
+    tiledb_completion_queue_t* cq,
+    int64_t timeout_ms,
+    void** tag,
+    tiledb_query_status_t* status,
+    int32_t* has_event);
+
 /* ********************************* */
 /*               ARRAY               */
 /* ********************************* */
@@ -2857,6 +3239,64 @@ tiledb_array_reopen(tiledb_ctx_t* ctx, tiledb_array_t* array);
 TILEDB_EXPORT int32_t tiledb_array_reopen_at(
     tiledb_ctx_t* ctx, tiledb_array_t* array, uint64_t timestamp);
 
+/**
+ * Polls a TileDB array (the array must be already open) for updates. This
+ * reopens the array at the current time and retrieves the number of
+ * fragments that became visible since the array was last (re)opened. Only
+ * the metadata of these new fragments are loaded, which makes this function
+ * suitable for readers that frequently refresh their view of a growing
+ * array. The URIs of the new fragments can be retrieved with
+ * `tiledb_array_get_new_fragment_uri`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_array_t* array;
+ * tiledb_array_alloc(ctx, "hdfs:///tiledb_arrays/my_array", &array);
+ * tiledb_array_open(ctx, array, TILEDB_READ);
+ * uint32_t new_fragment_num;
+ * tiledb_array_poll(ctx, array, &new_fragment_num);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array The array object to be polled.
+ * @param new_fragment_num Set to the number of newly visible fragments.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ *
+ * @note This is applicable only to arrays opened for reads.
+ */
+TILEDB_EXPORT int32_t tiledb_array_poll(
+    tiledb_ctx_t* ctx, tiledb_array_t* array, uint32_t* new_fragment_num);
+
+/**
+ * Retrieves the URI of a fragment that became visible the last time the
+ * array was reopened or polled. The new fragments are sorted in ascending
+ * timestamp order.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint32_t new_fragment_num;
+ * tiledb_array_poll(ctx, array, &new_fragment_num);
+ * for (uint32_t i = 0; i < new_fragment_num; ++i) {
+ *   const char* fragment_uri;
+ *   tiledb_array_get_new_fragment_uri(ctx, array, i, &fragment_uri);
+ * }
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array The array object.
+ * @param idx The index of the new fragment.
+ * @param fragment_uri Set to the URI of the new fragment. The string is
+ *     valid as long as the array is not reopened or closed.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_array_get_new_fragment_uri(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    uint32_t idx,
+    const char** fragment_uri);
+
 /**
  * Returns the timestamp, representing time in milliseconds ellapsed since
  * 1970-01-01 00:00:00 +0000 (UTC), at which the array was opened. See also the
@@ -4938,6 +5378,61 @@ TILEDB_EXPORT int32_t tiledb_stats_dump_str(char** out);
  */
 TILEDB_EXPORT int32_t tiledb_stats_free_str(char** out);
 
+/**
+ * Enable tracing of the internal processing phases. While enabled, each call
+ * of an internal function timed by the statistics is recorded as an event
+ * holding its start time, duration, thread and query id. Each thread retains
+ * its most recent events only. Tracing requires a build with statistics
+ * (`TILEDB_STATS`), but not that statistics gathering is enabled.
+ *
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_stats_trace_enable();
+
+/**
+ * Disable tracing of the internal processing phases. The recorded events
+ * are kept until `tiledb_stats_trace_reset` is called.
+ *
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_stats_trace_disable();
+
+/**
+ * Discard all recorded trace events.
+ *
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_stats_trace_reset();
+
+/**
+ * Dump the recorded trace events to some output (e.g., file or stdout) in
+ * the Chrome trace event JSON format, which can be loaded in
+ * `chrome://tracing` or Perfetto.
+ *
+ * @param out The output.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_stats_trace_dump(FILE* out);
+
+/**
+ * Dump the recorded trace events to an output string in the Chrome trace
+ * event JSON format. The caller is responsible for freeing the resulting
+ * string with `tiledb_stats_free_str`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * char *trace_str;
+ * tiledb_stats_trace_dump_str(&trace_str);
+ * // ...
+ * tiledb_stats_free_str(&trace_str);
+ * @endcode
+ *
+ * @param out Will be set to point to an allocated string containing the trace.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_stats_trace_dump_str(char** out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -131,6 +131,10 @@
     TILEDB_FILTER_TYPE_ENUM(FILTER_BYTESHUFFLE) = 9,
     /** Positive-delta encoding filter. */
     TILEDB_FILTER_TYPE_ENUM(FILTER_POSITIVE_DELTA) = 10,
+    /** Adaptive filter, choosing the codec of each chunk from a sample. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_AUTO) = 12,
+    /** CRC32C checksum filter, verifying the integrity of each chunk. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_CHECKSUM_CRC32C) = 13,
 #endif
 
 #ifdef TILEDB_FILTER_OPTION_ENUM
@@ -140,6 +144,20 @@
     TILEDB_FILTER_OPTION_ENUM(BIT_WIDTH_MAX_WINDOW) = 1,
     /** Max window length for positive-delta encoding. Type: `uint32_t`. */
     TILEDB_FILTER_OPTION_ENUM(POSITIVE_DELTA_MAX_WINDOW) = 2,
+    /**
+     * Objective of the codec choice of the adaptive filter, one of
+     * `tiledb_auto_objective_t`. Type: `uint32_t`.
+     */
+    TILEDB_FILTER_OPTION_ENUM(AUTO_OBJECTIVE) = 3,
+#endif
+
+#ifdef TILEDB_AUTO_OBJECTIVE_ENUM
+    /** Choose the codec producing the smallest chunk. */
+    TILEDB_AUTO_OBJECTIVE_ENUM(AUTO_RATIO) = 0,
+    /** Trade off the chunk size against the decoding cost. */
+    TILEDB_AUTO_OBJECTIVE_ENUM(AUTO_BALANCED) = 1,
+    /** Favor the codecs that decode fastest. */
+    TILEDB_AUTO_OBJECTIVE_ENUM(AUTO_DECODE_SPEED) = 2,
 #endif
 
 #ifdef TILEDB_ENCRYPTION_TYPE_ENUM
@@ -0,0 +1,423 @@
+/**
+ * @file   disk_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class DiskCache.
+ */
+
+#include "tiledb/sm/cache/disk_cache.h"
+#include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/misc/thread_pool.h"
+#include "tiledb/sm/misc/uuid.h"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Identifies the files of the cache (and their format version). */
+const uint64_t entry_magic = 0x3165686361434454;  // "TDCache1"
+
+/** The name of the filelock in the cache directory. */
+const std::string lock_name = "__disk_cache.lock";
+
+/** The suffix of the cached range files. */
+const std::string entry_suffix = ".range";
+
+/** The suffix of the temporary files. */
+const std::string tmp_suffix = ".tmp";
+
+/** Temporary files older than this (in seconds) are left over by crashes. */
+const time_t tmp_max_age = 3600;
+
+/** Returns the 64-bit FNV-1a hash of the input string. */
+uint64_t fnv1a(const std::string& s) {
+  uint64_t h = 0xcbf29ce484222325;
+  for (unsigned char c : s) {
+    h ^= c;
+    h *= 0x100000001b3;
+  }
+  return h;
+}
+
+/** Returns the modification time of a file in nanoseconds. */
+uint64_t mtime_ns(const struct stat& s) {
+#if defined(_WIN32)
+  return (uint64_t)s.st_mtime * 1000000000;
+#elif defined(__APPLE__)
+  return (uint64_t)s.st_mtimespec.tv_sec * 1000000000 +
+         (uint64_t)s.st_mtimespec.tv_nsec;
+#else
+  return (uint64_t)s.st_mtim.tv_sec * 1000000000 + (uint64_t)s.st_mtim.tv_nsec;
+#endif
+}
+
+bool ends_with(const std::string& s, const std::string& suffix) {
+  return s.size() >= suffix.size() &&
+         s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+DiskCache::DiskCache()
+    : vfs_(nullptr)
+    , max_size_(0)
+    , size_(0)
+    , num_writes_(0)
+    , evicting_(false)
+    , shared_lock_(INVALID_FILELOCK)
+    , num_pending_writes_(0)
+    , pending_bytes_(0)
+    , tmp_counter_(0) {
+}
+
+DiskCache::~DiskCache() {
+  wait_writes();
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status DiskCache::init(VFS* vfs, const Config::DiskCacheParams& params) {
+  if (params.path_.empty())
+    return LOG_STATUS(
+        Status::VFSError("Cannot initialize disk cache; Empty path"));
+
+  vfs_ = vfs;
+  dir_ = URI(params.path_);
+  if (!dir_.is_file())
+    return LOG_STATUS(Status::VFSError(
+        "Cannot initialize disk cache; Path '" + params.path_ +
+        "' is not local"));
+  lock_uri_ = dir_.join_path(lock_name);
+  max_size_ = params.max_size_;
+
+  RETURN_NOT_OK(uuid::generate_uuid(&tmp_prefix_, false));
+
+  RETURN_NOT_OK(vfs_->create_dir(dir_));
+  RETURN_NOT_OK(vfs_->touch(lock_uri_));
+
+  // Compute the current size, trimming the cache if it has been shrunk.
+  return evict();
+}
+
+bool DiskCache::cacheable(const URI& uri) {
+  if (!uri.is_s3() && !uri.is_hdfs())
+    return false;
+
+  // Fragment files are ".tdb" files in a directory named "__<...>".
+  auto name = uri.last_path_part();
+  auto fragment = uri.parent().last_path_part();
+  return ends_with(name, constants::file_suffix) &&
+         name != constants::fragment_metadata_filename &&
+         fragment.compare(0, 2, "__") == 0;
+}
+
+Status DiskCache::read(
+    const URI& uri,
+    uint64_t offset,
+    void* buffer,
+    uint64_t nbytes,
+    bool* hit) {
+  *hit = false;
+
+  auto path = entry_path(uri, offset, nbytes);
+  auto header = entry_header(uri, offset, nbytes);
+  std::ifstream ifs(path, std::ios::in | std::ios::binary);
+  if (ifs.is_open()) {
+    // Check the header, guarding against hash collisions and partial files.
+    std::string file_header(header.size(), '\0');
+    ifs.read(&file_header[0], (std::streamsize)header.size());
+    if (ifs && file_header == header) {
+      ifs.read(static_cast<char*>(buffer), (std::streamsize)nbytes);
+      *hit = ifs.gcount() == (std::streamsize)nbytes;
+    }
+    ifs.close();
+  }
+
+  if (*hit) {
+    // Mark the range as recently used.
+    utime(path.c_str(), nullptr);
+    STATS_COUNTER_ADD(vfs_disk_cache_hits, 1);
+    STATS_COUNTER_ADD(vfs_disk_cache_hit_bytes, nbytes);
+  } else {
+    STATS_COUNTER_ADD(vfs_disk_cache_misses, 1);
+  }
+
+  return Status::Ok();
+}
+
+Status DiskCache::write(
+    const URI& uri, uint64_t offset, const void* buffer, uint64_t nbytes) {
+  auto header = entry_header(uri, offset, nbytes);
+  uint64_t entry_size = header.size() + nbytes;
+  if (entry_size > max_size_)
+    return Status::Ok();
+
+  // Write to a temporary file first, so that concurrent readers never see a
+  // partial range.
+  auto path = entry_path(uri, offset, nbytes);
+  std::stringstream tmp_path;
+  tmp_path << path << "." << tmp_prefix_ << "_" << tmp_counter_++
+           << tmp_suffix;
+  std::ofstream ofs(
+      tmp_path.str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open())
+    return LOG_STATUS(Status::VFSError(
+        "Cannot write to disk cache; Failed to create '" + tmp_path.str() +
+        "'"));
+  ofs.write(header.data(), (std::streamsize)header.size());
+  ofs.write(static_cast<const char*>(buffer), (std::streamsize)nbytes);
+  ofs.close();
+  if (!ofs) {
+    std::remove(tmp_path.str().c_str());
+    return LOG_STATUS(Status::VFSError(
+        "Cannot write to disk cache; Failed to write '" + tmp_path.str() +
+        "'"));
+  }
+
+  // Publish the range. Failing to rename is not an error, since another
+  // process may have just cached the same range (the rename does not replace
+  // an existing file on Windows).
+  RETURN_NOT_OK(lock_shared());
+  bool renamed = std::rename(tmp_path.str().c_str(), path.c_str()) == 0;
+  RETURN_NOT_OK(unlock_shared());
+  if (!renamed) {
+    std::remove(tmp_path.str().c_str());
+    return Status::Ok();
+  }
+
+  STATS_COUNTER_ADD(vfs_disk_cache_inserted_bytes, nbytes);
+  if ((size_ += entry_size) > max_size_)
+    return evict();
+
+  return Status::Ok();
+}
+
+void DiskCache::write_async(
+    ThreadPool* tp,
+    const URI& uri,
+    uint64_t offset,
+    const void* buffer,
+    uint64_t nbytes) {
+  if (tp == nullptr || tp->num_threads() == 0) {
+    write(uri, offset, buffer, nbytes);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lck(pending_mtx_);
+    if (pending_bytes_ + nbytes > max_size_)
+      return;
+    ++num_pending_writes_;
+    pending_bytes_ += nbytes;
+  }
+
+  // The write outlives the read, so it works on behalf of no query.
+  stats::ScopedQuery no_query(nullptr, 0);
+  auto data = std::make_shared<std::vector<char>>(
+      static_cast<const char*>(buffer),
+      static_cast<const char*>(buffer) + nbytes);
+  tp->enqueue(
+      [this, uri, offset, data]() {
+        Status st = write(uri, offset, data->data(), data->size());
+        finish_write(data->size());
+        return st;
+      },
+      [this, nbytes]() { finish_write(nbytes); },
+      ThreadPool::Priority::BACKGROUND);
+}
+
+void DiskCache::wait_writes() {
+  std::unique_lock<std::mutex> lck(pending_mtx_);
+  pending_cv_.wait(lck, [this]() { return num_pending_writes_ == 0; });
+}
+
+Status DiskCache::evict() {
+  std::unique_lock<std::mutex> evict_lck(evict_mtx_, std::try_to_lock);
+  if (!evict_lck.owns_lock())
+    return Status::Ok();
+
+  // Wait for the insertions of this process to release the shared filelock,
+  // holding off new ones.
+  {
+    std::unique_lock<std::mutex> lck(lock_mtx_);
+    evicting_ = true;
+    lock_cv_.wait(lck, [this]() { return num_writes_ == 0; });
+  }
+
+  filelock_t lock = INVALID_FILELOCK;
+  Status st = vfs_->filelock_lock(lock_uri_, &lock, false);
+  if (st.ok()) {
+    st = evict_entries();
+    auto unlock_st = vfs_->filelock_unlock(lock_uri_, lock);
+    if (st.ok())
+      st = unlock_st;
+  }
+
+  {
+    std::lock_guard<std::mutex> lck(lock_mtx_);
+    evicting_ = false;
+  }
+  lock_cv_.notify_all();
+
+  return st;
+}
+
+Status DiskCache::evict_entries() {
+  struct Entry {
+    std::string path;
+    uint64_t size;
+    uint64_t mtime;
+  };
+  std::vector<Entry> entries;
+  uint64_t total = 0;
+  std::vector<URI> uris;
+  Status st = vfs_->ls(dir_, &uris);
+  time_t now = time(nullptr);
+  for (const auto& u : uris) {
+    if (!st.ok())
+      break;
+    auto path = u.to_path();
+    struct stat s;
+    if (stat(path.c_str(), &s) != 0)
+      continue;
+    if (ends_with(path, entry_suffix)) {
+      entries.push_back({path, (uint64_t)s.st_size, mtime_ns(s)});
+      total += (uint64_t)s.st_size;
+    } else if (ends_with(path, tmp_suffix) && now - s.st_mtime > tmp_max_age) {
+      std::remove(path.c_str());
+    }
+  }
+
+  // Remove the least recently used ranges.
+  uint64_t low_watermark = max_size_ / 10 * 9;
+  if (st.ok() && total > max_size_) {
+    std::sort(
+        entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+          return a.mtime < b.mtime;
+        });
+    for (const auto& e : entries) {
+      if (total <= low_watermark)
+        break;
+      if (std::remove(e.path.c_str()) == 0) {
+        total -= e.size;
+        STATS_COUNTER_ADD(vfs_disk_cache_evicted_bytes, e.size);
+      }
+    }
+  }
+  size_ = total;
+
+  return st;
+}
+
+uint64_t DiskCache::size() const {
+  return size_;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+Status DiskCache::lock_shared() {
+  std::unique_lock<std::mutex> lck(lock_mtx_);
+  lock_cv_.wait(lck, [this]() { return !evicting_; });
+  if (num_writes_ == 0)
+    RETURN_NOT_OK(vfs_->filelock_lock(lock_uri_, &shared_lock_, true));
+  ++num_writes_;
+
+  return Status::Ok();
+}
+
+Status DiskCache::unlock_shared() {
+  Status st;
+  {
+    std::lock_guard<std::mutex> lck(lock_mtx_);
+    if (--num_writes_ == 0) {
+      st = vfs_->filelock_unlock(lock_uri_, shared_lock_);
+      shared_lock_ = INVALID_FILELOCK;
+    }
+  }
+  lock_cv_.notify_all();
+
+  return st;
+}
+
+void DiskCache::finish_write(uint64_t nbytes) {
+  {
+    std::lock_guard<std::mutex> lck(pending_mtx_);
+    --num_pending_writes_;
+    pending_bytes_ -= nbytes;
+  }
+  pending_cv_.notify_all();
+}
+
+std::string DiskCache::entry_path(
+    const URI& uri, uint64_t offset, uint64_t nbytes) const {
+  std::stringstream ss;
+  ss << dir_.to_path() << "/" << std::hex << fnv1a(uri.to_string())
+     << std::dec << "_" << offset << "_" << nbytes << entry_suffix;
+  return ss.str();
+}
+
+std::string DiskCache::entry_header(
+    const URI& uri, uint64_t offset, uint64_t nbytes) {
+  const auto& uri_str = uri.to_string();
+  uint64_t fields[4] = {entry_magic, offset, nbytes, uri_str.size()};
+  std::string header(reinterpret_cast<const char*>(fields), sizeof(fields));
+  header += uri_str;
+  return header;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,272 @@
+/**
+ * @file   disk_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class DiskCache.
+ */
+
+#ifndef TILEDB_DISK_CACHE_H
+#define TILEDB_DISK_CACHE_H
+
+#include "tiledb/sm/filesystem/filelock.h"
+#include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/misc/uri.h"
+#include "tiledb/sm/storage_manager/config.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+namespace tiledb {
+namespace sm {
+
+class ThreadPool;
+class VFS;
+
+/**
+ * A persistent cache of byte ranges of remote files, stored in a local
+ * directory. Each cached range is a file in the directory, named after a
+ * hash of the URI of the remote file and the range, and prefixed with a
+ * header identifying the range so that hash collisions are detected.
+ *
+ * Only ranges of fragment files are cached (see `cacheable()`): fragments
+ * are never modified after they are written, so cached ranges are never
+ * invalidated. The fragment metadata file is excluded: it is cached in memory
+ * by the storage manager, and it is the file that tells a reopened array
+ * which fragments consolidation has replaced.
+ *
+ * Misses are inserted by background tasks (see `write_async()`), so that
+ * reads do not wait for the local disk.
+ *
+ * The directory may be shared by concurrent processes. Ranges are written
+ * to temporary files which are then atomically renamed. Recency is tracked
+ * with the modification time of the files, which is updated upon every
+ * hit. When the total size of the files exceeds the maximum cache size, the
+ * least recently used files are removed under an exclusive filelock on the
+ * directory, while insertions take it shared.
+ *
+ * POSIX filelocks are held per process (and released by any thread closing
+ * the file), so the threads of a process also synchronize in memory: the
+ * concurrent insertions share a single filelock, taken by the first and
+ * released by the last, and an eviction waits for them to finish.
+ */
+class DiskCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  DiskCache();
+
+  /** Destructor. Waits for the pending asynchronous writes. */
+  ~DiskCache();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Initializes the cache, creating the cache directory if it does not exist.
+   *
+   * @param vfs The VFS used to manage the cache directory.
+   * @param params The cache parameters.
+   * @return Status
+   */
+  Status init(VFS* vfs, const Config::DiskCacheParams& params);
+
+  /**
+   * Returns `true` if reads from the input URI can be cached, i.e. if it is
+   * an `s3://` or `hdfs://` URI of a file in a fragment directory other than
+   * the fragment metadata file.
+   */
+  static bool cacheable(const URI& uri);
+
+  /**
+   * Reads a range of a remote file from the cache.
+   *
+   * @param uri The URI of the remote file.
+   * @param offset The offset of the range.
+   * @param buffer The buffer to read into.
+   * @param nbytes The size of the range.
+   * @param hit Set to `true` if the range was found in the cache. Errors
+   *     reading a cached range are treated as misses.
+   * @return Status
+   */
+  Status read(
+      const URI& uri,
+      uint64_t offset,
+      void* buffer,
+      uint64_t nbytes,
+      bool* hit);
+
+  /**
+   * Stores a range of a remote file in the cache, evicting the least recently
+   * used ranges if this brings the cache over its maximum size. Ranges larger
+   * than the maximum cache size are ignored.
+   *
+   * @param uri The URI of the remote file.
+   * @param offset The offset of the range.
+   * @param buffer The data of the range.
+   * @param nbytes The size of the range.
+   * @return Status
+   */
+  Status write(
+      const URI& uri, uint64_t offset, const void* buffer, uint64_t nbytes);
+
+  /**
+   * Copies a range of a remote file and stores it in the cache with a
+   * background task of the input thread pool (see `write()`), so that the
+   * caller does not wait for it. The range is stored synchronously if the
+   * pool has no threads, and not stored at all if the pending writes already
+   * hold more than the maximum cache size. Errors are only logged.
+   *
+   * @param tp The thread pool to write on.
+   * @param uri The URI of the remote file.
+   * @param offset The offset of the range.
+   * @param buffer The data of the range.
+   * @param nbytes The size of the range.
+   */
+  void write_async(
+      ThreadPool* tp,
+      const URI& uri,
+      uint64_t offset,
+      const void* buffer,
+      uint64_t nbytes);
+
+  /** Waits for the writes started with `write_async()` to finish. */
+  void wait_writes();
+
+  /**
+   * Removes the least recently used ranges until the cache is at most 90% of
+   * its maximum size (to avoid evicting upon every write once full), and
+   * updates `size()`. This is a noop if another thread of this process is
+   * already evicting.
+   *
+   * @return Status
+   */
+  Status evict();
+
+  /**
+   * Returns the size of the cache in bytes, as of the last eviction plus the
+   * writes of this process since.
+   */
+  uint64_t size() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The VFS used to manage the cache directory. */
+  VFS* vfs_;
+
+  /** The cache directory. */
+  URI dir_;
+
+  /** The filelock guarding evictions. */
+  URI lock_uri_;
+
+  /** The maximum cache size in bytes. */
+  uint64_t max_size_;
+
+  /** The (estimated) cache size in bytes. */
+  std::atomic<uint64_t> size_;
+
+  /** Serializes the evictions of this process. */
+  std::mutex evict_mtx_;
+
+  /** Protects `num_writes_`, `evicting_` and `shared_lock_`. */
+  std::mutex lock_mtx_;
+
+  /** Notified when an insertion or an eviction of this process ends. */
+  std::condition_variable lock_cv_;
+
+  /** The number of insertions of this process holding the shared filelock. */
+  uint64_t num_writes_;
+
+  /** Whether an eviction of this process holds or awaits the filelock. */
+  bool evicting_;
+
+  /** The shared filelock, held while `num_writes_ > 0`. */
+  filelock_t shared_lock_;
+
+  /** Protects `num_pending_writes_` and `pending_bytes_`. */
+  std::mutex pending_mtx_;
+
+  /** Notified when an asynchronous write finishes or is cancelled. */
+  std::condition_variable pending_cv_;
+
+  /** The number of asynchronous writes not finished yet. */
+  uint64_t num_pending_writes_;
+
+  /** The size of the data held by the pending asynchronous writes. */
+  uint64_t pending_bytes_;
+
+  /** A random prefix for the temporary files of this instance. */
+  std::string tmp_prefix_;
+
+  /** Counter making the temporary files of this instance unique. */
+  std::atomic<uint64_t> tmp_counter_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Acquires the filelock shared for an insertion, waiting for an eviction
+   * of this process to finish first.
+   */
+  Status lock_shared();
+
+  /** Releases the filelock acquired with `lock_shared()`. */
+  Status unlock_shared();
+
+  /** Marks an asynchronous write of `nbytes` bytes as finished. */
+  void finish_write(uint64_t nbytes);
+
+  /**
+   * Removes the least recently used ranges (see `evict()`). The filelock
+   * must be held exclusively.
+   */
+  Status evict_entries();
+
+  /** Returns the path of the file caching the given range. */
+  std::string entry_path(
+      const URI& uri, uint64_t offset, uint64_t nbytes) const;
+
+  /** Returns the header of the file caching the given range. */
+  static std::string entry_header(
+      const URI& uri, uint64_t offset, uint64_t nbytes);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_DISK_CACHE_H
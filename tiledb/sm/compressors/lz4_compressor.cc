@@ -31,7 +31,10 @@
  */
 
 #include <lz4.h>
+#include <lz4hc.h>
+#include <algorithm>
 #include <limits>
+#include <memory>
 
 #include "tiledb/sm/compressors/lz4_compressor.h"
 #include "tiledb/sm/misc/logger.h"
@@ -40,6 +43,27 @@
 namespace tiledb {
 namespace sm {
 
+#if LZ4_VERSION_NUMBER >= 10705
+namespace {
+
+/**
+ * The lz4 compression states of a thread, allocated on first use. The LZ4HC
+ * state is much larger, so it is only allocated if LZ4HC is used.
+ */
+struct LZ4States {
+  std::unique_ptr<char[]> state_;
+  std::unique_ptr<char[]> state_hc_;
+};
+
+/** Returns the lz4 compression states of the calling thread. */
+LZ4States& thread_states() {
+  static thread_local LZ4States states;
+  return states;
+}
+
+}  // namespace
+#endif
+
 Status LZ4::compress(
     int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
   STATS_FUNC_IN(compressor_lz4_compress);
@@ -49,17 +73,36 @@ Status LZ4::compress(
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with LZ4; invalid buffer format"));
 
-  // TODO: level is ignored using the simple api interface
-  (void)level;
 // Compress
 #if LZ4_VERSION_NUMBER >= 10705
-  int ret = LZ4_compress_default(
-      (char*)input_buffer->data(),
-      (char*)output_buffer->cur_data(),
-      (int)input_buffer->size(),
-      (int)output_buffer->free_space());
+  // Levels from LZ4HC_CLEVEL_MIN on compress with LZ4HC, which is slower to
+  // compress but decompresses just as fast
+  auto& states = thread_states();
+  int ret;
+  if (level >= LZ4HC_CLEVEL_MIN) {
+    if (states.state_hc_ == nullptr)
+      states.state_hc_.reset(new char[LZ4_sizeofStateHC()]);
+    ret = LZ4_compress_HC_extStateHC(
+        states.state_hc_.get(),
+        (char*)input_buffer->data(),
+        (char*)output_buffer->cur_data(),
+        (int)input_buffer->size(),
+        (int)output_buffer->free_space(),
+        std::min(level, LZ4HC_CLEVEL_MAX));
+  } else {
+    if (states.state_ == nullptr)
+      states.state_.reset(new char[LZ4_sizeofState()]);
+    ret = LZ4_compress_fast_extState(
+        states.state_.get(),
+        (char*)input_buffer->data(),
+        (char*)output_buffer->cur_data(),
+        (int)input_buffer->size(),
+        (int)output_buffer->free_space(),
+        1);
+  }
 #else
-  // deprecated lz4 api
+  // deprecated lz4 api, which ignores the level
+  (void)level;
   int ret = LZ4_compress(
       (char*)input_buffer->data(),
       (char*)output_buffer->cur_data(),
@@ -67,7 +110,7 @@ Status LZ4::compress(
 #endif
 
   // Check error
-  if (ret < 0)
+  if (ret <= 0)
     return Status::CompressionError("LZ4 compression failed");
 
   // Set size of compressed data
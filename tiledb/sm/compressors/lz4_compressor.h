@@ -41,13 +41,20 @@
 namespace tiledb {
 namespace sm {
 
-/** Handles compression/decompression with the lz4 library. */
+/**
+ * Handles compression/decompression with the lz4 library.
+ *
+ * Each thread reuses its own compression state, rather than initializing a
+ * new one for every (typically small) input.
+ */
 class LZ4 {
  public:
   /**
    * Compression function.
    *
-   * @param level Compression level.
+   * @param level Compression level. Levels from 3 (`LZ4HC_CLEVEL_MIN`) to 12
+   *     compress with LZ4HC, which compresses better and more slowly than the
+   *     default LZ4 compression used for lower levels.
    * @param input_buffer Input buffer to read from.
    * @param output_buffer Output buffer to write to the compressed data.
    * @return Status
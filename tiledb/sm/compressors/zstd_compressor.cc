@@ -27,21 +27,132 @@
  *
  * @section DESCRIPTION
  *
- * This file implements the zstd compressor class.
+ * This file implements the zstd compressor class and the zstd dictionary
+ * class.
  */
 
 #include "tiledb/sm/compressors/zstd_compressor.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/stats.h"
 
+// The dictionary ID functions are only in the experimental API before zstd 1.4
+#define ZSTD_STATIC_LINKING_ONLY
+#include <zdict.h>
 #include <zstd.h>
 #include <iostream>
 
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/** The zstd contexts of a thread, created on first use. */
+struct ZStdContexts {
+  ZSTD_CCtx* cctx_ = nullptr;
+  ZSTD_DCtx* dctx_ = nullptr;
+
+  ~ZStdContexts() {
+    ZSTD_freeCCtx(cctx_);
+    ZSTD_freeDCtx(dctx_);
+  }
+};
+
+/** Returns the zstd contexts of the calling thread. */
+ZStdContexts& thread_contexts() {
+  static thread_local ZStdContexts contexts;
+  return contexts;
+}
+
+}  // namespace
+
+/* ****************************** */
+/*         ZSTD DICTIONARY        */
+/* ****************************** */
+
+ZStdDictionary::ZStdDictionary(const void* data, uint64_t size)
+    : data_((const uint8_t*)data, (const uint8_t*)data + size) {
+  ddict_ = ZSTD_createDDict(data_.data(), data_.size());
+}
+
+ZStdDictionary::~ZStdDictionary() {
+  ZSTD_freeDDict(ddict_);
+  for (auto& cdict : cdicts_)
+    ZSTD_freeCDict(cdict.second);
+}
+
+Status ZStdDictionary::train(
+    const std::vector<uint8_t>& samples,
+    const std::vector<size_t>& sample_sizes,
+    uint64_t max_size,
+    std::shared_ptr<ZStdDictionary>* dict) {
+  dict->reset();
+  if (sample_sizes.empty() || max_size == 0)
+    return Status::Ok();
+
+  // Training fails if the samples are too few or too small to extract a
+  // useful dictionary from, in which case no dictionary is used
+  std::vector<uint8_t> buff(max_size);
+  auto ret = ZDICT_trainFromBuffer(
+      buff.data(),
+      buff.size(),
+      samples.data(),
+      sample_sizes.data(),
+      (unsigned)sample_sizes.size());
+  if (ZDICT_isError(ret))
+    return Status::Ok();
+
+  dict->reset(new ZStdDictionary(buff.data(), ret));
+  if ((*dict)->ddict() == nullptr) {
+    dict->reset();
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot train zstd dictionary; Creating dictionary failed"));
+  }
+
+  return Status::Ok();
+}
+
+const void* ZStdDictionary::data() const {
+  return data_.data();
+}
+
+uint64_t ZStdDictionary::size() const {
+  return data_.size();
+}
+
+unsigned ZStdDictionary::id() const {
+  return ZSTD_getDictID_fromDict(data_.data(), data_.size());
+}
+
+ZSTD_CDict_s* ZStdDictionary::cdict(int level) const {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto it = cdicts_.find(level);
+  if (it != cdicts_.end())
+    return it->second;
+
+  auto cdict = ZSTD_createCDict(data_.data(), data_.size(), level);
+  if (cdict != nullptr)
+    cdicts_[level] = cdict;
+  return cdict;
+}
+
+ZSTD_DDict_s* ZStdDictionary::ddict() const {
+  return ddict_;
+}
+
+/* ****************************** */
+/*              ZSTD              */
+/* ****************************** */
+
 Status ZStd::compress(
     int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  return compress(level, nullptr, input_buffer, output_buffer);
+}
+
+Status ZStd::compress(
+    int level,
+    const ZStdDictionary* dict,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) {
   STATS_FUNC_IN(compressor_zstd_compress);
 
   // Sanity check
@@ -49,13 +160,38 @@ Status ZStd::compress(
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with ZStd; invalid buffer format"));
 
+  // Get the compression context of this thread
+  auto& contexts = thread_contexts();
+  if (contexts.cctx_ == nullptr)
+    contexts.cctx_ = ZSTD_createCCtx();
+  if (contexts.cctx_ == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "ZStd compression failed; Cannot create compression context"));
+
   // Compress
-  uint64_t zstd_ret = ZSTD_compress(
-      output_buffer->cur_data(),
-      output_buffer->free_space(),
-      input_buffer->data(),
-      input_buffer->size(),
-      level < 0 ? ZStd::default_level() : level);
+  level = level < 0 ? ZStd::default_level() : level;
+  size_t zstd_ret;
+  if (dict != nullptr) {
+    auto cdict = dict->cdict(level);
+    if (cdict == nullptr)
+      return LOG_STATUS(Status::CompressionError(
+          "ZStd compression failed; Cannot load dictionary"));
+    zstd_ret = ZSTD_compress_usingCDict(
+        contexts.cctx_,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        cdict);
+  } else {
+    zstd_ret = ZSTD_compressCCtx(
+        contexts.cctx_,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        level);
+  }
 
   // Handle error
   if (ZSTD_isError(zstd_ret) != 0) {
@@ -75,6 +211,13 @@ Status ZStd::compress(
 
 Status ZStd::decompress(
     ConstBuffer* input_buffer, PreallocatedBuffer* output_buffer) {
+  return decompress(nullptr, input_buffer, output_buffer);
+}
+
+Status ZStd::decompress(
+    const ZStdDictionary* dict,
+    ConstBuffer* input_buffer,
+    PreallocatedBuffer* output_buffer) {
   STATS_FUNC_IN(compressor_zstd_decompress);
 
   // Sanity check
@@ -82,12 +225,37 @@ Status ZStd::decompress(
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with ZStd; invalid buffer format"));
 
-  // Decompress
-  uint64_t zstd_ret = ZSTD_decompress(
-      output_buffer->cur_data(),
-      output_buffer->free_space(),
-      input_buffer->data(),
-      input_buffer->size());
+  // Get the decompression context of this thread
+  auto& contexts = thread_contexts();
+  if (contexts.dctx_ == nullptr)
+    contexts.dctx_ = ZSTD_createDCtx();
+  if (contexts.dctx_ == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "ZStd decompression failed; Cannot create decompression context"));
+
+  // Decompress, using the dictionary only if the frame was compressed with it
+  size_t zstd_ret;
+  if (dict != nullptr &&
+      ZSTD_getDictID_fromFrame(input_buffer->data(), input_buffer->size()) ==
+          dict->id()) {
+    if (dict->ddict() == nullptr)
+      return LOG_STATUS(Status::CompressionError(
+          "ZStd decompression failed; Cannot load dictionary"));
+    zstd_ret = ZSTD_decompress_usingDDict(
+        contexts.dctx_,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        dict->ddict());
+  } else {
+    zstd_ret = ZSTD_decompressDCtx(
+        contexts.dctx_,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size());
+  }
 
   // Check error
   if (ZSTD_isError(zstd_ret) != 0) {
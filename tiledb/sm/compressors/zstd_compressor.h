@@ -27,7 +27,7 @@
  *
  * @section DESCRIPTION
  *
- * This file defines the zstd compressor class.
+ * This file defines the zstd compressor class and the zstd dictionary class.
  */
 
 #ifndef TILEDB_ZSTD_H
@@ -38,10 +38,97 @@
 #include "tiledb/sm/buffer/preallocated_buffer.h"
 #include "tiledb/sm/misc/status.h"
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 namespace tiledb {
 namespace sm {
 
-/** Handles compression/decompression with the zstd library. */
+/**
+ * A zstd dictionary, trained on samples of the data it compresses. Small
+ * inputs such as tile chunks compress considerably better with a dictionary,
+ * as they can reference the content and entropy tables of the dictionary
+ * instead of having to build their own.
+ *
+ * The dictionary is digested once for decompression, and once per compression
+ * level for compression, the first time it is used with that level. It is
+ * safe to use from multiple threads.
+ */
+class ZStdDictionary {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param data The serialized dictionary, as produced by `train`.
+   * @param size The size of the serialized dictionary.
+   */
+  ZStdDictionary(const void* data, uint64_t size);
+
+  /** Destructor. */
+  ~ZStdDictionary();
+
+  ZStdDictionary(const ZStdDictionary&) = delete;
+  ZStdDictionary& operator=(const ZStdDictionary&) = delete;
+
+  /**
+   * Trains a dictionary on the input samples.
+   *
+   * @param samples The samples, concatenated.
+   * @param sample_sizes The size of each sample.
+   * @param max_size The maximum size of the dictionary.
+   * @param dict Set to the trained dictionary, or to `nullptr` if there is
+   *     too little or too uniform sample data to train a dictionary from.
+   * @return Status
+   */
+  static Status train(
+      const std::vector<uint8_t>& samples,
+      const std::vector<size_t>& sample_sizes,
+      uint64_t max_size,
+      std::shared_ptr<ZStdDictionary>* dict);
+
+  /** Returns the serialized dictionary. */
+  const void* data() const;
+
+  /** Returns the size of the serialized dictionary. */
+  uint64_t size() const;
+
+  /** Returns the dictionary ID, which is recorded in the frames using it. */
+  unsigned id() const;
+
+  /**
+   * Returns the dictionary digested for compression with the input level,
+   * or `nullptr` on error.
+   */
+  ZSTD_CDict_s* cdict(int level) const;
+
+  /** Returns the dictionary digested for decompression, or `nullptr`. */
+  ZSTD_DDict_s* ddict() const;
+
+ private:
+  /** The serialized dictionary. */
+  std::vector<uint8_t> data_;
+
+  /** The dictionary digested for decompression. */
+  ZSTD_DDict_s* ddict_;
+
+  /** The dictionary digested for compression, per compression level. */
+  mutable std::map<int, ZSTD_CDict_s*> cdicts_;
+
+  /** Protects `cdicts_`. */
+  mutable std::mutex mtx_;
+};
+
+/**
+ * Handles compression/decompression with the zstd library.
+ *
+ * Each thread reuses its own compression and decompression contexts, rather
+ * than allocating new ones for every (typically small) input.
+ */
 class ZStd {
  public:
   /**
@@ -55,6 +142,22 @@ class ZStd {
   static Status compress(
       int level, ConstBuffer* input_buffer, Buffer* output_buffer);
 
+  /**
+   * Compression function using a dictionary.
+   *
+   * @param level Compression level.
+   * @param dict The dictionary to compress with. If `nullptr`, this is the
+   *     same as compressing without dictionary.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the compressed data.
+   * @return Status
+   */
+  static Status compress(
+      int level,
+      const ZStdDictionary* dict,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer);
+
   /**
    * Decompression function.
    *
@@ -65,6 +168,21 @@ class ZStd {
   static Status decompress(
       ConstBuffer* input_buffer, PreallocatedBuffer* output_buffer);
 
+  /**
+   * Decompression function using a dictionary. The dictionary is only used
+   * if the input was compressed with it, so data compressed without
+   * dictionary can be decompressed with this function as well.
+   *
+   * @param dict The dictionary the input may have been compressed with.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
+   * @return Status
+   */
+  static Status decompress(
+      const ZStdDictionary* dict,
+      ConstBuffer* input_buffer,
+      PreallocatedBuffer* output_buffer);
+
   /** Returns the default compression level. */
   static int default_level() {
     return 5;
@@ -556,6 +556,46 @@ class Array {
     schema_ = ArraySchema(ctx, array_schema);
   }
 
+  /**
+   * Polls the array for updates (the array must be already open). This
+   * reopens the array at the current time, loading only the metadata of
+   * the fragments that were written since the array was last (re)opened,
+   * and returns the URIs of these new fragments in ascending timestamp
+   * order.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * // Open the array for reading
+   * tiledb::Array array(ctx, "s3://bucket-name/array-name", TILEDB_READ);
+   * while (true) {
+   *   auto new_fragments = array.poll();
+   *   // Read the newly written data
+   * }
+   * @endcode
+   *
+   * @return The URIs of the newly visible fragments.
+   * @throws TileDBError if the array was not already open or other error
+   * occurred.
+   */
+  std::vector<std::string> poll() {
+    auto& ctx = ctx_.get();
+    uint32_t new_fragment_num;
+    ctx.handle_error(tiledb_array_poll(ctx, array_.get(), &new_fragment_num));
+    tiledb_array_schema_t* array_schema;
+    ctx.handle_error(tiledb_array_get_schema(ctx, array_.get(), &array_schema));
+    schema_ = ArraySchema(ctx, array_schema);
+
+    std::vector<std::string> new_fragments;
+    for (uint32_t i = 0; i < new_fragment_num; ++i) {
+      const char* fragment_uri;
+      ctx.handle_error(tiledb_array_get_new_fragment_uri(
+          ctx, array_.get(), i, &fragment_uri));
+      new_fragments.emplace_back(fragment_uri);
+    }
+
+    return new_fragments;
+  }
+
   /** Returns the timestamp at which the array was opened. */
   uint64_t timestamp() const {
     auto& ctx = ctx_.get();
@@ -0,0 +1,179 @@
+/**
+ * @file   completion_queue.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements the C++ API for the TileDB CompletionQueue object.
+ */
+
+#ifndef TILEDB_CPP_API_COMPLETION_QUEUE_H
+#define TILEDB_CPP_API_COMPLETION_QUEUE_H
+
+#include "context.h"
+#include "deleter.h"
+#include "tiledb.h"
+
+#include <functional>
+#include <memory>
+
+namespace tiledb {
+
+/**
+ * A queue of completion events of asynchronous queries. A query submitted
+ * with `Query::submit_async(CompletionQueue&, void*)` posts one event to
+ * the queue when its processing ends. Many queries may be outstanding on
+ * the same queue, and on POSIX systems the queue exposes a file descriptor
+ * that can be registered with an `epoll`/`poll` event loop.
+ *
+ * **Example:**
+ *
+ * @code{.cpp}
+ * tiledb::CompletionQueue cq(ctx);
+ * query_a.submit_async(cq, &query_a);
+ * query_b.submit_async(cq, &query_b);
+ * for (int i = 0; i < 2; ++i) {
+ *   auto event = cq.wait();
+ *   auto query = static_cast<tiledb::Query*>(event.tag);
+ *   ...
+ * }
+ * @endcode
+ *
+ * @note The queue must outlive the processing of the queries submitted to
+ *     it.
+ */
+class CompletionQueue {
+ public:
+  /** A completion event. */
+  struct Event {
+    /** The tag the query was submitted with. */
+    void* tag;
+    /** The status of the query when its processing ended. */
+    tiledb_query_status_t status;
+  };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructs a completion queue.
+   *
+   * @param ctx TileDB context
+   */
+  explicit CompletionQueue(const Context& ctx)
+      : ctx_(ctx) {
+    tiledb_completion_queue_t* cq;
+    ctx.handle_error(tiledb_completion_queue_alloc(ctx, &cq));
+    cq_ = std::shared_ptr<tiledb_completion_queue_t>(cq, deleter_);
+  }
+
+  CompletionQueue(const CompletionQueue&) = default;
+  CompletionQueue(CompletionQueue&&) = default;
+  CompletionQueue& operator=(const CompletionQueue&) = default;
+  CompletionQueue& operator=(CompletionQueue&&) = default;
+
+  /* ********************************* */
+  /*                 API               */
+  /* ********************************* */
+
+  /** Auxiliary operator for getting the underlying C TileDB object. */
+  operator tiledb_completion_queue_t*() const {
+    return cq_.get();
+  }
+
+  /** Returns a shared pointer to the C TileDB completion queue object. */
+  std::shared_ptr<tiledb_completion_queue_t> ptr() const {
+    return cq_;
+  }
+
+  /**
+   * Returns a file descriptor that is readable whenever the queue holds
+   * events, or -1 if the platform does not support it. The descriptor is
+   * owned by the queue and must not be read from or closed.
+   */
+  int32_t fd() const {
+    auto& ctx = ctx_.get();
+    int32_t fd;
+    ctx.handle_error(tiledb_completion_queue_get_fd(ctx, cq_.get(), &fd));
+    return fd;
+  }
+
+  /**
+   * Retrieves the oldest event of the queue without blocking.
+   *
+   * @param event The retrieved event.
+   * @return `true` if an event was retrieved, `false` if the queue is empty.
+   */
+  bool poll(Event* event) const {
+    auto& ctx = ctx_.get();
+    int32_t has_event;
+    ctx.handle_error(tiledb_completion_queue_poll(
+        ctx, cq_.get(), &event->tag, &event->status, &has_event));
+    return has_event != 0;
+  }
+
+  /**
+   * Retrieves the oldest event of the queue, waiting for one if the queue
+   * is empty.
+   *
+   * @param event The retrieved event.
+   * @param timeout_ms The maximum time to wait in milliseconds.
+   * @return `true` if an event was retrieved, `false` on timeout.
+   */
+  bool wait(Event* event, int64_t timeout_ms) const {
+    auto& ctx = ctx_.get();
+    int32_t has_event;
+    ctx.handle_error(tiledb_completion_queue_wait(
+        ctx, cq_.get(), timeout_ms, &event->tag, &event->status, &has_event));
+    return has_event != 0;
+  }
+
+  /** Retrieves the oldest event of the queue, waiting for one if needed. */
+  Event wait() const {
+    Event event;
+    wait(&event, -1);
+    return event;
+  }
+
+ private:
+  /* ********************************* */
+  /*          PRIVATE ATTRIBUTES       */
+  /* ********************************* */
+
+  /** The TileDB context. */
+  std::reference_wrapper<const Context> ctx_;
+
+  /** An auxiliary deleter. */
+  impl::Deleter deleter_;
+
+  /** The pointer to the C TileDB completion queue object. */
+  std::shared_ptr<tiledb_completion_queue_t> cq_;
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_CPP_API_COMPLETION_QUEUE_H
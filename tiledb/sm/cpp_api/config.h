@@ -245,6 +245,40 @@ class Config {
    * - `sm.tile_cache_size` <br>
    *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.zstd_dictionary_size` <br>
+   *    The maximum size in bytes of the zstd dictionary trained for each
+   *    attribute whose first filter is zstd compression, on the first tiles
+   *    written to a fragment, and stored in the fragment metadata. A
+   *    dictionary improves the compression of small tiles. No dictionaries
+   *    are trained if 0. <br>
+   *    **Default**: 0
+   * - `sm.verify_checksums` <br>
+   *    If `true`, the checksum filters verify the checksum of every tile
+   *    chunk they unfilter, and reads fail on a mismatch. Tiles found in the
+   *    tile cache were verified when first read, so they are not verified
+   *    again. If `false`, checksums are still written but not verified. <br>
+   *    **Default**: true
+   * - `sm.write_coalescing.max_bytes` <br>
+   *    If non-zero, unordered writes are not written as a fragment each, but
+   *    are buffered in memory per array and written together as a single
+   *    fragment once the buffered bytes of the array exceed this size, once
+   *    they are older than `sm.write_coalescing.max_age_ms`, when the array
+   *    is opened for reads in the same context, when
+   *    `Context::flush_writes` is called, or when the context is freed.
+   *    Buffered writes are lost if the process exits before they are flushed.
+   *    Cells written more than once while buffered keep their latest value.
+   *    Writes are not buffered if 0. <br>
+   *    **Default**: 0
+   * - `sm.write_coalescing.max_age_ms` <br>
+   *    The time in milliseconds after which buffered writes are flushed, if
+   *    `sm.write_coalescing.max_bytes` is non-zero. Buffered writes are only
+   *    flushed on the other events if 0. <br>
+   *    **Default**: 1000
+   * - `sm.read_partition_utilization` <br>
+   *    The fraction of the user buffers that each partition of an incomplete
+   *    read aims to fill, based on the estimated result size. Must be in
+   *    `(0, 1]`. <br>
+   *    **Default**: 1.0
    * - `sm.array_schema_cache_size` <br>
    *    Array schema cache size in bytes. Any `uint64_t` value is acceptable.
    * <br>
@@ -253,26 +287,45 @@ class Config {
    *    The fragment metadata cache size in bytes. Any `uint64_t` value is
    *    acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.generic_tile_prefetch_size` <br>
+   *    The number of bytes of a generic tile (e.g. the array schema or a
+   *    fragment metadata section) that are read speculatively in the same
+   *    request as its header, so that small generic tiles are read in a
+   *    single request. `0` reads the header and the tile separately. <br>
+   *    **Default**: 65536
+   * - `sm.buffer_pool_size` <br>
+   *    The maximum number of idle bytes kept by the pool that tile and
+   *    filter buffers allocate from. `0` disables pooling. <br>
+   *    **Default**: 50,000,000
    * - `sm.enable_signal_handlers` <br>
    *    Whether or not TileDB will install signal handlers. <br>
    *    **Default**: true
    * - `sm.num_async_threads` <br>
-   *    The number of threads allocated for async queries. <br>
+   *    Deprecated and ignored. Async queries run on the thread pool of the
+   *    context (see `sm.num_compute_threads`). <br>
    *    **Default**: 1
    * - `sm.num_reader_threads` <br>
-   *    The number of threads allocated for issuing reads to VFS in
-   *    parallel. <br>
+   *    Deprecated and ignored. Reads are issued on the thread pool of the
+   *    context (see `sm.num_compute_threads`). <br>
    *    **Default**: 1
    * - `sm.num_writer_threads` <br>
-   *    The number of threads allocated for issuing writes to VFS in
-   *    parallel.<br>
+   *    Deprecated and ignored. Writes are issued on the thread pool of the
+   *    context (see `sm.num_compute_threads`). <br>
+   *    **Default**: 1
+   * - `sm.num_compute_threads` <br>
+   *    The number of threads of the thread pool of the context, which runs all
+   *    its parallel work: async queries, the parallel I/O, loops and sorts of
+   *    the queries and the filter pipeline, and background consolidation. <br>
+   *    **Default**: number of cores
+   * - `sm.num_consolidation_threads` <br>
+   *    The maximum number of background consolidations running at a time on the
+   *    thread pool of the context (see `sm.consolidation.auto`).<br>
    *    **Default**: 1
    * - `sm.num_tbb_threads` <br>
-   *    The number of threads allocated for the TBB thread pool (if TBB is
-   *    enabled). Note: this is a whole-program setting. Usually this should not
-   *    be modified from the default. See also the documentation for TBB's
-   *    `task_scheduler_init` class.<br>
-   *    **Default**: TBB automatic
+   *    Deprecated and ignored. TileDB no longer uses TBB; all parallel work
+   *    runs on the thread pool of the context (see `sm.num_compute_threads`).
+   *    <br>
+   *    **Default**: -1
    * - `sm.consolidation.amplification` <br>
    *    The factor by which the size of the dense fragment resulting
    *    from consolidating a set of fragments (containing at least one
@@ -300,9 +353,28 @@ class Config {
    *    The size ratio that two ("adjacent") fragments must satisfy to be
    *    considered for consolidation in a single step.<br>
    *    **Default**: 0.0
+   * - `sm.consolidation.auto` <br>
+   *    If `true`, arrays written through this context are consolidated in
+   *    the background after writes, using the consolidation parameters
+   *    above.<br>
+   *    **Default**: false
+   * - `sm.consolidation.auto_interval_ms` <br>
+   *    The minimum time (in milliseconds) between two background
+   *    consolidation runs on the same array.<br>
+   *    **Default**: 1000
+   * - `sm.consolidation.auto_max_bytes` <br>
+   *    The maximum number of fragment bytes a single background
+   *    consolidation run may rewrite.<br>
+   *    **Default**: 1,000,000,000
+   * - `sm.consolidation.auto_write_amplification` <br>
+   *    The maximum ratio of bytes rewritten by background consolidation to
+   *    bytes written by queries, per array.<br>
+   *    **Default**: 4.0
    * - `vfs.num_threads` <br>
    *    The number of threads allocated for VFS operations (any backend), per
-   *    VFS instance. <br>
+   *    VFS instance created without a context, e.g., by `tiledb_vfs_alloc`. The
+   *    VFS of a context uses the thread pool of the context (see
+   *    `sm.num_compute_threads`). <br>
    *    **Default**: number of cores
    * - `vfs.min_parallel_size` <br>
    *    The minimum number of bytes in a parallel VFS operation
@@ -320,6 +392,29 @@ class Config {
    *    The maximum number of parallel operations on objects with `file:///`
    *    URIs. <br>
    *    **Default**: `vfs.num_threads`
+   * - `vfs.file.io_uring` <br>
+   *    If `true`, reads of objects with `file:///` URIs are submitted in
+   *    batches through Linux io_uring instead of blocking `pread` calls from
+   *    the VFS thread pool. Ignored (with the blocking path used instead) if
+   *    TileDB was built without io_uring support or the kernel does not
+   *    provide it. <br>
+   *    **Default**: false
+   * - `vfs.file.io_uring_depth` <br>
+   *    The maximum number of reads in flight on an io_uring instance, if
+   *    `vfs.file.io_uring` is `true`. <br>
+   *    **Default**: 32
+   * - `vfs.disk_cache.path` <br>
+   *    A local directory in which the fragment files (except the fragment
+   *    metadata) read from `s3://` and `hdfs://` URIs are cached, keyed on the
+   *    file URI and the byte range read. Fragment files are immutable, so
+   *    cached ranges never go stale. Missed ranges are cached by background
+   *    tasks, off the read path. The directory may be shared by concurrent
+   *    processes. The cache is disabled if empty. <br>
+   *    **Default**: ""
+   * - `vfs.disk_cache.max_size` <br>
+   *    The maximum size in bytes of the local disk cache, beyond which the
+   *    least recently used ranges are evicted. <br>
+   *    **Default**: 10737418240
    * - `vfs.s3.region` <br>
    *    The S3 region, if S3 is enabled. <br>
    *    **Default**: us-east-1
@@ -194,6 +194,41 @@ class Context {
     handle_error(tiledb_ctx_cancel_tasks(ctx_.get()));
   }
 
+  /**
+   * Writes the unordered writes buffered by this context (see the
+   * `sm.write_coalescing.max_bytes` config parameter) to their arrays.
+   * Once this returns, the buffered writes are durable.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * tiledb::Config config;
+   * config["sm.write_coalescing.max_bytes"] = "1048576";
+   * tiledb::Context ctx(config);
+   * // ... submit unordered writes ...
+   * ctx.flush_writes();
+   * @endcode
+   */
+  void flush_writes() const {
+    handle_error(tiledb_ctx_flush_writes(ctx_.get()));
+  }
+
+  /**
+   * Waits until the background consolidations of this context (see the
+   * `sm.consolidation.auto` config parameter) have completed.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * tiledb::Config config;
+   * config["sm.consolidation.auto"] = "true";
+   * tiledb::Context ctx(config);
+   * // ... write fragments ...
+   * ctx.wait_consolidations();
+   * @endcode
+   */
+  void wait_consolidations() const {
+    handle_error(tiledb_ctx_wait_consolidations(ctx_.get()));
+  }
+
   /* ********************************* */
   /*          STATIC FUNCTIONS         */
   /* ********************************* */
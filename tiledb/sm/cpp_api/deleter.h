@@ -122,6 +122,10 @@ class Deleter {
     tiledb_filter_list_free(&p);
   }
 
+  void operator()(tiledb_completion_queue_t* p) const {
+    tiledb_completion_queue_free(&p);
+  }
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
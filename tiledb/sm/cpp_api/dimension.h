@@ -38,6 +38,7 @@
 #include "context.h"
 #include "deleter.h"
 #include "exception.h"
+#include "filter_list.h"
 #include "object.h"
 #include "tiledb.h"
 #include "type.h"
@@ -271,6 +272,46 @@ class Dimension {
     return ss.str();
   }
 
+  /**
+   * Returns a copy of the FilterList of the dimension.
+   * To change the filter list, use `set_filter_list()`.
+   *
+   * @return Copy of the dimension FilterList.
+   */
+  FilterList filter_list() const {
+    auto& ctx = ctx_.get();
+    tiledb_filter_list_t* filter_list;
+    ctx.handle_error(
+        tiledb_dimension_get_filter_list(ctx, dim_.get(), &filter_list));
+    return FilterList(ctx, filter_list);
+  }
+
+  /**
+   * Sets the dimension filter list, which is an ordered list of filters that
+   * will be used to process and/or transform the coordinates of the
+   * dimension in sparse fragments. If not set, the coordinates filter list
+   * of the array schema is used. This must be called before the dimension
+   * is added to a domain.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * tiledb::FilterList filters(ctx);
+   * filters.add_filter({ctx, TILEDB_FILTER_DOUBLE_DELTA});
+   * auto dim = Dimension::create<int64_t>(ctx, "d", {{0, 1000}}, 100);
+   * dim.set_filter_list(filters);
+   * domain.add_dimension(dim);
+   * @endcode
+   *
+   * @param filter_list Filter list to set
+   * @return Reference to this Dimension
+   */
+  Dimension& set_filter_list(const FilterList& filter_list) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(
+        tiledb_dimension_set_filter_list(ctx, dim_.get(), filter_list));
+    return *this;
+  }
+
   /** Returns a shared pointer to the C TileDB dimension object. */
   std::shared_ptr<tiledb_dimension_t> ptr() const {
     return dim_;
@@ -268,6 +268,10 @@ class Filter {
         return "BYTESHUFFLE";
       case TILEDB_FILTER_POSITIVE_DELTA:
         return "POSITIVE_DELTA";
+      case TILEDB_FILTER_AUTO:
+        return "AUTO";
+      case TILEDB_FILTER_CHECKSUM_CRC32C:
+        return "CHECKSUM_CRC32C";
     }
     return "";
   }
@@ -303,6 +307,7 @@ class Filter {
         break;
       case TILEDB_BIT_WIDTH_MAX_WINDOW:
       case TILEDB_POSITIVE_DELTA_MAX_WINDOW:
+      case TILEDB_AUTO_OBJECTIVE:
         if (!std::is_same<uint32_t, T>::value)
           throw std::invalid_argument("Option value must be uint32_t.");
         break;
@@ -37,6 +37,7 @@
 
 #include "array.h"
 #include "array_schema.h"
+#include "completion_queue.h"
 #include "context.h"
 #include "core_interface.h"
 #include "deleter.h"
@@ -186,6 +187,17 @@ class Query {
     return query_type;
   }
 
+  /**
+   * Returns the id of the query, which identifies it in the events dumped by
+   * `Stats::trace_dump()`.
+   */
+  uint64_t id() const {
+    auto& ctx = ctx_.get();
+    uint64_t id;
+    ctx.handle_error(tiledb_query_get_id(ctx, query_.get(), &id));
+    return id;
+  }
+
   /**
    * Sets the layout of the cells to be written or read.
    *
@@ -297,6 +309,51 @@ class Query {
     submit_async([]() {});
   }
 
+  /**
+   * Returns the stats gathered while processing the query as a JSON string.
+   * Stats are gathered only while they are enabled with `Stats::enable()`.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * tiledb::Stats::enable();
+   * query.submit();
+   * std::cout << query.stats() << "\n";
+   * @endcode
+   */
+  std::string stats() const {
+    auto& ctx = ctx_.get();
+    char* stats_json;
+    ctx.handle_error(tiledb_query_get_stats(ctx, query_.get(), &stats_json));
+    std::string str(stats_json);
+    tiledb_stats_free_str(&stats_json);
+    return str;
+  }
+
+  /**
+   * Submit an async query, posting an event with the input tag to the
+   * input completion queue once its processing ends. Call returns
+   * immediately.
+   *
+   * @note Same notes apply as `Query::submit()`. See also
+   *     `tiledb_query_submit_async_cq` for how many async queries are
+   *     processed at a time.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * tiledb::CompletionQueue cq(ctx);
+   * query.submit_async(cq, &query);
+   * auto event = cq.wait();
+   * @endcode
+   *
+   * @param cq The completion queue.
+   * @param tag A user tag identifying the query in the completion event.
+   */
+  void submit_async(const CompletionQueue& cq, void* tag) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(
+        tiledb_query_submit_async_cq(ctx, query_.get(), cq, tag));
+  }
+
   /**
    * Flushes all internal state of a query object and finalizes the query.
    * This is applicable only to global layout writes. It has no effect for
@@ -90,6 +90,57 @@ class Stats {
     check_error(tiledb_stats_free_str(&c_str), "error freeing stats string");
   }
 
+  /**
+   * Enables tracing of the internal processing phases, recording the calls
+   * of the functions timed by the statistics as trace events.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * tiledb::Stats::trace_enable();
+   * query.submit();
+   * tiledb::Stats::trace_disable();
+   * FILE* f = fopen("trace.json", "w");
+   * tiledb::Stats::trace_dump(f);  // Load in chrome://tracing or Perfetto
+   * fclose(f);
+   * @endcode
+   */
+  static void trace_enable() {
+    check_error(tiledb_stats_trace_enable(), "error enabling tracing");
+  }
+
+  /** Disables tracing of the internal processing phases. */
+  static void trace_disable() {
+    check_error(tiledb_stats_trace_disable(), "error disabling tracing");
+  }
+
+  /** Discards all recorded trace events. */
+  static void trace_reset() {
+    check_error(tiledb_stats_trace_reset(), "error resetting trace");
+  }
+
+  /**
+   * Dump the recorded trace events in the Chrome trace event JSON format to
+   * some output (e.g., file or stdout).
+   *
+   * @param out The output.
+   */
+  static void trace_dump(FILE* out = stdout) {
+    check_error(tiledb_stats_trace_dump(out), "error dumping trace");
+  }
+
+  /**
+   * Dump the recorded trace events in the Chrome trace event JSON format to
+   * a string.
+   *
+   * @param out The output.
+   */
+  static void trace_dump(std::string* out) {
+    char* c_str = nullptr;
+    check_error(tiledb_stats_trace_dump_str(&c_str), "error dumping trace");
+    *out = std::string(c_str);
+    check_error(tiledb_stats_free_str(&c_str), "error freeing trace string");
+  }
+
  private:
   /**
    * Checks the return code for TILEDB_OK and throws an exception if not.
@@ -1,5 +1,5 @@
 /**
- * @file   tbb_state.h
+ * @file auto_objective.h
  *
  * @section LICENSE
  *
@@ -27,31 +27,26 @@
  *
  * @section DESCRIPTION
  *
- This file declares the Intel TBB threading scheduler state, if TileDB is built
- with Intel TBB.
+ * This defines the TileDB AutoObjective enum that maps to
+ * tiledb_auto_objective_t C-API enum.
  */
 
-#ifndef TILEDB_TBB_STATE_H
-#define TILEDB_TBB_STATE_H
+#ifndef TILEDB_AUTO_OBJECTIVE_H
+#define TILEDB_AUTO_OBJECTIVE_H
 
-#include "tiledb/sm/misc/status.h"
-#include "tiledb/sm/storage_manager/config.h"
+#include <cstdint>
 
 namespace tiledb {
 namespace sm {
-namespace global_state {
 
-/**
- * Initializes the Intel TBB thread runtime scheduler with a specified number of
- * threads
- *
- * @param config TileDB Config object pointer (or nullptr)
- * @return Status
- */
-Status init_tbb(Config* config);
+/** Defines the objective of the codec choice of the adaptive filter. */
+enum class AutoObjective : uint8_t {
+#define TILEDB_AUTO_OBJECTIVE_ENUM(id) id
+#include "tiledb/sm/c_api/tiledb_enum.h"
+#undef TILEDB_AUTO_OBJECTIVE_ENUM
+};
 
-}  // namespace global_state
 }  // namespace sm
 }  // namespace tiledb
 
-#endif
+#endif  // TILEDB_AUTO_OBJECTIVE_H
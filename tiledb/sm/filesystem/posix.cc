@@ -44,12 +44,18 @@
 
 #include <ftw.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
 namespace tiledb {
 namespace sm {
 
+Posix::Posix()
+    : vfs_thread_pool_(nullptr)
+    , io_uring_enabled_(false) {
+}
+
 bool Posix::both_slashes(char a, char b) {
   return a == '/' && b == '/';
 }
@@ -266,9 +272,34 @@ Status Posix::init(
   vfs_params_ = vfs_params;
   vfs_thread_pool_ = vfs_thread_pool;
 
+  io_uring_enabled_ = false;
+#ifdef HAVE_IO_URING
+  {
+    std::unique_lock<std::mutex> lck(uring_mtx_);
+    idle_urings_.clear();
+  }
+  if (vfs_params.file_params_.io_uring_) {
+    // Probe for kernel support, falling back to blocking reads if missing.
+    std::unique_ptr<Uring> uring;
+    Status st = acquire_uring(&uring);
+    if (st.ok()) {
+      release_uring(std::move(uring));
+      io_uring_enabled_ = true;
+    } else {
+      LOG_ERROR(
+          "io_uring is unavailable, falling back to blocking reads; " +
+          st.message());
+    }
+  }
+#endif
+
   return Status::Ok();
 }
 
+bool Posix::io_uring_enabled() const {
+  return io_uring_enabled_;
+}
+
 bool Posix::is_dir(const std::string& path) const {
   struct stat st;
   memset(&st, 0, sizeof(struct stat));
@@ -393,11 +424,34 @@ Status Posix::read(
         std::string("Cannot read from file ' ") + path.c_str() +
         "'; nbytes > SSIZE_MAX"));
   }
-  uint64_t bytes_read = read_all(fd, buffer, nbytes, offset);
-  if (bytes_read != nbytes) {
-    return LOG_STATUS(Status::IOError(
-        std::string("Cannot read from file '") + path.c_str() +
-        "'; File reading error"));
+  if (io_uring_enabled_) {
+    // Split large reads as VFS::read() does over threads, but submit the
+    // parts together instead.
+    uint64_t num_ops = std::min(
+        std::max(nbytes / vfs_params_.min_parallel_size_, uint64_t(1)),
+        vfs_params_.file_params_.max_parallel_ops_);
+    uint64_t op_nbytes = utils::math::ceil(nbytes, num_ops);
+    std::vector<ReadRequest> reads;
+    for (uint64_t begin = 0; begin < nbytes; begin += op_nbytes) {
+      uint64_t end = std::min(begin + op_nbytes, nbytes);
+      reads.push_back(ReadRequest{offset + begin,
+                                  end - begin,
+                                  static_cast<char*>(buffer) + begin});
+    }
+    Status st = uring_read(fd, reads, nullptr);
+    if (!st.ok()) {
+      close(fd);
+      return LOG_STATUS(Status::IOError(
+          std::string("Cannot read from file '") + path.c_str() + "'; " +
+          st.message()));
+    }
+  } else {
+    uint64_t bytes_read = read_all(fd, buffer, nbytes, offset);
+    if (bytes_read != nbytes) {
+      return LOG_STATUS(Status::IOError(
+          std::string("Cannot read from file '") + path.c_str() +
+          "'; File reading error"));
+    }
   }
   // Close file
   if (close(fd)) {
@@ -407,6 +461,56 @@ Status Posix::read(
   return Status::Ok();
 }
 
+Status Posix::read_batched(
+    const std::string& path,
+    const std::vector<ReadRequest>& reads,
+    const std::function<Status(uint64_t, const char*)>& consume) const {
+  // Checks
+  uint64_t file_size;
+  RETURN_NOT_OK(this->file_size(path, &file_size));
+  for (const auto& r : reads) {
+    if (r.offset + r.nbytes > file_size)
+      return LOG_STATUS(
+          Status::IOError("Cannot read from file; Read exceeds file size"));
+  }
+
+  // Open file
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot read from file; ") + strerror(errno)));
+  }
+
+  Status st;
+  if (io_uring_enabled_) {
+    st = uring_read(fd, reads, consume);
+  } else {
+    std::vector<char> temp;
+    for (uint64_t i = 0; i < reads.size() && st.ok(); i++) {
+      const auto& r = reads[i];
+      char* data = r.dest;
+      if (data == nullptr) {
+        temp.resize(r.nbytes);
+        data = temp.data();
+      }
+      if (read_all(fd, data, r.nbytes, r.offset) != r.nbytes)
+        st = Status::IOError("File reading error");
+      else if (consume != nullptr)
+        st = consume(i, data);
+    }
+  }
+
+  // Close file
+  if (close(fd) && st.ok())
+    st = Status::IOError(strerror(errno));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot read from file '") + path.c_str() + "'; " +
+        st.message()));
+  }
+  return Status::Ok();
+}
+
 Status Posix::sync(const std::string& path) {
   // Open file
   int fd = -1;
@@ -535,6 +639,185 @@ Status Posix::write_at(
   return Status::Ok();
 }
 
+#ifdef HAVE_IO_URING
+
+namespace {
+/** The maximum number of bytes of a single io_uring read. */
+const uint64_t max_uring_read_bytes = 1ull << 30;
+}  // namespace
+
+Status Posix::acquire_uring(std::unique_ptr<Uring>* uring) const {
+  {
+    std::unique_lock<std::mutex> lck(uring_mtx_);
+    if (!idle_urings_.empty()) {
+      *uring = std::move(idle_urings_.back());
+      idle_urings_.pop_back();
+      return Status::Ok();
+    }
+  }
+
+  std::unique_ptr<Uring> new_uring(new (std::nothrow) Uring());
+  if (new_uring == nullptr)
+    return LOG_STATUS(Status::VFSError("Could not allocate io_uring"));
+  RETURN_NOT_OK(new_uring->init(
+      (unsigned)vfs_params_.file_params_.io_uring_depth_,
+      constants::vfs_file_io_uring_buffer_size));
+  *uring = std::move(new_uring);
+
+  return Status::Ok();
+}
+
+void Posix::release_uring(std::unique_ptr<Uring> uring) const {
+  std::unique_lock<std::mutex> lck(uring_mtx_);
+  idle_urings_.push_back(std::move(uring));
+}
+
+Status Posix::uring_read(
+    int fd,
+    const std::vector<ReadRequest>& reads,
+    const std::function<Status(uint64_t, const char*)>& consume) const {
+  std::unique_ptr<Uring> uring;
+  RETURN_NOT_OK(acquire_uring(&uring));
+
+  // The state of the read occupying each submission queue slot. The slot
+  // index is the user data of the read, and the index of the registered
+  // buffer it may use.
+  struct Slot {
+    uint64_t read;
+    uint64_t done;
+    char* data;
+    int buffer_index;
+    std::unique_ptr<char[]> temp;
+  };
+  std::vector<Slot> slots(uring->entries());
+  std::vector<unsigned> free_slots;
+  for (unsigned i = uring->entries(); i > 0; i--)
+    free_slots.push_back(i - 1);
+
+  // Queues the (rest of the) read occupying the given slot.
+  unsigned in_flight = 0;
+  auto prep = [&](unsigned s) {
+    Slot& slot = slots[s];
+    const ReadRequest& r = reads[slot.read];
+    uint64_t nbytes = std::min(r.nbytes - slot.done, max_uring_read_bytes);
+    uring->prep_read(
+        fd,
+        slot.data + slot.done,
+        (uint32_t)nbytes,
+        r.offset + slot.done,
+        slot.buffer_index,
+        s);
+    in_flight++;
+    STATS_COUNTER_ADD(vfs_posix_io_uring_num_reads, 1);
+  };
+
+  Status st;
+  uint64_t next = 0;
+  uint64_t temp_bytes = 0;
+  for (;;) {
+    // Queue new reads while there are free slots. Reads without destination
+    // go to the registered buffer of their slot if they fit, otherwise to a
+    // temporary buffer, the total size of which is bounded by the maximum
+    // batch read size (as VFS::read_all() would use one buffer per batch).
+    while (st.ok() && next < reads.size() && !free_slots.empty()) {
+      const ReadRequest& r = reads[next];
+      unsigned s = free_slots.back();
+      Slot& slot = slots[s];
+      slot.buffer_index = -1;
+      if (r.dest != nullptr) {
+        slot.data = r.dest;
+      } else if (s < uring->num_buffers() && r.nbytes <= uring->buffer_size()) {
+        slot.data = uring->buffer(s);
+        slot.buffer_index = (int)s;
+      } else {
+        if (temp_bytes > 0 &&
+            temp_bytes + r.nbytes > vfs_params_.max_batch_read_size_)
+          break;
+        slot.temp.reset(new (std::nothrow) char[r.nbytes]);
+        if (slot.temp == nullptr) {
+          st = Status::VFSError("Could not allocate io_uring read buffer");
+          break;
+        }
+        slot.data = slot.temp.get();
+        temp_bytes += r.nbytes;
+      }
+      slot.read = next++;
+      slot.done = 0;
+      free_slots.pop_back();
+      prep(s);
+    }
+    if (in_flight == 0)
+      break;
+
+    // Submit the queued reads and wait for at least one completion. On
+    // error, wait for the reads in flight before their destinations are
+    // freed, and discard the ring rather than return it to the pool. If
+    // even waiting fails, leak the temporary buffers the kernel may still
+    // write into.
+    Status submit_st = uring->submit_and_wait(1);
+    STATS_COUNTER_ADD(vfs_posix_io_uring_num_submissions, 1);
+    if (!submit_st.ok()) {
+      Status drain_st = uring->drain();
+      if (!drain_st.ok()) {
+        LOG_STATUS(drain_st);
+        for (auto& slot : slots)
+          slot.temp.release();
+        uring.release();
+      }
+      uring.reset();
+      return LOG_STATUS(submit_st);
+    }
+
+    // Reap the completions, resubmitting short reads.
+    uint64_t user_data;
+    int32_t res;
+    while (uring->pop_completion(&user_data, &res)) {
+      in_flight--;
+      auto s = (unsigned)user_data;
+      Slot& slot = slots[s];
+      const ReadRequest& r = reads[slot.read];
+      if (res > 0) {
+        slot.done += (uint64_t)res;
+      } else if (st.ok() && res < 0) {
+        st = Status::IOError(
+            std::string("POSIX io_uring read error: ") + strerror(-res));
+      } else if (st.ok() && slot.done < r.nbytes) {
+        st = Status::IOError("POSIX io_uring read error: Unexpected EOF");
+      }
+      if (st.ok() && slot.done < r.nbytes) {
+        prep(s);
+        continue;
+      }
+      if (st.ok() && consume != nullptr)
+        st = consume(slot.read, slot.data);
+      if (slot.temp != nullptr) {
+        temp_bytes -= r.nbytes;
+        slot.temp.reset();
+      }
+      free_slots.push_back(s);
+    }
+  }
+
+  release_uring(std::move(uring));
+
+  return st;
+}
+
+#else
+
+Status Posix::uring_read(
+    int fd,
+    const std::vector<ReadRequest>& reads,
+    const std::function<Status(uint64_t, const char*)>& consume) const {
+  (void)fd;
+  (void)reads;
+  (void)consume;
+  return LOG_STATUS(
+      Status::VFSError("TileDB was built without io_uring support"));
+}
+
+#endif
+
 }  // namespace sm
 }  // namespace tiledb
 
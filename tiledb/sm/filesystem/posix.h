@@ -38,11 +38,15 @@
 #include <ftw.h>
 #include <sys/types.h>
 
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/filesystem/filelock.h"
+#include "tiledb/sm/filesystem/uring.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/misc/thread_pool.h"
 #include "tiledb/sm/misc/uri.h"
@@ -56,6 +60,22 @@ namespace sm {
  */
 class Posix {
  public:
+  /** A region of a file read by `read_batched()`. */
+  struct ReadRequest {
+    /** The file offset of the region. */
+    uint64_t offset;
+    /** The size of the region. */
+    uint64_t nbytes;
+    /**
+     * The destination of the region, or `nullptr` to read into a temporary
+     * buffer owned by `read_batched()`.
+     */
+    char* dest;
+  };
+
+  /** Constructor. */
+  Posix();
+
   /**
    * Returns the absolute posix (string) path of the input in the
    * form "file://<absolute path>"
@@ -143,6 +163,13 @@ class Posix {
    */
   Status init(const Config::VFSParams& vfs_params, ThreadPool* vfs_thread_pool);
 
+  /**
+   * Returns `true` if reads are issued through io_uring, i.e. if
+   * `vfs.file.io_uring` is set and io_uring is supported by both the build
+   * and the running kernel.
+   */
+  bool io_uring_enabled() const;
+
   /**
    * Checks if the input is an existing directory.
    *
@@ -193,6 +220,25 @@ class Posix {
       void* buffer,
       uint64_t nbytes) const;
 
+  /**
+   * Reads a number of regions of a file. If io_uring is enabled, the reads
+   * are all submitted up front (up to the configured depth in flight) and
+   * `consume` is invoked on each region as soon as its completion is
+   * reaped, i.e. in completion rather than submission order. Otherwise the
+   * regions are read one after the other.
+   *
+   * @param path The name of the file.
+   * @param reads The regions to read.
+   * @param consume If not `nullptr`, invoked with the index of each region
+   *     in `reads` and its data once it has been read. If the region has no
+   *     destination, the data is only valid for the duration of the call.
+   * @return Status
+   */
+  Status read_batched(
+      const std::string& path,
+      const std::vector<ReadRequest>& reads,
+      const std::function<Status(uint64_t, const char*)>& consume) const;
+
   /**
    * Syncs a file or directory.
    *
@@ -222,6 +268,38 @@ class Posix {
   /** Thread pool from parent VFS instance. */
   ThreadPool* vfs_thread_pool_;
 
+  /** Whether reads are issued through io_uring. */
+  bool io_uring_enabled_;
+
+  /** Protects `idle_urings_`. */
+  mutable std::mutex uring_mtx_;
+
+  /**
+   * The io_uring instances not currently used by a read. An instance is
+   * used by a single read at a time, and is created on demand.
+   */
+  mutable std::vector<std::unique_ptr<Uring>> idle_urings_;
+
+  /** Takes an idle io_uring instance from the pool, creating one if none. */
+  Status acquire_uring(std::unique_ptr<Uring>* uring) const;
+
+  /** Returns an io_uring instance to the pool. */
+  void release_uring(std::unique_ptr<Uring> uring) const;
+
+  /**
+   * Reads the given regions of an open file through io_uring. See
+   * `read_batched()` for the semantics of `consume`.
+   *
+   * @param fd The open file descriptor to read from.
+   * @param reads The regions to read.
+   * @param consume Callback invoked on each region once it has been read.
+   * @return Status
+   */
+  Status uring_read(
+      int fd,
+      const std::vector<ReadRequest>& reads,
+      const std::function<Status(uint64_t, const char*)>& consume) const;
+
   static void adjacent_slashes_dedup(std::string* path);
 
   static bool both_slashes(char a, char b);
@@ -524,6 +524,22 @@ Status S3::object_size(const URI& uri, uint64_t* nbytes) const {
 
 Status S3::read(
     const URI& uri, off_t offset, void* buffer, uint64_t length) const {
+  uint64_t length_read;
+  RETURN_NOT_OK(read(uri, offset, buffer, length, &length_read));
+  if (length_read != length) {
+    return LOG_STATUS(Status::S3Error(
+        std::string("Read operation returned different size of bytes.")));
+  }
+
+  return Status::Ok();
+}
+
+Status S3::read(
+    const URI& uri,
+    off_t offset,
+    void* buffer,
+    uint64_t length,
+    uint64_t* length_read) const {
   RETURN_NOT_OK(init_client());
 
   if (!uri.is_s3()) {
@@ -531,6 +547,8 @@ Status S3::read(
         std::string("URI is not an S3 URI: " + uri.to_string())));
   }
 
+  // A range extending past the end of the object returns the bytes up to
+  // the end of the object
   Aws::Http::URI aws_uri = uri.c_str();
   Aws::S3::Model::GetObjectRequest get_object_request;
   get_object_request.WithBucket(aws_uri.GetAuthority())
@@ -550,7 +568,8 @@ Status S3::read(
         std::string("Failed to read S3 object ") + uri.c_str() +
         outcome_error_message(get_object_outcome)));
   }
-  if ((uint64_t)get_object_outcome.GetResult().GetContentLength() != length) {
+  *length_read = (uint64_t)get_object_outcome.GetResult().GetContentLength();
+  if (*length_read > length) {
     return LOG_STATUS(Status::S3Error(
         std::string("Read operation returned different size of bytes.")));
   }
@@ -998,6 +1017,10 @@ Status S3::get_make_upload_part_req(
     const URI& uri, const std::string& uri_path, MakeUploadPartCtx& ctx) {
   RETURN_NOT_OK(init_client());
 
+  // The request runs on the VFS thread pool (see `S3ThreadPoolExecutor`),
+  // hence wait by executing pending tasks, so that requests awaited by all
+  // the threads of the pool still get to run
+  vfs_thread_pool_->wait(ctx.upload_part_outcome_callable);
   auto upload_part_outcome = ctx.upload_part_outcome_callable.get();
   bool success = upload_part_outcome.IsSuccess();
 
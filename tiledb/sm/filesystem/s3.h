@@ -239,6 +239,25 @@ class S3 {
   Status read(
       const URI& uri, off_t offset, void* buffer, uint64_t length) const;
 
+  /**
+   * Same as `read`, but the read may end early at the end of the object,
+   * in which case fewer than `length` bytes are read. The offset must be
+   * within the object.
+   *
+   * @param uri The URI of the object to be read.
+   * @param offset The offset in the object from which the read will start.
+   * @param buffer The buffer into which the data will be written.
+   * @param length The maximum size of the data to be read from the object.
+   * @param length_read Set to the size of the data that was read.
+   * @return Status
+   */
+  Status read(
+      const URI& uri,
+      off_t offset,
+      void* buffer,
+      uint64_t length,
+      uint64_t* length_read) const;
+
   /**
    * Deletes a bucket.
    *
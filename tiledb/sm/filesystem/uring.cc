@@ -0,0 +1,371 @@
+/**
+ * @file   uring.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class Uring.
+ */
+
+#include "tiledb/sm/filesystem/uring.h"
+
+#ifdef HAVE_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+int sys_io_uring_setup(unsigned entries, struct io_uring_params* p) {
+  return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+int sys_io_uring_enter(
+    int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return (int)syscall(
+      __NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+}
+
+int sys_io_uring_register(
+    int fd, unsigned opcode, const void* arg, unsigned nr_args) {
+  return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+/** Returns the pointer at the given byte offset of a mapped ring. */
+template <class T>
+T* ring_ptr(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+Uring::Uring()
+    : ring_fd_(-1)
+    , entries_(0)
+    , sq_ring_(MAP_FAILED)
+    , sq_ring_size_(0)
+    , cq_ring_(MAP_FAILED)
+    , cq_ring_size_(0)
+    , sqes_(MAP_FAILED)
+    , sqes_size_(0)
+    , sq_head_(nullptr)
+    , sq_tail_(nullptr)
+    , sq_mask_(nullptr)
+    , sq_array_(nullptr)
+    , cq_head_(nullptr)
+    , cq_tail_(nullptr)
+    , cq_mask_(nullptr)
+    , cqes_(nullptr)
+    , to_submit_(0)
+    , in_flight_(0)
+    , num_buffers_(0)
+    , buffer_size_(0) {
+}
+
+Uring::~Uring() {
+  destroy();
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status Uring::init(unsigned entries, uint64_t buffer_size) {
+  destroy();
+
+  struct io_uring_params p;
+  std::memset(&p, 0, sizeof(p));
+  ring_fd_ = sys_io_uring_setup(entries, &p);
+  if (ring_fd_ < 0)
+    return Status::IOError(
+        std::string("Cannot set up io_uring; ") + strerror(errno));
+
+  // IORING_OP_READ and IORING_FEAT_RW_CUR_POS were both added in Linux 5.6.
+  if (!(p.features & IORING_FEAT_RW_CUR_POS)) {
+    destroy();
+    return Status::IOError("Cannot set up io_uring; Kernel is too old");
+  }
+  entries_ = p.sq_entries;
+
+  // Map the rings. With IORING_FEAT_SINGLE_MMAP the completion queue shares
+  // the mapping of the submission queue.
+  sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  cq_ring_size_ =
+      p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  bool single_mmap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    cq_ring_size_ = 0;
+  }
+  sq_ring_ = mmap(
+      nullptr,
+      sq_ring_size_,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      ring_fd_,
+      IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    destroy();
+    return Status::IOError(
+        std::string("Cannot map io_uring; ") + strerror(errno));
+  }
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(
+        nullptr,
+        cq_ring_size_,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        ring_fd_,
+        IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      destroy();
+      return Status::IOError(
+          std::string("Cannot map io_uring; ") + strerror(errno));
+    }
+  }
+  sqes_size_ = p.sq_entries * sizeof(struct io_uring_sqe);
+  sqes_ = mmap(
+      nullptr,
+      sqes_size_,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      ring_fd_,
+      IORING_OFF_SQES);
+  if (sqes_ == MAP_FAILED) {
+    destroy();
+    return Status::IOError(
+        std::string("Cannot map io_uring; ") + strerror(errno));
+  }
+
+  sq_head_ = ring_ptr<unsigned>(sq_ring_, p.sq_off.head);
+  sq_tail_ = ring_ptr<unsigned>(sq_ring_, p.sq_off.tail);
+  sq_mask_ = ring_ptr<unsigned>(sq_ring_, p.sq_off.ring_mask);
+  sq_array_ = ring_ptr<unsigned>(sq_ring_, p.sq_off.array);
+  cq_head_ = ring_ptr<unsigned>(cq_ring_, p.cq_off.head);
+  cq_tail_ = ring_ptr<unsigned>(cq_ring_, p.cq_off.tail);
+  cq_mask_ = ring_ptr<unsigned>(cq_ring_, p.cq_off.ring_mask);
+  cqes_ = ring_ptr<void>(cq_ring_, p.cq_off.cqes);
+
+  // Register one buffer per entry. Failure is not an error, since reads can
+  // still be issued into unregistered memory.
+  buffers_.resize(entries_ * buffer_size);
+  std::vector<struct iovec> iovecs(entries_);
+  for (unsigned i = 0; i < entries_; i++) {
+    iovecs[i].iov_base = &buffers_[i * buffer_size];
+    iovecs[i].iov_len = buffer_size;
+  }
+  if (sys_io_uring_register(
+          ring_fd_, IORING_REGISTER_BUFFERS, iovecs.data(), entries_) == 0) {
+    num_buffers_ = entries_;
+    buffer_size_ = buffer_size;
+  } else {
+    std::vector<char>().swap(buffers_);
+  }
+
+  return Status::Ok();
+}
+
+unsigned Uring::entries() const {
+  return entries_;
+}
+
+unsigned Uring::num_buffers() const {
+  return num_buffers_;
+}
+
+uint64_t Uring::buffer_size() const {
+  return buffer_size_;
+}
+
+char* Uring::buffer(unsigned index) const {
+  return const_cast<char*>(&buffers_[index * buffer_size_]);
+}
+
+bool Uring::prep_read(
+    int fd,
+    void* dest,
+    uint32_t nbytes,
+    uint64_t offset,
+    int buffer_index,
+    uint64_t user_data) {
+  // Only this thread writes the tail; the kernel advances the head.
+  unsigned tail = *sq_tail_;
+  unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  if (tail - head >= entries_)
+    return false;
+
+  unsigned index = tail & *sq_mask_;
+  auto sqe = static_cast<struct io_uring_sqe*>(sqes_) + index;
+  std::memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = buffer_index >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+  sqe->fd = fd;
+  sqe->off = offset;
+  sqe->addr = reinterpret_cast<uint64_t>(dest);
+  sqe->len = nbytes;
+  sqe->buf_index = buffer_index >= 0 ? (uint16_t)buffer_index : 0;
+  sqe->user_data = user_data;
+  sq_array_[index] = index;
+
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  to_submit_++;
+
+  return true;
+}
+
+Status Uring::submit_and_wait(unsigned wait_nr) {
+  unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+  for (;;) {
+    int ret = sys_io_uring_enter(ring_fd_, to_submit_, wait_nr, flags);
+    if (ret > 0 || (ret == 0 && to_submit_ == 0)) {
+      auto submitted = std::min((unsigned)ret, to_submit_);
+      to_submit_ -= submitted;
+      in_flight_ += submitted;
+      if (to_submit_ == 0)
+        return Status::Ok();
+      // Not all queued reads were consumed; submit the rest.
+      continue;
+    }
+    if (ret == 0)
+      return Status::IOError("io_uring submission error: No entry consumed");
+    if (errno == EINTR)
+      continue;
+    if (errno == EAGAIN || errno == EBUSY) {
+      // Let the caller make room in the completion queue, if it can
+      if (has_completions())
+        return Status::Ok();
+      std::this_thread::yield();
+      continue;
+    }
+    return Status::IOError(
+        std::string("io_uring submission error: ") + strerror(errno));
+  }
+}
+
+bool Uring::pop_completion(uint64_t* user_data, int32_t* res) {
+  // Only this thread writes the head; the kernel advances the tail.
+  unsigned head = *cq_head_;
+  unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  if (head == tail)
+    return false;
+
+  auto cqe = static_cast<struct io_uring_cqe*>(cqes_) + (head & *cq_mask_);
+  *user_data = cqe->user_data;
+  *res = cqe->res;
+  __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+  if (in_flight_ > 0)
+    in_flight_--;
+
+  return true;
+}
+
+Status Uring::drain() {
+  // The kernel reads the submission queue only when entering the ring, so
+  // the queued reads can be withdrawn by moving the tail back.
+  __atomic_store_n(sq_tail_, *sq_tail_ - to_submit_, __ATOMIC_RELEASE);
+  to_submit_ = 0;
+
+  uint64_t user_data;
+  int32_t res;
+  while (in_flight_ > 0) {
+    if (pop_completion(&user_data, &res))
+      continue;
+    int ret = sys_io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+    if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+      return Status::IOError(
+          std::string("io_uring wait error: ") + strerror(errno));
+  }
+
+  return Status::Ok();
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+bool Uring::has_completions() const {
+  return *cq_head_ != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+}
+
+void Uring::destroy() {
+  if (sqes_ != MAP_FAILED)
+    munmap(sqes_, sqes_size_);
+  if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_)
+    munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != MAP_FAILED)
+    munmap(sq_ring_, sq_ring_size_);
+  if (ring_fd_ >= 0)
+    close(ring_fd_);
+
+  ring_fd_ = -1;
+  entries_ = 0;
+  sq_ring_ = cq_ring_ = sqes_ = MAP_FAILED;
+  to_submit_ = 0;
+  in_flight_ = 0;
+  num_buffers_ = 0;
+  buffer_size_ = 0;
+  std::vector<char>().swap(buffers_);
+}
+
+}  // namespace sm
+}  // namespace tiledb
+
+#else
+
+namespace tiledb {
+namespace sm {
+
+// Only what the users of the class need without io_uring support.
+
+Uring::Uring()
+    : ring_fd_(-1)
+    , entries_(0)
+    , num_buffers_(0)
+    , buffer_size_(0) {
+}
+
+Uring::~Uring() = default;
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // HAVE_IO_URING
@@ -0,0 +1,224 @@
+/**
+ * @file   uring.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class Uring, a minimal wrapper around a Linux io_uring
+ * instance used to batch file reads.
+ */
+
+#ifndef TILEDB_URING_H
+#define TILEDB_URING_H
+
+#include <cstdint>
+#include <vector>
+
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A Linux io_uring instance, driven directly through the io_uring system
+ * calls. Reads are queued on the submission queue with `prep_read()`,
+ * submitted together with `submit_and_wait()`, and their results are
+ * collected with `pop_completion()`.
+ *
+ * Upon initialization, one buffer per submission queue entry is registered
+ * with the kernel, so that reads into them skip the per-request page
+ * pinning. Registration is best effort (it may for instance exceed the
+ * locked memory limit), see `num_buffers()`.
+ *
+ * An instance must not be used concurrently by multiple threads. The class
+ * is only defined if TileDB is built with io_uring support (`HAVE_IO_URING`),
+ * but is always declared so that the layout of its users does not depend on
+ * it.
+ */
+class Uring {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  Uring();
+
+  /** Destructor. */
+  ~Uring();
+
+  Uring(const Uring&) = delete;
+  Uring& operator=(const Uring&) = delete;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Initializes the io_uring instance. This fails if the kernel does not
+   * support io_uring or the operations used by this class (Linux 5.6+).
+   *
+   * @param entries The number of submission queue entries, which bounds the
+   *     number of reads in flight.
+   * @param buffer_size The size of each registered buffer.
+   * @return Status
+   */
+  Status init(unsigned entries, uint64_t buffer_size);
+
+  /** Returns the number of submission queue entries. */
+  unsigned entries() const;
+
+  /** Returns the number of registered buffers (0 if registration failed). */
+  unsigned num_buffers() const;
+
+  /** Returns the size of each registered buffer. */
+  uint64_t buffer_size() const;
+
+  /** Returns the registered buffer with the given index. */
+  char* buffer(unsigned index) const;
+
+  /**
+   * Queues a read on the submission queue, without submitting it.
+   *
+   * @param fd The file descriptor to read from.
+   * @param dest The destination of the read.
+   * @param nbytes The number of bytes to read.
+   * @param offset The file offset to read from.
+   * @param buffer_index The index of the registered buffer `dest` lies in, or
+   *     -1 if it does not lie in a registered buffer.
+   * @param user_data The value returned with the completion of the read.
+   * @return `false` if the submission queue is full.
+   */
+  bool prep_read(
+      int fd,
+      void* dest,
+      uint32_t nbytes,
+      uint64_t offset,
+      int buffer_index,
+      uint64_t user_data);
+
+  /**
+   * Submits all queued reads and waits until at least `wait_nr` completions
+   * are available. If the kernel is temporarily short of resources, or the
+   * completion queue is full, this returns as soon as completions are
+   * available, possibly leaving reads queued for the next call.
+   *
+   * @param wait_nr The number of completions to wait for.
+   * @return Status
+   */
+  Status submit_and_wait(unsigned wait_nr);
+
+  /**
+   * Discards the queued reads and waits for all the submitted reads to
+   * complete, discarding their completions. This must be called upon
+   * errors, before freeing the destinations of the reads in flight.
+   *
+   * @return Status, an error if waiting failed, in which case reads may
+   *     still be in flight.
+   */
+  Status drain();
+
+  /**
+   * Pops a completion from the completion queue, if any.
+   *
+   * @param user_data Set to the user data of the completed read.
+   * @param res Set to the result of the completed read: the number of bytes
+   *     read, or a negated `errno` value on error.
+   * @return `false` if the completion queue is empty.
+   */
+  bool pop_completion(uint64_t* user_data, int32_t* res);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The io_uring file descriptor. */
+  int ring_fd_;
+
+  /** The number of submission queue entries. */
+  unsigned entries_;
+
+  /** The mapped submission queue ring. */
+  void* sq_ring_;
+
+  /** The size of the mapped submission queue ring. */
+  size_t sq_ring_size_;
+
+  /** The mapped completion queue ring (may alias the submission queue). */
+  void* cq_ring_;
+
+  /** The size of the mapped completion queue ring. */
+  size_t cq_ring_size_;
+
+  /** The mapped submission queue entries. */
+  void* sqes_;
+
+  /** The size of the mapped submission queue entries. */
+  size_t sqes_size_;
+
+  /** Submission queue head, tail, mask and index array. */
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned* sq_mask_;
+  unsigned* sq_array_;
+
+  /** Completion queue head, tail, mask and entries. */
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned* cq_mask_;
+  void* cqes_;
+
+  /** The number of reads queued but not yet submitted. */
+  unsigned to_submit_;
+
+  /** The number of reads submitted whose completion was not popped. */
+  unsigned in_flight_;
+
+  /** Backing memory of the registered buffers. */
+  std::vector<char> buffers_;
+
+  /** The number of registered buffers. */
+  unsigned num_buffers_;
+
+  /** The size of each registered buffer. */
+  uint64_t buffer_size_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns `true` if the completion queue is not empty. */
+  bool has_completions() const;
+
+  /** Unmaps the rings and closes the io_uring file descriptor. */
+  void destroy();
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_URING_H
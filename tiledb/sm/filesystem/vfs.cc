@@ -62,7 +62,8 @@ static std::mutex filelock_mtx_;
 /*     CONSTRUCTORS & DESTRUCTORS    */
 /* ********************************* */
 
-VFS::VFS() {
+VFS::VFS()
+    : thread_pool_(nullptr) {
   STATS_FUNC_VOID_IN(vfs_constructor);
 
 #ifdef HAVE_HDFS
@@ -215,7 +216,9 @@ Status VFS::touch(const URI& uri) const {
 }
 
 Status VFS::cancel_all_tasks() {
-  thread_pool_->cancel_all_tasks();
+  // The tasks of a shared thread pool are cancelled by its owner
+  if (owned_thread_pool_ != nullptr)
+    owned_thread_pool_->cancel_all_tasks();
   return Status::Ok();
 }
 
@@ -597,16 +600,22 @@ Status VFS::is_bucket(const URI& uri, bool* is_bucket) const {
   STATS_FUNC_OUT(vfs_is_bucket);
 }
 
-Status VFS::init(const Config::VFSParams& vfs_params) {
+Status VFS::init(const Config::VFSParams& vfs_params, ThreadPool* thread_pool) {
   STATS_FUNC_IN(vfs_init);
 
   vfs_params_ = vfs_params;
 
-  thread_pool_ = std::unique_ptr<ThreadPool>(new (std::nothrow) ThreadPool());
-  if (thread_pool_.get() == nullptr) {
-    return LOG_STATUS(Status::VFSError("Could not allocate VFS thread pool."));
+  thread_pool_ = thread_pool;
+  if (thread_pool_ == nullptr) {
+    owned_thread_pool_ =
+        std::unique_ptr<ThreadPool>(new (std::nothrow) ThreadPool());
+    if (owned_thread_pool_.get() == nullptr) {
+      return LOG_STATUS(
+          Status::VFSError("Could not allocate VFS thread pool."));
+    }
+    RETURN_NOT_OK(owned_thread_pool_->init(vfs_params.num_threads_));
+    thread_pool_ = owned_thread_pool_.get();
   }
-  RETURN_NOT_OK(thread_pool_->init(vfs_params.num_threads_));
 
 #ifdef HAVE_HDFS
   hdfs_ = std::unique_ptr<hdfs::HDFS>(new (std::nothrow) hdfs::HDFS());
@@ -617,20 +626,37 @@ Status VFS::init(const Config::VFSParams& vfs_params) {
 #endif
 
 #ifdef HAVE_S3
-  RETURN_NOT_OK(s3_.init(vfs_params.s3_params_, thread_pool_.get()));
+  RETURN_NOT_OK(s3_.init(vfs_params.s3_params_, thread_pool_));
 #endif
 
 #ifdef WIN32
-  win_.init(vfs_params, thread_pool_.get());
+  win_.init(vfs_params, thread_pool_);
 #else
-  posix_.init(vfs_params, thread_pool_.get());
+  posix_.init(vfs_params, thread_pool_);
 #endif
 
+  disk_cache_.reset();
+  if (!vfs_params.disk_cache_params_.path_.empty()) {
+    disk_cache_ = std::unique_ptr<DiskCache>(new (std::nothrow) DiskCache());
+    if (disk_cache_.get() == nullptr) {
+      return LOG_STATUS(Status::VFSError("Could not allocate disk cache."));
+    }
+    RETURN_NOT_OK(disk_cache_->init(this, vfs_params.disk_cache_params_));
+  }
+
   return Status::Ok();
 
   STATS_FUNC_OUT(vfs_init);
 }
 
+bool VFS::io_uring_enabled() const {
+#ifdef _WIN32
+  return false;
+#else
+  return posix_.io_uring_enabled();
+#endif
+}
+
 Status VFS::ls(const URI& parent, std::vector<URI>* uris) const {
   STATS_FUNC_IN(vfs_ls);
 
@@ -658,7 +684,7 @@ Status VFS::ls(const URI& parent, std::vector<URI>* uris) const {
     return LOG_STATUS(
         Status::VFSError("Unsupported URI scheme: " + parent.to_string()));
   }
-  parallel_sort(paths.begin(), paths.end());
+  parallel_sort(thread_pool_, paths.begin(), paths.end());
   for (auto& path : paths) {
     uris->emplace_back(path);
   }
@@ -778,6 +804,52 @@ Status VFS::read(
   STATS_FUNC_IN(vfs_read);
   STATS_COUNTER_ADD(vfs_read_total_bytes, nbytes);
 
+  if (disk_cache_ == nullptr || !DiskCache::cacheable(uri))
+    return read_parallel(uri, offset, buffer, nbytes);
+
+  // Serve ranges of remote fragment files from the local disk cache, caching
+  // the ranges that miss.
+  bool hit = false;
+  RETURN_NOT_OK(disk_cache_->read(uri, offset, buffer, nbytes, &hit));
+  if (hit)
+    return Status::Ok();
+  RETURN_NOT_OK(read_parallel(uri, offset, buffer, nbytes));
+  // Cache the range in the background. Failing to cache it does not fail
+  // the read.
+  disk_cache_->write_async(thread_pool_, uri, offset, buffer, nbytes);
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(vfs_read);
+}
+
+Status VFS::read_at_most(
+    const URI& uri,
+    uint64_t offset,
+    void* buffer,
+    uint64_t nbytes,
+    uint64_t* nbytes_read) const {
+  if (uri.is_s3()) {
+#ifdef HAVE_S3
+    STATS_COUNTER_ADD(vfs_read_total_bytes, nbytes);
+    return s3_.read(uri, offset, buffer, nbytes, nbytes_read);
+#else
+    return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
+#endif
+  }
+
+  uint64_t size;
+  RETURN_NOT_OK(file_size(uri, &size));
+  if (offset >= size)
+    return LOG_STATUS(Status::VFSError(
+        "Cannot read from file '" + uri.to_string() +
+        "'; Offset exceeds file size"));
+  *nbytes_read = std::min(nbytes, size - offset);
+  return read(uri, offset, buffer, *nbytes_read);
+}
+
+Status VFS::read_parallel(
+    const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const {
   // Ensure that each thread is responsible for at least min_parallel_size
   // bytes, and cap the number of parallel operations at the configured maximum
   // number.
@@ -785,7 +857,8 @@ Status VFS::read(
       std::max(nbytes / vfs_params_.min_parallel_size_, uint64_t(1)),
       max_parallel_ops(uri));
 
-  if (num_ops == 1) {
+  // With io_uring, the POSIX backend splits and submits large reads itself.
+  if (num_ops == 1 || (uri.is_file() && io_uring_enabled())) {
     return read_impl(uri, offset, buffer, nbytes);
   } else {
     STATS_COUNTER_ADD(vfs_read_num_parallelized, 1);
@@ -798,10 +871,13 @@ Status VFS::read(
       uint64_t thread_nbytes = end - begin + 1;
       uint64_t thread_offset = offset + begin;
       auto thread_buffer = reinterpret_cast<char*>(buffer) + begin;
+      // Reads are on the critical path of queries, so they are scheduled
+      // ahead of any pending (e.g. parallel write) tasks in the pool.
       results.push_back(thread_pool_->enqueue(
           [this, &uri, thread_offset, thread_buffer, thread_nbytes]() {
             return read_impl(uri, thread_offset, thread_buffer, thread_nbytes);
-          }));
+          },
+          ThreadPool::Priority::HIGH));
     }
     Status st = thread_pool_->wait_all(results);
     if (!st.ok()) {
@@ -812,8 +888,6 @@ Status VFS::read(
     }
     return st;
   }
-
-  STATS_FUNC_OUT(vfs_read);
 }
 
 Status VFS::read_impl(
@@ -853,24 +927,92 @@ Status VFS::read_all(
   if (regions.empty())
     return Status::Ok();
 
+  // Serve the regions of remote fragment files from the local disk cache
+  // individually, so that a tile is cached under its own range however the
+  // regions of the query around it are batched. Only the misses are read.
+  bool use_disk_cache = disk_cache_ != nullptr && DiskCache::cacheable(uri);
+  std::vector<std::tuple<uint64_t, void*, uint64_t>> missed_regions;
+  if (use_disk_cache) {
+    for (const auto& region : regions) {
+      bool hit = false;
+      RETURN_NOT_OK(disk_cache_->read(
+          uri,
+          std::get<0>(region),
+          std::get<1>(region),
+          std::get<2>(region),
+          &hit));
+      if (!hit)
+        missed_regions.push_back(region);
+    }
+    if (missed_regions.empty())
+      return Status::Ok();
+  }
+
   // Convert the individual regions into batched regions.
   std::vector<BatchedRead> batches;
-  RETURN_NOT_OK(compute_read_batches(regions, &batches));
+  RETURN_NOT_OK(compute_read_batches(
+      use_disk_cache ? missed_regions : regions, &batches));
+
+#ifndef _WIN32
+  // With io_uring, submit all the batches at once and copy each to its
+  // destinations as soon as it completes.
+  if (uri.is_file() && io_uring_enabled()) {
+    std::vector<Posix::ReadRequest> reads;
+    reads.reserve(batches.size());
+    for (const auto& batch : batches) {
+      reads.push_back(Posix::ReadRequest{batch.offset, batch.nbytes, nullptr});
+      STATS_COUNTER_ADD(vfs_read_total_bytes, batch.nbytes);
+    }
+    return posix_.read_batched(
+        uri.to_path(), reads, [&batches](uint64_t i, const char* data) {
+          const auto& batch = batches[i];
+          for (const auto& region : batch.regions) {
+            uint64_t offset = std::get<0>(region);
+            void* dest = std::get<1>(region);
+            uint64_t nbytes = std::get<2>(region);
+            std::memcpy(dest, data + (offset - batch.offset), nbytes);
+          }
+          return Status::Ok();
+        });
+  }
+#endif
 
-  // Read all the batches and copy to the original destinations.
+  // Read all the batches and copy to the original destinations. The batches
+  // bypass the disk cache, which caches the individual regions instead.
   Buffer buffer;
   for (const auto& batch : batches) {
     RETURN_NOT_OK(buffer.realloc(batch.nbytes));
-    RETURN_NOT_OK(read(uri, batch.offset, buffer.data(), batch.nbytes));
+    if (use_disk_cache) {
+      STATS_COUNTER_ADD(vfs_read_total_bytes, batch.nbytes);
+      RETURN_NOT_OK(
+          read_parallel(uri, batch.offset, buffer.data(), batch.nbytes));
+    } else {
+      RETURN_NOT_OK(read(uri, batch.offset, buffer.data(), batch.nbytes));
+    }
     // Parallel copy back into the individual destinations.
-    parallel_for(0, batch.regions.size(), [&batch, &buffer](uint64_t i) {
-      const auto& region = batch.regions[i];
-      uint64_t offset = std::get<0>(region);
-      void* dest = std::get<1>(region);
-      uint64_t nbytes = std::get<2>(region);
-      std::memcpy(dest, buffer.data(offset - batch.offset), nbytes);
-      return Status::Ok();
-    });
+    parallel_for(
+        thread_pool_,
+        0,
+        batch.regions.size(),
+        [&batch, &buffer](uint64_t i) {
+          const auto& region = batch.regions[i];
+          uint64_t offset = std::get<0>(region);
+          void* dest = std::get<1>(region);
+          uint64_t nbytes = std::get<2>(region);
+          std::memcpy(dest, buffer.data(offset - batch.offset), nbytes);
+          return Status::Ok();
+        });
+    // Cache the regions in the background. Failing to cache a region does
+    // not fail the read.
+    if (use_disk_cache) {
+      for (const auto& region : batch.regions)
+        disk_cache_->write_async(
+            thread_pool_,
+            uri,
+            std::get<0>(region),
+            std::get<1>(region),
+            std::get<2>(region));
+    }
   }
 
   return Status::Ok();
@@ -885,6 +1027,7 @@ Status VFS::compute_read_batches(
   std::vector<std::tuple<uint64_t, void*, uint64_t>> sorted_regions(
       regions.begin(), regions.end());
   parallel_sort(
+      thread_pool_,
       sorted_regions.begin(),
       sorted_regions.end(),
       [](const std::tuple<uint64_t, void*, uint64_t>& a,
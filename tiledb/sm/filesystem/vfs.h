@@ -34,6 +34,7 @@
 #define TILEDB_VFS_H
 
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/cache/disk_cache.h"
 #include "tiledb/sm/enums/filesystem.h"
 #include "tiledb/sm/enums/vfs_mode.h"
 #include "tiledb/sm/filesystem/filelock.h"
@@ -59,6 +60,10 @@
 namespace tiledb {
 namespace sm {
 
+namespace microbench {
+class Access;
+}
+
 /**
  * This class implements a virtual filesystem that directs filesystem-related
  * function execution to the appropriate backend based on the input URI.
@@ -245,9 +250,19 @@ class VFS {
    * Initializes the virtual filesystem with the given configuration.
    *
    * @param vfs_params VFS Configuration
+   * @param thread_pool The thread pool to run the parallel I/O on, which must
+   *     outlive the VFS. If `nullptr`, the VFS creates its own pool of
+   *     `vfs.num_threads` threads.
    * @return Status
    */
-  Status init(const Config::VFSParams& vfs_params);
+  Status init(
+      const Config::VFSParams& vfs_params, ThreadPool* thread_pool = nullptr);
+
+  /**
+   * Returns `true` if reads of `file:///` URIs are issued through io_uring
+   * (see config parameter `vfs.file.io_uring`).
+   */
+  bool io_uring_enabled() const;
 
   /**
    * Retrieves all the URIs that have the first input as parent.
@@ -289,7 +304,16 @@ class VFS {
       const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const;
 
   /**
-   * Reads multiple regions from a file.
+   * Reads multiple regions from a file. Nearby regions are coalesced into
+   * batched reads (see `vfs.max_batch_read_size` and
+   * `vfs.max_batch_read_amplification`).
+   *
+   * For `file:///` URIs with io_uring enabled, all the batches are submitted
+   * at once and each is copied to its destinations as soon as it completes.
+   * Note that the function still returns only after every batch has
+   * completed: the completions are not pipelined with the processing of the
+   * regions by the caller (e.g., tile unfiltering), which starts after the
+   * slowest read of the call.
    *
    * @param uri The URI of the file.
    * @param regions The list of regions to read. Each region is a tuple
@@ -300,6 +324,27 @@ class VFS {
       const URI& uri,
       const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions) const;
 
+  /**
+   * Reads up to `nbytes` bytes from a file, stopping early at the end of
+   * the file. This lets a speculative read stand in for a file size lookup:
+   * on S3 it takes a single request, whereas the other backends look up
+   * the file size first, which is cheap for them. The disk cache is not
+   * used. The offset must be within the file.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset where the read begins.
+   * @param buffer The buffer to read into.
+   * @param nbytes The maximum number of bytes to read.
+   * @param nbytes_read Set to the number of bytes read.
+   * @return Status
+   */
+  Status read_at_most(
+      const URI& uri,
+      uint64_t offset,
+      void* buffer,
+      uint64_t nbytes,
+      uint64_t* nbytes_read) const;
+
   /** Checks if a given filesystem is supported. */
   bool supports_fs(Filesystem fs) const;
 
@@ -354,6 +399,9 @@ class VFS {
   Status write(const URI& uri, const void* buffer, uint64_t buffer_size);
 
  private:
+  /** Gives the micro-benchmarks access to the internal kernels they time. */
+  friend class microbench::Access;
+
   /* ********************************* */
   /*        PRIVATE DATATYPES          */
   /* ********************************* */
@@ -407,7 +455,16 @@ class VFS {
   std::set<Filesystem> supported_fs_;
 
   /** Thread pool for parallel I/O operations. */
-  std::unique_ptr<ThreadPool> thread_pool_;
+  ThreadPool* thread_pool_;
+
+  /** The own thread pool, if no thread pool was given on `init`. */
+  std::unique_ptr<ThreadPool> owned_thread_pool_;
+
+  /**
+   * The local disk cache of remote fragment files, or `nullptr` if disabled
+   * (see config parameter `vfs.disk_cache.path`).
+   */
+  std::unique_ptr<DiskCache> disk_cache_;
 
   /**
    * Groups the given vector of regions to be read into a possibly smaller
@@ -422,6 +479,18 @@ class VFS {
       const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions,
       std::vector<BatchedRead>* batches) const;
 
+  /**
+   * Reads from a file, splitting large reads into parallel operations.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset where the read begins.
+   * @param buffer The buffer to read into.
+   * @param nbytes Number of bytes to read.
+   * @return Status
+   */
+  Status read_parallel(
+      const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const;
+
   /**
    * Reads from a file by calling the specific backend read function.
    *
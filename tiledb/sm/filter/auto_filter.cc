@@ -0,0 +1,369 @@
+/**
+ * @file   auto_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class AutoFilter.
+ */
+
+#include "tiledb/sm/filter/auto_filter.h"
+#include "tiledb/sm/filter/bit_width_reduction_filter.h"
+#include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/filter/filter_storage.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/**
+ * The candidate codecs, in increasing order of decoding cost (so that ties
+ * favor the cheaper codec).
+ */
+const FilterType candidate_codecs[] = {FilterType::FILTER_RLE,
+                                       FilterType::FILTER_LZ4,
+                                       FilterType::FILTER_BIT_WIDTH_REDUCTION,
+                                       FilterType::FILTER_DOUBLE_DELTA,
+                                       FilterType::FILTER_ZSTD};
+
+/**
+ * Returns the decoding cost per byte of a codec, relative to that of LZ4.
+ * Reading uncompressed data costs nothing. The costs are fixed estimates,
+ * not measured.
+ */
+double decode_cost(FilterType codec) {
+  switch (codec) {
+    case FilterType::FILTER_RLE:
+    case FilterType::FILTER_LZ4:
+      return 1.0;
+    case FilterType::FILTER_BIT_WIDTH_REDUCTION:
+    case FilterType::FILTER_DOUBLE_DELTA:
+      return 2.0;
+    case FilterType::FILTER_ZSTD:
+      return 3.0;
+    default:
+      return 0.0;
+  }
+}
+
+/**
+ * Returns the weight of the decoding cost in the score of a codec, which is
+ * added to its compression ratio.
+ */
+double decode_cost_weight(AutoObjective objective) {
+  switch (objective) {
+    case AutoObjective::AUTO_RATIO:
+      return 0.0;
+    case AutoObjective::AUTO_BALANCED:
+      return 0.05;
+    case AutoObjective::AUTO_DECODE_SPEED:
+      return 0.2;
+  }
+  return 0.0;
+}
+
+}  // namespace
+
+AutoFilter::AutoFilter()
+    : AutoFilter(AutoObjective::AUTO_BALANCED, -1) {
+}
+
+AutoFilter::AutoFilter(AutoObjective objective, int level)
+    : Filter(FilterType::FILTER_AUTO)
+    , objective_(objective)
+    , level_(level) {
+  create_codecs();
+}
+
+int AutoFilter::compression_level() const {
+  return level_;
+}
+
+AutoObjective AutoFilter::objective() const {
+  return objective_;
+}
+
+AutoFilter* AutoFilter::clone_impl() const {
+  return new AutoFilter(objective_, level_);
+}
+
+void AutoFilter::set_compression_level(int level) {
+  level_ = level;
+  create_codecs();
+}
+
+void AutoFilter::set_objective(AutoObjective objective) {
+  objective_ = objective;
+}
+
+Status AutoFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  FilterType codec;
+  RETURN_NOT_OK(choose_codec(input, &codec));
+
+  if (codec != FilterType::FILTER_NONE) {
+    auto filter = codec_filter(codec);
+    RETURN_NOT_OK(
+        filter->run_forward(input_metadata, input, output_metadata, output));
+
+    // Store the chunk uncompressed if the codec did not shrink it
+    if (output->size() + output_metadata->size() >=
+        input->size() + input_metadata->size()) {
+      RETURN_NOT_OK(output->clear());
+      RETURN_NOT_OK(output_metadata->clear());
+      codec = FilterType::FILTER_NONE;
+    }
+  }
+
+  if (codec == FilterType::FILTER_NONE) {
+    RETURN_NOT_OK(output->append_view(input));
+    RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  }
+
+  // Record the chosen codec before the metadata of the codec
+  auto codec_char = static_cast<uint8_t>(codec);
+  RETURN_NOT_OK(output_metadata->prepend_buffer(sizeof(uint8_t)));
+  RETURN_NOT_OK(output_metadata->write(&codec_char, sizeof(uint8_t)));
+
+  return Status::Ok();
+}
+
+Status AutoFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  uint8_t codec_char;
+  RETURN_NOT_OK(input_metadata->read(&codec_char, sizeof(uint8_t)));
+  auto codec = static_cast<FilterType>(codec_char);
+
+  // The codec metadata is a view on the rest of the input metadata
+  FilterBuffer codec_metadata;
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(codec_metadata.append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  if (codec == FilterType::FILTER_NONE) {
+    RETURN_NOT_OK(output->append_view(input));
+    RETURN_NOT_OK(output_metadata->append_view(&codec_metadata));
+    return Status::Ok();
+  }
+
+  auto filter = codec_filter(codec);
+  if (filter == nullptr)
+    return LOG_STATUS(
+        Status::FilterError("Auto filter error; unknown chunk codec"));
+
+  return filter->run_reverse(&codec_metadata, input, output_metadata, output);
+}
+
+Status AutoFilter::choose_codec(FilterBuffer* input, FilterType* codec) const {
+  *codec = FilterType::FILTER_NONE;
+  auto input_size = input->size();
+  if (input_size == 0)
+    return Status::Ok();
+
+  // Take the sample, from evenly spaced stripes of whole cells if the input
+  // is larger than the sample
+  auto cell_size = pipeline_->current_tile()->cell_size();
+  auto sample_size = constants::auto_filter_sample_size;
+  auto stripes = constants::auto_filter_sample_stripes;
+  auto stripe_size = sample_size / stripes / cell_size * cell_size;
+  auto step = input_size / stripes / cell_size * cell_size;
+  std::vector<char> sample;
+  if (input_size > sample_size && stripe_size > 0 && step >= stripe_size) {
+    sample.resize(stripes * stripe_size);
+    for (unsigned i = 0; i < stripes; ++i) {
+      input->set_offset(i * step);
+      RETURN_NOT_OK(input->read(&sample[i * stripe_size], stripe_size));
+    }
+  } else {
+    sample.resize(std::min(
+        input_size, std::max(sample_size / cell_size * cell_size, cell_size)));
+    input->reset_offset();
+    RETURN_NOT_OK(input->read(&sample[0], sample.size()));
+  }
+  input->reset_offset();
+
+  // Storing the chunk uncompressed scores 1
+  auto weight = decode_cost_weight(objective_);
+  double best_score = 1.0;
+  for (auto candidate : candidate_codecs) {
+    if (!is_applicable(candidate, input_size))
+      continue;
+
+    // Skip the codecs that fail on the sample
+    uint64_t size;
+    if (!trial_size(codec_filter(candidate), &sample[0], sample.size(), &size)
+             .ok())
+      continue;
+
+    double score =
+        (double)size / sample.size() + weight * decode_cost(candidate);
+    if (score < best_score) {
+      best_score = score;
+      *codec = candidate;
+    }
+  }
+
+  return Status::Ok();
+}
+
+const Filter* AutoFilter::codec_filter(FilterType codec) const {
+  for (const auto& filter : codecs_) {
+    if (filter->type() == codec)
+      return filter.get();
+  }
+  return nullptr;
+}
+
+void AutoFilter::create_codecs() {
+  codecs_.clear();
+  for (auto codec : candidate_codecs) {
+    std::unique_ptr<Filter> filter;
+    if (codec == FilterType::FILTER_BIT_WIDTH_REDUCTION)
+      filter.reset(new BitWidthReductionFilter());
+    else
+      filter.reset(new CompressionFilter(codec, level_));
+    filter->set_pipeline(pipeline_);
+    codecs_.push_back(std::move(filter));
+  }
+}
+
+bool AutoFilter::is_applicable(FilterType codec, uint64_t input_size) const {
+  auto tile = pipeline_->current_tile();
+  auto type = tile->type();
+  auto type_size = datatype_size(type);
+
+  switch (codec) {
+    case FilterType::FILTER_RLE:
+      return input_size % tile->cell_size() == 0;
+    case FilterType::FILTER_LZ4:
+    case FilterType::FILTER_ZSTD:
+      return true;
+    case FilterType::FILTER_BIT_WIDTH_REDUCTION:
+      return datatype_is_integer(type) && type_size > 1 &&
+             input_size % type_size == 0;
+    case FilterType::FILTER_DOUBLE_DELTA:
+      return datatype_is_integer(type) && input_size % type_size == 0;
+    default:
+      return false;
+  }
+}
+
+Status AutoFilter::trial_size(
+    const Filter* codec,
+    void* sample,
+    uint64_t sample_size,
+    uint64_t* size) const {
+  FilterStorage storage(nullptr);
+  FilterBuffer input(&storage), input_metadata(&storage);
+  FilterBuffer output(&storage), output_metadata(&storage);
+  RETURN_NOT_OK(input.init(sample, sample_size));
+  RETURN_NOT_OK(
+      codec->run_forward(&input_metadata, &input, &output_metadata, &output));
+
+  *size = output.size() + output_metadata.size();
+
+  return Status::Ok();
+}
+
+Status AutoFilter::set_option_impl(FilterOption option, const void* value) {
+  if (value == nullptr)
+    return LOG_STATUS(
+        Status::FilterError("Auto filter error; invalid option value"));
+
+  switch (option) {
+    case FilterOption::AUTO_OBJECTIVE: {
+      auto objective = *(const uint32_t*)value;
+      if (objective > (uint32_t)AutoObjective::AUTO_DECODE_SPEED)
+        return LOG_STATUS(
+            Status::FilterError("Auto filter error; invalid objective"));
+      objective_ = static_cast<AutoObjective>(objective);
+      return Status::Ok();
+    }
+    case FilterOption::COMPRESSION_LEVEL:
+      set_compression_level(*(const int*)value);
+      return Status::Ok();
+    default:
+      return LOG_STATUS(
+          Status::FilterError("Auto filter error; unknown option"));
+  }
+}
+
+void AutoFilter::set_pipeline_impl(const FilterPipeline* pipeline) {
+  for (auto& filter : codecs_)
+    filter->set_pipeline(pipeline);
+}
+
+Status AutoFilter::get_option_impl(FilterOption option, void* value) const {
+  switch (option) {
+    case FilterOption::AUTO_OBJECTIVE:
+      *(uint32_t*)value = static_cast<uint32_t>(objective_);
+      return Status::Ok();
+    case FilterOption::COMPRESSION_LEVEL:
+      *(int*)value = level_;
+      return Status::Ok();
+    default:
+      return LOG_STATUS(
+          Status::FilterError("Auto filter error; unknown option"));
+  }
+}
+
+Status AutoFilter::serialize_impl(Buffer* buff) const {
+  auto objective_char = static_cast<uint8_t>(objective_);
+  RETURN_NOT_OK(buff->write(&objective_char, sizeof(uint8_t)));
+  RETURN_NOT_OK(buff->write(&level_, sizeof(int32_t)));
+
+  return Status::Ok();
+}
+
+Status AutoFilter::deserialize_impl(ConstBuffer* buff) {
+  uint8_t objective_char;
+  RETURN_NOT_OK(buff->read(&objective_char, sizeof(uint8_t)));
+  if (objective_char > (uint8_t)AutoObjective::AUTO_DECODE_SPEED)
+    return LOG_STATUS(
+        Status::FilterError("Auto filter error; invalid serialized objective"));
+  objective_ = static_cast<AutoObjective>(objective_char);
+  RETURN_NOT_OK(buff->read(&level_, sizeof(int32_t)));
+  create_codecs();
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,185 @@
+/**
+ * @file   auto_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class AutoFilter.
+ */
+
+#ifndef TILEDB_AUTO_FILTER_H
+#define TILEDB_AUTO_FILTER_H
+
+#include "tiledb/sm/enums/auto_objective.h"
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/misc/status.h"
+
+#include <memory>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * An adaptive filter that chooses the codec of each chunk separately. It
+ * compresses a sample of the chunk (at most
+ * `constants::auto_filter_sample_size` bytes, taken from evenly spaced
+ * stripes of larger chunks) with each candidate codec applicable to the tile
+ * datatype, among RLE, bit width reduction, double delta, LZ4 and
+ * Zstandard, and scores each codec by its sample compression ratio plus a
+ * decoding cost weighted according to the objective (see `AutoObjective`).
+ * The chunk is stored uncompressed if no codec beats that, or if the chosen
+ * codec does not shrink the whole chunk.
+ *
+ * The forward output metadata has the format:
+ *   uint8_t - Chosen codec, as a FilterType (`FILTER_NONE` if uncompressed)
+ *   uint8_t[] - The output metadata of the chosen codec
+ *
+ * The forward output data is the output data of the chosen codec.
+ *
+ * The reverse output format is the reverse output of the chosen codec.
+ */
+class AutoFilter : public Filter {
+ public:
+  /** Constructor. */
+  AutoFilter();
+
+  /**
+   * Constructor.
+   *
+   * @param objective The objective of the codec choice.
+   * @param level The compression level of the LZ4 and Zstandard codecs.
+   */
+  AutoFilter(AutoObjective objective, int level);
+
+  /** Returns the compression level of the LZ4 and Zstandard codecs. */
+  int compression_level() const;
+
+  /** Returns the objective of the codec choice. */
+  AutoObjective objective() const;
+
+  /**
+   * Chooses a codec for the input and encodes it into the output.
+   */
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decodes the input with the codec recorded in the input metadata.
+   */
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /** Sets the compression level of the LZ4 and Zstandard codecs. */
+  void set_compression_level(int level);
+
+  /** Sets the objective of the codec choice. */
+  void set_objective(AutoObjective objective);
+
+ private:
+  /** The objective of the codec choice. */
+  AutoObjective objective_;
+
+  /** The compression level of the LZ4 and Zstandard codecs. */
+  int level_;
+
+  /**
+   * The filters of the candidate codecs, created once and shared by the
+   * chunks of every pipeline run. They are executed by the pipeline of this
+   * filter, and recreated when the compression level changes.
+   */
+  std::vector<std::unique_ptr<Filter>> codecs_;
+
+  /**
+   * Chooses the codec for the input, from the codecs applicable to the
+   * current tile.
+   *
+   * @param input The input to choose the codec for.
+   * @param codec Set to the chosen codec.
+   * @return Status
+   */
+  Status choose_codec(FilterBuffer* input, FilterType* codec) const;
+
+  /** Returns a new clone of this filter. */
+  AutoFilter* clone_impl() const override;
+
+  /**
+   * Returns the filter of the given codec, or `nullptr` if `codec` is not a
+   * codec of this filter.
+   */
+  const Filter* codec_filter(FilterType codec) const;
+
+  /** Creates the filters of the candidate codecs (see `codecs_`). */
+  void create_codecs();
+
+  /** Deserializes this filter's metadata from the given buffer. */
+  Status deserialize_impl(ConstBuffer* buff) override;
+
+  /** Gets an option from this filter. */
+  Status get_option_impl(FilterOption option, void* value) const override;
+
+  /**
+   * Returns `true` if the codec can encode an input of the given size of
+   * the current tile.
+   */
+  bool is_applicable(FilterType codec, uint64_t input_size) const;
+
+  /** Sets an option on this filter. */
+  Status set_option_impl(FilterOption option, const void* value) override;
+
+  /** Sets the pipeline of the codec filters. */
+  void set_pipeline_impl(const FilterPipeline* pipeline) override;
+
+  /** Serializes this filter's metadata to the given buffer. */
+  Status serialize_impl(Buffer* buff) const override;
+
+  /**
+   * Computes the size of the output (data and metadata) of the given codec
+   * on the given sample.
+   *
+   * @param codec The codec filter.
+   * @param sample The sample to encode.
+   * @param sample_size The size of the sample in bytes.
+   * @param size Set to the output size in bytes.
+   * @return Status
+   */
+  Status trial_size(
+      const Filter* codec,
+      void* sample,
+      uint64_t sample_size,
+      uint64_t* size) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_AUTO_FILTER_H
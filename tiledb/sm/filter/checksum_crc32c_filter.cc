@@ -0,0 +1,112 @@
+/**
+ * @file   checksum_crc32c_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class ChecksumCRC32CFilter.
+ */
+
+#include "tiledb/sm/filter/checksum_crc32c_filter.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/misc/crc32c.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+
+namespace tiledb {
+namespace sm {
+
+ChecksumCRC32CFilter::ChecksumCRC32CFilter()
+    : Filter(FilterType::FILTER_CHECKSUM_CRC32C) {
+}
+
+ChecksumCRC32CFilter* ChecksumCRC32CFilter::clone_impl() const {
+  return new ChecksumCRC32CFilter;
+}
+
+Status ChecksumCRC32CFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  uint32_t data_checksum = checksum(input, 0);
+  uint32_t metadata_checksum = checksum(input_metadata, 0);
+
+  // Pass the data through, prepending the checksums to the metadata
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(2 * sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&data_checksum, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&metadata_checksum, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+
+  return Status::Ok();
+}
+
+Status ChecksumCRC32CFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  uint32_t data_checksum, metadata_checksum;
+  RETURN_NOT_OK(input_metadata->read(&data_checksum, sizeof(uint32_t)));
+  RETURN_NOT_OK(input_metadata->read(&metadata_checksum, sizeof(uint32_t)));
+  auto metadata_offset = input_metadata->offset();
+
+  if (pipeline_ == nullptr || pipeline_->verify_checksums()) {
+    STATS_COUNTER_ADD(filter_checksum_bytes_verified, input->size());
+    if (checksum(input, 0) != data_checksum ||
+        checksum(input_metadata, metadata_offset) != metadata_checksum)
+      return LOG_STATUS(Status::FilterError(
+          "CRC32C checksum mismatch; the tile data is corrupted"));
+  }
+
+  // Pass the data and the rest of the metadata through
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata,
+      metadata_offset,
+      input_metadata->size() - metadata_offset));
+
+  return Status::Ok();
+}
+
+uint32_t ChecksumCRC32CFilter::checksum(
+    const FilterBuffer* buffer, uint64_t offset) {
+  uint32_t crc = 0;
+  for (const auto& part : buffer->buffers()) {
+    if (offset >= part.size()) {
+      offset -= part.size();
+      continue;
+    }
+    crc = crc32c::extend(
+        crc, (const char*)part.data() + offset, part.size() - offset);
+    offset = 0;
+  }
+  return crc;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,89 @@
+/**
+ * @file   checksum_crc32c_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class ChecksumCRC32CFilter.
+ */
+
+#ifndef TILEDB_CHECKSUM_CRC32C_FILTER_H
+#define TILEDB_CHECKSUM_CRC32C_FILTER_H
+
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A filter that computes a CRC32C checksum of the data and metadata of each
+ * chunk, and verifies it when unfiltering. The data passes through unmodified.
+ *
+ * The output metadata of each chunk is:
+ *
+ * `uint32_t` checksum of the input data
+ * `uint32_t` checksum of the input metadata
+ * input metadata
+ *
+ * The checksums are verified only if the pipeline verifies checksums (see
+ * `FilterPipeline::set_verify_checksums()`), and a mismatch fails the
+ * reverse run with an error.
+ */
+class ChecksumCRC32CFilter : public Filter {
+ public:
+  /** Constructor. */
+  ChecksumCRC32CFilter();
+
+  /** Computes the checksums of the input, passing it to the output. */
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /** Verifies the checksums of the input, passing it to the output. */
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+ private:
+  /** Returns a new clone of this filter. */
+  ChecksumCRC32CFilter* clone_impl() const override;
+
+  /**
+   * Computes the checksum of the bytes of the given buffer from the given
+   * offset on.
+   */
+  static uint32_t checksum(const FilterBuffer* buffer, uint64_t offset);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_CHECKSUM_CRC32C_FILTER_H
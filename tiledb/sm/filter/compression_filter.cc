@@ -67,7 +67,9 @@ int CompressionFilter::compression_level() const {
 }
 
 CompressionFilter* CompressionFilter::clone_impl() const {
-  return new CompressionFilter(compressor_, level_);
+  auto clone = new CompressionFilter(compressor_, level_);
+  clone->zstd_dictionary_ = zstd_dictionary_;
+  return clone;
 }
 
 void CompressionFilter::set_compressor(Compressor compressor) {
@@ -79,6 +81,16 @@ void CompressionFilter::set_compression_level(int compressor_level) {
   level_ = compressor_level;
 }
 
+void CompressionFilter::set_zstd_dictionary(
+    const std::shared_ptr<ZStdDictionary>& dict) {
+  zstd_dictionary_ = dict;
+}
+
+const std::shared_ptr<ZStdDictionary>& CompressionFilter::zstd_dictionary()
+    const {
+  return zstd_dictionary_;
+}
+
 FilterType CompressionFilter::compressor_to_filter(Compressor compressor) {
   switch (compressor) {
     case Compressor::NO_COMPRESSION:
@@ -250,7 +262,8 @@ Status CompressionFilter::compress_part(
       RETURN_NOT_OK(GZip::compress(level_, &input_buffer, output));
       break;
     case Compressor::ZSTD:
-      RETURN_NOT_OK(ZStd::compress(level_, &input_buffer, output));
+      RETURN_NOT_OK(ZStd::compress(
+          level_, zstd_dictionary_.get(), &input_buffer, output));
       break;
     case Compressor::LZ4:
       RETURN_NOT_OK(LZ4::compress(level_, &input_buffer, output));
@@ -315,7 +328,8 @@ Status CompressionFilter::decompress_part(
       st = GZip::decompress(&input_buffer, &output_buffer);
       break;
     case Compressor::ZSTD:
-      st = ZStd::decompress(&input_buffer, &output_buffer);
+      st = ZStd::decompress(
+          zstd_dictionary_.get(), &input_buffer, &output_buffer);
       break;
     case Compressor::LZ4:
       st = LZ4::decompress(&input_buffer, &output_buffer);
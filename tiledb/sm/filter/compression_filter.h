@@ -34,6 +34,7 @@
 #define TILEDB_COMPRESSION_FILTER_H
 
 #include "tiledb/sm/buffer/preallocated_buffer.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
 #include "tiledb/sm/enums/compressor.h"
 #include "tiledb/sm/filter/filter.h"
 #include "tiledb/sm/misc/status.h"
@@ -70,6 +71,11 @@ namespace sm {
  *
  * The reverse (decompress) output format is simply:
  *   uint8_t[] - Array of uncompressed bytes
+ *
+ * A zstd compression filter may be given a dictionary, which is not part of
+ * the filter's serialized metadata: the dictionary is stored separately (in
+ * the fragment metadata) and must be set again on the filter before
+ * decompressing.
  */
 class CompressionFilter : public Filter {
  public:
@@ -119,6 +125,15 @@ class CompressionFilter : public Filter {
   /** Set the compression level used by this filter instance. */
   void set_compression_level(int compressor_level);
 
+  /**
+   * Sets the dictionary of this filter, used only by the zstd compressor.
+   * If `nullptr`, the filter compresses without dictionary.
+   */
+  void set_zstd_dictionary(const std::shared_ptr<ZStdDictionary>& dict);
+
+  /** Returns the dictionary of this filter (may be `nullptr`). */
+  const std::shared_ptr<ZStdDictionary>& zstd_dictionary() const;
+
  private:
   /** The compressor. */
   Compressor compressor_;
@@ -126,6 +141,9 @@ class CompressionFilter : public Filter {
   /** The compression level. */
   int level_;
 
+  /** The zstd dictionary, not serialized with the filter. */
+  std::shared_ptr<ZStdDictionary> zstd_dictionary_;
+
   /** Returns a new clone of this filter. */
   CompressionFilter* clone_impl() const override;
 
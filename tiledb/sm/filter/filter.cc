@@ -31,9 +31,11 @@
  */
 
 #include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/filter/auto_filter.h"
 #include "tiledb/sm/filter/bit_width_reduction_filter.h"
 #include "tiledb/sm/filter/bitshuffle_filter.h"
 #include "tiledb/sm/filter/byteshuffle_filter.h"
+#include "tiledb/sm/filter/checksum_crc32c_filter.h"
 #include "tiledb/sm/filter/compression_filter.h"
 #include "tiledb/sm/filter/encryption_aes256gcm_filter.h"
 #include "tiledb/sm/filter/noop_filter.h"
@@ -75,6 +77,10 @@ Filter* Filter::create(FilterType type) {
       return new (std::nothrow) ByteshuffleFilter();
     case FilterType::FILTER_POSITIVE_DELTA:
       return new (std::nothrow) PositiveDeltaFilter();
+    case FilterType::FILTER_AUTO:
+      return new (std::nothrow) AutoFilter();
+    case FilterType::FILTER_CHECKSUM_CRC32C:
+      return new (std::nothrow) ChecksumCRC32CFilter();
     case FilterType::INTERNAL_FILTER_AES_256_GCM:
       return new (std::nothrow) EncryptionAES256GCMFilter();
     default:
@@ -172,6 +178,11 @@ Status Filter::serialize_impl(Buffer* buff) const {
 
 void Filter::set_pipeline(const FilterPipeline* pipeline) {
   pipeline_ = pipeline;
+  set_pipeline_impl(pipeline);
+}
+
+void Filter::set_pipeline_impl(const FilterPipeline* pipeline) {
+  (void)pipeline;
 }
 
 FilterType Filter::type() const {
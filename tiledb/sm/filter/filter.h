@@ -187,6 +187,13 @@ class Filter {
   /** Optional subclass specific get_option method. */
   virtual Status set_option_impl(FilterOption option, const void* value);
 
+  /**
+   * Optional subclass specific set_pipeline method, called after the
+   * pipeline of this filter is set, e.g., to set the pipeline of the filters
+   * the subclass executes internally.
+   */
+  virtual void set_pipeline_impl(const FilterPipeline* pipeline);
+
   /**
    * Serialization function that can be implemented by a specific Filter
    * subclass for filter-specific metadata.
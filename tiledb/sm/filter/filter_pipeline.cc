@@ -47,6 +47,7 @@ namespace sm {
 FilterPipeline::FilterPipeline() {
   current_tile_ = nullptr;
   max_chunk_size_ = constants::max_tile_chunk_size;
+  verify_checksums_ = constants::verify_checksums;
 }
 
 FilterPipeline::FilterPipeline(const FilterPipeline& other) {
@@ -55,6 +56,7 @@ FilterPipeline::FilterPipeline(const FilterPipeline& other) {
   }
   current_tile_ = other.current_tile_;
   max_chunk_size_ = other.max_chunk_size_;
+  verify_checksums_ = other.verify_checksums_;
 }
 
 FilterPipeline::FilterPipeline(FilterPipeline&& other) {
@@ -127,17 +129,18 @@ const Tile* FilterPipeline::current_tile() const {
 
 Status FilterPipeline::filter_chunks_forward(
     const std::vector<std::pair<void*, uint32_t>>& chunks,
-    Buffer* output) const {
+    Buffer* output,
+    ThreadPool* compute_tp) const {
   // Vector storing the input and output of the final pipeline stage for each
   // chunk.
   std::vector<std::pair<FilterBufferPair, FilterBufferPair>> final_stage_io(
       chunks.size());
 
   // Run each chunk through the entire pipeline.
-  auto statuses = parallel_for(0, chunks.size(), [&](uint64_t i) {
+  auto statuses = parallel_for(compute_tp, 0, chunks.size(), [&](uint64_t i) {
     // TODO(ttd): can we instead allocate one FilterStorage per thread?
     // or make it threadsafe?
-    FilterStorage storage;
+    FilterStorage storage(output->pool());
     FilterBuffer input_data(&storage), output_data(&storage);
     FilterBuffer input_metadata(&storage), output_metadata(&storage);
 
@@ -215,7 +218,7 @@ Status FilterPipeline::filter_chunks_forward(
 
   // Concatenate all processed chunks into the final output buffer.
   RETURN_NOT_OK(output->realloc(output->size() + total_processed_size));
-  statuses = parallel_for(0, final_stage_io.size(), [&](uint64_t i) {
+  statuses = parallel_for(compute_tp, 0, chunks.size(), [&](uint64_t i) {
     auto& final_stage_output_metadata = final_stage_io[i].first.first;
     auto& final_stage_output_data = final_stage_io[i].first.second;
     auto filtered_size = (uint32_t)final_stage_output_data.size();
@@ -255,7 +258,8 @@ Status FilterPipeline::filter_chunks_forward(
 
 Status FilterPipeline::filter_chunks_reverse(
     const std::vector<std::tuple<void*, uint32_t, uint32_t, uint32_t>>& chunks,
-    Buffer* output) const {
+    Buffer* output,
+    ThreadPool* compute_tp) const {
   // Precompute the offsets for the final chunks in the shared output buffer.
   std::vector<uint64_t> chunk_dest_offsets(chunks.size());
   uint64_t chunk_dest_offset = 0;
@@ -265,7 +269,7 @@ Status FilterPipeline::filter_chunks_reverse(
   }
 
   // Run each chunk through the entire pipeline.
-  auto statuses = parallel_for(0, chunks.size(), [&](uint64_t i) {
+  auto statuses = parallel_for(compute_tp, 0, chunks.size(), [&](uint64_t i) {
     const auto& chunk_input = chunks[i];
     uint32_t filtered_chunk_len = std::get<1>(chunk_input);
     uint32_t orig_chunk_len = std::get<2>(chunk_input);
@@ -275,7 +279,7 @@ Status FilterPipeline::filter_chunks_reverse(
 
     // TODO(ttd): can we instead allocate one FilterStorage per thread?
     // or make it threadsafe?
-    FilterStorage storage;
+    FilterStorage storage(output->pool());
     FilterBuffer input_data(&storage), output_data(&storage);
     FilterBuffer input_metadata(&storage), output_metadata(&storage);
 
@@ -348,7 +352,7 @@ uint32_t FilterPipeline::max_chunk_size() const {
   return max_chunk_size_;
 }
 
-Status FilterPipeline::run_forward(Tile* tile) const {
+Status FilterPipeline::run_forward(Tile* tile, ThreadPool* compute_tp) const {
   STATS_FUNC_IN(filter_pipeline_run_forward);
 
   current_tile_ = tile;
@@ -366,12 +370,12 @@ Status FilterPipeline::run_forward(Tile* tile) const {
 
   // Allocate a buffer to hold the end result (the concatentated, filtered
   // chunks), and write the number of chunks.
-  Buffer filtered_tile;
+  Buffer filtered_tile(tile->buffer()->pool());
   filtered_tile.realloc(tile->buffer()->size());
   RETURN_NOT_OK(filtered_tile.write(&num_chunks, sizeof(uint64_t)));
 
   // Run the filters over all the chunks into the filtered_tile buffer.
-  RETURN_NOT_OK(filter_chunks_forward(chunks, &filtered_tile));
+  RETURN_NOT_OK(filter_chunks_forward(chunks, &filtered_tile, compute_tp));
 
   // Replace the tile's buffer with the filtered buffer.
   RETURN_NOT_OK(tile->buffer()->swap(filtered_tile));
@@ -381,7 +385,7 @@ Status FilterPipeline::run_forward(Tile* tile) const {
   STATS_FUNC_OUT(filter_pipeline_run_forward);
 }
 
-Status FilterPipeline::run_reverse(Tile* tile) const {
+Status FilterPipeline::run_reverse(Tile* tile, ThreadPool* compute_tp) const {
   STATS_FUNC_IN(filter_pipeline_run_reverse);
 
   auto tile_buff = tile->buffer();
@@ -415,12 +419,12 @@ Status FilterPipeline::run_reverse(Tile* tile) const {
 
   // Allocate a buffer to hold the end result (the assembled, unfiltered
   // chunks).
-  Buffer unfiltered_tile;
+  Buffer unfiltered_tile(tile_buff->pool());
   RETURN_NOT_OK(unfiltered_tile.realloc(total_orig_size));
 
   // Run the filters in reverse over all the chunks into the unfiltered_tile
   // buffer.
-  RETURN_NOT_OK(filter_chunks_reverse(chunks, &unfiltered_tile));
+  RETURN_NOT_OK(filter_chunks_reverse(chunks, &unfiltered_tile, compute_tp));
 
   // Replace the tile's buffer with the unfiltered buffer.
   RETURN_NOT_OK(tile->buffer()->swap(unfiltered_tile));
@@ -488,6 +492,24 @@ void FilterPipeline::set_max_chunk_size(uint32_t max_chunk_size) {
   max_chunk_size_ = max_chunk_size;
 }
 
+void FilterPipeline::set_verify_checksums(bool verify_checksums) {
+  verify_checksums_ = verify_checksums;
+}
+
+void FilterPipeline::set_zstd_dictionary(
+    const std::shared_ptr<ZStdDictionary>& dict) {
+  for (auto& f : filters_) {
+    auto compression_filter = dynamic_cast<CompressionFilter*>(f.get());
+    if (compression_filter != nullptr &&
+        compression_filter->compressor() == Compressor::ZSTD)
+      compression_filter->set_zstd_dictionary(dict);
+  }
+}
+
+bool FilterPipeline::verify_checksums() const {
+  return verify_checksums_;
+}
+
 unsigned FilterPipeline::size() const {
   return static_cast<unsigned>(filters_.size());
 }
@@ -503,6 +525,7 @@ void FilterPipeline::swap(FilterPipeline& other) {
 
   std::swap(current_tile_, other.current_tile_);
   std::swap(max_chunk_size_, other.max_chunk_size_);
+  std::swap(verify_checksums_, other.verify_checksums_);
 }
 
 Status FilterPipeline::append_encryption_filter(
@@ -34,6 +34,7 @@
 #define TILEDB_FILTER_PIPELINE_H
 
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
 #include "tiledb/sm/encryption/encryption_key.h"
 #include "tiledb/sm/enums/encryption_type.h"
 #include "tiledb/sm/filter/filter.h"
@@ -46,6 +47,7 @@
 namespace tiledb {
 namespace sm {
 
+class ThreadPool;
 class Tile;
 
 /**
@@ -164,9 +166,11 @@ class FilterPipeline {
    * data.
    *
    * @param tile Tile to filter.
+   * @param compute_tp Optional thread pool on which the chunks are filtered.
+   *    If null, the chunks are filtered on the calling thread.
    * @return Status
    */
-  Status run_forward(Tile* tile) const;
+  Status run_forward(Tile* tile, ThreadPool* compute_tp = nullptr) const;
 
   /**
    * Runs the pipeline in reverse on the given filtered tile. This is used
@@ -201,9 +205,11 @@ class FilterPipeline {
    * to N.
    *
    * @param tile Tile to filter
+   * @param compute_tp Optional thread pool on which the chunks are
+   *    unfiltered. If null, the chunks are unfiltered on the calling thread.
    * @return Status
    */
-  Status run_reverse(Tile* tile) const;
+  Status run_reverse(Tile* tile, ThreadPool* compute_tp = nullptr) const;
 
   /**
    * Serializes the pipeline metadata into a binary buffer.
@@ -216,9 +222,25 @@ class FilterPipeline {
   /** Sets the maximum tile chunk size. */
   void set_max_chunk_size(uint32_t max_chunk_size);
 
+  /**
+   * Sets whether the checksum filters in the pipeline verify the checksums
+   * of the chunks in the reverse direction. This is not serialized.
+   */
+  void set_verify_checksums(bool verify_checksums);
+
+  /**
+   * Sets the dictionary of the zstd compression filters in the pipeline.
+   *
+   * @param dict The dictionary, or `nullptr` to compress without dictionary.
+   */
+  void set_zstd_dictionary(const std::shared_ptr<ZStdDictionary>& dict);
+
   /** Returns the number of filters in the pipeline. */
   unsigned size() const;
 
+  /** Returns `true` if the checksum filters verify the chunk checksums. */
+  bool verify_checksums() const;
+
   /** Swaps the contents of this pipeline with the given pipeline. */
   void swap(FilterPipeline& other);
 
@@ -248,6 +270,9 @@ class FilterPipeline {
   /** The max chunk size allowed within tiles. */
   uint32_t max_chunk_size_;
 
+  /** Whether the checksum filters verify the chunk checksums. */
+  bool verify_checksums_;
+
   /**
    * Compute chunks of the given tile, used in the forward direction.
    *
@@ -263,11 +288,13 @@ class FilterPipeline {
    *
    * @param chunks Chunks to process
    * @param output Buffer where output of last stage will be written.
+   * @param compute_tp Thread pool to process the chunks on (may be null).
    * @return Status
    */
   Status filter_chunks_forward(
       const std::vector<std::pair<void*, uint32_t>>& chunks,
-      Buffer* output) const;
+      Buffer* output,
+      ThreadPool* compute_tp) const;
 
   /**
    * Run the given list of chunks in reverse through the pipeline.
@@ -275,12 +302,14 @@ class FilterPipeline {
    * @param chunks Chunks to process. Format is
    *    (data ptr, filtered size, original size, metadata size).
    * @param output Buffer where output of last stage will be written.
+   * @param compute_tp Thread pool to process the chunks on (may be null).
    * @return Status
    */
   Status filter_chunks_reverse(
       const std::vector<std::tuple<void*, uint32_t, uint32_t, uint32_t>>&
           chunks,
-      Buffer* output) const;
+      Buffer* output,
+      ThreadPool* compute_tp) const;
 };
 
 }  // namespace sm
@@ -35,9 +35,17 @@
 namespace tiledb {
 namespace sm {
 
+FilterStorage::FilterStorage()
+    : buffer_pool_(nullptr) {
+}
+
+FilterStorage::FilterStorage(BufferPool* buffer_pool)
+    : buffer_pool_(buffer_pool) {
+}
+
 std::shared_ptr<Buffer> FilterStorage::get_buffer() {
   if (available_.empty())
-    available_.emplace_back(new Buffer());
+    available_.emplace_back(new Buffer(buffer_pool_));
 
   std::shared_ptr<Buffer> buf = std::move(available_.front());
   Buffer* buf_ptr = buf.get();
@@ -48,6 +48,17 @@ namespace sm {
  */
 class FilterStorage {
  public:
+  /** Constructor. */
+  FilterStorage();
+
+  /**
+   * Constructor.
+   *
+   * @param buffer_pool The pool that the managed buffers allocate from. If
+   *     `nullptr`, the system allocator is used.
+   */
+  explicit FilterStorage(BufferPool* buffer_pool);
+
   /**
    * Return a buffer from the pool, allocating a new one if necessary. The
    * buffer returned by this function will not be available for reuse until it
@@ -76,6 +87,9 @@ class FilterStorage {
   Status reclaim(Buffer* buffer);
 
  private:
+  /** The pool that the managed buffers allocate from (may be `nullptr`). */
+  BufferPool* buffer_pool_;
+
   /** List of buffers that are available to be used (may be empty). */
   std::list<std::shared_ptr<Buffer>> available_;
 
@@ -36,6 +36,7 @@
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/utils.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
 
 #include <cassert>
 #include <iostream>
@@ -67,6 +68,7 @@ FragmentMetadata::FragmentMetadata(
   non_empty_domain_ = nullptr;
   version_ = constants::format_version;
   tile_index_base_ = 0;
+  footer_offset_ = 0;
   auto attributes = array_schema_->attributes();
   for (unsigned i = 0; i < attributes.size(); ++i) {
     auto attr_name = attributes[i]->name();
@@ -80,6 +82,13 @@ FragmentMetadata::FragmentMetadata(
   attribute_idx_map_[constants::coords] = array_schema_->attribute_num();
   attribute_uri_map_[constants::coords] =
       fragment_uri_.join_path(constants::coords + constants::file_suffix);
+  auto dim_num = array_schema_->dim_num();
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim_name = coords_dim_name(d);
+    attribute_idx_map_[dim_name] = array_schema_->attribute_num() + 1 + d;
+    attribute_uri_map_[dim_name] =
+        fragment_uri_.join_path(dim_name + constants::file_suffix);
+  }
 }
 
 FragmentMetadata::~FragmentMetadata() {
@@ -116,6 +125,10 @@ void FragmentMetadata::set_bounding_coords(
   bounding_coords_[tile] = new_bounding_coords;
 }
 
+void FragmentMetadata::set_footer_offset(uint64_t offset) {
+  footer_offset_ = offset;
+}
+
 Status FragmentMetadata::set_mbr(uint64_t tile, const void* mbr) {
   switch (array_schema_->coords_type()) {
     case Datatype::INT8:
@@ -189,6 +202,22 @@ void FragmentMetadata::set_tile_var_size(
   tile_var_sizes_[attribute_id][tile] = size;
 }
 
+void FragmentMetadata::set_zstd_dictionary(
+    const std::string& attribute,
+    const std::shared_ptr<ZStdDictionary>& dict) {
+  auto attribute_id = attribute_idx_map_[attribute];
+  assert(attribute_id < zstd_dictionaries_.size());
+  zstd_dictionaries_[attribute_id] = dict;
+}
+
+bool FragmentMetadata::stores_section(unsigned section) const {
+  assert(section < section_num());
+  auto attribute_num = array_schema_->attribute_num();
+  if (section < attribute_num || section == section_num() - 1)
+    return true;
+  return (section == attribute_num) != split_coords();
+}
+
 uint64_t FragmentMetadata::cell_num(uint64_t tile_pos) const {
   if (dense_)
     return array_schema_->domain()->cell_num_per_tile();
@@ -325,12 +354,108 @@ Status FragmentMetadata::add_est_read_buffer_sizes_sparse(
   return Status::Ok();
 }
 
+template <class T>
+Status FragmentMetadata::add_est_read_buffer_sizes_histogram(
+    const T* subarray,
+    const std::vector<uint64_t>* tile_ids,
+    unsigned dim,
+    const std::vector<T>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const {
+  auto dim_num = array_schema_->dim_num();
+  std::vector<T> tile_overlap(2 * dim_num);
+  bool overlap;
+
+  // Sparse fragments: histogram the (candidate) MBRs
+  if (!dense_) {
+    auto mbr_num = (uint64_t)mbrs_.size();
+    auto tile_num = (tile_ids == nullptr) ? mbr_num : tile_ids->size();
+    for (uint64_t i = 0; i < tile_num; ++i) {
+      auto tid = (tile_ids == nullptr) ? i : (*tile_ids)[i];
+      assert(tid < mbr_num);
+      auto mbr = (const T*)mbrs_[tid];
+      utils::geometry::overlap(
+          mbr, subarray, dim_num, &tile_overlap[0], &overlap);
+      if (overlap)
+        add_tile_est_to_histogram(
+            tid,
+            mbr,
+            &tile_overlap[0],
+            dim,
+            bucket_bounds,
+            attributes,
+            histogram,
+            overlapping);
+    }
+    return Status::Ok();
+  }
+
+  // Dense fragments: walk the tiles overlapping the subarray
+  auto metadata_domain = static_cast<const T*>(domain_);
+  if (!utils::geometry::overlap(subarray, metadata_domain, dim_num))
+    return Status::Ok();
+
+  std::vector<T> subarray_tile_domain(2 * dim_num);
+  get_subarray_tile_domain(subarray, &subarray_tile_domain[0]);
+  std::vector<T> tile_subarray(2 * dim_num);
+  std::vector<T> tile_coords(dim_num);
+  for (unsigned i = 0; i < dim_num; ++i)
+    tile_coords[i] = subarray_tile_domain[2 * i];
+
+  auto domain = array_schema_->domain();
+  do {
+    domain->get_tile_subarray(
+        metadata_domain, &tile_coords[0], &tile_subarray[0]);
+    utils::geometry::overlap(
+        subarray, &tile_subarray[0], dim_num, &tile_overlap[0], &overlap);
+    assert(overlap);
+    auto tid = domain->get_tile_pos(metadata_domain, &tile_coords[0]);
+    add_tile_est_to_histogram(
+        tid,
+        &tile_subarray[0],
+        &tile_overlap[0],
+        dim,
+        bucket_bounds,
+        attributes,
+        histogram,
+        overlapping);
+    domain->get_next_tile_coords(&subarray_tile_domain[0], &tile_coords[0]);
+  } while (utils::geometry::coords_in_rect(
+      &tile_coords[0], &subarray_tile_domain[0], dim_num));
+
+  return Status::Ok();
+}
+
 bool FragmentMetadata::dense() const {
   return dense_;
 }
 
 Status FragmentMetadata::deserialize(ConstBuffer* buf) {
   RETURN_NOT_OK(load_version(buf));
+
+  // The buffer holds only the footer; the sections are loaded on demand
+  if (version_ >= constants::fragment_metadata_sections_version) {
+    RETURN_NOT_OK(load_non_empty_domain(buf));
+    RETURN_NOT_OK(load_last_tile_cell_num(buf));
+    RETURN_NOT_OK(load_file_sizes(buf));
+    RETURN_NOT_OK(load_file_var_sizes(buf));
+    RETURN_NOT_OK(load_section_offsets(buf));
+
+    // Only sparse fragments have (zipped or per-dimension) coordinate files
+    auto attribute_num = array_schema_->attribute_num();
+    dense_ = true;
+    for (auto i = attribute_num; i < file_sizes_.size(); ++i)
+      dense_ = dense_ && file_sizes_[i] == 0;
+
+    tile_offsets_.resize(tile_offsets_num());
+    tile_var_offsets_.resize(attribute_num);
+    tile_var_sizes_.resize(attribute_num);
+    zstd_dictionaries_.resize(attribute_num);
+    sections_loaded_.assign(section_num(), false);
+    return Status::Ok();
+  }
+
   RETURN_NOT_OK(load_non_empty_domain(buf));
   RETURN_NOT_OK(load_mbrs(buf));
   RETURN_NOT_OK(load_bounding_coords(buf));
@@ -340,6 +465,10 @@ Status FragmentMetadata::deserialize(ConstBuffer* buf) {
   RETURN_NOT_OK(load_last_tile_cell_num(buf));
   RETURN_NOT_OK(load_file_sizes(buf));
   RETURN_NOT_OK(load_file_var_sizes(buf));
+
+  // Only sparse fragments have MBRs
+  dense_ = mbrs_.empty();
+
   return Status::Ok();
 }
 
@@ -363,6 +492,19 @@ uint32_t FragmentMetadata::format_version() const {
   return version_;
 }
 
+uint64_t FragmentMetadata::fragment_size() const {
+  uint64_t size = 0;
+  for (auto file_size : file_sizes_)
+    size += file_size;
+  for (auto file_var_size : file_var_sizes_)
+    size += file_var_size;
+  return size;
+}
+
+bool FragmentMetadata::split_coords() const {
+  return !dense_ && version_ >= constants::split_coords_version;
+}
+
 const URI& FragmentMetadata::fragment_uri() const {
   return fragment_uri_;
 }
@@ -416,9 +558,10 @@ Status FragmentMetadata::init(const void* non_empty_domain) {
   last_tile_cell_num_ = 0;
 
   // Initialize tile offsets
-  tile_offsets_.resize(attribute_num + 1);
-  next_tile_offsets_.resize(attribute_num + 1);
-  for (unsigned int i = 0; i < attribute_num + 1; ++i)
+  auto tile_offsets_num = this->tile_offsets_num();
+  tile_offsets_.resize(tile_offsets_num);
+  next_tile_offsets_.resize(tile_offsets_num);
+  for (unsigned int i = 0; i < tile_offsets_num; ++i)
     next_tile_offsets_[i] = 0;
 
   // Initialize variable tile offsets
@@ -430,6 +573,9 @@ Status FragmentMetadata::init(const void* non_empty_domain) {
   // Initialize variable tile sizes
   tile_var_sizes_.resize(attribute_num);
 
+  // Initialize zstd dictionaries
+  zstd_dictionaries_.resize(attribute_num);
+
   return Status::Ok();
 }
 
@@ -437,6 +583,62 @@ uint64_t FragmentMetadata::last_tile_cell_num() const {
   return last_tile_cell_num_;
 }
 
+Status FragmentMetadata::load_sections(
+    StorageManager* storage_manager,
+    const EncryptionKey& encryption_key,
+    const std::vector<std::string>& attributes) {
+  std::lock_guard<std::mutex> lock(sections_mtx_);
+
+  // Nothing to do if the entire metadata is in memory
+  if (sections_loaded_.empty())
+    return Status::Ok();
+
+  // Find the sections to load
+  auto attribute_num = array_schema_->attribute_num();
+  std::vector<unsigned> sections;
+  for (const auto& attr : attributes) {
+    auto it = attribute_idx_map_.find(attr);
+    if (it == attribute_idx_map_.end())
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot load fragment metadata; Invalid attribute '" + attr + "'"));
+    sections.push_back(it->second);
+  }
+  if (!dense_) {
+    if (split_coords()) {
+      auto dim_num = array_schema_->dim_num();
+      for (unsigned d = 0; d < dim_num; ++d)
+        sections.push_back(attribute_num + 1 + d);
+    } else {
+      sections.push_back(attribute_num);
+    }
+    sections.push_back(section_num() - 1);
+  }
+
+  // Load each missing section from its own generic tile, which ends where
+  // the next section (or the footer) begins
+  for (auto s : sections) {
+    if (sections_loaded_[s])
+      continue;
+    auto offset = section_offsets_[s];
+    uint64_t end = 0;
+    for (auto next : section_offsets_) {
+      if (next > offset && (end == 0 || next < end))
+        end = next;
+    }
+    if (end == 0)
+      end = footer_offset_;
+    uint64_t max_size = (end > offset) ? end - offset : 0;
+    Buffer buff;
+    RETURN_NOT_OK(storage_manager->load_fragment_metadata_section(
+        fragment_uri_, offset, max_size, encryption_key, &buff));
+    ConstBuffer cbuff(&buff);
+    RETURN_NOT_OK(load_section(s, &cbuff));
+    sections_loaded_[s] = true;
+  }
+
+  return Status::Ok();
+}
+
 const std::vector<void*>& FragmentMetadata::mbrs() const {
   return mbrs_;
 }
@@ -445,25 +647,42 @@ const void* FragmentMetadata::non_empty_domain() const {
   return non_empty_domain_;
 }
 
-Status FragmentMetadata::serialize(Buffer* buf) {
+unsigned FragmentMetadata::section_num() const {
+  return tile_offsets_num() + 1;
+}
+
+Status FragmentMetadata::serialize_footer(
+    const std::vector<uint64_t>& section_offsets, Buffer* buf) {
+  assert(section_offsets.size() == section_num());
   RETURN_NOT_OK(write_version(buf));
   RETURN_NOT_OK(write_non_empty_domain(buf));
-  RETURN_NOT_OK(write_mbrs(buf));
-  RETURN_NOT_OK(write_bounding_coords(buf));
-  RETURN_NOT_OK(write_tile_offsets(buf));
-  RETURN_NOT_OK(write_tile_var_offsets(buf));
-  RETURN_NOT_OK(write_tile_var_sizes(buf));
   RETURN_NOT_OK(write_last_tile_cell_num(buf));
   RETURN_NOT_OK(write_file_sizes(buf));
   RETURN_NOT_OK(write_file_var_sizes(buf));
+  RETURN_NOT_OK(write_section_offsets(section_offsets, buf));
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::serialize_section(unsigned section, Buffer* buf) {
+  assert(section < section_num());
+
+  // Attribute and coordinates sections
+  if (section < tile_offsets_num())
+    return write_attribute_section(section, buf);
+
+  // MBR section
+  RETURN_NOT_OK(write_mbrs(buf));
+  RETURN_NOT_OK(write_bounding_coords(buf));
 
   return Status::Ok();
 }
 
 Status FragmentMetadata::set_num_tiles(uint64_t num_tiles) {
   auto num_attributes = array_schema_->attribute_num();
+  auto tile_offsets_num = this->tile_offsets_num();
 
-  for (unsigned i = 0; i < num_attributes + 1; i++) {
+  for (unsigned i = 0; i < tile_offsets_num; i++) {
     assert(num_tiles >= tile_offsets_[i].size());
     tile_offsets_[i].resize(num_tiles, 0);
     if (i < num_attributes) {
@@ -499,6 +718,10 @@ URI FragmentMetadata::attr_uri(const std::string& attribute) const {
   return attribute_uri_map_.at(attribute);
 }
 
+std::string FragmentMetadata::coords_dim_name(unsigned dim_idx) {
+  return constants::coords + "_" + std::to_string(dim_idx);
+}
+
 URI FragmentMetadata::attr_var_uri(const std::string& attribute) const {
   return attribute_var_uri_map_.at(attribute);
 }
@@ -544,8 +767,15 @@ uint64_t FragmentMetadata::persisted_tile_var_size(
 
 uint64_t FragmentMetadata::tile_size(
     const std::string& attribute, uint64_t tile_idx) const {
-  auto var_size = array_schema_->var_size(attribute);
   auto cell_num = this->cell_num(tile_idx);
+
+  // Split coordinates of a single dimension
+  auto it = attribute_idx_map_.find(attribute);
+  if (it != attribute_idx_map_.end() &&
+      it->second > array_schema_->attribute_num())
+    return cell_num * datatype_size(array_schema_->coords_type());
+
+  auto var_size = array_schema_->var_size(attribute);
   return (var_size) ? cell_num * constants::cell_var_offset_size :
                       cell_num * array_schema_->cell_size(attribute);
 }
@@ -561,6 +791,15 @@ uint64_t FragmentMetadata::timestamp() const {
   return timestamp_;
 }
 
+std::shared_ptr<ZStdDictionary> FragmentMetadata::zstd_dictionary(
+    const std::string& attribute) const {
+  auto it = attribute_idx_map_.find(attribute);
+  if (it == attribute_idx_map_.end() ||
+      it->second >= zstd_dictionaries_.size())
+    return nullptr;
+  return zstd_dictionaries_[it->second];
+}
+
 bool FragmentMetadata::operator<(const FragmentMetadata& metadata) const {
   return (timestamp_ < metadata.timestamp_) ||
          (timestamp_ == metadata.timestamp_ &&
@@ -659,6 +898,50 @@ FragmentMetadata::compute_overlapping_tile_ids_cov(const T* subarray) const {
   return tids;
 }
 
+template <class T>
+void FragmentMetadata::add_tile_est_to_histogram(
+    uint64_t tid,
+    const T* tile_subarray,
+    T* tile_overlap,
+    unsigned dim,
+    const std::vector<T>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const {
+  auto dim_num = array_schema_->dim_num();
+  auto attribute_num = attributes.size();
+  auto bucket_num = (uint64_t)bucket_bounds.size() / 2;
+  T low = tile_overlap[2 * dim], high = tile_overlap[2 * dim + 1];
+
+  // Find the first bucket ending at or after the start of the overlap
+  uint64_t first = 0, last = bucket_num;
+  while (first < last) {
+    auto mid = first + (last - first) / 2;
+    if (bucket_bounds[2 * mid + 1] < low)
+      first = mid + 1;
+    else
+      last = mid;
+  }
+
+  // Distribute the tile estimate to the buckets the overlap intersects
+  for (auto b = first; b < bucket_num && bucket_bounds[2 * b] <= high; ++b) {
+    tile_overlap[2 * dim] = MAX(low, bucket_bounds[2 * b]);
+    tile_overlap[2 * dim + 1] = MIN(high, bucket_bounds[2 * b + 1]);
+    double cov =
+        utils::geometry::coverage(tile_overlap, tile_subarray, dim_num);
+    (*overlapping)[b] = true;
+    for (size_t a = 0; a < attribute_num; ++a) {
+      auto& entry = (*histogram)[b * attribute_num + a];
+      entry.first += cov * tile_size(attributes[a], tid);
+      if (array_schema_->var_size(attributes[a]))
+        entry.second += cov * tile_var_size(attributes[a], tid);
+    }
+  }
+
+  tile_overlap[2 * dim] = low;
+  tile_overlap[2 * dim + 1] = high;
+}
+
 template <class T>
 void FragmentMetadata::get_subarray_tile_domain(
     const T* subarray, T* subarray_tile_domain) const {
@@ -706,6 +989,88 @@ Status FragmentMetadata::expand_non_empty_domain(const T* mbr) {
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// tile_offsets_num (uint64_t)
+// tile_offsets_#1 (uint64_t) tile_offsets_#2 (uint64_t) ...
+// (only for attributes, i.e., not for the coordinates)
+// tile_var_offsets_num (uint64_t)
+// tile_var_offsets_#1 (uint64_t) tile_var_offsets_#2 (uint64_t) ...
+// tile_var_sizes_num (uint64_t)
+// tile_var_sizes_#1 (uint64_t) tile_var_sizes_#2 (uint64_t) ...
+// (from `constants::zstd_dictionary_version` on)
+// zstd_dictionary_size (uint64_t)
+// zstd_dictionary (uint8_t[]), absent if the size is 0
+Status FragmentMetadata::load_attribute_section(
+    unsigned attribute_id, ConstBuffer* buff) {
+  // Get tile offsets
+  uint64_t tile_offsets_num = 0;
+  Status st = buff->read(&tile_offsets_num, sizeof(uint64_t));
+  if (st.ok() && tile_offsets_num != 0) {
+    tile_offsets_[attribute_id].resize(tile_offsets_num);
+    st = buff->read(
+        &tile_offsets_[attribute_id][0], tile_offsets_num * sizeof(uint64_t));
+  }
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading tile offsets failed"));
+  }
+
+  // The coordinates have no variable tiles
+  if (attribute_id >= array_schema_->attribute_num())
+    return Status::Ok();
+
+  // Get variable tile offsets
+  uint64_t tile_var_offsets_num = 0;
+  st = buff->read(&tile_var_offsets_num, sizeof(uint64_t));
+  if (st.ok() && tile_var_offsets_num != 0) {
+    tile_var_offsets_[attribute_id].resize(tile_var_offsets_num);
+    st = buff->read(
+        &tile_var_offsets_[attribute_id][0],
+        tile_var_offsets_num * sizeof(uint64_t));
+  }
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading variable tile offsets "
+        "failed"));
+  }
+
+  // Get variable tile sizes
+  uint64_t tile_var_sizes_num = 0;
+  st = buff->read(&tile_var_sizes_num, sizeof(uint64_t));
+  if (st.ok() && tile_var_sizes_num != 0) {
+    tile_var_sizes_[attribute_id].resize(tile_var_sizes_num);
+    st = buff->read(
+        &tile_var_sizes_[attribute_id][0],
+        tile_var_sizes_num * sizeof(uint64_t));
+  }
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading variable tile sizes failed"));
+  }
+
+  if (version_ < constants::zstd_dictionary_version)
+    return Status::Ok();
+
+  // Get zstd dictionary
+  uint64_t zstd_dictionary_size = 0;
+  st = buff->read(&zstd_dictionary_size, sizeof(uint64_t));
+  if (st.ok() && zstd_dictionary_size != 0) {
+    if (zstd_dictionary_size > buff->nbytes_left_to_read()) {
+      st = Status::FragmentMetadataError("Invalid dictionary size");
+    } else {
+      zstd_dictionaries_[attribute_id] = std::make_shared<ZStdDictionary>(
+          buff->cur_data(), zstd_dictionary_size);
+      buff->advance_offset(zstd_dictionary_size);
+    }
+  }
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading zstd dictionary failed"));
+  }
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 //  bounding_coords_num (uint64_t)
 //  bounding_coords_#1 (void*) bounding_coords_#2 (void*) ...
@@ -741,11 +1106,14 @@ Status FragmentMetadata::load_bounding_coords(ConstBuffer* buff) {
 // file_sizes_attr#0 (uint64_t)
 // ...
 // file_sizes_attr#attribute_num (uint64_t)
+// file_sizes_dim#0 (uint64_t) (from split_coords_version on)
+// ...
+// file_sizes_dim#<dim_num-1> (uint64_t) (from split_coords_version on)
 Status FragmentMetadata::load_file_sizes(ConstBuffer* buff) {
-  unsigned int attribute_num = array_schema_->attribute_num();
-  file_sizes_.resize(attribute_num + 1);
+  auto tile_offsets_num = this->tile_offsets_num();
+  file_sizes_.resize(tile_offsets_num);
   Status st =
-      buff->read(&file_sizes_[0], (attribute_num + 1) * sizeof(uint64_t));
+      buff->read(&file_sizes_[0], tile_offsets_num * sizeof(uint64_t));
 
   if (!st.ok()) {
     return LOG_STATUS(Status::FragmentMetadataError(
@@ -973,6 +1341,39 @@ Status FragmentMetadata::load_tile_var_sizes(ConstBuffer* buff) {
   return Status::Ok();
 }
 
+Status FragmentMetadata::load_section(unsigned section, ConstBuffer* buff) {
+  // Attribute and coordinates sections
+  if (section < tile_offsets_num())
+    return load_attribute_section(section, buff);
+
+  // MBR section
+  RETURN_NOT_OK(load_mbrs(buff));
+  RETURN_NOT_OK(load_bounding_coords(buff));
+  return Status::Ok();
+}
+
+// ===== FORMAT =====
+// section_num (uint64_t)
+// section_offset_#1 (uint64_t) section_offset_#2 (uint64_t) ...
+Status FragmentMetadata::load_section_offsets(ConstBuffer* buff) {
+  uint64_t section_offsets_num = 0;
+  Status st = buff->read(&section_offsets_num, sizeof(uint64_t));
+  if (!st.ok() || section_offsets_num != section_num()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of sections failed"));
+  }
+
+  section_offsets_.resize(section_offsets_num);
+  st = buff->read(
+      &section_offsets_[0], section_offsets_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading section offsets failed"));
+  }
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // version (uint32_t)
 Status FragmentMetadata::load_version(ConstBuffer* buff) {
@@ -980,6 +1381,80 @@ Status FragmentMetadata::load_version(ConstBuffer* buff) {
   return Status::Ok();
 }
 
+unsigned FragmentMetadata::tile_offsets_num() const {
+  auto attribute_num = array_schema_->attribute_num();
+  if (version_ < constants::split_coords_version)
+    return attribute_num + 1;
+  return attribute_num + 1 + array_schema_->dim_num();
+}
+
+// ===== FORMAT =====
+// tile_offsets_num (uint64_t)
+// tile_offsets_#1 (uint64_t) tile_offsets_#2 (uint64_t) ...
+// (only for attributes, i.e., not for the coordinates)
+// tile_var_offsets_num (uint64_t)
+// tile_var_offsets_#1 (uint64_t) tile_var_offsets_#2 (uint64_t) ...
+// tile_var_sizes_num (uint64_t)
+// tile_var_sizes_#1 (uint64_t) tile_var_sizes_#2 (uint64_t) ...
+// zstd_dictionary_size (uint64_t)
+// zstd_dictionary (uint8_t[]), absent if the size is 0
+Status FragmentMetadata::write_attribute_section(
+    unsigned attribute_id, Buffer* buff) {
+  // Write tile offsets
+  uint64_t tile_offsets_num = tile_offsets_[attribute_id].size();
+  Status st = buff->write(&tile_offsets_num, sizeof(uint64_t));
+  if (st.ok() && tile_offsets_num != 0)
+    st = buff->write(
+        &tile_offsets_[attribute_id][0], tile_offsets_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing tile offsets failed"));
+  }
+
+  // The coordinates have no variable tiles
+  if (attribute_id >= array_schema_->attribute_num())
+    return Status::Ok();
+
+  // Write variable tile offsets
+  uint64_t tile_var_offsets_num = tile_var_offsets_[attribute_id].size();
+  st = buff->write(&tile_var_offsets_num, sizeof(uint64_t));
+  if (st.ok() && tile_var_offsets_num != 0)
+    st = buff->write(
+        &tile_var_offsets_[attribute_id][0],
+        tile_var_offsets_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing variable tile offsets "
+        "failed"));
+  }
+
+  // Write variable tile sizes
+  uint64_t tile_var_sizes_num = tile_var_sizes_[attribute_id].size();
+  st = buff->write(&tile_var_sizes_num, sizeof(uint64_t));
+  if (st.ok() && tile_var_sizes_num != 0)
+    st = buff->write(
+        &tile_var_sizes_[attribute_id][0],
+        tile_var_sizes_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing variable tile sizes "
+        "failed"));
+  }
+
+  // Write zstd dictionary
+  const auto& dict = zstd_dictionaries_[attribute_id];
+  uint64_t zstd_dictionary_size = dict == nullptr ? 0 : dict->size();
+  st = buff->write(&zstd_dictionary_size, sizeof(uint64_t));
+  if (st.ok() && zstd_dictionary_size != 0)
+    st = buff->write(dict->data(), zstd_dictionary_size);
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing zstd dictionary failed"));
+  }
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // bounding_coords_num(uint64_t)
 // bounding_coords_#1(void*) bounding_coords_#2(void*) ...
@@ -1011,10 +1486,12 @@ Status FragmentMetadata::write_bounding_coords(Buffer* buff) {
 // file_sizes_attr#0 (uint64_t)
 // ...
 // file_sizes_attr#attribute_num (uint64_t)
+// file_sizes_dim#0 (uint64_t) (from split_coords_version on)
+// ...
+// file_sizes_dim#<dim_num-1> (uint64_t) (from split_coords_version on)
 Status FragmentMetadata::write_file_sizes(Buffer* buff) {
-  unsigned int attribute_num = array_schema_->attribute_num();
   Status st = buff->write(
-      &next_tile_offsets_[0], (attribute_num + 1) * sizeof(uint64_t));
+      &next_tile_offsets_[0], tile_offsets_num() * sizeof(uint64_t));
   if (!st.ok()) {
     return LOG_STATUS(Status::FragmentMetadataError(
         "Cannot serialize fragment metadata; Writing file sizes failed"));
@@ -1112,117 +1589,27 @@ Status FragmentMetadata::write_non_empty_domain(Buffer* buff) {
 }
 
 // ===== FORMAT =====
-// tile_offsets_attr#0_num(uint64_t)
-// tile_offsets_attr#0_#1 (uint64_t) tile_offsets_attr#0_#2 (uint64_t) ...
-// ...
-// tile_offsets_attr#<attribute_num>_num(uint64_t)
-// tile_offsets_attr#<attribute_num>_#1 (uint64_t)
-// tile_offsets_attr#<attribute_num>_#2 (uint64_t) ...
-Status FragmentMetadata::write_tile_offsets(Buffer* buff) {
-  Status st;
-  unsigned int attribute_num = array_schema_->attribute_num();
-
-  // Write tile offsets for each attribute
-  for (unsigned int i = 0; i < attribute_num + 1; ++i) {
-    // Write number of tile offsets
-    uint64_t tile_offsets_num = tile_offsets_[i].size();
-    st = buff->write(&tile_offsets_num, sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot serialize fragment metadata; Writing number of tile offsets "
-          "failed"));
-    }
-
-    if (tile_offsets_num == 0)
-      continue;
-
-    // Write tile offsets
-    st = buff->write(&tile_offsets_[i][0], tile_offsets_num * sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot serialize fragment metadata; Writing tile offsets failed"));
-    }
+// section_num (uint64_t)
+// section_offset_#1 (uint64_t) section_offset_#2 (uint64_t) ...
+Status FragmentMetadata::write_section_offsets(
+    const std::vector<uint64_t>& section_offsets, Buffer* buff) {
+  auto section_num = (uint64_t)section_offsets.size();
+  Status st = buff->write(&section_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing number of sections "
+        "failed"));
   }
 
-  return Status::Ok();
-}
-
-// ===== FORMAT =====
-// tile_var_offsets_attr#0_num(uint64_t)
-// tile_var_offsets_attr#0_#1 (uint64_t) tile_var_offsets_attr#0_#2 (uint64_t)
-// ...
-// ...
-// tile_var_offsets_attr#<attribute_num-1>_num(uint64_t)
-// tile_var_offsets_attr#<attribute_num-1>_#1 (uint64_t)
-//     tile_var_offsets_attr#<attribute_num-1>_#2 (uint64_t) ...
-Status FragmentMetadata::write_tile_var_offsets(Buffer* buff) {
-  Status st;
-  unsigned int attribute_num = array_schema_->attribute_num();
-
-  // Write tile offsets for each attribute
-  for (unsigned int i = 0; i < attribute_num; ++i) {
-    // Write number of offsets
-    uint64_t tile_var_offsets_num = tile_var_offsets_[i].size();
-    st = buff->write(&tile_var_offsets_num, sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot serialize fragment metadata; Writing number of "
-          "variable tile offsets failed"));
-    }
-
-    if (tile_var_offsets_num == 0)
-      continue;
-
-    // Write tile offsets
-    st = buff->write(
-        &tile_var_offsets_[i][0], tile_var_offsets_num * sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot serialize fragment metadata; Writing "
-          "variable tile offsets failed"));
-    }
+  st = buff->write(&section_offsets[0], section_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing section offsets failed"));
   }
 
   return Status::Ok();
 }
 
-// ===== FORMAT =====
-// tile_var_sizes_attr#0_num(uint64_t)
-// tile_var_sizes_attr#0_#1 (uint64_t) tile_sizes_attr#0_#2 (uint64_t) ...
-// ...
-// tile_var_sizes_attr#<attribute_num-1>_num(uint64_t)
-// tile_var_sizes_attr#<attribute_num-1>_#1(uint64_t)
-//     tile_var_sizes_attr#<attribute_num-1>_#2 (uint64_t) ...
-Status FragmentMetadata::write_tile_var_sizes(Buffer* buff) {
-  Status st;
-  unsigned int attribute_num = array_schema_->attribute_num();
-
-  // Write tile sizes for each attribute
-  for (unsigned int i = 0; i < attribute_num; ++i) {
-    // Write number of sizes
-    uint64_t tile_var_sizes_num = tile_var_sizes_[i].size();
-    st = buff->write(&tile_var_sizes_num, sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot serialize fragment metadata; Writing number of "
-          "variable tile sizes failed"));
-    }
-
-    if (tile_var_sizes_num == 0)
-      continue;
-
-    // Write tile sizes
-    st = buff->write(
-        &tile_var_sizes_[i][0], tile_var_sizes_num * sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(
-          Status::FragmentMetadataError("Cannot serialize fragment metadata; "
-                                        "Writing variable tile sizes failed"));
-    }
-  }
-  return Status::Ok();
-}
-
 // ===== FORMAT =====
 // version (uint32_t)
 Status FragmentMetadata::write_version(Buffer* buff) {
@@ -1334,6 +1721,87 @@ template Status FragmentMetadata::add_est_read_buffer_sizes<double>(
     std::unordered_map<std::string, std::pair<double, double>>* buffer_sizes)
     const;
 
+template Status FragmentMetadata::add_est_read_buffer_sizes_histogram<int8_t>(
+    const int8_t* subarray,
+    const std::vector<uint64_t>* tile_ids,
+    unsigned dim,
+    const std::vector<int8_t>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const;
+template Status FragmentMetadata::add_est_read_buffer_sizes_histogram<uint8_t>(
+    const uint8_t* subarray,
+    const std::vector<uint64_t>* tile_ids,
+    unsigned dim,
+    const std::vector<uint8_t>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const;
+template Status FragmentMetadata::add_est_read_buffer_sizes_histogram<int16_t>(
+    const int16_t* subarray,
+    const std::vector<uint64_t>* tile_ids,
+    unsigned dim,
+    const std::vector<int16_t>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const;
+template Status FragmentMetadata::add_est_read_buffer_sizes_histogram<uint16_t>(
+    const uint16_t* subarray,
+    const std::vector<uint64_t>* tile_ids,
+    unsigned dim,
+    const std::vector<uint16_t>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const;
+template Status FragmentMetadata::add_est_read_buffer_sizes_histogram<int>(
+    const int* subarray,
+    const std::vector<uint64_t>* tile_ids,
+    unsigned dim,
+    const std::vector<int>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const;
+template Status FragmentMetadata::add_est_read_buffer_sizes_histogram<unsigned>(
+    const unsigned* subarray,
+    const std::vector<uint64_t>* tile_ids,
+    unsigned dim,
+    const std::vector<unsigned>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const;
+template Status FragmentMetadata::add_est_read_buffer_sizes_histogram<int64_t>(
+    const int64_t* subarray,
+    const std::vector<uint64_t>* tile_ids,
+    unsigned dim,
+    const std::vector<int64_t>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const;
+template Status FragmentMetadata::add_est_read_buffer_sizes_histogram<uint64_t>(
+    const uint64_t* subarray,
+    const std::vector<uint64_t>* tile_ids,
+    unsigned dim,
+    const std::vector<uint64_t>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const;
+template Status FragmentMetadata::add_est_read_buffer_sizes_histogram<float>(
+    const float* subarray,
+    const std::vector<uint64_t>* tile_ids,
+    unsigned dim,
+    const std::vector<float>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const;
+template Status FragmentMetadata::add_est_read_buffer_sizes_histogram<double>(
+    const double* subarray,
+    const std::vector<uint64_t>* tile_ids,
+    unsigned dim,
+    const std::vector<double>& bucket_bounds,
+    const std::vector<std::string>& attributes,
+    std::vector<std::pair<double, double>>* histogram,
+    std::vector<bool>* overlapping) const;
+
 template uint64_t FragmentMetadata::get_tile_pos<int8_t>(
     const int8_t* tile_coords) const;
 template uint64_t FragmentMetadata::get_tile_pos<uint8_t>(
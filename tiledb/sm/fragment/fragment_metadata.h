@@ -36,14 +36,23 @@
 
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/misc/status.h"
 
+#include <mutex>
 #include <vector>
 
 namespace tiledb {
 namespace sm {
 
+class EncryptionKey;
+class StorageManager;
+
+namespace microbench {
+class Access;
+}
+
 /** Stores the metadata structures of a fragment. */
 class FragmentMetadata {
  public:
@@ -55,7 +64,8 @@ class FragmentMetadata {
    * Constructor.
    *
    * @param array_schema The schema of the array the fragment belongs to.
-   * @param dense Indicates whether the fragment is dense or sparse.
+   * @param dense Indicates whether the fragment is dense or sparse. It is
+   *     overwritten by `deserialize` with the value of the stored metadata.
    * @param fragment_uri The fragment URI.
    * @param timestamp The timestamp of the fragment creation. In TileDB,
    * timestamps are in ms elapsed since 1970-01-01 00:00:00 +0000 (UTC).
@@ -197,6 +207,40 @@ class FragmentMetadata {
       std::unordered_map<std::string, std::pair<double, double>>* buffer_sizes)
       const;
 
+  /**
+   * Adds the estimated buffer sizes of reading `subarray` from the fragment
+   * to a histogram along dimension `dim`. Bucket `b` is the slab of
+   * `subarray` whose coordinates on `dim` lie in
+   * `[bucket_bounds[2 * b], bucket_bounds[2 * b + 1]]`. The buckets must be
+   * sorted and disjoint. Each bucket receives the same estimate that
+   * `add_est_read_buffer_sizes` computes for its slab.
+   *
+   * @tparam T The coordinates type.
+   * @param subarray The targeted subarray.
+   * @param tile_ids The ids of the tiles to consider for sparse fragments,
+   *     or `nullptr` to consider all tiles. Ignored for dense fragments.
+   * @param dim The dimension the histogram is computed along.
+   * @param bucket_bounds The bucket bounds on `dim`.
+   * @param attributes The attributes to estimate the buffer sizes for.
+   * @param histogram The histogram the estimates are added to. The entry of
+   *     bucket `b` and attribute `a` is at `b * attributes.size() + a`. For
+   *     var-sized attributes, the first size is the offsets size and the
+   *     second the data size.
+   * @param overlapping Entry `b` is set to `true` if a tile of the fragment
+   *     intersects bucket `b`. This holds even if its estimate is zero, as
+   *     happens for real domains when a tile only touches the bucket.
+   * @return Status
+   */
+  template <class T>
+  Status add_est_read_buffer_sizes_histogram(
+      const T* subarray,
+      const std::vector<uint64_t>* tile_ids,
+      unsigned dim,
+      const std::vector<T>& bucket_bounds,
+      const std::vector<std::string>& attributes,
+      std::vector<std::pair<double, double>>* histogram,
+      std::vector<bool>* overlapping) const;
+
   /**
    * Returns ture if the corresponding fragment is dense, and false if it
    * is sparse.
@@ -205,6 +249,14 @@ class FragmentMetadata {
 
   /**
    * Loads the fragment metadata structures from the input binary buffer.
+   * For format versions prior to
+   * `constants::fragment_metadata_sections_version` the buffer holds the
+   * entire metadata. Otherwise, it holds only the metadata footer, and the
+   * remaining sections are loaded on demand with `load_sections`.
+   *
+   * Whether the fragment is dense is derived from the metadata: only sparse
+   * fragments store coordinates (and MBRs), so no file of the fragment needs
+   * to be checked.
    *
    * @param buff The binary buffer to deserialize from.
    * @return Status
@@ -223,6 +275,19 @@ class FragmentMetadata {
   /** Returns the format version of this fragment. */
   uint32_t format_version() const;
 
+  /**
+   * Returns the total size in bytes of the attribute and coordinate files
+   * of the fragment, i.e., of all its files but the fragment metadata.
+   */
+  uint64_t fragment_size() const;
+
+  /**
+   * Returns true if the fragment is sparse and stores the coordinates of
+   * each dimension in a separate file (see `coords_dim_name`), instead of
+   * storing them zipped in a single coordinates file.
+   */
+  bool split_coords() const;
+
   /** Returns the fragment URI. */
   const URI& fragment_uri() const;
 
@@ -249,6 +314,24 @@ class FragmentMetadata {
   /** Returns the number of cells in the last tile. */
   uint64_t last_tile_cell_num() const;
 
+  /**
+   * Loads the metadata sections (tile offsets and sizes) of the input
+   * attributes, if they are not already loaded. For sparse fragments, the
+   * sections of the coordinates and the MBRs are always loaded as well. This
+   * must be called before accessing the per-tile metadata of an attribute.
+   * It is a noop for metadata that is entirely in memory, i.e., metadata
+   * created for a write or loaded from an older format version.
+   *
+   * @param storage_manager The storage manager used to read the sections.
+   * @param encryption_key The encryption key of the array.
+   * @param attributes The attributes whose sections will be loaded.
+   * @return Status
+   */
+  Status load_sections(
+      StorageManager* storage_manager,
+      const EncryptionKey& encryption_key,
+      const std::vector<std::string>& attributes);
+
   /** Returns the MBRs. */
   const std::vector<void*>& mbrs() const;
 
@@ -256,12 +339,32 @@ class FragmentMetadata {
   const void* non_empty_domain() const;
 
   /**
-   * Serializes the metadata structures into a binary buffer.
+   * Returns the number of metadata sections, which are stored independently
+   * before the metadata footer. There is one section per attribute, one for
+   * the coordinates, one per dimension from `constants::split_coords_version`
+   * on, and one for the MBRs (the last).
+   */
+  unsigned section_num() const;
+
+  /**
+   * Serializes the metadata footer into a binary buffer. The footer holds
+   * the fragment-wide metadata along with the file offsets of the sections.
+   *
+   * @param section_offsets The offsets of the sections in the metadata file.
+   * @param buff The buffer to serialize into.
+   * @return Status
+   */
+  Status serialize_footer(
+      const std::vector<uint64_t>& section_offsets, Buffer* buff);
+
+  /**
+   * Serializes a metadata section into a binary buffer.
    *
+   * @param section The index of the section, in `[0, section_num())`.
    * @param buff The buffer to serialize into.
    * @return Status
    */
-  Status serialize(Buffer* buff);
+  Status serialize_section(unsigned section, Buffer* buff);
 
   /**
    * Sets the input tile's bounding coordinates in the fragment metadata.
@@ -272,6 +375,12 @@ class FragmentMetadata {
    */
   void set_bounding_coords(uint64_t tile, const void* bounding_coords);
 
+  /**
+   * Sets the offset of the footer in the fragment metadata file, which
+   * bounds the generic tile of the last section when it is loaded.
+   */
+  void set_footer_offset(uint64_t offset);
+
   /**
    * Simply sets the number of cells for the last tile.
    *
@@ -358,6 +467,27 @@ class FragmentMetadata {
   void set_tile_var_size(
       const std::string& attribute, uint64_t tile, uint64_t size);
 
+  /**
+   * Sets the zstd dictionary the (var-sized) tiles of the input attribute
+   * are compressed with.
+   *
+   * @param attribute The attribute, which must not be the coordinates.
+   * @param dict The dictionary.
+   */
+  void set_zstd_dictionary(
+      const std::string& attribute,
+      const std::shared_ptr<ZStdDictionary>& dict);
+
+  /**
+   * Returns `true` if the input section is stored in the metadata file. The
+   * per-dimension coordinate sections are stored only when the coordinates
+   * are split, which in turn omits the zipped coordinate section. An omitted
+   * section takes no space, i.e., its offset equals that of the next one.
+   *
+   * @param section The index of the section, in `[0, section_num())`.
+   */
+  bool stores_section(unsigned section) const;
+
   /** Returns the tile index base value. */
   uint64_t tile_index_base() const;
 
@@ -367,6 +497,13 @@ class FragmentMetadata {
   /** Returns the URI of the input attribute. */
   URI attr_uri(const std::string& attribute) const;
 
+  /**
+   * Returns the name under which the coordinate tiles of the input
+   * dimension are stored in fragments with split coordinates. The name can
+   * be used in place of an attribute name in the metadata accessors.
+   */
+  static std::string coords_dim_name(unsigned dim_idx);
+
   /** Returns the URI of the input variable-sized attribute. */
   URI attr_var_uri(const std::string& attribute) const;
 
@@ -440,6 +577,14 @@ class FragmentMetadata {
   /** The creation timestamp of the fragment. */
   uint64_t timestamp() const;
 
+  /**
+   * Returns the zstd dictionary the (var-sized) tiles of the input attribute
+   * are compressed with, or `nullptr` if there is none. For fragments loaded
+   * from storage, the section of the attribute must be loaded first.
+   */
+  std::shared_ptr<ZStdDictionary> zstd_dictionary(
+      const std::string& attribute) const;
+
   /**
    * Returns `true` if the timestamp of the first operand is smaller,
    * breaking ties based on the URI string.
@@ -447,6 +592,9 @@ class FragmentMetadata {
   bool operator<(const FragmentMetadata& metadata) const;
 
  private:
+  /** Gives the micro-benchmarks access to the internal kernels they time. */
+  friend class microbench::Access;
+
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
   /* ********************************* */
@@ -492,7 +640,28 @@ class FragmentMetadata {
   /** The MBRs (applicable only to the sparse case with irregular tiles). */
   std::vector<void*> mbrs_;
 
-  /** The offsets of the next tile for each attribute. */
+  /** Protects the on-demand loading of the metadata sections. */
+  std::mutex sections_mtx_;
+
+  /**
+   * Indicates which metadata sections are loaded in memory. It is empty if
+   * the entire metadata is in memory.
+   */
+  std::vector<bool> sections_loaded_;
+
+  /** The offsets of the metadata sections in the fragment metadata file. */
+  std::vector<uint64_t> section_offsets_;
+
+  /**
+   * The offset of the footer in the fragment metadata file, or 0 if it is
+   * unknown (e.g. the footer was retrieved from the cache).
+   */
+  uint64_t footer_offset_;
+
+  /**
+   * The offsets of the next tile for each attribute, the coordinates and,
+   * for fragments with split coordinates, each dimension.
+   */
   std::vector<uint64_t> next_tile_offsets_;
 
   /** The offsets of the next variable tile for each attribute. */
@@ -531,6 +700,9 @@ class FragmentMetadata {
   /** The format version of this metadata. */
   uint32_t version_;
 
+  /** The zstd dictionary of each attribute (`nullptr` if none). */
+  std::vector<std::shared_ptr<ZStdDictionary>> zstd_dictionaries_;
+
   /** The creation timestamp of the fragment. */
   uint64_t timestamp_;
 
@@ -550,6 +722,33 @@ class FragmentMetadata {
   std::vector<std::pair<uint64_t, double>> compute_overlapping_tile_ids_cov(
       const T* subarray) const;
 
+  /**
+   * Adds the estimated buffer sizes of the overlap of a tile with a subarray
+   * to the histogram buckets the overlap intersects. See
+   * `add_est_read_buffer_sizes_histogram`.
+   *
+   * @tparam T The coordinates type.
+   * @param tid The tile id.
+   * @param tile_subarray The subarray (or MBR) covered by the tile.
+   * @param tile_overlap The overlap of the tile with the targeted subarray.
+   *     It is used as scratch space but restored before returning.
+   * @param dim The dimension the histogram is computed along.
+   * @param bucket_bounds The bucket bounds on `dim`.
+   * @param attributes The attributes to estimate the buffer sizes for.
+   * @param histogram The histogram the estimates are added to.
+   * @param overlapping Set to `true` for the buckets the overlap intersects.
+   */
+  template <class T>
+  void add_tile_est_to_histogram(
+      uint64_t tid,
+      const T* tile_subarray,
+      T* tile_overlap,
+      unsigned dim,
+      const std::vector<T>& bucket_bounds,
+      const std::vector<std::string>& attributes,
+      std::vector<std::pair<double, double>>* histogram,
+      std::vector<bool>* overlapping) const;
+
   /**
    * Retrieves the tile domain for the input `subarray` based on the expanded
    * `domain_`.
@@ -572,6 +771,17 @@ class FragmentMetadata {
   template <class T>
   Status expand_non_empty_domain(const T* mbr);
 
+  /**
+   * Loads the tile offsets, variable tile offsets and variable tile sizes of
+   * a single attribute from a fragment metadata section buffer.
+   *
+   * @param attribute_id The attribute id (`attribute_num` for coordinates,
+   *     followed by the dimensions for split coordinates).
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_attribute_section(unsigned attribute_id, ConstBuffer* buff);
+
   /**
    * Loads the bounding coordinates from the fragment metadata buffer.
    *
@@ -634,9 +844,39 @@ class FragmentMetadata {
    */
   Status load_tile_var_sizes(ConstBuffer* buff);
 
+  /**
+   * Loads a metadata section from the input buffer.
+   *
+   * @param section The index of the section.
+   * @param buff Metadata section buffer.
+   * @return Status
+   */
+  Status load_section(unsigned section, ConstBuffer* buff);
+
+  /** Loads the metadata section offsets from the footer buffer. */
+  Status load_section_offsets(ConstBuffer* buff);
+
   /** Loads the format version from the buffer. */
   Status load_version(ConstBuffer* buff);
 
+  /**
+   * Returns the number of tile offset vectors, i.e., one per attribute, one
+   * for the coordinates and, from `constants::split_coords_version` on, one
+   * per dimension.
+   */
+  unsigned tile_offsets_num() const;
+
+  /**
+   * Writes the tile offsets, variable tile offsets and variable tile sizes of
+   * a single attribute to a fragment metadata section buffer.
+   *
+   * @param attribute_id The attribute id (`attribute_num` for coordinates,
+   *     followed by the dimensions for split coordinates).
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status write_attribute_section(unsigned attribute_id, Buffer* buff);
+
   /**
    * Writes the bounding coordinates to the fragment metadata buffer.
    *
@@ -676,28 +916,14 @@ class FragmentMetadata {
   Status write_non_empty_domain(Buffer* buff);
 
   /**
-   * Writes the tile offsets to the fragment metadata buffer.
-   *
-   * @param buff Metadata buffer.
-   * @return Status
-   */
-  Status write_tile_offsets(Buffer* buff);
-
-  /**
-   * Writes the variable tile offsets to the fragment metadata buffer.
-   *
-   * @param buff Metadata buffer.
-   * @return Status
-   */
-  Status write_tile_var_offsets(Buffer* buff);
-
-  /**
-   * Writes the variable tile sizes to the fragment metadata buffer.
+   * Writes the metadata section offsets to the footer buffer.
    *
+   * @param section_offsets The section offsets to write.
    * @param buff Metadata buffer.
    * @return Status
    */
-  Status write_tile_var_sizes(Buffer* buff);
+  Status write_section_offsets(
+      const std::vector<uint64_t>& section_offsets, Buffer* buff);
 
   /** Writes the format version to the buffer. */
   Status write_version(Buffer* buff);
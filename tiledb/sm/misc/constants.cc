@@ -34,10 +34,6 @@
 #include <limits>
 #include <thread>
 
-#ifdef HAVE_TBB
-#include <tbb/task_scheduler_init.h>
-#endif
-
 #include "tiledb/sm/c_api/tiledb_version.h"
 
 // Include files for platform path max definition.
@@ -216,6 +212,42 @@ const uint32_t consolidation_step_max_frags = UINT32_MAX;
  */
 const float consolidation_step_size_ratio = 0.0f;
 
+/** Whether background auto-consolidation is enabled. */
+const bool consolidation_auto = false;
+
+/**
+ * Minimum time (in ms) between two background consolidation runs on the
+ * same array.
+ */
+const uint64_t consolidation_auto_interval_ms = 1000;
+
+/** Maximum fragment bytes rewritten by a background consolidation run. */
+const uint64_t consolidation_auto_max_bytes = 1000000000;
+
+/**
+ * Maximum ratio of bytes rewritten by background consolidation to bytes
+ * written by the user, per array.
+ */
+const float consolidation_auto_write_amplification = 4.0f;
+
+/**
+ * Maximum time (in ms) a background consolidation run waits for the
+ * exclusive lock of its array before giving up and rescheduling.
+ */
+const uint64_t consolidation_auto_xlock_timeout_ms = 1000;
+
+/**
+ * Time (in ms) a background consolidation run waits before retrying, after
+ * failing to lock its array exclusively. It doubles upon every retry.
+ */
+const uint64_t consolidation_auto_xlock_backoff_ms = 1000;
+
+/**
+ * Maximum number of consecutive retries of a background consolidation run
+ * that failed to lock its array exclusively.
+ */
+const uint32_t consolidation_auto_xlock_max_retries = 3;
+
 /** The maximum number of bytes written in a single I/O. */
 const uint64_t max_write_bytes = std::numeric_limits<int>::max();
 
@@ -234,6 +266,21 @@ const float vfs_max_batch_read_amplification = 1.0;
 /** The default maximum number of parallel file:/// operations. */
 const uint64_t vfs_file_max_parallel_ops = vfs_num_threads;
 
+/** Whether io_uring is used for file:/// reads by default. */
+const bool vfs_file_io_uring = false;
+
+/** The default io_uring submission queue depth for file:/// reads. */
+const uint64_t vfs_file_io_uring_depth = 32;
+
+/** The size of each registered io_uring buffer. */
+const uint64_t vfs_file_io_uring_buffer_size = 131072;
+
+/** The default directory of the local disk cache of remote files. */
+const std::string vfs_disk_cache_path = "";
+
+/** The default maximum size of the local disk cache of remote files. */
+const uint64_t vfs_disk_cache_max_size = 10737418240;
+
 /** The maximum name length. */
 const uint32_t uri_max_len = 256;
 
@@ -254,6 +301,12 @@ const uint64_t array_schema_cache_size = 10000000;
 /** The fragment metadata cache size. */
 const uint64_t fragment_metadata_cache_size = 10000000;
 
+/**
+ * The number of tile bytes read along with the header of a generic tile, in
+ * the same request.
+ */
+const uint64_t generic_tile_prefetch_size = 65536;
+
 /** Whether or not the signal handlers are installed. */
 const bool enable_signal_handlers = true;
 
@@ -266,16 +319,51 @@ const uint64_t num_reader_threads = 1;
 /** The number of threads allocated per StorageManager for the Writer pool. */
 const uint64_t num_writer_threads = 1;
 
-/** The number of threads allocated for TBB. */
-#ifdef HAVE_TBB
-const int num_tbb_threads = tbb::task_scheduler_init::automatic;
-#else
+/**
+ * The number of threads allocated per StorageManager for background
+ * consolidation.
+ */
+const uint64_t num_consolidation_threads = 1;
+
+/** The number of TBB threads (deprecated and ignored). */
 const int num_tbb_threads = -1;
-#endif
+
+/** The number of threads of the compute thread pool. */
+const uint64_t num_compute_threads = std::thread::hardware_concurrency();
+
+/** The minimum number of elements sorted in parallel by the thread pool. */
+const uint64_t parallel_sort_min_size = 65536;
+
+/** The maximum number of idle bytes kept by the buffer pool. */
+const uint64_t buffer_pool_size = 50000000;
+
+/** The smallest size class (in bytes) served by the buffer pool. */
+const uint64_t buffer_pool_min_class_size = 4096;
+
+/** The maximum number of size classes of the buffer pool. */
+const int buffer_pool_max_class_num = 40;
+
+/** The fraction of the user buffers that a read partition aims to fill. */
+const float read_partition_utilization = 1.0f;
+
+/** The maximum number of buckets of a read partitioning histogram. */
+const uint64_t read_partition_histogram_bucket_num = 256;
 
 /** The tile cache size. */
 const uint64_t tile_cache_size = 10000000;
 
+/** The default maximum size of the zstd dictionary of each attribute. */
+const uint64_t zstd_dictionary_size = 0;
+
+/** Whether the checksum filters verify the data they unfilter by default. */
+const bool verify_checksums = true;
+
+/** The default size in bytes above which buffered writes are flushed. */
+const uint64_t write_coalescing_max_bytes = 0;
+
+/** The default age in ms after which buffered writes are flushed. */
+const uint64_t write_coalescing_max_age_ms = 1000;
+
 /** Empty String **/
 const std::string empty_str = "";
 
@@ -406,11 +494,48 @@ const int32_t library_version[3] = {
     TILEDB_VERSION_MAJOR, TILEDB_VERSION_MINOR, TILEDB_VERSION_PATCH};
 
 /** The TileDB serialization format version number. */
-const uint32_t format_version = 2;
+const uint32_t format_version = 5;
+
+/**
+ * The first format version in which the fragment metadata is stored as
+ * independently loadable sections followed by a footer.
+ */
+const uint32_t fragment_metadata_sections_version = 3;
+
+/**
+ * The first format version in which the coordinates of sparse fragments are
+ * stored as a separate tile stream per dimension, and in which the
+ * dimensions may have their own filter pipelines.
+ */
+const uint32_t split_coords_version = 4;
+
+/**
+ * The first format version in which the fragment metadata stores a trained
+ * zstd dictionary per attribute.
+ */
+const uint32_t zstd_dictionary_version = 5;
 
 /** The maximum size of a tile chunk (unit of compression) in bytes. */
 const uint64_t max_tile_chunk_size = 64 * 1024;
 
+/**
+ * The maximum size of the samples a zstd dictionary is trained on, as a
+ * multiple of the maximum dictionary size.
+ */
+const uint64_t zstd_dictionary_sample_ratio = 100;
+
+/**
+ * The maximum number of bytes of a chunk the adaptive filter compresses with
+ * each candidate codec to choose the codec of the chunk.
+ */
+const uint64_t auto_filter_sample_size = 8 * 1024;
+
+/**
+ * The number of evenly spaced stripes the sample of the adaptive filter is
+ * taken from, for the chunks larger than the sample.
+ */
+const unsigned auto_filter_sample_stripes = 4;
+
 /** The default attribute name prefix. */
 const std::string default_attr_name = "__attr";
 
@@ -203,6 +203,42 @@ extern const uint32_t consolidation_step_max_frags;
  */
 extern const float consolidation_step_size_ratio;
 
+/** Whether background auto-consolidation is enabled. */
+extern const bool consolidation_auto;
+
+/**
+ * Minimum time (in ms) between two background consolidation runs on the
+ * same array.
+ */
+extern const uint64_t consolidation_auto_interval_ms;
+
+/** Maximum fragment bytes rewritten by a background consolidation run. */
+extern const uint64_t consolidation_auto_max_bytes;
+
+/**
+ * Maximum ratio of bytes rewritten by background consolidation to bytes
+ * written by the user, per array.
+ */
+extern const float consolidation_auto_write_amplification;
+
+/**
+ * Maximum time (in ms) a background consolidation run waits for the
+ * exclusive lock of its array before giving up and rescheduling.
+ */
+extern const uint64_t consolidation_auto_xlock_timeout_ms;
+
+/**
+ * Time (in ms) a background consolidation run waits before retrying, after
+ * failing to lock its array exclusively. It doubles upon every retry.
+ */
+extern const uint64_t consolidation_auto_xlock_backoff_ms;
+
+/**
+ * Maximum number of consecutive retries of a background consolidation run
+ * that failed to lock its array exclusively.
+ */
+extern const uint32_t consolidation_auto_xlock_max_retries;
+
 /** The maximum number of bytes written in a single I/O. */
 extern const uint64_t max_write_bytes;
 
@@ -221,6 +257,21 @@ extern const float vfs_max_batch_read_amplification;
 /** The default maximum number of parallel file:/// operations. */
 extern const uint64_t vfs_file_max_parallel_ops;
 
+/** Whether io_uring is used for file:/// reads by default. */
+extern const bool vfs_file_io_uring;
+
+/** The default io_uring submission queue depth for file:/// reads. */
+extern const uint64_t vfs_file_io_uring_depth;
+
+/** The size of each registered io_uring buffer. */
+extern const uint64_t vfs_file_io_uring_buffer_size;
+
+/** The default directory of the local disk cache of remote files. */
+extern const std::string vfs_disk_cache_path;
+
+/** The default maximum size of the local disk cache of remote files. */
+extern const uint64_t vfs_disk_cache_max_size;
+
 /** The maximum name length. */
 extern const uint32_t uri_max_len;
 
@@ -239,6 +290,12 @@ extern const uint64_t array_schema_cache_size;
 /** The fragment metadata cache size. */
 extern const uint64_t fragment_metadata_cache_size;
 
+/**
+ * The number of tile bytes read along with the header of a generic tile, in
+ * the same request.
+ */
+extern const uint64_t generic_tile_prefetch_size;
+
 /** Whether or not the signal handlers are installed. */
 extern const bool enable_signal_handlers;
 
@@ -251,12 +308,51 @@ extern const uint64_t num_reader_threads;
 /** The number of threads allocated per StorageManager for write operations. */
 extern const uint64_t num_writer_threads;
 
-/** The number of threads allocated for TBB. */
+/**
+ * The number of threads allocated per StorageManager for background
+ * consolidation.
+ */
+extern const uint64_t num_consolidation_threads;
+
+/** The number of TBB threads (deprecated and ignored). */
 extern const int num_tbb_threads;
 
+/** The number of threads of the compute thread pool. */
+extern const uint64_t num_compute_threads;
+
+/** The minimum number of elements sorted in parallel by the thread pool. */
+extern const uint64_t parallel_sort_min_size;
+
+/** The maximum number of idle bytes kept by the buffer pool. */
+extern const uint64_t buffer_pool_size;
+
+/** The smallest size class (in bytes) served by the buffer pool. */
+extern const uint64_t buffer_pool_min_class_size;
+
+/** The maximum number of size classes of the buffer pool. */
+extern const int buffer_pool_max_class_num;
+
+/** The fraction of the user buffers that a read partition aims to fill. */
+extern const float read_partition_utilization;
+
+/** The maximum number of buckets of a read partitioning histogram. */
+extern const uint64_t read_partition_histogram_bucket_num;
+
 /** The tile cache size. */
 extern const uint64_t tile_cache_size;
 
+/** The default maximum size of the zstd dictionary of each attribute. */
+extern const uint64_t zstd_dictionary_size;
+
+/** Whether the checksum filters verify the data they unfilter by default. */
+extern const bool verify_checksums;
+
+/** The default size in bytes above which buffered writes are flushed. */
+extern const uint64_t write_coalescing_max_bytes;
+
+/** The default age in ms after which buffered writes are flushed. */
+extern const uint64_t write_coalescing_max_age_ms;
+
 /** Empty String reference **/
 extern const std::string empty_str;
 
@@ -389,9 +485,46 @@ extern const int32_t library_version[3];
 /** The TileDB serialization format version number. */
 extern const uint32_t format_version;
 
+/**
+ * The first format version in which the fragment metadata is stored as
+ * independently loadable sections followed by a footer.
+ */
+extern const uint32_t fragment_metadata_sections_version;
+
+/**
+ * The first format version in which the coordinates of sparse fragments are
+ * stored as a separate tile stream per dimension, and in which the
+ * dimensions may have their own filter pipelines.
+ */
+extern const uint32_t split_coords_version;
+
+/**
+ * The first format version in which the fragment metadata stores a trained
+ * zstd dictionary per attribute.
+ */
+extern const uint32_t zstd_dictionary_version;
+
 /** The maximum size of a tile chunk (unit of compression) in bytes. */
 extern const uint64_t max_tile_chunk_size;
 
+/**
+ * The maximum size of the samples a zstd dictionary is trained on, as a
+ * multiple of the maximum dictionary size.
+ */
+extern const uint64_t zstd_dictionary_sample_ratio;
+
+/**
+ * The maximum number of bytes of a chunk the adaptive filter compresses with
+ * each candidate codec to choose the codec of the chunk.
+ */
+extern const uint64_t auto_filter_sample_size;
+
+/**
+ * The number of evenly spaced stripes the sample of the adaptive filter is
+ * taken from, for the chunks larger than the sample.
+ */
+extern const unsigned auto_filter_sample_stripes;
+
 /** The default attribute name prefix. */
 extern const std::string default_attr_name;
 
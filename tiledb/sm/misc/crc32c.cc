@@ -0,0 +1,115 @@
+/**
+ * @file   crc32c.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the CRC32C (Castagnoli) checksum.
+ */
+
+#include "tiledb/sm/misc/crc32c.h"
+#include "tiledb/sm/misc/simd.h"
+
+#include <cstring>
+
+namespace tiledb {
+namespace sm {
+namespace crc32c {
+
+namespace {
+
+/** The reversed CRC32C polynomial. */
+const uint32_t polynomial = 0x82f63b78;
+
+/**
+ * The lookup tables of the slicing-by-8 algorithm: `t[k][b]` is the CRC of
+ * byte `b` followed by `k` zero bytes.
+ */
+struct Tables {
+  uint32_t t[8][256];
+
+  Tables() {
+    for (uint32_t b = 0; b < 256; ++b) {
+      uint32_t crc = b;
+      for (int i = 0; i < 8; ++i)
+        crc = (crc >> 1) ^ (polynomial & (0u - (crc & 1)));
+      t[0][b] = crc;
+    }
+    for (uint32_t b = 0; b < 256; ++b)
+      for (int k = 1; k < 8; ++k)
+        t[k][b] = (t[k - 1][b] >> 8) ^ t[0][t[k - 1][b] & 0xff];
+  }
+};
+
+/** Returns the lookup tables, computing them on first use. */
+const Tables& tables() {
+  static const Tables tables;
+  return tables;
+}
+
+/** Returns `true` if the SSE4.2 kernel can be used. */
+bool use_sse42() {
+  static const bool sse42 = simd::detect_sse42();
+  return sse42 && simd::isa() != simd::Isa::GENERIC;
+}
+
+}  // namespace
+
+uint32_t extend(uint32_t crc, const void* data, uint64_t size) {
+  uint32_t result;
+  if (use_sse42() && sse42::extend(crc, data, size, &result))
+    return result;
+  return extend_portable(crc, data, size);
+}
+
+uint32_t extend_portable(uint32_t crc, const void* data, uint64_t size) {
+  const auto& t = tables().t;
+  auto p = (const uint8_t*)data;
+  uint32_t l = ~crc;
+
+  // Slicing-by-8: eight table lookups per 8 bytes, in little-endian order
+  for (; size >= 8; size -= 8, p += 8) {
+    uint32_t lo, hi;
+    std::memcpy(&lo, p, sizeof(lo));
+    std::memcpy(&hi, p + 4, sizeof(hi));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    lo = __builtin_bswap32(lo);
+    hi = __builtin_bswap32(hi);
+#endif
+    lo ^= l;
+    l = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^ t[5][(lo >> 16) & 0xff] ^
+        t[4][lo >> 24] ^ t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^
+        t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+  }
+  for (; size > 0; --size, ++p)
+    l = (l >> 8) ^ t[0][(l ^ *p) & 0xff];
+
+  return ~l;
+}
+
+}  // namespace crc32c
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,80 @@
+/**
+ * @file   crc32c.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the CRC32C (Castagnoli) checksum.
+ */
+
+#ifndef TILEDB_CRC32C_H
+#define TILEDB_CRC32C_H
+
+#include <cstdint>
+
+namespace tiledb {
+namespace sm {
+namespace crc32c {
+
+/**
+ * Extends the CRC32C checksum `crc` of some data with the given bytes, so
+ * that `extend(value(a), b)` is the checksum of `a` followed by `b`.
+ *
+ * The checksum is computed with the SSE4.2 CRC32 instruction when the
+ * processor supports it and a SIMD instruction set is selected (see
+ * `simd::isa()`), and with a portable table-driven loop otherwise.
+ *
+ * @param crc The checksum of the preceding data (0 for none).
+ * @param data The data to checksum.
+ * @param size The size of the data in bytes.
+ * @return The checksum of the preceding data followed by the given bytes.
+ */
+uint32_t extend(uint32_t crc, const void* data, uint64_t size);
+
+/** Returns the CRC32C checksum of the given bytes. */
+inline uint32_t value(const void* data, uint64_t size) {
+  return extend(0, data, size);
+}
+
+/** The portable implementation of `extend`. */
+uint32_t extend_portable(uint32_t crc, const void* data, uint64_t size);
+
+namespace sse42 {
+
+/**
+ * The SSE4.2 implementation of `extend`. It must be called only if the
+ * processor supports SSE4.2, and returns `false` without computing the
+ * checksum if the kernel is not compiled in.
+ */
+bool extend(uint32_t crc, const void* data, uint64_t size, uint32_t* result);
+
+}  // namespace sse42
+
+}  // namespace crc32c
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_CRC32C_H
@@ -0,0 +1,216 @@
+/**
+ * @file   crc32c_sse42.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the SSE4.2 kernel of the CRC32C checksum. It is compiled
+ * with the SSE4.2 flag when the compiler supports it, and its kernel is called
+ * only if the processor supports SSE4.2 (see simd.h). On x86-64 it checksums
+ * three streams of the input in parallel and combines their CRCs with shift
+ * tables.
+ */
+
+#include "tiledb/sm/misc/crc32c.h"
+
+#if defined(__SSE4_2__) || (defined(_MSC_VER) && defined(_M_X64))
+#define TILEDB_CRC32C_SSE42
+#include <nmmintrin.h>
+#include <cstring>
+#endif
+
+namespace tiledb {
+namespace sm {
+namespace crc32c {
+namespace sse42 {
+
+#ifdef TILEDB_CRC32C_SSE42
+
+namespace {
+
+/** The CRC32C polynomial (reversed). */
+const uint32_t polynomial = 0x82f63b78;
+
+/**
+ * The block lengths (in bytes) of each of the three streams checksummed in
+ * parallel, for long and short inputs respectively.
+ */
+const uint64_t long_len = 8192;
+const uint64_t short_len = 256;
+
+/**
+ * Multiplies the 32x32 matrix over GF(2) `mat` (one column per element)
+ * with the vector `vec`.
+ */
+uint32_t gf2_matrix_times(const uint32_t* mat, uint32_t vec) {
+  uint32_t sum = 0;
+  for (; vec != 0; vec >>= 1, ++mat) {
+    if (vec & 1)
+      sum ^= *mat;
+  }
+  return sum;
+}
+
+/** Stores the square of the matrix `mat` in `square`. */
+void gf2_matrix_square(uint32_t* square, const uint32_t* mat) {
+  for (int n = 0; n < 32; ++n)
+    square[n] = gf2_matrix_times(mat, mat[n]);
+}
+
+/**
+ * Tables to shift a CRC by a fixed number of zero bytes, i.e., to compute
+ * the CRC of some data followed by `len` zero bytes from the CRC of the
+ * data, with four table lookups.
+ */
+struct ShiftTable {
+  uint32_t t[4][256];
+
+  explicit ShiftTable(uint64_t len) {
+    // The operator for one zero bit, squared up to one for `len` zero bytes
+    uint32_t odd[32], even[32], op[32];
+    odd[0] = polynomial;
+    for (int n = 1; n < 32; ++n)
+      odd[n] = 1u << (n - 1);
+    gf2_matrix_square(even, odd);  // 2 zero bits
+    gf2_matrix_square(odd, even);  // 4 zero bits
+    const uint32_t* cur = odd;
+    for (;;) {
+      gf2_matrix_square(even, odd);
+      cur = even;
+      len >>= 1;
+      if (len == 0)
+        break;
+      gf2_matrix_square(odd, even);
+      cur = odd;
+      len >>= 1;
+      if (len == 0)
+        break;
+    }
+    std::memcpy(op, cur, sizeof(op));
+
+    for (uint32_t b = 0; b < 256; ++b) {
+      t[0][b] = gf2_matrix_times(op, b);
+      t[1][b] = gf2_matrix_times(op, b << 8);
+      t[2][b] = gf2_matrix_times(op, b << 16);
+      t[3][b] = gf2_matrix_times(op, b << 24);
+    }
+  }
+
+  /** Shifts `crc` by the zero bytes of the table. */
+  uint32_t shift(uint32_t crc) const {
+    return t[0][crc & 0xff] ^ t[1][(crc >> 8) & 0xff] ^
+           t[2][(crc >> 16) & 0xff] ^ t[3][crc >> 24];
+  }
+};
+
+const ShiftTable& long_shift() {
+  static const ShiftTable table(long_len);
+  return table;
+}
+
+const ShiftTable& short_shift() {
+  static const ShiftTable table(short_len);
+  return table;
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+/** Loads an unaligned 8-byte word. */
+inline uint64_t load64(const uint8_t* p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/**
+ * Checksums `num` blocks of three consecutive streams of `len` bytes each.
+ * The CRC32 instruction has a latency of three cycles but a throughput of
+ * one per cycle, so the three independent streams keep it busy; their CRCs
+ * are then combined by shifting with `table`.
+ */
+uint64_t extend_streams(
+    uint64_t crc,
+    const uint8_t** p,
+    uint64_t* size,
+    uint64_t len,
+    const ShiftTable& table) {
+  for (; *size >= 3 * len; *size -= 3 * len, *p += 3 * len) {
+    uint64_t crc1 = 0, crc2 = 0;
+    auto q = *p;
+    for (auto end = q + len; q < end; q += 8) {
+      crc = _mm_crc32_u64(crc, load64(q));
+      crc1 = _mm_crc32_u64(crc1, load64(q + len));
+      crc2 = _mm_crc32_u64(crc2, load64(q + 2 * len));
+    }
+    crc = table.shift((uint32_t)crc) ^ crc1;
+    crc = table.shift((uint32_t)crc) ^ crc2;
+  }
+  return crc;
+}
+#endif
+
+}  // namespace
+
+bool extend(uint32_t crc, const void* data, uint64_t size, uint32_t* result) {
+  auto p = (const uint8_t*)data;
+  uint32_t l = ~crc;
+
+  // Align the input to 8 bytes
+  for (; size > 0 && ((uintptr_t)p & 7) != 0; --size, ++p)
+    l = _mm_crc32_u8(l, *p);
+
+#if defined(__x86_64__) || defined(_M_X64)
+  // Three interleaved streams, in long and then short blocks
+  uint64_t l64 = l;
+  l64 = extend_streams(l64, &p, &size, long_len, long_shift());
+  l64 = extend_streams(l64, &p, &size, short_len, short_shift());
+  for (; size >= 8; size -= 8, p += 8)
+    l64 = _mm_crc32_u64(l64, load64(p));
+  l = (uint32_t)l64;
+#endif
+  for (; size >= 4; size -= 4, p += 4) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    l = _mm_crc32_u32(l, v);
+  }
+  for (; size > 0; --size, ++p)
+    l = _mm_crc32_u8(l, *p);
+
+  *result = ~l;
+  return true;
+}
+
+#else
+
+bool extend(uint32_t, const void*, uint64_t, uint32_t*) {
+  return false;
+}
+
+#endif
+
+}  // namespace sse42
+}  // namespace crc32c
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,241 @@
+/**
+ * @file   gather.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines functions that gather cells scattered in a buffer
+ * into consecutive locations of another buffer.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "tiledb/sm/misc/gather.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TILEDB_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define TILEDB_PREFETCH(addr)
+#endif
+
+namespace tiledb {
+namespace sm {
+namespace gather {
+
+namespace {
+
+/**
+ * The number of cells processed per block. The source cells of a block are
+ * prefetched while the previous block is copied, so a block should be
+ * large enough to hide the memory latency but small enough for its cache
+ * lines to stay in L1.
+ */
+const uint64_t block_cells = 64;
+
+/** A 16-byte value, copied with a single (unaligned) memcpy. */
+struct Bytes16 {
+  uint64_t lo;
+  uint64_t hi;
+};
+
+/** Prefetches the source cells at the input positions. */
+inline void prefetch_cells(
+    const unsigned char* src,
+    uint64_t cell_size,
+    const uint64_t* cell_pos,
+    uint64_t num) {
+  for (uint64_t i = 0; i < num; ++i)
+    TILEDB_PREFETCH(src + cell_pos[i] * cell_size);
+}
+
+/**
+ * Copies a block of cells of type `T`. The constant width lets the
+ * compiler emit a single load and store per cell.
+ */
+template <class T>
+inline void copy_block(
+    const unsigned char* src,
+    const uint64_t* cell_pos,
+    uint64_t num,
+    unsigned char* dst) {
+  for (uint64_t i = 0; i < num; ++i)
+    std::memcpy(dst + i * sizeof(T), src + cell_pos[i] * sizeof(T), sizeof(T));
+}
+
+/** Copies a block of cells of arbitrary size. */
+inline void copy_block(
+    const unsigned char* src,
+    uint64_t cell_size,
+    const uint64_t* cell_pos,
+    uint64_t num,
+    unsigned char* dst) {
+  for (uint64_t i = 0; i < num; ++i)
+    std::memcpy(dst + i * cell_size, src + cell_pos[i] * cell_size, cell_size);
+}
+
+/** Gathers the cells block by block, prefetching the next block. */
+template <class T>
+void gather_blocks(
+    const unsigned char* src,
+    const uint64_t* cell_pos,
+    uint64_t cell_num,
+    unsigned char* dst) {
+  prefetch_cells(src, sizeof(T), cell_pos, std::min(block_cells, cell_num));
+  for (uint64_t b = 0; b < cell_num; b += block_cells) {
+    auto num = std::min(block_cells, cell_num - b);
+    auto next = b + num;
+    if (next < cell_num)
+      prefetch_cells(
+          src,
+          sizeof(T),
+          cell_pos + next,
+          std::min(block_cells, cell_num - next));
+    copy_block<T>(src, cell_pos + b, num, dst + b * sizeof(T));
+  }
+}
+
+/** Returns the size of var-sized cell `pos`. */
+inline uint64_t cell_var_size(
+    const uint64_t* offsets,
+    uint64_t offsets_num,
+    uint64_t var_size,
+    uint64_t pos) {
+  return (pos == offsets_num - 1) ? var_size - offsets[pos] :
+                                    offsets[pos + 1] - offsets[pos];
+}
+
+}  // namespace
+
+void gather_fixed(
+    const void* src,
+    uint64_t cell_size,
+    const uint64_t* cell_pos,
+    uint64_t cell_num,
+    void* dst) {
+  auto s = (const unsigned char*)src;
+  auto d = (unsigned char*)dst;
+  switch (cell_size) {
+    case 1:
+      gather_blocks<uint8_t>(s, cell_pos, cell_num, d);
+      return;
+    case 2:
+      gather_blocks<uint16_t>(s, cell_pos, cell_num, d);
+      return;
+    case 4:
+      gather_blocks<uint32_t>(s, cell_pos, cell_num, d);
+      return;
+    case 8:
+      gather_blocks<uint64_t>(s, cell_pos, cell_num, d);
+      return;
+    case 16:
+      gather_blocks<Bytes16>(s, cell_pos, cell_num, d);
+      return;
+    default:
+      break;
+  }
+
+  prefetch_cells(s, cell_size, cell_pos, std::min(block_cells, cell_num));
+  for (uint64_t b = 0; b < cell_num; b += block_cells) {
+    auto num = std::min(block_cells, cell_num - b);
+    auto next = b + num;
+    if (next < cell_num)
+      prefetch_cells(
+          s,
+          cell_size,
+          cell_pos + next,
+          std::min(block_cells, cell_num - next));
+    copy_block(s, cell_size, cell_pos + b, num, d + b * cell_size);
+  }
+}
+
+uint64_t gather_var_offsets(
+    const uint64_t* offsets,
+    uint64_t offsets_num,
+    uint64_t var_size,
+    const uint64_t* cell_pos,
+    uint64_t cell_num,
+    uint64_t* dst_offsets) {
+  auto s = (const unsigned char*)offsets;
+  auto offset_size = sizeof(uint64_t);
+  uint64_t total = 0;
+  prefetch_cells(s, offset_size, cell_pos, std::min(block_cells, cell_num));
+  for (uint64_t b = 0; b < cell_num; b += block_cells) {
+    auto num = std::min(block_cells, cell_num - b);
+    auto next = b + num;
+    if (next < cell_num)
+      prefetch_cells(
+          s,
+          offset_size,
+          cell_pos + next,
+          std::min(block_cells, cell_num - next));
+
+    // Gather the cell sizes of the block, then turn them into offsets.
+    // The two loops are kept separate so that the first has no loop
+    // carried dependency.
+    auto block_offsets = dst_offsets + b;
+    for (uint64_t i = 0; i < num; ++i)
+      block_offsets[i] =
+          cell_var_size(offsets, offsets_num, var_size, cell_pos[b + i]);
+    for (uint64_t i = 0; i < num; ++i) {
+      auto size = block_offsets[i];
+      block_offsets[i] = total;
+      total += size;
+    }
+  }
+
+  return total;
+}
+
+void gather_var(
+    const uint64_t* offsets,
+    const void* src_var,
+    const uint64_t* cell_pos,
+    uint64_t cell_num,
+    const uint64_t* dst_offsets,
+    uint64_t dst_var_size,
+    void* dst_var) {
+  auto s = (const unsigned char*)src_var;
+  auto d = (unsigned char*)dst_var;
+  for (uint64_t i = 0; i < std::min(block_cells, cell_num); ++i)
+    TILEDB_PREFETCH(s + offsets[cell_pos[i]]);
+  for (uint64_t b = 0; b < cell_num; b += block_cells) {
+    auto num = std::min(block_cells, cell_num - b);
+    auto next = b + num;
+    for (uint64_t i = next; i < std::min(next + block_cells, cell_num); ++i)
+      TILEDB_PREFETCH(s + offsets[cell_pos[i]]);
+
+    for (uint64_t i = b; i < next; ++i) {
+      auto size = (i == cell_num - 1) ? dst_var_size - dst_offsets[i] :
+                                        dst_offsets[i + 1] - dst_offsets[i];
+      std::memcpy(d + dst_offsets[i], s + offsets[cell_pos[i]], size);
+    }
+  }
+}
+
+}  // namespace gather
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,113 @@
+/**
+ * @file   gather.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares functions that gather cells scattered in a buffer
+ * into consecutive locations of another buffer.
+ */
+
+#ifndef TILEDB_GATHER_H
+#define TILEDB_GATHER_H
+
+#include <cstdint>
+
+namespace tiledb {
+namespace sm {
+namespace gather {
+
+/**
+ * Copies the fixed-sized cells of `src` at positions `cell_pos` to
+ * consecutive locations of `dst`, i.e., cell `i` of `dst` is cell
+ * `cell_pos[i]` of `src`.
+ *
+ * The positions are processed in cache-sized blocks, prefetching the
+ * source cells of the next block while copying the current one. Cells of
+ * 1, 2, 4, 8 and 16 bytes are copied with width-specialized kernels.
+ *
+ * @param src The source buffer.
+ * @param cell_size The cell size in bytes.
+ * @param cell_pos The positions of the cells in `src` to copy.
+ * @param cell_num The number of positions in `cell_pos`.
+ * @param dst The destination buffer, which must fit `cell_num` cells.
+ */
+void gather_fixed(
+    const void* src,
+    uint64_t cell_size,
+    const uint64_t* cell_pos,
+    uint64_t cell_num,
+    void* dst);
+
+/**
+ * Computes the offsets of the var-sized cells of a buffer at positions
+ * `cell_pos`, when these are copied to consecutive locations of another
+ * buffer. The offsets are the exclusive prefix sum of the cell sizes.
+ *
+ * @param offsets The offsets of all cells in the source var-sized buffer.
+ * @param offsets_num The number of elements in `offsets`.
+ * @param var_size The size of the source var-sized buffer.
+ * @param cell_pos The positions of the cells to copy.
+ * @param cell_num The number of positions in `cell_pos`.
+ * @param dst_offsets The computed destination offsets, one per position.
+ * @return The total size of the var-sized cells to copy.
+ */
+uint64_t gather_var_offsets(
+    const uint64_t* offsets,
+    uint64_t offsets_num,
+    uint64_t var_size,
+    const uint64_t* cell_pos,
+    uint64_t cell_num,
+    uint64_t* dst_offsets);
+
+/**
+ * Copies the var-sized cells of `src_var` at positions `cell_pos` to
+ * consecutive locations of `dst_var`, using the destination offsets
+ * computed by `gather_var_offsets`.
+ *
+ * @param offsets The offsets of all cells in `src_var`.
+ * @param src_var The source var-sized buffer.
+ * @param cell_pos The positions of the cells to copy.
+ * @param cell_num The number of positions in `cell_pos`.
+ * @param dst_offsets The destination offsets of the cells.
+ * @param dst_var_size The total size of the cells to copy.
+ * @param dst_var The destination buffer, which must fit `dst_var_size`
+ *     bytes.
+ */
+void gather_var(
+    const uint64_t* offsets,
+    const void* src_var,
+    const uint64_t* cell_pos,
+    uint64_t cell_num,
+    const uint64_t* dst_offsets,
+    uint64_t dst_var_size,
+    void* dst_var);
+
+}  // namespace gather
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_GATHER_H
@@ -35,18 +35,18 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 
-#ifdef HAVE_TBB
-#include <tbb/parallel_for.h>
-#include <tbb/parallel_for_each.h>
-#include <tbb/parallel_sort.h>
-#endif
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/misc/thread_pool.h"
 
 namespace tiledb {
 namespace sm {
 
 /**
- * Sort the given iterator range, possibly in parallel.
+ * Sort the given iterator range on the calling thread. This is the fallback
+ * of the thread pool overloads below.
  *
  * @tparam IterT Iterator type
  * @tparam CmpT Comparator type
@@ -56,15 +56,11 @@ namespace sm {
  */
 template <typename IterT, typename CmpT>
 void parallel_sort(IterT begin, IterT end, CmpT cmp) {
-#ifdef HAVE_TBB
-  tbb::parallel_sort(begin, end, cmp);
-#else
   std::sort(begin, end, cmp);
-#endif
 }
 
 /**
- * Sort the given iterator range, possibly in parallel.
+ * Sort the given iterator range on the calling thread.
  *
  * @tparam IterT Iterator type
  * @param begin Beginning of range to sort (inclusive).
@@ -72,16 +68,12 @@ void parallel_sort(IterT begin, IterT end, CmpT cmp) {
  */
 template <typename IterT>
 void parallel_sort(IterT begin, IterT end) {
-#ifdef HAVE_TBB
-  tbb::parallel_sort(begin, end);
-#else
   std::sort(begin, end);
-#endif
 }
 
 /**
- * Call the given function on each element in the given iterator range,
- * possibly in parallel.
+ * Call the given function on each element in the given iterator range on the
+ * calling thread.
  *
  * @tparam IterT Iterator type
  * @tparam FuncT Function type (returning Status).
@@ -94,37 +86,195 @@ template <typename IterT, typename FuncT>
 std::vector<Status> parallel_for_each(IterT begin, IterT end, const FuncT& F) {
   auto niters = static_cast<uint64_t>(std::distance(begin, end));
   std::vector<Status> result(niters);
-#ifdef HAVE_TBB
-  tbb::parallel_for(uint64_t(0), niters, [begin, &result, &F](uint64_t i) {
-    auto it = std::next(begin, i);
-    result[i] = F(*it);
-  });
-#else
   for (uint64_t i = 0; i < niters; i++) {
     auto it = std::next(begin, i);
     result[i] = F(*it);
   }
-#endif
   return result;
 }
 
+/**
+ * Calls the given function on each index in the range `[begin, end)` on the
+ * calling thread.
+ *
+ * @tparam FuncT Function type (returning Status).
+ * @param begin Beginning of the range (inclusive).
+ * @param end End of the range (exclusive).
+ * @param F Function to call on each index.
+ * @return Vector of Status objects, one for each function invocation.
+ */
 template <typename FuncT>
 std::vector<Status> parallel_for(uint64_t begin, uint64_t end, const FuncT& F) {
   assert(begin <= end);
   uint64_t num_iters = end - begin + 1;
   std::vector<Status> result(num_iters);
-#ifdef HAVE_TBB
-  tbb::parallel_for(begin, end, [begin, &result, &F](uint64_t i) {
-    result[i - begin] = F(i);
-  });
-#else
   for (uint64_t i = begin; i < end; i++) {
     result[i - begin] = F(i);
   }
-#endif
   return result;
 }
 
+/**
+ * Calls the given function on each index in the range `[begin, end)` using
+ * the tasks of the given thread pool. The range is split into a few blocks
+ * per thread; the calling thread executes the first block and then waits
+ * for the others (see `ThreadPool::wait_all_status`). The indices of a block
+ * that failed to run, e.g., because its task was cancelled, get the error
+ * of the task.
+ *
+ * If `tp` is `nullptr` or has no threads, this falls back to
+ * `parallel_for(begin, end, F)`.
+ *
+ * @tparam FuncT Function type (returning Status).
+ * @param tp The thread pool to run on.
+ * @param begin Beginning of the range (inclusive).
+ * @param end End of the range (exclusive).
+ * @param F Function to call on each index.
+ * @return Vector of Status objects, one for each function invocation.
+ */
+template <typename FuncT>
+std::vector<Status> parallel_for(
+    ThreadPool* tp, uint64_t begin, uint64_t end, const FuncT& F) {
+  if (tp == nullptr || tp->num_threads() == 0)
+    return parallel_for(begin, end, F);
+
+  assert(begin <= end);
+  uint64_t num_iters = end - begin;
+  std::vector<Status> result(num_iters + 1);
+  if (num_iters == 0)
+    return result;
+
+  // A few blocks per thread, so that stealing can balance uneven work
+  uint64_t num_blocks = std::min(num_iters, 4 * (tp->num_threads() + 1));
+  uint64_t block_size = (num_iters + num_blocks - 1) / num_blocks;
+  num_blocks = (num_iters + block_size - 1) / block_size;
+  auto run_block = [begin, end, block_size, &result, &F](uint64_t b) {
+    uint64_t block_begin = begin + b * block_size;
+    uint64_t block_end = std::min(block_begin + block_size, end);
+    for (uint64_t i = block_begin; i < block_end; i++)
+      result[i - begin] = F(i);
+    return Status::Ok();
+  };
+
+  std::vector<std::future<Status>> tasks;
+  tasks.reserve(num_blocks - 1);
+  for (uint64_t b = 1; b < num_blocks; b++)
+    tasks.push_back(tp->enqueue([b, &run_block]() { return run_block(b); }));
+  run_block(0);
+  auto statuses = tp->wait_all_status(tasks);
+  for (uint64_t b = 1; b < num_blocks; b++) {
+    if (statuses[b - 1].ok())
+      continue;
+    uint64_t block_begin = begin + b * block_size;
+    uint64_t block_end = std::min(block_begin + block_size, end);
+    for (uint64_t i = block_begin; i < block_end; i++)
+      result[i - begin] = statuses[b - 1];
+  }
+
+  return result;
+}
+
+/**
+ * Call the given function on each element in the given iterator range using
+ * the tasks of the given thread pool (see `parallel_for`).
+ *
+ * @tparam IterT Iterator type
+ * @tparam FuncT Function type (returning Status).
+ * @param tp The thread pool to run on.
+ * @param begin Beginning of range (inclusive).
+ * @param end End of range (exclusive).
+ * @param F Function to call on each item
+ * @return Vector of Status objects, one for each function invocation.
+ */
+template <typename IterT, typename FuncT>
+std::vector<Status> parallel_for_each(
+    ThreadPool* tp, IterT begin, IterT end, const FuncT& F) {
+  if (tp == nullptr || tp->num_threads() == 0)
+    return parallel_for_each(begin, end, F);
+
+  std::vector<IterT> iters;
+  for (auto it = begin; it != end; ++it)
+    iters.push_back(it);
+  auto result = parallel_for(
+      tp, 0, iters.size(), [&iters, &F](uint64_t i) { return F(*iters[i]); });
+  result.pop_back();
+  return result;
+}
+
+/**
+ * Sort the given random-access iterator range using the tasks of the given
+ * thread pool. Blocks of the range are sorted in parallel and then merged
+ * pairwise in parallel rounds. If a task fails to run, the range is sorted
+ * by the calling thread instead.
+ *
+ * If `tp` is `nullptr` or has at most one thread, this falls back to
+ * `parallel_sort(begin, end, cmp)`.
+ *
+ * @tparam IterT Iterator type
+ * @tparam CmpT Comparator type
+ * @param tp The thread pool to run on.
+ * @param begin Beginning of range to sort (inclusive).
+ * @param end End of range to sort (exclusive).
+ * @param cmp Comparator.
+ */
+template <typename IterT, typename CmpT>
+void parallel_sort(ThreadPool* tp, IterT begin, IterT end, CmpT cmp) {
+  auto n = static_cast<uint64_t>(std::distance(begin, end));
+  if (tp == nullptr || tp->num_threads() <= 1 ||
+      n < constants::parallel_sort_min_size) {
+    parallel_sort(begin, end, cmp);
+    return;
+  }
+
+  uint64_t num_blocks = tp->num_threads() + 1;
+  uint64_t block_size = (n + num_blocks - 1) / num_blocks;
+  num_blocks = (n + block_size - 1) / block_size;
+  auto all_ok = [](const std::vector<Status>& statuses) {
+    for (const auto& st : statuses) {
+      if (!st.ok())
+        return false;
+    }
+    return true;
+  };
+  auto statuses = parallel_for(tp, 0, num_blocks, [&](uint64_t b) {
+    auto block_begin = begin + b * block_size;
+    auto block_end = begin + std::min((b + 1) * block_size, n);
+    std::sort(block_begin, block_end, cmp);
+    return Status::Ok();
+  });
+
+  for (uint64_t width = block_size; width < n && all_ok(statuses);
+       width *= 2) {
+    uint64_t num_merges = (n + 2 * width - 1) / (2 * width);
+    statuses = parallel_for(tp, 0, num_merges, [&](uint64_t m) {
+      uint64_t lo = m * 2 * width;
+      uint64_t mid = std::min(lo + width, n);
+      uint64_t hi = std::min(lo + 2 * width, n);
+      if (mid < hi)
+        std::inplace_merge(begin + lo, begin + mid, begin + hi, cmp);
+      return Status::Ok();
+    });
+  }
+
+  if (!all_ok(statuses))
+    parallel_sort(begin, end, cmp);
+}
+
+/**
+ * Sort the given random-access iterator range using the tasks of the given
+ * thread pool (see `parallel_sort`).
+ *
+ * @tparam IterT Iterator type
+ * @param tp The thread pool to run on.
+ * @param begin Beginning of range to sort (inclusive).
+ * @param end End of range to sort (exclusive).
+ */
+template <typename IterT>
+void parallel_sort(ThreadPool* tp, IterT begin, IterT end) {
+  typedef typename std::iterator_traits<IterT>::value_type ValueT;
+  parallel_sort(tp, begin, end, std::less<ValueT>());
+}
+
 }  // namespace sm
 }  // namespace tiledb
 
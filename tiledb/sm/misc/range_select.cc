@@ -0,0 +1,152 @@
+/**
+ * @file   range_select.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the portable kernels that select the values of an array
+ * that fall in a range, and the dispatch to the AVX2 kernels.
+ */
+
+#include "tiledb/sm/misc/range_select.h"
+#include "tiledb/sm/misc/simd.h"
+
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace tiledb {
+namespace sm {
+namespace range_select {
+
+namespace {
+
+/** Returns the index of the lowest set bit of a non-zero word. */
+inline unsigned lowest_bit(uint64_t word) {
+#ifdef _MSC_VER
+  unsigned long idx;
+  _BitScanForward64(&idx, word);
+  return (unsigned)idx;
+#else
+  return (unsigned)__builtin_ctzll(word);
+#endif
+}
+
+/** The portable kernel of `select`. */
+template <class T>
+void select_generic(
+    const T* values,
+    uint64_t stride,
+    uint64_t num,
+    T low,
+    T high,
+    bool intersect,
+    uint64_t* bitmap) {
+  auto words = bitmap_words(num);
+  for (uint64_t w = 0; w < words; ++w) {
+    // No need to check the values already out of range
+    if (intersect && bitmap[w] == 0)
+      continue;
+
+    auto begin = w * 64;
+    auto n = std::min<uint64_t>(64, num - begin);
+    auto v = values + begin * stride;
+    uint64_t word = 0;
+    for (uint64_t j = 0; j < n; ++j) {
+      auto x = v[j * stride];
+      word |= (uint64_t)((x >= low) & (x <= high)) << j;
+    }
+    bitmap[w] = intersect ? (bitmap[w] & word) : word;
+  }
+}
+
+}  // namespace
+
+template <class T>
+void select(
+    const T* values,
+    uint64_t stride,
+    uint64_t num,
+    T low,
+    T high,
+    bool intersect,
+    uint64_t* bitmap) {
+  if (stride == 1 && simd::isa() == simd::Isa::AVX2 &&
+      avx2::select(values, num, low, high, intersect, bitmap))
+    return;
+
+  select_generic(values, stride, num, low, high, intersect, bitmap);
+}
+
+bool bitmap_empty(const uint64_t* bitmap, uint64_t num) {
+  uint64_t any = 0;
+  auto words = bitmap_words(num);
+  for (uint64_t w = 0; w < words; ++w)
+    any |= bitmap[w];
+  return any == 0;
+}
+
+uint64_t bitmap_to_positions(
+    const uint64_t* bitmap, uint64_t num, uint64_t* pos) {
+  uint64_t n = 0;
+  auto words = bitmap_words(num);
+  for (uint64_t w = 0; w < words; ++w) {
+    auto word = bitmap[w];
+    while (word != 0) {
+      pos[n++] = w * 64 + lowest_bit(word);
+      word &= word - 1;
+    }
+  }
+  return n;
+}
+
+// Explicit template instantiations
+template void select<int8_t>(
+    const int8_t*, uint64_t, uint64_t, int8_t, int8_t, bool, uint64_t*);
+template void select<uint8_t>(
+    const uint8_t*, uint64_t, uint64_t, uint8_t, uint8_t, bool, uint64_t*);
+template void select<int16_t>(
+    const int16_t*, uint64_t, uint64_t, int16_t, int16_t, bool, uint64_t*);
+template void select<uint16_t>(
+    const uint16_t*, uint64_t, uint64_t, uint16_t, uint16_t, bool, uint64_t*);
+template void select<int32_t>(
+    const int32_t*, uint64_t, uint64_t, int32_t, int32_t, bool, uint64_t*);
+template void select<uint32_t>(
+    const uint32_t*, uint64_t, uint64_t, uint32_t, uint32_t, bool, uint64_t*);
+template void select<int64_t>(
+    const int64_t*, uint64_t, uint64_t, int64_t, int64_t, bool, uint64_t*);
+template void select<uint64_t>(
+    const uint64_t*, uint64_t, uint64_t, uint64_t, uint64_t, bool, uint64_t*);
+template void select<float>(
+    const float*, uint64_t, uint64_t, float, float, bool, uint64_t*);
+template void select<double>(
+    const double*, uint64_t, uint64_t, double, double, bool, uint64_t*);
+
+}  // namespace range_select
+}  // namespace sm
+}  // namespace tiledb
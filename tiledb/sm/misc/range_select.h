@@ -0,0 +1,153 @@
+/**
+ * @file   range_select.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares kernels that select the values of an array that fall in a
+ * range, producing a selection bitmap, and that convert a selection bitmap to
+ * a list of positions.
+ */
+
+#ifndef TILEDB_RANGE_SELECT_H
+#define TILEDB_RANGE_SELECT_H
+
+#include <cstdint>
+
+namespace tiledb {
+namespace sm {
+namespace range_select {
+
+/** Returns the number of 64-bit words of a bitmap of `num` bits. */
+inline uint64_t bitmap_words(uint64_t num) {
+  return (num + 63) / 64;
+}
+
+/**
+ * Computes a selection bitmap of the values that fall in `[low, high]`,
+ * where bit `i % 64` of word `i / 64` of `bitmap` corresponds to value
+ * `values[i * stride]`. The bits past the last value are set to zero.
+ *
+ * Contiguous (`stride` equal to 1) 32- and 64-bit values are checked with
+ * the AVX2 kernels when these are selected (see `simd::isa()`), and all
+ * other values with a branch-free portable loop.
+ *
+ * @tparam T The value type.
+ * @param values The values to check.
+ * @param stride The distance (in values) between consecutive values.
+ * @param num The number of values to check.
+ * @param low The lower bound of the range (inclusive).
+ * @param high The upper bound of the range (inclusive).
+ * @param intersect If `true`, the bitmap is intersected with the selection
+ *     instead of being overwritten by it.
+ * @param bitmap The bitmap, of `bitmap_words(num)` words.
+ */
+template <class T>
+void select(
+    const T* values,
+    uint64_t stride,
+    uint64_t num,
+    T low,
+    T high,
+    bool intersect,
+    uint64_t* bitmap);
+
+/** Returns `true` if no bit of the bitmap of `num` bits is set. */
+bool bitmap_empty(const uint64_t* bitmap, uint64_t num);
+
+/**
+ * Stores the positions of the set bits of the bitmap of `num` bits in
+ * `pos`, in increasing order.
+ *
+ * @param bitmap The bitmap.
+ * @param num The number of bits in the bitmap.
+ * @param pos The positions, which must fit the number of set bits.
+ * @return The number of set bits.
+ */
+uint64_t bitmap_to_positions(
+    const uint64_t* bitmap, uint64_t num, uint64_t* pos);
+
+namespace avx2 {
+
+/**
+ * The AVX2 kernels of `select` for contiguous values. They must be called
+ * only if the AVX2 instruction set is selected, and return `false` without
+ * modifying the bitmap if the kernel for the value type is not compiled in.
+ */
+template <class T>
+inline bool select(const T*, uint64_t, T, T, bool, uint64_t*) {
+  return false;
+}
+bool select(
+    const int32_t* values,
+    uint64_t num,
+    int32_t low,
+    int32_t high,
+    bool intersect,
+    uint64_t* bitmap);
+bool select(
+    const uint32_t* values,
+    uint64_t num,
+    uint32_t low,
+    uint32_t high,
+    bool intersect,
+    uint64_t* bitmap);
+bool select(
+    const int64_t* values,
+    uint64_t num,
+    int64_t low,
+    int64_t high,
+    bool intersect,
+    uint64_t* bitmap);
+bool select(
+    const uint64_t* values,
+    uint64_t num,
+    uint64_t low,
+    uint64_t high,
+    bool intersect,
+    uint64_t* bitmap);
+bool select(
+    const float* values,
+    uint64_t num,
+    float low,
+    float high,
+    bool intersect,
+    uint64_t* bitmap);
+bool select(
+    const double* values,
+    uint64_t num,
+    double low,
+    double high,
+    bool intersect,
+    uint64_t* bitmap);
+
+}  // namespace avx2
+
+}  // namespace range_select
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_RANGE_SELECT_H
@@ -0,0 +1,243 @@
+/**
+ * @file   range_select_avx2.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the AVX2 kernels that select the values of an array that
+ * fall in a range. It is compiled with the AVX2 flag when the compiler
+ * supports it, and its kernels are called only if the processor supports AVX2
+ * (see simd.h).
+ */
+
+#include "tiledb/sm/misc/range_select.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace tiledb {
+namespace sm {
+namespace range_select {
+namespace avx2 {
+
+#ifdef __AVX2__
+
+namespace {
+
+/**
+ * Checks the values of a vector register against a range. Each
+ * specialization has `lanes` values per register, and `bits` returns the
+ * bits of the selection of the `lanes` values at the given address.
+ */
+template <class T>
+struct Range;
+
+template <>
+struct Range<int32_t> {
+  static const unsigned lanes = 8;
+  __m256i low_, high_;
+
+  Range(int32_t low, int32_t high)
+      : low_(_mm256_set1_epi32(low))
+      , high_(_mm256_set1_epi32(high)) {
+  }
+
+  uint64_t bits(const int32_t* v) const {
+    auto x = _mm256_loadu_si256((const __m256i*)v);
+    auto out = _mm256_or_si256(
+        _mm256_cmpgt_epi32(low_, x), _mm256_cmpgt_epi32(x, high_));
+    return ~(uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(out)) & 0xff;
+  }
+};
+
+template <>
+struct Range<uint32_t> {
+  static const unsigned lanes = 8;
+  __m256i low_, high_, flip_;
+
+  // Unsigned values are compared as signed after flipping their sign bit
+  Range(uint32_t low, uint32_t high)
+      : low_(_mm256_set1_epi32((int32_t)(low ^ 0x80000000u)))
+      , high_(_mm256_set1_epi32((int32_t)(high ^ 0x80000000u)))
+      , flip_(_mm256_set1_epi32((int32_t)0x80000000u)) {
+  }
+
+  uint64_t bits(const uint32_t* v) const {
+    auto x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)v), flip_);
+    auto out = _mm256_or_si256(
+        _mm256_cmpgt_epi32(low_, x), _mm256_cmpgt_epi32(x, high_));
+    return ~(uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(out)) & 0xff;
+  }
+};
+
+template <>
+struct Range<int64_t> {
+  static const unsigned lanes = 4;
+  __m256i low_, high_;
+
+  Range(int64_t low, int64_t high)
+      : low_(_mm256_set1_epi64x(low))
+      , high_(_mm256_set1_epi64x(high)) {
+  }
+
+  uint64_t bits(const int64_t* v) const {
+    auto x = _mm256_loadu_si256((const __m256i*)v);
+    auto out = _mm256_or_si256(
+        _mm256_cmpgt_epi64(low_, x), _mm256_cmpgt_epi64(x, high_));
+    return ~(uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(out)) & 0xf;
+  }
+};
+
+template <>
+struct Range<uint64_t> {
+  static const unsigned lanes = 4;
+  __m256i low_, high_, flip_;
+
+  // Unsigned values are compared as signed after flipping their sign bit
+  Range(uint64_t low, uint64_t high)
+      : low_(_mm256_set1_epi64x((int64_t)(low ^ 0x8000000000000000ull)))
+      , high_(_mm256_set1_epi64x((int64_t)(high ^ 0x8000000000000000ull)))
+      , flip_(_mm256_set1_epi64x((int64_t)0x8000000000000000ull)) {
+  }
+
+  uint64_t bits(const uint64_t* v) const {
+    auto x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)v), flip_);
+    auto out = _mm256_or_si256(
+        _mm256_cmpgt_epi64(low_, x), _mm256_cmpgt_epi64(x, high_));
+    return ~(uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(out)) & 0xf;
+  }
+};
+
+template <>
+struct Range<float> {
+  static const unsigned lanes = 8;
+  __m256 low_, high_;
+
+  Range(float low, float high)
+      : low_(_mm256_set1_ps(low))
+      , high_(_mm256_set1_ps(high)) {
+  }
+
+  uint64_t bits(const float* v) const {
+    auto x = _mm256_loadu_ps(v);
+    auto in = _mm256_and_ps(
+        _mm256_cmp_ps(x, low_, _CMP_GE_OQ), _mm256_cmp_ps(x, high_, _CMP_LE_OQ));
+    return (uint64_t)_mm256_movemask_ps(in);
+  }
+};
+
+template <>
+struct Range<double> {
+  static const unsigned lanes = 4;
+  __m256d low_, high_;
+
+  Range(double low, double high)
+      : low_(_mm256_set1_pd(low))
+      , high_(_mm256_set1_pd(high)) {
+  }
+
+  uint64_t bits(const double* v) const {
+    auto x = _mm256_loadu_pd(v);
+    auto in = _mm256_and_pd(
+        _mm256_cmp_pd(x, low_, _CMP_GE_OQ), _mm256_cmp_pd(x, high_, _CMP_LE_OQ));
+    return (uint64_t)_mm256_movemask_pd(in);
+  }
+};
+
+/** Computes the selection bitmap 64 values at a time. */
+template <class T>
+void select_words(
+    const T* values,
+    uint64_t num,
+    T low,
+    T high,
+    bool intersect,
+    uint64_t* bitmap) {
+  Range<T> range(low, high);
+  const unsigned lanes = Range<T>::lanes;
+
+  auto full_words = num / 64;
+  for (uint64_t w = 0; w < full_words; ++w) {
+    // No need to check the values already out of range
+    if (intersect && bitmap[w] == 0)
+      continue;
+
+    auto v = values + w * 64;
+    uint64_t word = 0;
+    for (unsigned j = 0; j < 64; j += lanes)
+      word |= range.bits(v + j) << j;
+    bitmap[w] = intersect ? (bitmap[w] & word) : word;
+  }
+
+  // Check the remaining values one by one
+  auto begin = full_words * 64;
+  if (begin < num) {
+    uint64_t word = 0;
+    for (uint64_t j = 0; begin + j < num; ++j) {
+      auto x = values[begin + j];
+      word |= (uint64_t)((x >= low) & (x <= high)) << j;
+    }
+    bitmap[full_words] = intersect ? (bitmap[full_words] & word) : word;
+  }
+}
+
+}  // namespace
+
+#define TILEDB_RANGE_SELECT_AVX2(T)                                     \
+  bool select(                                                          \
+      const T* values,                                                  \
+      uint64_t num,                                                     \
+      T low,                                                            \
+      T high,                                                           \
+      bool intersect,                                                   \
+      uint64_t* bitmap) {                                               \
+    select_words<T>(values, num, low, high, intersect, bitmap);         \
+    return true;                                                        \
+  }
+
+#else
+
+#define TILEDB_RANGE_SELECT_AVX2(T) \
+  bool select(const T*, uint64_t, T, T, bool, uint64_t*) {   \
+    return false;                                            \
+  }
+
+#endif
+
+TILEDB_RANGE_SELECT_AVX2(int32_t)
+TILEDB_RANGE_SELECT_AVX2(uint32_t)
+TILEDB_RANGE_SELECT_AVX2(int64_t)
+TILEDB_RANGE_SELECT_AVX2(uint64_t)
+TILEDB_RANGE_SELECT_AVX2(float)
+TILEDB_RANGE_SELECT_AVX2(double)
+
+#undef TILEDB_RANGE_SELECT_AVX2
+
+}  // namespace avx2
+}  // namespace range_select
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,172 @@
+/**
+ * @file simd.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the runtime selection of the instruction set used by the
+ * SIMD kernels.
+ */
+
+#include "tiledb/sm/misc/simd.h"
+#include "tiledb/sm/misc/stats.h"
+
+#include "bitshuffle_core.h"
+#include "shuffle.h"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define TILEDB_SIMD_X86
+#ifdef _MSC_VER
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace tiledb {
+namespace sm {
+namespace simd {
+
+/** The selected instruction set, or -1 if none is selected yet. */
+static std::atomic<int> selected_isa(-1);
+
+#ifdef TILEDB_SIMD_X86
+
+/** Executes `cpuid` for the given leaf, storing eax, ebx, ecx and edx. */
+static void cpuid(uint32_t leaf, uint32_t regs[4]) {
+#ifdef _MSC_VER
+  int r[4];
+  __cpuidex(r, (int)leaf, 0);
+  for (int i = 0; i < 4; ++i)
+    regs[i] = (uint32_t)r[i];
+#else
+  __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/** Returns the XCR0 register, i.e., the register states the OS saves. */
+static uint64_t xcr0() {
+#ifdef _MSC_VER
+  return _xgetbv(0);
+#else
+  uint32_t eax, edx;
+  // "xgetbv", as bytes for older assemblers
+  __asm__ __volatile__(".byte 0x0f, 0x01, 0xd0"
+                       : "=a"(eax), "=d"(edx)
+                       : "c"(0));
+  return ((uint64_t)edx << 32) | eax;
+#endif
+}
+
+#endif
+
+Isa detect() {
+#ifdef TILEDB_SIMD_X86
+  uint32_t regs[4];
+  cpuid(0, regs);
+  uint32_t max_leaf = regs[0];
+
+  cpuid(1, regs);
+  bool sse2 = (regs[3] & (1u << 26)) != 0;
+  bool osxsave = (regs[2] & (1u << 27)) != 0;
+  bool avx = (regs[2] & (1u << 28)) != 0;
+
+  bool avx2 = false;
+  if (max_leaf >= 7) {
+    cpuid(7, regs);
+    avx2 = (regs[1] & (1u << 5)) != 0;
+  }
+
+  // AVX2 also requires the OS to save the XMM and YMM registers
+  if (avx2 && avx && osxsave && (xcr0() & 0x6) == 0x6)
+    return Isa::AVX2;
+  if (sse2)
+    return Isa::SSE2;
+#endif
+
+  return Isa::GENERIC;
+}
+
+bool detect_sse42() {
+#ifdef TILEDB_SIMD_X86
+  uint32_t regs[4];
+  cpuid(1, regs);
+  return (regs[2] & (1u << 20)) != 0;
+#else
+  return false;
+#endif
+}
+
+Isa compiled() {
+#if defined(TILEDB_AVX2_KERNELS)
+  return Isa::AVX2;
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  return Isa::SSE2;
+#else
+  return Isa::GENERIC;
+#endif
+}
+
+Isa isa() {
+  int isa = selected_isa.load(std::memory_order_relaxed);
+  if (isa < 0)
+    return select();
+  return (Isa)isa;
+}
+
+Isa select(Isa max_isa) {
+  auto isa = std::min(std::min(detect(), compiled()), max_isa);
+
+  blosc::select_shuffle_implementation((int)isa);
+  bshuf_select_isa((int)isa);
+
+  selected_isa = (int)isa;
+  stats::all_stats.counter_simd_isa = (uint64_t)isa;
+
+  return isa;
+}
+
+const char* isa_str(Isa isa) {
+  switch (isa) {
+    case Isa::GENERIC:
+      return "generic";
+    case Isa::SSE2:
+      return "sse2";
+    case Isa::AVX2:
+      return "avx2";
+  }
+  return "generic";
+}
+
+}  // namespace simd
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,97 @@
+/**
+ * @file simd.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the runtime selection of the instruction set used by the
+ * SIMD kernels.
+ */
+
+#ifndef TILEDB_SIMD_H
+#define TILEDB_SIMD_H
+
+#include <cstdint>
+
+namespace tiledb {
+namespace sm {
+namespace simd {
+
+/**
+ * The instruction sets the SIMD kernels are built for, in increasing order of
+ * capability.
+ */
+enum class Isa : uint8_t {
+  /** Portable (non-vectorized) code. */
+  GENERIC = 0,
+  /** SSE2, which every x86-64 processor supports. */
+  SSE2 = 1,
+  /** AVX2, supported by Intel Haswell (2013) and later processors. */
+  AVX2 = 2
+};
+
+/** Returns the best instruction set supported by the processor and the OS. */
+Isa detect();
+
+/**
+ * Returns `true` if the processor supports SSE4.2, which includes the CRC32C
+ * instruction. This is independent of the selected instruction set.
+ */
+bool detect_sse42();
+
+/**
+ * Returns the best instruction set the SIMD kernels were compiled for. The
+ * AVX2 kernels are compiled separately from the rest of the library, so a
+ * build for the baseline instruction set still includes them.
+ */
+Isa compiled();
+
+/**
+ * Returns the instruction set selected for the SIMD kernels, selecting the
+ * best available one on first use.
+ */
+Isa isa();
+
+/**
+ * Selects the instruction set used by all SIMD kernels, which is the best one
+ * both supported by the processor and compiled for, up to the given one. The
+ * selection is also recorded in the `simd_isa` stats counter. This is
+ * called upon global state initialization, and should not be called while
+ * kernels are running.
+ *
+ * @param max_isa The best instruction set that may be selected.
+ * @return The selected instruction set.
+ */
+Isa select(Isa max_isa = Isa::AVX2);
+
+/** Returns the name of the given instruction set. */
+const char* isa_str(Isa isa);
+
+}  // namespace simd
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_SIMD_H
@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <cmath>
 #include <thread>
+#include <vector>
 
 #include "tiledb/sm/misc/stats.h"
 
@@ -8,9 +11,112 @@ namespace stats {
 
 Statistics all_stats;
 
+namespace {
+
+/** The stats of the query the calling thread is working on. */
+thread_local QueryStats* thread_query_stats = nullptr;
+
+/** The id of the query the calling thread is working on. */
+thread_local uint64_t thread_query_id = 0;
+
+}  // namespace
+
+/* ****************************** */
+/*        LATENCY HISTOGRAM       */
+/* ****************************** */
+
+LatencyHistogram::LatencyHistogram() {
+  reset();
+}
+
+uint64_t LatencyHistogram::count() const {
+  return count_;
+}
+
+void LatencyHistogram::dump(std::stringstream& ss) const {
+  ss << "\"count\": " << count() << ", ";
+  ss << "\"p50\": " << percentile(50) << ", ";
+  ss << "\"p90\": " << percentile(90) << ", ";
+  ss << "\"p99\": " << percentile(99) << ", ";
+  ss << "\"p999\": " << percentile(99.9) << ", ";
+  ss << "\"max\": " << max();
+}
+
+uint64_t LatencyHistogram::max() const {
+  return max_;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+  uint64_t count = count_;
+  if (count == 0)
+    return 0;
+
+  // The rank of the percentile among the recorded values, starting at 1
+  auto rank = (uint64_t)std::ceil(p / 100.0 * count);
+  rank = std::max<uint64_t>(rank, 1);
+
+  uint64_t seen = 0;
+  for (unsigned i = 0; i < bucket_num; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank)
+      return (i == bucket_num - 1) ? max() : std::min(bucket_upper(i), max());
+  }
+
+  // Values recorded concurrently may be counted but not yet bucketed
+  return max();
+}
+
+void LatencyHistogram::record(uint64_t value) {
+  buckets_[bucket_idx(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  atomic_max(max_, value);
+}
+
+void LatencyHistogram::reset() {
+  for (auto& bucket : buckets_)
+    bucket = 0;
+  count_ = 0;
+  max_ = 0;
+}
+
+unsigned LatencyHistogram::bucket_idx(uint64_t value) {
+  if (value < sub_bucket_num)
+    return (unsigned)value;
+
+  // Position of the most significant bit
+  unsigned exponent = 0;
+  for (uint64_t v = value >> 1; v != 0; v >>= 1)
+    ++exponent;
+  if (exponent > max_exponent)
+    return bucket_num - 1;
+
+  // The sub-bucket is given by the bits following the most significant one
+  unsigned shift = exponent - sub_bucket_bits;
+  auto sub_bucket = (unsigned)(value >> shift) & (sub_bucket_num - 1);
+  return (shift + 1) * sub_bucket_num + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucket_upper(unsigned idx) {
+  if (idx < sub_bucket_num)
+    return idx;
+
+  unsigned shift = idx / sub_bucket_num - 1;
+  uint64_t lower = (uint64_t)(sub_bucket_num + idx % sub_bucket_num) << shift;
+  return lower + ((uint64_t)1 << shift) - 1;
+}
+
+/* ****************************** */
+/*           STATISTICS           */
+/* ****************************** */
+
 Statistics::Statistics() {
   enabled_ = false;
   reset();
+
+#define STATS_INIT_HISTOGRAM_STAT(function_name) \
+  function_name##_hist = &function_name##_latency;
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_INIT_HISTOGRAM_STAT
 }
 
 void Statistics::dump(FILE* out) const {
@@ -39,6 +145,23 @@ void Statistics::dump(FILE* out) const {
       "\n");
   dump_all_counter_stats(out);
 
+  fprintf(out, "\nLatency histograms:\n");
+  fprintf(
+      out,
+      "%-40s%12s%12s%12s%12s\n",
+      "  Function name",
+      "# calls",
+      "p50 (ns)",
+      "p99 (ns)",
+      "max (ns)");
+  fprintf(
+      out,
+      "  "
+      "------------------------------------------------------------------------"
+      "------"
+      "\n");
+  dump_all_histogram_stats(out);
+
   fprintf(out, "\nSummary:\n");
   fprintf(out, "--------\n");
   fprintf(
@@ -140,6 +263,14 @@ void Statistics::dump(std::string* out) const {
   ss.seekp(-2, std::ios_base::cur);
   ss << "\n";
 
+  ss << "  ],\n";
+  ss << "  \"histograms\": [\n";
+  dump_all_histogram_stats(ss);
+
+  // Replace last ,\n with just \n
+  ss.seekp(-2, std::ios_base::cur);
+  ss << "\n";
+
   ss << "  ]\n";
   ss << "}";
   *out = ss.str();
@@ -191,6 +322,96 @@ void Statistics::set_enabled(bool enabled) {
   enabled_ = enabled;
 }
 
+/* ****************************** */
+/*           QUERY STATS          */
+/* ****************************** */
+
+QueryStats::QueryStats() {
+#define STATS_INIT_FUNC_STAT(function_name) \
+  function_name##_total_ns = 0;             \
+  function_name##_call_count = 0;
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_INIT_FUNC_STAT
+
+#define STATS_INIT_COUNTER_STAT(counter_name) counter_##counter_name = 0;
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_INIT_COUNTER_STAT
+
+#define STATS_INIT_HISTOGRAM_STAT(function_name) \
+  function_name##_hist = &function_name##_latency;
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_INIT_HISTOGRAM_STAT
+}
+
+void QueryStats::dump(std::string* out) const {
+  // Only the non-zero entries are reported
+  std::vector<std::string> funcs, counters, histograms;
+  std::stringstream ss;
+
+#define STATS_REPORT_FUNC_STAT(function_name)                                \
+  if (function_name##_call_count > 0) {                                      \
+    ss.str("");                                                              \
+    ss << "    { ";                                                          \
+    ss << "\"name\": \"" << #function_name << "\", ";                        \
+    ss << "\"callCount\": " << (uint64_t)function_name##_call_count << ", "; \
+    ss << "\"ns\": " << (uint64_t)function_name##_total_ns << " }";          \
+    funcs.push_back(ss.str());                                               \
+  }
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_REPORT_FUNC_STAT
+
+#define STATS_REPORT_COUNTER_STAT(counter_name)                      \
+  if (counter_##counter_name > 0) {                                  \
+    ss.str("");                                                      \
+    ss << "    { ";                                                  \
+    ss << "\"name\": \"" << #counter_name << "\", ";                 \
+    ss << "\"value\": " << (uint64_t)counter_##counter_name << " }"; \
+    counters.push_back(ss.str());                                    \
+  }
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_REPORT_COUNTER_STAT
+
+#define STATS_REPORT_HISTOGRAM_STAT(function_name)    \
+  if (function_name##_latency.count() > 0) {          \
+    ss.str("");                                       \
+    ss << "    { ";                                   \
+    ss << "\"name\": \"" << #function_name << "\", "; \
+    function_name##_latency.dump(ss);                 \
+    ss << " }";                                       \
+    histograms.push_back(ss.str());                   \
+  }
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_REPORT_HISTOGRAM_STAT
+
+  auto join = [](const std::vector<std::string>& entries) {
+    std::string ret;
+    for (size_t i = 0; i < entries.size(); ++i)
+      ret += entries[i] + (i + 1 < entries.size() ? ",\n" : "\n");
+    return ret;
+  };
+
+  ss.str("");
+  ss << "{\n";
+  ss << "  \"functions\": [\n" << join(funcs) << "  ],\n";
+  ss << "  \"counters\": [\n" << join(counters) << "  ],\n";
+  ss << "  \"histograms\": [\n" << join(histograms) << "  ]\n";
+  ss << "}";
+  *out = ss.str();
+}
+
+QueryStats* current_query_stats() {
+  return thread_query_stats;
+}
+
+uint64_t current_query_id() {
+  return thread_query_id;
+}
+
+void set_current_query(QueryStats* query_stats, uint64_t query_id) {
+  thread_query_stats = query_stats;
+  thread_query_id = query_id;
+}
+
 }  // namespace stats
 }  // namespace sm
-}  // namespace tiledb
\ No newline at end of file
+}  // namespace tiledb
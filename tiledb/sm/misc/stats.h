@@ -35,6 +35,9 @@
 
 #define __STDC_FORMAT_MACROS
 
+#include "tiledb/sm/misc/macros.h"
+#include "tiledb/sm/misc/trace.h"
+
 #include <inttypes.h>
 #include <atomic>
 #include <chrono>
@@ -50,31 +53,199 @@ namespace stats {
 /*          TYPE DEFINITIONS         */
 /* ********************************* */
 
+/** The number of shards of a ShardedCounter. */
+const unsigned counter_shard_num = 16;
+
+/**
+ * Returns the counter shard of the calling thread. Shards are assigned to
+ * threads round-robin upon their first stats update.
+ */
+inline unsigned thread_counter_shard() {
+  static std::atomic<unsigned> next_shard(0);
+  static thread_local unsigned shard = next_shard++ % counter_shard_num;
+  return shard;
+}
+
+/** Atomically raises `counter` to `value` if `value` is larger. */
+inline void atomic_max(std::atomic<uint64_t>& counter, uint64_t value) {
+  uint64_t cur = counter;
+  while (value > cur && !counter.compare_exchange_weak(cur, value)) {
+  }
+}
+
+/**
+ * A counter split into cache-line-sized shards. Each thread adds to its own
+ * shard, so that counters updated by many threads do not bounce a cache
+ * line between cores, and reads aggregate all shards.
+ */
+class ShardedCounter {
+ public:
+  /** Constructor. */
+  ShardedCounter() {
+    reset();
+  }
+
+  DISABLE_COPY_AND_COPY_ASSIGN(ShardedCounter);
+
+  /** Resets the counter to the input value. */
+  ShardedCounter& operator=(uint64_t value) {
+    reset();
+    shards_[0].value_ = value;
+    return *this;
+  }
+
+  /** Adds a value to the shard of the calling thread. */
+  ShardedCounter& operator+=(uint64_t value) {
+    shards_[thread_counter_shard()].value_.fetch_add(
+        value, std::memory_order_relaxed);
+    return *this;
+  }
+
+  /** Adds one to the shard of the calling thread. */
+  void operator++(int) {
+    *this += 1;
+  }
+
+  /** Returns the sum of all shards. */
+  operator uint64_t() const {
+    uint64_t sum = 0;
+    for (const auto& shard : shards_)
+      sum += shard.value_.load(std::memory_order_relaxed);
+    return sum;
+  }
+
+  /**
+   * Raises the counter to the input value if the value is larger. Counters
+   * updated with `max` are never added to, so they keep their value in the
+   * first shard only.
+   */
+  void max(uint64_t value) {
+    atomic_max(shards_[0].value_, value);
+  }
+
+ private:
+  /** A shard, padded to a cache line. */
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> value_;
+  };
+
+  /** The shards. */
+  Shard shards_[counter_shard_num];
+
+  /** Resets all shards to zero. */
+  void reset() {
+    for (auto& shard : shards_)
+      shard.value_ = 0;
+  }
+};
+
+/**
+ * A latency histogram with log-linear buckets, in the style of HDR
+ * histograms. Values below 8 ns have their own bucket, and every power of
+ * two above is split into 8 equal buckets, which bounds the relative error
+ * of the reported percentiles to 12.5%. Recording is lock-free.
+ */
+class LatencyHistogram {
+ public:
+  /** The number of bits of a value that select its sub-bucket. */
+  static const unsigned sub_bucket_bits = 3;
+
+  /** The number of sub-buckets per power of two. */
+  static const unsigned sub_bucket_num = 1u << sub_bucket_bits;
+
+  /**
+   * The largest power of two with its own buckets; larger values are
+   * recorded in the last bucket (2^42 ns is over an hour).
+   */
+  static const unsigned max_exponent = 42;
+
+  /** The number of buckets. */
+  static const unsigned bucket_num =
+      (max_exponent - sub_bucket_bits + 2) * sub_bucket_num;
+
+  /** Constructor. */
+  LatencyHistogram();
+
+  DISABLE_COPY_AND_COPY_ASSIGN(LatencyHistogram);
+
+  /** Returns the number of recorded values. */
+  uint64_t count() const;
+
+  /**
+   * Dumps the count, the maximum and the 50th, 90th, 99th and 99.9th
+   * percentiles as the members of a JSON object.
+   */
+  void dump(std::stringstream& ss) const;
+
+  /** Returns the largest recorded value. */
+  uint64_t max() const;
+
+  /**
+   * Returns the given percentile (in [0, 100]) of the recorded values, i.e.,
+   * the upper bound of the bucket holding it (capped at the maximum), or 0
+   * if there are no values.
+   */
+  uint64_t percentile(double p) const;
+
+  /** Records a value. */
+  void record(uint64_t value);
+
+  /** Clears all recorded values. */
+  void reset();
+
+ private:
+  /** The number of values per bucket. */
+  std::atomic<uint64_t> buckets_[bucket_num];
+
+  /** The number of recorded values. */
+  std::atomic<uint64_t> count_;
+
+  /** The largest recorded value. */
+  std::atomic<uint64_t> max_;
+
+  /** Returns the bucket of a value. */
+  static unsigned bucket_idx(uint64_t value);
+
+  /** Returns the largest value of a bucket. */
+  static uint64_t bucket_upper(unsigned idx);
+};
+
 /**
  * Class that defines stats counters and methods to manipulate them.
  */
 class Statistics {
  public:
   /* Define the counters */
-#define STATS_DEFINE_FUNC_STAT(function_name)     \
-  std::atomic<uint64_t> function_name##_total_ns; \
-  std::atomic<uint64_t> function_name##_call_count;
+#define STATS_DEFINE_FUNC_STAT(function_name) \
+  ShardedCounter function_name##_total_ns;    \
+  ShardedCounter function_name##_call_count;  \
+  LatencyHistogram* function_name##_hist = nullptr;
 #include "tiledb/sm/misc/stats_counters.h"
 #undef STATS_DEFINE_FUNC_STAT
 
 #define STATS_DEFINE_COUNTER_STAT(counter_name) \
-  std::atomic<uint64_t> counter_##counter_name;
+  ShardedCounter counter_##counter_name;
 #include "tiledb/sm/misc/stats_counters.h"
 #undef STATS_DEFINE_COUNTER_STAT
 
+#define STATS_DEFINE_HISTOGRAM_STAT(function_name) \
+  LatencyHistogram function_name##_latency;
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_DEFINE_HISTOGRAM_STAT
+
   /** Constructor. */
   Statistics();
 
   /** Returns true if statistics are currently enabled. */
   bool enabled() const;
 
-  /** Reset all counters to zero. */
+  /**
+   * Reset all counters to zero, except `simd_isa` which records the selected
+   * instruction set of the SIMD kernels rather than counting.
+   */
   void reset() {
+    uint64_t simd_isa = counter_simd_isa;
+
 #define STATS_INIT_FUNC_STAT(function_name) \
   function_name##_total_ns = 0;             \
   function_name##_call_count = 0;
@@ -84,6 +255,13 @@ class Statistics {
 #define STATS_INIT_COUNTER_STAT(counter_name) counter_##counter_name = 0;
 #include "tiledb/sm/misc/stats_counters.h"
 #undef STATS_INIT_COUNTER_STAT
+
+#define STATS_INIT_HISTOGRAM_STAT(function_name) \
+  function_name##_latency.reset();
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_INIT_HISTOGRAM_STAT
+
+    counter_simd_isa = simd_isa;
   }
 
   /** Dump the current counter values to the given file. */
@@ -145,6 +323,32 @@ class Statistics {
 #undef STATS_REPORT_COUNTER_STAT
   }
 
+  /** Dump all latency histograms to the output. */
+  void dump_all_histogram_stats(FILE* out) const {
+#define STATS_REPORT_HISTOGRAM_STAT(function_name)                   \
+  fprintf(                                                           \
+      out,                                                           \
+      "%-40s%12" PRIu64 "%12" PRIu64 "%12" PRIu64 "%12" PRIu64 "\n", \
+      "  " #function_name ",",                                       \
+      function_name##_latency.count(),                               \
+      function_name##_latency.percentile(50),                        \
+      function_name##_latency.percentile(99),                        \
+      function_name##_latency.max());
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_REPORT_HISTOGRAM_STAT
+  }
+
+  /** Dump all latency histograms to the output. */
+  void dump_all_histogram_stats(std::stringstream& ss) const {
+#define STATS_REPORT_HISTOGRAM_STAT(function_name)  \
+  ss << "    { ";                                   \
+  ss << "\"name\": \"" << #function_name << "\", "; \
+  function_name##_latency.dump(ss);                 \
+  ss << " },\n";
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_REPORT_HISTOGRAM_STAT
+  }
+
   /** Dump a summary of read statistics. */
   void dump_read_summary(FILE* out) const;
 
@@ -184,6 +388,87 @@ class Statistics {
       uint64_t denominator) const;
 };
 
+/**
+ * The stats of a single query. These are gathered in addition to the global
+ * stats, by all threads working on the query, while global stats are
+ * enabled. Since a query is processed by few threads at a time, its
+ * counters are plain atomics.
+ */
+class QueryStats {
+ public:
+  /* Define the counters */
+#define STATS_DEFINE_FUNC_STAT(function_name)       \
+  std::atomic<uint64_t> function_name##_total_ns;   \
+  std::atomic<uint64_t> function_name##_call_count; \
+  LatencyHistogram* function_name##_hist = nullptr;
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_DEFINE_FUNC_STAT
+
+#define STATS_DEFINE_COUNTER_STAT(counter_name) \
+  std::atomic<uint64_t> counter_##counter_name;
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_DEFINE_COUNTER_STAT
+
+#define STATS_DEFINE_HISTOGRAM_STAT(function_name) \
+  LatencyHistogram function_name##_latency;
+#include "tiledb/sm/misc/stats_counters.h"
+#undef STATS_DEFINE_HISTOGRAM_STAT
+
+  /** Constructor. */
+  QueryStats();
+
+  DISABLE_COPY_AND_COPY_ASSIGN(QueryStats);
+
+  /**
+   * Dumps the stats to the given string as JSON, in the same format as the
+   * global stats but omitting the entries that are zero.
+   */
+  void dump(std::string* out) const;
+};
+
+/**
+ * Returns the stats of the query the calling thread is working on, or
+ * `nullptr` if it is not working on a query or the query gathers no stats.
+ */
+QueryStats* current_query_stats();
+
+/**
+ * Returns the id of the query the calling thread is working on, or 0 if it
+ * is not working on a query.
+ */
+uint64_t current_query_id();
+
+/** Sets the query (its stats and id) the calling thread is working on. */
+void set_current_query(QueryStats* query_stats, uint64_t query_id);
+
+/**
+ * Sets the query the calling thread is working on for the lifetime of the
+ * object, restoring the previous one upon destruction.
+ */
+class ScopedQuery {
+ public:
+  /** Constructor. */
+  ScopedQuery(QueryStats* query_stats, uint64_t query_id)
+      : prev_stats_(current_query_stats())
+      , prev_id_(current_query_id()) {
+    set_current_query(query_stats, query_id);
+  }
+
+  /** Destructor. */
+  ~ScopedQuery() {
+    set_current_query(prev_stats_, prev_id_);
+  }
+
+  DISABLE_COPY_AND_COPY_ASSIGN(ScopedQuery);
+
+ private:
+  /** The query stats of the thread before the object was created. */
+  QueryStats* prev_stats_;
+
+  /** The query id of the thread before the object was created. */
+  uint64_t prev_id_;
+};
+
 /**
  * The singleton instance holding all global stats counters. The report will
  * be automatically made when this object is destroyed (at program termination).
@@ -196,6 +481,35 @@ extern Statistics all_stats;
 
 #ifdef TILEDB_STATS
 
+/** Adds a function call of the given duration to a stats object. */
+#define STATS_RECORD_FUNC(stats_obj, f, dur_ns) \
+  {                                             \
+    (stats_obj).f##_total_ns += (dur_ns);       \
+    (stats_obj).f##_call_count++;               \
+    if ((stats_obj).f##_hist != nullptr)        \
+      (stats_obj).f##_hist->record(dur_ns);     \
+  }
+
+/**
+ * Records a call of a stats-enabled function that started at the given time
+ * into the global and query stats, and into the trace if tracing is enabled.
+ */
+#define STATS_FUNC_RECORD(f, start)                            \
+  if (stats::all_stats.enabled() || stats::tracer.enabled()) { \
+    uint64_t __stats_dur_ns =                                  \
+        std::chrono::duration_cast<std::chrono::nanoseconds>(  \
+            std::chrono::steady_clock::now() - (start))        \
+            .count();                                          \
+    if (stats::all_stats.enabled()) {                          \
+      STATS_RECORD_FUNC(stats::all_stats, f, __stats_dur_ns);  \
+      auto __stats_query = stats::current_query_stats();       \
+      if (__stats_query != nullptr)                            \
+        STATS_RECORD_FUNC(*__stats_query, f, __stats_dur_ns);  \
+    }                                                          \
+    if (stats::tracer.enabled())                               \
+      stats::tracer.record(#f, (start), __stats_dur_ns);       \
+  }
+
 /** Marks the beginning of a stats-enabled function. This should come before the
  * first statement where you want the function timer to start. */
 #define STATS_FUNC_IN(f)                                 \
@@ -205,18 +519,10 @@ extern Statistics all_stats;
  * statement in the function. Note that a function can have multiple exit paths
  * (i.e. multiple returns), but you should still put this macro after the very
  * last statement in the function. */
-#define STATS_FUNC_OUT(f)                                     \
-  }                                                           \
-  ();                                                         \
-  if (stats::all_stats.enabled()) {                           \
-    auto __stats_end = std::chrono::steady_clock::now();      \
-    uint64_t __stats_dur_ns =                                 \
-        std::chrono::duration_cast<std::chrono::nanoseconds>( \
-            __stats_end - __stats_start)                      \
-            .count();                                         \
-    stats::all_stats.f##_total_ns += __stats_dur_ns;          \
-    stats::all_stats.f##_call_count++;                        \
-  }                                                           \
+#define STATS_FUNC_OUT(f)             \
+  }                                   \
+  ();                                 \
+  STATS_FUNC_RECORD(f, __stats_start) \
   return __stats_##f##_retval;
 
 /** Marks the beginning of a stats-enabled void function. This should come
@@ -226,28 +532,35 @@ extern Statistics all_stats;
   [&]() {
 /** Marks the end of a stats-enabled void function. This should come after the
  * last statement in the function. */
-#define STATS_FUNC_VOID_OUT(f)                                 \
-  }                                                            \
-  ();                                                          \
-  if (stats::all_stats.enabled()) {                            \
-    auto __stats_##f##_end = std::chrono::steady_clock::now(); \
-    uint64_t __stats_dur_ns =                                  \
-        std::chrono::duration_cast<std::chrono::nanoseconds>(  \
-            __stats_##f##_end - __stats_##f##_start)           \
-            .count();                                          \
-    stats::all_stats.f##_total_ns += __stats_dur_ns;           \
-    stats::all_stats.f##_call_count++;                         \
-  }
+#define STATS_FUNC_VOID_OUT(f) \
+  }                            \
+  ();                          \
+  STATS_FUNC_RECORD(f, __stats_##f##_start)
 /** Adds a value to a counter stat. */
-#define STATS_COUNTER_ADD(counter_name, value)          \
-  if (stats::all_stats.enabled()) {                     \
-    stats::all_stats.counter_##counter_name += (value); \
+#define STATS_COUNTER_ADD(counter_name, value)                \
+  if (stats::all_stats.enabled()) {                           \
+    uint64_t __stats_value = (value);                         \
+    stats::all_stats.counter_##counter_name += __stats_value; \
+    auto __stats_query = stats::current_query_stats();        \
+    if (__stats_query != nullptr)                             \
+      __stats_query->counter_##counter_name += __stats_value; \
   }
 
 /** Adds a value to a counter stat if the given condition is true. */
 #define STATS_COUNTER_ADD_IF(cond, counter_name, value) \
   if (stats::all_stats.enabled() && (cond)) {           \
-    stats::all_stats.counter_##counter_name += (value); \
+    STATS_COUNTER_ADD(counter_name, value)              \
+  }
+
+/** Raises a counter stat to the given value if the value is larger. */
+#define STATS_COUNTER_MAX(counter_name, value)                   \
+  if (stats::all_stats.enabled()) {                              \
+    uint64_t __stats_value = (value);                            \
+    stats::all_stats.counter_##counter_name.max(__stats_value);  \
+    auto __stats_query = stats::current_query_stats();           \
+    if (__stats_query != nullptr)                                \
+      stats::atomic_max(                                         \
+          __stats_query->counter_##counter_name, __stats_value); \
   }
 
 /** Starts an ad hoc timer of the given name. */
@@ -278,6 +591,8 @@ extern Statistics all_stats;
 
 #define STATS_COUNTER_ADD_IF(cond, counter_name, value)
 
+#define STATS_COUNTER_MAX(counter_name, value)
+
 #define STATS_TIMER_START(name)
 
 #define STATS_TIMER_NS(name)
@@ -44,6 +44,9 @@ STATS_DEFINE_FUNC_STAT(compressor_rle_compress)
 STATS_DEFINE_FUNC_STAT(compressor_rle_decompress)
 STATS_DEFINE_FUNC_STAT(compressor_zstd_compress)
 STATS_DEFINE_FUNC_STAT(compressor_zstd_decompress)
+// Consolidator
+STATS_DEFINE_FUNC_STAT(consolidator_consolidate_tiles)
+STATS_DEFINE_FUNC_STAT(consolidator_merge_tiles)
 // Encryption
 STATS_DEFINE_FUNC_STAT(encryption_encrypt_aes256gcm)
 STATS_DEFINE_FUNC_STAT(encryption_decrypt_aes256gcm)
@@ -62,9 +65,11 @@ STATS_DEFINE_FUNC_STAT(reader_compute_dense_cell_ranges)
 STATS_DEFINE_FUNC_STAT(reader_compute_dense_overlapping_tiles_and_cell_ranges)
 STATS_DEFINE_FUNC_STAT(reader_compute_overlapping_coords)
 STATS_DEFINE_FUNC_STAT(reader_compute_overlapping_tiles)
+STATS_DEFINE_FUNC_STAT(reader_compute_subarray_partitions)
 STATS_DEFINE_FUNC_STAT(reader_compute_tile_coords)
 STATS_DEFINE_FUNC_STAT(reader_copy_fixed_cells)
 STATS_DEFINE_FUNC_STAT(reader_copy_var_cells)
+STATS_DEFINE_FUNC_STAT(reader_copy_result_cells)
 STATS_DEFINE_FUNC_STAT(reader_dedup_coords)
 STATS_DEFINE_FUNC_STAT(reader_dense_read)
 STATS_DEFINE_FUNC_STAT(reader_fill_coords)
@@ -95,6 +100,7 @@ STATS_DEFINE_FUNC_STAT(writer_prepare_tiles_fixed)
 STATS_DEFINE_FUNC_STAT(writer_prepare_tiles_ordered)
 STATS_DEFINE_FUNC_STAT(writer_prepare_tiles_var)
 STATS_DEFINE_FUNC_STAT(writer_sort_coords)
+STATS_DEFINE_FUNC_STAT(writer_train_zstd_dictionary)
 STATS_DEFINE_FUNC_STAT(writer_unordered_write)
 STATS_DEFINE_FUNC_STAT(writer_write)
 STATS_DEFINE_FUNC_STAT(writer_write_all_tiles)
@@ -107,6 +113,8 @@ STATS_DEFINE_FUNC_STAT(sm_array_reopen)
 STATS_DEFINE_FUNC_STAT(sm_read_from_cache)
 STATS_DEFINE_FUNC_STAT(sm_write_to_cache)
 STATS_DEFINE_FUNC_STAT(sm_query_submit)
+STATS_DEFINE_FUNC_STAT(sm_write_coalescer_append)
+STATS_DEFINE_FUNC_STAT(sm_write_coalescer_flush)
 // TileIO
 STATS_DEFINE_FUNC_STAT(tileio_is_generic_tile)
 STATS_DEFINE_FUNC_STAT(tileio_read_generic)
@@ -158,6 +166,9 @@ STATS_INIT_FUNC_STAT(compressor_rle_compress)
 STATS_INIT_FUNC_STAT(compressor_rle_decompress)
 STATS_INIT_FUNC_STAT(compressor_zstd_compress)
 STATS_INIT_FUNC_STAT(compressor_zstd_decompress)
+// Consolidator
+STATS_INIT_FUNC_STAT(consolidator_consolidate_tiles)
+STATS_INIT_FUNC_STAT(consolidator_merge_tiles)
 // Encryption
 STATS_INIT_FUNC_STAT(encryption_encrypt_aes256gcm)
 STATS_INIT_FUNC_STAT(encryption_decrypt_aes256gcm)
@@ -176,9 +187,11 @@ STATS_INIT_FUNC_STAT(reader_compute_dense_cell_ranges)
 STATS_INIT_FUNC_STAT(reader_compute_dense_overlapping_tiles_and_cell_ranges)
 STATS_INIT_FUNC_STAT(reader_compute_overlapping_coords)
 STATS_INIT_FUNC_STAT(reader_compute_overlapping_tiles)
+STATS_INIT_FUNC_STAT(reader_compute_subarray_partitions)
 STATS_INIT_FUNC_STAT(reader_compute_tile_coords)
 STATS_INIT_FUNC_STAT(reader_copy_fixed_cells)
 STATS_INIT_FUNC_STAT(reader_copy_var_cells)
+STATS_INIT_FUNC_STAT(reader_copy_result_cells)
 STATS_INIT_FUNC_STAT(reader_dedup_coords)
 STATS_INIT_FUNC_STAT(reader_dense_read)
 STATS_INIT_FUNC_STAT(reader_fill_coords)
@@ -209,6 +222,7 @@ STATS_INIT_FUNC_STAT(writer_prepare_tiles_fixed)
 STATS_INIT_FUNC_STAT(writer_prepare_tiles_ordered)
 STATS_INIT_FUNC_STAT(writer_prepare_tiles_var)
 STATS_INIT_FUNC_STAT(writer_sort_coords)
+STATS_INIT_FUNC_STAT(writer_train_zstd_dictionary)
 STATS_INIT_FUNC_STAT(writer_unordered_write)
 STATS_INIT_FUNC_STAT(writer_write)
 STATS_INIT_FUNC_STAT(writer_write_all_tiles)
@@ -221,6 +235,8 @@ STATS_INIT_FUNC_STAT(sm_array_reopen)
 STATS_INIT_FUNC_STAT(sm_read_from_cache)
 STATS_INIT_FUNC_STAT(sm_write_to_cache)
 STATS_INIT_FUNC_STAT(sm_query_submit)
+STATS_INIT_FUNC_STAT(sm_write_coalescer_append)
+STATS_INIT_FUNC_STAT(sm_write_coalescer_flush)
 // TileIO
 STATS_INIT_FUNC_STAT(tileio_is_generic_tile)
 STATS_INIT_FUNC_STAT(tileio_read_generic)
@@ -272,6 +288,9 @@ STATS_REPORT_FUNC_STAT(compressor_rle_compress)
 STATS_REPORT_FUNC_STAT(compressor_rle_decompress)
 STATS_REPORT_FUNC_STAT(compressor_zstd_compress)
 STATS_REPORT_FUNC_STAT(compressor_zstd_decompress)
+// Consolidator
+STATS_REPORT_FUNC_STAT(consolidator_consolidate_tiles)
+STATS_REPORT_FUNC_STAT(consolidator_merge_tiles)
 // Encryption
 STATS_REPORT_FUNC_STAT(encryption_encrypt_aes256gcm)
 STATS_REPORT_FUNC_STAT(encryption_decrypt_aes256gcm)
@@ -290,9 +309,11 @@ STATS_REPORT_FUNC_STAT(reader_compute_dense_cell_ranges)
 STATS_REPORT_FUNC_STAT(reader_compute_dense_overlapping_tiles_and_cell_ranges)
 STATS_REPORT_FUNC_STAT(reader_compute_overlapping_coords)
 STATS_REPORT_FUNC_STAT(reader_compute_overlapping_tiles)
+STATS_REPORT_FUNC_STAT(reader_compute_subarray_partitions)
 STATS_REPORT_FUNC_STAT(reader_compute_tile_coords)
 STATS_REPORT_FUNC_STAT(reader_copy_fixed_cells)
 STATS_REPORT_FUNC_STAT(reader_copy_var_cells)
+STATS_REPORT_FUNC_STAT(reader_copy_result_cells)
 STATS_REPORT_FUNC_STAT(reader_dedup_coords)
 STATS_REPORT_FUNC_STAT(reader_dense_read)
 STATS_REPORT_FUNC_STAT(reader_fill_coords)
@@ -323,6 +344,7 @@ STATS_REPORT_FUNC_STAT(writer_prepare_tiles_fixed)
 STATS_REPORT_FUNC_STAT(writer_prepare_tiles_ordered)
 STATS_REPORT_FUNC_STAT(writer_prepare_tiles_var)
 STATS_REPORT_FUNC_STAT(writer_sort_coords)
+STATS_REPORT_FUNC_STAT(writer_train_zstd_dictionary)
 STATS_REPORT_FUNC_STAT(writer_unordered_write)
 STATS_REPORT_FUNC_STAT(writer_write)
 STATS_REPORT_FUNC_STAT(writer_write_all_tiles)
@@ -335,6 +357,8 @@ STATS_REPORT_FUNC_STAT(sm_array_reopen)
 STATS_REPORT_FUNC_STAT(sm_read_from_cache)
 STATS_REPORT_FUNC_STAT(sm_write_to_cache)
 STATS_REPORT_FUNC_STAT(sm_query_submit)
+STATS_REPORT_FUNC_STAT(sm_write_coalescer_append)
+STATS_REPORT_FUNC_STAT(sm_write_coalescer_flush)
 // TileIO
 STATS_REPORT_FUNC_STAT(tileio_is_generic_tile)
 STATS_REPORT_FUNC_STAT(tileio_read_generic)
@@ -373,12 +397,25 @@ STATS_REPORT_FUNC_STAT(vfs_s3_write_multipart)
 #endif
 
 #ifdef STATS_DEFINE_COUNTER_STAT
+// Buffer pool
+STATS_DEFINE_COUNTER_STAT(buffer_pool_hits)
+STATS_DEFINE_COUNTER_STAT(buffer_pool_misses)
+STATS_DEFINE_COUNTER_STAT(buffer_pool_reused_bytes)
+STATS_DEFINE_COUNTER_STAT(buffer_pool_max_pooled_bytes)
+STATS_DEFINE_COUNTER_STAT(buffer_pool_max_in_use_bytes)
 // Cache
 STATS_DEFINE_COUNTER_STAT(cache_lru_inserts)
 STATS_DEFINE_COUNTER_STAT(cache_lru_read_hits)
 STATS_DEFINE_COUNTER_STAT(cache_lru_read_misses)
+// Consolidator
+STATS_DEFINE_COUNTER_STAT(consolidator_num_bytes_copied)
+STATS_DEFINE_COUNTER_STAT(consolidator_num_cells_merged)
+STATS_DEFINE_COUNTER_STAT(consolidator_num_tiles_copied)
+// Filters
+STATS_DEFINE_COUNTER_STAT(filter_checksum_bytes_verified)
 // Fragment Metadata
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_num_fragments)
+STATS_DEFINE_COUNTER_STAT(fragment_metadata_num_sections)
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_bytes)
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_bytes_read)
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_cached_bytes_copied)
@@ -398,7 +435,15 @@ STATS_DEFINE_COUNTER_STAT(reader_num_var_cell_bytes_read)
 STATS_DEFINE_COUNTER_STAT(writer_num_attr_tiles_written)
 STATS_DEFINE_COUNTER_STAT(writer_num_bytes_before_filtering)
 STATS_DEFINE_COUNTER_STAT(writer_num_bytes_written)
+// SIMD (instruction set of the kernels: 0 generic, 1 SSE2, 2 AVX2)
+STATS_DEFINE_COUNTER_STAT(simd_isa)
 // StorageManager
+STATS_DEFINE_COUNTER_STAT(sm_array_reopen_reused_fragments)
+STATS_DEFINE_COUNTER_STAT(sm_auto_consolidations)
+STATS_DEFINE_COUNTER_STAT(sm_auto_consolidation_bytes)
+STATS_DEFINE_COUNTER_STAT(sm_write_coalescer_writes)
+STATS_DEFINE_COUNTER_STAT(sm_write_coalescer_flushes)
+STATS_DEFINE_COUNTER_STAT(sm_write_coalescer_flush_bytes)
 STATS_DEFINE_COUNTER_STAT(sm_contexts_created)
 STATS_DEFINE_COUNTER_STAT(sm_query_submit_layout_col_major)
 STATS_DEFINE_COUNTER_STAT(sm_query_submit_layout_row_major)
@@ -416,19 +461,39 @@ STATS_DEFINE_COUNTER_STAT(vfs_read_total_bytes)
 STATS_DEFINE_COUNTER_STAT(vfs_write_total_bytes)
 STATS_DEFINE_COUNTER_STAT(vfs_read_num_parallelized)
 STATS_DEFINE_COUNTER_STAT(vfs_read_all_total_regions)
+STATS_DEFINE_COUNTER_STAT(vfs_disk_cache_hits)
+STATS_DEFINE_COUNTER_STAT(vfs_disk_cache_misses)
+STATS_DEFINE_COUNTER_STAT(vfs_disk_cache_hit_bytes)
+STATS_DEFINE_COUNTER_STAT(vfs_disk_cache_inserted_bytes)
+STATS_DEFINE_COUNTER_STAT(vfs_disk_cache_evicted_bytes)
 STATS_DEFINE_COUNTER_STAT(vfs_posix_write_num_parallelized)
+STATS_DEFINE_COUNTER_STAT(vfs_posix_io_uring_num_reads)
+STATS_DEFINE_COUNTER_STAT(vfs_posix_io_uring_num_submissions)
 STATS_DEFINE_COUNTER_STAT(vfs_win32_write_num_parallelized)
 STATS_DEFINE_COUNTER_STAT(vfs_s3_num_parts_written)
 STATS_DEFINE_COUNTER_STAT(vfs_s3_write_num_parallelized)
 #endif
 
 #ifdef STATS_INIT_COUNTER_STAT
+// Buffer pool
+STATS_INIT_COUNTER_STAT(buffer_pool_hits)
+STATS_INIT_COUNTER_STAT(buffer_pool_misses)
+STATS_INIT_COUNTER_STAT(buffer_pool_reused_bytes)
+STATS_INIT_COUNTER_STAT(buffer_pool_max_pooled_bytes)
+STATS_INIT_COUNTER_STAT(buffer_pool_max_in_use_bytes)
 // Cache
 STATS_INIT_COUNTER_STAT(cache_lru_inserts)
 STATS_INIT_COUNTER_STAT(cache_lru_read_hits)
 STATS_INIT_COUNTER_STAT(cache_lru_read_misses)
+// Consolidator
+STATS_INIT_COUNTER_STAT(consolidator_num_bytes_copied)
+STATS_INIT_COUNTER_STAT(consolidator_num_cells_merged)
+STATS_INIT_COUNTER_STAT(consolidator_num_tiles_copied)
+// Filters
+STATS_INIT_COUNTER_STAT(filter_checksum_bytes_verified)
 // Fragment Metadata
 STATS_INIT_COUNTER_STAT(fragment_metadata_num_fragments)
+STATS_INIT_COUNTER_STAT(fragment_metadata_num_sections)
 STATS_INIT_COUNTER_STAT(fragment_metadata_bytes)
 STATS_INIT_COUNTER_STAT(fragment_metadata_bytes_read)
 STATS_INIT_COUNTER_STAT(fragment_metadata_cached_bytes_copied)
@@ -448,7 +513,15 @@ STATS_INIT_COUNTER_STAT(reader_num_var_cell_bytes_read)
 STATS_INIT_COUNTER_STAT(writer_num_attr_tiles_written)
 STATS_INIT_COUNTER_STAT(writer_num_bytes_before_filtering)
 STATS_INIT_COUNTER_STAT(writer_num_bytes_written)
+// SIMD (instruction set of the kernels: 0 generic, 1 SSE2, 2 AVX2)
+STATS_INIT_COUNTER_STAT(simd_isa)
 // StorageManager
+STATS_INIT_COUNTER_STAT(sm_array_reopen_reused_fragments)
+STATS_INIT_COUNTER_STAT(sm_auto_consolidations)
+STATS_INIT_COUNTER_STAT(sm_auto_consolidation_bytes)
+STATS_INIT_COUNTER_STAT(sm_write_coalescer_writes)
+STATS_INIT_COUNTER_STAT(sm_write_coalescer_flushes)
+STATS_INIT_COUNTER_STAT(sm_write_coalescer_flush_bytes)
 STATS_INIT_COUNTER_STAT(sm_contexts_created)
 STATS_INIT_COUNTER_STAT(sm_query_submit_layout_col_major)
 STATS_INIT_COUNTER_STAT(sm_query_submit_layout_row_major)
@@ -466,19 +539,39 @@ STATS_INIT_COUNTER_STAT(vfs_read_total_bytes)
 STATS_INIT_COUNTER_STAT(vfs_write_total_bytes)
 STATS_INIT_COUNTER_STAT(vfs_read_num_parallelized)
 STATS_INIT_COUNTER_STAT(vfs_read_all_total_regions)
+STATS_INIT_COUNTER_STAT(vfs_disk_cache_hits)
+STATS_INIT_COUNTER_STAT(vfs_disk_cache_misses)
+STATS_INIT_COUNTER_STAT(vfs_disk_cache_hit_bytes)
+STATS_INIT_COUNTER_STAT(vfs_disk_cache_inserted_bytes)
+STATS_INIT_COUNTER_STAT(vfs_disk_cache_evicted_bytes)
 STATS_INIT_COUNTER_STAT(vfs_posix_write_num_parallelized)
+STATS_INIT_COUNTER_STAT(vfs_posix_io_uring_num_reads)
+STATS_INIT_COUNTER_STAT(vfs_posix_io_uring_num_submissions)
 STATS_INIT_COUNTER_STAT(vfs_win32_write_num_parallelized)
 STATS_INIT_COUNTER_STAT(vfs_s3_num_parts_written)
 STATS_INIT_COUNTER_STAT(vfs_s3_write_num_parallelized)
 #endif
 
 #ifdef STATS_REPORT_COUNTER_STAT
+// Buffer pool
+STATS_REPORT_COUNTER_STAT(buffer_pool_hits)
+STATS_REPORT_COUNTER_STAT(buffer_pool_misses)
+STATS_REPORT_COUNTER_STAT(buffer_pool_reused_bytes)
+STATS_REPORT_COUNTER_STAT(buffer_pool_max_pooled_bytes)
+STATS_REPORT_COUNTER_STAT(buffer_pool_max_in_use_bytes)
 // Cache
 STATS_REPORT_COUNTER_STAT(cache_lru_inserts)
 STATS_REPORT_COUNTER_STAT(cache_lru_read_hits)
 STATS_REPORT_COUNTER_STAT(cache_lru_read_misses)
+// Consolidator
+STATS_REPORT_COUNTER_STAT(consolidator_num_bytes_copied)
+STATS_REPORT_COUNTER_STAT(consolidator_num_cells_merged)
+STATS_REPORT_COUNTER_STAT(consolidator_num_tiles_copied)
+// Filters
+STATS_REPORT_COUNTER_STAT(filter_checksum_bytes_verified)
 // Fragment Metadata
 STATS_REPORT_COUNTER_STAT(fragment_metadata_num_fragments)
+STATS_REPORT_COUNTER_STAT(fragment_metadata_num_sections)
 STATS_REPORT_COUNTER_STAT(fragment_metadata_bytes)
 STATS_REPORT_COUNTER_STAT(fragment_metadata_bytes_read)
 STATS_REPORT_COUNTER_STAT(fragment_metadata_cached_bytes_copied)
@@ -498,7 +591,15 @@ STATS_REPORT_COUNTER_STAT(reader_num_var_cell_bytes_read)
 STATS_REPORT_COUNTER_STAT(writer_num_attr_tiles_written)
 STATS_REPORT_COUNTER_STAT(writer_num_bytes_before_filtering)
 STATS_REPORT_COUNTER_STAT(writer_num_bytes_written)
+// SIMD (instruction set of the kernels: 0 generic, 1 SSE2, 2 AVX2)
+STATS_REPORT_COUNTER_STAT(simd_isa)
 // StorageManager
+STATS_REPORT_COUNTER_STAT(sm_array_reopen_reused_fragments)
+STATS_REPORT_COUNTER_STAT(sm_auto_consolidations)
+STATS_REPORT_COUNTER_STAT(sm_auto_consolidation_bytes)
+STATS_REPORT_COUNTER_STAT(sm_write_coalescer_writes)
+STATS_REPORT_COUNTER_STAT(sm_write_coalescer_flushes)
+STATS_REPORT_COUNTER_STAT(sm_write_coalescer_flush_bytes)
 STATS_REPORT_COUNTER_STAT(sm_contexts_created)
 STATS_REPORT_COUNTER_STAT(sm_query_submit_layout_col_major)
 STATS_REPORT_COUNTER_STAT(sm_query_submit_layout_row_major)
@@ -516,8 +617,42 @@ STATS_REPORT_COUNTER_STAT(vfs_read_total_bytes)
 STATS_REPORT_COUNTER_STAT(vfs_write_total_bytes)
 STATS_REPORT_COUNTER_STAT(vfs_read_num_parallelized)
 STATS_REPORT_COUNTER_STAT(vfs_read_all_total_regions)
+STATS_REPORT_COUNTER_STAT(vfs_disk_cache_hits)
+STATS_REPORT_COUNTER_STAT(vfs_disk_cache_misses)
+STATS_REPORT_COUNTER_STAT(vfs_disk_cache_hit_bytes)
+STATS_REPORT_COUNTER_STAT(vfs_disk_cache_inserted_bytes)
+STATS_REPORT_COUNTER_STAT(vfs_disk_cache_evicted_bytes)
 STATS_REPORT_COUNTER_STAT(vfs_posix_write_num_parallelized)
+STATS_REPORT_COUNTER_STAT(vfs_posix_io_uring_num_reads)
+STATS_REPORT_COUNTER_STAT(vfs_posix_io_uring_num_submissions)
 STATS_REPORT_COUNTER_STAT(vfs_win32_write_num_parallelized)
 STATS_REPORT_COUNTER_STAT(vfs_s3_num_parts_written)
 STATS_REPORT_COUNTER_STAT(vfs_s3_write_num_parallelized)
-#endif
\ No newline at end of file
+#endif
+
+#ifdef STATS_DEFINE_HISTOGRAM_STAT
+STATS_DEFINE_HISTOGRAM_STAT(filter_pipeline_run_forward)
+STATS_DEFINE_HISTOGRAM_STAT(filter_pipeline_run_reverse)
+STATS_DEFINE_HISTOGRAM_STAT(reader_filter_tiles)
+STATS_DEFINE_HISTOGRAM_STAT(reader_read)
+STATS_DEFINE_HISTOGRAM_STAT(vfs_read)
+STATS_DEFINE_HISTOGRAM_STAT(writer_filter_tiles)
+#endif
+
+#ifdef STATS_INIT_HISTOGRAM_STAT
+STATS_INIT_HISTOGRAM_STAT(filter_pipeline_run_forward)
+STATS_INIT_HISTOGRAM_STAT(filter_pipeline_run_reverse)
+STATS_INIT_HISTOGRAM_STAT(reader_filter_tiles)
+STATS_INIT_HISTOGRAM_STAT(reader_read)
+STATS_INIT_HISTOGRAM_STAT(vfs_read)
+STATS_INIT_HISTOGRAM_STAT(writer_filter_tiles)
+#endif
+
+#ifdef STATS_REPORT_HISTOGRAM_STAT
+STATS_REPORT_HISTOGRAM_STAT(filter_pipeline_run_forward)
+STATS_REPORT_HISTOGRAM_STAT(filter_pipeline_run_reverse)
+STATS_REPORT_HISTOGRAM_STAT(reader_filter_tiles)
+STATS_REPORT_HISTOGRAM_STAT(reader_read)
+STATS_REPORT_HISTOGRAM_STAT(vfs_read)
+STATS_REPORT_HISTOGRAM_STAT(writer_filter_tiles)
+#endif
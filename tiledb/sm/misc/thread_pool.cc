@@ -32,12 +32,31 @@
 
 #include "tiledb/sm/misc/thread_pool.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+
+#include <chrono>
 
 namespace tiledb {
 namespace sm {
 
-ThreadPool::ThreadPool() {
-  should_cancel_ = false;
+namespace {
+
+/** The pool the calling thread is a worker of (`nullptr` if none). */
+thread_local const ThreadPool* tl_pool = nullptr;
+
+/** The worker index of the calling thread in `tl_pool`. */
+thread_local int tl_worker_idx = -1;
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+ThreadPool::ThreadPool()
+    : num_waiters_(0) {
+  for (auto& n : num_queued_)
+    n = 0;
   should_terminate_ = false;
 }
 
@@ -45,12 +64,21 @@ ThreadPool::~ThreadPool() {
   terminate();
 }
 
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
 Status ThreadPool::init(uint64_t num_threads) {
   Status st = Status::Ok();
 
+  // The queues must exist before any worker starts
+  for (uint64_t i = 0; i < num_threads; i++)
+    worker_queues_.emplace_back(new TaskQueue());
+
   for (uint64_t i = 0; i < num_threads; i++) {
     try {
-      threads_.emplace_back([this]() { worker(*this); });
+      int idx = (int)i;
+      threads_.emplace_back([this, idx]() { worker(*this, idx); });
     } catch (const std::exception& e) {
       st = Status::Error(
           "Error allocating thread pool of " + std::to_string(num_threads) +
@@ -69,29 +97,21 @@ Status ThreadPool::init(uint64_t num_threads) {
 }
 
 void ThreadPool::cancel_all_tasks() {
-  // Notify workers to dequeue and cancel all tasks.
-  {
-    std::unique_lock<std::mutex> lck(queue_mutex_);
-    should_cancel_ = true;
-    queue_cv_.notify_all();
-  }
-
-  // Wait for the queue to empty and reset the flag.
-  {
-    std::unique_lock<std::mutex> lck(queue_mutex_);
-    queue_cv_.wait(lck, [this]() { return task_queue_.empty(); });
-    should_cancel_ = false;
-  }
+  // Dequeue and cancel all queued tasks. Running tasks are not affected.
+  Task task;
+  while (pop_task(-1, true, &task))
+    run_task(&task, true);
 }
 
 std::future<Status> ThreadPool::enqueue(
-    const std::function<Status()>& function) {
-  return enqueue(function, []() {});
+    const std::function<Status()>& function, Priority priority) {
+  return enqueue(function, []() {}, priority);
 }
 
 std::future<Status> ThreadPool::enqueue(
     const std::function<Status()>& function,
-    const std::function<void()>& on_cancel) {
+    const std::function<void()>& on_cancel,
+    Priority priority) {
   if (threads_.empty()) {
     std::promise<Status> error_task;
     error_task.set_value(
@@ -99,22 +119,38 @@ std::future<Status> ThreadPool::enqueue(
     return error_task.get_future();
   }
 
-  std::packaged_task<Status(bool)> task(
-      [function, on_cancel](bool should_cancel) {
-        if (should_cancel) {
-          on_cancel();
-          return Status::Error("Task cancelled before execution.");
-        } else {
-          return function();
-        }
-      });
+  // Tasks work on behalf of the query of the enqueuing thread
+  auto query_stats = stats::current_query_stats();
+  auto query_id = stats::current_query_id();
+  Task task([function, on_cancel, query_stats, query_id](bool should_cancel) {
+    if (should_cancel) {
+      on_cancel();
+      return Status::Error("Task cancelled before execution.");
+    } else {
+      stats::ScopedQuery scoped_query(query_stats, query_id);
+      return function();
+    }
+  });
   auto future = task.get_future();
 
+  // Workers push to their own queue, other threads to the shared one
+  auto idx = worker_idx();
+  auto& queue = (idx == -1) ? global_queue_ : *worker_queues_[idx];
+  auto p = static_cast<uint8_t>(priority);
+  {
+    std::unique_lock<std::mutex> lck(queue.mtx_);
+    queue.tasks_[p].push_back(std::move(task));
+    num_queued_[p]++;
+  }
+
+  // Acquiring the sleep mutex ensures that a worker or waiting thread about
+  // to sleep either sees the new task or receives the notification.
   {
-    std::unique_lock<std::mutex> lck(queue_mutex_);
-    task_queue_.push(std::move(task));
-    queue_cv_.notify_one();
+    std::unique_lock<std::mutex> lck(sleep_mtx_);
+    if (priority != Priority::BACKGROUND && num_waiters_ > 0)
+      wait_cv_.notify_all();
   }
+  sleep_cv_.notify_one();
 
   return future;
 }
@@ -141,6 +177,7 @@ std::vector<Status> ThreadPool::wait_all_status(
       LOG_ERROR("Waiting on invalid future.");
       statuses.push_back(Status::Error("Invalid future"));
     } else {
+      wait(future);
       Status status = future.get();
       if (!status.ok()) {
         LOG_STATUS(status);
@@ -151,14 +188,85 @@ std::vector<Status> ThreadPool::wait_all_status(
   return statuses;
 }
 
+/* ****************************** */
+/*          PRIVATE METHODS       */
+/* ****************************** */
+
+bool ThreadPool::has_foreground_tasks() const {
+  return num_queued_[static_cast<uint8_t>(Priority::HIGH)] +
+             num_queued_[static_cast<uint8_t>(Priority::NORMAL)] >
+         0;
+}
+
+bool ThreadPool::pop_task(int worker_idx, bool background, Task* task) {
+  auto num_workers = (int)worker_queues_.size();
+  auto num_priorities = background ? num_priorities_ : num_priorities_ - 1;
+  for (int p = 0; p < num_priorities; ++p) {
+    if (num_queued_[p] == 0)
+      continue;
+
+    // Own queue, newest task first
+    if (worker_idx != -1) {
+      auto& queue = *worker_queues_[worker_idx];
+      std::unique_lock<std::mutex> lck(queue.mtx_);
+      if (!queue.tasks_[p].empty()) {
+        *task = std::move(queue.tasks_[p].back());
+        queue.tasks_[p].pop_back();
+        num_queued_[p]--;
+        return true;
+      }
+    }
+
+    // Shared queue, oldest task first
+    {
+      std::unique_lock<std::mutex> lck(global_queue_.mtx_);
+      if (!global_queue_.tasks_[p].empty()) {
+        *task = std::move(global_queue_.tasks_[p].front());
+        global_queue_.tasks_[p].pop_front();
+        num_queued_[p]--;
+        return true;
+      }
+    }
+
+    // Steal the oldest task of another worker
+    for (int i = 1; i <= num_workers; ++i) {
+      auto victim = (worker_idx + i) % num_workers;
+      if (victim == worker_idx)
+        continue;
+      auto& queue = *worker_queues_[victim];
+      std::unique_lock<std::mutex> lck(queue.mtx_);
+      if (!queue.tasks_[p].empty()) {
+        *task = std::move(queue.tasks_[p].front());
+        queue.tasks_[p].pop_front();
+        num_queued_[p]--;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+void ThreadPool::run_task(Task* task, bool should_cancel) {
+  (*task)(should_cancel);
+
+  // The task may be awaited. Acquiring the sleep mutex ensures that a thread
+  // about to wait either sees the finished task or receives the
+  // notification.
+  std::unique_lock<std::mutex> lck(sleep_mtx_);
+  if (num_waiters_ > 0)
+    wait_cv_.notify_all();
+}
+
 void ThreadPool::terminate() {
   {
-    std::unique_lock<std::mutex> lck(queue_mutex_);
-    if (!task_queue_.empty()) {
+    std::unique_lock<std::mutex> lck(sleep_mtx_);
+    if (has_foreground_tasks() ||
+        num_queued_[static_cast<uint8_t>(Priority::BACKGROUND)] > 0) {
       LOG_ERROR("Destroying ThreadPool with outstanding tasks.");
     }
     should_terminate_ = true;
-    queue_cv_.notify_all();
+    sleep_cv_.notify_all();
   }
 
   for (auto& t : threads_) {
@@ -168,41 +276,52 @@ void ThreadPool::terminate() {
   threads_.clear();
 }
 
-void ThreadPool::worker(ThreadPool& pool) {
-  while (true) {
-    std::packaged_task<Status(bool)> task;
-    bool should_cancel = false;
+void ThreadPool::wait_until(const std::function<bool()>& ready) {
+  auto idx = worker_idx();
+  while (!ready()) {
+    // Execute a pending task, which is either awaited or lets the awaited
+    // tasks get to run sooner
+    Task task;
+    if (pop_task(idx, false, &task)) {
+      run_task(&task, false);
+      continue;
+    }
 
-    {
-      // Wait until there's work to do or a message is received.
-      std::unique_lock<std::mutex> lck(pool.queue_mutex_);
-      pool.queue_cv_.wait(lck, [&pool]() {
-        return pool.should_terminate_ || pool.should_cancel_ ||
-               !pool.task_queue_.empty();
-      });
-
-      if (pool.should_terminate_) {
-        break;
-      } else if (!pool.task_queue_.empty()) {
-        task = std::move(pool.task_queue_.front());
-        pool.task_queue_.pop();
-      }
+    // All awaited tasks are running, sleep until one finishes or there is
+    // another task to execute
+    std::unique_lock<std::mutex> lck(sleep_mtx_);
+    num_waiters_++;
+    wait_cv_.wait(lck, [this, &ready]() {
+      return ready() || has_foreground_tasks();
+    });
+    num_waiters_--;
+  }
+}
 
-      // Keep waking up threads until the cancel flag is reset. This also wakes
-      // up the thread that will reset the cancel flag when appropriate.
-      if (pool.should_cancel_) {
-        pool.queue_cv_.notify_all();
-      }
+int ThreadPool::worker_idx() const {
+  return (tl_pool == this) ? tl_worker_idx : -1;
+}
 
-      // Save the cancellation flag.
-      should_cancel = pool.should_cancel_;
-    }
+void ThreadPool::worker(ThreadPool& pool, int worker_idx) {
+  tl_pool = &pool;
+  tl_worker_idx = worker_idx;
 
-    if (task.valid()) {
-      task(should_cancel);
+  while (!pool.should_terminate_) {
+    Task task;
+    if (pool.pop_task(worker_idx, true, &task)) {
+      pool.run_task(&task, false);
+      continue;
     }
+
+    // Wait until there's work to do or the pool terminates.
+    std::unique_lock<std::mutex> lck(pool.sleep_mtx_);
+    pool.sleep_cv_.wait(lck, [&pool]() {
+      return pool.should_terminate_ || pool.has_foreground_tasks() ||
+             pool.num_queued_[static_cast<uint8_t>(Priority::BACKGROUND)] >
+                 0;
+    });
   }
 }
 
 }  // namespace sm
-}  // namespace tiledb
\ No newline at end of file
+}  // namespace tiledb
@@ -33,10 +33,14 @@
 #ifndef TILEDB_THREAD_POOL_H
 #define TILEDB_THREAD_POOL_H
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <vector>
 
@@ -46,16 +50,54 @@ namespace tiledb {
 namespace sm {
 
 /**
- * Thread pool class.
+ * Work-stealing thread pool class.
+ *
+ * Each worker thread owns a task deque. Tasks enqueued by a worker are pushed
+ * to its own deque and popped in LIFO order, which keeps nested parallel work
+ * local and cache-friendly. Tasks enqueued by other threads go to a shared
+ * queue. Idle workers take tasks from the shared queue and then steal the
+ * oldest tasks from the other workers.
+ *
+ * A thread waiting on tasks (`wait_all`, `wait_all_status`), be it a worker
+ * or not, executes pending tasks instead of blocking, its own ones first, so
+ * nested waits (a task waiting on tasks of the same pool) neither deadlock
+ * nor idle a thread. It blocks only while no task is pending, until a task
+ * finishes or a new one is enqueued. The awaited tasks must have been
+ * enqueued in the same pool.
+ *
+ * Waiting threads never start background tasks (see `Priority`). Hence
+ * high- and normal-priority tasks must not take locks that a thread may hold
+ * while waiting on the pool; work that does (e.g., whole queries) must be
+ * enqueued with background priority.
  */
 class ThreadPool {
  public:
+  /* ********************************* */
+  /*          TYPE DEFINITIONS         */
+  /* ********************************* */
+
+  /**
+   * Task priority. Queued high-priority tasks (e.g., I/O that unblocks
+   * further work) are executed before queued normal-priority tasks, and
+   * those before background tasks. Background tasks (e.g., async queries or
+   * background consolidation) are only started by idle workers.
+   */
+  enum class Priority : uint8_t { HIGH = 0, NORMAL = 1, BACKGROUND = 2 };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
   /** Constructor. */
   ThreadPool();
 
   /** Destructor. */
   ~ThreadPool();
 
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
   /**
    * Initialize the thread pool.
    *
@@ -73,32 +115,58 @@ class ThreadPool {
   void cancel_all_tasks();
 
   /**
-   * Enqueue a new task to be executed by a thread.
+   * Enqueue a new task to be executed by a thread. The task works on behalf
+   * of the query the calling thread works on (see `stats::ScopedQuery`),
+   * hence tasks that may outlive that query must be enqueued outside of it.
    *
    * @param function Task function to execute.
+   * @param priority The task priority.
    * @return Future for the return value of the task.
    */
-  std::future<Status> enqueue(const std::function<Status()>& function);
+  std::future<Status> enqueue(
+      const std::function<Status()>& function,
+      Priority priority = Priority::NORMAL);
 
   /**
    * Enqueue a new task to be executed by a thread with a custom callback
    * made if the task is cancelled before it can execute.
    *
-   * Note: the on_cancel callback is made from a thread in the pool.
+   * Note: the on_cancel callback is made from the thread that calls
+   * `cancel_all_tasks`. As above, the task works on behalf of the query the
+   * calling thread works on.
    *
    * @param function Task function to execute.
    * @param on_cancel Cancellation callback function to make on cancel.
+   * @param priority The task priority.
    * @return Future for the return value of the task.
    */
   std::future<Status> enqueue(
       const std::function<Status()>& function,
-      const std::function<void()>& on_cancel);
+      const std::function<void()>& on_cancel,
+      Priority priority = Priority::NORMAL);
 
   /** Return the number of threads in this pool. */
   uint64_t num_threads() const;
 
   /**
-   * Wait on all the given tasks to complete.
+   * Waits for the given future to be ready, executing pending tasks
+   * meanwhile. The future must be made ready by a task of this pool, e.g., a
+   * task that a library enqueued (see `S3ThreadPoolExecutor`).
+   *
+   * @tparam T The value type of the future.
+   * @param future The future.
+   */
+  template <class T>
+  void wait(const std::future<T>& future) {
+    wait_until([&future]() {
+      return future.wait_for(std::chrono::seconds(0)) ==
+             std::future_status::ready;
+    });
+  }
+
+  /**
+   * Wait on all the given tasks to complete. The calling thread executes
+   * pending tasks while it waits.
    *
    * @param tasks Task list to wait on.
    * @return Status::Ok if all tasks returned Status::Ok, otherwise the first
@@ -108,7 +176,7 @@ class ThreadPool {
 
   /**
    * Wait on all the given tasks to complete, return a vector of their return
-   * Status.
+   * Status. The calling thread executes pending tasks while it waits.
    *
    * @param tasks Task list to wait on
    * @return Vector of each task's Status.
@@ -116,25 +184,105 @@ class ThreadPool {
   std::vector<Status> wait_all_status(std::vector<std::future<Status>>& tasks);
 
  private:
-  std::mutex queue_mutex_;
+  /* ********************************* */
+  /*         TYPE DEFINITIONS          */
+  /* ********************************* */
+
+  /** A task. The argument is `true` if the task is being cancelled. */
+  typedef std::packaged_task<Status(bool)> Task;
+
+  /** The number of task priorities. */
+  static const int num_priorities_ = 3;
+
+  /** A task deque per priority, protected by a mutex. */
+  struct TaskQueue {
+    /** Protects `tasks_`. */
+    std::mutex mtx_;
+    /** The queued tasks, indexed by priority. */
+    std::deque<Task> tasks_[num_priorities_];
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The queue of tasks enqueued by threads outside the pool. */
+  TaskQueue global_queue_;
 
-  std::condition_variable queue_cv_;
+  /** The number of queued tasks, indexed by priority. */
+  std::atomic<uint64_t> num_queued_[num_priorities_];
 
-  bool should_cancel_;
+  /** Set when the threads must exit. */
+  std::atomic<bool> should_terminate_;
 
-  bool should_terminate_;
+  /** Idle workers sleep on this condition variable. */
+  std::condition_variable sleep_cv_;
 
-  std::queue<std::packaged_task<Status(bool)>> task_queue_;
+  /** Protects the sleep state of the idle workers and waiting threads. */
+  std::mutex sleep_mtx_;
 
+  /**
+   * Threads waiting on tasks sleep on this condition variable, which is
+   * notified when a task finishes or a foreground task is enqueued.
+   */
+  std::condition_variable wait_cv_;
+
+  /** The number of threads sleeping on `wait_cv_`. */
+  uint64_t num_waiters_;
+
+  /** The worker threads. */
   std::vector<std::thread> threads_;
 
+  /** The per-worker task queues, indexed like `threads_`. */
+  std::vector<std::unique_ptr<TaskQueue>> worker_queues_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns `true` if high- or normal-priority tasks are queued. */
+  bool has_foreground_tasks() const;
+
+  /**
+   * Pops the next task to execute, trying (per priority) the own queue of
+   * the worker (newest task first), the shared queue and then the queues of
+   * the other workers (oldest task first).
+   *
+   * @param worker_idx The index of the calling worker, or -1 if the calling
+   *     thread does not belong to the pool.
+   * @param background Whether background tasks may be popped.
+   * @param task Set to the popped task.
+   * @return `true` if a task was popped.
+   */
+  bool pop_task(int worker_idx, bool background, Task* task);
+
+  /**
+   * Executes the given task and wakes up the threads waiting on tasks.
+   *
+   * @param task The task.
+   * @param should_cancel Whether the task is cancelled instead.
+   */
+  void run_task(Task* task, bool should_cancel);
+
+  /**
+   * Waits until the given predicate holds, executing pending tasks
+   * meanwhile. The predicate is checked whenever a task finishes.
+   *
+   * @param ready The predicate.
+   */
+  void wait_until(const std::function<bool()>& ready);
+
   /** Terminate the threads in the thread pool. */
   void terminate();
 
-  static void worker(ThreadPool& pool);
+  /** Returns the worker index of the calling thread (-1 if not a worker). */
+  int worker_idx() const;
+
+  /** The worker thread loop. */
+  static void worker(ThreadPool& pool, int worker_idx);
 };
 
 }  // namespace sm
 }  // namespace tiledb
 
-#endif  // TILEDB_THREAD_POOL_H
\ No newline at end of file
+#endif  // TILEDB_THREAD_POOL_H
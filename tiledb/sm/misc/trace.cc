@@ -0,0 +1,213 @@
+/**
+ * @file   trace.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the tracer.
+ */
+
+#include "tiledb/sm/misc/trace.h"
+#include "tiledb/sm/misc/stats.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <sstream>
+
+namespace tiledb {
+namespace sm {
+namespace stats {
+
+Tracer tracer;
+
+namespace {
+
+/** Releases the trace buffer of a thread when the thread exits. */
+struct ThreadBuffer {
+  std::shared_ptr<TraceBuffer> buffer_;
+
+  ~ThreadBuffer() {
+    if (buffer_ != nullptr)
+      buffer_->in_use() = false;
+  }
+};
+
+/** The trace buffer of the calling thread. */
+thread_local ThreadBuffer thread_trace_buffer;
+
+}  // namespace
+
+/* ****************************** */
+/*          TRACE BUFFER          */
+/* ****************************** */
+
+const uint64_t TraceBuffer::event_num;
+
+TraceBuffer::TraceBuffer(uint64_t tid)
+    : events_(new TraceEvent[event_num])
+    , head_(0)
+    , tail_(0)
+    , in_use_(true)
+    , tid_(tid) {
+}
+
+void TraceBuffer::clear() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  tail_ = head_;
+}
+
+std::atomic<bool>& TraceBuffer::in_use() {
+  return in_use_;
+}
+
+void TraceBuffer::push(const TraceEvent& event) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto& slot = events_[head_ % event_num];
+  slot = event;
+  slot.tid_ = tid_;
+  ++head_;
+}
+
+void TraceBuffer::set_tid(uint64_t tid) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  tid_ = tid;
+}
+
+void TraceBuffer::snapshot(std::vector<TraceEvent>* events) const {
+  std::unique_lock<std::mutex> lck(mtx_);
+  uint64_t first = tail_;
+  if (head_ > event_num)
+    first = std::max(first, head_ - event_num);
+  for (uint64_t i = first; i < head_; ++i)
+    events->push_back(events_[i % event_num]);
+}
+
+/* ****************************** */
+/*             TRACER             */
+/* ****************************** */
+
+Tracer::Tracer()
+    : enabled_(false)
+    , epoch_(std::chrono::steady_clock::now())
+    , next_tid_(1) {
+}
+
+void Tracer::dump(FILE* out) const {
+  auto json = to_json();
+  fprintf(out, "%s", json.c_str());
+}
+
+void Tracer::dump(std::string* out) const {
+  *out = to_json();
+}
+
+void Tracer::record(
+    const char* name,
+    std::chrono::steady_clock::time_point start,
+    uint64_t dur_ns) {
+  TraceEvent event;
+  event.name_ = name;
+  event.start_ns_ =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch_)
+          .count();
+  event.dur_ns_ = dur_ns;
+  event.query_id_ = current_query_id();
+  thread_buffer()->push(event);
+}
+
+void Tracer::reset() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  for (auto& buffer : buffers_)
+    buffer->clear();
+}
+
+void Tracer::set_enabled(bool enabled) {
+  enabled_ = enabled;
+}
+
+TraceBuffer* Tracer::thread_buffer() {
+  auto& buffer = thread_trace_buffer.buffer_;
+  if (buffer != nullptr)
+    return buffer.get();
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  for (auto& b : buffers_) {
+    bool in_use = false;
+    if (b->in_use().compare_exchange_strong(in_use, true)) {
+      buffer = b;
+      buffer->set_tid(next_tid_++);
+      return buffer.get();
+    }
+  }
+  buffer = std::make_shared<TraceBuffer>(next_tid_++);
+  buffers_.push_back(buffer);
+  return buffer.get();
+}
+
+std::string Tracer::to_json() const {
+  std::stringstream ss;
+  ss << "{\n  \"traceEvents\": [";
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  bool first = true;
+  std::vector<TraceEvent> events;
+  for (const auto& buffer : buffers_) {
+    events.clear();
+    buffer->snapshot(&events);
+    for (const auto& event : events) {
+      ss << (first ? "\n" : ",\n");
+      first = false;
+      char ts[64];
+      snprintf(
+          ts,
+          sizeof(ts),
+          "%" PRIu64 ".%03" PRIu64 "",
+          event.start_ns_ / 1000,
+          event.start_ns_ % 1000);
+      char dur[64];
+      snprintf(
+          dur,
+          sizeof(dur),
+          "%" PRIu64 ".%03" PRIu64 "",
+          event.dur_ns_ / 1000,
+          event.dur_ns_ % 1000);
+      ss << "    {\"name\": \"" << event.name_
+         << "\", \"cat\": \"tiledb\", \"ph\": \"X\", \"ts\": " << ts
+         << ", \"dur\": " << dur << ", \"pid\": 1, \"tid\": " << event.tid_;
+      if (event.query_id_ != 0)
+        ss << ", \"args\": {\"query_id\": " << event.query_id_ << "}";
+      ss << "}";
+    }
+  }
+  lck.unlock();
+
+  ss << "\n  ],\n  \"displayTimeUnit\": \"ns\"\n}\n";
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,194 @@
+/**
+ * @file   trace.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the tracer, which records the timeline of the internal
+ * phases timed by the stats macros and exports it in the Chrome trace event
+ * format (viewable in chrome://tracing or Perfetto).
+ */
+
+#ifndef TILEDB_TRACE_H
+#define TILEDB_TRACE_H
+
+#include "tiledb/sm/misc/macros.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+namespace stats {
+
+/** A complete event, i.e., a timed call of an internal function. */
+struct TraceEvent {
+  /** The name of the function. Must be a string literal. */
+  const char* name_;
+  /** The start time of the call, in ns since the tracer epoch. */
+  uint64_t start_ns_;
+  /** The duration of the call in ns. */
+  uint64_t dur_ns_;
+  /** The id of the query the call was made for, or 0 if none. */
+  uint64_t query_id_;
+  /** The trace thread id of the calling thread, set upon pushing. */
+  uint64_t tid_;
+};
+
+/**
+ * A ring buffer holding the most recent trace events of a single thread.
+ * Only the owning thread pushes events, so its lock is contended only while
+ * a snapshot is taken.
+ */
+class TraceBuffer {
+ public:
+  /** The number of events retained per thread. */
+  static const uint64_t event_num = 1 << 14;
+
+  /** Constructor. */
+  explicit TraceBuffer(uint64_t tid);
+
+  DISABLE_COPY_AND_COPY_ASSIGN(TraceBuffer);
+
+  /** Discards all events. */
+  void clear();
+
+  /** Whether the buffer is owned by a live thread. */
+  std::atomic<bool>& in_use();
+
+  /** Appends an event, overwriting the oldest one if the buffer is full. */
+  void push(const TraceEvent& event);
+
+  /**
+   * Sets the trace thread id of the events pushed from now on. This is
+   * called when the buffer of an exited thread is reused by another one.
+   */
+  void set_tid(uint64_t tid);
+
+  /** Appends the retained events to the input vector, oldest first. */
+  void snapshot(std::vector<TraceEvent>* events) const;
+
+ private:
+  /** The events. */
+  std::unique_ptr<TraceEvent[]> events_;
+
+  /** The total number of events pushed. */
+  uint64_t head_;
+
+  /** The number of events discarded by the last clear. */
+  uint64_t tail_;
+
+  /** Whether the buffer is owned by a live thread. */
+  std::atomic<bool> in_use_;
+
+  /** Protects the events, `head_`, `tail_` and `tid_`. */
+  mutable std::mutex mtx_;
+
+  /** The trace thread id of the events pushed. */
+  uint64_t tid_;
+};
+
+/**
+ * Records trace events into per-thread ring buffers while enabled, and dumps
+ * them as Chrome trace JSON. When disabled, recording costs a single relaxed
+ * atomic load at each instrumented function.
+ */
+class Tracer {
+ public:
+  /** Constructor. */
+  Tracer();
+
+  DISABLE_COPY_AND_COPY_ASSIGN(Tracer);
+
+  /** Dumps the recorded events as Chrome trace JSON to the input file. */
+  void dump(FILE* out) const;
+
+  /** Dumps the recorded events as Chrome trace JSON to the input string. */
+  void dump(std::string* out) const;
+
+  /** Whether tracing is enabled. */
+  bool enabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Records a call of the input function made for the current query of the
+   * calling thread.
+   *
+   * @param name The function name. Must be a string literal.
+   * @param start The start time of the call.
+   * @param dur_ns The duration of the call in ns.
+   */
+  void record(
+      const char* name,
+      std::chrono::steady_clock::time_point start,
+      uint64_t dur_ns);
+
+  /** Discards all recorded events. */
+  void reset();
+
+  /** Enables or disables tracing. */
+  void set_enabled(bool enabled);
+
+ private:
+  /** The buffers of all threads that recorded events. */
+  std::vector<std::shared_ptr<TraceBuffer>> buffers_;
+
+  /** Whether tracing is enabled. */
+  std::atomic<bool> enabled_;
+
+  /** The time event timestamps are relative to. */
+  std::chrono::steady_clock::time_point epoch_;
+
+  /** Protects `buffers_` and `next_tid_`. */
+  mutable std::mutex mtx_;
+
+  /** The trace thread id given to the next thread recording events. */
+  uint64_t next_tid_;
+
+  /**
+   * Returns the buffer of the calling thread, assigning it one (reusing the
+   * buffer of an exited thread if possible) upon its first event.
+   */
+  TraceBuffer* thread_buffer();
+
+  /** Serializes the recorded events as Chrome trace JSON. */
+  std::string to_json() const;
+};
+
+/** The singleton tracer. */
+extern Tracer tracer;
+
+}  // namespace stats
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_TRACE_H
@@ -34,6 +34,8 @@
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/misc/logger.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <set>
 #include <sstream>
@@ -202,6 +204,31 @@ bool is_uint(const std::string& str) {
   return true;
 }
 
+Status fragment_name(
+    const std::string& name, uint64_t* timestamp, bool* consolidated) {
+  // Split the name after the `__` prefix into its `_`-separated parts
+  std::vector<std::string> parts;
+  if (starts_with(name, "__")) {
+    std::stringstream ss(name.substr(2));
+    std::string part;
+    while (std::getline(ss, part, '_'))
+      parts.push_back(part);
+  }
+
+  bool valid = (parts.size() == 2 || parts.size() == 3) && !parts[0].empty();
+  for (size_t i = 1; valid && i < parts.size(); ++i)
+    valid = isdigit(parts[i][0]) && is_uint(parts[i]);
+  if (!valid)
+    return Status::UtilsError(
+        std::string("Cannot parse fragment name '") + name +
+        "'; Invalid format");
+
+  RETURN_NOT_OK(convert(parts.back(), timestamp));
+  *consolidated = (parts.size() == 3);
+
+  return Status::Ok();
+}
+
 std::string domain_str(const void* domain, Datatype type) {
   std::stringstream ss;
 
@@ -592,7 +619,11 @@ double coverage(const T* a, const T* b, unsigned dim_num) {
 
 namespace time {
 
-uint64_t timestamp_now_ms() {
+/** The last timestamp returned by `timestamp_next_ms`. */
+static std::atomic<uint64_t> last_next_ms(0);
+
+/** Returns the wall clock time in milliseconds since the epoch. */
+static uint64_t clock_ms() {
 #ifdef _WIN32
   struct _timeb tb;
   memset(&tb, 0, sizeof(struct _timeb));
@@ -606,6 +637,19 @@ uint64_t timestamp_now_ms() {
 #endif
 }
 
+uint64_t timestamp_now_ms() {
+  return std::max(clock_ms(), last_next_ms.load());
+}
+
+uint64_t timestamp_next_ms() {
+  auto last = last_next_ms.load();
+  uint64_t next;
+  do {
+    next = std::max(clock_ms(), last + 1);
+  } while (!last_next_ms.compare_exchange_weak(last, next));
+  return next;
+}
+
 }  // namespace time
 
 /* ********************************* */
@@ -76,6 +76,21 @@ bool is_int(const std::string& str);
 /** Returns `true` if the input string is an unsigned integer. */
 bool is_uint(const std::string& str);
 
+/**
+ * Parses a fragment name, which is of the form `__<uuid>_<t>` for the
+ * fragments written by queries, and `__<uuid>_<t>_<last_t>` for the
+ * fragments produced by consolidation.
+ *
+ * @param name The fragment name, i.e., the last part of its URI.
+ * @param timestamp Set to the timestamp the fragments are ordered by,
+ *     i.e., `<t>` or `<last_t>` respectively.
+ * @param consolidated Set to `true` if the fragment was produced by
+ *     consolidation.
+ * @return Status, which is an error if `name` is not a fragment name.
+ */
+Status fragment_name(
+    const std::string& name, uint64_t* timestamp, bool* consolidated);
+
 /**
  * Returns the input domain as a string of the form "[low, high]".
  *
@@ -264,10 +279,19 @@ namespace time {
 
 /**
  * Returns the current time in milliseconds since
- * 1970-01-01 00:00:00 +0000 (UTC).
+ * 1970-01-01 00:00:00 +0000 (UTC). This is never earlier than the last
+ * timestamp returned by `timestamp_next_ms`.
  */
 uint64_t timestamp_now_ms();
 
+/**
+ * Returns a timestamp for a new fragment. This is the current time, or one
+ * millisecond past the previous timestamp returned in this process if the
+ * clock has not advanced, so that the fragments created one after the other
+ * get increasing timestamps without waiting for the clock.
+ */
+uint64_t timestamp_next_ms();
+
 }  // namespace time
 
 /* ********************************* */
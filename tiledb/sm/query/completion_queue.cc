@@ -0,0 +1,177 @@
+/**
+ * @file   completion_queue.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class CompletionQueue.
+ */
+
+#include "tiledb/sm/query/completion_queue.h"
+#include "tiledb/sm/misc/logger.h"
+
+#include <chrono>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+CompletionQueue::CompletionQueue() {
+  fd_ = -1;
+  fd_write_ = -1;
+}
+
+CompletionQueue::~CompletionQueue() {
+#ifndef _WIN32
+  if (fd_write_ != -1 && fd_write_ != fd_)
+    ::close(fd_write_);
+  if (fd_ != -1)
+    ::close(fd_);
+#endif
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+int CompletionQueue::fd() const {
+  return fd_;
+}
+
+Status CompletionQueue::init() {
+#if defined(__linux__)
+  fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (fd_ == -1)
+    return LOG_STATUS(Status::QueryError(
+        std::string("Cannot initialize completion queue; ") +
+        strerror(errno)));
+  fd_write_ = fd_;
+#elif !defined(_WIN32)
+  int fds[2];
+  if (pipe(fds) != 0)
+    return LOG_STATUS(Status::QueryError(
+        std::string("Cannot initialize completion queue; ") +
+        strerror(errno)));
+  for (int i = 0; i < 2; ++i) {
+    fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+    fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+  }
+  fd_ = fds[0];
+  fd_write_ = fds[1];
+#endif
+
+  return Status::Ok();
+}
+
+bool CompletionQueue::pop(Event* event) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  if (events_.empty())
+    return false;
+  pop_locked(event);
+  return true;
+}
+
+void CompletionQueue::push(const Event& event) {
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    events_.push_back(event);
+    if (events_.size() == 1)
+      fd_signal();
+  }
+  cv_.notify_one();
+}
+
+uint64_t CompletionQueue::size() const {
+  std::unique_lock<std::mutex> lck(mtx_);
+  return events_.size();
+}
+
+bool CompletionQueue::wait(int64_t timeout_ms, Event* event) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto has_event = [this]() { return !events_.empty(); };
+  if (timeout_ms < 0) {
+    cv_.wait(lck, has_event);
+  } else if (!cv_.wait_for(
+                 lck, std::chrono::milliseconds(timeout_ms), has_event)) {
+    return false;
+  }
+
+  pop_locked(event);
+  return true;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+void CompletionQueue::fd_clear() {
+#ifndef _WIN32
+  if (fd_ == -1)
+    return;
+
+  // The descriptor is non-blocking, so this drains whatever was signalled
+  char buf[64];
+  while (::read(fd_, buf, sizeof(buf)) > 0) {
+  }
+#endif
+}
+
+void CompletionQueue::fd_signal() {
+#ifndef _WIN32
+  if (fd_write_ == -1)
+    return;
+
+  // An eventfd expects an 8-byte counter increment; a pipe accepts any byte
+  uint64_t one = 1;
+  auto nbytes = (fd_write_ == fd_) ? sizeof(one) : 1;
+  if (::write(fd_write_, &one, nbytes) < 0)
+    LOG_STATUS(Status::QueryError(
+        std::string("Cannot signal completion queue; ") + strerror(errno)));
+#endif
+}
+
+void CompletionQueue::pop_locked(Event* event) {
+  *event = events_.front();
+  events_.pop_front();
+  if (events_.empty())
+    fd_clear();
+}
+
+}  // namespace sm
+}  // namespace tiledb
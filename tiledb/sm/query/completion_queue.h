@@ -0,0 +1,164 @@
+/**
+ * @file   completion_queue.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class CompletionQueue.
+ */
+
+#ifndef TILEDB_COMPLETION_QUEUE_H
+#define TILEDB_COMPLETION_QUEUE_H
+
+#include "tiledb/sm/enums/query_status.h"
+#include "tiledb/sm/misc/macros.h"
+#include "tiledb/sm/misc/status.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A queue of completion events of asynchronous queries. Each query
+ * submitted asynchronously with a completion queue posts exactly one event
+ * to the queue when its processing ends, whether it completed, is
+ * incomplete, failed or was cancelled. Many queries can be outstanding on
+ * the same queue.
+ *
+ * On POSIX systems the queue exposes a file descriptor that is readable
+ * whenever the queue is non-empty, so that it can be registered with
+ * `epoll`, `poll` or `select` in an event loop.
+ */
+class CompletionQueue {
+ public:
+  /* ********************************* */
+  /*          TYPE DEFINITIONS         */
+  /* ********************************* */
+
+  /** A completion event. */
+  struct Event {
+    /** The user tag given when the query was submitted. */
+    void* tag_;
+    /** The status of the query when its processing ended. */
+    QueryStatus status_;
+  };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  CompletionQueue();
+
+  /** Destructor. Closes the file descriptor of the queue. */
+  ~CompletionQueue();
+
+  DISABLE_COPY_AND_COPY_ASSIGN(CompletionQueue);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(CompletionQueue);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns the file descriptor that becomes readable when the queue is
+   * non-empty, or -1 if the platform does not support one.
+   */
+  int fd() const;
+
+  /** Initializes the queue, creating its file descriptor. */
+  Status init();
+
+  /**
+   * Retrieves the oldest event of the queue without blocking.
+   *
+   * @param event The retrieved event.
+   * @return `true` if an event was retrieved, `false` if the queue is empty.
+   */
+  bool pop(Event* event);
+
+  /** Posts an event to the queue, waking up any waiters. */
+  void push(const Event& event);
+
+  /** Returns the number of events in the queue. */
+  uint64_t size() const;
+
+  /**
+   * Retrieves the oldest event of the queue, waiting for one to be posted
+   * if the queue is empty.
+   *
+   * @param timeout_ms The maximum time to wait in milliseconds. A negative
+   *     value waits without a time limit.
+   * @param event The retrieved event.
+   * @return `true` if an event was retrieved, `false` on timeout.
+   */
+  bool wait(int64_t timeout_ms, Event* event);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** Notified when an event is posted. */
+  std::condition_variable cv_;
+
+  /** The posted events, oldest first. */
+  std::deque<Event> events_;
+
+  /**
+   * The file descriptor signalled while the queue is non-empty (-1 if
+   * none). On Linux this is an eventfd, otherwise the read end of a pipe.
+   */
+  int fd_;
+
+  /** The write end of the pipe, when the queue does not use an eventfd. */
+  int fd_write_;
+
+  /** Protects the events. */
+  mutable std::mutex mtx_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Clears the readable state of the file descriptor. */
+  void fd_clear();
+
+  /** Makes the file descriptor readable. */
+  void fd_signal();
+
+  /** Pops the oldest event. Must be called with the mutex held. */
+  void pop_locked(Event* event);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_COMPLETION_QUEUE_H
@@ -34,6 +34,7 @@
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/misc/logger.h"
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <sstream>
@@ -41,6 +42,11 @@
 namespace tiledb {
 namespace sm {
 
+namespace {
+/** The id of the next query to be created; 0 denotes "no query". */
+std::atomic<uint64_t> next_query_id(1);
+}  // namespace
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -52,6 +58,9 @@ Query::Query(StorageManager* storage_manager, Array* array, URI fragment_uri)
 
   callback_ = nullptr;
   callback_data_ = nullptr;
+  completion_queue_ = nullptr;
+  completion_tag_ = nullptr;
+  id_ = next_query_id++;
   layout_ = Layout::ROW_MAJOR;
   status_ = QueryStatus::UNINITIALIZED;
   auto st = array->get_query_type(&type_);
@@ -93,10 +102,20 @@ std::vector<std::string> Query::attributes() const {
   return reader_.attributes();
 }
 
+void Query::dump_stats(std::string* out) const {
+  if (stats_ != nullptr) {
+    stats_->dump(out);
+  } else {
+    std::unique_ptr<stats::QueryStats> empty(new stats::QueryStats());
+    empty->dump(out);
+  }
+}
+
 Status Query::finalize() {
   if (status_ == QueryStatus::UNINITIALIZED)
     return Status::Ok();
 
+  stats::ScopedQuery scoped_query(stats_.get(), id_);
   RETURN_NOT_OK(writer_.finalize());
   status_ = QueryStatus::COMPLETED;
   return Status::Ok();
@@ -177,6 +196,10 @@ bool Query::has_results() const {
   return !reader_.no_results();
 }
 
+uint64_t Query::id() const {
+  return id_;
+}
+
 Status Query::init() {
   // Only if the query has not been initialized before
   if (status_ == QueryStatus::UNINITIALIZED) {
@@ -259,12 +282,25 @@ Status Query::check_var_attr_offsets(
   return Status::Ok();
 }
 
+void Query::post_completion(const Status& st) {
+  if (completion_queue_ == nullptr)
+    return;
+
+  auto status = st.ok() ? status_ : QueryStatus::FAILED;
+  completion_queue_->push({completion_tag_, status});
+}
+
 Status Query::process() {
   if (status_ == QueryStatus::UNINITIALIZED)
     return LOG_STATUS(
         Status::QueryError("Cannot process query; Query is not initialized"));
   status_ = QueryStatus::INPROGRESS;
 
+  // Account the stats of all threads working on the query to it
+  if (stats::all_stats.enabled() && stats_ == nullptr)
+    stats_.reset(new (std::nothrow) stats::QueryStats());
+  stats::ScopedQuery scoped_query(stats_.get(), id_);
+
   // Process query
   Status st = Status::Ok();
   if (type_ == QueryType::READ)
@@ -313,6 +349,15 @@ Status Query::set_buffer(
       attribute, buffer_off, buffer_off_size, buffer_val, buffer_val_size);
 }
 
+Status Query::set_coalesce_writes(bool coalesce_writes) {
+  if (type_ != QueryType::WRITE)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set write coalescing; Only applicable to write queries"));
+
+  writer_.set_coalesce_writes(coalesce_writes);
+  return Status::Ok();
+}
+
 Status Query::set_layout(Layout layout) {
   layout_ = layout;
   if (type_ == QueryType::WRITE)
@@ -351,6 +396,21 @@ Status Query::submit_async(
   RETURN_NOT_OK(init());
   callback_ = callback;
   callback_data_ = callback_data;
+  completion_queue_ = nullptr;
+  completion_tag_ = nullptr;
+  return storage_manager_->query_submit_async(this);
+}
+
+Status Query::submit_async(CompletionQueue* completion_queue, void* tag) {
+  if (completion_queue == nullptr)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot submit query; Invalid completion queue"));
+
+  RETURN_NOT_OK(init());
+  callback_ = nullptr;
+  callback_data_ = nullptr;
+  completion_queue_ = completion_queue;
+  completion_tag_ = tag;
   return storage_manager_->query_submit_async(this);
 }
 
@@ -37,14 +37,17 @@
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/misc/utils.h"
+#include "tiledb/sm/query/completion_queue.h"
 #include "tiledb/sm/query/dense_cell_range_iter.h"
 #include "tiledb/sm/query/reader.h"
 #include "tiledb/sm/query/writer.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 
 #include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -89,6 +92,12 @@ class Query {
    */
   std::vector<std::string> attributes() const;
 
+  /**
+   * Dumps the stats gathered while processing the query to the given string
+   * as JSON. Stats are gathered only while global stats are enabled.
+   */
+  void dump_stats(std::string* out) const;
+
   /**
    * Return a copy of the buffer for a given attribute
    * @tparam T
@@ -229,6 +238,12 @@ class Query {
    */
   bool has_results() const;
 
+  /**
+   * Returns the id of the query, unique within the process. It identifies
+   * the query in the trace events.
+   */
+  uint64_t id() const;
+
   /** Initializes the query. */
   Status init();
 
@@ -285,6 +300,18 @@ class Query {
       void* buffer_val,
       uint64_t* buffer_val_size);
 
+  /**
+   * Sets whether the unordered writes of the query may be buffered and
+   * coalesced with other writes to the array, when
+   * `sm.write_coalescing.max_bytes` is non-zero. This is `true` by default.
+   *
+   * @param coalesce_writes Whether the writes may be buffered.
+   * @return Status
+   *
+   * @note Applicable only to writes.
+   */
+  Status set_coalesce_writes(bool coalesce_writes);
+
   /**
    * Sets the cell layout of the query. The function will return an error
    * if the queried array is a key-value store (because it has its default
@@ -325,6 +352,25 @@ class Query {
    */
   Status submit_async(std::function<void(void*)> callback, void* callback_data);
 
+  /**
+   * Submits the query to the storage manager. The query will be
+   * processed asynchronously (i.e., in a non-blocking manner).
+   * Once its processing ends (whether the query completed, is incomplete,
+   * failed or was cancelled), an event with the input tag and the query
+   * status is posted to the input completion queue.
+   *
+   * @note The completion queue must outlive the processing of the query.
+   */
+  Status submit_async(CompletionQueue* completion_queue, void* tag);
+
+  /**
+   * Posts the completion event of an asynchronous query to its completion
+   * queue, if the query was submitted with one.
+   *
+   * @param st The status with which the processing of the query ended.
+   */
+  void post_completion(const Status& st);
+
   /**
    * Return the query subarray
    * @tparam T
@@ -389,12 +435,24 @@ class Query {
   /** The data input to the callback function. */
   void* callback_data_;
 
+  /** The queue an async query posts its completion event to (if any). */
+  CompletionQueue* completion_queue_;
+
+  /** The user tag of the completion event. */
+  void* completion_tag_;
+
+  /** The id of the query. */
+  uint64_t id_;
+
   /** The layout of the cells in the result of the subarray. */
   Layout layout_;
 
   /** The query status. */
   QueryStatus status_;
 
+  /** The stats of the query (`nullptr` if none were gathered). */
+  std::unique_ptr<stats::QueryStats> stats_;
+
   /** The storage manager. */
   StorageManager* storage_manager_;
 
@@ -34,6 +34,7 @@
 #include "tiledb/sm/misc/comparators.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/misc/range_select.h"
 #include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/query/query_macros.h"
@@ -41,6 +42,7 @@
 #include "tiledb/sm/tile/tile_io.h"
 
 #include <iostream>
+#include <numeric>
 
 namespace tiledb {
 namespace sm {
@@ -91,6 +93,12 @@ Reader::Reader() {
   read_state_.subarray_ = nullptr;
   read_state_.initialized_ = false;
   read_state_.overflowed_ = false;
+  read_state_.result_range_idx_ = 0;
+  read_state_.result_range_offset_ = 0;
+  read_state_.result_cell_num_ = 0;
+  read_state_.result_cells_copied_ = 0;
+  partition_utilization_ = constants::read_partition_utilization;
+  verify_checksums_ = constants::verify_checksums;
   sparse_mode_ = false;
 }
 
@@ -190,6 +198,16 @@ Status Reader::init() {
 
   optimize_layout_for_1D();
 
+  // Get configuration parameters
+  partition_utilization_ =
+      storage_manager_->config().sm_params().read_partition_utilization_;
+  verify_checksums_ = storage_manager_->config().sm_params().verify_checksums_;
+
+  // Load the fragment metadata of the queried attributes
+  for (auto meta : fragment_metadata_)
+    RETURN_NOT_OK(meta->load_sections(
+        storage_manager_, array_->get_encryption_key(), attributes_));
+
   if (!fragment_metadata_.empty())
     RETURN_NOT_OK(init_read_state());
 
@@ -209,102 +227,45 @@ Layout Reader::layout() const {
 Status Reader::next_subarray_partition() {
   STATS_FUNC_IN(reader_next_subarray_partition);
 
-  auto domain = array_schema_->domain();
-  read_state_.unsplittable_ = false;
-
-  // Handle case of overflow - the current partition must be split
-  if (read_state_.overflowed_) {
-    void *subarray_1 = nullptr, *subarray_2 = nullptr;
-    Status st = domain->split_subarray(
-        read_state_.cur_subarray_partition_, layout_, &subarray_1, &subarray_2);
-    if (subarray_1 != nullptr && subarray_2 != nullptr) {
-      read_state_.subarray_partitions_.push_front(subarray_2);
-      read_state_.subarray_partitions_.push_front(subarray_1);
-    } else {  // Unsplittable partition
-      read_state_.unsplittable_ = true;
-      return Status::Ok();
-    }
-  }
-
   if (read_state_.subarray_partitions_.empty()) {
     std::free(read_state_.cur_subarray_partition_);
     read_state_.cur_subarray_partition_ = nullptr;
     return Status::Ok();
   }
 
-  // Prepare buffer sizes map
-  std::unordered_map<std::string, std::pair<uint64_t, uint64_t>>
-      buffer_sizes_map;
-  for (const auto& it : attr_buffers_) {
-    buffer_sizes_map[it.first] = std::pair<uint64_t, uint64_t>(
-        it.second.original_buffer_size_, it.second.original_buffer_var_size_);
-  }
-
   // Loop until a new partition whose result fit in the buffers is found
-  std::unordered_map<std::string, std::pair<double, double>> est_buffer_sizes;
   bool found = false;
   void* next_partition = nullptr;
   do {
     // Pop next partition
     std::free(next_partition);
-    next_partition = read_state_.subarray_partitions_.front();
+    auto partition = read_state_.subarray_partitions_.front();
     read_state_.subarray_partitions_.pop_front();
+    next_partition = partition.subarray_;
+    if (partition.fits_) {
+      found = true;
+      break;
+    }
 
-    // Get estimated buffer sizes
-    for (const auto& attr_it : buffer_sizes_map)
-      est_buffer_sizes[attr_it.first] = std::pair<double, double>(0, 0);
-    auto st = storage_manager_->array_compute_est_read_buffer_sizes(
-        array_schema_, fragment_metadata_, next_partition, &est_buffer_sizes);
-
+    // Partition further
+    std::list<SubarrayPartition> partitions;
+    bool unsplittable = false;
+    auto st = compute_subarray_partitions(
+        next_partition, &partitions, &unsplittable);
     if (!st.ok()) {
+      for (auto& p : partitions)
+        std::free(p.subarray_);
       std::free(next_partition);
       clear_read_state();
       return st;
     }
 
-    // Handle case of no results
-    auto no_results = true;
-    for (auto& item : est_buffer_sizes) {
-      if (item.second.first != 0) {
-        no_results = false;
-        break;
-      }
-    }
-    if (no_results)
-      continue;
-
-    // Handle case of split
-    auto must_split = false;
-    for (auto& item : est_buffer_sizes) {
-      auto buffer_size = buffer_sizes_map.find(item.first)->second.first;
-      auto buffer_var_size = buffer_sizes_map.find(item.first)->second.second;
-      auto var_size = array_schema_->var_size(item.first);
-      if (uint64_t(round(item.second.first)) > buffer_size ||
-          (var_size && uint64_t(round(item.second.second)) > buffer_var_size)) {
-        must_split = true;
-        break;
-      }
-    }
-    if (must_split) {
-      void *subarray_1 = nullptr, *subarray_2 = nullptr;
-      st = domain->split_subarray(
-          next_partition, layout_, &subarray_1, &subarray_2);
-      if (!st.ok()) {
-        std::free(next_partition);
-        clear_read_state();
-        return st;
-      }
-
-      // Not splittable, return the original subarray as result
-      if (subarray_1 == nullptr || subarray_2 == nullptr) {
-        found = true;
-        read_state_.unsplittable_ = true;
-      } else {
-        read_state_.subarray_partitions_.push_front(subarray_2);
-        read_state_.subarray_partitions_.push_front(subarray_1);
-      }
-    } else {
+    // Not splittable, return the original subarray as result
+    if (unsplittable) {
       found = true;
+    } else {
+      read_state_.subarray_partitions_.splice(
+          read_state_.subarray_partitions_.begin(), partitions);
     }
   } while (!found && !read_state_.subarray_partitions_.empty());
 
@@ -349,30 +310,23 @@ Status Reader::read() {
     read_state_.overflowed_ = false;
     reset_buffer_sizes();
 
-    // Perform dense or sparse read if there are fragments
+    // Perform dense or sparse read if there are fragments. If results of
+    // the current partition were left over by the previous submission,
+    // this only copies them.
     if (array_schema_->dense() && !sparse_mode_) {
       RETURN_NOT_OK(dense_read());
     } else {
       RETURN_NOT_OK(sparse_read());
     }
 
-    // Zero out the buffer sizes if this partition led to an overflow.
-    // In the case of overflow, `next_subarray_partition` below will
-    // split further the current partition and continue with the loop.
+    // The results of the current partition did not all fit in the buffers.
+    // The remaining ones are kept in the read state for the next submission.
     if (read_state_.overflowed_)
-      zero_out_buffer_sizes();
+      return Status::Ok();
 
     // Advance to the next subarray partition
     RETURN_NOT_OK(next_subarray_partition());
 
-    // If no new subarray partition is found because the current one
-    // is unsplittable, and the current partition had led to an
-    // overflow, zero out the buffer sizes and return
-    if (read_state_.unsplittable_ && read_state_.overflowed_) {
-      zero_out_buffer_sizes();
-      return Status::Ok();
-    }
-
     no_results = this->no_results();
   } while (no_results && read_state_.cur_subarray_partition_ != nullptr);
 
@@ -551,19 +505,31 @@ void* Reader::subarray() const {
 /* ****************************** */
 
 void Reader::clear_read_state() {
-  for (auto p : read_state_.subarray_partitions_)
-    std::free(p);
+  for (auto& p : read_state_.subarray_partitions_)
+    std::free(p.subarray_);
   read_state_.subarray_partitions_.clear();
+  read_state_.overlapping_tile_ids_.clear();
 
   std::free(read_state_.subarray_);
   read_state_.subarray_ = nullptr;
   std::free(read_state_.cur_subarray_partition_);
   read_state_.cur_subarray_partition_ = nullptr;
 
+  clear_result_state();
+
   read_state_.initialized_ = false;
   read_state_.overflowed_ = false;
 }
 
+void Reader::clear_result_state() {
+  read_state_.result_cell_ranges_.clear();
+  read_state_.result_tiles_.clear();
+  read_state_.result_range_idx_ = 0;
+  read_state_.result_range_offset_ = 0;
+  read_state_.result_cell_num_ = 0;
+  read_state_.result_cells_copied_ = 0;
+}
+
 template <class T>
 Status Reader::compute_cell_ranges(
     const OverlappingCoordsList<T>& coords,
@@ -609,6 +575,40 @@ Status Reader::compute_cell_ranges(
   STATS_FUNC_OUT(reader_compute_cell_ranges);
 }
 
+Status Reader::compute_cell_ranges(
+    const OverlappingCoordsPositions& positions,
+    OverlappingCellRangeList* cell_ranges) const {
+  STATS_FUNC_IN(reader_compute_cell_ranges);
+
+  auto tile_num = (uint64_t)positions.tiles_.size();
+  for (uint64_t i = 0; i < tile_num; ++i) {
+    auto begin = positions.offsets_[i];
+    auto end = positions.offsets_[i + 1];
+    if (begin == end)
+      continue;
+
+    // Scan the positions of the tile and compute ranges
+    auto tile = positions.tiles_[i];
+    uint64_t start_pos = positions.pos_[begin];
+    uint64_t end_pos = start_pos;
+    for (auto j = begin + 1; j < end; ++j) {
+      auto pos = positions.pos_[j];
+      if (pos != end_pos + 1) {
+        cell_ranges->emplace_back(tile, start_pos, end_pos);
+        start_pos = pos;
+      }
+      end_pos = pos;
+    }
+
+    // Append the last range of the tile
+    cell_ranges->emplace_back(tile, start_pos, end_pos);
+  }
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(reader_compute_cell_ranges);
+}
+
 template <class T>
 Status Reader::compute_dense_cell_ranges(
     const T* tile_coords,
@@ -892,15 +892,54 @@ Status Reader::compute_dense_overlapping_tiles_and_cell_ranges(
 
 template <class T>
 Status Reader::compute_overlapping_coords(
-    const OverlappingTileVec& tiles, OverlappingCoordsList<T>* coords) const {
+    OverlappingTileVec* tiles, OverlappingCoordsPositions* positions) const {
   STATS_FUNC_IN(reader_compute_overlapping_coords);
 
-  for (const auto& tile : tiles) {
-    if (tile->full_overlap_) {
-      RETURN_NOT_OK(get_all_coords<T>(tile.get(), coords));
-    } else {
-      RETURN_NOT_OK(compute_overlapping_coords<T>(tile.get(), coords));
+  // Compute the positions of each tile in parallel
+  auto tile_num = (uint64_t)tiles->size();
+  std::vector<std::vector<uint64_t>> tile_pos(tile_num);
+  auto statuses = parallel_for(
+      storage_manager_->thread_pool(),
+      0,
+      tile_num,
+      [&](uint64_t i) {
+        return compute_overlapping_coords<T>((*tiles)[i].get(), &tile_pos[i]);
+      });
+  for (const auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // Drop the tiles without coordinates in the subarray
+  uint64_t kept = 0;
+  for (uint64_t i = 0; i < tile_num; ++i) {
+    if (tile_pos[i].empty())
+      continue;
+    if (kept != i) {
+      (*tiles)[kept] = std::move((*tiles)[i]);
+      tile_pos[kept] = std::move(tile_pos[i]);
     }
+    ++kept;
+  }
+  tiles->resize(kept);
+  tile_pos.resize(kept);
+  tile_num = kept;
+
+  // Concatenate the positions of all tiles
+  positions->tiles_.resize(tile_num);
+  positions->offsets_.resize(tile_num + 1);
+  uint64_t total = 0;
+  for (uint64_t i = 0; i < tile_num; ++i) {
+    positions->tiles_[i] = (*tiles)[i].get();
+    positions->offsets_[i] = total;
+    total += tile_pos[i].size();
+  }
+  positions->offsets_[tile_num] = total;
+
+  positions->pos_.resize(total);
+  for (uint64_t i = 0; i < tile_num; ++i) {
+    std::copy(
+        tile_pos[i].begin(),
+        tile_pos[i].end(),
+        positions->pos_.begin() + positions->offsets_[i]);
   }
 
   return Status::Ok();
@@ -910,21 +949,418 @@ Status Reader::compute_overlapping_coords(
 
 template <class T>
 Status Reader::compute_overlapping_coords(
-    const OverlappingTile* tile, OverlappingCoordsList<T>* coords) const {
+    OverlappingTile* tile, std::vector<uint64_t>* pos) const {
+  // For easy reference
   auto dim_num = array_schema_->dim_num();
-  const auto& t = tile->attr_tiles_.find(constants::coords)->second.first;
-  auto coords_num = t.cell_num();
   auto subarray = (T*)read_state_.cur_subarray_partition_;
-  auto c = (T*)t.data();
+  auto& fragment = fragment_metadata_[tile->fragment_idx_];
+  auto coords_num = fragment->cell_num(tile->tile_idx_);
+
+  // The tile lies within the subarray on every dimension
+  if (tile->check_dims_.empty()) {
+    pos->resize(coords_num);
+    std::iota(pos->begin(), pos->end(), 0);
+    return Status::Ok();
+  }
+
+  // Selection bitmap of the cells that fall in the subarray on the
+  // dimensions checked so far
+  std::vector<uint64_t> bitmap(range_select::bitmap_words(coords_num));
+  auto split = fragment->split_coords();
+  bool checked = false;
+  for (auto d : tile->check_dims_) {
+    RETURN_NOT_OK(filter_coords_tile(tile, d));
+
+    // The values of the dimension are contiguous for split coordinates,
+    // and interleaved with the other dimensions otherwise
+    const T* values;
+    uint64_t stride;
+    if (split) {
+      auto dim_name = FragmentMetadata::coords_dim_name(d);
+      const auto& dim_tile = tile->attr_tiles_.find(dim_name)->second.first;
+      values = (const T*)dim_tile.data();
+      stride = 1;
+    } else {
+      const auto& t = tile->attr_tiles_.find(constants::coords)->second.first;
+      values = (const T*)t.data() + d;
+      stride = dim_num;
+    }
 
-  for (uint64_t i = 0, pos = 0; i < coords_num; ++i, pos += dim_num) {
-    if (utils::geometry::coords_in_rect<T>(&c[pos], &subarray[0], dim_num))
-      coords->emplace_back(tile, &c[pos], i);
+    range_select::select<T>(
+        values,
+        stride,
+        coords_num,
+        subarray[2 * d],
+        subarray[2 * d + 1],
+        checked,
+        bitmap.data());
+    checked = true;
+
+    if (range_select::bitmap_empty(bitmap.data(), coords_num))
+      return Status::Ok();
   }
 
+  pos->resize(coords_num);
+  auto n = range_select::bitmap_to_positions(
+      bitmap.data(), coords_num, pos->data());
+  pos->resize(n);
+
   return Status::Ok();
 }
 
+template <class T>
+Status Reader::compute_overlapping_tile_ids() {
+  auto subarray = (const T*)read_state_.subarray_;
+  auto dim_num = array_schema_->dim_num();
+  auto fragment_num = fragment_metadata_.size();
+  auto& tile_ids = read_state_.overlapping_tile_ids_;
+  tile_ids.clear();
+  tile_ids.resize(fragment_num);
+
+  auto statuses = parallel_for(
+      storage_manager_->thread_pool(),
+      0,
+      fragment_num,
+      [&](uint64_t i) {
+        // Applicable only to sparse fragments
+        if (fragment_metadata_[i]->dense())
+          return Status::Ok();
+
+        const auto& mbrs = fragment_metadata_[i]->mbrs();
+        auto mbr_num = (uint64_t)mbrs.size();
+        for (uint64_t j = 0; j < mbr_num; ++j) {
+          if (utils::geometry::overlap(subarray, (const T*)mbrs[j], dim_num))
+            tile_ids[i].push_back(j);
+        }
+        return Status::Ok();
+      });
+
+  for (const auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  return Status::Ok();
+}
+
+Status Reader::compute_subarray_partitions(
+    const void* subarray,
+    std::list<SubarrayPartition>* partitions,
+    bool* unsplittable) {
+  auto coords_type = array_schema_->coords_type();
+  switch (coords_type) {
+    case Datatype::INT8:
+      return compute_subarray_partitions<int8_t>(
+          (const int8_t*)subarray, partitions, unsplittable);
+    case Datatype::UINT8:
+      return compute_subarray_partitions<uint8_t>(
+          (const uint8_t*)subarray, partitions, unsplittable);
+    case Datatype::INT16:
+      return compute_subarray_partitions<int16_t>(
+          (const int16_t*)subarray, partitions, unsplittable);
+    case Datatype::UINT16:
+      return compute_subarray_partitions<uint16_t>(
+          (const uint16_t*)subarray, partitions, unsplittable);
+    case Datatype::INT32:
+      return compute_subarray_partitions<int>(
+          (const int*)subarray, partitions, unsplittable);
+    case Datatype::UINT32:
+      return compute_subarray_partitions<unsigned>(
+          (const unsigned*)subarray, partitions, unsplittable);
+    case Datatype::INT64:
+      return compute_subarray_partitions<int64_t>(
+          (const int64_t*)subarray, partitions, unsplittable);
+    case Datatype::UINT64:
+      return compute_subarray_partitions<uint64_t>(
+          (const uint64_t*)subarray, partitions, unsplittable);
+    case Datatype::FLOAT32:
+      return compute_subarray_partitions<float>(
+          (const float*)subarray, partitions, unsplittable);
+    case Datatype::FLOAT64:
+      return compute_subarray_partitions<double>(
+          (const double*)subarray, partitions, unsplittable);
+    default:
+      return LOG_STATUS(Status::ReaderError(
+          "Cannot partition subarray; Unsupported domain type"));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Reader::compute_subarray_partitions(
+    const T* subarray,
+    std::list<SubarrayPartition>* partitions,
+    bool* unsplittable) {
+  STATS_FUNC_IN(reader_compute_subarray_partitions);
+
+  // The sparse tiles overlapping the query subarray are computed only once
+  if (read_state_.overlapping_tile_ids_.empty())
+    RETURN_NOT_OK(compute_overlapping_tile_ids<T>());
+
+  // For easy reference
+  auto dim_num = array_schema_->dim_num();
+  auto domain = array_schema_->domain();
+  auto dense = array_schema_->dense();
+  auto integer_domain = datatype_is_integer(domain->type());
+  auto subarray_size = 2 * array_schema_->coords_size();
+  auto fragment_num = fragment_metadata_.size();
+  *unsplittable = false;
+
+  // Get the user buffer sizes
+  std::vector<std::string> attributes;
+  std::vector<std::pair<uint64_t, uint64_t>> buffer_sizes;
+  for (const auto& it : attr_buffers_) {
+    attributes.push_back(it.first);
+    buffer_sizes.emplace_back(
+        it.second.original_buffer_size_, it.second.original_buffer_var_size_);
+  }
+  auto attribute_num = attributes.size();
+
+  // Compute the histogram of the estimated result sizes in one pass over
+  // the tiles of all fragments
+  unsigned dim;
+  std::vector<T> bucket_bounds;
+  compute_subarray_partition_buckets(subarray, &dim, &bucket_bounds);
+  auto bucket_num = (uint64_t)bucket_bounds.size() / 2;
+  std::vector<std::pair<double, double>> histogram(
+      bucket_num * attribute_num, std::pair<double, double>(0, 0));
+  std::vector<bool> overlapping(bucket_num, false);
+  for (size_t i = 0; i < fragment_num; ++i) {
+    RETURN_NOT_OK(fragment_metadata_[i]->add_est_read_buffer_sizes_histogram(
+        subarray,
+        &read_state_.overlapping_tile_ids_[i],
+        dim,
+        bucket_bounds,
+        attributes,
+        &histogram,
+        &overlapping));
+  }
+
+  // Make it cumulative, so that any range of buckets is estimated quickly
+  std::vector<std::pair<double, double>> cum_histogram(
+      (bucket_num + 1) * attribute_num, std::pair<double, double>(0, 0));
+  for (uint64_t b = 0; b < bucket_num; ++b) {
+    for (size_t a = 0; a < attribute_num; ++a) {
+      const auto& prev = cum_histogram[b * attribute_num + a];
+      const auto& cur = histogram[b * attribute_num + a];
+      auto& next = cum_histogram[(b + 1) * attribute_num + a];
+      next.first = prev.first + cur.first;
+      next.second = prev.second + cur.second;
+    }
+  }
+
+  // Sets `partition` to the slab of buckets [start, end]
+  std::vector<T> partition(subarray, subarray + 2 * dim_num);
+  auto set_partition = [&](uint64_t start, uint64_t end) {
+    partition[2 * dim] = bucket_bounds[2 * start];
+    partition[2 * dim + 1] = bucket_bounds[2 * end + 1];
+  };
+
+  // Computes the estimated result sizes of buckets [start, end], rectified
+  // with the number of cells of the partition for dense arrays and sparse
+  // arrays with integer domains
+  std::vector<std::pair<double, double>> est(attribute_num);
+  auto estimate = [&](uint64_t start, uint64_t end) {
+    set_partition(start, end);
+    for (size_t a = 0; a < attribute_num; ++a) {
+      const auto& first = cum_histogram[start * attribute_num + a];
+      const auto& last = cum_histogram[(end + 1) * attribute_num + a];
+      est[a].first = last.first - first.first;
+      est[a].second = last.second - first.second;
+    }
+
+    if (!dense && !integer_domain)
+      return;
+    auto cell_num = domain->cell_num(&partition[0]);
+    if (cell_num == 0)
+      return;
+    for (size_t a = 0; a < attribute_num; ++a) {
+      auto var_size = array_schema_->var_size(attributes[a]);
+      if (dense) {
+        est[a].first = var_size ?
+                           cell_num * constants::cell_var_offset_size :
+                           cell_num * array_schema_->cell_size(attributes[a]);
+      } else if (!var_size) {
+        auto cell_size = array_schema_->cell_size(attributes[a]);
+        uint64_t new_size = cell_num * cell_size;
+        if (new_size / cell_size == cell_num)
+          est[a].first = MIN(est[a].first, new_size);
+      }
+    }
+  };
+
+  // Checks if the last estimate fits in the given fraction of the buffers
+  auto fits = [&](double utilization) {
+    for (size_t a = 0; a < attribute_num; ++a) {
+      if (std::round(est[a].first) > utilization * buffer_sizes[a].first ||
+          (array_schema_->var_size(attributes[a]) &&
+           std::round(est[a].second) > utilization * buffer_sizes[a].second))
+        return false;
+    }
+    return true;
+  };
+
+  // Checks if a bucket has no results, i.e., intersects no tile. Its
+  // estimate is not checked, since a tile that only touches a bucket of a
+  // real domain has zero coverage, yet may have cells on the boundary.
+  auto no_results = [&](uint64_t b) {
+    if (overlapping[b])
+      return false;
+    // Dense arrays have results in every cell
+    if (!dense)
+      return true;
+    set_partition(b, b);
+    return domain->cell_num(&partition[0]) == 0;
+  };
+
+  // Adds the slab of buckets [start, end] to the partitions
+  auto add_partition = [&](uint64_t start, uint64_t end, bool fits) {
+    set_partition(start, end);
+    auto p = std::malloc(subarray_size);
+    if (p == nullptr)
+      return LOG_STATUS(Status::ReaderError(
+          "Cannot partition subarray; Memory allocation failed"));
+    std::memcpy(p, &partition[0], subarray_size);
+    partitions->push_back({p, fits});
+    return Status::Ok();
+  };
+
+  // Cut the histogram greedily
+  auto splittable = bucket_num > 1;
+  auto none = bucket_num;
+  auto start = none;
+  for (uint64_t b = 0; b < bucket_num; ++b) {
+    // Try to extend the current partition with the bucket
+    if (start != none) {
+      estimate(start, b);
+      if (fits(partition_utilization_))
+        continue;
+      RETURN_NOT_OK(add_partition(start, b - 1, true));
+      start = none;
+    }
+
+    if (no_results(b))
+      continue;
+
+    // Start a new partition with the bucket. A bucket that does not fit on
+    // its own is partitioned further later.
+    estimate(b, b);
+    if (fits(partition_utilization_)) {
+      start = b;
+    } else if (splittable) {
+      RETURN_NOT_OK(add_partition(b, b, false));
+    } else if (fits(1.0)) {
+      RETURN_NOT_OK(add_partition(b, b, true));
+    } else {
+      *unsplittable = true;
+    }
+  }
+  if (start != none)
+    RETURN_NOT_OK(add_partition(start, bucket_num - 1, true));
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(reader_compute_subarray_partitions);
+}
+
+template <class T>
+void Reader::compute_subarray_partition_buckets(
+    const T* subarray, unsigned* dim, std::vector<T>* bucket_bounds) const {
+  // For easy reference
+  auto dim_num = array_schema_->dim_num();
+  auto domain = array_schema_->domain();
+  auto domain_bounds = (const T*)domain->domain();
+  auto tile_extents = (const T*)domain->tile_extents();
+  auto max_bucket_num = constants::read_partition_histogram_bucket_num;
+  bucket_bounds->clear();
+
+  // In the global order, partition along the tile boundaries of the first
+  // dimension (in the tile order) spanning more than one tile
+  if (layout_ == Layout::GLOBAL_ORDER && tile_extents != nullptr) {
+    auto row_major = domain->tile_order() == Layout::ROW_MAJOR;
+    for (unsigned i = 0; i < dim_num; ++i) {
+      auto d = row_major ? i : dim_num - 1 - i;
+      auto extent = tile_extents[d];
+      auto first_tile = (uint64_t)floor(
+          (subarray[2 * d] - domain_bounds[2 * d]) / extent);
+      auto last_tile = (uint64_t)floor(
+          (subarray[2 * d + 1] - domain_bounds[2 * d]) / extent);
+      if (first_tile == last_tile)
+        continue;
+
+      *dim = d;
+      auto tiles_per_bucket = (last_tile - first_tile) / max_bucket_num + 1;
+      for (auto t = first_tile; t <= last_tile; t += tiles_per_bucket) {
+        T low = (t == first_tile) ? subarray[2 * d] :
+                                    domain_bounds[2 * d] + t * extent;
+        T high = subarray[2 * d + 1];
+        auto next_tile = t + tiles_per_bucket;
+        if (next_tile <= last_tile) {
+          T next_low = domain_bounds[2 * d] + next_tile * extent;
+          high = std::numeric_limits<T>::is_integer ?
+                     next_low - 1 :
+                     std::nextafter(next_low, std::numeric_limits<T>::lowest());
+        }
+        bucket_bounds->push_back(low);
+        bucket_bounds->push_back(high);
+      }
+      return;
+    }
+  }
+
+  // Otherwise, partition along the first dimension (in the cell order) with
+  // more than one coordinate
+  auto cell_order = (layout_ == Layout::ROW_MAJOR ||
+                     layout_ == Layout::COL_MAJOR) ?
+                        layout_ :
+                        domain->cell_order();
+  for (unsigned i = 0; i < dim_num; ++i) {
+    auto d = (cell_order == Layout::ROW_MAJOR) ? i : dim_num - 1 - i;
+    T low = subarray[2 * d], high = subarray[2 * d + 1];
+    if (low == high)
+      continue;
+
+    *dim = d;
+    if (std::numeric_limits<T>::is_integer) {
+      // Equal-width buckets, computed without overflowing `T`
+      auto width = ((uint64_t)high - (uint64_t)low) / max_bucket_num + 1;
+      while (true) {
+        T bucket_high = ((uint64_t)high - (uint64_t)low < width) ?
+                            high :
+                            (T)((uint64_t)low + width - 1);
+        bucket_bounds->push_back(low);
+        bucket_bounds->push_back(bucket_high);
+        if (bucket_high == high)
+          break;
+        low = bucket_high + 1;
+      }
+    } else {
+      // Equal-width buckets, skipping those that collapse to no values
+      auto first = low;
+      for (uint64_t b = 1; b <= max_bucket_num; ++b) {
+        T bucket_high = high;
+        if (b < max_bucket_num) {
+          auto f = (double)b / max_bucket_num;
+          auto edge = (T)(first * (1 - f) + high * f);
+          if (edge <= low || edge > high)
+            continue;
+          bucket_high = std::nextafter(edge, std::numeric_limits<T>::lowest());
+        }
+        bucket_bounds->push_back(low);
+        bucket_bounds->push_back(bucket_high);
+        if (bucket_high == high)
+          break;
+        low = std::nextafter(bucket_high, std::numeric_limits<T>::max());
+      }
+    }
+    return;
+  }
+
+  // The subarray is a single cell and cannot be split
+  *dim = 0;
+  bucket_bounds->push_back(subarray[0]);
+  bucket_bounds->push_back(subarray[1]);
+}
+
 template <class T>
 Status Reader::compute_overlapping_tiles(OverlappingTileVec* tiles) const {
   STATS_FUNC_IN(reader_compute_overlapping_tiles);
@@ -935,20 +1371,31 @@ Status Reader::compute_overlapping_tiles(OverlappingTileVec* tiles) const {
   auto fragment_num = fragment_metadata_.size();
   bool full_overlap;
 
-  // Find overlapping tile indexes for each fragment
+  // Find overlapping tile indexes for each fragment, among the tiles
+  // overlapping the query subarray
   tiles->clear();
+  assert(read_state_.overlapping_tile_ids_.size() == fragment_num);
   for (unsigned i = 0; i < fragment_num; ++i) {
     // Applicable only to sparse fragments
     if (fragment_metadata_[i]->dense())
       continue;
 
-    auto mbrs = fragment_metadata_[i]->mbrs();
-    auto mbr_num = (uint64_t)mbrs.size();
-    for (uint64_t j = 0; j < mbr_num; ++j) {
+    const auto& mbrs = fragment_metadata_[i]->mbrs();
+    for (auto j : read_state_.overlapping_tile_ids_[i]) {
       if (utils::geometry::overlap(
               &subarray[0], (const T*)(mbrs[j]), dim_num, &full_overlap)) {
         auto tile = std::unique_ptr<OverlappingTile>(
             new OverlappingTile(i, j, attributes_, full_overlap));
+        if (!full_overlap) {
+          // Skip the dimensions on which the tile MBR lies within the
+          // subarray
+          auto mbr = (const T*)mbrs[j];
+          for (unsigned d = 0; d < dim_num; ++d) {
+            if (mbr[2 * d] < subarray[2 * d] ||
+                mbr[2 * d + 1] > subarray[2 * d + 1])
+              tile->check_dims_.push_back(d);
+          }
+        }
         tiles->push_back(std::move(tile));
       }
     }
@@ -996,6 +1443,139 @@ Status Reader::compute_tile_coords(
   STATS_FUNC_OUT(reader_compute_tile_coords);
 }
 
+Status Reader::compute_result_cell_num(uint64_t* cell_num) const {
+  // For easy reference
+  const auto& cell_ranges = read_state_.result_cell_ranges_;
+  auto dense_read = array_schema_->dense() && !sparse_mode_;
+  auto offset_size = constants::cell_var_offset_size;
+
+  // Bound the number of cells by the fixed-sized buffers
+  *cell_num = read_state_.result_cell_num_ - read_state_.result_cells_copied_;
+  for (const auto& attr : attributes_) {
+    const auto& attr_buffer = attr_buffers_.find(attr)->second;
+    uint64_t cell_size;
+    if (attr == constants::coords && dense_read)
+      cell_size = array_schema_->coords_size();
+    else if (array_schema_->var_size(attr))
+      cell_size = offset_size;
+    else
+      cell_size = array_schema_->cell_size(attr);
+    *cell_num = std::min(*cell_num, *attr_buffer.buffer_size_ / cell_size);
+  }
+
+  // Bound the number of cells by the var-sized buffers
+  for (const auto& attr : attributes_) {
+    if (!array_schema_->var_size(attr))
+      continue;
+
+    auto buffer_var_size = *attr_buffers_.find(attr)->second.buffer_var_size_;
+    auto fill_size = datatype_size(array_schema_->type(attr));
+    uint64_t num = 0, var_size = 0;
+    auto offset = read_state_.result_range_offset_;
+    bool full = false;
+    for (auto i = read_state_.result_range_idx_;
+         i < cell_ranges.size() && num < *cell_num && !full;
+         ++i, offset = 0) {
+      const auto& cr = cell_ranges[i];
+
+      // Get tile information, if the range is nonempty
+      uint64_t* tile_offsets = nullptr;
+      uint64_t tile_cell_num = 0;
+      uint64_t tile_var_size = 0;
+      if (cr.tile_ != nullptr) {
+        const auto& tile_pair = cr.tile_->attr_tiles_.find(attr)->second;
+        tile_offsets = (uint64_t*)tile_pair.first.data();
+        tile_cell_num = tile_pair.first.cell_num();
+        tile_var_size = tile_pair.second.size();
+      }
+
+      for (auto cell_idx = cr.start_ + offset;
+           cell_idx <= cr.end_ && num < *cell_num;
+           ++cell_idx, ++num) {
+        uint64_t cell_var_size = fill_size;
+        if (cr.tile_ != nullptr)
+          cell_var_size =
+              (cell_idx != tile_cell_num - 1) ?
+                  tile_offsets[cell_idx + 1] - tile_offsets[cell_idx] :
+                  tile_var_size - (tile_offsets[cell_idx] - tile_offsets[0]);
+        if (var_size + cell_var_size > buffer_var_size) {
+          full = true;
+          break;
+        }
+        var_size += cell_var_size;
+      }
+    }
+    *cell_num = std::min(*cell_num, num);
+  }
+
+  return Status::Ok();
+}
+
+Status Reader::copy_result_cells() {
+  STATS_FUNC_IN(reader_copy_result_cells);
+
+  // For easy reference
+  const auto& result_cell_ranges = read_state_.result_cell_ranges_;
+  auto dense_read = array_schema_->dense() && !sparse_mode_;
+
+  // Nothing to copy
+  if (read_state_.result_cells_copied_ == read_state_.result_cell_num_) {
+    clear_result_state();
+    zero_out_buffer_sizes();
+    return Status::Ok();
+  }
+
+  // Not even a single cell fits in the buffers
+  uint64_t cell_num;
+  RETURN_NOT_OK(compute_result_cell_num(&cell_num));
+  if (cell_num == 0) {
+    zero_out_buffer_sizes();
+    read_state_.overflowed_ = true;
+    return Status::Ok();
+  }
+
+  // Get the cell ranges of the next `cell_num` cells, advancing the cursor
+  OverlappingCellRangeList cell_ranges;
+  auto& idx = read_state_.result_range_idx_;
+  auto& offset = read_state_.result_range_offset_;
+  for (uint64_t left = cell_num; left > 0;) {
+    const auto& cr = result_cell_ranges[idx];
+    auto start = cr.start_ + offset;
+    auto num = std::min(cr.end_ - start + 1, left);
+    cell_ranges.emplace_back(cr.tile_, start, start + num - 1);
+    left -= num;
+    if (start + num - 1 == cr.end_) {
+      ++idx;
+      offset = 0;
+    } else {
+      offset += num;
+    }
+  }
+
+  // Copy cells
+  for (const auto& attr : attributes_) {
+    if (attr != constants::coords || !dense_read)
+      RETURN_CANCEL_OR_ERROR(copy_cells(attr, cell_ranges));
+  }
+
+  // Fill coordinates if the user requested them
+  if (dense_read && has_coords()) {
+    RETURN_CANCEL_OR_ERROR(
+        fill_coords(read_state_.result_cells_copied_, cell_num));
+  }
+
+  // Keep the remaining results for the next submission
+  read_state_.result_cells_copied_ += cell_num;
+  if (read_state_.result_cells_copied_ == read_state_.result_cell_num_)
+    clear_result_state();
+  else
+    read_state_.overflowed_ = true;
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(reader_copy_result_cells);
+}
+
 Status Reader::copy_cells(
     const std::string& attribute, const OverlappingCellRangeList& cell_ranges) {
   // Early exit for empty cell range list.
@@ -1041,7 +1621,8 @@ Status Reader::copy_fixed_cells(
   }
 
   // Copy cell ranges in parallel.
-  auto statuses = parallel_for(0, num_cr, [&](uint64_t i) {
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, num_cr, [&](uint64_t i) {
     const auto& cr = cell_ranges[i];
     uint64_t offset = cr_offsets[i];
     // Check for overflow
@@ -1055,6 +1636,22 @@ Status Reader::copy_fixed_cells(
         std::memcpy(buffer + offset, fill_value, fill_size);
         offset += fill_size;
       }
+    } else if (
+        attribute == constants::coords &&
+        fragment_metadata_[cr.tile_->fragment_idx_]->split_coords()) {
+      // Interleave the values of the dimension tiles
+      auto dim_num = array_schema_->dim_num();
+      auto coord_size = cell_size / dim_num;
+      auto cell_num = cr.end_ - cr.start_ + 1;
+      for (unsigned d = 0; d < dim_num; ++d) {
+        auto dim_name = FragmentMetadata::coords_dim_name(d);
+        const auto& tile = cr.tile_->attr_tiles_.find(dim_name)->second.first;
+        auto data = (unsigned char*)tile.data() + cr.start_ * coord_size;
+        auto dest = buffer + offset + d * coord_size;
+        for (uint64_t c = 0; c < cell_num; ++c)
+          std::memcpy(
+              dest + c * cell_size, data + c * coord_size, coord_size);
+      }
     } else {  // Non-empty range
       const auto& tile = cr.tile_->attr_tiles_.find(attribute)->second.first;
       auto data = (unsigned char*)tile.data();
@@ -1112,7 +1709,8 @@ Status Reader::copy_var_cells(
 
   // Copy cell ranges in parallel.
   const auto num_cr = cell_ranges.size();
-  auto statuses = parallel_for(0, num_cr, [&](uint64_t cr_idx) {
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, num_cr, [&](uint64_t cr_idx) {
     const auto& cr = cell_ranges[cr_idx];
     const auto& offset_offsets = offset_offsets_per_cr[cr_idx];
     const auto& var_offsets = var_offsets_per_cr[cr_idx];
@@ -1296,6 +1894,10 @@ template <class T>
 Status Reader::dense_read() {
   STATS_FUNC_IN(reader_dense_read);
 
+  // Resume copying the results left over by the previous submission
+  if (!read_state_.result_cell_ranges_.empty())
+    return copy_result_cells();
+
   // For easy reference
   auto domain = array_schema_->domain();
   auto subarray_len = 2 * array_schema_->dim_num();
@@ -1308,15 +1910,21 @@ Status Reader::dense_read() {
   OverlappingTileVec sparse_tiles;
   RETURN_CANCEL_OR_ERROR(compute_overlapping_tiles<T>(&sparse_tiles));
 
-  // Read sparse tiles
-  RETURN_CANCEL_OR_ERROR(read_all_tiles(&sparse_tiles));
+  // Compute the read coordinates for all sparse fragments, reading only
+  // the coordinates checked against the subarray
+  RETURN_CANCEL_OR_ERROR(read_check_coords_tiles(&sparse_tiles));
+  OverlappingCoordsPositions positions;
+  RETURN_CANCEL_OR_ERROR(
+      compute_overlapping_coords<T>(&sparse_tiles, &positions));
 
-  // Filter sparse tiles
+  // Read and filter the rest of the sparse tiles with results
+  RETURN_CANCEL_OR_ERROR(read_all_tiles(&sparse_tiles));
   RETURN_CANCEL_OR_ERROR(filter_all_tiles(&sparse_tiles));
 
-  // Compute the read coordinates for all sparse fragments
+  std::vector<T> coords_buff;
   OverlappingCoordsList<T> coords;
-  RETURN_CANCEL_OR_ERROR(compute_overlapping_coords<T>(sparse_tiles, &coords));
+  RETURN_CANCEL_OR_ERROR(get_coords_list<T>(positions, &coords_buff, &coords));
+  positions = OverlappingCoordsPositions();
 
   // Compute the tile coordinates for all overlapping coordinates (for sorting).
   std::unique_ptr<T[]> tile_coords(nullptr);
@@ -1360,6 +1968,7 @@ Status Reader::dense_read() {
   RETURN_CANCEL_OR_ERROR(compute_dense_overlapping_tiles_and_cell_ranges<T>(
       dense_cell_ranges, coords, &dense_tiles, &overlapping_cell_ranges));
   coords.clear();
+  coords_buff.clear();
   dense_cell_ranges.clear();
   overlapping_tile_idx_coords.clear();
 
@@ -1369,26 +1978,54 @@ Status Reader::dense_read() {
   // Filter dense tiles
   RETURN_CANCEL_OR_ERROR(filter_all_tiles(&dense_tiles, false));
 
-  // Copy cells
-  for (const auto& attr : attributes_) {
-    if (read_state_.overflowed_)
-      break;
-
-    if (attr != constants::coords)  // Skip coordinates
-      RETURN_CANCEL_OR_ERROR(copy_cells(attr, overlapping_cell_ranges));
-  }
+  // Keep the tiles and cell ranges in the read state, so that the results
+  // that do not fit in the buffers are copied by the next submissions
+  clear_result_state();
+  read_state_.result_tiles_ = std::move(sparse_tiles);
+  for (auto& tile : dense_tiles)
+    read_state_.result_tiles_.push_back(std::move(tile));
+  dense_tiles.clear();
+  read_state_.result_cell_ranges_ = std::move(overlapping_cell_ranges);
+  for (const auto& cr : read_state_.result_cell_ranges_)
+    read_state_.result_cell_num_ += cr.end_ - cr.start_ + 1;
 
-  // Fill coordinates if the user requested them
-  if (!read_state_.overflowed_ && has_coords())
-    RETURN_CANCEL_OR_ERROR(fill_coords<T>());
+  // Copy cells
+  RETURN_CANCEL_OR_ERROR(copy_result_cells());
 
   return Status::Ok();
 
   STATS_FUNC_OUT(reader_dense_read);
 }
 
+Status Reader::fill_coords(uint64_t skip, uint64_t num) {
+  auto coords_type = array_schema_->coords_type();
+  switch (coords_type) {
+    case Datatype::INT8:
+      return fill_coords<int8_t>(skip, num);
+    case Datatype::UINT8:
+      return fill_coords<uint8_t>(skip, num);
+    case Datatype::INT16:
+      return fill_coords<int16_t>(skip, num);
+    case Datatype::UINT16:
+      return fill_coords<uint16_t>(skip, num);
+    case Datatype::INT32:
+      return fill_coords<int>(skip, num);
+    case Datatype::UINT32:
+      return fill_coords<unsigned>(skip, num);
+    case Datatype::INT64:
+      return fill_coords<int64_t>(skip, num);
+    case Datatype::UINT64:
+      return fill_coords<uint64_t>(skip, num);
+    default:
+      return LOG_STATUS(Status::ReaderError(
+          "Cannot fill coordinates; Unsupported domain type"));
+  }
+
+  return Status::Ok();
+}
+
 template <class T>
-Status Reader::fill_coords() {
+Status Reader::fill_coords(uint64_t skip, uint64_t num) {
   STATS_FUNC_IN(reader_fill_coords);
 
   // For easy reference
@@ -1399,32 +2036,47 @@ Status Reader::fill_coords() {
   auto coords_buff_size = *(it->second.buffer_size_);
   auto domain = array_schema_->domain();
   auto cell_order = array_schema_->cell_order();
-  auto subarray_len = 2 * array_schema_->dim_num();
+  auto dim_num = array_schema_->dim_num();
+  auto subarray_len = 2 * dim_num;
   auto coords_size = array_schema_->coords_size();
+  auto row_slabs =
+      layout_ == Layout::ROW_MAJOR ||
+      (layout_ == Layout::GLOBAL_ORDER && cell_order == Layout::ROW_MAJOR);
   std::vector<T> subarray;
   subarray.resize(subarray_len);
   for (size_t i = 0; i < subarray_len; ++i)
     subarray[i] = ((T*)read_state_.cur_subarray_partition_)[i];
 
-  // Iterate over all coordinates, retrieved in cell slabs
+  // Iterate over the coordinates in cell slabs, filling only the slab
+  // parts within cells [skip, skip + num)
+  std::vector<T> start(dim_num);
+  uint64_t pos = 0, end = skip + num;
   DenseCellRangeIter<T> cell_it(domain, subarray, layout_);
   RETURN_CANCEL_OR_ERROR(cell_it.begin());
-  while (!cell_it.end()) {
-    auto coords_num = cell_it.range_end() - cell_it.range_start() + 1;
+  while (!cell_it.end() && pos < end) {
+    auto slab_num = cell_it.range_end() - cell_it.range_start() + 1;
+    if (pos + slab_num > skip) {
+      auto slab_skip = (skip > pos) ? skip - pos : 0;
+      auto coords_num = std::min(pos + slab_num, end) - pos - slab_skip;
+
+      // Check for overflow
+      if (coords_num * coords_size + coords_buff_offset > coords_buff_size) {
+        read_state_.overflowed_ = true;
+        return Status::Ok();
+      }
 
-    // Check for overflow
-    if (coords_num * coords_size + coords_buff_offset > coords_buff_size) {
-      read_state_.overflowed_ = true;
-      return Status::Ok();
+      std::memcpy(&start[0], cell_it.coords_start(), coords_size);
+      if (row_slabs) {
+        start[dim_num - 1] += slab_skip;
+        fill_coords_row_slab(
+            &start[0], coords_num, coords_buff, &coords_buff_offset);
+      } else {
+        start[0] += slab_skip;
+        fill_coords_col_slab(
+            &start[0], coords_num, coords_buff, &coords_buff_offset);
+      }
     }
-
-    if (layout_ == Layout::ROW_MAJOR ||
-        (layout_ == Layout::GLOBAL_ORDER && cell_order == Layout::ROW_MAJOR))
-      fill_coords_row_slab(
-          cell_it.coords_start(), coords_num, coords_buff, &coords_buff_offset);
-    else
-      fill_coords_col_slab(
-          cell_it.coords_start(), coords_num, coords_buff, &coords_buff_offset);
+    pos += slab_num;
     ++cell_it;
   }
 
@@ -1503,6 +2155,7 @@ Status Reader::filter_all_tiles(
 
   // Filter the tiles in parallel over the attributes.
   auto statuses = parallel_for_each(
+      storage_manager_->thread_pool(),
       all_attributes.begin(),
       all_attributes.end(),
       [this, &tiles](const std::string& attr) {
@@ -1520,27 +2173,53 @@ Status Reader::filter_tiles(
     const std::string& attribute, OverlappingTileVec* tiles) const {
   STATS_FUNC_IN(reader_filter_tiles);
 
+  // Get the filter pipeline of the fixed-sized (or offsets) tiles
   auto var_size = array_schema_->var_size(attribute);
+  const FilterPipeline* filters;
+  if (attribute == constants::coords)
+    filters = array_schema_->coords_filters();
+  else if (var_size)
+    filters = array_schema_->cell_var_offsets_filters();
+  else
+    filters = array_schema_->filters(attribute);
+
   auto num_tiles = static_cast<uint64_t>(tiles->size());
-  auto statuses = parallel_for(0, num_tiles, [&, this](uint64_t i) {
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, num_tiles, [&, this](uint64_t i) {
     auto& tile = (*tiles)[i];
     auto it = tile->attr_tiles_.find(attribute);
     // Skip non-existent attributes (e.g. coords in the dense case).
     if (it == tile->attr_tiles_.end())
       return Status::Ok();
 
-    // Get information about the tile in its fragment
+    auto& tile_pair = it->second;
+    auto& t = tile_pair.first;
+    auto& t_var = tile_pair.second;
+
+    // The coordinates of the fragments with split coordinates are filtered
+    // per dimension, only for the dimension tiles that were read.
     auto& fragment = fragment_metadata_[tile->fragment_idx_];
+    if (attribute == constants::coords && fragment->split_coords()) {
+      for (unsigned d = 0; d < array_schema_->dim_num(); ++d) {
+        auto dim_it =
+            tile->attr_tiles_.find(FragmentMetadata::coords_dim_name(d));
+        if (dim_it != tile->attr_tiles_.end() &&
+            dim_it->second.first.buffer() != nullptr)
+          RETURN_NOT_OK(filter_coords_tile(tile.get(), d));
+      }
+      return Status::Ok();
+    }
+
+    // Get information about the tile in its fragment
     auto tile_attr_uri = fragment->attr_uri(attribute);
     auto tile_attr_offset = fragment->file_offset(attribute, tile->tile_idx_);
 
-    auto& tile_pair = it->second;
-    auto& t = tile_pair.first;
-    auto& t_var = tile_pair.second;
+    // The attribute values may be compressed with a dictionary
+    auto dict = fragment->zstd_dictionary(attribute);
 
     if (!t.filtered()) {
       // Decompress, etc.
-      RETURN_NOT_OK(filter_tile(attribute, &t, var_size));
+      RETURN_NOT_OK(filter_tile(filters, var_size ? nullptr : dict, &t));
       RETURN_NOT_OK(storage_manager_->write_to_cache(
           tile_attr_uri, tile_attr_offset, t.buffer()));
     }
@@ -1551,7 +2230,8 @@ Status Reader::filter_tiles(
           fragment->file_var_offset(attribute, tile->tile_idx_);
 
       // Decompress, etc.
-      RETURN_NOT_OK(filter_tile(attribute, &t_var, false));
+      RETURN_NOT_OK(
+          filter_tile(array_schema_->filters(attribute), dict, &t_var));
       RETURN_NOT_OK(storage_manager_->write_to_cache(
           tile_attr_var_uri, tile_attr_var_offset, t_var.buffer()));
     }
@@ -1567,25 +2247,50 @@ Status Reader::filter_tiles(
   STATS_FUNC_OUT(reader_filter_tiles);
 }
 
-Status Reader::filter_tile(
-    const std::string& attribute, Tile* tile, bool offsets) const {
-  uint64_t orig_size = tile->buffer()->size();
+Status Reader::filter_coords_tile(OverlappingTile* tile, unsigned dim) const {
+  // For easy reference
+  auto& fragment = fragment_metadata_[tile->fragment_idx_];
+  auto split = fragment->split_coords();
+  auto name =
+      split ? FragmentMetadata::coords_dim_name(dim) : constants::coords;
+  auto& t = tile->attr_tiles_.find(name)->second.first;
+  if (t.filtered())
+    return Status::Ok();
 
-  // Get a copy of the appropriate filter pipeline.
-  FilterPipeline filters;
-  if (tile->stores_coords()) {
-    filters = *array_schema_->coords_filters();
-  } else if (offsets) {
-    filters = *array_schema_->cell_var_offsets_filters();
+  // Decompress, etc.
+  if (split) {
+    RETURN_NOT_OK(filter_tile(array_schema_->coords_filters(dim), nullptr, &t));
   } else {
-    filters = *array_schema_->filters(attribute);
+    RETURN_NOT_OK(filter_tile(
+        array_schema_->coords_filters(),
+        fragment->zstd_dictionary(constants::coords),
+        &t));
   }
 
+  return storage_manager_->write_to_cache(
+      fragment->attr_uri(name),
+      fragment->file_offset(name, tile->tile_idx_),
+      t.buffer());
+}
+
+Status Reader::filter_tile(
+    const FilterPipeline* filters,
+    const std::shared_ptr<ZStdDictionary>& zstd_dictionary,
+    Tile* tile) const {
+  uint64_t orig_size = tile->buffer()->size();
+
+  // Get a copy of the filter pipeline.
+  FilterPipeline tile_filters = *filters;
+  if (zstd_dictionary != nullptr)
+    tile_filters.set_zstd_dictionary(zstd_dictionary);
+  tile_filters.set_verify_checksums(verify_checksums_);
+
   // Append an encryption filter when necessary.
   RETURN_NOT_OK(FilterPipeline::append_encryption_filter(
-      &filters, array_->get_encryption_key()));
+      &tile_filters, array_->get_encryption_key()));
 
-  RETURN_NOT_OK(filters.run_reverse(tile));
+  RETURN_NOT_OK(
+      tile_filters.run_reverse(tile, storage_manager_->thread_pool()));
 
   tile->set_filtered(true);
   tile->set_pre_filtered_size(orig_size);
@@ -1596,15 +2301,65 @@ Status Reader::filter_tile(
 }
 
 template <class T>
-Status Reader::get_all_coords(
-    const OverlappingTile* tile, OverlappingCoordsList<T>* coords) const {
+Status Reader::get_coords_list(
+    const OverlappingCoordsPositions& positions,
+    std::vector<T>* coords_buff,
+    OverlappingCoordsList<T>* coords) const {
   auto dim_num = array_schema_->dim_num();
-  const auto& t = tile->attr_tiles_.find(constants::coords)->second.first;
-  auto coords_num = t.cell_num();
-  auto c = (T*)t.data();
+  auto tile_num = (uint64_t)positions.tiles_.size();
+  coords->resize(
+      positions.pos_.size(), OverlappingCoords<T>(nullptr, nullptr, 0));
+
+  // Reserve a coordinate tuple per overlapping cell of the tiles with
+  // split coordinates
+  std::vector<uint64_t> buff_offsets(tile_num);
+  uint64_t buff_num = 0;
+  for (uint64_t i = 0; i < tile_num; ++i) {
+    buff_offsets[i] = buff_num;
+    if (fragment_metadata_[positions.tiles_[i]->fragment_idx_]->split_coords())
+      buff_num += positions.offsets_[i + 1] - positions.offsets_[i];
+  }
+  coords_buff->resize(buff_num * dim_num);
+
+  auto statuses = parallel_for(
+      storage_manager_->thread_pool(),
+      0,
+      tile_num,
+      [&](uint64_t i) {
+        auto tile = positions.tiles_[i];
+        auto begin = positions.offsets_[i];
+        auto end = positions.offsets_[i + 1];
+
+        // Point into the coordinates tile
+        if (!fragment_metadata_[tile->fragment_idx_]->split_coords()) {
+          const auto& t =
+              tile->attr_tiles_.find(constants::coords)->second.first;
+          auto c = (const T*)t.data();
+          for (auto j = begin; j < end; ++j) {
+            auto p = positions.pos_[j];
+            (*coords)[j] = OverlappingCoords<T>(tile, &c[p * dim_num], p);
+          }
+          return Status::Ok();
+        }
 
-  for (uint64_t i = 0; i < coords_num; ++i)
-    coords->emplace_back(tile, &c[i * dim_num], i);
+        // Gather the coordinates of the overlapping cells from the
+        // dimension tiles
+        auto c = coords_buff->data() + buff_offsets[i] * dim_num;
+        for (unsigned d = 0; d < dim_num; ++d) {
+          auto dim_name = FragmentMetadata::coords_dim_name(d);
+          auto values =
+              (const T*)tile->attr_tiles_.find(dim_name)->second.first.data();
+          for (auto j = begin; j < end; ++j)
+            c[(j - begin) * dim_num + d] = values[positions.pos_[j]];
+        }
+        for (auto j = begin; j < end; ++j) {
+          (*coords)[j] = OverlappingCoords<T>(
+              tile, &c[(j - begin) * dim_num], positions.pos_[j]);
+        }
+        return Status::Ok();
+      });
+  for (const auto& st : statuses)
+    RETURN_NOT_OK(st);
 
   return Status::Ok();
 }
@@ -1685,7 +2440,7 @@ Status Reader::init_read_state() {
         "Cannot initialize read state; Memory allocation failed"));
 
   std::memcpy(first_partition, read_state_.subarray_, subarray_size);
-  read_state_.subarray_partitions_.push_back(first_partition);
+  read_state_.subarray_partitions_.push_back({first_partition, false});
 
   RETURN_NOT_OK(next_subarray_partition());
 
@@ -1706,10 +2461,11 @@ Status Reader::init_tile(
   auto cell_num_per_tile =
       (has_coords()) ? capacity : domain->cell_num_per_tile();
   auto tile_size = cell_num_per_tile * cell_size;
+  auto buffer_pool = storage_manager_->buffer_pool();
 
   // Initialize
-  RETURN_NOT_OK(
-      tile->init(format_version, type, tile_size, cell_size, dim_num));
+  RETURN_NOT_OK(tile->init(
+      format_version, type, tile_size, cell_size, dim_num, buffer_pool));
 
   return Status::Ok();
 }
@@ -1726,6 +2482,7 @@ Status Reader::init_tile(
   auto cell_num_per_tile =
       (has_coords()) ? capacity : domain->cell_num_per_tile();
   auto tile_size = cell_num_per_tile * constants::cell_var_offset_size;
+  auto buffer_pool = storage_manager_->buffer_pool();
 
   // Initialize
   RETURN_NOT_OK(tile->init(
@@ -1733,9 +2490,10 @@ Status Reader::init_tile(
       constants::cell_var_offset_type,
       tile_size,
       constants::cell_var_offset_size,
-      0));
-  RETURN_NOT_OK(
-      tile_var->init(format_version, type, tile_size, datatype_size(type), 0));
+      0,
+      buffer_pool));
+  RETURN_NOT_OK(tile_var->init(
+      format_version, type, tile_size, datatype_size(type), 0, buffer_pool));
   return Status::Ok();
 }
 
@@ -1856,8 +2614,7 @@ Status Reader::read_all_tiles(
     RETURN_CANCEL_OR_ERROR(read_tiles(attr, tiles, &tasks));
 
   // Wait for the reads to finish and check statuses.
-  auto statuses =
-      storage_manager_->reader_thread_pool()->wait_all_status(tasks);
+  auto statuses = storage_manager_->thread_pool()->wait_all_status(tasks);
   for (const auto& st : statuses)
     RETURN_CANCEL_OR_ERROR(st);
 
@@ -1866,13 +2623,32 @@ Status Reader::read_all_tiles(
   STATS_FUNC_OUT(reader_read_all_tiles);
 }
 
+Status Reader::read_check_coords_tiles(OverlappingTileVec* tiles) const {
+  if (tiles->empty())
+    return Status::Ok();
+
+  std::vector<std::future<Status>> tasks;
+  RETURN_CANCEL_OR_ERROR(read_tiles(constants::coords, tiles, &tasks, true));
+
+  // Wait for the reads to finish and check statuses.
+  auto statuses = storage_manager_->thread_pool()->wait_all_status(tasks);
+  for (const auto& st : statuses)
+    RETURN_CANCEL_OR_ERROR(st);
+
+  return Status::Ok();
+}
+
 Status Reader::read_tiles(
     const std::string& attribute,
     OverlappingTileVec* tiles,
-    std::vector<std::future<Status>>* tasks) const {
+    std::vector<std::future<Status>>* tasks,
+    bool check_coords_only) const {
   // For each tile, read from its fragment.
   bool var_size = array_schema_->var_size(attribute);
   auto num_tiles = static_cast<uint64_t>(tiles->size());
+  uint64_t num_touched = 0;
+  std::vector<unsigned> all_dims(array_schema_->dim_num());
+  std::iota(all_dims.begin(), all_dims.end(), 0);
 
   // Populate the list of regions per file to be read.
   std::map<URI, std::vector<std::tuple<uint64_t, void*, uint64_t>>> all_regions;
@@ -1884,11 +2660,29 @@ Status Reader::read_tiles(
           Status::ReaderError("Invalid tile map for attribute " + attribute));
     }
 
-    // Initialize the tile(s)
+    // The coordinates of the fragments with split coordinates are read
+    // per dimension.
+    auto& fragment = fragment_metadata_[tile->fragment_idx_];
+    if (attribute == constants::coords && fragment->split_coords()) {
+      RETURN_NOT_OK(read_coords_tiles(
+          tile.get(),
+          check_coords_only ? tile->check_dims_ : all_dims,
+          &all_regions));
+      num_touched += check_coords_only ? 0 : 1;
+      continue;
+    }
+
+    // Skip the tiles already read, and those whose cells all lie in the
+    // subarray when reading only the coordinates to check
     auto& tile_pair = it->second;
     auto& t = tile_pair.first;
     auto& t_var = tile_pair.second;
-    auto& fragment = fragment_metadata_[tile->fragment_idx_];
+    if (t.buffer() != nullptr ||
+        (check_coords_only && tile->check_dims_.empty()))
+      continue;
+    ++num_touched;
+
+    // Initialize the tile(s)
     auto format_version = fragment->format_version();
     if (!var_size) {
       RETURN_NOT_OK(init_tile(format_version, attribute, &t));
@@ -1967,7 +2761,7 @@ Status Reader::read_tiles(
     const auto& uri = item.first;
     const auto& regions = item.second;
     auto task =
-        storage_manager_->reader_thread_pool()->enqueue([uri, regions, this]() {
+        storage_manager_->thread_pool()->enqueue([uri, regions, this]() {
           RETURN_NOT_OK(storage_manager_->vfs()->read_all(uri, regions));
           return Status::Ok();
         });
@@ -1975,7 +2769,58 @@ Status Reader::read_tiles(
   }
 
   STATS_COUNTER_ADD(
-      reader_num_attr_tiles_touched, ((var_size ? 2 : 1) * num_tiles));
+      reader_num_attr_tiles_touched, ((var_size ? 2 : 1) * num_touched));
+
+  return Status::Ok();
+}
+
+Status Reader::read_coords_tiles(
+    OverlappingTile* tile,
+    const std::vector<unsigned>& dims,
+    std::map<URI, std::vector<std::tuple<uint64_t, void*, uint64_t>>>*
+        all_regions) const {
+  // For easy reference
+  auto coords_type = array_schema_->coords_type();
+  auto coord_size = datatype_size(coords_type);
+  auto tile_size = array_schema_->capacity() * coord_size;
+  auto buffer_pool = storage_manager_->buffer_pool();
+  auto& fragment = fragment_metadata_[tile->fragment_idx_];
+  auto format_version = fragment->format_version();
+
+  for (auto d : dims) {
+    auto dim_name = FragmentMetadata::coords_dim_name(d);
+    auto& t = tile->attr_tiles_[dim_name].first;
+    if (t.buffer() != nullptr)
+      continue;
+    RETURN_NOT_OK(t.init(
+        format_version, coords_type, tile_size, coord_size, 0, buffer_pool));
+
+    // Get information about the tile in its fragment
+    auto dim_uri = fragment->attr_uri(dim_name);
+    auto dim_offset = fragment->file_offset(dim_name, tile->tile_idx_);
+    auto dim_tile_size = fragment->tile_size(dim_name, tile->tile_idx_);
+    auto dim_persisted_size =
+        fragment->persisted_tile_size(dim_name, tile->tile_idx_);
+
+    // Try the cache first.
+    bool cache_hit;
+    RETURN_NOT_OK(storage_manager_->read_from_cache(
+        dim_uri, dim_offset, t.buffer(), dim_tile_size, &cache_hit));
+    if (cache_hit) {
+      t.set_filtered(true);
+      STATS_COUNTER_ADD(reader_attr_tile_cache_hits, 1);
+    } else {
+      // Add the region of the fragment to be read.
+      RETURN_NOT_OK(t.buffer()->realloc(dim_persisted_size));
+      t.buffer()->set_size(dim_persisted_size);
+      t.buffer()->reset_offset();
+      (*all_regions)[dim_uri].emplace_back(
+          dim_offset, t.buffer()->data(), dim_persisted_size);
+
+      STATS_COUNTER_ADD(reader_num_tile_bytes_read, dim_persisted_size);
+      STATS_COUNTER_ADD(reader_num_fixed_cell_bytes_read, dim_persisted_size);
+    }
+  }
 
   return Status::Ok();
 }
@@ -1992,15 +2837,16 @@ template <class T>
 Status Reader::sort_coords(OverlappingCoordsList<T>* coords) const {
   STATS_FUNC_IN(reader_sort_coords);
 
+  auto tp = storage_manager_->thread_pool();
   if (layout_ == Layout::GLOBAL_ORDER) {
     auto domain = array_schema_->domain();
-    parallel_sort(coords->begin(), coords->end(), GlobalCmp<T>(domain));
+    parallel_sort(tp, coords->begin(), coords->end(), GlobalCmp<T>(domain));
   } else {
     auto dim_num = array_schema_->dim_num();
     if (layout_ == Layout::ROW_MAJOR)
-      parallel_sort(coords->begin(), coords->end(), RowCmp<T>(dim_num));
+      parallel_sort(tp, coords->begin(), coords->end(), RowCmp<T>(dim_num));
     else if (layout_ == Layout::COL_MAJOR)
-      parallel_sort(coords->begin(), coords->end(), ColCmp<T>(dim_num));
+      parallel_sort(tp, coords->begin(), coords->end(), ColCmp<T>(dim_num));
   }
 
   return Status::Ok();
@@ -2043,43 +2889,60 @@ template <class T>
 Status Reader::sparse_read() {
   STATS_FUNC_IN(reader_sparse_read);
 
+  // Resume copying the results left over by the previous submission
+  if (!read_state_.result_cell_ranges_.empty())
+    return copy_result_cells();
+
   // Get overlapping tile indexes
   OverlappingTileVec tiles;
   RETURN_CANCEL_OR_ERROR(compute_overlapping_tiles<T>(&tiles));
 
-  // Read tiles
-  RETURN_CANCEL_OR_ERROR(read_all_tiles(&tiles));
-
-  // Filter tiles
-  RETURN_CANCEL_OR_ERROR(filter_all_tiles(&tiles));
+  // Compute the read coordinates for all fragments, reading only the
+  // coordinates checked against the subarray
+  RETURN_CANCEL_OR_ERROR(read_check_coords_tiles(&tiles));
+  OverlappingCoordsPositions positions;
+  RETURN_CANCEL_OR_ERROR(compute_overlapping_coords<T>(&tiles, &positions));
 
-  // Compute the read coordinates for all fragments
-  OverlappingCoordsList<T> coords;
-  RETURN_CANCEL_OR_ERROR(compute_overlapping_coords<T>(tiles, &coords));
+  // Read and filter the rest of the tiles with results. The coordinates are
+  // already in the global order for a single fragment, so they are needed
+  // for sorting and deduplicating only otherwise
+  bool sorted =
+      fragment_metadata_.size() == 1 && layout_ == Layout::GLOBAL_ORDER;
+  RETURN_CANCEL_OR_ERROR(read_all_tiles(&tiles, !sorted));
+  RETURN_CANCEL_OR_ERROR(filter_all_tiles(&tiles, !sorted));
 
-  // Compute the tile coordinates for all overlapping coordinates (for sorting).
-  std::unique_ptr<T[]> tile_coords(nullptr);
-  RETURN_CANCEL_OR_ERROR(compute_tile_coords<T>(&tile_coords, &coords));
-
-  // Sort and dedup the coordinates (not applicable to the global order
-  // layout for a single fragment)
-  if (!(fragment_metadata_.size() == 1 && layout_ == Layout::GLOBAL_ORDER)) {
+  // Compute the maximal cell ranges
+  OverlappingCellRangeList cell_ranges;
+  if (sorted) {
+    RETURN_CANCEL_OR_ERROR(compute_cell_ranges(positions, &cell_ranges));
+  } else {
+    std::vector<T> coords_buff;
+    OverlappingCoordsList<T> coords;
+    RETURN_CANCEL_OR_ERROR(
+        get_coords_list<T>(positions, &coords_buff, &coords));
+    positions = OverlappingCoordsPositions();
+
+    // Compute the tile coordinates for all overlapping coordinates (for
+    // sorting)
+    std::unique_ptr<T[]> tile_coords(nullptr);
+    RETURN_CANCEL_OR_ERROR(compute_tile_coords<T>(&tile_coords, &coords));
     RETURN_CANCEL_OR_ERROR(sort_coords<T>(&coords));
     RETURN_CANCEL_OR_ERROR(dedup_coords<T>(&coords));
+    tile_coords.reset(nullptr);
+
+    RETURN_CANCEL_OR_ERROR(compute_cell_ranges(coords, &cell_ranges));
   }
-  tile_coords.reset(nullptr);
 
-  // Compute the maximal cell ranges
-  OverlappingCellRangeList cell_ranges;
-  RETURN_CANCEL_OR_ERROR(compute_cell_ranges(coords, &cell_ranges));
-  coords.clear();
+  // Keep the tiles and cell ranges in the read state, so that the results
+  // that do not fit in the buffers are copied by the next submissions
+  clear_result_state();
+  read_state_.result_tiles_ = std::move(tiles);
+  read_state_.result_cell_ranges_ = std::move(cell_ranges);
+  for (const auto& cr : read_state_.result_cell_ranges_)
+    read_state_.result_cell_num_ += cr.end_ - cr.start_ + 1;
 
   // Copy cells
-  for (const auto& attr : attributes_) {
-    if (read_state_.overflowed_)
-      break;
-    RETURN_CANCEL_OR_ERROR(copy_cells(attr, cell_ranges));
-  }
+  RETURN_CANCEL_OR_ERROR(copy_result_cells());
 
   return Status::Ok();
 
@@ -43,7 +43,9 @@
 
 #include <future>
 #include <list>
+#include <map>
 #include <memory>
+#include <tuple>
 
 namespace tiledb {
 namespace sm {
@@ -51,6 +53,10 @@ namespace sm {
 class Array;
 class StorageManager;
 
+namespace microbench {
+class Access;
+}
+
 /** Processes read queries. */
 class Reader {
  public:
@@ -58,39 +64,15 @@ class Reader {
   /*          TYPE DEFINITIONS         */
   /* ********************************* */
 
-  /**
-   * For a read query, the user sets a subarray and buffers that will
-   * hold the results. For some subarray, the user buffers may not be
-   * able to hold the entire result. Given a subarray and the buffer sizes,
-   * TileDB knows how to decompose the subarray into partitions, such
-   * that the results of each partition can certainly fit in the user
-   * buffers. The user can perform successive calls to `submit` in order
-   * to incrementally perform each subarray partition. The query is
-   * "incomplete" until all partitions are processed.
-   *
-   * The read state maintains a vector with all the subarray partitions,
-   * along with an index `idx_` that indicates the parition to be processed
-   * next.
-   */
-  struct ReadState {
-    /** The current subarray the query is constrained on. */
-    void* cur_subarray_partition_;
-    /** The original subarray set by the user. */
+  /** A partition of the query subarray. */
+  struct SubarrayPartition {
+    /** The partition subarray. */
     void* subarray_;
     /**
-     * A list of subarray partitions. The head of the list is the partition
-     * to be split next.
+     * `true` if the estimated results of the partition fit in the user
+     * buffers, i.e., the partition does not need to be split further.
      */
-    std::list<void*> subarray_partitions_;
-    /** True if the reader has been initialized. */
-    bool initialized_;
-    /**
-     * `True` if the query produced results that could not fit in
-     * some buffer.
-     */
-    bool overflowed_;
-    /** True if the current subarray partition is unsplittable. */
-    bool unsplittable_;
+    bool fits_;
   };
 
   /**
@@ -108,6 +90,11 @@ class Reader {
     uint64_t tile_idx_;
     /** `true` if the overlap is full, and `false` if it is partial. */
     bool full_overlap_;
+    /**
+     * The dimensions on which the tile MBR does not lie within the subarray,
+     * i.e., the dimensions whose coordinates must be checked against it.
+     */
+    std::vector<unsigned> check_dims_;
     /**
      * Maps attribute names to attribute tiles. Note that the coordinates
      * are a special attribute as well.
@@ -141,9 +128,9 @@ class Reader {
      * an "empty" cell range, to be filled with the default empty
      * values.
      *
-     * Note that the tile this points to is allocated and freed in
-     * sparse_read/dense_read, so the lifetime of this struct must not exceed
-     * the scope of those functions.
+     * Note that the tile this points to is owned by the read state
+     * (`ReadState::result_tiles_`), which keeps it alive until all cells of
+     * the current subarray partition have been copied.
      */
     const OverlappingTile* tile_;
     /** The starting cell in the range. */
@@ -163,6 +150,81 @@ class Reader {
   /** A list of cell ranges. */
   typedef std::vector<OverlappingCellRange> OverlappingCellRangeList;
 
+  /**
+   * The positions of the coordinates that overlap a subarray, grouped by
+   * overlapping tile. The positions of tile `tiles_[i]` are stored in
+   * `pos_[offsets_[i]]` up to (excluding) `pos_[offsets_[i + 1]]`, in
+   * increasing order.
+   */
+  struct OverlappingCoordsPositions {
+    /** The overlapping tiles. */
+    std::vector<const OverlappingTile*> tiles_;
+    /**
+     * The offsets of the positions of each tile in `pos_`, with one extra
+     * offset at the end equal to the total number of positions.
+     */
+    std::vector<uint64_t> offsets_;
+    /** The positions of the overlapping coordinates in their tiles. */
+    std::vector<uint64_t> pos_;
+  };
+
+  /**
+   * For a read query, the user sets a subarray and buffers that will
+   * hold the results. For some subarray, the user buffers may not be
+   * able to hold the entire result. Given a subarray and the buffer sizes,
+   * TileDB knows how to decompose the subarray into partitions, such
+   * that the results of each partition can certainly fit in the user
+   * buffers. The user can perform successive calls to `submit` in order
+   * to incrementally perform each subarray partition. The query is
+   * "incomplete" until all partitions are processed.
+   *
+   * The read state maintains a list with the subarray partitions still to
+   * be processed. The results of the current partition are computed once;
+   * if they do not all fit in the user buffers, the read state keeps them
+   * and the next `submit` copies the remainder without reading, unfiltering
+   * or sorting again.
+   */
+  struct ReadState {
+    /** The current subarray the query is constrained on. */
+    void* cur_subarray_partition_;
+    /** The original subarray set by the user. */
+    void* subarray_;
+    /**
+     * A list of subarray partitions. The head of the list is the partition
+     * to be processed next.
+     */
+    std::list<SubarrayPartition> subarray_partitions_;
+    /**
+     * For each fragment, the ids of its sparse tiles whose MBR overlaps
+     * `subarray_`. It is computed once per query and used both to partition
+     * the subarray and to find the tiles overlapping each partition.
+     */
+    std::vector<std::vector<uint64_t>> overlapping_tile_ids_;
+    /** True if the reader has been initialized. */
+    bool initialized_;
+    /**
+     * `True` if the query produced results that could not fit in
+     * some buffer.
+     */
+    bool overflowed_;
+    /**
+     * The tiles the results of the current partition are copied from. They
+     * stay pinned across `submit` calls until all results of the partition
+     * have been copied to the user buffers.
+     */
+    OverlappingTileVec result_tiles_;
+    /** The result cell ranges of the current partition. */
+    OverlappingCellRangeList result_cell_ranges_;
+    /** The index of the first result cell range not fully copied yet. */
+    uint64_t result_range_idx_;
+    /** The number of cells of that range that have already been copied. */
+    uint64_t result_range_offset_;
+    /** The number of result cells of the current partition. */
+    uint64_t result_cell_num_;
+    /** The number of result cells of the current partition copied so far. */
+    uint64_t result_cells_copied_;
+  };
+
   /**
    * Records the overlapping tile and position of the coordinates
    * in that tile.
@@ -350,12 +412,12 @@ class Reader {
   Layout layout() const;
 
   /**
-   * Advances the read state to the next subarray partition. It splits the
-   * head of the subarray partition list (re-inserting at the front the
-   * potentially derived partitons) and copies the first partition that
-   * fits in the user buffers to `read_state_.cur_subarray_`. If there
-   * is no next subarray, `read_state_.cur_subarray_` is freed and
-   * set to `nullptr`.
+   * Advances the read state to the next subarray partition. It partitions
+   * the head of the subarray partition list (re-inserting at the front the
+   * derived partitons, see `compute_subarray_partitions`) and copies the
+   * first partition that fits in the user buffers to
+   * `read_state_.cur_subarray_`. If there is no next subarray,
+   * `read_state_.cur_subarray_` is freed and set to `nullptr`.
    */
   Status next_subarray_partition();
 
@@ -459,6 +521,9 @@ class Reader {
   void* subarray() const;
 
  private:
+  /** Gives the micro-benchmarks access to the internal kernels they time. */
+  friend class microbench::Access;
+
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
   /* ********************************* */
@@ -488,6 +553,18 @@ class Reader {
   /** To handle incomplete read queries. */
   ReadState read_state_;
 
+  /**
+   * The fraction of the user buffers that each subarray partition aims to
+   * fill (see `sm.read_partition_utilization`).
+   */
+  float partition_utilization_;
+
+  /**
+   * Whether the checksum filters verify the tiles read from disk (see
+   * `sm.verify_checksums`).
+   */
+  bool verify_checksums_;
+
   /**
    * If `true`, then the dense array will be read in "sparse mode", i.e.,
    * the sparse read algorithm will be executing, returning results only
@@ -505,6 +582,12 @@ class Reader {
   /** Clears the read state. */
   void clear_read_state();
 
+  /**
+   * Releases the result tiles and cell ranges of the current subarray
+   * partition kept in the read state.
+   */
+  void clear_result_state();
+
   /**
    * Compute the maximal cell ranges of contiguous cell positions.
    *
@@ -518,6 +601,19 @@ class Reader {
       const OverlappingCoordsList<T>& coords,
       OverlappingCellRangeList* cell_ranges) const;
 
+  /**
+   * Compute the maximal cell ranges of contiguous cell positions, directly
+   * from the overlapping coordinate positions (i.e., when the coordinates
+   * need not be sorted).
+   *
+   * @param positions The coordinate positions to compute the ranges from.
+   * @param cell_ranges The cell ranges to compute.
+   * @return Status
+   */
+  Status compute_cell_ranges(
+      const OverlappingCoordsPositions& positions,
+      OverlappingCellRangeList* cell_ranges) const;
+
   /**
    * For the given cell range, it computes all the result dense cell ranges
    * across fragments, given precedence to more recent fragments.
@@ -562,33 +658,99 @@ class Reader {
       OverlappingCellRangeList* overlapping_cell_ranges);
 
   /**
-   * Computes the overlapping coordinates for a given subarray.
+   * Computes the positions of the coordinates that overlap the current
+   * subarray partition. The tiles are processed in parallel. The tiles
+   * without any coordinates in the subarray are removed from `tiles`, so
+   * that none of their other tiles are read.
    *
    * @tparam T The coords type.
-   * @param tiles The tiles to get the overlapping coordinates from.
-   * @param coords The coordinates to be retrieved.
+   * @param tiles The tiles to get the overlapping coordinates from. Their
+   *     coordinate tiles of the dimensions in `check_dims_` must have been
+   *     read (see `read_check_coords_tiles`).
+   * @param positions The coordinate positions to be retrieved.
    * @return Status
    */
   template <class T>
   Status compute_overlapping_coords(
-      const OverlappingTileVec& tiles, OverlappingCoordsList<T>* coords) const;
+      OverlappingTileVec* tiles, OverlappingCoordsPositions* positions) const;
 
   /**
-   * Retrieves the coordinates that overlap the subarray from the input
-   * overlapping tile.
+   * Retrieves the positions of the coordinates of the input tile that
+   * overlap the current subarray partition. The check runs one dimension
+   * of `check_dims_` at a time, producing a selection bitmap (see
+   * `range_select.h`), and checks each next dimension only for the words
+   * of the bitmap that still have cells in the subarray. The coordinates
+   * of a dimension are unfiltered right before they are checked, so the
+   * dimensions after the one emptying the bitmap are never unfiltered.
    *
    * @tparam T The coords type.
-   * @param The overlapping tile.
-   * @param coords The overlapping coordinates to retrieve.
+   * @param tile The overlapping tile.
+   * @param pos The overlapping coordinate positions to retrieve, in
+   *     increasing order.
    * @return Status
    */
   template <class T>
   Status compute_overlapping_coords(
-      const OverlappingTile* tile, OverlappingCoordsList<T>* coords) const;
+      OverlappingTile* tile, std::vector<uint64_t>* pos) const;
+
+  /**
+   * Computes the ids of the sparse tiles of each fragment that overlap the
+   * query subarray, storing them in `read_state_.overlapping_tile_ids_`.
+   *
+   * @tparam T The coords type.
+   * @return Status
+   */
+  template <class T>
+  Status compute_overlapping_tile_ids();
+
+  /**
+   * Partitions `subarray` into consecutive partitions whose estimated results
+   * fill the user buffers up to `sm.read_partition_utilization`. It builds
+   * a histogram of the estimated result sizes along the dimension the
+   * subarray would be split on (in one pass over the overlapping tiles of
+   * all fragments) and cuts it greedily. Buckets that do not fit on their
+   * own are returned as partitions with `fits_ == false`, to be partitioned
+   * further. Regions with no estimated results are skipped.
+   *
+   * @param subarray The subarray to partition.
+   * @param partitions The computed partitions, in the order they must be
+   *     read. The caller takes ownership of their subarrays.
+   * @param unsplittable Set to `true` if `subarray` cannot be split and its
+   *     estimated results do not fit in the user buffers.
+   * @return Status
+   */
+  Status compute_subarray_partitions(
+      const void* subarray,
+      std::list<SubarrayPartition>* partitions,
+      bool* unsplittable);
+
+  /** Same as the non-templated version, for the given coords type. */
+  template <class T>
+  Status compute_subarray_partitions(
+      const T* subarray,
+      std::list<SubarrayPartition>* partitions,
+      bool* unsplittable);
+
+  /**
+   * Computes the dimension along which `subarray` should be partitioned so
+   * that the partitions are read in the query layout, along with the
+   * bucket bounds on that dimension for the partitioning histogram. For the
+   * global order, the buckets are aligned to the space tiles.
+   *
+   * @tparam T The coords type.
+   * @param subarray The subarray to partition.
+   * @param dim The dimension to partition along.
+   * @param bucket_bounds The bucket bounds (low, high) on `dim`. A single
+   *     bucket is returned if `subarray` cannot be split.
+   */
+  template <class T>
+  void compute_subarray_partition_buckets(
+      const T* subarray, unsigned* dim, std::vector<T>* bucket_bounds) const;
 
   /**
    * Computes info about the overlapping tiles, such as which fragment they
-   * belong to, the tile index and the type of overlap.
+   * belong to, the tile index, the type of overlap and the dimensions whose
+   * coordinates must be checked against the subarray.
    *
    * @tparam T The coords type.
    * @param tiles The tiles to be computed.
@@ -612,6 +774,27 @@ class Reader {
       std::unique_ptr<T[]>* all_tile_coords,
       OverlappingCoordsList<T>* coords) const;
 
+  /**
+   * Computes the number of the remaining result cells of the current
+   * partition (starting at the read state cursor) that fit in the user
+   * buffers of all attributes.
+   *
+   * @param cell_num The number of cells that fit.
+   * @return Status
+   */
+  Status compute_result_cell_num(uint64_t* cell_num) const;
+
+  /**
+   * Copies as many of the remaining result cells of the current partition
+   * as fit in the user buffers, and advances the read state cursor.
+   * If some results remain, `read_state_.overflowed_` is set and the
+   * results are kept in the read state for the next submission; otherwise
+   * the result state is cleared.
+   *
+   * @return Status
+   */
+  Status copy_result_cells();
+
   /**
    * Copies the cells for the input attribute and cell ranges, into
    * the corresponding result buffers.
@@ -689,7 +872,9 @@ class Reader {
   Status dense_read();
 
   /**
-   * Performs a read on a dense array.
+   * Performs a read on a dense array. If results of the current subarray
+   * partition are left over from a previous submission, it only copies
+   * those.
    *
    * @tparam The domain type.
    * @return Status
@@ -697,16 +882,31 @@ class Reader {
   template <class T>
   Status dense_read();
 
+  /**
+   * Fills the coordinate buffer with coordinates. Applicable only to dense
+   * arrays when the user explicitly requests the coordinates to be
+   * materialized.
+   *
+   * @param skip The number of cells of the current partition (in the query
+   *     layout) to skip.
+   * @param num The number of cells to fill coordinates for.
+   * @return Status
+   */
+  Status fill_coords(uint64_t skip, uint64_t num);
+
   /**
    * Fills the coordinate buffer with coordinates. Applicable only to dense
    * arrays when the user explicitly requests the coordinates to be
    * materialized.
    *
    * @tparam T The domain type.
+   * @param skip The number of cells of the current partition (in the query
+   *     layout) to skip.
+   * @param num The number of cells to fill coordinates for.
    * @return Status
    */
   template <class T>
-  Status fill_coords();
+  Status fill_coords(uint64_t skip, uint64_t num);
 
   /**
    * Fills coordinates in the input buffer for a particular cell slab, following
@@ -766,29 +966,49 @@ class Reader {
       const std::string& attribute, OverlappingTileVec* tiles) const;
 
   /**
-   * Runs the input tile for the input attribute through the filter pipeline.
+   * Filters the coordinates tile of the input tile, if not filtered yet.
+   * For fragments with split coordinates, it filters the tile of the
+   * input dimension instead.
+   *
+   * @param tile The overlapping tile whose coordinates will be filtered.
+   * @param dim The dimension index (applicable to split coordinates only).
+   * @return Status
+   */
+  Status filter_coords_tile(OverlappingTile* tile, unsigned dim) const;
+
+  /**
+   * Runs the input tile through the input filter pipeline (in reverse).
    * The tile buffer is modified to contain the output of the pipeline.
    *
-   * @param attribute The attribute the tile belong to.
+   * @param filters The filter pipeline the tile was filtered with.
+   * @param zstd_dictionary The dictionary of the zstd compression filters of
+   *     the pipeline (may be `nullptr`).
    * @param tile The tile to be filtered.
-   * @param offsets True if the tile to be filtered contains offsets for a
-   *    var-sized attribute.
    * @return Status
    */
   Status filter_tile(
-      const std::string& attribute, Tile* tile, bool offsets) const;
+      const FilterPipeline* filters,
+      const std::shared_ptr<ZStdDictionary>& zstd_dictionary,
+      Tile* tile) const;
 
   /**
-   * Gets all the coordinates of the input tile into `coords`.
+   * Builds the list of overlapping coordinates (used for sorting and
+   * deduplicating them) from their positions. The coordinates of the
+   * fragments with split coordinates are gathered into `coords_buff`, one
+   * tuple per overlapping cell; the rest point into the coordinate tiles.
    *
    * @tparam T The coords type.
-   * @param tile The overlapping tile to read the coordinates from.
-   * @param coords The overlapping coordinates to copy into.
+   * @param positions The overlapping coordinate positions.
+   * @param coords_buff The buffer holding the gathered coordinates. It must
+   *     outlive `coords`.
+   * @param coords The overlapping coordinates to build.
    * @return Status
    */
   template <class T>
-  Status get_all_coords(
-      const OverlappingTile* tile, OverlappingCoordsList<T>* coords) const;
+  Status get_coords_list(
+      const OverlappingCoordsPositions& positions,
+      std::vector<T>* coords_buff,
+      OverlappingCoordsList<T>* coords) const;
 
   /**
    * Handles the coordinates that fall between `start` and `end`.
@@ -884,7 +1104,7 @@ class Reader {
 
   /**
    * Retrieves the tiles on all attributes from all input fragments based on
-   * the tile info in `tiles`.
+   * the tile info in `tiles`. The tiles already retrieved are skipped.
    *
    * @param tiles The retrieved tiles will be stored in `tiles`.
    * @param ensure_coords If true (the default), always read the coordinate
@@ -894,6 +1114,17 @@ class Reader {
   Status read_all_tiles(
       OverlappingTileVec* tiles, bool ensure_coords = true) const;
 
+  /**
+   * Retrieves the coordinate tiles needed to check which cells of the input
+   * tiles fall in the subarray, i.e., the tiles of the dimensions in
+   * `check_dims_` for the fragments with split coordinates, and the
+   * coordinates tile for the rest (unless `check_dims_` is empty).
+   *
+   * @param tiles The retrieved tiles will be stored in `tiles`.
+   * @return Status
+   */
+  Status read_check_coords_tiles(OverlappingTileVec* tiles) const;
+
   /**
    * Retrieves the tiles on a particular attribute from all input fragments
    * based on the tile info in `tiles`.
@@ -904,12 +1135,33 @@ class Reader {
    * @param attribute The attribute name.
    * @param tiles The retrieved tiles will be stored in `tiles`.
    * @param tasks Vector to hold futures for the read tasks.
+   * @param check_coords_only If true, only the coordinate tiles needed to
+   *     check which cells fall in the subarray are read (applicable to the
+   *     coordinates only).
    * @return Status
    */
   Status read_tiles(
       const std::string& attribute,
       OverlappingTileVec* tiles,
-      std::vector<std::future<Status>>* tasks) const;
+      std::vector<std::future<Status>>* tasks,
+      bool check_coords_only = false) const;
+
+  /**
+   * Initializes the input dimension tiles of the input tile of a fragment
+   * with split coordinates, and retrieves them from the cache or adds their
+   * regions to the regions to be read. The dimension tiles already
+   * initialized are skipped.
+   *
+   * @param tile The overlapping tile whose coordinates will be read.
+   * @param dims The indices of the dimensions to read.
+   * @param all_regions The regions to be read per file.
+   * @return Status
+   */
+  Status read_coords_tiles(
+      OverlappingTile* tile,
+      const std::vector<unsigned>& dims,
+      std::map<URI, std::vector<std::tuple<uint64_t, void*, uint64_t>>>*
+          all_regions) const;
 
   /**
    * Resets the buffer sizes to the original buffer sizes. This is because
@@ -932,7 +1184,9 @@ class Reader {
   Status sparse_read();
 
   /**
-   * Performs a read on a sparse array.
+   * Performs a read on a sparse array. If results of the current subarray
+   * partition are left over from a previous submission, it only copies
+   * those.
    *
    * @tparam The domain type.
    * @return Status
@@ -32,6 +32,7 @@
 
 #include "tiledb/sm/query/writer.h"
 #include "tiledb/sm/misc/comparators.h"
+#include "tiledb/sm/misc/gather.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/stats.h"
@@ -41,6 +42,7 @@
 #include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/tile/tile_io.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -54,11 +56,13 @@ namespace sm {
 Writer::Writer() {
   array_ = nullptr;
   array_schema_ = nullptr;
+  coalesce_writes_ = true;
   global_write_state_.reset(nullptr);
   initialized_ = false;
   layout_ = Layout::ROW_MAJOR;
   storage_manager_ = nullptr;
   subarray_ = nullptr;
+  zstd_dictionary_size_ = 0;
 }
 
 Writer::~Writer() {
@@ -151,17 +155,20 @@ Status Writer::init() {
 
   // Get configuration parameters
   const char *check_coord_dups, *check_coord_oob, *check_global_order;
-  const char* dedup_coords;
+  const char *dedup_coords, *zstd_dictionary_size;
   auto config = storage_manager_->config();
   RETURN_NOT_OK(config.get("sm.check_coord_dups", &check_coord_dups));
   RETURN_NOT_OK(config.get("sm.check_coord_oob", &check_coord_oob));
   RETURN_NOT_OK(config.get("sm.check_global_order", &check_global_order));
   RETURN_NOT_OK(config.get("sm.dedup_coords", &dedup_coords));
+  RETURN_NOT_OK(config.get("sm.zstd_dictionary_size", &zstd_dictionary_size));
   assert(check_coord_dups != nullptr && dedup_coords != nullptr);
   check_coord_dups_ = !strcmp(check_coord_dups, "true");
   check_coord_oob_ = !strcmp(check_coord_oob, "true");
   check_global_order_ = !strcmp(check_global_order, "true");
   dedup_coords_ = !strcmp(dedup_coords, "true");
+  RETURN_NOT_OK(
+      utils::parse::convert(zstd_dictionary_size, &zstd_dictionary_size_));
   initialized_ = true;
 
   return Status::Ok();
@@ -274,6 +281,10 @@ Status Writer::set_buffer(
   return Status::Ok();
 }
 
+void Writer::set_coalesce_writes(bool coalesce_writes) {
+  coalesce_writes_ = coalesce_writes;
+}
+
 void Writer::set_fragment_uri(const URI& fragment_uri) {
   fragment_uri_ = fragment_uri;
 }
@@ -336,6 +347,23 @@ Status Writer::write() {
   if (check_coord_oob_)
     RETURN_NOT_OK(check_coord_oob());
 
+  // Buffer unordered writes if write coalescing is enabled. The buffered
+  // writes of the array are flushed before any other write to it, so that
+  // the fragments keep the order of the writes.
+  auto write_coalescer = storage_manager_->write_coalescer();
+  if (coalesce_writes_ && write_coalescer->enabled()) {
+    if (layout_ == Layout::UNORDERED && !array_schema_->is_kv() &&
+        fragment_uri_.to_string().empty()) {
+      // Duplicates within this write are checked now, as they would be if
+      // it were not buffered. The coalescer collapses only the duplicates
+      // across separate writes.
+      if (check_coord_dups_ && !dedup_coords_)
+        RETURN_NOT_OK(check_coord_dups_unordered());
+      return write_coalescer->append(array_, attr_buffers_);
+    }
+    RETURN_NOT_OK(write_coalescer->flush(array_schema_->array_uri()));
+  }
+
   if (layout_ == Layout::COL_MAJOR || layout_ == Layout::ROW_MAJOR) {
     RETURN_NOT_OK(ordered_write());
   } else if (layout_ == Layout::UNORDERED) {
@@ -442,6 +470,47 @@ Status Writer::check_coord_dups(const std::vector<uint64_t>& cell_pos) const {
   STATS_FUNC_OUT(writer_check_coord_dups);
 }
 
+Status Writer::check_coord_dups_unordered() const {
+  switch (array_schema_->coords_type()) {
+    case Datatype::INT8:
+      return check_coord_dups_unordered<int8_t>();
+    case Datatype::UINT8:
+      return check_coord_dups_unordered<uint8_t>();
+    case Datatype::INT16:
+      return check_coord_dups_unordered<int16_t>();
+    case Datatype::UINT16:
+      return check_coord_dups_unordered<uint16_t>();
+    case Datatype::INT32:
+      return check_coord_dups_unordered<int>();
+    case Datatype::UINT32:
+      return check_coord_dups_unordered<unsigned>();
+    case Datatype::INT64:
+      return check_coord_dups_unordered<int64_t>();
+    case Datatype::UINT64:
+      return check_coord_dups_unordered<uint64_t>();
+    case Datatype::FLOAT32:
+      return check_coord_dups_unordered<float>();
+    case Datatype::FLOAT64:
+      return check_coord_dups_unordered<double>();
+    default:
+      return LOG_STATUS(
+          Status::WriterError("Cannot check for coordinate duplicates; "
+                              "Unsupported domain type"));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Writer::check_coord_dups_unordered() const {
+  if (attr_buffers_.find(constants::coords) == attr_buffers_.end())
+    return Status::Ok();
+
+  std::vector<uint64_t> cell_pos;
+  RETURN_NOT_OK(sort_coords<T>(&cell_pos));
+  return check_coord_dups(cell_pos);
+}
+
 Status Writer::check_coord_dups() const {
   STATS_FUNC_IN(writer_check_coord_dups_global);
 
@@ -527,7 +596,8 @@ Status Writer::check_coord_oob() const {
   auto domain = (T*)array_schema_->domain()->domain();
 
   // Check if all coordinates fall in the domain in parallel
-  auto statuses = parallel_for(0, coords_num, [&](uint64_t i) {
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, coords_num, [&](uint64_t i) {
     if (!utils::geometry::coords_in_rect<T>(
             &coords_buff[i * dim_num], domain, dim_num)) {
       std::stringstream ss;
@@ -610,7 +680,8 @@ Status Writer::check_global_order() const {
   auto domain = array_schema_->domain();
 
   // Check if all coordinates fall in the domain in parallel
-  auto statuses = parallel_for(0, coords_num - 1, [&](uint64_t i) {
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, coords_num - 1, [&](uint64_t i) {
     auto tile_cmp = domain->tile_order_cmp<T>(
         &coords_buff[i * dim_num], &coords_buff[(i + 1) * dim_num]);
     auto fail = (tile_cmp > 0) ||
@@ -716,6 +787,15 @@ Status Writer::check_subarray() const {
 
 Status Writer::close_files(FragmentMetadata* meta) const {
   for (const auto& attr : attributes_) {
+    // The coordinates are written to a file per dimension
+    if (attr == constants::coords) {
+      auto dim_num = array_schema_->dim_num();
+      for (unsigned d = 0; d < dim_num; ++d)
+        RETURN_NOT_OK(storage_manager_->close_file(
+            meta->attr_uri(FragmentMetadata::coords_dim_name(d))));
+      continue;
+    }
+
     RETURN_NOT_OK(storage_manager_->close_file(meta->attr_uri(attr)));
     if (array_schema_->var_size(attr))
       RETURN_NOT_OK(storage_manager_->close_file(meta->attr_var_uri(attr)));
@@ -919,44 +999,74 @@ Status Writer::create_fragment(
 }
 
 Status Writer::filter_tiles(
-    const std::string& attribute, std::vector<Tile>* tiles) const {
+    const std::string& attribute,
+    FragmentMetadata* frag_meta,
+    std::vector<Tile>* tiles) const {
   STATS_FUNC_IN(writer_filter_tiles);
 
   bool var_size = array_schema_->var_size(attribute);
-  // Filter all tiles
-  auto tile_num = tiles->size();
-  for (size_t i = 0; i < tile_num; ++i) {
-    RETURN_NOT_OK(filter_tile(attribute, &(*tiles)[i], var_size));
-    if (var_size) {
-      ++i;
-      RETURN_NOT_OK(filter_tile(attribute, &(*tiles)[i], false));
+  bool coords = (attribute == constants::coords);
+  auto dim_num = array_schema_->dim_num();
+
+  // Store the coordinates of each dimension in separate tiles
+  if (coords)
+    RETURN_NOT_OK(split_coords_tiles(tiles));
+
+  // Get the zstd dictionary of the attribute values, training it on the
+  // first tiles written to the fragment
+  std::shared_ptr<ZStdDictionary> dict;
+  if (!coords) {
+    dict = frag_meta->zstd_dictionary(attribute);
+    if (dict == nullptr) {
+      RETURN_NOT_OK(train_zstd_dictionary(attribute, *tiles, &dict));
+      if (dict != nullptr)
+        frag_meta->set_zstd_dictionary(attribute, dict);
     }
   }
 
+  // Filter all tiles in parallel. For var-sized attributes, the tiles
+  // alternate between offsets and values tiles, whereas for the coordinates
+  // they cycle through the dimensions.
+  auto tile_num = tiles->size();
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, tile_num, [&](uint64_t i) {
+    if (coords) {
+      RETURN_NOT_OK(filter_tile(
+          array_schema_->coords_filters(i % dim_num), nullptr, &(*tiles)[i]));
+    } else if (var_size && (i % 2 == 0)) {
+      RETURN_NOT_OK(filter_tile(
+          array_schema_->cell_var_offsets_filters(), nullptr, &(*tiles)[i]));
+    } else {
+      RETURN_NOT_OK(
+          filter_tile(array_schema_->filters(attribute), dict, &(*tiles)[i]));
+    }
+    return Status::Ok();
+  });
+
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
   return Status::Ok();
 
   STATS_FUNC_OUT(writer_filter_tiles);
 }
 
 Status Writer::filter_tile(
-    const std::string& attribute, Tile* tile, bool offsets) const {
+    const FilterPipeline* filters,
+    const std::shared_ptr<ZStdDictionary>& zstd_dictionary,
+    Tile* tile) const {
   auto orig_size = tile->buffer()->size();
 
-  // Get a copy of the appropriate filter pipeline.
-  FilterPipeline filters;
-  if (tile->stores_coords()) {
-    filters = *array_schema_->coords_filters();
-  } else if (offsets) {
-    filters = *array_schema_->cell_var_offsets_filters();
-  } else {
-    filters = *array_schema_->filters(attribute);
-  }
-
-  // Append an encryption filter when necessary.
+  // Get a copy of the filter pipeline and append an encryption filter when
+  // necessary.
+  FilterPipeline pipeline = *filters;
+  if (zstd_dictionary != nullptr)
+    pipeline.set_zstd_dictionary(zstd_dictionary);
   RETURN_NOT_OK(FilterPipeline::append_encryption_filter(
-      &filters, array_->get_encryption_key()));
+      &pipeline, array_->get_encryption_key()));
 
-  RETURN_NOT_OK(filters.run_forward(tile));
+  RETURN_NOT_OK(
+      pipeline.run_forward(tile, storage_manager_->thread_pool()));
 
   tile->set_filtered(true);
   tile->set_pre_filtered_size(orig_size);
@@ -1121,7 +1231,8 @@ Status Writer::global_write() {
 
   // Prepare tiles for all attributes
   std::vector<std::vector<Tile>> attribute_tiles(num_attributes);
-  auto statuses = parallel_for(0, num_attributes, [&](uint64_t i) {
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, num_attributes, [&](uint64_t i) {
     const auto& attr = attributes_[i];
     auto& full_tiles = attribute_tiles[i];
     RETURN_CANCEL_OR_ERROR(prepare_full_tiles(attr, coord_dups, &full_tiles));
@@ -1146,12 +1257,12 @@ Status Writer::global_write() {
   frag_meta->set_num_tiles(new_num_tiles);
 
   // Filter all tiles
-  statuses = parallel_for(0, num_attributes, [&](uint64_t i) {
+  statuses = parallel_for(tp, 0, num_attributes, [&](uint64_t i) {
     const auto& attr = attributes_[i];
     auto& full_tiles = attribute_tiles[i];
     if (attr == constants::coords)
       RETURN_CANCEL_OR_ERROR(compute_coords_metadata<T>(full_tiles, frag_meta));
-    RETURN_CANCEL_OR_ERROR(filter_tiles(attr, &full_tiles));
+    RETURN_CANCEL_OR_ERROR(filter_tiles(attr, frag_meta, &full_tiles));
     return Status::Ok();
   });
 
@@ -1202,7 +1313,8 @@ Status Writer::global_write_handle_last_tile() {
   // Filter the last tiles
   uint64_t num_attributes = attributes_.size();
   std::vector<std::vector<Tile>> attribute_tiles(num_attributes);
-  auto statuses = parallel_for(0, num_attributes, [&](uint64_t i) {
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, num_attributes, [&](uint64_t i) {
     const auto& attr = attributes_[i];
     auto& last_tile = global_write_state_->last_tiles_[attr].first;
     auto& last_tile_var = global_write_state_->last_tiles_[attr].second;
@@ -1216,7 +1328,7 @@ Status Writer::global_write_handle_last_tile() {
         tiles.push_back(last_tile_var.clone(false));
       if (attr == constants::coords)
         RETURN_NOT_OK(compute_coords_metadata<T>(tiles, meta));
-      RETURN_NOT_OK(filter_tiles(attr, &tiles));
+      RETURN_NOT_OK(filter_tiles(attr, meta, &tiles));
     }
     return Status::Ok();
   });
@@ -1298,10 +1410,16 @@ Status Writer::init_tile(const std::string& attribute, Tile* tile) const {
   auto cell_num_per_tile =
       (has_coords()) ? capacity : domain->cell_num_per_tile();
   auto tile_size = cell_num_per_tile * cell_size;
+  auto buffer_pool = storage_manager_->buffer_pool();
 
   // Initialize
   RETURN_NOT_OK(tile->init(
-      constants::format_version, type, tile_size, cell_size, dim_num));
+      constants::format_version,
+      type,
+      tile_size,
+      cell_size,
+      dim_num,
+      buffer_pool));
 
   return Status::Ok();
 }
@@ -1315,6 +1433,7 @@ Status Writer::init_tile(
   auto cell_num_per_tile =
       (has_coords()) ? capacity : domain->cell_num_per_tile();
   auto tile_size = cell_num_per_tile * constants::cell_var_offset_size;
+  auto buffer_pool = storage_manager_->buffer_pool();
 
   // Initialize
   RETURN_NOT_OK(tile->init(
@@ -1322,9 +1441,15 @@ Status Writer::init_tile(
       constants::cell_var_offset_type,
       tile_size,
       constants::cell_var_offset_size,
-      0));
+      0,
+      buffer_pool));
   RETURN_NOT_OK(tile_var->init(
-      constants::format_version, type, tile_size, datatype_size(type), 0));
+      constants::format_version,
+      type,
+      tile_size,
+      datatype_size(type),
+      0,
+      buffer_pool));
   return Status::Ok();
 }
 
@@ -1404,7 +1529,12 @@ Status Writer::new_fragment_name(
     std::string* frag_uri, uint64_t* timestamp) const {
   if (frag_uri == nullptr)
     return Status::WriterError("Null fragment uri argument.");
-  *timestamp = utils::time::timestamp_now_ms();
+
+  // Fragments are ordered by their timestamps, and fragments with equal
+  // timestamps by their URIs, i.e., arbitrarily. Give each fragment a
+  // distinct timestamp so that their order is the order of creation
+  *timestamp = utils::time::timestamp_next_ms();
+
   std::string uuid;
   frag_uri->clear();
   RETURN_NOT_OK(uuid::generate_uuid(&uuid, false));
@@ -1494,11 +1624,12 @@ Status Writer::ordered_write() {
   // Prepare tiles for all attributes and filter
   uint64_t num_attributes = attributes_.size();
   std::vector<std::vector<Tile>> attr_tiles(num_attributes);
-  auto statuses = parallel_for(0, num_attributes, [&](uint64_t i) {
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, num_attributes, [&](uint64_t i) {
     const auto& attr = attributes_[i];
     std::vector<Tile>& tiles = attr_tiles[i];
     RETURN_CANCEL_OR_ERROR(prepare_tiles(attr, write_cell_ranges, &tiles));
-    RETURN_CANCEL_OR_ERROR(filter_tiles(attr, &tiles));
+    RETURN_CANCEL_OR_ERROR(filter_tiles(attr, frag_meta.get(), &tiles));
     return Status::Ok();
   });
 
@@ -1589,17 +1720,21 @@ Status Writer::prepare_full_tiles_fixed(
       assert(last_tile.empty());
     }
 
-    // Write all remaining cells one by one
+    // Write all remaining cells. Without duplicates, each tile is a
+    // single copy and the tiles are filled in parallel.
     if (coord_dups.empty()) {
-      for (uint64_t tile_idx = 0, i = 0; i < cell_num_to_write;) {
-        if ((*tiles)[tile_idx].full())
-          ++tile_idx;
-
-        RETURN_NOT_OK((*tiles)[tile_idx].write(
-            buffer + cell_idx * cell_size, cell_size * cell_num_per_tile));
-        cell_idx += cell_num_per_tile;
-        i += cell_num_per_tile;
-      }
+      auto first_tile = (uint64_t)(*tiles)[0].full();
+      auto tp = storage_manager_->thread_pool();
+      auto statuses = parallel_for(
+          tp, 0, cell_num_to_write / cell_num_per_tile, [&](uint64_t i) {
+            auto start = cell_idx + i * cell_num_per_tile;
+            RETURN_NOT_OK((*tiles)[first_tile + i].write(
+                buffer + start * cell_size, cell_size * cell_num_per_tile));
+            return Status::Ok();
+          });
+      for (auto& st : statuses)
+        RETURN_NOT_OK(st);
+      cell_idx += cell_num_to_write;
     } else {
       for (uint64_t tile_idx = 0, i = 0; i < cell_num_to_write;
            ++cell_idx, ++i) {
@@ -1722,24 +1857,31 @@ Status Writer::prepare_full_tiles_var(
       assert(last_tile_var.empty());
     }
 
-    // Write all remaining cells one by one
+    // Write all remaining cells. Without duplicates, the values of each
+    // tile are a single copy, its offsets are the user offsets rebased to
+    // the first cell, and the tiles are filled in parallel.
     if (coord_dups.empty()) {
-      for (uint64_t tile_idx = 0, i = 0; i < cell_num_to_write;
-           ++cell_idx, ++i) {
-        if ((*tiles)[tile_idx].full())
-          tile_idx += 2;
-
-        // Write offset
-        offset = (*tiles)[tile_idx + 1].size();
-        RETURN_NOT_OK((*tiles)[tile_idx].write(&offset, sizeof(offset)));
-
-        // Write var-sized value
-        var_size = (cell_idx == cell_num - 1) ?
-                       *buffer_var_size - buffer[cell_idx] :
-                       buffer[cell_idx + 1] - buffer[cell_idx];
-        RETURN_NOT_OK((*tiles)[tile_idx + 1].write(
-            &buffer_var[buffer[cell_idx]], var_size));
-      }
+      auto first_tile = (uint64_t)(*tiles)[0].full();
+      auto tp = storage_manager_->thread_pool();
+      auto statuses = parallel_for(
+          tp, 0, cell_num_to_write / cell_num_per_tile, [&](uint64_t i) {
+            auto& tile = (*tiles)[2 * (first_tile + i)];
+            auto& tile_var = (*tiles)[2 * (first_tile + i) + 1];
+            auto start = cell_idx + i * cell_num_per_tile;
+            auto end = start + cell_num_per_tile;
+            auto var_start = buffer[start];
+            auto var_end = (end == cell_num) ? *buffer_var_size : buffer[end];
+            for (auto c = start; c < end; ++c) {
+              uint64_t tile_offset = buffer[c] - var_start;
+              RETURN_NOT_OK(tile.write(&tile_offset, sizeof(tile_offset)));
+            }
+            RETURN_NOT_OK(
+                tile_var.write(&buffer_var[var_start], var_end - var_start));
+            return Status::Ok();
+          });
+      for (auto& st : statuses)
+        RETURN_NOT_OK(st);
+      cell_idx += cell_num_to_write;
     } else {
       for (uint64_t tile_idx = 0, i = 0; i < cell_num_to_write;
            ++cell_idx, ++i) {
@@ -1821,16 +1963,20 @@ Status Writer::prepare_tiles(
   auto buffer_var_size = it->second.buffer_var_size_;
   auto cell_val_num = array_schema_->cell_val_num(attribute);
 
-  // Initialize tiles and buffer
+  // Initialize tiles
   RETURN_NOT_OK(init_tiles(attribute, tile_num, tiles));
-  auto buff = std::make_shared<ConstBuffer>(buffer, *buffer_size);
-  auto buff_var =
-      (!var_size) ? nullptr :
-                    std::make_shared<ConstBuffer>(buffer_var, *buffer_var_size);
 
-  // Populate each tile with the write cell ranges
+  // Populate the tiles with the write cell ranges in parallel. Each task
+  // reads the user buffers through its own buffer objects, since these
+  // keep a read offset.
   uint64_t end_pos = array_schema_->domain()->cell_num_per_tile() - 1;
-  for (size_t i = 0, t = 0; i < tile_num; ++i, t += (var_size) ? 2 : 1) {
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, tile_num, [&](uint64_t i) {
+    auto t = (var_size) ? 2 * i : i;
+    auto buff = std::make_shared<ConstBuffer>(buffer, *buffer_size);
+    auto buff_var = (!var_size) ? nullptr :
+                                  std::make_shared<ConstBuffer>(
+                                      buffer_var, *buffer_var_size);
     uint64_t pos = 0;
     for (const auto& wcr : write_cell_ranges[i]) {
       // Write empty range
@@ -1868,7 +2014,12 @@ Status Writer::prepare_tiles(
         write_empty_cell_range_to_tile(
             (end_pos - pos + 1) * cell_val_num, &(*tiles)[t]);
     }
-  }
+
+    return Status::Ok();
+  });
+
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
 
   return Status::Ok();
 
@@ -1878,17 +2029,15 @@ Status Writer::prepare_tiles(
 Status Writer::prepare_tiles(
     const std::string& attribute,
     const std::vector<uint64_t>& cell_pos,
-    const std::set<uint64_t>& coord_dups,
     std::vector<Tile>* tiles) const {
   return array_schema_->var_size(attribute) ?
-             prepare_tiles_var(attribute, cell_pos, coord_dups, tiles) :
-             prepare_tiles_fixed(attribute, cell_pos, coord_dups, tiles);
+             prepare_tiles_var(attribute, cell_pos, tiles) :
+             prepare_tiles_fixed(attribute, cell_pos, tiles);
 }
 
 Status Writer::prepare_tiles_fixed(
     const std::string& attribute,
     const std::vector<uint64_t>& cell_pos,
-    const std::set<uint64_t>& coord_dups,
     std::vector<Tile>* tiles) const {
   STATS_FUNC_IN(writer_prepare_tiles_fixed);
 
@@ -1898,39 +2047,28 @@ Status Writer::prepare_tiles_fixed(
 
   // For easy reference
   auto it = attr_buffers_.find(attribute);
-  auto buffer = (unsigned char*)it->second.buffer_;
+  auto buffer = it->second.buffer_;
   auto cell_num = (uint64_t)cell_pos.size();
   auto capacity = array_schema_->capacity();
-  auto dups_num = coord_dups.size();
-  auto tile_num = utils::math::ceil(cell_num - dups_num, capacity);
+  auto tile_num = utils::math::ceil(cell_num, capacity);
   auto cell_size = array_schema_->cell_size(attribute);
 
-  // Initialize tiles
+  // Gather the cells of each tile in parallel
   tiles->resize(tile_num);
-  for (auto& tile : (*tiles))
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, tile_num, [&](uint64_t t) {
+    auto& tile = (*tiles)[t];
     RETURN_NOT_OK(init_tile(attribute, &tile));
+    auto start = t * capacity;
+    auto num = std::min(capacity, cell_num - start);
+    gather::gather_fixed(buffer, cell_size, &cell_pos[start], num, tile.data());
+    tile.set_size(num * cell_size);
+    tile.set_offset(num * cell_size);
+    return Status::Ok();
+  });
 
-  // Write all cells one by one
-  if (dups_num == 0) {
-    for (uint64_t i = 0, tile_idx = 0; i < cell_num; ++i) {
-      if ((*tiles)[tile_idx].full())
-        ++tile_idx;
-
-      RETURN_NOT_OK((*tiles)[tile_idx].write(
-          buffer + cell_pos[i] * cell_size, cell_size));
-    }
-  } else {
-    for (uint64_t i = 0, tile_idx = 0; i < cell_num; ++i) {
-      if (coord_dups.find(cell_pos[i]) != coord_dups.end())
-        continue;
-
-      if ((*tiles)[tile_idx].full())
-        ++tile_idx;
-
-      RETURN_NOT_OK((*tiles)[tile_idx].write(
-          buffer + cell_pos[i] * cell_size, cell_size));
-    }
-  }
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
 
   return Status::Ok();
 
@@ -1940,65 +2078,61 @@ Status Writer::prepare_tiles_fixed(
 Status Writer::prepare_tiles_var(
     const std::string& attribute,
     const std::vector<uint64_t>& cell_pos,
-    const std::set<uint64_t>& coord_dups,
     std::vector<Tile>* tiles) const {
   STATS_FUNC_IN(writer_prepare_tiles_var);
 
+  // Trivial case
+  if (cell_pos.empty())
+    return Status::Ok();
+
   // For easy reference
   auto it = attr_buffers_.find(attribute);
   auto buffer = (uint64_t*)it->second.buffer_;
-  auto buffer_var = (unsigned char*)it->second.buffer_var_;
-  auto buffer_var_size = it->second.buffer_var_size_;
+  auto buffer_var = it->second.buffer_var_;
+  auto buffer_num = *it->second.buffer_size_ / constants::cell_var_offset_size;
+  auto buffer_var_size = *it->second.buffer_var_size_;
   auto cell_num = (uint64_t)cell_pos.size();
   auto capacity = array_schema_->capacity();
-  auto dups_num = coord_dups.size();
-  auto tile_num = utils::math::ceil(cell_num - dups_num, capacity);
-  uint64_t offset;
-  uint64_t var_size;
+  auto tile_num = utils::math::ceil(cell_num, capacity);
+  auto offset_size = constants::cell_var_offset_size;
 
-  // Initialize tiles
+  // Gather the offsets and then the var-sized values of each tile in
+  // parallel. The tile offsets start from zero.
   tiles->resize(2 * tile_num);
-  auto tiles_len = tiles->size();
-  for (uint64_t i = 0; i < tiles_len; i += 2)
-    RETURN_NOT_OK(init_tile(attribute, &((*tiles)[i]), &((*tiles)[i + 1])));
-
-  // Write all cells one by one
-  if (dups_num == 0) {
-    for (uint64_t i = 0, tile_idx = 0; i < cell_num; ++i) {
-      if ((*tiles)[tile_idx].full())
-        tile_idx += 2;
-
-      // Write offset
-      offset = (*tiles)[tile_idx + 1].size();
-      RETURN_NOT_OK((*tiles)[tile_idx].write(&offset, sizeof(offset)));
-
-      // Write var-sized value
-      var_size = (cell_pos[i] == cell_num - 1) ?
-                     *buffer_var_size - buffer[cell_pos[i]] :
-                     buffer[cell_pos[i] + 1] - buffer[cell_pos[i]];
-      RETURN_NOT_OK((*tiles)[tile_idx + 1].write(
-          &buffer_var[buffer[cell_pos[i]]], var_size));
-    }
-  } else {
-    for (uint64_t i = 0, tile_idx = 0; i < cell_num; ++i) {
-      if (coord_dups.find(cell_pos[i]) != coord_dups.end())
-        continue;
-
-      if ((*tiles)[tile_idx].full())
-        tile_idx += 2;
-
-      // Write offset
-      offset = (*tiles)[tile_idx + 1].size();
-      RETURN_NOT_OK((*tiles)[tile_idx].write(&offset, sizeof(offset)));
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, tile_num, [&](uint64_t t) {
+    auto& tile = (*tiles)[2 * t];
+    auto& tile_var = (*tiles)[2 * t + 1];
+    RETURN_NOT_OK(init_tile(attribute, &tile, &tile_var));
+    auto start = t * capacity;
+    auto num = std::min(capacity, cell_num - start);
+    auto tile_offsets = (uint64_t*)tile.data();
+    auto var_size = gather::gather_var_offsets(
+        buffer,
+        buffer_num,
+        buffer_var_size,
+        &cell_pos[start],
+        num,
+        tile_offsets);
+    tile.set_size(num * offset_size);
+    tile.set_offset(num * offset_size);
+
+    RETURN_NOT_OK(tile_var.realloc(var_size));
+    gather::gather_var(
+        buffer,
+        buffer_var,
+        &cell_pos[start],
+        num,
+        tile_offsets,
+        var_size,
+        tile_var.data());
+    tile_var.set_size(var_size);
+    tile_var.set_offset(var_size);
+    return Status::Ok();
+  });
 
-      // Write var-sized value
-      var_size = (cell_pos[i] == cell_num - 1) ?
-                     *buffer_var_size - buffer[cell_pos[i]] :
-                     buffer[cell_pos[i] + 1] - buffer[cell_pos[i]];
-      RETURN_NOT_OK((*tiles)[tile_idx + 1].write(
-          &buffer_var[buffer[cell_pos[i]]], var_size));
-    }
-  }
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
 
   return Status::Ok();
 
@@ -2030,13 +2164,88 @@ Status Writer::sort_coords(std::vector<uint64_t>* cell_pos) const {
 
   // Sort the coordinates in global order
   parallel_sort(
-      cell_pos->begin(), cell_pos->end(), GlobalCmp<T>(domain, buffer));
+      storage_manager_->thread_pool(),
+      cell_pos->begin(),
+      cell_pos->end(),
+      GlobalCmp<T>(domain, buffer));
 
   return Status::Ok();
 
   STATS_FUNC_OUT(writer_sort_coords);
 }
 
+Status Writer::split_coords_tiles(std::vector<Tile>* tiles) const {
+  auto dim_num = array_schema_->dim_num();
+  auto tile_num = tiles->size();
+  std::vector<Tile> dim_tiles(tile_num * dim_num);
+
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, tile_num, [&](uint64_t i) {
+    std::vector<Tile> split;
+    RETURN_NOT_OK((*tiles)[i].split_coordinates(&split));
+    for (unsigned d = 0; d < dim_num; ++d)
+      dim_tiles[i * dim_num + d] = std::move(split[d]);
+    return Status::Ok();
+  });
+
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  *tiles = std::move(dim_tiles);
+
+  return Status::Ok();
+}
+
+Status Writer::train_zstd_dictionary(
+    const std::string& attribute,
+    const std::vector<Tile>& tiles,
+    std::shared_ptr<ZStdDictionary>* dict) const {
+  STATS_FUNC_IN(writer_train_zstd_dictionary);
+
+  dict->reset();
+  auto filters = array_schema_->filters(attribute);
+  if (zstd_dictionary_size_ == 0 || filters->size() == 0 ||
+      filters->get_filter(0)->type() != FilterType::FILTER_ZSTD)
+    return Status::Ok();
+
+  // Split the values tiles into chunks, the unit of compression. For
+  // var-sized attributes, the values tiles follow their offsets tiles.
+  bool var_size = array_schema_->var_size(attribute);
+  uint64_t chunk_size = filters->max_chunk_size();
+  std::vector<ConstBuffer> chunks;
+  for (uint64_t i = var_size ? 1 : 0; i < tiles.size(); i += var_size ? 2 : 1) {
+    auto buff = tiles[i].buffer();
+    for (uint64_t offset = 0; offset < buff->size(); offset += chunk_size)
+      chunks.emplace_back(
+          (const char*)buff->data() + offset,
+          std::min(chunk_size, buff->size() - offset));
+  }
+
+  // Use evenly spaced chunks as samples, up to the sample budget
+  uint64_t total_size = 0;
+  for (const auto& chunk : chunks)
+    total_size += chunk.size();
+  uint64_t max_size =
+      constants::zstd_dictionary_sample_ratio * zstd_dictionary_size_;
+  uint64_t sample_num = chunks.size();
+  if (total_size > max_size)
+    sample_num = std::max<uint64_t>(
+        1, (uint64_t)((double)chunks.size() * max_size / total_size));
+  std::vector<uint8_t> samples;
+  std::vector<size_t> sample_sizes(sample_num);
+  for (uint64_t i = 0; i < sample_num; ++i) {
+    const auto& chunk = chunks[i * chunks.size() / sample_num];
+    auto data = (const uint8_t*)chunk.data();
+    samples.insert(samples.end(), data, data + chunk.size());
+    sample_sizes[i] = chunk.size();
+  }
+
+  return ZStdDictionary::train(
+      samples, sample_sizes, zstd_dictionary_size_, dict);
+
+  STATS_FUNC_OUT(writer_train_zstd_dictionary);
+}
+
 Status Writer::unordered_write() {
   STATS_FUNC_IN(writer_unordered_write);
 
@@ -2092,6 +2301,18 @@ Status Writer::unordered_write() {
   if (dedup_coords_)
     RETURN_CANCEL_OR_ERROR(compute_coord_dups(cell_pos, &coord_dups));
 
+  // Remove the duplicates from the sorted positions once, instead of
+  // looking them up per cell and attribute while preparing the tiles
+  if (!coord_dups.empty()) {
+    cell_pos.erase(
+        std::remove_if(
+            cell_pos.begin(),
+            cell_pos.end(),
+            [&](uint64_t pos) { return coord_dups.count(pos) != 0; }),
+        cell_pos.end());
+    coord_dups.clear();
+  }
+
   // Create new fragment
   std::shared_ptr<FragmentMetadata> frag_meta;
   RETURN_CANCEL_OR_ERROR(create_fragment(false, &frag_meta));
@@ -2100,16 +2321,14 @@ Status Writer::unordered_write() {
   // Prepare tiles for all attributes
   auto num_attributes = attributes_.size();
   std::vector<std::vector<Tile>> attribute_tiles(num_attributes);
-  auto statuses = parallel_for(0, num_attributes, [&](uint64_t i) {
+  auto tp = storage_manager_->thread_pool();
+  auto statuses = parallel_for(tp, 0, num_attributes, [&](uint64_t i) {
     const auto& attr = attributes_[i];
     auto& tiles = attribute_tiles[i];
-    RETURN_CANCEL_OR_ERROR(prepare_tiles(attr, cell_pos, coord_dups, &tiles));
+    RETURN_CANCEL_OR_ERROR(prepare_tiles(attr, cell_pos, &tiles));
     return Status::Ok();
   });
 
-  // Clear the boolean vector for coordinate duplicates
-  coord_dups.clear();
-
   // Check all statuses
   for (auto& st : statuses)
     RETURN_NOT_OK_ELSE(st, storage_manager_->vfs()->remove_dir(uri));
@@ -2122,13 +2341,13 @@ Status Writer::unordered_write() {
   frag_meta->set_num_tiles(num_tiles);
 
   // Filter all tiles
-  statuses = parallel_for(0, num_attributes, [&](uint64_t i) {
+  statuses = parallel_for(tp, 0, num_attributes, [&](uint64_t i) {
     const auto& attr = attributes_[i];
     auto& tiles = attribute_tiles[i];
     if (attr == constants::coords)
       RETURN_CANCEL_OR_ERROR(
           compute_coords_metadata<T>(tiles, frag_meta.get()));
-    RETURN_CANCEL_OR_ERROR(filter_tiles(attr, &tiles));
+    RETURN_CANCEL_OR_ERROR(filter_tiles(attr, frag_meta.get(), &tiles));
     return Status::Ok();
   });
 
@@ -2227,16 +2446,29 @@ Status Writer::write_all_tiles(
   for (uint64_t i = 0; i < num_attributes; i++) {
     const auto& attr = attributes_[i];
     auto& tiles = attribute_tiles[i];
+
+    // Write the coordinates of each dimension to its own file
+    if (attr == constants::coords) {
+      auto dim_num = array_schema_->dim_num();
+      for (unsigned d = 0; d < dim_num; ++d) {
+        tasks.push_back(
+            storage_manager_->thread_pool()->enqueue([&, d, this]() {
+              RETURN_CANCEL_OR_ERROR(write_coords_tiles(d, frag_meta, tiles));
+              return Status::Ok();
+            }));
+      }
+      continue;
+    }
+
     tasks.push_back(
-        storage_manager_->writer_thread_pool()->enqueue([&, this]() {
+        storage_manager_->thread_pool()->enqueue([&, this]() {
           RETURN_CANCEL_OR_ERROR(write_tiles(attr, frag_meta, tiles));
           return Status::Ok();
         }));
   }
 
   // Wait for writes and check all statuses
-  auto statuses =
-      storage_manager_->writer_thread_pool()->wait_all_status(tasks);
+  auto statuses = storage_manager_->thread_pool()->wait_all_status(tasks);
   for (auto& st : statuses)
     RETURN_NOT_OK(st);
 
@@ -2292,5 +2524,37 @@ Status Writer::write_tiles(
   return Status::Ok();
 }
 
+Status Writer::write_coords_tiles(
+    unsigned dim_idx,
+    FragmentMetadata* frag_meta,
+    const std::vector<Tile>& tiles) const {
+  // Handle zero tiles
+  if (tiles.empty())
+    return Status::Ok();
+
+  // For easy reference
+  auto dim_num = array_schema_->dim_num();
+  auto dim_name = FragmentMetadata::coords_dim_name(dim_idx);
+  auto dim_uri = frag_meta->attr_uri(dim_name);
+
+  // Write the tiles of the dimension
+  auto tile_num = tiles.size() / dim_num;
+  for (uint64_t tile_id = 0; tile_id < tile_num; ++tile_id) {
+    const auto& tile = tiles[tile_id * dim_num + dim_idx];
+    RETURN_NOT_OK(storage_manager_->write(dim_uri, tile.buffer()));
+    frag_meta->set_tile_offset(dim_name, tile_id, tile.buffer()->size());
+
+    STATS_COUNTER_ADD(writer_num_bytes_written, tile.buffer()->size());
+  }
+
+  // Close the file, except in the case of global order
+  if (layout_ != Layout::GLOBAL_ORDER)
+    RETURN_NOT_OK(storage_manager_->close_file(dim_uri));
+
+  STATS_COUNTER_ADD(writer_num_attr_tiles_written, tile_num);
+
+  return Status::Ok();
+}
+
 }  // namespace sm
 }  // namespace tiledb
@@ -210,6 +210,13 @@ class Writer {
       void* buffer_val,
       uint64_t* buffer_val_size);
 
+  /**
+   * Sets whether unordered writes may be buffered by the write coalescer
+   * of the storage manager, when `sm.write_coalescing.max_bytes` is
+   * non-zero. This is `true` by default.
+   */
+  void set_coalesce_writes(bool coalesce_writes);
+
   /** Sets the fragment URI. Applicable only to write queries. */
   void set_fragment_uri(const URI& fragment_uri);
 
@@ -274,6 +281,12 @@ class Writer {
    */
   bool check_coord_oob_;
 
+  /**
+   * If `true`, unordered writes are buffered by the write coalescer of the
+   * storage manager if it is enabled.
+   */
+  bool coalesce_writes_;
+
   /**
    * If `true`, the coordinates will be checked whether the
    * obey the global array order and appropriate errors will be thrown.
@@ -309,6 +322,12 @@ class Writer {
   /** The subarray the query is constrained on. */
   void* subarray_;
 
+  /**
+   * The maximum size of the zstd dictionary trained for each attribute in
+   * the fragment. No dictionaries are trained if 0.
+   */
+  uint64_t zstd_dictionary_size_;
+
   /* ********************************* */
   /*           PRIVATE METHODS         */
   /* ********************************* */
@@ -328,6 +347,24 @@ class Writer {
    */
   Status check_coord_dups(const std::vector<uint64_t>& cell_pos) const;
 
+  /**
+   * Throws an error if there are coordinate duplicates. This function
+   * sorts the coordinates of an unordered write to find them.
+   *
+   * @return Status
+   */
+  Status check_coord_dups_unordered() const;
+
+  /**
+   * Throws an error if there are coordinate duplicates. This function
+   * sorts the coordinates of an unordered write to find them.
+   *
+   * @tparam T The domain type.
+   * @return Status
+   */
+  template <class T>
+  Status check_coord_dups_unordered() const;
+
   /**
    * Throws an error if there are coordinates falling out-of-bounds, i.e.,
    * outside the array domain.
@@ -380,7 +417,10 @@ class Writer {
   template <class T>
   Status check_subarray() const;
 
-  /** Closes all attribute files, flushing their state to storage. */
+  /**
+   * Closes all attribute files, including the coordinate file of each
+   * dimension, flushing their state to storage.
+   */
   Status close_files(FragmentMetadata* meta) const;
 
   /**
@@ -455,26 +495,38 @@ class Writer {
   /**
    * Runs the input tiles for the input attribute through the filter pipeline.
    * The tile buffers are modified to contain the output of the pipeline.
+   * The coordinate tiles are first split into one tile per dimension (see
+   * `split_coords_tiles`), each filtered with the pipeline of its dimension.
+   *
+   * The attribute values are compressed with the zstd dictionary of the
+   * attribute in the fragment, which is trained on the input tiles if the
+   * fragment has none yet (see `train_zstd_dictionary`).
    *
    * @param attribute The attribute the tiles belong to.
+   * @param frag_meta The metadata of the fragment the tiles are written to.
    * @param tile The tiles to be filtered.
    * @return Status
    */
   Status filter_tiles(
-      const std::string& attribute, std::vector<Tile>* tiles) const;
+      const std::string& attribute,
+      FragmentMetadata* frag_meta,
+      std::vector<Tile>* tiles) const;
 
   /**
-   * Runs the input tile for the input attribute through the filter pipeline.
-   * The tile buffer is modified to contain the output of the pipeline.
+   * Runs the input tile through the input filter pipeline, to which the
+   * encryption filter is appended when necessary. The tile buffer is
+   * modified to contain the output of the pipeline.
    *
-   * @param attribute The attribute the tile belong to.
+   * @param filters The filter pipeline to run.
+   * @param zstd_dictionary The dictionary of the zstd compression filters of
+   *     the pipeline (may be `nullptr`).
    * @param tile The tile to be filtered.
-   * @param offsets True if the tile to be filtered contains offsets for a
-   *    var-sized attribute.
    * @return Status
    */
   Status filter_tile(
-      const std::string& attribute, Tile* tile, bool offsets) const;
+      const FilterPipeline* filters,
+      const std::shared_ptr<ZStdDictionary>& zstd_dictionary,
+      Tile* tile) const;
 
   /** Finalizes the global write state. */
   Status finalize_global_write_state();
@@ -688,16 +740,14 @@ class Writer {
    *
    * @param attribute The attribute to prepare the tiles for.
    * @param cell_pos The positions that resulted from sorting and
-   *     according to which the cells must be re-arranged.
-   * @param coord_dups The set with the positions
-   *     of duplicate coordinates/cells.
+   *     according to which the cells must be re-arranged. They must
+   *     not include the positions of duplicate coordinates.
    * @param tiles The tiles to be created.
    * @return Status
    */
   Status prepare_tiles(
       const std::string& attribute,
       const std::vector<uint64_t>& cell_pos,
-      const std::set<uint64_t>& coord_dups,
       std::vector<Tile>* tiles) const;
 
   /**
@@ -707,16 +757,14 @@ class Writer {
    *
    * @param attribute The attribute to prepare the tiles for.
    * @param cell_pos The positions that resulted from sorting and
-   *     according to which the cells must be re-arranged.
-   * @param coord_dups The set with the positions
-   *     of duplicate coordinates/cells.
+   *     according to which the cells must be re-arranged. They must
+   *     not include the positions of duplicate coordinates.
    * @param tiles The tiles to be created.
    * @return Status
    */
   Status prepare_tiles_fixed(
       const std::string& attribute,
       const std::vector<uint64_t>& cell_pos,
-      const std::set<uint64_t>& coord_dups,
       std::vector<Tile>* tiles) const;
 
   /**
@@ -726,16 +774,14 @@ class Writer {
    *
    * @param attribute The attribute to prepare the tiles for.
    * @param cell_pos The positions that resulted from sorting and
-   *     according to which the cells must be re-arranged.
-   * @param coord_dups The set with the positions
-   *     of duplicate coordinates/cells.
+   *     according to which the cells must be re-arranged. They must
+   *     not include the positions of duplicate coordinates.
    * @param tiles The tiles to be created.
    * @return Status
    */
   Status prepare_tiles_var(
       const std::string& attribute,
       const std::vector<uint64_t>& cell_pos,
-      const std::set<uint64_t>& coord_dups,
       std::vector<Tile>* tiles) const;
 
   /** Resets the writer object, rendering it incomplete. */
@@ -752,6 +798,35 @@ class Writer {
   template <class T>
   Status sort_coords(std::vector<uint64_t>* cell_pos) const;
 
+  /**
+   * Splits each of the input coordinate tiles into one tile per dimension.
+   * On return, `tiles` holds `dim_num` consecutive tiles (in dimension
+   * order) for each of the original tiles.
+   *
+   * @param tiles The coordinate tiles to be split in place.
+   * @return Status
+   */
+  Status split_coords_tiles(std::vector<Tile>* tiles) const;
+
+  /**
+   * Trains a zstd dictionary on the values of the input attribute tiles, if
+   * dictionaries are enabled (`sm.zstd_dictionary_size`) and the first
+   * filter of the attribute is a zstd compression filter. The dictionary is
+   * trained on the unfiltered values, which is why it is only used when no
+   * filter precedes the compression.
+   *
+   * @param attribute The attribute the tiles belong to (not the coordinates).
+   * @param tiles The unfiltered tiles of the attribute. For var-sized
+   *     attributes, offsets and values tiles alternate.
+   * @param dict Set to the trained dictionary, or to `nullptr` if no
+   *     dictionary is used for the attribute.
+   * @return Status
+   */
+  Status train_zstd_dictionary(
+      const std::string& attribute,
+      const std::vector<Tile>& tiles,
+      std::shared_ptr<ZStdDictionary>* dict) const;
+
   /**
    * Writes in unordered layout. Applicable to both dense and sparse arrays.
    * Explicit coordinates must be provided for this write.
@@ -844,6 +919,20 @@ class Writer {
       const std::string& attribute,
       FragmentMetadata* frag_meta,
       const std::vector<Tile>& tiles) const;
+
+  /**
+   * Writes the coordinate tiles of the input dimension to storage.
+   *
+   * @param dim_idx The index of the dimension.
+   * @param frag_meta The fragment metadata.
+   * @param tiles The split coordinate tiles, holding one tile per dimension
+   *     for each coordinate tile (see `split_coords_tiles`).
+   * @return Status
+   */
+  Status write_coords_tiles(
+      unsigned dim_idx,
+      FragmentMetadata* frag_meta,
+      const std::vector<Tile>& tiles) const;
 };
 
 }  // namespace sm
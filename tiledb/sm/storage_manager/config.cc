@@ -174,6 +174,16 @@ Status Config::set(const std::string& param, const std::string& value) {
     RETURN_NOT_OK(set_sm_check_global_order(value));
   } else if (param == "sm.tile_cache_size") {
     RETURN_NOT_OK(set_sm_tile_cache_size(value));
+  } else if (param == "sm.zstd_dictionary_size") {
+    RETURN_NOT_OK(set_sm_zstd_dictionary_size(value));
+  } else if (param == "sm.verify_checksums") {
+    RETURN_NOT_OK(set_sm_verify_checksums(value));
+  } else if (param == "sm.write_coalescing.max_bytes") {
+    RETURN_NOT_OK(set_sm_write_coalescing_max_bytes(value));
+  } else if (param == "sm.write_coalescing.max_age_ms") {
+    RETURN_NOT_OK(set_sm_write_coalescing_max_age_ms(value));
+  } else if (param == "sm.read_partition_utilization") {
+    RETURN_NOT_OK(set_sm_read_partition_utilization(value));
   } else if (param == "sm.consolidation.amplification") {
     RETURN_NOT_OK(set_consolidation_amplification(value));
   } else if (param == "sm.consolidation.buffer_size") {
@@ -182,6 +192,10 @@ Status Config::set(const std::string& param, const std::string& value) {
     RETURN_NOT_OK(set_sm_array_schema_cache_size(value));
   } else if (param == "sm.fragment_metadata_cache_size") {
     RETURN_NOT_OK(set_sm_fragment_metadata_cache_size(value));
+  } else if (param == "sm.generic_tile_prefetch_size") {
+    RETURN_NOT_OK(set_sm_generic_tile_prefetch_size(value));
+  } else if (param == "sm.buffer_pool_size") {
+    RETURN_NOT_OK(set_sm_buffer_pool_size(value));
   } else if (param == "sm.enable_signal_handlers") {
     RETURN_NOT_OK(set_sm_enable_signal_handlers(value));
   } else if (param == "sm.num_async_threads") {
@@ -190,6 +204,10 @@ Status Config::set(const std::string& param, const std::string& value) {
     RETURN_NOT_OK(set_sm_num_reader_threads(value));
   } else if (param == "sm.num_writer_threads") {
     RETURN_NOT_OK(set_sm_num_writer_threads(value));
+  } else if (param == "sm.num_compute_threads") {
+    RETURN_NOT_OK(set_sm_num_compute_threads(value));
+  } else if (param == "sm.num_consolidation_threads") {
+    RETURN_NOT_OK(set_sm_num_consolidation_threads(value));
   } else if (param == "sm.num_tbb_threads") {
     RETURN_NOT_OK(set_sm_num_tbb_threads(value));
   } else if (param == "sm.consolidation.steps") {
@@ -200,6 +218,14 @@ Status Config::set(const std::string& param, const std::string& value) {
     RETURN_NOT_OK(set_consolidation_step_max_frags(value));
   } else if (param == "sm.consolidation.step_size_ratio") {
     RETURN_NOT_OK(set_consolidation_step_size_ratio(value));
+  } else if (param == "sm.consolidation.auto") {
+    RETURN_NOT_OK(set_consolidation_auto(value));
+  } else if (param == "sm.consolidation.auto_interval_ms") {
+    RETURN_NOT_OK(set_consolidation_auto_interval_ms(value));
+  } else if (param == "sm.consolidation.auto_max_bytes") {
+    RETURN_NOT_OK(set_consolidation_auto_max_bytes(value));
+  } else if (param == "sm.consolidation.auto_write_amplification") {
+    RETURN_NOT_OK(set_consolidation_auto_write_amplification(value));
   } else if (param == "vfs.num_threads") {
     RETURN_NOT_OK(set_vfs_num_threads(value));
   } else if (param == "vfs.min_parallel_size") {
@@ -210,6 +236,14 @@ Status Config::set(const std::string& param, const std::string& value) {
     RETURN_NOT_OK(set_vfs_max_batch_read_amplification(value));
   } else if (param == "vfs.file.max_parallel_ops") {
     RETURN_NOT_OK(set_vfs_file_max_parallel_ops(value));
+  } else if (param == "vfs.file.io_uring") {
+    RETURN_NOT_OK(set_vfs_file_io_uring(value));
+  } else if (param == "vfs.file.io_uring_depth") {
+    RETURN_NOT_OK(set_vfs_file_io_uring_depth(value));
+  } else if (param == "vfs.disk_cache.path") {
+    RETURN_NOT_OK(set_vfs_disk_cache_path(value));
+  } else if (param == "vfs.disk_cache.max_size") {
+    RETURN_NOT_OK(set_vfs_disk_cache_max_size(value));
   } else if (param == "vfs.s3.region") {
     RETURN_NOT_OK(set_vfs_s3_region(value));
   } else if (param == "vfs.s3.aws_access_key_id") {
@@ -306,6 +340,34 @@ Status Config::unset(const std::string& param) {
     value << sm_params_.tile_cache_size_;
     param_values_["sm.tile_cache_size"] = value.str();
     value.str(std::string());
+  } else if (param == "sm.zstd_dictionary_size") {
+    sm_params_.zstd_dictionary_size_ = constants::zstd_dictionary_size;
+    value << sm_params_.zstd_dictionary_size_;
+    param_values_["sm.zstd_dictionary_size"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.verify_checksums") {
+    sm_params_.verify_checksums_ = constants::verify_checksums;
+    value << (sm_params_.verify_checksums_ ? "true" : "false");
+    param_values_["sm.verify_checksums"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.write_coalescing.max_bytes") {
+    sm_params_.write_coalescing_max_bytes_ =
+        constants::write_coalescing_max_bytes;
+    value << sm_params_.write_coalescing_max_bytes_;
+    param_values_["sm.write_coalescing.max_bytes"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.write_coalescing.max_age_ms") {
+    sm_params_.write_coalescing_max_age_ms_ =
+        constants::write_coalescing_max_age_ms;
+    value << sm_params_.write_coalescing_max_age_ms_;
+    param_values_["sm.write_coalescing.max_age_ms"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.read_partition_utilization") {
+    sm_params_.read_partition_utilization_ =
+        constants::read_partition_utilization;
+    value << sm_params_.read_partition_utilization_;
+    param_values_["sm.read_partition_utilization"] = value.str();
+    value.str(std::string());
   } else if (param == "sm.consolidation.amplification") {
     sm_params_.consolidation_params_.amplification_ =
         constants::consolidation_amplification;
@@ -329,6 +391,17 @@ Status Config::unset(const std::string& param) {
     value << sm_params_.fragment_metadata_cache_size_;
     param_values_["sm.fragment_metadata_cache_size"] = value.str();
     value.str(std::string());
+  } else if (param == "sm.generic_tile_prefetch_size") {
+    sm_params_.generic_tile_prefetch_size_ =
+        constants::generic_tile_prefetch_size;
+    value << sm_params_.generic_tile_prefetch_size_;
+    param_values_["sm.generic_tile_prefetch_size"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.buffer_pool_size") {
+    sm_params_.buffer_pool_size_ = constants::buffer_pool_size;
+    value << sm_params_.buffer_pool_size_;
+    param_values_["sm.buffer_pool_size"] = value.str();
+    value.str(std::string());
   } else if (param == "sm.enable_signal_handlers") {
     sm_params_.enable_signal_handlers_ = constants::enable_signal_handlers;
     value << (sm_params_.enable_signal_handlers_ ? "true" : "false");
@@ -349,6 +422,17 @@ Status Config::unset(const std::string& param) {
     value << sm_params_.num_writer_threads_;
     param_values_["sm.num_writer_threads"] = value.str();
     value.str(std::string());
+  } else if (param == "sm.num_compute_threads") {
+    sm_params_.num_compute_threads_ = constants::num_compute_threads;
+    value << sm_params_.num_compute_threads_;
+    param_values_["sm.num_compute_threads"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.num_consolidation_threads") {
+    sm_params_.num_consolidation_threads_ =
+        constants::num_consolidation_threads;
+    value << sm_params_.num_consolidation_threads_;
+    param_values_["sm.num_consolidation_threads"] = value.str();
+    value.str(std::string());
   } else if (param == "sm.num_tbb_threads") {
     sm_params_.num_tbb_threads_ = constants::num_tbb_threads;
     value << sm_params_.num_tbb_threads_;
@@ -377,6 +461,29 @@ Status Config::unset(const std::string& param) {
     value << sm_params_.consolidation_params_.step_size_ratio_;
     param_values_["sm.consolidation.step_size_ratio"] = value.str();
     value.str(std::string());
+  } else if (param == "sm.consolidation.auto") {
+    sm_params_.consolidation_params_.auto_ = constants::consolidation_auto;
+    value << (sm_params_.consolidation_params_.auto_ ? "true" : "false");
+    param_values_["sm.consolidation.auto"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.consolidation.auto_interval_ms") {
+    sm_params_.consolidation_params_.auto_interval_ms_ =
+        constants::consolidation_auto_interval_ms;
+    value << sm_params_.consolidation_params_.auto_interval_ms_;
+    param_values_["sm.consolidation.auto_interval_ms"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.consolidation.auto_max_bytes") {
+    sm_params_.consolidation_params_.auto_max_bytes_ =
+        constants::consolidation_auto_max_bytes;
+    value << sm_params_.consolidation_params_.auto_max_bytes_;
+    param_values_["sm.consolidation.auto_max_bytes"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.consolidation.auto_write_amplification") {
+    sm_params_.consolidation_params_.auto_write_amplification_ =
+        constants::consolidation_auto_write_amplification;
+    value << sm_params_.consolidation_params_.auto_write_amplification_;
+    param_values_["sm.consolidation.auto_write_amplification"] = value.str();
+    value.str(std::string());
   } else if (param == "vfs.num_threads") {
     vfs_params_.num_threads_ = constants::vfs_num_threads;
     value << vfs_params_.num_threads_;
@@ -404,6 +511,28 @@ Status Config::unset(const std::string& param) {
     value << vfs_params_.file_params_.max_parallel_ops_;
     param_values_["vfs.file.max_parallel_ops"] = value.str();
     value.str(std::string());
+  } else if (param == "vfs.file.io_uring") {
+    vfs_params_.file_params_.io_uring_ = constants::vfs_file_io_uring;
+    value << (vfs_params_.file_params_.io_uring_ ? "true" : "false");
+    param_values_["vfs.file.io_uring"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.file.io_uring_depth") {
+    vfs_params_.file_params_.io_uring_depth_ =
+        constants::vfs_file_io_uring_depth;
+    value << vfs_params_.file_params_.io_uring_depth_;
+    param_values_["vfs.file.io_uring_depth"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.disk_cache.path") {
+    vfs_params_.disk_cache_params_.path_ = constants::vfs_disk_cache_path;
+    value << vfs_params_.disk_cache_params_.path_;
+    param_values_["vfs.disk_cache.path"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.disk_cache.max_size") {
+    vfs_params_.disk_cache_params_.max_size_ =
+        constants::vfs_disk_cache_max_size;
+    value << vfs_params_.disk_cache_params_.max_size_;
+    param_values_["vfs.disk_cache.max_size"] = value.str();
+    value.str(std::string());
   } else if (param == "vfs.s3.region") {
     vfs_params_.s3_params_.region_ = constants::s3_region;
     value << vfs_params_.s3_params_.region_;
@@ -544,6 +673,26 @@ void Config::set_default_param_values() {
   param_values_["sm.tile_cache_size"] = value.str();
   value.str(std::string());
 
+  value << sm_params_.zstd_dictionary_size_;
+  param_values_["sm.zstd_dictionary_size"] = value.str();
+  value.str(std::string());
+
+  value << (sm_params_.verify_checksums_ ? "true" : "false");
+  param_values_["sm.verify_checksums"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.write_coalescing_max_bytes_;
+  param_values_["sm.write_coalescing.max_bytes"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.write_coalescing_max_age_ms_;
+  param_values_["sm.write_coalescing.max_age_ms"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.read_partition_utilization_;
+  param_values_["sm.read_partition_utilization"] = value.str();
+  value.str(std::string());
+
   value << sm_params_.consolidation_params_.amplification_;
   param_values_["sm.consolidation.amplification"] = value.str();
   value.str(std::string());
@@ -560,6 +709,14 @@ void Config::set_default_param_values() {
   param_values_["sm.fragment_metadata_cache_size"] = value.str();
   value.str(std::string());
 
+  value << sm_params_.generic_tile_prefetch_size_;
+  param_values_["sm.generic_tile_prefetch_size"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.buffer_pool_size_;
+  param_values_["sm.buffer_pool_size"] = value.str();
+  value.str(std::string());
+
   value << (sm_params_.enable_signal_handlers_ ? "true" : "false");
   param_values_["sm.enable_signal_handlers"] = value.str();
   value.str(std::string());
@@ -576,6 +733,14 @@ void Config::set_default_param_values() {
   param_values_["sm.num_writer_threads"] = value.str();
   value.str(std::string());
 
+  value << sm_params_.num_compute_threads_;
+  param_values_["sm.num_compute_threads"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.num_consolidation_threads_;
+  param_values_["sm.num_consolidation_threads"] = value.str();
+  value.str(std::string());
+
   value << sm_params_.num_tbb_threads_;
   param_values_["sm.num_tbb_threads"] = value.str();
   value.str(std::string());
@@ -596,6 +761,22 @@ void Config::set_default_param_values() {
   param_values_["sm.consolidation.step_size_ratio"] = value.str();
   value.str(std::string());
 
+  value << (sm_params_.consolidation_params_.auto_ ? "true" : "false");
+  param_values_["sm.consolidation.auto"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_params_.auto_interval_ms_;
+  param_values_["sm.consolidation.auto_interval_ms"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_params_.auto_max_bytes_;
+  param_values_["sm.consolidation.auto_max_bytes"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_params_.auto_write_amplification_;
+  param_values_["sm.consolidation.auto_write_amplification"] = value.str();
+  value.str(std::string());
+
   value << vfs_params_.num_threads_;
   param_values_["vfs.num_threads"] = value.str();
   value.str(std::string());
@@ -616,6 +797,22 @@ void Config::set_default_param_values() {
   param_values_["vfs.file.max_parallel_ops"] = value.str();
   value.str(std::string());
 
+  value << (vfs_params_.file_params_.io_uring_ ? "true" : "false");
+  param_values_["vfs.file.io_uring"] = value.str();
+  value.str(std::string());
+
+  value << vfs_params_.file_params_.io_uring_depth_;
+  param_values_["vfs.file.io_uring_depth"] = value.str();
+  value.str(std::string());
+
+  value << vfs_params_.disk_cache_params_.path_;
+  param_values_["vfs.disk_cache.path"] = value.str();
+  value.str(std::string());
+
+  value << vfs_params_.disk_cache_params_.max_size_;
+  param_values_["vfs.disk_cache.max_size"] = value.str();
+  value.str(std::string());
+
   value << vfs_params_.s3_params_.region_;
   param_values_["vfs.s3.region"] = value.str();
   value.str(std::string());
@@ -767,6 +964,22 @@ Status Config::set_sm_fragment_metadata_cache_size(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_sm_generic_tile_prefetch_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.generic_tile_prefetch_size_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_buffer_pool_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.buffer_pool_size_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_sm_enable_signal_handlers(const std::string& value) {
   bool v;
   RETURN_NOT_OK(parse_bool(value, &v));
@@ -799,6 +1012,22 @@ Status Config::set_sm_num_writer_threads(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_sm_num_compute_threads(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.num_compute_threads_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_num_consolidation_threads(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.num_consolidation_threads_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_sm_num_tbb_threads(const std::string& value) {
   int v;
   RETURN_NOT_OK(utils::parse::convert(value, &v));
@@ -847,6 +1076,51 @@ Status Config::set_sm_tile_cache_size(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_sm_zstd_dictionary_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.zstd_dictionary_size_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_verify_checksums(const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid verify checksums value"));
+  }
+  sm_params_.verify_checksums_ = v;
+  return Status::Ok();
+}
+
+Status Config::set_sm_write_coalescing_max_bytes(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.write_coalescing_max_bytes_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_write_coalescing_max_age_ms(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.write_coalescing_max_age_ms_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_read_partition_utilization(const std::string& value) {
+  float v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  if (!(v > 0 && v <= 1))
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Read partition utilization must be in (0, 1]"));
+  sm_params_.read_partition_utilization_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_consolidation_amplification(const std::string& value) {
   float v;
   RETURN_NOT_OK(utils::parse::convert(value, &v));
@@ -863,6 +1137,39 @@ Status Config::set_consolidation_buffer_size(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_consolidation_auto(const std::string& value) {
+  bool v;
+  RETURN_NOT_OK(parse_bool(value, &v));
+  sm_params_.consolidation_params_.auto_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_consolidation_auto_interval_ms(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.consolidation_params_.auto_interval_ms_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_consolidation_auto_max_bytes(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.consolidation_params_.auto_max_bytes_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_consolidation_auto_write_amplification(
+    const std::string& value) {
+  float v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.consolidation_params_.auto_write_amplification_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_vfs_num_threads(const std::string& value) {
   uint64_t v;
   RETURN_NOT_OK(utils::parse::convert(value, &v));
@@ -903,6 +1210,42 @@ Status Config::set_vfs_file_max_parallel_ops(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_vfs_file_io_uring(const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid io_uring value"));
+  }
+  vfs_params_.file_params_.io_uring_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_vfs_file_io_uring_depth(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  if (v == 0 || v > 4096) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; io_uring depth must be in [1, 4096]"));
+  }
+  vfs_params_.file_params_.io_uring_depth_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_vfs_disk_cache_path(const std::string& value) {
+  vfs_params_.disk_cache_params_.path_ = value;
+  return Status::Ok();
+}
+
+Status Config::set_vfs_disk_cache_max_size(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.disk_cache_params_.max_size_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_vfs_s3_region(const std::string& value) {
   vfs_params_.s3_params_.region_ = value;
   return Status::Ok();
@@ -58,6 +58,10 @@ class Config {
     uint32_t step_min_frags_;
     uint32_t step_max_frags_;
     float step_size_ratio_;
+    bool auto_;
+    uint64_t auto_interval_ms_;
+    uint64_t auto_max_bytes_;
+    float auto_write_amplification_;
 
     ConsolidationParams() {
       amplification_ = constants::consolidation_amplification;
@@ -66,6 +70,11 @@ class Config {
       step_min_frags_ = constants::consolidation_step_min_frags;
       step_max_frags_ = constants::consolidation_step_max_frags;
       step_size_ratio_ = constants::consolidation_step_size_ratio;
+      auto_ = constants::consolidation_auto;
+      auto_interval_ms_ = constants::consolidation_auto_interval_ms;
+      auto_max_bytes_ = constants::consolidation_auto_max_bytes;
+      auto_write_amplification_ =
+          constants::consolidation_auto_write_amplification;
     }
   };
 
@@ -73,12 +82,21 @@ class Config {
   struct SMParams {
     uint64_t array_schema_cache_size_;
     uint64_t fragment_metadata_cache_size_;
+    uint64_t generic_tile_prefetch_size_;
+    uint64_t buffer_pool_size_;
     bool enable_signal_handlers_;
     uint64_t num_async_threads_;
     uint64_t num_reader_threads_;
     uint64_t num_writer_threads_;
+    uint64_t num_compute_threads_;
+    uint64_t num_consolidation_threads_;
     int num_tbb_threads_;
     uint64_t tile_cache_size_;
+    uint64_t zstd_dictionary_size_;
+    bool verify_checksums_;
+    uint64_t write_coalescing_max_bytes_;
+    uint64_t write_coalescing_max_age_ms_;
+    float read_partition_utilization_;
     bool dedup_coords_;
     bool check_coord_dups_;
     bool check_coord_oob_;
@@ -88,12 +106,21 @@ class Config {
     SMParams() {
       array_schema_cache_size_ = constants::array_schema_cache_size;
       fragment_metadata_cache_size_ = constants::fragment_metadata_cache_size;
+      generic_tile_prefetch_size_ = constants::generic_tile_prefetch_size;
+      buffer_pool_size_ = constants::buffer_pool_size;
       enable_signal_handlers_ = constants::enable_signal_handlers;
       num_async_threads_ = constants::num_async_threads;
       num_reader_threads_ = constants::num_reader_threads;
       num_writer_threads_ = constants::num_writer_threads;
+      num_compute_threads_ = constants::num_compute_threads;
+      num_consolidation_threads_ = constants::num_consolidation_threads;
       num_tbb_threads_ = constants::num_tbb_threads;
       tile_cache_size_ = constants::tile_cache_size;
+      zstd_dictionary_size_ = constants::zstd_dictionary_size;
+      verify_checksums_ = constants::verify_checksums;
+      write_coalescing_max_bytes_ = constants::write_coalescing_max_bytes;
+      write_coalescing_max_age_ms_ = constants::write_coalescing_max_age_ms;
+      read_partition_utilization_ = constants::read_partition_utilization;
       dedup_coords_ = false;
       check_coord_dups_ = true;
       check_coord_oob_ = true;
@@ -155,9 +182,23 @@ class Config {
 
   struct FileParams {
     uint64_t max_parallel_ops_;
+    bool io_uring_;
+    uint64_t io_uring_depth_;
 
     FileParams() {
       max_parallel_ops_ = constants::vfs_file_max_parallel_ops;
+      io_uring_ = constants::vfs_file_io_uring;
+      io_uring_depth_ = constants::vfs_file_io_uring_depth;
+    }
+  };
+
+  struct DiskCacheParams {
+    std::string path_;
+    uint64_t max_size_;
+
+    DiskCacheParams() {
+      path_ = constants::vfs_disk_cache_path;
+      max_size_ = constants::vfs_disk_cache_max_size;
     }
   };
 
@@ -165,6 +206,7 @@ class Config {
     S3Params s3_params_;
     HDFSParams hdfs_params_;
     FileParams file_params_;
+    DiskCacheParams disk_cache_params_;
     uint64_t num_threads_;
     uint64_t min_parallel_size_;
     uint64_t max_batch_read_size_;
@@ -241,6 +283,40 @@ class Config {
    * - `sm.tile_cache_size` <br>
    *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.zstd_dictionary_size` <br>
+   *    The maximum size in bytes of the zstd dictionary trained for each
+   *    attribute whose first filter is zstd compression, on the first tiles
+   *    written to a fragment, and stored in the fragment metadata. A
+   *    dictionary improves the compression of small tiles. No dictionaries
+   *    are trained if 0. <br>
+   *    **Default**: 0
+   * - `sm.verify_checksums` <br>
+   *    If `true`, the checksum filters verify the checksum of every tile
+   *    chunk they unfilter, and reads fail on a mismatch. Tiles found in the
+   *    tile cache were verified when first read, so they are not verified
+   *    again. If `false`, checksums are still written but not verified. <br>
+   *    **Default**: true
+   * - `sm.write_coalescing.max_bytes` <br>
+   *    If non-zero, unordered writes are not written as a fragment each, but
+   *    are buffered in memory per array and written together as a single
+   *    fragment once the buffered bytes of the array exceed this size, once
+   *    they are older than `sm.write_coalescing.max_age_ms`, when the array
+   *    is opened for reads in the same context, when
+   *    `tiledb_ctx_flush_writes` is called, or when the context is freed.
+   *    Buffered writes are lost if the process exits before they are flushed.
+   *    Cells written more than once while buffered keep their latest value.
+   *    Writes are not buffered if 0. <br>
+   *    **Default**: 0
+   * - `sm.write_coalescing.max_age_ms` <br>
+   *    The time in milliseconds after which buffered writes are flushed, if
+   *    `sm.write_coalescing.max_bytes` is non-zero. Buffered writes are only
+   *    flushed on the other events if 0. <br>
+   *    **Default**: 1000
+   * - `sm.read_partition_utilization` <br>
+   *    The fraction of the user buffers that each partition of an incomplete
+   *    read aims to fill, based on the estimated result size. Must be in
+   *    `(0, 1]`. <br>
+   *    **Default**: 1.0
    * - `sm.array_schema_cache_size` <br>
    *    Array schema cache size in bytes. Any `uint64_t` value is acceptable.
    * <br>
@@ -249,26 +325,45 @@ class Config {
    *    The fragment metadata cache size in bytes. Any `uint64_t` value is
    *    acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.generic_tile_prefetch_size` <br>
+   *    The number of bytes of a generic tile (e.g. the array schema or a
+   *    fragment metadata section) that are read speculatively in the same
+   *    request as its header, so that small generic tiles are read in a
+   *    single request. `0` reads the header and the tile separately. <br>
+   *    **Default**: 65536
+   * - `sm.buffer_pool_size` <br>
+   *    The maximum number of idle bytes kept by the pool that tile and
+   *    filter buffers allocate from. `0` disables pooling. <br>
+   *    **Default**: 50,000,000
    * - `sm.enable_signal_handlers` <br>
    *    Whether or not TileDB will install signal handlers. <br>
    *    **Default**: true
    * - `sm.num_async_threads` <br>
-   *    The number of threads allocated for async queries. <br>
+   *    Deprecated and ignored. Async queries run on the thread pool of the
+   *    context (see `sm.num_compute_threads`). <br>
    *    **Default**: 1
    * - `sm.num_reader_threads` <br>
-   *    The number of threads allocated for issuing reads to VFS in
-   *    parallel. <br>
+   *    Deprecated and ignored. Reads are issued on the thread pool of the
+   *    context (see `sm.num_compute_threads`). <br>
    *    **Default**: 1
    * - `sm.num_writer_threads` <br>
-   *    The number of threads allocated for issuing writes to VFS in
-   *    parallel.<br>
+   *    Deprecated and ignored. Writes are issued on the thread pool of the
+   *    context (see `sm.num_compute_threads`). <br>
+   *    **Default**: 1
+   * - `sm.num_compute_threads` <br>
+   *    The number of threads of the thread pool of the context, which runs all
+   *    its parallel work: async queries, the parallel I/O, loops and sorts of
+   *    the queries and the filter pipeline, and background consolidation. <br>
+   *    **Default**: number of cores
+   * - `sm.num_consolidation_threads` <br>
+   *    The maximum number of background consolidations running at a time on the
+   *    thread pool of the context (see `sm.consolidation.auto`).<br>
    *    **Default**: 1
    * - `sm.num_tbb_threads` <br>
-   *    The number of threads allocated for the TBB thread pool (if TBB is
-   *    enabled). Note: this is a whole-program setting. Usually this should not
-   *    be modified from the default. See also the documentation for TBB's
-   *    `task_scheduler_init` class.<br>
-   *    **Default**: TBB automatic
+   *    Deprecated and ignored. TileDB no longer uses TBB; all parallel work
+   *    runs on the thread pool of the context (see `sm.num_compute_threads`).
+   *    <br>
+   *    **Default**: -1
    * - `sm.consolidation.amplification` <br>
    *    The factor by which the size of the dense fragment resulting
    *    from consolidating a set of fragments (containing at least one
@@ -296,9 +391,28 @@ class Config {
    *    The size ratio that two ("adjacent") fragments must satisfy to be
    *    considered for consolidation in a single step.<br>
    *    **Default**: 0.0
+   * - `sm.consolidation.auto` <br>
+   *    If `true`, arrays written through this context are consolidated in
+   *    the background after writes, using the consolidation parameters
+   *    above.<br>
+   *    **Default**: false
+   * - `sm.consolidation.auto_interval_ms` <br>
+   *    The minimum time (in milliseconds) between two background
+   *    consolidation runs on the same array.<br>
+   *    **Default**: 1000
+   * - `sm.consolidation.auto_max_bytes` <br>
+   *    The maximum number of fragment bytes a single background
+   *    consolidation run may rewrite.<br>
+   *    **Default**: 1,000,000,000
+   * - `sm.consolidation.auto_write_amplification` <br>
+   *    The maximum ratio of bytes rewritten by background consolidation to
+   *    bytes written by queries, per array.<br>
+   *    **Default**: 4.0
    * - `vfs.num_threads` <br>
    *    The number of threads allocated for VFS operations (any backend), per
-   *    VFS instance. <br>
+   *    VFS instance created without a context, e.g., by `tiledb_vfs_alloc`. The
+   *    VFS of a context uses the thread pool of the context (see
+   *    `sm.num_compute_threads`). <br>
    *    **Default**: number of cores
    * - `vfs.min_parallel_size` <br>
    *    The minimum number of bytes in a parallel VFS operation
@@ -316,6 +430,29 @@ class Config {
    *    The maximum number of parallel operations on objects with `file:///`
    *    URIs. <br>
    *    **Default**: `vfs.num_threads`
+   * - `vfs.file.io_uring` <br>
+   *    If `true`, reads of objects with `file:///` URIs are submitted in
+   *    batches through Linux io_uring instead of blocking `pread` calls from
+   *    the VFS thread pool. Ignored (with the blocking path used instead) if
+   *    TileDB was built without io_uring support or the kernel does not
+   *    provide it. <br>
+   *    **Default**: false
+   * - `vfs.file.io_uring_depth` <br>
+   *    The maximum number of reads in flight on an io_uring instance, if
+   *    `vfs.file.io_uring` is `true`. <br>
+   *    **Default**: 32
+   * - `vfs.disk_cache.path` <br>
+   *    A local directory in which the fragment files (except the fragment
+   *    metadata) read from `s3://` and `hdfs://` URIs are cached, keyed on the
+   *    file URI and the byte range read. Fragment files are immutable, so
+   *    cached ranges never go stale. Missed ranges are cached by background
+   *    tasks, off the read path. The directory may be shared by concurrent
+   *    processes. The cache is disabled if empty. <br>
+   *    **Default**: ""
+   * - `vfs.disk_cache.max_size` <br>
+   *    The maximum size in bytes of the local disk cache, beyond which the
+   *    least recently used ranges are evicted. <br>
+   *    **Default**: 10737418240
    * - `vfs.s3.region` <br>
    *    The S3 region, if S3 is enabled. <br>
    *    **Default**: us-east-1
@@ -456,6 +593,12 @@ class Config {
   /** Sets the fragment metadata cache size, properly parsing the input value.*/
   Status set_sm_fragment_metadata_cache_size(const std::string& value);
 
+  /** Sets the generic tile prefetch size, properly parsing the input value. */
+  Status set_sm_generic_tile_prefetch_size(const std::string& value);
+
+  /** Sets the buffer pool size, properly parsing the input value. */
+  Status set_sm_buffer_pool_size(const std::string& value);
+
   /** Sets the enable signal handlers value, properly parsing the input value.*/
   Status set_sm_enable_signal_handlers(const std::string& value);
 
@@ -468,7 +611,13 @@ class Config {
   /** Sets the number of threads, properly parsing the input value.*/
   Status set_sm_num_writer_threads(const std::string& value);
 
-  /** Sets the number of TBB threads, properly parsing the input value.*/
+  /** Sets the number of compute threads, properly parsing the input value. */
+  Status set_sm_num_compute_threads(const std::string& value);
+
+  /** Sets the number of threads, properly parsing the input value.*/
+  Status set_sm_num_consolidation_threads(const std::string& value);
+
+  /** Sets the (ignored) number of TBB threads, parsing the input value.*/
   Status set_sm_num_tbb_threads(const std::string& value);
 
   /** Sets the number of consolidation steps.*/
@@ -489,9 +638,36 @@ class Config {
   /** Sets the consolidation buffer size, properly parsing the input value. */
   Status set_consolidation_buffer_size(const std::string& value);
 
+  /** Sets whether background consolidation is enabled. */
+  Status set_consolidation_auto(const std::string& value);
+
+  /** Sets the minimum interval between background consolidation runs. */
+  Status set_consolidation_auto_interval_ms(const std::string& value);
+
+  /** Sets the maximum bytes rewritten by a background consolidation run. */
+  Status set_consolidation_auto_max_bytes(const std::string& value);
+
+  /** Sets the background consolidation write amplification budget. */
+  Status set_consolidation_auto_write_amplification(const std::string& value);
+
   /** Sets the tile cache size, properly parsing the input value. */
   Status set_sm_tile_cache_size(const std::string& value);
 
+  /** Sets the maximum size of the zstd dictionary of each attribute. */
+  Status set_sm_zstd_dictionary_size(const std::string& value);
+
+  /** Sets whether the checksum filters verify the data they unfilter. */
+  Status set_sm_verify_checksums(const std::string& value);
+
+  /** Sets the size above which the buffered writes of an array are flushed. */
+  Status set_sm_write_coalescing_max_bytes(const std::string& value);
+
+  /** Sets the age after which the buffered writes of an array are flushed. */
+  Status set_sm_write_coalescing_max_age_ms(const std::string& value);
+
+  /** Sets the target utilization of the user buffers of read partitions. */
+  Status set_sm_read_partition_utilization(const std::string& value);
+
   /** Sets the number of VFS threads. */
   Status set_vfs_num_threads(const std::string& value);
 
@@ -507,6 +683,18 @@ class Config {
   /** Sets the max number of allowed file:/// parallel operations. */
   Status set_vfs_file_max_parallel_ops(const std::string& value);
 
+  /** Sets whether io_uring is used for file:/// reads. */
+  Status set_vfs_file_io_uring(const std::string& value);
+
+  /** Sets the io_uring submission queue depth for file:/// reads. */
+  Status set_vfs_file_io_uring_depth(const std::string& value);
+
+  /** Sets the directory of the local disk cache of remote files. */
+  Status set_vfs_disk_cache_path(const std::string& value);
+
+  /** Sets the maximum size of the local disk cache of remote files. */
+  Status set_vfs_disk_cache_max_size(const std::string& value);
+
   /** Sets the S3 region. */
   Status set_vfs_s3_region(const std::string& value);
 
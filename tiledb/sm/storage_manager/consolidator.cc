@@ -32,12 +32,18 @@
 
 #include "tiledb/sm/storage_manager/consolidator.h"
 #include "tiledb/sm/fragment/fragment_info.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/misc/uuid.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
+#include "tiledb/sm/tile/tile.h"
 
 #include <iostream>
+#include <map>
+#include <queue>
 #include <sstream>
 
 /* ****************************** */
@@ -60,7 +66,10 @@ namespace sm {
 /* ****************************** */
 
 Consolidator::Consolidator(StorageManager* storage_manager)
-    : storage_manager_(storage_manager) {
+    : bytes_consolidated_(0)
+    , stopped_early_(false)
+    , storage_manager_(storage_manager)
+    , xlock_timed_out_(false) {
 }
 
 Consolidator::~Consolidator() = default;
@@ -77,6 +86,8 @@ Status Consolidator::consolidate(
     const Config* config) {
   // Set config parameters
   RETURN_NOT_OK(set_config(config));
+  stopped_early_ = false;
+  xlock_timed_out_ = false;
 
   URI array_uri = URI(array_name);
   EncryptionKey enc_key;
@@ -99,6 +110,26 @@ Status Consolidator::consolidate(
   return Status::Ok();
 }
 
+uint64_t Consolidator::bytes_consolidated() const {
+  return bytes_consolidated_;
+}
+
+bool Consolidator::stopped_early() const {
+  return stopped_early_;
+}
+
+void Consolidator::set_max_bytes(uint64_t max_bytes) {
+  config_.max_bytes_ = max_bytes;
+}
+
+void Consolidator::set_xlock_timeout_ms(uint64_t timeout_ms) {
+  config_.xlock_timeout_ms_ = timeout_ms;
+}
+
+bool Consolidator::xlock_timed_out() const {
+  return xlock_timed_out_;
+}
+
 /* ****************************** */
 /*        PRIVATE METHODS         */
 /* ****************************** */
@@ -147,6 +178,110 @@ bool Consolidator::are_consolidatable(
   return (double(union_cell_num) / sum_cell_num) <= config_.amplification_;
 }
 
+bool Consolidator::can_copy_tiles(
+    const Array* array_for_reads, const void* union_non_empty_domains) const {
+  auto domain = union_non_empty_domains;
+  switch (array_for_reads->array_schema()->coords_type()) {
+    case Datatype::INT32:
+      return can_copy_tiles<int>(array_for_reads, (const int*)domain);
+    case Datatype::INT64:
+      return can_copy_tiles<int64_t>(array_for_reads, (const int64_t*)domain);
+    case Datatype::INT8:
+      return can_copy_tiles<int8_t>(array_for_reads, (const int8_t*)domain);
+    case Datatype::UINT8:
+      return can_copy_tiles<uint8_t>(array_for_reads, (const uint8_t*)domain);
+    case Datatype::INT16:
+      return can_copy_tiles<int16_t>(array_for_reads, (const int16_t*)domain);
+    case Datatype::UINT16:
+      return can_copy_tiles<uint16_t>(
+          array_for_reads, (const uint16_t*)domain);
+    case Datatype::UINT32:
+      return can_copy_tiles<uint32_t>(
+          array_for_reads, (const uint32_t*)domain);
+    case Datatype::UINT64:
+      return can_copy_tiles<uint64_t>(
+          array_for_reads, (const uint64_t*)domain);
+    default:
+      return false;
+  }
+}
+
+template <class T>
+bool Consolidator::can_copy_tiles(
+    const Array* array_for_reads, const T* union_non_empty_domains) const {
+  // Applicable only to dense arrays
+  auto array_schema = array_for_reads->array_schema();
+  if (!array_schema->dense())
+    return false;
+
+  // All fragments must be dense and in the current format version
+  auto fragment_metadata = array_for_reads->fragment_metadata();
+  for (const auto& meta : fragment_metadata) {
+    if (!meta->dense() || meta->format_version() != constants::format_version)
+      return false;
+  }
+
+  // The expanded domains of the fragments must not overlap
+  auto dim_num = array_schema->dim_num();
+  auto fragment_num = fragment_metadata.size();
+  for (size_t i = 0; i < fragment_num; ++i) {
+    for (size_t j = i + 1; j < fragment_num; ++j) {
+      if (utils::geometry::overlap<T>(
+              (const T*)fragment_metadata[i]->domain(),
+              (const T*)fragment_metadata[j]->domain(),
+              dim_num))
+        return false;
+    }
+  }
+
+  // The expanded domains of the fragments must cover the union exactly
+  auto domain = array_schema->domain();
+  uint64_t tile_num = 0;
+  for (const auto& meta : fragment_metadata)
+    tile_num += domain->tile_num<T>((const T*)meta->domain());
+  if (tile_num != domain->tile_num<T>(union_non_empty_domains))
+    return false;
+
+  // The tiles must not be compressed with a dictionary. Failing to load
+  // the sections falls back to consolidating through a query, which
+  // reports the error.
+  std::vector<std::string> attributes;
+  for (const auto& attr : array_schema->attributes())
+    attributes.push_back(attr->name());
+  for (const auto& meta : fragment_metadata) {
+    auto st = meta->load_sections(
+        storage_manager_, array_for_reads->get_encryption_key(), attributes);
+    if (!st.ok())
+      return false;
+    for (const auto& attribute : attributes) {
+      if (meta->zstd_dictionary(attribute) != nullptr)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+bool Consolidator::can_merge_tiles(const Array* array_for_reads) const {
+  // All fragments must be sparse and in the current format version
+  for (const auto& meta : array_for_reads->fragment_metadata()) {
+    if (meta->dense() || meta->format_version() != constants::format_version)
+      return false;
+  }
+
+  // The new fragment must not need a zstd dictionary for any attribute
+  if (storage_manager_->config().sm_params().zstd_dictionary_size_ == 0)
+    return true;
+  for (const auto& attr : array_for_reads->array_schema()->attributes()) {
+    auto filters = attr->filters();
+    if (filters->size() != 0 &&
+        filters->get_filter(0)->type() == FilterType::FILTER_ZSTD)
+      return false;
+  }
+
+  return true;
+}
+
 Status Consolidator::consolidate(
     const ArraySchema* array_schema,
     EncryptionType encryption_type,
@@ -218,6 +353,8 @@ Status Consolidator::consolidate(
 
   // First make a pass and delete any entirely overwritten fragments
   RETURN_NOT_OK(delete_overwritten_fragments<T>(array_schema, &fragment_info));
+  if (xlock_timed_out_)
+    return Status::Ok();
 
   uint32_t step = 0;
   do {
@@ -236,6 +373,15 @@ Status Consolidator::consolidate(
     if (to_consolidate.size() <= 1)
       break;
 
+    // Stop if the step would exceed the byte budget
+    uint64_t step_bytes = 0;
+    for (const auto& f : to_consolidate)
+      step_bytes += f.fragment_size_;
+    if (step_bytes > config_.max_bytes_ - bytes_consolidated_) {
+      stopped_early_ = true;
+      break;
+    }
+
     // Consolidate the selected fragments
     URI new_fragment_uri;
     RETURN_NOT_OK(consolidate<T>(
@@ -246,6 +392,8 @@ Status Consolidator::consolidate(
         encryption_key,
         key_length,
         &new_fragment_uri));
+    if (xlock_timed_out_)
+      break;
 
     FragmentInfo new_fragment_info;
     RETURN_NOT_OK(storage_manager_->get_fragment_info(
@@ -253,11 +401,14 @@ Status Consolidator::consolidate(
 
     // Update fragment info
     update_fragment_info(to_consolidate, new_fragment_info, &fragment_info);
+    bytes_consolidated_ += step_bytes;
 
     // Advance number of steps
     ++step;
 
   } while (step < config_.steps_);
+  if (step == config_.steps_)
+    stopped_early_ = true;
 
   return Status::Ok();
 }
@@ -271,6 +422,18 @@ Status Consolidator::consolidate(
     const void* encryption_key,
     uint32_t key_length,
     URI* new_fragment_uri) {
+  // Give up before writing the new fragment if the array would not be
+  // locked exclusively to publish it
+  if (config_.xlock_timeout_ms_ != 0) {
+    bool closed = false;
+    RETURN_NOT_OK(storage_manager_->array_wait_closed_for_reads(
+        array_uri, config_.xlock_timeout_ms_, &closed));
+    if (!closed) {
+      xlock_timed_out_ = true;
+      return Status::Ok();
+    }
+  }
+
   // Open array for reading
   Array array_for_reads(array_uri, storage_manager_);
   RETURN_NOT_OK(array_for_reads.open(
@@ -292,6 +455,19 @@ Status Consolidator::consolidate(
           QueryType::WRITE, encryption_type, encryption_key, key_length),
       array_for_reads.close());
 
+  // Copy the filtered tiles verbatim, or merge the tiles of the sparse
+  // fragments directly, if the fragments permit it
+  bool copy =
+      can_copy_tiles(&array_for_reads, (const void*)union_non_empty_domains);
+  if (copy || can_merge_tiles(&array_for_reads))
+    return consolidate_tiles(
+        &array_for_reads,
+        &array_for_writes,
+        to_consolidate,
+        union_non_empty_domains,
+        !copy,
+        new_fragment_uri);
+
   // Get schema
   auto array_schema = array_for_reads.array_schema();
 
@@ -353,16 +529,22 @@ Status Consolidator::consolidate(
     return st;
   }
 
-  // Lock the array exclusively
-  st = storage_manager_->array_xlock(array_uri);
-  if (!st.ok()) {
+  // Lock the array exclusively, so that no reader sees both the new
+  // fragment and the old ones
+  bool locked = false;
+  st = xlock(array_uri, &locked);
+  if (!st.ok() || !locked) {
     storage_manager_->array_close_for_writes(array_uri);
-    storage_manager_->vfs()->remove_dir(*new_fragment_uri);
     clean_up(buffer_num, buffers, buffer_sizes, query_r, query_w);
+    bool is_dir = false;
+    auto st2 = storage_manager_->vfs()->is_dir(*new_fragment_uri, &is_dir);
+    (void)st2;  // Perhaps report this once we support an error stack
+    if (is_dir)
+      storage_manager_->vfs()->remove_dir(*new_fragment_uri);
     return st;
   }
 
-  // Finalize write query
+  // Finalize write query. This makes the new fragment visible
   st = query_w->finalize();
   if (!st.ok()) {
     storage_manager_->array_close_for_writes(array_uri);
@@ -378,9 +560,70 @@ Status Consolidator::consolidate(
 
   // Close array
   storage_manager_->array_close_for_writes(array_uri);
+
+  std::vector<URI> to_delete;
+  for (const auto& f : to_consolidate)
+    to_delete.emplace_back(f.uri_);
+
+  // Delete old fragment metadata. This makes the old fragments invisible
+  st = delete_fragment_metadata(to_delete);
   if (!st.ok()) {
+    delete_fragments(to_delete);
     storage_manager_->array_xunlock(array_uri);
     clean_up(buffer_num, buffers, buffer_sizes, query_r, query_w);
+    return st;
+  }
+
+  // Unlock the array
+  st = storage_manager_->array_xunlock(array_uri);
+  if (!st.ok()) {
+    delete_fragments(to_delete);
+    clean_up(buffer_num, buffers, buffer_sizes, query_r, query_w);
+    return st;
+  }
+
+  // Delete old fragments. The array does not need to be locked.
+  st = delete_fragments(to_delete);
+
+  // Clean up
+  clean_up(buffer_num, buffers, buffer_sizes, query_r, query_w);
+
+  return st;
+}
+
+Status Consolidator::consolidate_tiles(
+    Array* array_for_reads,
+    Array* array_for_writes,
+    const std::vector<FragmentInfo>& to_consolidate,
+    const void* union_non_empty_domains,
+    bool merge,
+    URI* new_fragment_uri) {
+  STATS_FUNC_IN(consolidator_consolidate_tiles);
+
+  // The consolidated fragment takes the timestamp of the last fragment,
+  // both in its URI and in its metadata
+  auto fragment_metadata = array_for_reads->fragment_metadata();
+  auto timestamp = fragment_metadata.back()->timestamp();
+  *new_fragment_uri = fragment_metadata.back()->fragment_uri();
+  Status st = rename_new_fragment_uri(new_fragment_uri);
+  if (!st.ok()) {
+    array_for_reads->close();
+    array_for_writes->close();
+    return st;
+  }
+
+  // Copy or merge the tiles into the new fragment
+  FragmentMetadata new_meta(
+      array_for_writes->array_schema(),
+      !merge,
+      *new_fragment_uri,
+      timestamp);
+  st = merge ?
+           merge_tiles(array_for_reads, &new_meta) :
+           copy_tiles(array_for_reads, union_non_empty_domains, &new_meta);
+  if (!st.ok()) {
+    array_for_reads->close();
+    array_for_writes->close();
     bool is_dir = false;
     auto st2 = storage_manager_->vfs()->is_dir(*new_fragment_uri, &is_dir);
     (void)st2;  // Perhaps report this once we support an error stack
@@ -389,6 +632,35 @@ Status Consolidator::consolidate(
     return st;
   }
 
+  // Close array for reading
+  st = array_for_reads->close();
+  if (!st.ok()) {
+    array_for_writes->close();
+    storage_manager_->vfs()->remove_dir(*new_fragment_uri);
+    return st;
+  }
+
+  // Lock the array exclusively, so that no reader sees both the new
+  // fragment and the old ones
+  const auto array_uri = array_for_writes->array_uri();
+  bool locked = false;
+  st = xlock(array_uri, &locked);
+  if (!st.ok() || !locked) {
+    array_for_writes->close();
+    storage_manager_->vfs()->remove_dir(*new_fragment_uri);
+    return st;
+  }
+
+  // Store the fragment metadata. This makes the new fragment visible
+  st = storage_manager_->store_fragment_metadata(
+      &new_meta, array_for_writes->get_encryption_key());
+  array_for_writes->close();
+  if (!st.ok()) {
+    storage_manager_->array_xunlock(array_uri);
+    storage_manager_->vfs()->remove_dir(*new_fragment_uri);
+    return st;
+  }
+
   std::vector<URI> to_delete;
   for (const auto& f : to_consolidate)
     to_delete.emplace_back(f.uri_);
@@ -398,7 +670,6 @@ Status Consolidator::consolidate(
   if (!st.ok()) {
     delete_fragments(to_delete);
     storage_manager_->array_xunlock(array_uri);
-    clean_up(buffer_num, buffers, buffer_sizes, query_r, query_w);
     return st;
   }
 
@@ -406,17 +677,13 @@ Status Consolidator::consolidate(
   st = storage_manager_->array_xunlock(array_uri);
   if (!st.ok()) {
     delete_fragments(to_delete);
-    clean_up(buffer_num, buffers, buffer_sizes, query_r, query_w);
     return st;
   }
 
   // Delete old fragments. The array does not need to be locked.
-  st = delete_fragments(to_delete);
+  return delete_fragments(to_delete);
 
-  // Clean up
-  clean_up(buffer_num, buffers, buffer_sizes, query_r, query_w);
-
-  return st;
+  STATS_FUNC_OUT(consolidator_consolidate_tiles);
 }
 
 Status Consolidator::copy_array(Query* query_r, Query* query_w) {
@@ -428,6 +695,802 @@ Status Consolidator::copy_array(Query* query_r, Query* query_w) {
   return Status::Ok();
 }
 
+Status Consolidator::copy_attribute_tiles(
+    const Attribute* attr,
+    const std::vector<std::pair<FragmentMetadata*, uint64_t>>& tiles,
+    FragmentMetadata* new_meta) const {
+  // For easy reference
+  const auto& attribute = attr->name();
+  auto var_size = attr->var_size();
+  auto attr_uri = new_meta->attr_uri(attribute);
+  auto attr_var_uri = var_size ? new_meta->attr_var_uri(attribute) : URI("");
+  auto tile_num = tiles.size();
+  Buffer buff, buff_var;
+
+  for (uint64_t t = 0, end = 0; t < tile_num; t = end) {
+    auto meta = tiles[t].first;
+    auto pos = tiles[t].second;
+
+    // Tiles that are adjacent in the same fragment are stored contiguously,
+    // thus they are copied in a single batch of at most the buffer size
+    uint64_t size = meta->persisted_tile_size(attribute, pos);
+    uint64_t var_size_sum =
+        var_size ? meta->persisted_tile_var_size(attribute, pos) : 0;
+    for (end = t + 1; end < tile_num; ++end) {
+      if (tiles[end].first != meta || tiles[end].second != pos + (end - t))
+        break;
+      auto next_size = meta->persisted_tile_size(attribute, tiles[end].second);
+      auto next_var_size =
+          var_size ?
+              meta->persisted_tile_var_size(attribute, tiles[end].second) :
+              0;
+      if (size + next_size > config_.buffer_size_ ||
+          var_size_sum + next_var_size > config_.buffer_size_)
+        break;
+      size += next_size;
+      var_size_sum += next_var_size;
+    }
+
+    // Copy the batch of tiles
+    RETURN_NOT_OK(storage_manager_->read(
+        meta->attr_uri(attribute),
+        meta->file_offset(attribute, pos),
+        &buff,
+        size));
+    RETURN_NOT_OK(storage_manager_->write(attr_uri, &buff));
+    if (var_size) {
+      RETURN_NOT_OK(storage_manager_->read(
+          meta->attr_var_uri(attribute),
+          meta->file_var_offset(attribute, pos),
+          &buff_var,
+          var_size_sum));
+      RETURN_NOT_OK(storage_manager_->write(attr_var_uri, &buff_var));
+    }
+
+    // Update the metadata of the new fragment
+    for (auto i = t; i < end; ++i) {
+      auto tile_pos = tiles[i].second;
+      new_meta->set_tile_offset(
+          attribute, i, meta->persisted_tile_size(attribute, tile_pos));
+      if (var_size) {
+        new_meta->set_tile_var_offset(
+            attribute, i, meta->persisted_tile_var_size(attribute, tile_pos));
+        new_meta->set_tile_var_size(
+            attribute, i, meta->tile_var_size(attribute, tile_pos));
+      }
+    }
+
+    STATS_COUNTER_ADD(consolidator_num_bytes_copied, size + var_size_sum);
+  }
+
+  STATS_COUNTER_ADD(consolidator_num_tiles_copied, tile_num);
+
+  // Close files
+  RETURN_NOT_OK(storage_manager_->close_file(attr_uri));
+  if (var_size)
+    RETURN_NOT_OK(storage_manager_->close_file(attr_var_uri));
+
+  return Status::Ok();
+}
+
+Status Consolidator::copy_tiles(
+    const Array* array_for_reads,
+    const void* union_non_empty_domains,
+    FragmentMetadata* new_meta) const {
+  auto domain = union_non_empty_domains;
+  switch (array_for_reads->array_schema()->coords_type()) {
+    case Datatype::INT32:
+      return copy_tiles<int>(array_for_reads, (const int*)domain, new_meta);
+    case Datatype::INT64:
+      return copy_tiles<int64_t>(
+          array_for_reads, (const int64_t*)domain, new_meta);
+    case Datatype::INT8:
+      return copy_tiles<int8_t>(
+          array_for_reads, (const int8_t*)domain, new_meta);
+    case Datatype::UINT8:
+      return copy_tiles<uint8_t>(
+          array_for_reads, (const uint8_t*)domain, new_meta);
+    case Datatype::INT16:
+      return copy_tiles<int16_t>(
+          array_for_reads, (const int16_t*)domain, new_meta);
+    case Datatype::UINT16:
+      return copy_tiles<uint16_t>(
+          array_for_reads, (const uint16_t*)domain, new_meta);
+    case Datatype::UINT32:
+      return copy_tiles<uint32_t>(
+          array_for_reads, (const uint32_t*)domain, new_meta);
+    case Datatype::UINT64:
+      return copy_tiles<uint64_t>(
+          array_for_reads, (const uint64_t*)domain, new_meta);
+    default:
+      return LOG_STATUS(
+          Status::ConsolidatorError("Cannot copy tiles; Invalid domain type"));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Consolidator::copy_tiles(
+    const Array* array_for_reads,
+    const T* union_non_empty_domains,
+    FragmentMetadata* new_meta) const {
+  // For easy reference
+  auto array_schema = array_for_reads->array_schema();
+  auto domain = array_schema->domain();
+  auto dim_num = array_schema->dim_num();
+  auto fragment_metadata = array_for_reads->fragment_metadata();
+  auto fragment_num = fragment_metadata.size();
+
+  // Compute the tile domains of the fragments
+  std::vector<std::vector<T>> frag_tile_domains(fragment_num);
+  for (size_t f = 0; f < fragment_num; ++f) {
+    frag_tile_domains[f].resize(2 * dim_num);
+    domain->get_tile_domain(
+        (const T*)fragment_metadata[f]->domain(), &frag_tile_domains[f][0]);
+  }
+
+  // Find the source fragment and position of every tile of the new
+  // fragment, following the global tile order
+  std::vector<T> tile_domain(2 * dim_num);
+  domain->get_tile_domain(union_non_empty_domains, &tile_domain[0]);
+  std::vector<T> tile_coords(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d)
+    tile_coords[d] = tile_domain[2 * d];
+  auto tile_num = domain->tile_num<T>(union_non_empty_domains);
+  std::vector<std::pair<FragmentMetadata*, uint64_t>> tiles;
+  tiles.reserve(tile_num);
+  for (uint64_t t = 0; t < tile_num; ++t) {
+    size_t f = 0;
+    for (; f < fragment_num; ++f) {
+      if (utils::geometry::coords_in_rect<T>(
+              &tile_coords[0], &frag_tile_domains[f][0], dim_num))
+        break;
+    }
+    if (f == fragment_num)
+      return LOG_STATUS(Status::ConsolidatorError(
+          "Cannot copy tiles; Tile is not covered by any fragment"));
+    tiles.emplace_back(
+        fragment_metadata[f],
+        fragment_metadata[f]->get_tile_pos<T>(&tile_coords[0]));
+    domain->get_next_tile_coords<T>(&tile_domain[0], &tile_coords[0]);
+  }
+
+  // Load the fragment metadata of all attributes
+  std::vector<std::string> attributes;
+  for (const auto& attr : array_schema->attributes())
+    attributes.push_back(attr->name());
+  for (auto meta : fragment_metadata)
+    RETURN_NOT_OK(meta->load_sections(
+        storage_manager_, array_for_reads->get_encryption_key(), attributes));
+
+  // Create the new fragment
+  RETURN_NOT_OK(new_meta->init(union_non_empty_domains));
+  RETURN_NOT_OK(new_meta->set_num_tiles(tile_num));
+  RETURN_NOT_OK(storage_manager_->create_dir(new_meta->fragment_uri()));
+
+  // Copy the tiles of each attribute in parallel
+  std::vector<std::future<Status>> tasks;
+  auto thread_pool = storage_manager_->thread_pool();
+  for (const auto& attr : array_schema->attributes()) {
+    tasks.push_back(thread_pool->enqueue([&, attr]() {
+      return copy_attribute_tiles(attr, tiles, new_meta);
+    }));
+  }
+
+  // Wait for the copies and check all statuses
+  auto statuses = thread_pool->wait_all_status(tasks);
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  return Status::Ok();
+}
+
+Status Consolidator::filter_tile(
+    const Array* array, const FilterPipeline* filters, Tile* tile) const {
+  auto orig_size = tile->buffer()->size();
+
+  // Get a copy of the filter pipeline and append an encryption filter when
+  // necessary.
+  FilterPipeline pipeline = *filters;
+  RETURN_NOT_OK(FilterPipeline::append_encryption_filter(
+      &pipeline, array->get_encryption_key()));
+
+  RETURN_NOT_OK(pipeline.run_forward(tile, storage_manager_->thread_pool()));
+
+  tile->set_filtered(true);
+  tile->set_pre_filtered_size(orig_size);
+
+  return Status::Ok();
+}
+
+Status Consolidator::merge_tiles(
+    const Array* array_for_reads, FragmentMetadata* new_meta) const {
+  switch (array_for_reads->array_schema()->coords_type()) {
+    case Datatype::INT32:
+      return merge_tiles<int>(array_for_reads, new_meta);
+    case Datatype::INT64:
+      return merge_tiles<int64_t>(array_for_reads, new_meta);
+    case Datatype::INT8:
+      return merge_tiles<int8_t>(array_for_reads, new_meta);
+    case Datatype::UINT8:
+      return merge_tiles<uint8_t>(array_for_reads, new_meta);
+    case Datatype::INT16:
+      return merge_tiles<int16_t>(array_for_reads, new_meta);
+    case Datatype::UINT16:
+      return merge_tiles<uint16_t>(array_for_reads, new_meta);
+    case Datatype::UINT32:
+      return merge_tiles<uint32_t>(array_for_reads, new_meta);
+    case Datatype::UINT64:
+      return merge_tiles<uint64_t>(array_for_reads, new_meta);
+    case Datatype::FLOAT32:
+      return merge_tiles<float>(array_for_reads, new_meta);
+    case Datatype::FLOAT64:
+      return merge_tiles<double>(array_for_reads, new_meta);
+    default:
+      return LOG_STATUS(
+          Status::ConsolidatorError("Cannot merge tiles; Invalid domain type"));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Consolidator::merge_tiles(
+    const Array* array_for_reads, FragmentMetadata* new_meta) const {
+  STATS_FUNC_IN(consolidator_merge_tiles);
+
+  // For easy reference
+  auto array_schema = array_for_reads->array_schema();
+  auto domain = array_schema->domain();
+  auto dim_num = array_schema->dim_num();
+  auto capacity = array_schema->capacity();
+  auto fragment_metadata = array_for_reads->fragment_metadata();
+  auto fragment_num = (unsigned)fragment_metadata.size();
+  auto thread_pool = storage_manager_->thread_pool();
+
+  // Load the fragment metadata of all attributes and dimensions
+  std::vector<std::string> attributes;
+  for (const auto& attr : array_schema->attributes())
+    attributes.push_back(attr->name());
+  for (auto meta : fragment_metadata)
+    RETURN_NOT_OK(meta->load_sections(
+        storage_manager_, array_for_reads->get_encryption_key(), attributes));
+
+  // Create the new fragment. Its non-empty domain is computed from the MBRs.
+  RETURN_NOT_OK(new_meta->init(domain->domain()));
+  RETURN_NOT_OK(storage_manager_->create_dir(new_meta->fragment_uri()));
+
+  // Read the first coordinates tile of every fragment
+  std::vector<std::vector<T>> coords(fragment_num);
+  std::vector<uint64_t> tile_idx(fragment_num, 0);
+  std::vector<uint64_t> cell_idx(fragment_num, 0);
+  auto statuses = parallel_for(thread_pool, 0, fragment_num, [&](uint64_t f) {
+    if (fragment_metadata[f]->tile_num() == 0)
+      return Status::Ok();
+    return read_coords_tile<T>(
+        array_for_reads, fragment_metadata[f], 0, &coords[f]);
+  });
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // The heap holds the fragments that have cells left, with the fragment
+  // whose next cell comes first in the global order on top. Among cells
+  // with the same coordinates, the cell of the latest fragment comes first.
+  auto cmp = [&](const T* a, const T* b) {
+    auto tile_cmp = domain->tile_order_cmp<T>(a, b);
+    return (tile_cmp != 0) ? tile_cmp : domain->cell_order_cmp<T>(a, b);
+  };
+  auto next_coords = [&](unsigned f) {
+    return &coords[f][cell_idx[f] * dim_num];
+  };
+  auto heap_cmp = [&](unsigned a, unsigned b) {
+    auto coords_cmp = cmp(next_coords(a), next_coords(b));
+    return (coords_cmp != 0) ? coords_cmp > 0 : a < b;
+  };
+  std::priority_queue<unsigned, std::vector<unsigned>, decltype(heap_cmp)>
+      heap(heap_cmp);
+  for (unsigned f = 0; f < fragment_num; ++f) {
+    if (!coords[f].empty())
+      heap.push(f);
+  }
+
+  // Moves a fragment past the cells with the input coordinates, reading
+  // its next coordinates tiles when needed
+  auto advance = [&](unsigned f, const T* skip_coords) {
+    do {
+      if (++cell_idx[f] * dim_num == coords[f].size()) {
+        cell_idx[f] = 0;
+        if (++tile_idx[f] == fragment_metadata[f]->tile_num())
+          return Status::Ok();
+        RETURN_NOT_OK(read_coords_tile<T>(
+            array_for_reads, fragment_metadata[f], tile_idx[f], &coords[f]));
+      }
+    } while (cmp(next_coords(f), skip_coords) == 0);
+    heap.push(f);
+    return Status::Ok();
+  };
+
+  // Merge the cells, writing them in batches of full tiles whose
+  // coordinates take about the buffer size
+  uint64_t batch_cell_num =
+      capacity *
+      MAX(1, config_.buffer_size_ / (capacity * array_schema->coords_size()));
+  std::vector<MergedCell> cells;
+  std::vector<T> merged_coords;
+  std::vector<T> c(dim_num);
+  cells.reserve(batch_cell_num);
+  merged_coords.reserve(batch_cell_num * dim_num);
+  uint64_t merged_cell_num = 0;
+  while (!heap.empty()) {
+    auto f = heap.top();
+    heap.pop();
+    std::memcpy(&c[0], next_coords(f), dim_num * sizeof(T));
+    cells.push_back({f, tile_idx[f], cell_idx[f]});
+    merged_coords.insert(merged_coords.end(), c.begin(), c.end());
+
+    // Only the first cell with some coordinates in the latest fragment
+    // that has them is kept, thus skip the cells with the same
+    // coordinates in this and earlier fragments
+    while (!heap.empty() && cmp(next_coords(heap.top()), &c[0]) == 0) {
+      auto dup = heap.top();
+      heap.pop();
+      RETURN_NOT_OK(advance(dup, &c[0]));
+    }
+    RETURN_NOT_OK(advance(f, &c[0]));
+
+    if (cells.size() == batch_cell_num || heap.empty()) {
+      RETURN_NOT_OK(write_merged_tiles<T>(
+          array_for_reads, cells, merged_coords, new_meta));
+      merged_cell_num += cells.size();
+      cells.clear();
+      merged_coords.clear();
+    }
+  }
+
+  STATS_COUNTER_ADD(consolidator_num_cells_merged, merged_cell_num);
+
+  // Close files
+  for (unsigned d = 0; d < dim_num; ++d)
+    RETURN_NOT_OK(storage_manager_->close_file(
+        new_meta->attr_uri(FragmentMetadata::coords_dim_name(d))));
+  for (const auto& attr : array_schema->attributes()) {
+    RETURN_NOT_OK(
+        storage_manager_->close_file(new_meta->attr_uri(attr->name())));
+    if (attr->var_size())
+      RETURN_NOT_OK(
+          storage_manager_->close_file(new_meta->attr_var_uri(attr->name())));
+  }
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(consolidator_merge_tiles);
+}
+
+template <class T>
+Status Consolidator::read_coords_tile(
+    const Array* array_for_reads,
+    const FragmentMetadata* meta,
+    uint64_t tile_pos,
+    std::vector<T>* coords) const {
+  // For easy reference
+  auto array_schema = array_for_reads->array_schema();
+  auto coords_type = array_schema->coords_type();
+  auto dim_num = array_schema->dim_num();
+  auto cell_num = meta->cell_num(tile_pos);
+  auto buffer_pool = storage_manager_->buffer_pool();
+  coords->resize(cell_num * dim_num);
+
+  // Read and unfilter the tile of each dimension, zipping its values
+  auto statuses = parallel_for(
+      storage_manager_->thread_pool(), 0, dim_num, [&](uint64_t d) {
+        auto dim_name = FragmentMetadata::coords_dim_name(d);
+        auto persisted_size = meta->persisted_tile_size(dim_name, tile_pos);
+        Tile tile;
+        RETURN_NOT_OK(tile.init(
+            meta->format_version(),
+            coords_type,
+            persisted_size,
+            sizeof(T),
+            0,
+            buffer_pool));
+        tile.buffer()->set_size(persisted_size);
+        RETURN_NOT_OK(storage_manager_->vfs()->read(
+            meta->attr_uri(dim_name),
+            meta->file_offset(dim_name, tile_pos),
+            tile.data(),
+            persisted_size));
+        RETURN_NOT_OK(unfilter_tile(
+            array_for_reads,
+            array_schema->coords_filters(d),
+            nullptr,
+            &tile));
+        if (tile.size() != cell_num * sizeof(T))
+          return LOG_STATUS(Status::ConsolidatorError(
+              "Cannot read coordinates tile; Unexpected tile size"));
+        auto data = (const T*)tile.data();
+        for (uint64_t i = 0; i < cell_num; ++i)
+          (*coords)[i * dim_num + d] = data[i];
+        return Status::Ok();
+      });
+
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  return Status::Ok();
+}
+
+Status Consolidator::read_tiles(
+    const Array* array_for_reads,
+    const Attribute* attr,
+    const std::vector<std::pair<FragmentMetadata*, uint64_t>>& tiles,
+    std::vector<Tile>* attr_tiles,
+    std::vector<Tile>* attr_var_tiles) const {
+  // For easy reference
+  const auto& attribute = attr->name();
+  auto var_size = attr->var_size();
+  auto type = attr->type();
+  auto buffer_pool = storage_manager_->buffer_pool();
+  auto tile_num = tiles.size();
+  attr_tiles->resize(tile_num);
+  if (var_size)
+    attr_var_tiles->resize(tile_num);
+
+  // Populate the list of regions per file to be read
+  std::map<URI, std::vector<std::tuple<uint64_t, void*, uint64_t>>> regions;
+  for (uint64_t i = 0; i < tile_num; ++i) {
+    auto meta = tiles[i].first;
+    auto pos = tiles[i].second;
+    auto format_version = meta->format_version();
+    auto& tile = (*attr_tiles)[i];
+    auto size = meta->persisted_tile_size(attribute, pos);
+    if (!var_size) {
+      RETURN_NOT_OK(tile.init(
+          format_version, type, size, attr->cell_size(), 0, buffer_pool));
+    } else {
+      RETURN_NOT_OK(tile.init(
+          format_version,
+          constants::cell_var_offset_type,
+          size,
+          constants::cell_var_offset_size,
+          0,
+          buffer_pool));
+    }
+    tile.buffer()->set_size(size);
+    regions[meta->attr_uri(attribute)].emplace_back(
+        meta->file_offset(attribute, pos), tile.data(), size);
+
+    if (var_size) {
+      auto& tile_var = (*attr_var_tiles)[i];
+      auto var_size_persisted = meta->persisted_tile_var_size(attribute, pos);
+      RETURN_NOT_OK(tile_var.init(
+          format_version,
+          type,
+          var_size_persisted,
+          datatype_size(type),
+          0,
+          buffer_pool));
+      tile_var.buffer()->set_size(var_size_persisted);
+      regions[meta->attr_var_uri(attribute)].emplace_back(
+          meta->file_var_offset(attribute, pos),
+          tile_var.data(),
+          var_size_persisted);
+    }
+  }
+
+  // Read the regions of each file in parallel
+  std::vector<std::future<Status>> tasks;
+  auto thread_pool = storage_manager_->thread_pool();
+  for (const auto& item : regions) {
+    const auto& uri = item.first;
+    const auto& file_regions = item.second;
+    tasks.push_back(thread_pool->enqueue([&, uri]() {
+      return storage_manager_->vfs()->read_all(uri, file_regions);
+    }));
+  }
+  auto statuses = thread_pool->wait_all_status(tasks);
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // Unfilter the tiles in parallel
+  statuses = parallel_for(thread_pool, 0, tile_num, [&](uint64_t i) {
+    auto meta = tiles[i].first;
+    auto dict = meta->zstd_dictionary(attribute);
+    if (!var_size)
+      return unfilter_tile(
+          array_for_reads, attr->filters(), dict, &(*attr_tiles)[i]);
+    RETURN_NOT_OK(unfilter_tile(
+        array_for_reads,
+        array_for_reads->array_schema()->cell_var_offsets_filters(),
+        nullptr,
+        &(*attr_tiles)[i]));
+    return unfilter_tile(
+        array_for_reads, attr->filters(), dict, &(*attr_var_tiles)[i]);
+  });
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  return Status::Ok();
+}
+
+Status Consolidator::unfilter_tile(
+    const Array* array,
+    const FilterPipeline* filters,
+    const std::shared_ptr<ZStdDictionary>& zstd_dictionary,
+    Tile* tile) const {
+  uint64_t orig_size = tile->buffer()->size();
+
+  // Get a copy of the filter pipeline and append an encryption filter when
+  // necessary.
+  FilterPipeline pipeline = *filters;
+  if (zstd_dictionary != nullptr)
+    pipeline.set_zstd_dictionary(zstd_dictionary);
+  pipeline.set_verify_checksums(
+      storage_manager_->config().sm_params().verify_checksums_);
+  RETURN_NOT_OK(FilterPipeline::append_encryption_filter(
+      &pipeline, array->get_encryption_key()));
+
+  RETURN_NOT_OK(pipeline.run_reverse(tile, storage_manager_->thread_pool()));
+
+  tile->set_filtered(true);
+  tile->set_pre_filtered_size(orig_size);
+
+  return Status::Ok();
+}
+
+Status Consolidator::write_merged_attribute(
+    const Array* array_for_reads,
+    const Attribute* attr,
+    const std::vector<std::pair<FragmentMetadata*, uint64_t>>& tiles,
+    const std::vector<std::pair<uint64_t, uint64_t>>& cells,
+    FragmentMetadata* new_meta) const {
+  // For easy reference
+  const auto& attribute = attr->name();
+  auto var_size = attr->var_size();
+  auto type = attr->type();
+  auto cell_size =
+      var_size ? constants::cell_var_offset_size : attr->cell_size();
+  auto capacity = array_for_reads->array_schema()->capacity();
+  auto buffer_pool = storage_manager_->buffer_pool();
+  auto cell_num = (uint64_t)cells.size();
+  auto tile_num = utils::math::ceil(cell_num, capacity);
+
+  // Read the tiles the cells come from
+  std::vector<Tile> attr_tiles, attr_var_tiles;
+  RETURN_NOT_OK(read_tiles(
+      array_for_reads, attr, tiles, &attr_tiles, &attr_var_tiles));
+
+  // Gather the cells into the new tiles and filter them in parallel. Runs
+  // of consecutive cells of the same tile are copied at once.
+  std::vector<Tile> new_tiles(tile_num);
+  std::vector<Tile> new_var_tiles(var_size ? tile_num : 0);
+  auto statuses = parallel_for(
+      storage_manager_->thread_pool(), 0, tile_num, [&](uint64_t t) {
+        auto start = t * capacity;
+        auto end = std::min(start + capacity, cell_num);
+        auto& tile = new_tiles[t];
+        RETURN_NOT_OK(tile.init(
+            constants::format_version,
+            var_size ? constants::cell_var_offset_type : type,
+            (end - start) * cell_size,
+            cell_size,
+            0,
+            buffer_pool));
+        if (var_size)
+          RETURN_NOT_OK(new_var_tiles[t].init(
+              constants::format_version,
+              type,
+              (end - start) * datatype_size(type),
+              datatype_size(type),
+              0,
+              buffer_pool));
+
+        for (uint64_t i = start, run_end; i < end; i = run_end) {
+          auto src = cells[i].first;
+          auto cell = cells[i].second;
+          for (run_end = i + 1; run_end < end; ++run_end) {
+            if (cells[run_end].first != src ||
+                cells[run_end].second != cell + (run_end - i))
+              break;
+          }
+          auto run_num = run_end - i;
+          auto src_data = (const char*)attr_tiles[src].data();
+          if (!var_size) {
+            RETURN_NOT_OK(
+                tile.write(src_data + cell * cell_size, run_num * cell_size));
+            continue;
+          }
+
+          // The offsets of the new tile start from zero
+          auto src_offsets = (const uint64_t*)src_data;
+          auto src_cell_num = attr_tiles[src].size() / cell_size;
+          auto& tile_var = new_var_tiles[t];
+          auto run_begin = src_offsets[cell];
+          auto run_finish = (cell + run_num < src_cell_num) ?
+                                src_offsets[cell + run_num] :
+                                attr_var_tiles[src].size();
+          for (uint64_t j = 0; j < run_num; ++j) {
+            uint64_t offset =
+                tile_var.size() + src_offsets[cell + j] - run_begin;
+            RETURN_NOT_OK(tile.write(&offset, sizeof(offset)));
+          }
+          RETURN_NOT_OK(tile_var.write(
+              (const char*)attr_var_tiles[src].data() + run_begin,
+              run_finish - run_begin));
+        }
+
+        if (var_size) {
+          RETURN_NOT_OK(filter_tile(
+              array_for_reads,
+              array_for_reads->array_schema()->cell_var_offsets_filters(),
+              &tile));
+          return filter_tile(
+              array_for_reads, attr->filters(), &new_var_tiles[t]);
+        }
+        return filter_tile(array_for_reads, attr->filters(), &tile);
+      });
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // Write the new tiles
+  auto attr_uri = new_meta->attr_uri(attribute);
+  auto attr_var_uri = var_size ? new_meta->attr_var_uri(attribute) : URI("");
+  for (uint64_t t = 0; t < tile_num; ++t) {
+    RETURN_NOT_OK(storage_manager_->write(attr_uri, new_tiles[t].buffer()));
+    new_meta->set_tile_offset(attribute, t, new_tiles[t].buffer()->size());
+    if (var_size) {
+      auto& tile_var = new_var_tiles[t];
+      RETURN_NOT_OK(storage_manager_->write(attr_var_uri, tile_var.buffer()));
+      new_meta->set_tile_var_offset(
+          attribute, t, tile_var.buffer()->size());
+      new_meta->set_tile_var_size(
+          attribute, t, tile_var.pre_filtered_size());
+    }
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Consolidator::write_merged_coords(
+    const Array* array_for_reads,
+    unsigned dim,
+    const std::vector<T>& coords,
+    FragmentMetadata* new_meta) const {
+  // For easy reference
+  auto array_schema = array_for_reads->array_schema();
+  auto coords_type = array_schema->coords_type();
+  auto dim_num = array_schema->dim_num();
+  auto capacity = array_schema->capacity();
+  auto buffer_pool = storage_manager_->buffer_pool();
+  auto cell_num = (uint64_t)coords.size() / dim_num;
+  auto tile_num = utils::math::ceil(cell_num, capacity);
+
+  // Gather the values of the dimension into the new tiles and filter them
+  // in parallel
+  std::vector<Tile> new_tiles(tile_num);
+  auto statuses = parallel_for(
+      storage_manager_->thread_pool(), 0, tile_num, [&](uint64_t t) {
+        auto start = t * capacity;
+        auto end = std::min(start + capacity, cell_num);
+        auto& tile = new_tiles[t];
+        RETURN_NOT_OK(tile.init(
+            constants::format_version,
+            coords_type,
+            (end - start) * sizeof(T),
+            sizeof(T),
+            0,
+            buffer_pool));
+        auto data = (T*)tile.data();
+        for (uint64_t i = start; i < end; ++i)
+          data[i - start] = coords[i * dim_num + dim];
+        tile.buffer()->set_size((end - start) * sizeof(T));
+        return filter_tile(
+            array_for_reads, array_schema->coords_filters(dim), &tile);
+      });
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // Write the new tiles
+  auto dim_name = FragmentMetadata::coords_dim_name(dim);
+  auto dim_uri = new_meta->attr_uri(dim_name);
+  for (uint64_t t = 0; t < tile_num; ++t) {
+    RETURN_NOT_OK(storage_manager_->write(dim_uri, new_tiles[t].buffer()));
+    new_meta->set_tile_offset(dim_name, t, new_tiles[t].buffer()->size());
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Consolidator::write_merged_tiles(
+    const Array* array_for_reads,
+    const std::vector<MergedCell>& cells,
+    const std::vector<T>& coords,
+    FragmentMetadata* new_meta) const {
+  // For easy reference
+  auto array_schema = array_for_reads->array_schema();
+  auto dim_num = array_schema->dim_num();
+  auto coords_size = array_schema->coords_size();
+  auto capacity = array_schema->capacity();
+  auto fragment_metadata = array_for_reads->fragment_metadata();
+  auto fragment_num = fragment_metadata.size();
+  auto cell_num = (uint64_t)cells.size();
+  auto tile_num = utils::math::ceil(cell_num, capacity);
+  auto tile_index_base = new_meta->tile_index_base();
+  RETURN_NOT_OK(new_meta->set_num_tiles(tile_index_base + tile_num));
+
+  // Set the MBRs and bounding coordinates of the new tiles
+  std::vector<T> mbr(2 * dim_num);
+  std::vector<T> bcoords(2 * dim_num);
+  for (uint64_t t = 0; t < tile_num; ++t) {
+    auto start = t * capacity;
+    auto end = std::min(start + capacity, cell_num);
+    auto data = &coords[start * dim_num];
+    for (unsigned d = 0; d < dim_num; ++d) {
+      mbr[2 * d] = data[d];
+      mbr[2 * d + 1] = data[d];
+    }
+    for (uint64_t i = 1; i < end - start; ++i)
+      utils::geometry::expand_mbr(&mbr[0], &data[i * dim_num], dim_num);
+    RETURN_NOT_OK(new_meta->set_mbr(t, &mbr[0]));
+
+    std::memcpy(&bcoords[0], data, coords_size);
+    std::memcpy(
+        &bcoords[dim_num], &data[(end - start - 1) * dim_num], coords_size);
+    new_meta->set_bounding_coords(t, &bcoords[0]);
+  }
+  new_meta->set_last_tile_cell_num(cell_num - (tile_num - 1) * capacity);
+
+  // Find the tiles the cells come from. Each fragment contributes a range
+  // of consecutive tiles, since its cells are merged in order.
+  std::vector<uint64_t> first_tile(fragment_num, 0);
+  std::vector<uint64_t> end_tile(fragment_num, 0);
+  for (auto it = cells.rbegin(); it != cells.rend(); ++it)
+    first_tile[it->fragment_idx_] = it->tile_idx_;
+  for (const auto& cell : cells)
+    end_tile[cell.fragment_idx_] = cell.tile_idx_ + 1;
+  std::vector<std::pair<FragmentMetadata*, uint64_t>> tiles;
+  std::vector<uint64_t> tiles_start(fragment_num);
+  for (size_t f = 0; f < fragment_num; ++f) {
+    tiles_start[f] = tiles.size();
+    for (auto t = first_tile[f]; t < end_tile[f]; ++t)
+      tiles.emplace_back(fragment_metadata[f], t);
+  }
+  std::vector<std::pair<uint64_t, uint64_t>> tile_cells;
+  tile_cells.reserve(cell_num);
+  for (const auto& cell : cells) {
+    auto f = cell.fragment_idx_;
+    tile_cells.emplace_back(
+        tiles_start[f] + cell.tile_idx_ - first_tile[f], cell.cell_idx_);
+  }
+
+  // Write the dimensions and attributes in parallel
+  std::vector<std::future<Status>> tasks;
+  auto thread_pool = storage_manager_->thread_pool();
+  for (unsigned d = 0; d < dim_num; ++d) {
+    tasks.push_back(thread_pool->enqueue([&, d]() {
+      return write_merged_coords<T>(array_for_reads, d, coords, new_meta);
+    }));
+  }
+  for (const auto& attr : array_schema->attributes()) {
+    tasks.push_back(thread_pool->enqueue([&, attr]() {
+      return write_merged_attribute(
+          array_for_reads, attr, tiles, tile_cells, new_meta);
+    }));
+  }
+
+  // Wait for the writes and check all statuses
+  auto statuses = thread_pool->wait_all_status(tasks);
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // Increment the tile index base for the next batch
+  new_meta->set_tile_index_base(tile_index_base + tile_num);
+
+  return Status::Ok();
+}
+
 void Consolidator::clean_up(
     unsigned buffer_num,
     void** buffers,
@@ -574,9 +1637,16 @@ Status Consolidator::delete_overwritten_fragments(
     }
   }
 
+  // Nothing to delete
+  if (to_delete.empty())
+    return Status::Ok();
+
   // Lock the array exclusively
   const auto& array_uri = array_schema->array_uri();
-  RETURN_NOT_OK(storage_manager_->array_xlock(array_uri));
+  bool locked = false;
+  RETURN_NOT_OK(xlock(array_uri, &locked));
+  if (!locked)
+    return Status::Ok();
 
   // Delete the fragment metadata
   RETURN_NOT_OK_ELSE(
@@ -662,6 +1732,10 @@ Status Consolidator::compute_next_to_consolidate(
       } else if (i + j >= col_num) {  // Non-valid entries
         m_sizes[i][j] = UINT64_MAX;
         m_union[i][j].clear();
+      } else if (m_sizes[i - 1][j] == UINT64_MAX) {  // Invalid prefix
+        m_sizes[i][j] = UINT64_MAX;
+        m_union[i][j].clear();
+        m_union[i][j].shrink_to_fit();
       } else {  // Every other row is computed using the previous row
         auto ratio = (float)fragments[i + j - 1].fragment_size_ /
                      fragments[i + j].fragment_size_;
@@ -834,5 +1908,19 @@ Status Consolidator::set_config(const Config* config) {
   return Status::Ok();
 }
 
+Status Consolidator::xlock(const URI& array_uri, bool* locked) {
+  if (config_.xlock_timeout_ms_ == 0) {
+    *locked = true;
+    return storage_manager_->array_xlock(array_uri);
+  }
+
+  RETURN_NOT_OK(storage_manager_->array_xlock(
+      array_uri, config_.xlock_timeout_ms_, locked));
+  if (!*locked)
+    xlock_timed_out_ = true;
+
+  return Status::Ok();
+}
+
 }  // namespace sm
 }  // namespace tiledb
@@ -37,15 +37,24 @@
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/storage_manager/open_array.h"
 
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace tiledb {
 namespace sm {
 
 class ArraySchema;
+class Attribute;
+class FilterPipeline;
+class FragmentMetadata;
 class Query;
 class StorageManager;
+class Tile;
 class URI;
+class ZStdDictionary;
 
 /** Handles array consolidation. */
 class Consolidator {
@@ -82,6 +91,16 @@ class Consolidator {
      * consolidation.
      */
     float size_ratio_;
+    /**
+     * Maximum total size (in bytes) of the fragments rewritten in a
+     * single consolidation invocation.
+     */
+    uint64_t max_bytes_;
+    /**
+     * Maximum time (in ms) to wait for the exclusive lock of the array.
+     * 0 means waiting indefinitely.
+     */
+    uint64_t xlock_timeout_ms_;
 
     /** Constructor. */
     ConsolidationConfig() {
@@ -91,9 +110,21 @@ class Consolidator {
       min_frags_ = constants::consolidation_step_min_frags;
       max_frags_ = constants::consolidation_step_max_frags;
       size_ratio_ = constants::consolidation_step_size_ratio;
+      max_bytes_ = std::numeric_limits<uint64_t>::max();
+      xlock_timeout_ms_ = 0;
     }
   };
 
+  /** A cell of a fragment to be consolidated, as picked by `merge_tiles`. */
+  struct MergedCell {
+    /** The position of the fragment in the opened array. */
+    unsigned fragment_idx_;
+    /** The position of the tile in the fragment. */
+    uint64_t tile_idx_;
+    /** The position of the cell in the tile. */
+    uint64_t cell_idx_;
+  };
+
   /* ********************************* */
   /*     CONSTRUCTORS & DESTRUCTORS    */
   /* ********************************* */
@@ -131,17 +162,62 @@ class Consolidator {
       uint32_t key_length,
       const Config* config);
 
+  /**
+   * Returns the total size (in bytes) of the fragments rewritten by
+   * `consolidate`.
+   */
+  uint64_t bytes_consolidated() const;
+
+  /**
+   * Sets the maximum total size (in bytes) of the fragments that
+   * `consolidate` may rewrite. Consolidation stops before the first step
+   * that would exceed it.
+   */
+  void set_max_bytes(uint64_t max_bytes);
+
+  /**
+   * Sets the maximum time (in ms) to wait for the exclusive lock of the
+   * array, which cannot be taken while the array is open for reads in the
+   * same context. Upon timeout, `consolidate` stops before the step that
+   * needed the lock, leaving the array unchanged by that step. Steps check
+   * that the array is closed for reads before writing the consolidated
+   * fragment, so that they rarely time out after writing it.
+   */
+  void set_xlock_timeout_ms(uint64_t timeout_ms);
+
+  /**
+   * Returns `true` if the last `consolidate` stopped before a step that
+   * would exceed the maximum bytes (see `set_max_bytes`) or after the
+   * configured number of steps, possibly leaving fragments to consolidate.
+   */
+  bool stopped_early() const;
+
+  /**
+   * Returns `true` if the last `consolidate` stopped because it timed out
+   * waiting for the exclusive lock of the array.
+   */
+  bool xlock_timed_out() const;
+
  private:
   /* ********************************* */
   /*        PRIVATE ATTRIBUTES         */
   /* ********************************* */
 
+  /** Total size of the fragments rewritten by `consolidate`. */
+  uint64_t bytes_consolidated_;
+
   /** Connsolidation configuration parameters. */
   ConsolidationConfig config_;
 
+  /** `true` if `consolidate` stopped at the maximum bytes or steps. */
+  bool stopped_early_;
+
   /** The storage manager. */
   StorageManager* storage_manager_;
 
+  /** `true` if `consolidate` timed out waiting for the exclusive lock. */
+  bool xlock_timed_out_;
+
   /* ********************************* */
   /*          PRIVATE METHODS           */
   /* ********************************* */
@@ -185,6 +261,50 @@ class Consolidator {
       const T* union_non_empty_domains,
       unsigned dim_num) const;
 
+  /**
+   * Checks if the fragments opened in `array_for_reads` can be consolidated
+   * by copying their filtered tiles verbatim into the new fragment, i.e.,
+   * without reading them through a query and filtering them again. This
+   * is the case if the array is dense, all the fragments are dense and
+   * in the current format version, and their expanded non-empty domains
+   * do not overlap and exactly cover `union_non_empty_domains`. Moreover,
+   * no attribute of the fragments may be compressed with a zstd
+   * dictionary, since each fragment has its own dictionary whereas the
+   * new fragment can only have one per attribute. This loads the metadata
+   * sections of the attributes of the fragments.
+   *
+   * @param array_for_reads The array opened for reading the fragments
+   *     to be consolidated.
+   * @param union_non_empty_domains The (expanded) union of the non-empty
+   *     domains of the fragments to be consolidated.
+   * @return `True` if the tiles can be copied verbatim.
+   */
+  bool can_copy_tiles(
+      const Array* array_for_reads, const void* union_non_empty_domains) const;
+
+  /**
+   * Same as `can_copy_tiles` above, templated on the domain type.
+   *
+   * @tparam T The domain type.
+   */
+  template <class T>
+  bool can_copy_tiles(
+      const Array* array_for_reads, const T* union_non_empty_domains) const;
+
+  /**
+   * Checks if the fragments opened in `array_for_reads` can be consolidated
+   * by merging their tiles directly (see `merge_tiles`), i.e., without
+   * reading and writing them through queries. This is the case if all the
+   * fragments are sparse and in the current format version, and the new
+   * fragment would not compress any attribute with a zstd dictionary,
+   * which only the writer trains.
+   *
+   * @param array_for_reads The array opened for reading the fragments
+   *     to be consolidated.
+   * @return `True` if the tiles can be merged directly.
+   */
+  bool can_merge_tiles(const Array* array_for_reads) const;
+
   /**
    * Consolidates the fragments of the input array.
    *
@@ -248,6 +368,33 @@ class Consolidator {
       uint32_t key_length,
       URI* new_fragment_uri);
 
+  /**
+   * Consolidates the fragments opened in `array_for_reads` by copying
+   * their filtered tiles verbatim into a new fragment (see
+   * `can_copy_tiles`), or by merging their tiles into a new sparse
+   * fragment (see `can_merge_tiles`). It then makes the new fragment
+   * visible and deletes the consolidated fragments. Both arrays are closed
+   * by this function.
+   *
+   * @param array_for_reads The opened array for reading the fragments
+   *     to be consolidated.
+   * @param array_for_writes The opened array for writing the
+   *     consolidated fragment.
+   * @param to_consolidate The fragments to consolidate.
+   * @param union_non_empty_domains The (expanded) union of the non-empty
+   *     domains of the fragments in `to_consolidate`. Ignored when merging.
+   * @param merge `true` to merge the tiles, `false` to copy them.
+   * @param new_fragment_uri The URI of the new fragment to be created.
+   * @return Status
+   */
+  Status consolidate_tiles(
+      Array* array_for_reads,
+      Array* array_for_writes,
+      const std::vector<FragmentInfo>& to_consolidate,
+      const void* union_non_empty_domains,
+      bool merge,
+      URI* new_fragment_uri);
+
   /**
    * Copies the array by reading from the fragments to be consolidated
    * (with `query_r`) and writing to the new fragment (with `query_w`).
@@ -258,6 +405,201 @@ class Consolidator {
    */
   Status copy_array(Query* query_r, Query* query_w);
 
+  /**
+   * Copies the filtered tiles of the input attribute into the new
+   * fragment. Runs of tiles that are stored contiguously in the same
+   * source fragment are read and written with a single request, up to
+   * the consolidation buffer size.
+   *
+   * @param attr The attribute whose tiles will be copied.
+   * @param tiles The source fragment and tile position of every tile of the
+   *     new fragment, in the global tile order.
+   * @param new_meta The metadata of the new fragment.
+   * @return Status
+   */
+  Status copy_attribute_tiles(
+      const Attribute* attr,
+      const std::vector<std::pair<FragmentMetadata*, uint64_t>>& tiles,
+      FragmentMetadata* new_meta) const;
+
+  /**
+   * Creates the new fragment and copies into it the filtered tiles of the
+   * fragments opened in `array_for_reads`, processing the attributes
+   * in parallel.
+   *
+   * @param array_for_reads The opened array for reading the fragments
+   *     to be consolidated.
+   * @param union_non_empty_domains The (expanded) union of the non-empty
+   *     domains of the fragments, which is the domain of the new fragment.
+   * @param new_meta The metadata of the new fragment.
+   * @return Status
+   */
+  Status copy_tiles(
+      const Array* array_for_reads,
+      const void* union_non_empty_domains,
+      FragmentMetadata* new_meta) const;
+
+  /**
+   * Same as `copy_tiles` above, templated on the domain type.
+   *
+   * @tparam T The domain type.
+   */
+  template <class T>
+  Status copy_tiles(
+      const Array* array_for_reads,
+      const T* union_non_empty_domains,
+      FragmentMetadata* new_meta) const;
+
+  /**
+   * Filters the input tile of the new fragment with the input pipeline,
+   * followed by the encryption filter of the array if any.
+   *
+   * @param array The opened array.
+   * @param filters The filter pipeline of the tile.
+   * @param tile The tile to filter in place.
+   * @return Status
+   */
+  Status filter_tile(
+      const Array* array, const FilterPipeline* filters, Tile* tile) const;
+
+  /**
+   * Merges the tiles of the sparse fragments opened in `array_for_reads`
+   * into the new fragment, without going through queries. Since each
+   * fragment stores its cells in the global order, the coordinates of the
+   * fragments are k-way merged one tile per fragment at a time. Among
+   * cells with the same coordinates, only the first cell of the latest
+   * fragment is kept. The merged cells are written in batches of full tiles of
+   * about the consolidation buffer size (see `write_merged_tiles`).
+   *
+   * @param array_for_reads The opened array for reading the fragments
+   *     to be consolidated.
+   * @param new_meta The metadata of the new fragment.
+   * @return Status
+   */
+  Status merge_tiles(
+      const Array* array_for_reads, FragmentMetadata* new_meta) const;
+
+  /**
+   * Same as `merge_tiles` above, templated on the domain type.
+   *
+   * @tparam T The domain type.
+   */
+  template <class T>
+  Status merge_tiles(
+      const Array* array_for_reads, FragmentMetadata* new_meta) const;
+
+  /**
+   * Reads and unfilters the coordinates tile of a fragment, one tile per
+   * dimension in parallel.
+   *
+   * @tparam T The domain type.
+   * @param array_for_reads The opened array for reading the fragment.
+   * @param meta The metadata of the fragment.
+   * @param tile_pos The position of the tile in the fragment.
+   * @param coords The coordinates of the cells of the tile, zipped.
+   * @return Status
+   */
+  template <class T>
+  Status read_coords_tile(
+      const Array* array_for_reads,
+      const FragmentMetadata* meta,
+      uint64_t tile_pos,
+      std::vector<T>* coords) const;
+
+  /**
+   * Reads and unfilters the input tiles of an attribute, in parallel.
+   *
+   * @param array_for_reads The opened array for reading the fragments.
+   * @param attr The attribute whose tiles will be read.
+   * @param tiles The fragment and tile position of every tile to be read.
+   * @param attr_tiles The unfiltered (offsets) tiles, in the order of
+   *     `tiles`.
+   * @param attr_var_tiles The unfiltered values tiles, for var-sized
+   *     attributes.
+   * @return Status
+   */
+  Status read_tiles(
+      const Array* array_for_reads,
+      const Attribute* attr,
+      const std::vector<std::pair<FragmentMetadata*, uint64_t>>& tiles,
+      std::vector<Tile>* attr_tiles,
+      std::vector<Tile>* attr_var_tiles) const;
+
+  /**
+   * Unfilters the input tile of a fragment with the input pipeline,
+   * preceded by the decryption of the array if any.
+   *
+   * @param array The opened array.
+   * @param filters The filter pipeline of the tile.
+   * @param zstd_dictionary The zstd dictionary of the tile, if any.
+   * @param tile The tile to unfilter in place.
+   * @return Status
+   */
+  Status unfilter_tile(
+      const Array* array,
+      const FilterPipeline* filters,
+      const std::shared_ptr<ZStdDictionary>& zstd_dictionary,
+      Tile* tile) const;
+
+  /**
+   * Writes the tiles of an attribute of the new fragment holding the
+   * input merged cells. The cells are gathered from the unfiltered tiles
+   * of the fragments and the new tiles are filtered in parallel.
+   *
+   * @param array_for_reads The opened array for reading the fragments.
+   * @param attr The attribute whose tiles will be written.
+   * @param tiles The fragment and tile position of every tile the cells
+   *     come from.
+   * @param cells The position in `tiles` of the tile of each merged cell,
+   *     and the position of the cell in that tile.
+   * @param new_meta The metadata of the new fragment.
+   * @return Status
+   */
+  Status write_merged_attribute(
+      const Array* array_for_reads,
+      const Attribute* attr,
+      const std::vector<std::pair<FragmentMetadata*, uint64_t>>& tiles,
+      const std::vector<std::pair<uint64_t, uint64_t>>& cells,
+      FragmentMetadata* new_meta) const;
+
+  /**
+   * Writes the tiles of a dimension of the new fragment holding the input
+   * merged coordinates, filtering them in parallel.
+   *
+   * @tparam T The domain type.
+   * @param array_for_reads The opened array for reading the fragments.
+   * @param dim The index of the dimension.
+   * @param coords The merged coordinates, zipped.
+   * @param new_meta The metadata of the new fragment.
+   * @return Status
+   */
+  template <class T>
+  Status write_merged_coords(
+      const Array* array_for_reads,
+      unsigned dim,
+      const std::vector<T>& coords,
+      FragmentMetadata* new_meta) const;
+
+  /**
+   * Writes a batch of merged cells to the new fragment as full tiles,
+   * except perhaps for the last batch. It sets the MBRs and bounding
+   * coordinates of the new tiles, and writes every dimension and
+   * attribute in parallel.
+   *
+   * @tparam T The domain type.
+   * @param array_for_reads The opened array for reading the fragments.
+   * @param cells The merged cells, in the global order.
+   * @param coords The coordinates of the merged cells, zipped.
+   * @param new_meta The metadata of the new fragment.
+   * @return Status
+   */
+  template <class T>
+  Status write_merged_tiles(
+      const Array* array_for_reads,
+      const std::vector<MergedCell>& cells,
+      const std::vector<T>& coords,
+      FragmentMetadata* new_meta) const;
+
   /** Cleans up the inputs. */
   void clean_up(
       unsigned buffer_num,
@@ -430,6 +772,17 @@ class Consolidator {
       const std::vector<FragmentInfo>& to_consolidate,
       const FragmentInfo& new_fragment_info,
       std::vector<FragmentInfo>* fragment_info) const;
+
+  /**
+   * Locks the array exclusively, waiting at most for the configured
+   * timeout.
+   *
+   * @param array_uri The URI of the array to lock.
+   * @param locked Set to `true` if the array got locked. Otherwise,
+   *     `xlock_timed_out_` is set.
+   * @return Status
+   */
+  Status xlock(const URI& array_uri, bool* locked);
 };
 
 }  // namespace sm
@@ -54,6 +54,8 @@ OpenArray::~OpenArray() {
   delete array_schema_;
   for (auto& fragment : fragment_metadata_)
     delete fragment;
+  for (auto& fragment : removed_fragment_metadata_)
+    delete fragment;
 }
 
 /* ****************************** */
@@ -68,6 +70,12 @@ const URI& OpenArray::array_uri() const {
   return array_uri_;
 }
 
+void OpenArray::acquire_fragment_metadata(
+    const std::vector<FragmentMetadata*>& fragment_metadata) {
+  for (auto metadata : fragment_metadata)
+    ++fragment_metadata_refs_[metadata];
+}
+
 uint64_t OpenArray::cnt() const {
   return cnt_;
 }
@@ -136,6 +144,18 @@ QueryType OpenArray::query_type() const {
   return query_type_;
 }
 
+void OpenArray::release_fragment_metadata(
+    const std::vector<FragmentMetadata*>& fragment_metadata) {
+  for (auto metadata : fragment_metadata) {
+    auto it = fragment_metadata_refs_.find(metadata);
+    if (it == fragment_metadata_refs_.end() || --it->second > 0)
+      continue;
+    fragment_metadata_refs_.erase(it);
+    if (removed_fragment_metadata_.erase(metadata) != 0)
+      delete metadata;
+  }
+}
+
 void OpenArray::set_array_schema(ArraySchema* array_schema) {
   array_schema_ = array_schema;
 }
@@ -146,6 +166,23 @@ void OpenArray::insert_fragment_metadata(FragmentMetadata* metadata) {
   fragment_metadata_set_[metadata->fragment_uri().to_string()] = metadata;
 }
 
+void OpenArray::retain_fragment_metadata(
+    const std::unordered_set<std::string>& fragment_uris) {
+  for (auto it = fragment_metadata_.begin(); it != fragment_metadata_.end();) {
+    auto uri = (*it)->fragment_uri().to_string();
+    if (fragment_uris.count(uri) != 0) {
+      ++it;
+      continue;
+    }
+    fragment_metadata_set_.erase(uri);
+    if (fragment_metadata_refs_.count(*it) != 0)
+      removed_fragment_metadata_.insert(*it);
+    else
+      delete *it;
+    it = fragment_metadata_.erase(it);
+  }
+}
+
 /* ****************************** */
 /*        PRIVATE METHODS         */
 /* ****************************** */
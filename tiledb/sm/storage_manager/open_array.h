@@ -37,6 +37,7 @@
 #include <map>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "tiledb/sm/array_schema/array_schema.h"
@@ -81,6 +82,14 @@ class OpenArray {
   /** Returns the array URI. */
   const URI& array_uri() const;
 
+  /**
+   * Marks the input fragment metadata as held by an array opened for reads,
+   * so that they are not freed if they are removed meanwhile (see
+   * `retain_fragment_metadata`).
+   */
+  void acquire_fragment_metadata(
+      const std::vector<FragmentMetadata*>& fragment_metadata);
+
   /** Returns the counter. */
   uint64_t cnt() const;
 
@@ -129,6 +138,14 @@ class OpenArray {
   /** The query type the array was opened with. */
   QueryType query_type() const;
 
+  /**
+   * Releases the input fragment metadata, acquired with
+   * `acquire_fragment_metadata`. The removed metadata that no array holds
+   * any more are freed.
+   */
+  void release_fragment_metadata(
+      const std::vector<FragmentMetadata*>& fragment_metadata);
+
   /**
    * Inserts the input fragment metadata. Note that all fragment
    * metadata must be sorted in ascending timestamp of creation.
@@ -136,6 +153,15 @@ class OpenArray {
    */
   void insert_fragment_metadata(FragmentMetadata* metadata);
 
+  /**
+   * Removes the fragment metadata whose fragment URI is not in the input
+   * set, e.g., of the fragments deleted by consolidation. The removed
+   * metadata are freed once no array holds them (see
+   * `release_fragment_metadata`).
+   */
+  void retain_fragment_metadata(
+      const std::unordered_set<std::string>& fragment_uris);
+
   /** Sets an array schema. */
   void set_array_schema(ArraySchema* array_schema);
 
@@ -177,6 +203,18 @@ class OpenArray {
    */
   std::unordered_map<std::string, FragmentMetadata*> fragment_metadata_set_;
 
+  /**
+   * The number of arrays opened for reads holding each fragment metadata
+   * (only the metadata held by at least one array are present).
+   */
+  std::unordered_map<FragmentMetadata*, uint64_t> fragment_metadata_refs_;
+
+  /**
+   * The fragment metadata removed by `retain_fragment_metadata` that are
+   * still held by some array.
+   */
+  std::unordered_set<FragmentMetadata*> removed_fragment_metadata_;
+
   /**
    * A mutex used to lock the array when loading the array metadata and
    * any fragment metadata structures from the disk.
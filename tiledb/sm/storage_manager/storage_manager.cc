@@ -32,6 +32,7 @@
  */
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <sstream>
 
@@ -64,16 +65,39 @@ namespace sm {
 StorageManager::StorageManager() {
   array_schema_cache_ = nullptr;
   fragment_metadata_cache_ = nullptr;
+  generic_tile_prefetch_size_ = constants::generic_tile_prefetch_size;
   tile_cache_ = nullptr;
   vfs_ = nullptr;
   cancellation_in_progress_ = false;
   queries_in_progress_ = 0;
+  auto_consolidation_stop_ = false;
+  auto_consolidation_num_queued_ = 0;
+  auto_consolidation_max_queued_ = 1;
+  write_coalescer_ = std::unique_ptr<WriteCoalescer>(new WriteCoalescer(this));
 }
 
 StorageManager::~StorageManager() {
   global_state::GlobalState::GetGlobalState().unregister_storage_manager(this);
+
+  // Write the buffered writes while the resources they need are available,
+  // after stopping the background flushes that could race with the teardown
+  write_coalescer_->stop();
+  Status st = write_coalescer_->flush_all();
+  if (!st.ok())
+    LOG_STATUS(st);
+
+  {
+    std::lock_guard<std::mutex> lock{auto_consolidation_mtx_};
+    auto_consolidation_stop_ = true;
+  }
+  auto_consolidation_scheduler_cv_.notify_all();
+  if (auto_consolidation_scheduler_.joinable())
+    auto_consolidation_scheduler_.join();
   cancel_all_tasks();
 
+  // Wait for a running background consolidation to finish
+  wait_for_consolidations();
+
   delete array_schema_cache_;
   delete fragment_metadata_cache_;
   delete tile_cache_;
@@ -101,7 +125,9 @@ StorageManager::~StorageManager() {
 /*               API              */
 /* ****************************** */
 
-Status StorageManager::array_close_for_reads(const URI& array_uri) {
+Status StorageManager::array_close_for_reads(
+    const URI& array_uri,
+    const std::vector<FragmentMetadata*>& fragment_metadata) {
   STATS_FUNC_IN(sm_array_close_for_reads);
   // Lock mutex
   std::lock_guard<std::mutex> lock{open_array_for_reads_mtx_};
@@ -117,8 +143,10 @@ Status StorageManager::array_close_for_reads(const URI& array_uri) {
   // For easy reference
   OpenArray* open_array = it->second;
 
-  // Lock the mutex of the array and decrement counter
+  // Lock the mutex of the array, release the fragment metadata and
+  // decrement counter
   open_array->mtx_lock();
+  open_array->release_fragment_metadata(fragment_metadata);
   open_array->cnt_decr();
 
   // Close the array if the counter reaches 0
@@ -184,6 +212,10 @@ Status StorageManager::array_open_for_reads(
     std::vector<FragmentMetadata*>* fragment_metadata) {
   STATS_FUNC_IN(sm_array_open_for_reads);
 
+  // Make the writes buffered in this context visible to the read
+  RETURN_NOT_OK_ELSE(
+      write_coalescer_->flush(array_uri), *array_schema = nullptr);
+
   // Open array without fragments
   auto open_array = (OpenArray*)nullptr;
   RETURN_NOT_OK_ELSE(
@@ -214,6 +246,9 @@ Status StorageManager::array_open_for_reads(
     return st;
   }
 
+  // Hold the fragment metadata until the array is closed or reopened
+  open_array->acquire_fragment_metadata(*fragment_metadata);
+
   // Unlock the array mutex
   open_array->mtx_unlock();
 
@@ -231,6 +266,10 @@ Status StorageManager::array_open_for_reads(
     std::vector<FragmentMetadata*>* fragment_metadata) {
   STATS_FUNC_IN(sm_array_open_for_reads);
 
+  // Make the writes buffered in this context visible to the read
+  RETURN_NOT_OK_ELSE(
+      write_coalescer_->flush(array_uri), *array_schema = nullptr);
+
   // Open array without fragments
   auto open_array = (OpenArray*)nullptr;
   RETURN_NOT_OK_ELSE(
@@ -260,6 +299,9 @@ Status StorageManager::array_open_for_reads(
     return st;
   }
 
+  // Hold the fragment metadata until the array is closed or reopened
+  open_array->acquire_fragment_metadata(*fragment_metadata);
+
   // Unlock the array mutex
   open_array->mtx_unlock();
 
@@ -350,9 +392,13 @@ Status StorageManager::array_reopen(
     uint64_t timestamp,
     const EncryptionKey& encryption_key,
     ArraySchema** array_schema,
+    const std::vector<FragmentMetadata*>& old_fragment_metadata,
     std::vector<FragmentMetadata*>* fragment_metadata) {
   STATS_FUNC_IN(sm_array_reopen);
 
+  // Make the writes buffered in this context visible to the read
+  RETURN_NOT_OK(write_coalescer_->flush(array_uri));
+
   auto open_array = (OpenArray*)nullptr;
 
   // Lock mutex
@@ -378,32 +424,51 @@ Status StorageManager::array_reopen(
       open_array->array_schema(), encryption_key, true);
   if (!st.ok()) {
     open_array->mtx_unlock();
-    array_close_for_reads(array_uri);
+    array_close_for_reads(array_uri, old_fragment_metadata);
     *array_schema = nullptr;
     return st;
   }
 
-  // Determine which fragments to load
+  // Determine which fragments to load. Only the fragments that are not
+  // already held by the open array are considered; the rest are reused,
+  // except for those no longer in the array directory (e.g., deleted by
+  // consolidation), which are dropped.
   std::vector<std::pair<uint64_t, URI>> fragments_to_load;  // (timestamp, URI)
-  std::vector<URI> fragment_uris;
-  RETURN_NOT_OK(get_fragment_uris(array_uri, &fragment_uris));
-  get_sorted_fragment_uris(fragment_uris, timestamp, &fragments_to_load);
+  std::unordered_set<std::string> loaded_fragment_uris;
+  st = get_new_fragment_uris(
+      open_array, timestamp, &fragments_to_load, &loaded_fragment_uris);
+  if (st.ok())
+    open_array->retain_fragment_metadata(loaded_fragment_uris);
 
-  // Get fragment metadata in the case of reads, if not fetched already
+  // Get the metadata of the new fragments
   bool in_cache;
-  st = load_fragment_metadata(
-      open_array,
-      encryption_key,
-      fragments_to_load,
-      &in_cache,
-      fragment_metadata);
+  std::vector<FragmentMetadata*> new_fragment_metadata;
+  if (st.ok())
+    st = load_fragment_metadata(
+        open_array,
+        encryption_key,
+        fragments_to_load,
+        &in_cache,
+        &new_fragment_metadata);
   if (!st.ok()) {
     open_array->mtx_unlock();
-    array_close_for_reads(array_uri);
+    array_close_for_reads(array_uri, old_fragment_metadata);
     *array_schema = nullptr;
     return st;
   }
 
+  // The open array now holds the metadata of all the fragments in the
+  // array, sorted in ascending timestamp order
+  *fragment_metadata = open_array->fragment_metadata(timestamp);
+
+  // Hold the new fragment metadata and release the old ones, freeing those
+  // removed above that no other array holds
+  open_array->acquire_fragment_metadata(*fragment_metadata);
+  open_array->release_fragment_metadata(old_fragment_metadata);
+  STATS_COUNTER_ADD(
+      sm_array_reopen_reused_fragments,
+      fragment_metadata->size() - new_fragment_metadata.size());
+
   // Get the array schema
   *array_schema = open_array->array_schema();
 
@@ -415,86 +480,6 @@ Status StorageManager::array_reopen(
   STATS_FUNC_OUT(sm_array_reopen);
 }
 
-Status StorageManager::array_compute_est_read_buffer_sizes(
-    const ArraySchema* array_schema,
-    const std::vector<FragmentMetadata*>& fragment_metadata,
-    const void* subarray,
-    std::unordered_map<std::string, std::pair<double, double>>* buffer_sizes) {
-  // Return if there are no metadata
-  if (fragment_metadata.empty())
-    return Status::Ok();
-
-  // Compute buffer sizes
-  switch (array_schema->coords_type()) {
-    case Datatype::INT32:
-      return array_compute_est_read_buffer_sizes<int>(
-          array_schema,
-          fragment_metadata,
-          static_cast<const int*>(subarray),
-          buffer_sizes);
-    case Datatype::INT64:
-      return array_compute_est_read_buffer_sizes<int64_t>(
-          array_schema,
-          fragment_metadata,
-          static_cast<const int64_t*>(subarray),
-          buffer_sizes);
-    case Datatype::FLOAT32:
-      return array_compute_est_read_buffer_sizes<float>(
-          array_schema,
-          fragment_metadata,
-          static_cast<const float*>(subarray),
-          buffer_sizes);
-    case Datatype::FLOAT64:
-      return array_compute_est_read_buffer_sizes<double>(
-          array_schema,
-          fragment_metadata,
-          static_cast<const double*>(subarray),
-          buffer_sizes);
-    case Datatype::INT8:
-      return array_compute_est_read_buffer_sizes<int8_t>(
-          array_schema,
-          fragment_metadata,
-          static_cast<const int8_t*>(subarray),
-          buffer_sizes);
-    case Datatype::UINT8:
-      return array_compute_est_read_buffer_sizes<uint8_t>(
-          array_schema,
-          fragment_metadata,
-          static_cast<const uint8_t*>(subarray),
-          buffer_sizes);
-    case Datatype::INT16:
-      return array_compute_est_read_buffer_sizes<int16_t>(
-          array_schema,
-          fragment_metadata,
-          static_cast<const int16_t*>(subarray),
-          buffer_sizes);
-    case Datatype::UINT16:
-      return array_compute_est_read_buffer_sizes<uint16_t>(
-          array_schema,
-          fragment_metadata,
-          static_cast<const uint16_t*>(subarray),
-          buffer_sizes);
-    case Datatype::UINT32:
-      return array_compute_est_read_buffer_sizes<uint32_t>(
-          array_schema,
-          fragment_metadata,
-          static_cast<const uint32_t*>(subarray),
-          buffer_sizes);
-    case Datatype::UINT64:
-      return array_compute_est_read_buffer_sizes<uint64_t>(
-          array_schema,
-          fragment_metadata,
-          static_cast<const uint64_t*>(subarray),
-          buffer_sizes);
-    default:
-      return LOG_STATUS(
-          Status::StorageManagerError("Cannot compute estimate for read buffer "
-                                      "sizes; Invalid coordinates type"));
-  }
-
-  return Status::Ok();
-}
-
 Status StorageManager::array_consolidate(
     const char* array_name,
     EncryptionType encryption_type,
@@ -517,9 +502,17 @@ Status StorageManager::array_consolidate(
   }
 
   // Consolidate
-  Consolidator consolidator(this);
-  return consolidator.consolidate(
-      array_name, encryption_type, encryption_key, key_length, config);
+  std::mutex* mtx = consolidation_mtx_acquire(array_uri.to_string());
+  Status st;
+  {
+    std::lock_guard<std::mutex> lock{*mtx};
+    Consolidator consolidator(this);
+    st = consolidator.consolidate(
+        array_name, encryption_type, encryption_key, key_length, config);
+  }
+  consolidation_mtx_release(array_uri.to_string());
+
+  return st;
 }
 
 Status StorageManager::array_create(
@@ -679,7 +672,43 @@ Status StorageManager::array_xlock(const URI& array_uri) {
   return Status::Ok();
 }
 
+Status StorageManager::array_xlock(
+    const URI& array_uri, uint64_t timeout_ms, bool* locked) {
+  // Wait until the array is closed for reads, or give up
+  std::unique_lock<std::mutex> lk(open_array_for_reads_mtx_);
+  *locked = xlock_cv_.wait_for(
+      lk, std::chrono::milliseconds(timeout_ms), [this, array_uri] {
+        return open_arrays_for_reads_.find(array_uri.to_string()) ==
+               open_arrays_for_reads_.end();
+      });
+  if (!*locked)
+    return Status::Ok();
+
+  // Retrieve filelock
+  filelock_t filelock = INVALID_FILELOCK;
+  auto lock_uri = array_uri.join_path(constants::filelock_name);
+  RETURN_NOT_OK(vfs_->filelock_lock(lock_uri, &filelock, false));
+  xfilelocks_[array_uri.to_string()] = filelock;
+
+  return Status::Ok();
+}
+
+Status StorageManager::array_wait_closed_for_reads(
+    const URI& array_uri, uint64_t timeout_ms, bool* closed) {
+  std::unique_lock<std::mutex> lk(open_array_for_reads_mtx_);
+  *closed = xlock_cv_.wait_for(
+      lk, std::chrono::milliseconds(timeout_ms), [this, array_uri] {
+        return open_arrays_for_reads_.find(array_uri.to_string()) ==
+               open_arrays_for_reads_.end();
+      });
+
+  return Status::Ok();
+}
+
 Status StorageManager::array_xunlock(const URI& array_uri) {
+  // For thread-safety while accessing the exclusive filelocks
+  std::lock_guard<std::mutex> lock{open_array_for_reads_mtx_};
+
   // Get filelock if it exists
   auto it = xfilelocks_.find(array_uri.to_string());
   if (it == xfilelocks_.end())
@@ -696,12 +725,13 @@ Status StorageManager::array_xunlock(const URI& array_uri) {
 }
 
 Status StorageManager::async_push_query(Query* query) {
-  async_thread_pool_->enqueue(
+  thread_pool_->enqueue(
       [this, query]() {
         // Process query.
         Status st = query_submit(query);
         if (!st.ok())
           LOG_STATUS(st);
+        query->post_completion(st);
         return st;
       },
       [query]() {
@@ -709,11 +739,17 @@ Status StorageManager::async_push_query(Query* query) {
         // as we are guaranteed by the thread pool not to have entered
         // query->process() yet.
         query->cancel();
-      });
+        query->post_completion(Status::Ok());
+      },
+      ThreadPool::Priority::BACKGROUND);
 
   return Status::Ok();
 }
 
+BufferPool* StorageManager::buffer_pool() const {
+  return buffer_pool_.get();
+}
+
 Status StorageManager::cancel_all_tasks() {
   // Check if there is already a "cancellation" in progress.
   bool handle_cancel = false;
@@ -728,7 +764,7 @@ Status StorageManager::cancel_all_tasks() {
   // Handle the cancellation.
   if (handle_cancel) {
     // Cancel any queued tasks.
-    async_thread_pool_->cancel_all_tasks();
+    thread_pool_->cancel_all_tasks();
     vfs_->cancel_all_tasks();
 
     // Wait for in-progress queries to finish.
@@ -755,6 +791,14 @@ Status StorageManager::create_dir(const URI& uri) {
   return vfs_->create_dir(uri);
 }
 
+Status StorageManager::flush_writes() {
+  return write_coalescer_->flush_all();
+}
+
+Status StorageManager::flush_writes(const URI& array_uri) {
+  return write_coalescer_->flush(array_uri);
+}
+
 Status StorageManager::touch(const URI& uri) {
   return vfs_->touch(uri);
 }
@@ -833,6 +877,10 @@ Status StorageManager::object_move(
   return vfs_->move_dir(old_uri, new_uri);
 }
 
+uint64_t StorageManager::generic_tile_prefetch_size() const {
+  return generic_tile_prefetch_size_;
+}
+
 Status StorageManager::get_fragment_info(
     const ArraySchema* array_schema,
     uint64_t timestamp,
@@ -854,7 +902,7 @@ Status StorageManager::get_fragment_info(
 
   uint64_t domain_size = 2 * array_schema->coords_size();
   uint64_t size;
-  bool sparse, in_cache;
+  bool in_cache;
   void* non_empty_domain = std::malloc(domain_size);
   if (non_empty_domain == nullptr)
     return LOG_STATUS(Status::StorageManagerError(
@@ -862,23 +910,22 @@ Status StorageManager::get_fragment_info(
 
   // Get the rest of fragment info
   for (const auto& uri : sorted_fragment_uris) {
-    // Determine if the fragment is sparse
-    URI coords_uri =
-        uri.second.join_path(constants::coords + constants::file_suffix);
-    RETURN_NOT_OK(vfs_->is_file(coords_uri, &sparse));
-
     // Get fragment size
     RETURN_NOT_OK(vfs_->dir_size(uri.second, &size));
 
-    // Get fragment non-empty domain
-    auto metadata =
-        FragmentMetadata(array_schema, !sparse, uri.second, uri.first);
+    // Get fragment non-empty domain and whether it is sparse
+    FragmentMetadata metadata(array_schema, true, uri.second, uri.first);
     RETURN_NOT_OK(load_fragment_metadata(&metadata, encryption_key, &in_cache));
     std::memcpy(non_empty_domain, metadata.non_empty_domain(), domain_size);
 
     // Push new fragment info
     fragment_info->emplace_back(
-        uri.second, sparse, uri.first, size, non_empty_domain, domain_size);
+        uri.second,
+        !metadata.dense(),
+        uri.first,
+        size,
+        non_empty_domain,
+        domain_size);
   }
 
   // Clean up
@@ -909,22 +956,16 @@ Status StorageManager::get_fragment_info(
   uint64_t size;
   RETURN_NOT_OK(vfs_->dir_size(fragment_uri, &size));
 
-  // Check if fragment is sparse
+  // Get fragment non-empty domain and whether it is sparse
   uint64_t domain_size = 2 * array_schema->coords_size();
-  bool sparse, in_cache;
-  URI coords_uri =
-      fragment_uri.join_path(constants::coords + constants::file_suffix);
-  RETURN_NOT_OK(vfs_->is_file(coords_uri, &sparse));
-
-  // Get fragment non-empty domain
-  auto metadata =
-      FragmentMetadata(array_schema, !sparse, fragment_uri, timestamp);
+  bool in_cache;
+  FragmentMetadata metadata(array_schema, true, fragment_uri, timestamp);
   RETURN_NOT_OK(load_fragment_metadata(&metadata, encryption_key, &in_cache));
 
   // Set fragment info
   *fragment_info = FragmentInfo(
       fragment_uri,
-      sparse,
+      !metadata.dense(),
       timestamp,
       size,
       metadata.non_empty_domain(),
@@ -970,15 +1011,30 @@ Status StorageManager::init(Config* config) {
   array_schema_cache_ = new LRUCache(sm_params.array_schema_cache_size_);
   fragment_metadata_cache_ =
       new LRUCache(sm_params.fragment_metadata_cache_size_);
-  async_thread_pool_ = std::unique_ptr<ThreadPool>(new ThreadPool());
-  RETURN_NOT_OK(async_thread_pool_->init(sm_params.num_async_threads_));
-  reader_thread_pool_ = std::unique_ptr<ThreadPool>(new ThreadPool());
-  RETURN_NOT_OK(reader_thread_pool_->init(sm_params.num_reader_threads_));
-  writer_thread_pool_ = std::unique_ptr<ThreadPool>(new ThreadPool());
-  RETURN_NOT_OK(writer_thread_pool_->init(sm_params.num_writer_threads_));
+  generic_tile_prefetch_size_ = sm_params.generic_tile_prefetch_size_;
+  if (sm_params.buffer_pool_size_ > 0)
+    buffer_pool_ = std::unique_ptr<BufferPool>(
+        new BufferPool(sm_params.buffer_pool_size_));
+  thread_pool_ = std::unique_ptr<ThreadPool>(new ThreadPool());
+  RETURN_NOT_OK(thread_pool_->init(sm_params.num_compute_threads_));
+  if (sm_params.consolidation_params_.auto_) {
+    auto_consolidation_max_queued_ =
+        std::max<uint64_t>(sm_params.num_consolidation_threads_, 1);
+    try {
+      auto_consolidation_scheduler_ =
+          std::thread([this]() { auto_consolidation_schedule(); });
+    } catch (const std::exception& e) {
+      return LOG_STATUS(Status::StorageManagerError(
+          std::string("Cannot start background consolidation thread; ") +
+          e.what()));
+    }
+  }
   tile_cache_ = new LRUCache(sm_params.tile_cache_size_);
   vfs_ = new VFS();
-  RETURN_NOT_OK(vfs_->init(config_.vfs_params()));
+  RETURN_NOT_OK(vfs_->init(config_.vfs_params(), thread_pool_.get()));
+  RETURN_NOT_OK(write_coalescer_->init(
+      sm_params.write_coalescing_max_bytes_,
+      sm_params.write_coalescing_max_age_ms_));
   auto& global_state = global_state::GlobalState::GetGlobalState();
   RETURN_NOT_OK(global_state.initialize(config));
   global_state.register_storage_manager(this);
@@ -1006,9 +1062,9 @@ Status StorageManager::is_file(const URI& uri, bool* is_file) const {
 }
 
 Status StorageManager::is_fragment(const URI& uri, bool* is_fragment) const {
-  RETURN_NOT_OK(TileIO::is_generic_tile(
-      this, uri.join_path(constants::fragment_metadata_filename), is_fragment));
-  return Status::Ok();
+  uint64_t file_size;
+  uint32_t version;
+  return fragment_metadata_file_info(uri, is_fragment, &file_size, &version);
 }
 
 Status StorageManager::is_group(const URI& uri, bool* is_group) const {
@@ -1099,16 +1155,11 @@ Status StorageManager::load_fragment_metadata(
     const EncryptionKey& encryption_key,
     bool* in_cache) {
   const URI& fragment_uri = fragment_metadata->fragment_uri();
-  bool fragment_exists;
-  RETURN_NOT_OK(is_fragment(fragment_uri, &fragment_exists));
-  if (!fragment_exists)
-    return Status::StorageManagerError(
-        "Cannot load fragment metadata; Fragment does not exist");
-
   URI fragment_metadata_uri = fragment_uri.join_path(
       std::string(constants::fragment_metadata_filename));
 
-  // Try to read from cache
+  // Try to read from cache. The cached metadata is preceded by the offset
+  // of the footer in the file, which bounds the last section.
   auto buff = new Buffer();
   RETURN_NOT_OK_ELSE(
       fragment_metadata_cache_->read(
@@ -1116,12 +1167,38 @@ Status StorageManager::load_fragment_metadata(
       delete buff);
 
   // Read from file if not in cache
+  uint64_t footer_offset = 0, data_offset = 0;
   if (!(*in_cache)) {
     delete buff;
+    bool fragment_exists;
+    uint64_t file_size;
+    uint32_t version;
+    RETURN_NOT_OK(fragment_metadata_file_info(
+        fragment_uri, &fragment_exists, &file_size, &version));
+    if (!fragment_exists)
+      return Status::StorageManagerError(
+          "Cannot load fragment metadata; Fragment does not exist");
+
+    uint64_t size;
+    Buffer footer;
+    RETURN_NOT_OK(fragment_metadata_footer_offset(
+        fragment_metadata_uri,
+        file_size,
+        version,
+        &footer_offset,
+        &size,
+        &footer));
     auto tile_io = new TileIO(this, fragment_metadata_uri);
     auto tile = (Tile*)nullptr;
-    RETURN_NOT_OK_ELSE(
-        tile_io->read_generic(&tile, 0, encryption_key), delete tile_io);
+    if (footer.size() > 0) {
+      RETURN_NOT_OK_ELSE(
+          tile_io->read_generic(&tile, footer_offset, &footer, encryption_key),
+          delete tile_io);
+    } else {
+      RETURN_NOT_OK_ELSE(
+          tile_io->read_generic(&tile, footer_offset, size, encryption_key),
+          delete tile_io);
+    }
     tile->disown_buff();
     buff = tile->buffer();
     STATS_COUNTER_ADD(fragment_metadata_cache_read_misses, 1);
@@ -1131,21 +1208,39 @@ Status StorageManager::load_fragment_metadata(
   } else {
     STATS_COUNTER_ADD(fragment_metadata_cache_read_hits, 1);
     STATS_COUNTER_ADD(fragment_metadata_cached_bytes_copied, buff->size());
+    if (buff->size() < sizeof(uint64_t)) {
+      delete buff;
+      return LOG_STATUS(Status::StorageManagerError(
+          "Cannot load fragment metadata; Invalid cached metadata size"));
+    }
+    std::memcpy(&footer_offset, buff->data(), sizeof(uint64_t));
+    data_offset = sizeof(uint64_t);
   }
+  fragment_metadata->set_footer_offset(footer_offset);
 
   // Deserialize
-  auto cbuff = new ConstBuffer(buff);
+  auto cbuff =
+      new ConstBuffer(buff->data(data_offset), buff->size() - data_offset);
   Status st = fragment_metadata->deserialize(cbuff);
   delete cbuff;
 
   // Store in cache
   if (st.ok()) {
-    STATS_COUNTER_ADD(fragment_metadata_bytes, buff->size());
-    if (!(*in_cache) && buff->size() <= fragment_metadata_cache_->max_size()) {
-      buff->disown_data();
-      st = fragment_metadata_cache_->insert(
-          fragment_metadata_uri.to_string(), buff->data(), buff->size());
-      STATS_COUNTER_ADD_IF(st.ok(), fragment_metadata_cache_inserts, 1);
+    STATS_COUNTER_ADD(fragment_metadata_bytes, buff->size() - data_offset);
+    auto cached_size = sizeof(uint64_t) + buff->size();
+    if (!(*in_cache) && cached_size <= fragment_metadata_cache_->max_size()) {
+      Buffer cached;
+      st = cached.realloc(cached_size);
+      if (st.ok())
+        st = cached.write(&footer_offset, sizeof(uint64_t));
+      if (st.ok())
+        st = cached.write(buff->data(), buff->size());
+      if (st.ok()) {
+        cached.disown_data();
+        st = fragment_metadata_cache_->insert(
+            fragment_metadata_uri.to_string(), cached.data(), cached.size());
+        STATS_COUNTER_ADD_IF(st.ok(), fragment_metadata_cache_inserts, 1);
+      }
     }
   }
 
@@ -1154,6 +1249,61 @@ Status StorageManager::load_fragment_metadata(
   return st;
 }
 
+Status StorageManager::load_fragment_metadata_section(
+    const URI& fragment_uri,
+    uint64_t offset,
+    uint64_t max_size,
+    const EncryptionKey& encryption_key,
+    Buffer* buff) {
+  URI fragment_metadata_uri = fragment_uri.join_path(
+      std::string(constants::fragment_metadata_filename));
+  std::stringstream key;
+  key << fragment_metadata_uri.to_string() << "+" << offset;
+
+  // Try to read from cache
+  bool in_cache;
+  RETURN_NOT_OK(fragment_metadata_cache_->read(key.str(), buff, &in_cache));
+  if (in_cache) {
+    buff->reset_offset();
+    STATS_COUNTER_ADD(fragment_metadata_cache_read_hits, 1);
+    STATS_COUNTER_ADD(fragment_metadata_cached_bytes_copied, buff->size());
+    return Status::Ok();
+  }
+
+  // Read from file
+  TileIO tile_io(this, fragment_metadata_uri);
+  auto tile = (Tile*)nullptr;
+  if (max_size > 0) {
+    RETURN_NOT_OK(
+        tile_io.read_generic(&tile, offset, max_size, encryption_key));
+  } else {
+    RETURN_NOT_OK(tile_io.read_generic(&tile, offset, encryption_key));
+  }
+  Status st = buff->swap(*tile->buffer());
+  delete tile;
+  RETURN_NOT_OK(st);
+  buff->reset_offset();
+  STATS_COUNTER_ADD(fragment_metadata_cache_read_misses, 1);
+  STATS_COUNTER_ADD(fragment_metadata_bytes_read, tile_io.file_size());
+  STATS_COUNTER_ADD(fragment_metadata_bytes, buff->size());
+  STATS_COUNTER_ADD(fragment_metadata_num_sections, 1);
+
+  // Store in cache
+  if (buff->size() <= fragment_metadata_cache_->max_size()) {
+    void* data = std::malloc(buff->size());
+    if (data == nullptr)
+      return LOG_STATUS(Status::StorageManagerError(
+          "Cannot load fragment metadata section; Memory allocation failed"));
+    std::memcpy(data, buff->data(), buff->size());
+    st = fragment_metadata_cache_->insert(key.str(), data, buff->size());
+    if (!st.ok())
+      std::free(data);
+    STATS_COUNTER_ADD_IF(st.ok(), fragment_metadata_cache_inserts, 1);
+  }
+
+  return st;
+}
+
 Status StorageManager::object_type(const URI& uri, ObjectType* type) const {
   URI dir_uri = uri;
   if (uri.is_s3()) {
@@ -1417,10 +1567,6 @@ Status StorageManager::read(
   return Status::Ok();
 }
 
-ThreadPool* StorageManager::reader_thread_pool() const {
-  return reader_thread_pool_.get();
-}
-
 Status StorageManager::store_array_schema(
     ArraySchema* array_schema, const EncryptionKey& encryption_key) {
   auto& array_uri = array_schema->array_uri();
@@ -1461,7 +1607,7 @@ Status StorageManager::store_array_schema(
 Status StorageManager::store_fragment_metadata(
     FragmentMetadata* metadata, const EncryptionKey& encryption_key) {
   // For thread-safety while loading fragment metadata
-  std::lock_guard<std::mutex> lock{open_array_for_reads_mtx_};
+  std::unique_lock<std::mutex> lock{open_array_for_reads_mtx_};
 
   // Do nothing if fragment directory does not exist. The fragment directory
   // is created only when some attribute file is written
@@ -1472,34 +1618,46 @@ Status StorageManager::store_fragment_metadata(
     return Status::Ok();
   }
 
-  // Serialize
-  auto buff = new Buffer();
-  Status st = metadata->serialize(buff);
-  if (!st.ok()) {
-    delete buff;
-    return st;
-  }
-
-  // Write to file
+  // Write each stored section as a separate generic tile, so that it can be
+  // loaded independently, followed by the footer and the footer size
   URI fragment_metadata_uri = fragment_uri.join_path(
       std::string(constants::fragment_metadata_filename));
-  buff->reset_offset();
-  auto tile = new Tile(
-      constants::generic_tile_datatype,
-      constants::generic_tile_cell_size,
-      0,
-      buff,
-      false);
-
-  auto tile_io = new TileIO(this, fragment_metadata_uri);
-  st = tile_io->write_generic(tile, encryption_key);
+  std::vector<uint64_t> section_offsets;
+  uint64_t offset = 0, nbytes = 0;
+  Status st;
+  for (unsigned s = 0; s < metadata->section_num() && st.ok(); ++s) {
+    section_offsets.push_back(offset);
+    if (!metadata->stores_section(s))
+      continue;
+    Buffer buff;
+    st = metadata->serialize_section(s, &buff);
+    if (st.ok())
+      st = store_fragment_metadata_tile(
+          fragment_metadata_uri, &buff, encryption_key, &nbytes);
+    offset += nbytes;
+  }
   if (st.ok()) {
-    st = close_file(fragment_metadata_uri);
+    Buffer buff;
+    st = metadata->serialize_footer(section_offsets, &buff);
+    if (st.ok())
+      st = store_fragment_metadata_tile(
+          fragment_metadata_uri, &buff, encryption_key, &nbytes);
+  }
+  if (st.ok()) {
+    offset += nbytes;
+    Buffer buff;
+    st = buff.write(&nbytes, sizeof(uint64_t));
+    if (st.ok())
+      st = write(fragment_metadata_uri, &buff);
+    offset += sizeof(uint64_t);
   }
+  if (st.ok())
+    st = close_file(fragment_metadata_uri);
+  lock.unlock();
 
-  delete tile;
-  delete tile_io;
-  delete buff;
+  // Schedule background consolidation
+  if (st.ok() && config_.consolidation_params().auto_)
+    auto_consolidate_notify(metadata, offset, encryption_key);
 
   return st;
 }
@@ -1512,14 +1670,29 @@ Status StorageManager::sync(const URI& uri) {
   return vfs_->sync(uri);
 }
 
-ThreadPool* StorageManager::writer_thread_pool() const {
-  return writer_thread_pool_.get();
+ThreadPool* StorageManager::thread_pool() const {
+  return thread_pool_.get();
 }
 
 VFS* StorageManager::vfs() const {
   return vfs_;
 }
 
+WriteCoalescer* StorageManager::write_coalescer() const {
+  return write_coalescer_.get();
+}
+
+void StorageManager::wait_for_consolidations() {
+  std::unique_lock<std::mutex> lock{auto_consolidation_mtx_};
+  auto_consolidation_cv_.wait(lock, [this]() {
+    for (const auto& state : auto_consolidation_state_) {
+      if (state.second.pending_)
+        return false;
+    }
+    return true;
+  });
+}
+
 void StorageManager::wait_for_zero_in_progress() {
   std::unique_lock<std::mutex> lck(queries_in_progress_mtx_);
   queries_in_progress_cv_.wait(
@@ -1568,61 +1741,6 @@ Status StorageManager::write(const URI& uri, Buffer* buffer) const {
 /*         PRIVATE METHODS        */
 /* ****************************** */
 
-template <class T>
-Status StorageManager::array_compute_est_read_buffer_sizes(
-    const ArraySchema* array_schema,
-    const std::vector<FragmentMetadata*>& metadata,
-    const T* subarray,
-    std::unordered_map<std::string, std::pair<double, double>>* buffer_sizes) {
-  // Sanity check
-  assert(!metadata.empty());
-
-  // First we calculate a rough upper bound. Especially for dense
-  // arrays, this will not be accurate, as it accounts only for the
-  // non-empty regions of the subarray.
-  for (auto& meta : metadata)
-    RETURN_NOT_OK(meta->add_est_read_buffer_sizes(subarray, buffer_sizes));
-
-  // Rectify bound for dense arrays
-  if (array_schema->dense()) {
-    auto cell_num = array_schema->domain()->cell_num(subarray);
-    // `cell_num` becomes 0 when `subarray` is huge, leading to a
-    // `uint64_t` overflow.
-    if (cell_num != 0) {
-      for (auto& it : *buffer_sizes) {
-        if (array_schema->var_size(it.first)) {
-          it.second.first = cell_num * constants::cell_var_offset_size;
-        } else {
-          it.second.first = cell_num * array_schema->cell_size(it.first);
-        }
-      }
-    }
-  }
-
-  // Rectify bound for sparse arrays with integer domain
-  if (!array_schema->dense() &&
-      datatype_is_integer(array_schema->domain()->type())) {
-    auto cell_num = array_schema->domain()->cell_num(subarray);
-    // `cell_num` becomes 0 when `subarray` is huge, leading to a
-    // `uint64_t` overflow.
-    if (cell_num != 0) {
-      for (auto& it : *buffer_sizes) {
-        if (!array_schema->var_size(it.first)) {
-          // Check for overflow
-          uint64_t new_size = cell_num * array_schema->cell_size(it.first);
-          if (new_size / array_schema->cell_size((it.first)) != cell_num)
-            continue;
-
-          // Potentially rectify size
-          it.second.first = MIN(it.second.first, new_size);
-        }
-      }
-    }
-  }
-
-  return Status::Ok();
-}
-
 template <class T>
 void StorageManager::array_get_non_empty_domain(
     const std::vector<FragmentMetadata*>& metadata,
@@ -1718,6 +1836,346 @@ Status StorageManager::array_open_without_fragments(
   return Status::Ok();
 }
 
+Status StorageManager::auto_consolidate(
+    const std::string& array_uri,
+    EncryptionType encryption_type,
+    const std::vector<uint8_t>& encryption_key) {
+  auto params = config_.consolidation_params();
+
+  // Compute the byte budget of this run
+  uint64_t max_bytes;
+  {
+    std::lock_guard<std::mutex> lock{auto_consolidation_mtx_};
+    auto& state = auto_consolidation_state_[array_uri];
+    if (auto_consolidation_stop_) {
+      auto_consolidation_num_queued_--;
+      state.pending_ = false;
+      auto_consolidation_cv_.notify_all();
+      return Status::Ok();
+    }
+
+    state.dirty_ = false;
+    state.last_run_ms_ = utils::time::timestamp_now_ms();
+    auto allowed_bytes = (uint64_t)(
+        (double)params.auto_write_amplification_ * state.bytes_written_);
+    max_bytes = (allowed_bytes > state.bytes_consolidated_) ?
+                    allowed_bytes - state.bytes_consolidated_ :
+                    0;
+    max_bytes = std::min(max_bytes, params.auto_max_bytes_);
+  }
+
+  // Consolidate
+  Status st = Status::Ok();
+  uint64_t bytes_consolidated = 0;
+  bool xlock_timed_out = false;
+  bool stopped_early = true;
+  if (max_bytes > 0) {
+    std::mutex* mtx = consolidation_mtx_acquire(array_uri);
+    {
+      std::lock_guard<std::mutex> lock{*mtx};
+      Consolidator consolidator(this);
+      consolidator.set_max_bytes(max_bytes);
+      consolidator.set_xlock_timeout_ms(
+          constants::consolidation_auto_xlock_timeout_ms);
+      st = consolidator.consolidate(
+          array_uri.c_str(),
+          encryption_type,
+          encryption_key.empty() ? nullptr : encryption_key.data(),
+          (uint32_t)encryption_key.size(),
+          &config_);
+      bytes_consolidated = consolidator.bytes_consolidated();
+      xlock_timed_out = consolidator.xlock_timed_out();
+      stopped_early = consolidator.stopped_early();
+    }
+    consolidation_mtx_release(array_uri);
+  }
+
+  STATS_COUNTER_ADD(sm_auto_consolidations, 1);
+  STATS_COUNTER_ADD(sm_auto_consolidation_bytes, bytes_consolidated);
+
+  // Update the state, running again if fragments were written meanwhile,
+  // or if the array was kept open for reads in this context and the
+  // retries are not exhausted
+  std::lock_guard<std::mutex> lock{auto_consolidation_mtx_};
+  auto_consolidation_num_queued_--;
+  auto_consolidation_scheduler_cv_.notify_all();
+  auto& state = auto_consolidation_state_[array_uri];
+  state.bytes_consolidated_ += bytes_consolidated;
+  bool retry = false;
+  if (xlock_timed_out) {
+    retry = ++state.xlock_retries_ <=
+            constants::consolidation_auto_xlock_max_retries;
+    if (!retry)
+      state.xlock_retries_ = 0;
+  } else {
+    state.xlock_retries_ = 0;
+    retry = state.dirty_;
+  }
+  if (retry && !auto_consolidation_stop_) {
+    auto_consolidate_enqueue(array_uri, encryption_type, encryption_key);
+  } else {
+    state.pending_ = false;
+    state.done_ = st.ok() && bytes_consolidated > 0 && !xlock_timed_out &&
+                  !stopped_early;
+    auto_consolidation_cv_.notify_all();
+  }
+
+  return st;
+}
+
+void StorageManager::auto_consolidate_enqueue(
+    const std::string& array_uri,
+    EncryptionType encryption_type,
+    const std::vector<uint8_t>& encryption_key) {
+  auto& state = auto_consolidation_state_[array_uri];
+  state.pending_ = true;
+  state.done_ = false;
+
+  // Wait for the rate limit, or for the backoff after failing to lock the
+  // array, in the scheduler thread
+  auto params = config_.consolidation_params();
+  auto delay_ms = params.auto_interval_ms_;
+  if (state.xlock_retries_ > 0)
+    delay_ms = std::max(
+        delay_ms,
+        constants::consolidation_auto_xlock_backoff_ms
+            << (state.xlock_retries_ - 1));
+  auto next_run_ms = state.last_run_ms_ + delay_ms;
+  if (next_run_ms > utils::time::timestamp_now_ms() ||
+      auto_consolidation_num_queued_ >= auto_consolidation_max_queued_) {
+    state.scheduled_ = true;
+    state.next_run_ms_ = next_run_ms;
+    state.encryption_type_ = encryption_type;
+    state.encryption_key_ = encryption_key;
+    auto_consolidation_scheduler_cv_.notify_all();
+    return;
+  }
+
+  // The task outlives the query whose write triggered it, hence it must not
+  // record its stats on behalf of that query
+  stats::ScopedQuery no_query(nullptr, 0);
+  auto_consolidation_num_queued_++;
+  thread_pool_->enqueue(
+      [this, array_uri, encryption_type, encryption_key]() {
+        Status st =
+            auto_consolidate(array_uri, encryption_type, encryption_key);
+        if (!st.ok())
+          LOG_STATUS(st);
+        return st;
+      },
+      [this, array_uri]() {
+        // Task was cancelled before it started
+        std::lock_guard<std::mutex> lock{auto_consolidation_mtx_};
+        auto_consolidation_num_queued_--;
+        auto_consolidation_state_[array_uri].pending_ = false;
+        auto_consolidation_cv_.notify_all();
+        auto_consolidation_scheduler_cv_.notify_all();
+      },
+      ThreadPool::Priority::BACKGROUND);
+}
+
+void StorageManager::auto_consolidate_notify(
+    const FragmentMetadata* metadata,
+    uint64_t metadata_size,
+    const EncryptionKey& encryption_key) {
+  // Ignore the fragments produced by consolidation
+  const auto& fragment_uri = metadata->fragment_uri();
+  std::string uri_str = fragment_uri.to_string();
+  if (!uri_str.empty() && uri_str.back() == '/')
+    uri_str.pop_back();
+  uint64_t timestamp;
+  bool consolidated;
+  Status st = utils::parse::fragment_name(
+      URI(uri_str).last_path_part(), &timestamp, &consolidated);
+  if (!st.ok() || consolidated)
+    return;
+
+  // The sizes of the files of the fragment are known from its metadata,
+  // which saves listing the fragment directory
+  uint64_t fragment_size = metadata->fragment_size() + metadata_size;
+
+  auto array_uri = metadata->array_uri().to_string();
+  auto key = encryption_key.key();
+
+  std::lock_guard<std::mutex> lock{auto_consolidation_mtx_};
+  if (auto_consolidation_stop_)
+    return;
+  auto& state = auto_consolidation_state_[array_uri];
+  state.bytes_written_ += fragment_size;
+
+  if (state.pending_)
+    state.dirty_ = true;
+  else
+    auto_consolidate_enqueue(
+        array_uri,
+        encryption_key.encryption_type(),
+        std::vector<uint8_t>(
+            (const uint8_t*)key.data(),
+            (const uint8_t*)key.data() + key.size()));
+}
+
+void StorageManager::auto_consolidation_schedule() {
+  std::unique_lock<std::mutex> lock{auto_consolidation_mtx_};
+  while (!auto_consolidation_stop_) {
+    // Queue the due consolidations while the limit allows, and find the
+    // next one. The due ones that exceed the limit are queued once a
+    // queued one ends, which notifies this thread. The states of the
+    // arrays left with nothing to consolidate are dropped once their rate
+    // limit has passed, since a new state then behaves the same.
+    auto now = utils::time::timestamp_now_ms();
+    auto interval_ms = config_.consolidation_params().auto_interval_ms_;
+    uint64_t next_run_ms = 0;
+    for (auto it = auto_consolidation_state_.begin();
+         it != auto_consolidation_state_.end();) {
+      auto& state = it->second;
+      uint64_t run_ms;
+      if (state.scheduled_) {
+        run_ms = state.next_run_ms_;
+        if (run_ms <= now) {
+          if (auto_consolidation_num_queued_ < auto_consolidation_max_queued_) {
+            state.scheduled_ = false;
+            std::vector<uint8_t> encryption_key;
+            encryption_key.swap(state.encryption_key_);
+            auto_consolidate_enqueue(
+                it->first, state.encryption_type_, encryption_key);
+          }
+          ++it;
+          continue;
+        }
+      } else if (!state.pending_ && state.done_) {
+        run_ms = state.last_run_ms_ + interval_ms;
+        if (run_ms <= now) {
+          it = auto_consolidation_state_.erase(it);
+          continue;
+        }
+      } else {
+        ++it;
+        continue;
+      }
+      if (next_run_ms == 0 || run_ms < next_run_ms)
+        next_run_ms = run_ms;
+      ++it;
+    }
+
+    if (next_run_ms == 0)
+      auto_consolidation_scheduler_cv_.wait(lock);
+    else
+      auto_consolidation_scheduler_cv_.wait_for(
+          lock, std::chrono::milliseconds(next_run_ms - now));
+  }
+
+  // Drop the consolidations that were not queued
+  for (auto& it : auto_consolidation_state_) {
+    auto& state = it.second;
+    if (state.scheduled_) {
+      state.scheduled_ = false;
+      state.pending_ = false;
+      state.encryption_key_.clear();
+    }
+  }
+  auto_consolidation_cv_.notify_all();
+}
+
+std::mutex* StorageManager::consolidation_mtx_acquire(
+    const std::string& array_uri) {
+  std::lock_guard<std::mutex> lock{auto_consolidation_mtx_};
+  auto& consolidation_mtx = consolidation_mtxs_[array_uri];
+  consolidation_mtx.cnt_++;
+  return &consolidation_mtx.mtx_;
+}
+
+void StorageManager::consolidation_mtx_release(const std::string& array_uri) {
+  std::lock_guard<std::mutex> lock{auto_consolidation_mtx_};
+  auto it = consolidation_mtxs_.find(array_uri);
+  assert(it != consolidation_mtxs_.end());
+  if (--it->second.cnt_ == 0)
+    consolidation_mtxs_.erase(it);
+}
+
+Status StorageManager::fragment_metadata_footer_offset(
+    const URI& fragment_metadata_uri,
+    uint64_t file_size,
+    uint32_t version,
+    uint64_t* offset,
+    uint64_t* size,
+    Buffer* footer) const {
+  *offset = 0;
+  *size = file_size;
+
+  // Older format versions store the entire metadata in one generic tile
+  if (version < constants::fragment_metadata_sections_version)
+    return Status::Ok();
+
+  // The footer size is stored at the end of the file. Read it speculatively
+  // along with the bytes preceding it, which typically hold the footer.
+  if (file_size < sizeof(uint64_t))
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot load fragment metadata; Invalid fragment metadata file size"));
+  uint64_t tail_size = std::min(
+      file_size, (uint64_t)sizeof(uint64_t) + generic_tile_prefetch_size_);
+  Buffer tail;
+  RETURN_NOT_OK(
+      read(fragment_metadata_uri, file_size - tail_size, &tail, tail_size));
+  uint64_t footer_size;
+  tail.set_offset(tail_size - sizeof(uint64_t));
+  RETURN_NOT_OK(tail.read(&footer_size, sizeof(uint64_t)));
+  if (footer_size > file_size - sizeof(uint64_t))
+    return LOG_STATUS(
+        Status::StorageManagerError("Cannot load fragment metadata; Invalid "
+                                    "fragment metadata footer size"));
+
+  *offset = file_size - sizeof(uint64_t) - footer_size;
+  *size = footer_size;
+  if (footer_size + sizeof(uint64_t) <= tail_size)
+    RETURN_NOT_OK(footer->write(
+        tail.data(tail_size - sizeof(uint64_t) - footer_size), footer_size));
+
+  return Status::Ok();
+}
+
+Status StorageManager::fragment_metadata_file_info(
+    const URI& fragment_uri,
+    bool* is_fragment,
+    uint64_t* file_size,
+    uint32_t* version) const {
+  *is_fragment = false;
+  URI fragment_metadata_uri =
+      fragment_uri.join_path(constants::fragment_metadata_filename);
+
+  bool is_file;
+  RETURN_NOT_OK(vfs_->is_file(fragment_metadata_uri, &is_file));
+  if (!is_file)
+    return Status::Ok();
+
+  RETURN_NOT_OK(vfs_->file_size(fragment_metadata_uri, file_size));
+  if (*file_size < TileIO::GenericTileHeader::BASE_SIZE)
+    return Status::Ok();
+
+  // Older format versions store the metadata in a single generic tile,
+  // whereas newer ones append the sections, the footer and its size
+  TileIO::GenericTileHeader header;
+  Buffer prefetched;
+  RETURN_NOT_OK(TileIO::read_generic_tile_header(
+      this,
+      fragment_metadata_uri,
+      0,
+      std::min(
+          *file_size,
+          TileIO::GenericTileHeader::BASE_SIZE +
+              TileIO::GenericTileHeader::FILTERS_PREFETCH_SIZE),
+      &header,
+      &prefetched));
+  auto tile_size = TileIO::GenericTileHeader::BASE_SIZE +
+                   header.filter_pipeline_size + header.persisted_size;
+  *version = header.version_number;
+  if (*version >= constants::fragment_metadata_sections_version)
+    *is_fragment = *file_size > tile_size + sizeof(uint64_t);
+  else
+    *is_fragment = *file_size == tile_size;
+
+  return Status::Ok();
+}
+
 Status StorageManager::get_fragment_uris(
     const URI& array_uri, std::vector<URI>* fragment_uris) const {
   // Get all uris in the array directory
@@ -1738,6 +2196,39 @@ Status StorageManager::get_fragment_uris(
   return Status::Ok();
 }
 
+Status StorageManager::get_new_fragment_uris(
+    const OpenArray* open_array,
+    uint64_t timestamp,
+    std::vector<std::pair<uint64_t, URI>>* new_fragment_uris,
+    std::unordered_set<std::string>* loaded_fragment_uris) const {
+  // Get all uris in the array directory
+  std::vector<URI> uris;
+  RETURN_NOT_OK(vfs_->ls(open_array->array_uri().add_trailing_slash(), &uris));
+
+  // Get only the fragment uris that are not already loaded. The URIs of
+  // the loaded fragments are known to be valid fragments, so they do not
+  // need to be checked again.
+  std::vector<URI> fragment_uris;
+  bool exists;
+  for (auto& uri : uris) {
+    if (utils::parse::starts_with(uri.last_path_part(), "."))
+      continue;
+
+    if (open_array->fragment_metadata(uri) != nullptr) {
+      loaded_fragment_uris->insert(uri.to_string());
+      continue;
+    }
+
+    RETURN_NOT_OK(is_fragment(uri, &exists))
+    if (exists)
+      fragment_uris.push_back(uri);
+  }
+
+  get_sorted_fragment_uris(fragment_uris, timestamp, new_fragment_uris);
+
+  return Status::Ok();
+}
+
 Status StorageManager::load_array_schema(
     const URI& array_uri,
     ObjectType object_type,
@@ -1769,12 +2260,9 @@ Status StorageManager::load_fragment_metadata(
     auto frag_uri = sf.second;
     auto metadata = open_array->fragment_metadata(frag_uri);
     if (metadata == nullptr) {  // Fragment metadata does not exist - load it
-      URI coords_uri =
-          frag_uri.join_path(constants::coords + constants::file_suffix);
-      bool sparse;
-      RETURN_NOT_OK(vfs_->is_file(coords_uri, &sparse));
+      // Whether the fragment is dense is read from its metadata
       metadata = new FragmentMetadata(
-          open_array->array_schema(), !sparse, frag_uri, frag_timestamp);
+          open_array->array_schema(), true, frag_uri, frag_timestamp);
       bool metadata_in_cache;
       RETURN_NOT_OK_ELSE(
           load_fragment_metadata(metadata, encryption_key, &metadata_in_cache),
@@ -1822,5 +2310,21 @@ void StorageManager::get_sorted_fragment_uris(
   std::sort(sorted_fragment_uris->begin(), sorted_fragment_uris->end());
 }
 
+Status StorageManager::store_fragment_metadata_tile(
+    const URI& fragment_metadata_uri,
+    Buffer* buff,
+    const EncryptionKey& encryption_key,
+    uint64_t* nbytes) {
+  buff->reset_offset();
+  Tile tile(
+      constants::generic_tile_datatype,
+      constants::generic_tile_cell_size,
+      0,
+      buff,
+      false);
+  TileIO tile_io(this, fragment_metadata_uri);
+  return tile_io.write_generic(&tile, encryption_key, nbytes);
+}
+
 }  // namespace sm
 }  // namespace tiledb
@@ -42,8 +42,10 @@
 #include <queue>
 #include <string>
 #include <thread>
+#include <unordered_set>
 
 #include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/buffer/buffer_pool.h"
 #include "tiledb/sm/cache/lru_cache.h"
 #include "tiledb/sm/encryption/encryption.h"
 #include "tiledb/sm/encryption/encryption_key_validation.h"
@@ -58,6 +60,7 @@
 #include "tiledb/sm/storage_manager/config.h"
 #include "tiledb/sm/storage_manager/consolidator.h"
 #include "tiledb/sm/storage_manager/open_array.h"
+#include "tiledb/sm/storage_manager/write_coalescer.h"
 
 namespace tiledb {
 namespace sm {
@@ -110,9 +113,14 @@ class StorageManager {
    * Closes an array opened for reads.
    *
    * @param array_uri The array URI
+   * @param fragment_metadata The fragment metadata retrieved when the array
+   *     was opened (or reopened), which the array releases.
    * @return Status
    */
-  Status array_close_for_reads(const URI& array_uri);
+  Status array_close_for_reads(
+      const URI& array_uri,
+      const std::vector<FragmentMetadata*>& fragment_metadata =
+          std::vector<FragmentMetadata*>());
 
   /**
    * Closes an array opened for writes.
@@ -180,7 +188,9 @@ class StorageManager {
   /**
    * Reopens an already open array at a potentially new timestamp,
    * retrieving the fragment metadata of any new fragments written
-   * in the array.
+   * in the array. The metadata of the fragments that are already held
+   * by the open array are reused, i.e., only the fragments that were
+   * not seen before are checked and have their metadata loaded.
    *
    * @param array_uri The array URI.
    * @param timestamp The timestamp at which the array will be opened.
@@ -189,6 +199,8 @@ class StorageManager {
    * @param encryption_key The encryption key to use.
    * @param array_schema The array schema to be retrieved after the
    *     array is opened.
+   * @param old_fragment_metadata The fragment metadata retrieved when the
+   *     array was last opened, which the array releases.
    * @param fragment_metadata The fragment metadata to be retrieved
    *     after the array is opened.
    * @return Status
@@ -198,28 +210,9 @@ class StorageManager {
       uint64_t timestamp,
       const EncryptionKey& encryption_key,
       ArraySchema** array_schema,
+      const std::vector<FragmentMetadata*>& old_fragment_metadata,
       std::vector<FragmentMetadata*>* fragment_metadata);
 
-  /**
-   * Computes an estimate on the buffer sizes required for a read
-   * query, for a given subarray and set of attributes.
-   *
-   * @param array_schema The array schema
-   * @param fragment_metadata The fragment metadata of the array.
-   * @param subarray The subarray to focus on. Note that it must have the same
-   *     underlying type as the array domain.
-   * @param buffer_sizes The buffer sizes to be retrieved. This is a map
-   *     from an attribute to a size pair. For fixed-sized attributes, only
-   *     the first size is useful. For var-sized attributes, the first size
-   *     is the offsets size, and the second size is the values size.
-   * @return Status
-   */
-  Status array_compute_est_read_buffer_sizes(
-      const ArraySchema* array_schema,
-      const std::vector<FragmentMetadata*>& fragment_metadata,
-      const void* subarray,
-      std::unordered_map<std::string, std::pair<double, double>>* buffer_sizes);
-
   /**
    * Consolidates the fragments of an array into a single one.
    *
@@ -295,9 +288,34 @@ class StorageManager {
    */
   Status array_xlock(const URI& array_uri);
 
+  /**
+   * Same as `array_xlock`, but gives up if the array is still open for
+   * reads after `timeout_ms` milliseconds.
+   *
+   * @param array_uri The URI of the array to lock.
+   * @param timeout_ms The maximum time (in ms) to wait for the array to
+   *     be closed for reads.
+   * @param locked Set to `true` if the array got locked.
+   * @return Status
+   */
+  Status array_xlock(const URI& array_uri, uint64_t timeout_ms, bool* locked);
+
   /** Releases an exclusive lock for the input array. */
   Status array_xunlock(const URI& array_uri);
 
+  /**
+   * Waits for the input array to be closed for reads, as `array_xlock`
+   * does, without locking it.
+   *
+   * @param array_uri The URI of the array.
+   * @param timeout_ms The maximum time (in ms) to wait for the array to
+   *     be closed for reads.
+   * @param closed Set to `true` if the array got closed for reads.
+   * @return Status
+   */
+  Status array_wait_closed_for_reads(
+      const URI& array_uri, uint64_t timeout_ms, bool* closed);
+
   /**
    * Pushes an async query to the queue.
    *
@@ -306,6 +324,12 @@ class StorageManager {
    */
   Status async_push_query(Query* query);
 
+  /**
+   * Returns the pool that tile and filter buffers allocate from, or `nullptr`
+   * if pooling is disabled.
+   */
+  BufferPool* buffer_pool() const;
+
   /** Cancels all background tasks. */
   Status cancel_all_tasks();
 
@@ -318,6 +342,23 @@ class StorageManager {
   /** Creates a directory with the input URI. */
   Status create_dir(const URI& uri);
 
+  /**
+   * Writes the writes buffered by write coalescing to all arrays, returning
+   * once their fragments are written.
+   *
+   * @return Status
+   */
+  Status flush_writes();
+
+  /**
+   * Writes the writes buffered by write coalescing to the input array,
+   * returning once their fragment is written.
+   *
+   * @param array_uri The URI of the array.
+   * @return Status
+   */
+  Status flush_writes(const URI& array_uri);
+
   /** Creates an empty file with the input URI. */
   Status touch(const URI& uri);
 
@@ -339,6 +380,12 @@ class StorageManager {
       const EncryptionKey& encryption_key,
       std::vector<FragmentInfo>* fragment_info);
 
+  /**
+   * Returns the number of tile bytes read along with the header of a generic
+   * tile, in the same request.
+   */
+  uint64_t generic_tile_prefetch_size() const;
+
   /**
    * Gets the fragment info for a single fragment URI.
    *
@@ -448,7 +495,10 @@ class StorageManager {
 
   /**
    * Loads the fragment metadata of an array from persistent storage into
-   * memory.
+   * memory. For fragments written in format version
+   * `constants::fragment_metadata_sections_version` or later, only the
+   * metadata footer is loaded; the per-attribute and MBR sections are loaded
+   * on demand via `FragmentMetadata::load_sections`.
    *
    * @param metadata The fragment metadata to be loaded.
    * @param encryption_key The encryption key to use.
@@ -460,6 +510,26 @@ class StorageManager {
       const EncryptionKey& encryption_key,
       bool* in_cache);
 
+  /**
+   * Loads a single section of the fragment metadata, which is stored as a
+   * separate generic tile in the fragment metadata file. The section is
+   * retrieved from the fragment metadata cache if possible.
+   *
+   * @param fragment_uri The URI of the fragment.
+   * @param offset The offset of the section in the fragment metadata file.
+   * @param max_size The maximum size of the generic tile of the section in
+   *     the file, or 0 if it is unknown.
+   * @param encryption_key The encryption key to use.
+   * @param buff The buffer that will store the (unfiltered) section.
+   * @return Status
+   */
+  Status load_fragment_metadata_section(
+      const URI& fragment_uri,
+      uint64_t offset,
+      uint64_t max_size,
+      const EncryptionKey& encryption_key,
+      Buffer* buff);
+
   /** Removes a TileDB object (group, array, kv). */
   Status object_remove(const char* path) const;
 
@@ -585,9 +655,6 @@ class StorageManager {
       uint64_t nbytes,
       bool* in_cache) const;
 
-  /** Returns the Reader thread pool. */
-  ThreadPool* reader_thread_pool() const;
-
   /**
    * Reads from a file into the input buffer.
    *
@@ -627,12 +694,25 @@ class StorageManager {
   /** Syncs a file or directory, flushing its contents to persistent storage. */
   Status sync(const URI& uri);
 
-  /** Returns the Writer thread pool. */
-  ThreadPool* writer_thread_pool() const;
+  /**
+   * Returns the thread pool of this context, which runs all its parallel
+   * work: async queries, the I/O and the parallel loops and sorts of the
+   * queries and the filter pipeline, and background consolidation.
+   */
+  ThreadPool* thread_pool() const;
 
   /** Returns the virtual filesystem object. */
   VFS* vfs() const;
 
+  /** Returns the write coalescer, buffering small unordered writes. */
+  WriteCoalescer* write_coalescer() const;
+
+  /**
+   * Waits until no background consolidation is queued or running, including
+   * the follow-up runs scheduled meanwhile.
+   */
+  void wait_for_consolidations();
+
   /**
    * Writes the contents of a buffer into the cache. `uri` and `offset`
    * collectively form the key of the object to be cached. Essentially, this is
@@ -661,6 +741,71 @@ class StorageManager {
   /*        PRIVATE DATATYPES          */
   /* ********************************* */
 
+  /** The state of the background consolidation of an array. */
+  struct AutoConsolidationState {
+    /**
+     * `true` if a background consolidation is scheduled, queued or
+     * running.
+     */
+    bool pending_;
+    /**
+     * `true` if a background consolidation is scheduled to be queued at
+     * `next_run_ms_` by the scheduler thread.
+     */
+    bool scheduled_;
+    /** Time (in ms) at which the scheduled consolidation is queued. */
+    uint64_t next_run_ms_;
+    /** The encryption type of the array, for the scheduled consolidation. */
+    EncryptionType encryption_type_;
+    /** The encryption key of the array, for the scheduled consolidation. */
+    std::vector<uint8_t> encryption_key_;
+    /** `true` if fragments were written while consolidation was running. */
+    bool dirty_;
+    /** Time (in ms) at which the last background consolidation started. */
+    uint64_t last_run_ms_;
+    /** Bytes of the fragments written to the array by queries. */
+    uint64_t bytes_written_;
+    /** Bytes of the fragments rewritten by background consolidation. */
+    uint64_t bytes_consolidated_;
+    /** Number of consecutive runs that could not lock the array. */
+    uint32_t xlock_retries_;
+    /**
+     * `true` if the last background consolidation consolidated fragments
+     * and left nothing to consolidate. The state is then dropped by the
+     * scheduler thread once the rate limit has passed. This forgets the
+     * unused byte budget, which keeps the write amplification within the
+     * limit since the bytes written and consolidated restart together.
+     */
+    bool done_;
+
+    /** Constructor. */
+    AutoConsolidationState() {
+      pending_ = false;
+      scheduled_ = false;
+      next_run_ms_ = 0;
+      encryption_type_ = EncryptionType::NO_ENCRYPTION;
+      dirty_ = false;
+      last_run_ms_ = 0;
+      bytes_written_ = 0;
+      bytes_consolidated_ = 0;
+      xlock_retries_ = 0;
+      done_ = false;
+    }
+  };
+
+  /** A mutex serializing the consolidations of an array. */
+  struct ConsolidationMutex {
+    /** The mutex. */
+    std::mutex mtx_;
+    /** Number of consolidations holding or waiting for the mutex. */
+    uint64_t cnt_;
+
+    /** Constructor. */
+    ConsolidationMutex() {
+      cnt_ = 0;
+    }
+  };
+
   /**
    * Helper RAII struct that increments 'queries_in_progress' in the constructor
    * and decrements in the destructor, on the given StorageManager instance.
@@ -691,6 +836,49 @@ class StorageManager {
   /** An array schema cache. */
   LRUCache* array_schema_cache_;
 
+  /**
+   * The pool of tile and filter buffer allocations, shared by all queries.
+   * Declared before the thread pools so that it outlives their tasks.
+   */
+  std::unique_ptr<BufferPool> buffer_pool_;
+
+  /** Notified when a background consolidation of an array ends. */
+  std::condition_variable auto_consolidation_cv_;
+
+  /**
+   * Wakes up the scheduler thread upon a newly scheduled background
+   * consolidation, and upon destruction.
+   */
+  std::condition_variable auto_consolidation_scheduler_cv_;
+
+  /**
+   * The thread queueing the background consolidations scheduled to run
+   * later, once they are due. This is started only if
+   * `sm.consolidation.auto` is enabled.
+   */
+  std::thread auto_consolidation_scheduler_;
+
+  /** Mutex protecting auto_consolidation_state_ and consolidation_mtxs_. */
+  std::mutex auto_consolidation_mtx_;
+
+  /** Set to true when the background consolidation tasks must exit. */
+  bool auto_consolidation_stop_;
+
+  /**
+   * The number of background consolidations queued in or running on the
+   * thread pool, which is at most `auto_consolidation_max_queued_`.
+   */
+  uint64_t auto_consolidation_num_queued_;
+
+  /**
+   * The maximum number of background consolidations queued in or running on
+   * the thread pool (see `sm.num_consolidation_threads`).
+   */
+  uint64_t auto_consolidation_max_queued_;
+
+  /** Map of array URI -> state of its background consolidation. */
+  std::map<std::string, AutoConsolidationState> auto_consolidation_state_;
+
   /** Set to true when tasks are being cancelled. */
   bool cancellation_in_progress_;
 
@@ -707,6 +895,13 @@ class StorageManager {
   /** Mutex for providing thread-safety upon creating TileDB objects. */
   std::mutex object_create_mtx_;
 
+  /**
+   * Map of array URI -> mutex serializing the consolidations of the array
+   * issued through this storage manager (by the user or in the background).
+   * An entry is erased when the last consolidation holding it releases it.
+   */
+  std::map<std::string, ConsolidationMutex> consolidation_mtxs_;
+
   /** Stores the TileDB configuration parameters. */
   Config config_;
 
@@ -716,6 +911,12 @@ class StorageManager {
   /** A fragment metadata cache. */
   LRUCache* fragment_metadata_cache_;
 
+  /**
+   * The number of tile bytes read along with the header of a generic tile, in
+   * the same request.
+   */
+  uint64_t generic_tile_prefetch_size_;
+
   /** Mutex for managing OpenArray objects for reads. */
   std::mutex open_array_for_reads_mtx_;
 
@@ -751,14 +952,17 @@ class StorageManager {
   /** Guards queries_in_progress_ counter. */
   std::condition_variable queries_in_progress_cv_;
 
-  /** The storage manager's thread pool for async queries. */
-  std::unique_ptr<ThreadPool> async_thread_pool_;
-
-  /** The storage manager's thread pool for Readers. */
-  std::unique_ptr<ThreadPool> reader_thread_pool_;
+  /**
+   * The storage manager's thread pool, shared by all the parallel work of
+   * this context (see `thread_pool()`).
+   */
+  std::unique_ptr<ThreadPool> thread_pool_;
 
-  /** The storage manager's thread pool for Writers. */
-  std::unique_ptr<ThreadPool> writer_thread_pool_;
+  /**
+   * Buffers the unordered writes of this context, if
+   * `sm.write_coalescing.max_bytes` is non-zero.
+   */
+  std::unique_ptr<WriteCoalescer> write_coalescer_;
 
   /** A tile cache. */
   LRUCache* tile_cache_;
@@ -773,6 +977,80 @@ class StorageManager {
   /*         PRIVATE METHODS           */
   /* ********************************* */
 
+  /**
+   * Consolidates the input array in the background. The fragments rewritten
+   * are
+   * bounded by `sm.consolidation.auto_max_bytes`, and by
+   * `sm.consolidation.auto_write_amplification` times the bytes written to
+   * the array, minus the bytes already rewritten. If fragments were
+   * written in the meantime, another background consolidation is queued.
+   *
+   * If the array cannot be locked because it is kept open for reads in
+   * this context, the run gives up before rewriting any fragment and is
+   * retried after `constants::consolidation_auto_xlock_backoff_ms`,
+   * doubling upon every retry, up to
+   * `constants::consolidation_auto_xlock_max_retries` times.
+   *
+   * @param array_uri The URI of the array to consolidate.
+   * @param encryption_type The encryption type of the array.
+   * @param encryption_key The encryption key of the array (empty if
+   *     unencrypted).
+   * @return Status
+   */
+  Status auto_consolidate(
+      const std::string& array_uri,
+      EncryptionType encryption_type,
+      const std::vector<uint8_t>& encryption_key);
+
+  /**
+   * Queues a background consolidation of the input array, or schedules it
+   * to be queued by the scheduler thread once
+   * `sm.consolidation.auto_interval_ms` (or the backoff after failing to
+   * lock the array) has elapsed since the previous run and fewer than
+   * `sm.num_consolidation_threads` background consolidations are queued,
+   * so that waiting does not hold a thread of the pool. The caller must
+   * hold `auto_consolidation_mtx_`.
+   */
+  void auto_consolidate_enqueue(
+      const std::string& array_uri,
+      EncryptionType encryption_type,
+      const std::vector<uint8_t>& encryption_key);
+
+  /**
+   * Accounts for a new fragment written by a query and queues a background
+   * consolidation of its array, unless one is already pending. Fragments
+   * produced by consolidation are ignored.
+   *
+   * @param metadata The metadata of the new fragment.
+   * @param metadata_size The size in bytes of the fragment metadata file.
+   * @param encryption_key The encryption key of the array.
+   * @return void
+   */
+  void auto_consolidate_notify(
+      const FragmentMetadata* metadata,
+      uint64_t metadata_size,
+      const EncryptionKey& encryption_key);
+
+  /**
+   * The loop of the scheduler thread, queueing the scheduled background
+   * consolidations once they are due and the number of queued ones allows,
+   * until `auto_consolidation_stop_` is set.
+   */
+  void auto_consolidation_schedule();
+
+  /**
+   * Returns the mutex serializing the consolidations of the input array,
+   * incrementing its counter. It must be matched by a call to
+   * `consolidation_mtx_release` once the mutex is unlocked.
+   */
+  std::mutex* consolidation_mtx_acquire(const std::string& array_uri);
+
+  /**
+   * Decrements the counter of the consolidation mutex of the input array,
+   * erasing the mutex when the counter reaches zero.
+   */
+  void consolidation_mtx_release(const std::string& array_uri);
+
   /**
    * Retrieves the non-empty domain from the input fragment metadata. This is
    * the union of the non-empty domains of the fragments.
@@ -788,28 +1066,6 @@ class StorageManager {
       unsigned dim_num,
       T* domain);
 
-  /**
-   * Computes an estimate on the buffer sizes required for a read
-   * query, for a given subarray and set of attributes.
-   *
-   * @tparam T The domain type
-   * @param array_schema The array schema.
-   * @param fragment_metadata The fragment metadata of the array.
-   * @param subarray The subarray to focus on. Note that it must have the same
-   *     underlying type as the array domain.
-   * @param buffer_sizes The buffer sizes to be retrieved. This is a map
-   *     from an attribute to a size pair. For fixed-sized attributes, only
-   *     the first size is useful. For var-sized attributes, the first size
-   *     is the offsets size, and the second size is the values size.
-   * @return Status
-   */
-  template <class T>
-  Status array_compute_est_read_buffer_sizes(
-      const ArraySchema* array_schema,
-      const std::vector<FragmentMetadata*>& fragment_metadata,
-      const T* subarray,
-      std::unordered_map<std::string, std::pair<double, double>>* buffer_sizes);
-
   /**
    * This is an auxiliary function to the other `array_open*` functions.
    * It opens the array, retrieves an `OpenArray` instance, acquires
@@ -850,6 +1106,27 @@ class StorageManager {
   Status get_fragment_uris(
       const URI& array_uri, std::vector<URI>* fragment_uris) const;
 
+  /**
+   * Retrieves the URIs of the fragments in the array directory whose
+   * metadata are not already loaded in the input open array. Only the
+   * fragments with timestamp smaller than or equal to `timestamp` are
+   * considered. The URIs are sorted in ascending timestamp order and
+   * are stored along with the fragment timestamps.
+   *
+   * @param open_array The open array object.
+   * @param timestamp The timestamp to focus on.
+   * @param new_fragment_uris The new fragment (timestamp, URI) pairs
+   *     to be retrieved.
+   * @param loaded_fragment_uris The URIs of the fragments in the array
+   *     directory whose metadata are already loaded.
+   * @return Status
+   */
+  Status get_new_fragment_uris(
+      const OpenArray* open_array,
+      uint64_t timestamp,
+      std::vector<std::pair<uint64_t, URI>>* new_fragment_uris,
+      std::unordered_set<std::string>* loaded_fragment_uris) const;
+
   /** Increment the count of in-progress queries. */
   void increment_in_progress();
 
@@ -894,6 +1171,70 @@ class StorageManager {
       bool* in_cache,
       std::vector<FragmentMetadata*>* fragment_metadata);
 
+  /**
+   * Retrieves the offset of the generic tile that must be deserialized first
+   * when loading fragment metadata. This is the footer for format versions
+   * that store the metadata in sections, and 0 (i.e., the entire metadata)
+   * for older versions.
+   *
+   * The footer size is stored at the end of the file. It is read in one
+   * request along with up to `sm.generic_tile_prefetch_size` preceding
+   * bytes, which typically contain the entire footer.
+   *
+   * @param fragment_metadata_uri The URI of the fragment metadata file.
+   * @param file_size The size of the fragment metadata file.
+   * @param version The format version of the fragment metadata file.
+   * @param offset The offset to be retrieved.
+   * @param size Set to the size of the generic tile at `offset`, header
+   *     included.
+   * @param footer Set to the bytes of the generic tile at `offset` that
+   *     were read along with the footer size, i.e., the entire tile or
+   *     nothing.
+   * @return Status
+   */
+  Status fragment_metadata_footer_offset(
+      const URI& fragment_metadata_uri,
+      uint64_t file_size,
+      uint32_t version,
+      uint64_t* offset,
+      uint64_t* size,
+      Buffer* footer) const;
+
+  /**
+   * Same as `is_fragment`, but also retrieves the size and the format
+   * version of the fragment metadata file, so that loading the metadata
+   * does not need to look them up again.
+   *
+   * @param fragment_uri The URI to be checked.
+   * @param is_fragment Set to `true` if the URI is a fragment and `false`
+   *     otherwise.
+   * @param file_size Set to the size of the fragment metadata file, if the
+   *     URI is a fragment.
+   * @param version Set to the format version of the fragment metadata
+   *     file, if the URI is a fragment.
+   * @return Status
+   */
+  Status fragment_metadata_file_info(
+      const URI& fragment_uri,
+      bool* is_fragment,
+      uint64_t* file_size,
+      uint32_t* version) const;
+
+  /**
+   * Appends the input buffer as a generic tile to a fragment metadata file.
+   *
+   * @param fragment_metadata_uri The URI of the fragment metadata file.
+   * @param buff The buffer to write.
+   * @param encryption_key The encryption key to use.
+   * @param nbytes Set to the number of bytes appended to the file.
+   * @return Status
+   */
+  Status store_fragment_metadata_tile(
+      const URI& fragment_metadata_uri,
+      Buffer* buff,
+      const EncryptionKey& encryption_key,
+      uint64_t* nbytes);
+
   /**
    * Gets the sorted fragment URIs based on the first input
    * in ascending timestamp order, breaking ties with lexicographic sorting
@@ -0,0 +1,441 @@
+/**
+ * @file   write_coalescer.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class WriteCoalescer.
+ */
+
+#include "tiledb/sm/storage_manager/write_coalescer.h"
+#include "tiledb/sm/array/array.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/misc/utils.h"
+#include "tiledb/sm/query/query.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+WriteCoalescer::WriteCoalescer(StorageManager* storage_manager)
+    : storage_manager_(storage_manager) {
+  max_bytes_ = 0;
+  max_age_ms_ = 0;
+  stop_ = false;
+}
+
+WriteCoalescer::~WriteCoalescer() {
+  stop();
+
+  // The storage manager may no longer be able to write, so drop the writes
+  // that are still buffered, e.g., those of a failed final flush
+  std::lock_guard<std::mutex> lock{mtx_};
+  for (const auto& it : pending_)
+    LOG_STATUS(Status::StorageManagerError(
+        "Dropping buffered writes to array '" + it.first +
+        "'; The writes could not be flushed"));
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status WriteCoalescer::append(
+    const Array* array,
+    const std::unordered_map<std::string, AttributeBuffer>& buffers) {
+  STATS_FUNC_IN(sm_write_coalescer_append);
+
+  const auto& array_uri = array->array_uri();
+  bool full;
+  {
+    std::lock_guard<std::mutex> lock{mtx_};
+
+    // Report the failure of the last background flush
+    auto error_it = errors_.find(array_uri.to_string());
+    if (error_it != errors_.end()) {
+      Status st = error_it->second;
+      errors_.erase(error_it);
+      return st;
+    }
+
+    auto& pending = pending_[array_uri.to_string()];
+    if (pending == nullptr) {
+      pending.reset(new PendingWrites());
+      pending->first_write_ms_ = utils::time::timestamp_now_ms();
+      const auto& encryption_key = array->get_encryption_key();
+      auto key = encryption_key.key();
+      pending->encryption_type_ = encryption_key.encryption_type();
+      pending->encryption_key_.assign(
+          (const uint8_t*)key.data(), (const uint8_t*)key.data() + key.size());
+      cv_.notify_all();
+    }
+
+    // Append the values, shifting the offsets of var-sized attributes by
+    // the size of the values already buffered
+    for (const auto& it : buffers) {
+      auto& buffer = it.second;
+      auto& dest = pending->buffers_[it.first];
+      if (buffer.buffer_var_ != nullptr) {
+        auto start = dest.first.size();
+        RETURN_NOT_OK(dest.first.write(buffer.buffer_, *buffer.buffer_size_));
+        auto offsets = (uint64_t*)dest.first.data(start);
+        auto offset_num = *buffer.buffer_size_ / sizeof(uint64_t);
+        for (uint64_t i = 0; i < offset_num; ++i)
+          offsets[i] += dest.second.size();
+        RETURN_NOT_OK(
+            dest.second.write(buffer.buffer_var_, *buffer.buffer_var_size_));
+        pending->size_ += *buffer.buffer_var_size_;
+      } else {
+        RETURN_NOT_OK(dest.first.write(buffer.buffer_, *buffer.buffer_size_));
+      }
+      pending->size_ += *buffer.buffer_size_;
+    }
+
+    auto coords_it = buffers.find(constants::coords);
+    auto cell_num = (coords_it == buffers.end()) ?
+                        0 :
+                        *coords_it->second.buffer_size_ /
+                            array->array_schema()->coords_size();
+    auto prev_end =
+        pending->write_ends_.empty() ? 0 : pending->write_ends_.back();
+    pending->write_ends_.push_back(prev_end + cell_num);
+    full = pending->size_ >= max_bytes_;
+  }
+
+  STATS_COUNTER_ADD(sm_write_coalescer_writes, 1);
+
+  if (full)
+    return flush(array_uri);
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(sm_write_coalescer_append);
+}
+
+bool WriteCoalescer::enabled() const {
+  return max_bytes_ > 0;
+}
+
+Status WriteCoalescer::flush(const URI& array_uri) {
+  std::lock_guard<std::mutex> flush_lock{flush_mtx_};
+  std::unique_ptr<PendingWrites> pending;
+  {
+    std::lock_guard<std::mutex> lock{mtx_};
+    auto it = pending_.find(array_uri.to_string());
+    if (it == pending_.end())
+      return Status::Ok();
+    pending = std::move(it->second);
+    pending_.erase(it);
+
+    // The outcome of this flush supersedes that of the last one
+    errors_.erase(array_uri.to_string());
+  }
+
+  bool retry;
+  Status st = write(array_uri, pending.get(), &retry);
+  if (!st.ok() && retry) {
+    Status st_restore = restore(array_uri.to_string(), std::move(pending));
+    if (!st_restore.ok())
+      LOG_STATUS(st_restore);
+  }
+
+  return st;
+}
+
+Status WriteCoalescer::flush_all() {
+  std::lock_guard<std::mutex> flush_lock{flush_mtx_};
+  std::map<std::string, std::unique_ptr<PendingWrites>> pending;
+  {
+    std::lock_guard<std::mutex> lock{mtx_};
+    pending.swap(pending_);
+    errors_.clear();
+  }
+
+  // Write all arrays, returning the first error
+  Status ret = Status::Ok();
+  for (auto& it : pending) {
+    bool retry;
+    Status st = write(URI(it.first), it.second.get(), &retry);
+    if (!st.ok() && retry) {
+      Status st_restore = restore(it.first, std::move(it.second));
+      if (!st_restore.ok())
+        LOG_STATUS(st_restore);
+    }
+    if (ret.ok() && !st.ok())
+      ret = st;
+  }
+
+  return ret;
+}
+
+Status WriteCoalescer::init(uint64_t max_bytes, uint64_t max_age_ms) {
+  max_bytes_ = max_bytes;
+  max_age_ms_ = max_age_ms;
+
+  if (max_bytes_ > 0 && max_age_ms_ > 0) {
+    try {
+      flush_thread_ = std::thread([this]() { flush_expired(); });
+    } catch (const std::exception& e) {
+      return LOG_STATUS(Status::StorageManagerError(
+          std::string("Cannot start write coalescing thread; ") + e.what()));
+    }
+  }
+
+  return Status::Ok();
+}
+
+void WriteCoalescer::stop() {
+  {
+    std::lock_guard<std::mutex> lock{mtx_};
+    stop_ = true;
+  }
+  cv_.notify_all();
+  if (flush_thread_.joinable())
+    flush_thread_.join();
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+Status WriteCoalescer::dedup(
+    const ArraySchema* array_schema, PendingWrites* pending) const {
+  auto coords_it = pending->buffers_.find(constants::coords);
+  if (coords_it == pending->buffers_.end())
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot flush buffered writes; Coordinates not buffered"));
+
+  // Find the last write of each coordinate tuple
+  const auto& coords = coords_it->second.first;
+  auto coords_size = array_schema->coords_size();
+  auto cell_num = coords.size() / coords_size;
+  auto& write_ends = pending->write_ends_;
+  auto write_num = write_ends.size();
+  std::unordered_map<std::string, uint64_t> last;
+  last.reserve(cell_num);
+  for (uint64_t w = 0, i = 0; w < write_num; ++w) {
+    for (; i < write_ends[w]; ++i)
+      last[std::string(
+          (const char*)coords.data(i * coords_size), coords_size)] = w;
+  }
+  if (last.size() == cell_num)
+    return Status::Ok();
+
+  // Keep the cells of the last write of their coordinates, along with the
+  // duplicates within that write
+  std::vector<uint64_t> cells;
+  cells.reserve(last.size());
+  for (uint64_t w = 0, i = 0; w < write_num; ++w) {
+    for (; i < write_ends[w]; ++i) {
+      std::string key((const char*)coords.data(i * coords_size), coords_size);
+      if (last[key] == w)
+        cells.push_back(i);
+    }
+    write_ends[w] = cells.size();
+  }
+  if (cells.size() == cell_num)
+    return Status::Ok();
+
+  // Keep only those cells in every buffer
+  for (auto& it : pending->buffers_) {
+    const auto& name = it.first;
+    auto& buffers = it.second;
+    Buffer kept, kept_var;
+    if (name != constants::coords && array_schema->var_size(name)) {
+      auto offsets = (const uint64_t*)buffers.first.data();
+      auto values_size = buffers.second.size();
+      for (auto cell : cells) {
+        auto start = offsets[cell];
+        auto end = (cell + 1 < cell_num) ? offsets[cell + 1] : values_size;
+        auto offset = kept_var.size();
+        RETURN_NOT_OK(kept.write(&offset, sizeof(uint64_t)));
+        RETURN_NOT_OK(kept_var.write(buffers.second.data(start), end - start));
+      }
+    } else {
+      auto cell_size = (name == constants::coords) ?
+                           coords_size :
+                           array_schema->cell_size(name);
+      for (auto cell : cells)
+        RETURN_NOT_OK(
+            kept.write(buffers.first.data(cell * cell_size), cell_size));
+    }
+    RETURN_NOT_OK(buffers.first.swap(kept));
+    RETURN_NOT_OK(buffers.second.swap(kept_var));
+  }
+
+  return Status::Ok();
+}
+
+void WriteCoalescer::flush_expired() {
+  std::unique_lock<std::mutex> lock{mtx_};
+  while (!stop_) {
+    // Find the arrays whose buffered writes expired, and the time at which
+    // the next ones expire
+    auto now = utils::time::timestamp_now_ms();
+    auto wait_ms = max_age_ms_;
+    std::vector<URI> expired;
+    for (const auto& it : pending_) {
+      auto expiry_ms = it.second->first_write_ms_ + max_age_ms_;
+      if (expiry_ms <= now)
+        expired.emplace_back(it.first);
+      else
+        wait_ms = std::min(wait_ms, expiry_ms - now);
+    }
+
+    if (!expired.empty()) {
+      lock.unlock();
+      for (const auto& array_uri : expired) {
+        Status st = flush(array_uri);
+        if (!st.ok()) {
+          LOG_STATUS(st);
+          // Report the error upon the next write to the array
+          std::lock_guard<std::mutex> error_lock{mtx_};
+          errors_[array_uri.to_string()] = st;
+        }
+      }
+      lock.lock();
+      continue;
+    }
+
+    cv_.wait_for(lock, std::chrono::milliseconds(wait_ms));
+  }
+}
+
+Status WriteCoalescer::restore(
+    const std::string& array_uri, std::unique_ptr<PendingWrites> pending) {
+  std::lock_guard<std::mutex> lock{mtx_};
+  auto& newer = pending_[array_uri];
+  if (newer != nullptr) {
+    // Append the newer writes, shifting the offsets of var-sized attributes
+    // by the size of the values of the restored writes
+    for (auto& it : newer->buffers_) {
+      auto& src = it.second;
+      auto& dest = pending->buffers_[it.first];
+      auto start = dest.first.size();
+      RETURN_NOT_OK(dest.first.write(src.first.data(), src.first.size()));
+      if (src.second.size() > 0 || dest.second.size() > 0) {
+        auto offsets = (uint64_t*)dest.first.data(start);
+        auto offset_num = src.first.size() / sizeof(uint64_t);
+        for (uint64_t i = 0; i < offset_num; ++i)
+          offsets[i] += dest.second.size();
+        RETURN_NOT_OK(
+            dest.second.write(src.second.data(), src.second.size()));
+      }
+    }
+    auto cell_num =
+        pending->write_ends_.empty() ? 0 : pending->write_ends_.back();
+    for (auto end : newer->write_ends_)
+      pending->write_ends_.push_back(cell_num + end);
+    pending->size_ += newer->size_;
+  }
+
+  pending->first_write_ms_ = utils::time::timestamp_now_ms();
+  newer = std::move(pending);
+  cv_.notify_all();
+
+  return Status::Ok();
+}
+
+Status WriteCoalescer::write(
+    const URI& array_uri, PendingWrites* pending, bool* retry) const {
+  STATS_FUNC_IN(sm_write_coalescer_flush);
+
+  // Failing to open the array may be temporary, e.g., while it is moved
+  *retry = true;
+  Array array(array_uri, storage_manager_);
+  RETURN_NOT_OK(array.open(
+      QueryType::WRITE,
+      pending->encryption_type_,
+      pending->encryption_key_.empty() ? nullptr :
+                                         pending->encryption_key_.data(),
+      (uint32_t)pending->encryption_key_.size()));
+
+  Status st = dedup(array.array_schema(), pending);
+  if (!st.ok()) {
+    *retry = false;
+    array.close();
+    return st;
+  }
+
+  // Submit the buffered values as a single unordered write, bypassing
+  // the coalescer
+  std::map<std::string, std::pair<uint64_t, uint64_t>> sizes;
+  Query query(storage_manager_, &array);
+  st = query.set_layout(Layout::UNORDERED);
+  if (st.ok())
+    st = query.set_coalesce_writes(false);
+  for (auto& it : pending->buffers_) {
+    if (!st.ok())
+      break;
+    auto& buffers = it.second;
+    auto& size = sizes[it.first];
+    size.first = buffers.first.size();
+    size.second = buffers.second.size();
+    if (it.first != constants::coords &&
+        array.array_schema()->var_size(it.first))
+      st = query.set_buffer(
+          it.first,
+          (uint64_t*)buffers.first.data(),
+          &size.first,
+          buffers.second.data(),
+          &size.second);
+    else
+      st = query.set_buffer(it.first, buffers.first.data(), &size.first);
+  }
+  if (st.ok())
+    st = query.submit();
+  if (st.ok())
+    st = query.finalize();
+  Status st_close = array.close();
+  if (!st.ok()) {
+    // Retrying cannot succeed unless the write failed on I/O
+    auto code = st.code();
+    *retry = code == StatusCode::IO || code == StatusCode::VFS ||
+             code == StatusCode::FS_S3 || code == StatusCode::FS_HDFS ||
+             code == StatusCode::TileIO || code == StatusCode::Mem ||
+             code == StatusCode::VFSFileHandleError;
+    return st;
+  }
+  RETURN_NOT_OK(st_close);
+
+  STATS_COUNTER_ADD(sm_write_coalescer_flushes, 1);
+  STATS_COUNTER_ADD(sm_write_coalescer_flush_bytes, pending->size_);
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(sm_write_coalescer_flush);
+}
+
+}  // namespace sm
+}  // namespace tiledb
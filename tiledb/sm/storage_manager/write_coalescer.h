@@ -0,0 +1,276 @@
+/**
+ * @file   write_coalescer.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class WriteCoalescer.
+ */
+
+#ifndef TILEDB_WRITE_COALESCER_H
+#define TILEDB_WRITE_COALESCER_H
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/enums/encryption_type.h"
+#include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/misc/uri.h"
+#include "tiledb/sm/query/types.h"
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+class Array;
+class ArraySchema;
+class StorageManager;
+
+/**
+ * Buffers the unordered writes of a context in memory per array, and writes
+ * the buffered writes of an array as a single fragment once their size
+ * exceeds `sm.write_coalescing.max_bytes`, once they are older than
+ * `sm.write_coalescing.max_age_ms`, or upon an explicit flush. This turns
+ * many small writes into a few larger fragments.
+ *
+ * Buffered writes are not durable: they are lost if the process exits
+ * before they are flushed. They become visible to reads once flushed, and
+ * the storage manager flushes the writes of an array before opening it for
+ * reads. Cells written by more than one buffered write keep the value of
+ * the latest write, as if each write had been its own fragment. Duplicate
+ * coordinates within a single write are handled by the writer as usual,
+ * according to `sm.check_coord_dups` and `sm.dedup_coords`.
+ *
+ * If a flush fails with an I/O error, or because the array could not be
+ * opened, the writes are buffered again ahead of the writes buffered since,
+ * and retried upon the next flush of the array (in the background, after
+ * another `max_age_ms`). If the writes themselves are rejected, they are
+ * dropped. The error of a failed flush is returned by the explicit flushes
+ * and the array opens that trigger it, while the error of a failed
+ * background flush is returned by the next write to the array.
+ */
+class WriteCoalescer {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param storage_manager The storage manager the buffered writes are
+   *     submitted to.
+   */
+  explicit WriteCoalescer(StorageManager* storage_manager);
+
+  /**
+   * Destructor. Stops the background flushes and drops the writes that are
+   * still buffered, logging an error for each array. The storage manager
+   * flushes the buffered writes before destroying the coalescer.
+   */
+  ~WriteCoalescer();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Buffers a write to the input array. If the last background flush of the
+   * buffered writes of the array failed, its error is returned instead and
+   * the write is not buffered.
+   *
+   * @param array The array opened for writes.
+   * @param buffers The attribute buffers of the write, which must contain
+   *     the coordinates and all the attributes.
+   * @return Status
+   */
+  Status append(
+      const Array* array,
+      const std::unordered_map<std::string, AttributeBuffer>& buffers);
+
+  /** Returns `true` if writes are buffered. */
+  bool enabled() const;
+
+  /**
+   * Writes the buffered writes of the input array, if any, as a single
+   * fragment. Returns once the fragment is written.
+   *
+   * @param array_uri The URI of the array.
+   * @return Status
+   */
+  Status flush(const URI& array_uri);
+
+  /**
+   * Writes the buffered writes of all arrays.
+   *
+   * @return Status
+   */
+  Status flush_all();
+
+  /**
+   * Initializes the coalescer, starting the background flushes if needed.
+   *
+   * @param max_bytes The size in bytes of the buffered writes of an array
+   *     above which they are flushed. Writes are not buffered if 0.
+   * @param max_age_ms The time in ms after which buffered writes are
+   *     flushed. Buffered writes are not flushed in the background if 0.
+   * @return Status
+   */
+  Status init(uint64_t max_bytes, uint64_t max_age_ms);
+
+  /**
+   * Stops the background flushes, waiting for a running one to finish.
+   * Buffered writes are kept, and can still be flushed explicitly.
+   */
+  void stop();
+
+ private:
+  /* ********************************* */
+  /*        PRIVATE DATATYPES          */
+  /* ********************************* */
+
+  /** The buffered writes of an array. */
+  struct PendingWrites {
+    /** The encryption type of the array. */
+    EncryptionType encryption_type_;
+    /** The encryption key of the array (empty if unencrypted). */
+    std::vector<uint8_t> encryption_key_;
+    /**
+     * Map of attribute name -> buffered values. For var-sized attributes,
+     * the first buffer holds the offsets and the second the values.
+     */
+    std::map<std::string, std::pair<Buffer, Buffer>> buffers_;
+    /** The number of cells buffered up to the end of each write. */
+    std::vector<uint64_t> write_ends_;
+    /** Time (in ms) of the first buffered write. */
+    uint64_t first_write_ms_;
+    /** Size in bytes of the buffered values. */
+    uint64_t size_;
+
+    /** Constructor. */
+    PendingWrites() {
+      encryption_type_ = EncryptionType::NO_ENCRYPTION;
+      first_write_ms_ = 0;
+      size_ = 0;
+    }
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** Notifies the background flush thread of new writes and of stopping. */
+  std::condition_variable cv_;
+
+  /**
+   * Map of array URI -> error of the last background flush of the array,
+   * not yet reported.
+   */
+  std::map<std::string, Status> errors_;
+
+  /** The thread flushing the buffered writes older than `max_age_ms_`. */
+  std::thread flush_thread_;
+
+  /**
+   * Serializes the flushes, so that the fragments of an array are written
+   * in the order of the writes they contain.
+   */
+  std::mutex flush_mtx_;
+
+  /** The size above which the buffered writes of an array are flushed. */
+  uint64_t max_bytes_;
+
+  /** The time in ms after which the buffered writes are flushed. */
+  uint64_t max_age_ms_;
+
+  /** Mutex protecting `errors_`, `pending_` and `stop_`. */
+  std::mutex mtx_;
+
+  /** Map of array URI -> buffered writes of the array. */
+  std::map<std::string, std::unique_ptr<PendingWrites>> pending_;
+
+  /** Set to true when the background flush thread must exit. */
+  bool stop_;
+
+  /** The storage manager. */
+  StorageManager* storage_manager_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Removes the cells whose coordinates appear again in a later buffered
+   * write, so that the latest write of each cell wins. Duplicates within
+   * a write are kept.
+   *
+   * @param array_schema The array schema.
+   * @param pending The buffered writes.
+   * @return Status
+   */
+  Status dedup(const ArraySchema* array_schema, PendingWrites* pending) const;
+
+  /** Flushes the buffered writes older than `max_age_ms_` until stopped. */
+  void flush_expired();
+
+  /**
+   * Buffers again the input writes, whose flush failed, ahead of the writes
+   * to the same array buffered since. They expire `max_age_ms_` from now.
+   * Must be called while holding `flush_mtx_`, so that no newer writes of
+   * the array are flushed in the meantime.
+   *
+   * @param array_uri The URI of the array.
+   * @param pending The writes whose flush failed.
+   * @return Status
+   */
+  Status restore(
+      const std::string& array_uri, std::unique_ptr<PendingWrites> pending);
+
+  /**
+   * Writes the input buffered writes to the input array as a single
+   * unordered write.
+   *
+   * @param array_uri The URI of the array.
+   * @param pending The buffered writes.
+   * @param retry Set to `false` if the write failed for a reason other than
+   *     an I/O error or the array failing to open, e.g., because the
+   *     buffered cells are invalid, so that retrying cannot succeed.
+   * @return Status
+   */
+  Status write(const URI& array_uri, PendingWrites* pending, bool* retry)
+      const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_WRITE_COALESCER_H
@@ -38,6 +38,51 @@
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/**
+ * Copies `num` values of type T from `src` with the given stride (in values)
+ * to contiguous positions in `dst`.
+ */
+template <class T>
+void gather_strided(const void* src, uint64_t stride, uint64_t num, void* dst) {
+  auto s = static_cast<const T*>(src);
+  auto d = static_cast<T*>(dst);
+  for (uint64_t i = 0; i < num; ++i)
+    d[i] = s[i * stride];
+}
+
+/**
+ * Copies `num` values of `value_size` bytes from `src`, where they are
+ * `stride` values apart, to contiguous positions in `dst`.
+ */
+void gather_strided(
+    uint64_t value_size,
+    const void* src,
+    uint64_t stride,
+    uint64_t num,
+    void* dst) {
+  switch (value_size) {
+    case 1:
+      return gather_strided<uint8_t>(src, stride, num, dst);
+    case 2:
+      return gather_strided<uint16_t>(src, stride, num, dst);
+    case 4:
+      return gather_strided<uint32_t>(src, stride, num, dst);
+    case 8:
+      return gather_strided<uint64_t>(src, stride, num, dst);
+    default:
+      break;
+  }
+
+  auto s = static_cast<const char*>(src);
+  auto d = static_cast<char*>(dst);
+  for (uint64_t i = 0; i < num; ++i)
+    std::memcpy(d + i * value_size, s + i * stride * value_size, value_size);
+}
+
+}  // namespace
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -150,13 +195,14 @@ Status Tile::init(
     Datatype type,
     uint64_t tile_size,
     uint64_t cell_size,
-    unsigned int dim_num) {
+    unsigned int dim_num,
+    BufferPool* buffer_pool) {
   cell_size_ = cell_size;
   dim_num_ = dim_num;
   type_ = type;
   format_version_ = format_version;
 
-  buffer_ = new Buffer();
+  buffer_ = new Buffer(buffer_pool);
   if (buffer_ == nullptr)
     return LOG_STATUS(
         Status::TileError("Cannot initialize tile; Buffer allocation failed"));
@@ -315,6 +361,32 @@ void Tile::split_coordinates() {
   std::free((void*)tile_tmp);
 }
 
+Status Tile::split_coordinates(std::vector<Tile>* dim_tiles) const {
+  assert(dim_num_ > 0);
+
+  // For easy reference
+  uint64_t coord_size = cell_size_ / dim_num_;
+  uint64_t cell_num = buffer_->size() / cell_size_;
+  auto tile_c = (const char*)buffer_->data();
+
+  dim_tiles->clear();
+  dim_tiles->resize(dim_num_);
+  for (unsigned d = 0; d < dim_num_; ++d) {
+    auto& dim_tile = (*dim_tiles)[d];
+    RETURN_NOT_OK(dim_tile.init(
+        format_version_, type_, cell_num * coord_size, coord_size, 0));
+    gather_strided(
+        coord_size,
+        tile_c + d * coord_size,
+        dim_num_,
+        cell_num,
+        dim_tile.data());
+    dim_tile.set_size(cell_num * coord_size);
+  }
+
+  return Status::Ok();
+}
+
 bool Tile::stores_coords() const {
   return dim_num_ > 0;
 }
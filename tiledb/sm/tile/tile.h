@@ -39,6 +39,7 @@
 #include "tiledb/sm/misc/status.h"
 
 #include <cinttypes>
+#include <vector>
 
 namespace tiledb {
 namespace sm {
@@ -140,6 +141,8 @@ class Tile {
    * @param dim_num The number of dimensions in case the tile stores
    *      coordinates.
    * @param format_version The format version of the data in this tile.
+   * @param buffer_pool The pool the tile buffer allocates from. If `nullptr`,
+   *     the system allocator is used.
    * @return Status
    */
   Status init(
@@ -147,7 +150,8 @@ class Tile {
       Datatype type,
       uint64_t tile_size,
       uint64_t cell_size,
-      unsigned int dim_num);
+      unsigned int dim_num,
+      BufferPool* buffer_pool = nullptr);
 
   /** Advances the buffer offset. */
   void advance_offset(uint64_t nbytes);
@@ -251,6 +255,16 @@ class Tile {
    */
   void split_coordinates();
 
+  /**
+   * Splits the coordinates into one tile per dimension, each storing the
+   * values of a single dimension for all the cells of this tile.
+   *
+   * @param dim_tiles The per-dimension tiles to be created, in dimension
+   *     order.
+   * @return Status
+   */
+  Status split_coordinates(std::vector<Tile>* dim_tiles) const;
+
   /** Returns *true* if the tile stores coordinates. */
   bool stores_coords() const;
 
@@ -37,6 +37,10 @@
 #include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/stats.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 /* ****************************** */
 /*             MACROS             */
 /* ****************************** */
@@ -98,11 +102,52 @@ Status TileIO::is_generic_tile(
 
 Status TileIO::read_generic(
     Tile** tile, uint64_t file_offset, const EncryptionKey& encryption_key) {
+  // Without prefetching, the header and the tile data are read separately
+  if (storage_manager_->generic_tile_prefetch_size() == 0) {
+    uint64_t max_size = 0;
+    return read_generic(tile, file_offset, max_size, encryption_key);
+  }
+
+  // Read the header and a prefix of the tile data speculatively, stopping
+  // early at the end of the file
+  Buffer prefetched;
+  auto nbytes = generic_tile_prefetch_nbytes(
+      storage_manager_, std::numeric_limits<uint64_t>::max());
+  uint64_t nbytes_read;
+  RETURN_NOT_OK(prefetched.realloc(nbytes));
+  RETURN_NOT_OK(storage_manager_->vfs()->read_at_most(
+      uri_, file_offset, prefetched.data(), nbytes, &nbytes_read));
+  prefetched.set_size(nbytes_read);
+  prefetched.reset_offset();
+
+  return read_generic(tile, file_offset, &prefetched, encryption_key);
+}
+
+Status TileIO::read_generic(
+    Tile** tile,
+    uint64_t file_offset,
+    uint64_t max_size,
+    const EncryptionKey& encryption_key) {
+  Buffer prefetched;
+  RETURN_NOT_OK(storage_manager_->read(
+      uri_,
+      file_offset,
+      &prefetched,
+      generic_tile_prefetch_nbytes(storage_manager_, max_size)));
+
+  return read_generic(tile, file_offset, &prefetched, encryption_key);
+}
+
+Status TileIO::read_generic(
+    Tile** tile,
+    uint64_t file_offset,
+    Buffer* prefetched,
+    const EncryptionKey& encryption_key) {
   STATS_FUNC_IN(tileio_read_generic);
 
   GenericTileHeader header;
-  RETURN_NOT_OK(
-      read_generic_tile_header(storage_manager_, uri_, file_offset, &header));
+  RETURN_NOT_OK(deserialize_generic_tile_header(
+      storage_manager_, uri_, file_offset, &header, prefetched));
 
   if (encryption_key.encryption_type() !=
       (EncryptionType)header.encryption_type)
@@ -126,14 +171,37 @@ Status TileIO::read_generic(
   auto tile_data_offset =
       GenericTileHeader::BASE_SIZE + header.filter_pipeline_size;
 
-  // Read the tile.
-  RETURN_NOT_OK_ELSE(
-      storage_manager_->read(
-          uri_,
-          file_offset + tile_data_offset,
-          (*tile)->buffer(),
-          header.persisted_size),
-      delete *tile);
+  // Get the prefix of the tile that was read along with the header
+  uint64_t prefetched_nbytes = 0;
+  if (prefetched->size() > tile_data_offset)
+    prefetched_nbytes =
+        MIN(prefetched->size() - tile_data_offset, header.persisted_size);
+
+  // Read the tile, or its remainder after the prefetched prefix.
+  if (prefetched_nbytes == 0) {
+    RETURN_NOT_OK_ELSE(
+        storage_manager_->read(
+            uri_,
+            file_offset + tile_data_offset,
+            (*tile)->buffer(),
+            header.persisted_size),
+        delete *tile);
+  } else {
+    auto buff = (*tile)->buffer();
+    RETURN_NOT_OK_ELSE(buff->realloc(header.persisted_size), delete *tile);
+    std::memcpy(
+        buff->data(), prefetched->data(tile_data_offset), prefetched_nbytes);
+    if (prefetched_nbytes < header.persisted_size)
+      RETURN_NOT_OK_ELSE(
+          storage_manager_->vfs()->read(
+              uri_,
+              file_offset + tile_data_offset + prefetched_nbytes,
+              buff->data(prefetched_nbytes),
+              header.persisted_size - prefetched_nbytes),
+          delete *tile);
+    buff->set_size(header.persisted_size);
+    buff->reset_offset();
+  }
 
   // Filter
   RETURN_NOT_OK_ELSE(header.filters.run_reverse(*tile), delete *tile);
@@ -152,40 +220,37 @@ Status TileIO::read_generic_tile_header(
     const URI& uri,
     uint64_t file_offset,
     GenericTileHeader* header) {
-  // Read the fixed-sized part of the header from file
-  std::unique_ptr<Buffer> header_buff(new Buffer());
-  RETURN_NOT_OK(sm->read(
-      uri, file_offset, header_buff.get(), GenericTileHeader::BASE_SIZE));
-
-  // Read header individual values
-  RETURN_NOT_OK(header_buff->read(&header->version_number, sizeof(uint32_t)));
-  RETURN_NOT_OK(header_buff->read(&header->persisted_size, sizeof(uint64_t)));
-  RETURN_NOT_OK(header_buff->read(&header->tile_size, sizeof(uint64_t)));
-  RETURN_NOT_OK(header_buff->read(&header->datatype, sizeof(uint8_t)));
-  RETURN_NOT_OK(header_buff->read(&header->cell_size, sizeof(uint64_t)));
-  RETURN_NOT_OK(header_buff->read(&header->encryption_type, sizeof(uint8_t)));
-  RETURN_NOT_OK(
-      header_buff->read(&header->filter_pipeline_size, sizeof(uint32_t)));
+  Buffer prefetched;
+  return read_generic_tile_header(
+      sm, uri, file_offset, 0, header, &prefetched);
+}
 
-  // Read header filter pipeline.
-  header_buff->reset_size();
-  header_buff->reset_offset();
+Status TileIO::read_generic_tile_header(
+    const StorageManager* sm,
+    const URI& uri,
+    uint64_t file_offset,
+    uint64_t max_size,
+    GenericTileHeader* header,
+    Buffer* prefetched) {
+  // Read the fixed-sized part of the header from file, speculatively along
+  // with the filter pipeline and a prefix of the tile data
   RETURN_NOT_OK(sm->read(
       uri,
-      file_offset + GenericTileHeader::BASE_SIZE,
-      header_buff.get(),
-      header->filter_pipeline_size));
-  ConstBuffer cbuf(header_buff->data(), header_buff->size());
-  RETURN_NOT_OK(header->filters.deserialize(&cbuf));
-
-  STATS_COUNTER_ADD(
-      tileio_read_num_bytes_read,
-      GenericTileHeader::BASE_SIZE + header->filter_pipeline_size);
+      file_offset,
+      prefetched,
+      generic_tile_prefetch_nbytes(sm, max_size)));
 
-  return Status::Ok();
+  return deserialize_generic_tile_header(
+      sm, uri, file_offset, header, prefetched);
 }
 
 Status TileIO::write_generic(Tile* tile, const EncryptionKey& encryption_key) {
+  uint64_t nbytes;
+  return write_generic(tile, encryption_key, &nbytes);
+}
+
+Status TileIO::write_generic(
+    Tile* tile, const EncryptionKey& encryption_key, uint64_t* nbytes) {
   STATS_FUNC_IN(tileio_write_generic);
 
   // Reset the tile and buffer offset
@@ -205,6 +270,8 @@ Status TileIO::write_generic(Tile* tile, const EncryptionKey& encryption_key) {
   RETURN_NOT_OK(storage_manager_->write(uri_, tile->buffer()));
 
   file_size_ = header.persisted_size;
+  *nbytes = GenericTileHeader::BASE_SIZE + header.filter_pipeline_size +
+            header.persisted_size;
   STATS_COUNTER_ADD(tileio_write_num_bytes_written, header.persisted_size);
 
   return Status::Ok();
@@ -255,6 +322,10 @@ Status TileIO::write_generic_tile_header(GenericTileHeader* header) {
   return st;
 }
 
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
 Status TileIO::configure_encryption_filter(
     GenericTileHeader* header, const EncryptionKey& encryption_key) const {
   switch ((EncryptionType)header->encryption_type) {
@@ -296,5 +367,75 @@ Status TileIO::init_generic_tile_header(
   return Status::Ok();
 }
 
+Status TileIO::deserialize_generic_tile_header(
+    const StorageManager* sm,
+    const URI& uri,
+    uint64_t file_offset,
+    GenericTileHeader* header,
+    Buffer* prefetched) {
+  // Read the rest of the fixed-sized part of the header, if it was not
+  // prefetched.
+  RETURN_NOT_OK(read_generic_tile_rest(
+      sm, uri, file_offset, GenericTileHeader::BASE_SIZE, prefetched));
+
+  // Read header individual values
+  prefetched->reset_offset();
+  RETURN_NOT_OK(prefetched->read(&header->version_number, sizeof(uint32_t)));
+  RETURN_NOT_OK(prefetched->read(&header->persisted_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(prefetched->read(&header->tile_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(prefetched->read(&header->datatype, sizeof(uint8_t)));
+  RETURN_NOT_OK(prefetched->read(&header->cell_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(prefetched->read(&header->encryption_type, sizeof(uint8_t)));
+  RETURN_NOT_OK(
+      prefetched->read(&header->filter_pipeline_size, sizeof(uint32_t)));
+
+  // Read the rest of the header filter pipeline, if it was not prefetched.
+  RETURN_NOT_OK(read_generic_tile_rest(
+      sm,
+      uri,
+      file_offset,
+      GenericTileHeader::BASE_SIZE + header->filter_pipeline_size,
+      prefetched));
+  ConstBuffer cbuf(
+      prefetched->data(GenericTileHeader::BASE_SIZE),
+      header->filter_pipeline_size);
+  RETURN_NOT_OK(header->filters.deserialize(&cbuf));
+  prefetched->reset_offset();
+
+  STATS_COUNTER_ADD(
+      tileio_read_num_bytes_read,
+      GenericTileHeader::BASE_SIZE + header->filter_pipeline_size);
+
+  return Status::Ok();
+}
+
+uint64_t TileIO::generic_tile_prefetch_nbytes(
+    const StorageManager* sm, uint64_t max_size) {
+  uint64_t nbytes = GenericTileHeader::BASE_SIZE;
+  auto prefetch_size = sm->generic_tile_prefetch_size();
+  if (max_size > 0 && prefetch_size > 0)
+    nbytes = std::max(nbytes, MIN(max_size, nbytes + prefetch_size));
+  return nbytes;
+}
+
+Status TileIO::read_generic_tile_rest(
+    const StorageManager* sm,
+    const URI& uri,
+    uint64_t file_offset,
+    uint64_t nbytes,
+    Buffer* prefetched) {
+  if (prefetched->size() >= nbytes)
+    return Status::Ok();
+
+  Buffer rest;
+  RETURN_NOT_OK(sm->read(
+      uri,
+      file_offset + prefetched->size(),
+      &rest,
+      nbytes - prefetched->size()));
+  prefetched->set_offset(prefetched->size());
+  return prefetched->write(rest.data(), rest.size());
+}
+
 }  // namespace sm
 }  // namespace tiledb
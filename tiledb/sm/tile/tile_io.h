@@ -60,6 +60,12 @@ class TileIO {
     /** Size in bytes of the non-filters part of the serialized header. */
     static const uint64_t BASE_SIZE =
         3 * sizeof(uint64_t) + 2 * sizeof(char) + 2 * sizeof(uint32_t);
+    /**
+     * Number of bytes read along with the non-filters part of the header
+     * when only the header is needed, which covers the serialized filter
+     * pipeline of the generic tiles TileDB writes.
+     */
+    static const uint64_t FILTERS_PREFETCH_SIZE = 256;
     /** Format version number of the tile. */
     uint32_t version_number;
     /** Persisted (e.g. compressed) size of the tile. */
@@ -135,6 +141,12 @@ class TileIO {
    * information about the tile, and then reads the tile data. Note that it
    * creates a new Tile object with the header information.
    *
+   * The header is read in the same request as the first
+   * `sm.generic_tile_prefetch_size` bytes of the tile data, so that a small
+   * tile is read in a single request and a larger one in two. The
+   * speculative read stops early at the end of the file, so the file size
+   * need not be retrieved first (see `VFS::read_at_most`).
+   *
    * @param tile The tile that will hold the read data.
    * @param file_offset The offset in the file to read from.
    * @param encryption_key The encryption key to use.
@@ -143,6 +155,45 @@ class TileIO {
   Status read_generic(
       Tile** tile, uint64_t file_offset, const EncryptionKey& encryption_key);
 
+  /**
+   * Same as `read_generic(tile, file_offset, encryption_key)`, but the
+   * generic tile (header included) is known to span at most `max_size` bytes
+   * of the file, which bounds the speculative read of the tile data along
+   * with the header. A `max_size` of 0 means that the bound is unknown, in
+   * which case the header and the tile data are read separately.
+   *
+   * @param tile The tile that will hold the read data.
+   * @param file_offset The offset in the file to read from.
+   * @param max_size The maximum number of bytes of the generic tile in the
+   *     file, which must not extend past the end of the file.
+   * @param encryption_key The encryption key to use.
+   * @return Status
+   */
+  Status read_generic(
+      Tile** tile,
+      uint64_t file_offset,
+      uint64_t max_size,
+      const EncryptionKey& encryption_key);
+
+  /**
+   * Same as `read_generic(tile, file_offset, encryption_key)`, but a prefix
+   * of the generic tile has already been read from the file, e.g., as part
+   * of a larger speculative read. Only the bytes of the tile past that
+   * prefix, if any, are read from the file.
+   *
+   * @param tile The tile that will hold the read data.
+   * @param file_offset The offset in the file of the generic tile.
+   * @param prefetched The bytes of the file from `file_offset` on that have
+   *     already been read.
+   * @param encryption_key The encryption key to use.
+   * @return Status
+   */
+  Status read_generic(
+      Tile** tile,
+      uint64_t file_offset,
+      Buffer* prefetched,
+      const EncryptionKey& encryption_key);
+
   /**
    * Reads the generic tile header from the file.
    *
@@ -160,6 +211,32 @@ class TileIO {
       uint64_t file_offset,
       GenericTileHeader* header);
 
+  /**
+   * Same as `read_generic_tile_header(sm, uri, file_offset, header)`, but
+   * the fixed-sized part of the header, the filter pipeline and a prefix of
+   * up to `sm.generic_tile_prefetch_size` bytes of the tile data are read in
+   * one request, bounded by `max_size`. The filter pipeline is read with a
+   * follow-up request only if it does not fit in the first one.
+   *
+   * @param sm The StorageManager instance to use for reading.
+   * @param uri The URI of the generic tile.
+   * @param file_offset The offset where the header read will begin.
+   * @param max_size The maximum number of bytes of the generic tile in the
+   *     file, which must not extend past the end of the file. If it is 0,
+   *     only the header is read, in two requests.
+   * @param header The header to be retrieved.
+   * @param prefetched Set to the bytes read from `file_offset` on, i.e., the
+   *     serialized header possibly followed by a prefix of the tile data.
+   * @return Status
+   */
+  static Status read_generic_tile_header(
+      const StorageManager* sm,
+      const URI& uri,
+      uint64_t file_offset,
+      uint64_t max_size,
+      GenericTileHeader* header,
+      Buffer* prefetched);
+
   /**
    * Writes a tile generically to the file. This means that a header will be
    * prepended to the file before writing the tile contents. The reason is
@@ -172,6 +249,19 @@ class TileIO {
    */
   Status write_generic(Tile* tile, const EncryptionKey& encryption_key);
 
+  /**
+   * Same as `write_generic(tile, encryption_key)`, but it also retrieves the
+   * total number of bytes written to the file, i.e., the size of the header
+   * plus the persisted size of the tile.
+   *
+   * @param tile The tile to be written.
+   * @param encryption_key The encryption key to use.
+   * @param nbytes Set to the number of bytes appended to the file.
+   * @return Status
+   */
+  Status write_generic(
+      Tile* tile, const EncryptionKey& encryption_key, uint64_t* nbytes);
+
   /**
    * Writes the generic tile header to the file.
    *
@@ -218,6 +308,46 @@ class TileIO {
       Tile* tile,
       GenericTileHeader* header,
       const EncryptionKey& encryption_key) const;
+
+  /**
+   * Deserializes a generic tile header from the bytes of the file that have
+   * been read from `file_offset` on, reading the missing bytes of the header
+   * from the file if needed.
+   *
+   * @param sm The StorageManager instance to use for reading.
+   * @param uri The URI of the generic tile.
+   * @param file_offset The offset in the file of the generic tile.
+   * @param header The header to be retrieved.
+   * @param prefetched The bytes read from `file_offset` on. It is extended
+   *     with the missing bytes of the header, if any.
+   * @return Status
+   */
+  static Status deserialize_generic_tile_header(
+      const StorageManager* sm,
+      const URI& uri,
+      uint64_t file_offset,
+      GenericTileHeader* header,
+      Buffer* prefetched);
+
+  /**
+   * Returns the number of bytes to read speculatively along with a generic
+   * tile header, given that the tile spans at most `max_size` bytes of the
+   * file (0 if unknown).
+   */
+  static uint64_t generic_tile_prefetch_nbytes(
+      const StorageManager* sm, uint64_t max_size);
+
+  /**
+   * Reads the bytes of the file from `file_offset + prefetched->size()` up
+   * to `file_offset + nbytes` and appends them to `prefetched`. It is a
+   * no-op if `prefetched` already holds at least `nbytes` bytes.
+   */
+  static Status read_generic_tile_rest(
+      const StorageManager* sm,
+      const URI& uri,
+      uint64_t file_offset,
+      uint64_t nbytes,
+      Buffer* prefetched);
 };
 
 }  // namespace sm